@@ -9,10 +9,20 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include <benchmark/benchmark.h>
+#include <fcntl.h>
 
+#include "common/global_context.h"
+#include "common/lang/filesystem.h"
 #include "common/lang/memory.h"
+#include "common/lang/string.h"
 #include "common/lang/vector.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "net/plain_communicator.h"
+#include "net/sql_task_handler.h"
+#include "session/session.h"
 #include "sql/expr/aggregate_hash_table.h"
+#include "storage/default/default_handler.h"
 
 class AggregateHashTableBenchmark : public benchmark::Fixture
 {
@@ -41,7 +51,7 @@ protected:
   Chunk aggr_chunk_;
 };
 
-class DISABLED_StandardAggregateHashTableBenchmark : public AggregateHashTableBenchmark
+class StandardAggregateHashTableBenchmark : public AggregateHashTableBenchmark
 {
 public:
   void SetUp(const ::benchmark::State &state) override
@@ -58,17 +68,17 @@ protected:
   unique_ptr<AggregateHashTable> standard_hash_table_;
 };
 
-BENCHMARK_DEFINE_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)(benchmark::State &state)
+BENCHMARK_DEFINE_F(StandardAggregateHashTableBenchmark, Aggregate)(benchmark::State &state)
 {
   for (auto _ : state) {
     standard_hash_table_->add_chunk(group_chunk_, aggr_chunk_);
   }
 }
 
-BENCHMARK_REGISTER_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
+BENCHMARK_REGISTER_F(StandardAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
 
 #ifdef USE_SIMD
-class DISABLED_LinearProbingAggregateHashTableBenchmark : public AggregateHashTableBenchmark
+class LinearProbingAggregateHashTableBenchmark : public AggregateHashTableBenchmark
 {
 public:
   void SetUp(const ::benchmark::State &state) override
@@ -82,14 +92,102 @@ protected:
   unique_ptr<AggregateHashTable> linear_probing_hash_table_;
 };
 
-BENCHMARK_DEFINE_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)(benchmark::State &state)
+BENCHMARK_DEFINE_F(LinearProbingAggregateHashTableBenchmark, Aggregate)(benchmark::State &state)
 {
   for (auto _ : state) {
     linear_probing_hash_table_->add_chunk(group_chunk_, aggr_chunk_);
   }
 }
 
-BENCHMARK_REGISTER_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
+BENCHMARK_REGISTER_F(LinearProbingAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
 #endif
 
+/**
+ * @brief 从 SQL 开始的端到端 group by 测试
+ * @details 在进程内创建数据库，执行完整的解析、优化和执行流程，结果写到 /dev/null。
+ * 同一个查询分别使用向量化(chunk_iterator)和火山模型(tuple_iterator)执行，参数是分组的个数。
+ */
+class SqlGroupByBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM = 20000;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    if (GCTX.handler_ == nullptr) {
+      filesystem::remove_all("aggregate_hash_table_performance_test");
+      GCTX.handler_ = new DefaultHandler();
+      RC rc         = GCTX.handler_->init("aggregate_hash_table_performance_test", "vacuous", "vacuous", "");
+      ASSERT(OB_SUCC(rc), "failed to init handler. rc=%s", strrc(rc));
+    }
+
+    communicator_ = make_unique<PlainCommunicator>();
+    auto session  = make_unique<Session>(Session::default_session());
+    // 每次都要真正执行查询，不能直接返回缓存的结果
+    session->set_query_cache(false);
+    communicator_->init(::open("/dev/null", O_WRONLY), std::move(session), "benchmark");
+
+    const int group_num = state.range(0);
+    table_name_         = "group_by_" + to_string(group_num);
+    if (Session::default_session().get_current_db()->find_table(table_name_.c_str()) == nullptr) {
+      execute("create table " + table_name_ + "(id int, num int, price float) storage format=pax");
+      for (int i = 0; i < ROW_NUM; i++) {
+        execute("insert into " + table_name_ + " values(" + to_string(i % group_num) + ", " + to_string(i) + ", " +
+                to_string(i % 100) + ".5)");
+      }
+    }
+  }
+
+  void TearDown(const ::benchmark::State &state) override { communicator_.reset(); }
+
+protected:
+  void execute(const string &sql)
+  {
+    SessionEvent event(communicator_.get());
+    event.set_query(sql);
+    Session::set_current_session(communicator_->session());
+    communicator_->session()->set_current_request(&event);
+
+    SQLStageEvent sql_event(&event, sql);
+    RC            rc = handler_.handle_sql(&sql_event);
+    if (OB_FAIL(rc)) {
+      event.sql_result()->set_return_code(rc);
+    }
+
+    bool need_disconnect = false;
+    communicator_->write_result(&event, need_disconnect);
+    communicator_->session()->set_current_request(nullptr);
+    Session::set_current_session(nullptr);
+  }
+
+  void run_group_by(benchmark::State &state, const char *execution_mode)
+  {
+    execute(string("set execution_mode='") + execution_mode + "'");
+    const string sql = "select id, sum(num), count(*), avg(price), max(num), min(num) from " + table_name_ +
+                       " group by id";
+    for (auto _ : state) {
+      execute(sql);
+    }
+    state.SetItemsProcessed(state.iterations() * ROW_NUM);
+  }
+
+protected:
+  SqlTaskHandler                handler_;
+  unique_ptr<PlainCommunicator> communicator_;
+  string                        table_name_;
+};
+
+BENCHMARK_DEFINE_F(SqlGroupByBenchmark, ChunkIterator)(benchmark::State &state)
+{
+  run_group_by(state, "chunk_iterator");
+}
+
+BENCHMARK_DEFINE_F(SqlGroupByBenchmark, TupleIterator)(benchmark::State &state)
+{
+  run_group_by(state, "tuple_iterator");
+}
+
+BENCHMARK_REGISTER_F(SqlGroupByBenchmark, ChunkIterator)->Arg(8)->Arg(1024)->Arg(4096);
+BENCHMARK_REGISTER_F(SqlGroupByBenchmark, TupleIterator)->Arg(8)->Arg(1024)->Arg(4096);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -33,6 +33,8 @@ public:
 
   virtual string Name() const = 0;
 
+  virtual ObLsmOptions Options() const { return ObLsmOptions(); }
+
   virtual void SetUp(const State &state)
   {
     if (0 != state.thread_index()) {
@@ -41,7 +43,7 @@ public:
     filesystem::remove_all("oblsm_benchmark");
     filesystem::create_directory("oblsm_benchmark");
 
-    RC rc = ObLsm::open(ObLsmOptions(), "oblsm_benchmark", &oblsm_);
+    RC rc = ObLsm::open(Options(), "oblsm_benchmark", &oblsm_);
     if (rc != RC::SUCCESS) {
       throw runtime_error("failed to open oblsm");
     }
@@ -90,6 +92,15 @@ public:
     }
   }
 
+  void Get(uint32_t value)
+  {
+    string result;
+    RC     rc = oblsm_->get(to_string(value), &result);
+    if (rc != RC::SUCCESS) {
+      exit(1);
+    }
+  }
+
   void Scan(uint32_t begin, uint32_t end)
   {
     auto iter = oblsm_->new_iterator(ObLsmReadOptions());
@@ -150,4 +161,77 @@ BENCHMARK_REGISTER_F(DISABLED_MixtureBenchmark, Mixture)->Threads(10)->Arg(1)->A
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief random point reads, the block cache is disabled so every block is read from the sstable file and decoded.
+ */
+struct ColdRandomReadBenchmark : public BenchmarkBase
+{
+  string Name() const override { return "cold random read"; }
+
+  ObLsmOptions Options() const override
+  {
+    ObLsmOptions options;
+    options.memtable_size        = 1024 * 1024;
+    options.block_cache_capacity = 0;
+    return options;
+  }
+
+  void SetUp(const State &state) override
+  {
+    BenchmarkBase::SetUp(state);
+    if (0 != state.thread_index()) {
+      return;
+    }
+    FillUp(0, GetRangeMax(state));
+  }
+};
+
+BENCHMARK_DEFINE_F(ColdRandomReadBenchmark, RandomRead)(State &state)
+{
+  IntegerGenerator generator(0, GetRangeMax(state) - 1);
+  for (auto _ : state) {
+    Get(static_cast<uint32_t>(generator.next()));
+  }
+}
+
+BENCHMARK_REGISTER_F(ColdRandomReadBenchmark, RandomRead)->Threads(1)->Threads(4)->Arg(10000)->Arg(30000);
+
+/**
+ * @brief random point reads after all the blocks are loaded into the block cache.
+ */
+struct WarmRandomReadBenchmark : public ColdRandomReadBenchmark
+{
+  string Name() const override { return "warm random read"; }
+
+  ObLsmOptions Options() const override
+  {
+    ObLsmOptions options = ColdRandomReadBenchmark::Options();
+    options.block_cache_capacity = 64 * 1024 * 1024;
+    return options;
+  }
+
+  void SetUp(const State &state) override
+  {
+    ColdRandomReadBenchmark::SetUp(state);
+    if (0 != state.thread_index()) {
+      return;
+    }
+    for (uint32_t value = 0; value < GetRangeMax(state); ++value) {
+      Get(value);
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(WarmRandomReadBenchmark, RandomRead)(State &state)
+{
+  IntegerGenerator generator(0, GetRangeMax(state) - 1);
+  for (auto _ : state) {
+    Get(static_cast<uint32_t>(generator.next()));
+  }
+}
+
+BENCHMARK_REGISTER_F(WarmRandomReadBenchmark, RandomRead)->Threads(1)->Threads(4)->Arg(10000)->Arg(30000);
+
+////////////////////////////////////////////////////////////////////////////////
+
 BENCHMARK_MAIN();
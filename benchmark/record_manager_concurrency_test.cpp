@@ -257,7 +257,7 @@ BENCHMARK_DEFINE_F(InsertionBenchmark, Insertion)(State &state)
   state.counters["other"]   = Counter(stat.insert_other_count, Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10);
+BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->ThreadRange(1, 64)->UseRealTime();
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -284,6 +284,19 @@ public:
     setup_done_ = true;
   }
 
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    BenchmarkBase::TearDown(state);
+
+    // 同一个fixture会按照不同的线程数运行多次，下一轮需要重新准备数据
+    rids_.clear();
+    setup_done_ = false;
+  }
+
 protected:
   // 从实际测试情况看，每个线程都会执行setup，但是它们操作的对象都是同一个
   // 但是每个线程set up结束后，就会执行测试了。如果不等待的话，就会导致有些
@@ -308,7 +321,7 @@ BENCHMARK_DEFINE_F(DeletionBenchmark, Deletion)(State &state)
   state.counters["other"]     = Counter(stat.delete_other_count, Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(DeletionBenchmark, Deletion)->Threads(10)->Arg(4 * 10000);
+BENCHMARK_REGISTER_F(DeletionBenchmark, Deletion)->ThreadRange(1, 64)->Arg(4 * 10000)->UseRealTime();
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -352,7 +365,7 @@ BENCHMARK_DEFINE_F(ScanBenchmark, Scan)(State &state)
   state.counters["other"]                 = Counter(stat.scan_other_count, Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
+BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->ThreadRange(1, 64)->Arg(4 * 10000)->UseRealTime();
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -415,7 +428,7 @@ BENCHMARK_DEFINE_F(MixtureBenchmark, Mixture)(State &state)
       {"scan_open_failed", Counter(stat.scan_open_failed_count, Counter::kIsRate)}});
 }
 
-BENCHMARK_REGISTER_F(MixtureBenchmark, Mixture)->Threads(10)->Arg(4 * 10000);
+BENCHMARK_REGISTER_F(MixtureBenchmark, Mixture)->ThreadRange(1, 64)->Arg(4 * 10000)->UseRealTime();
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -16,3 +16,5 @@ See the Mulan PSL v2 for more details. */
 
 using std::from_chars;
 using std::from_chars_result;
+using std::to_chars;
+using std::to_chars_result;
@@ -22,9 +22,19 @@ int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i)
 
 int mm256_sum_epi32(const int *values, int size)
 {
-  // your code here
+  __m256i sum_vec = _mm256_setzero_si256();
+  int     i       = 0;
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH) {
+    sum_vec = _mm256_add_epi32(sum_vec, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i)));
+  }
+
+  int lanes[SIMD_WIDTH];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sum_vec);
   int sum = 0;
-  for (int i = 0; i < size; i++) {
+  for (int j = 0; j < SIMD_WIDTH; j++) {
+    sum += lanes[j];
+  }
+  for (; i < size; i++) {
     sum += values[i];
   }
   return sum;
@@ -32,9 +42,19 @@ int mm256_sum_epi32(const int *values, int size)
 
 float mm256_sum_ps(const float *values, int size)
 {
-  // your code here
+  __m256 sum_vec = _mm256_setzero_ps();
+  int    i       = 0;
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH) {
+    sum_vec = _mm256_add_ps(sum_vec, _mm256_loadu_ps(values + i));
+  }
+
+  float lanes[SIMD_WIDTH];
+  _mm256_storeu_ps(lanes, sum_vec);
   float sum = 0;
-  for (int i = 0; i < size; i++) {
+  for (int j = 0; j < SIMD_WIDTH; j++) {
+    sum += lanes[j];
+  }
+  for (; i < size; i++) {
     sum += values[i];
   }
   return sum;
@@ -1,2 +1,245 @@
-// TODO: add oblsm bench tool, reference leveldb db_bench
-int main() { return 0; }
\ No newline at end of file
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common/lang/atomic.h"
+#include "common/lang/chrono.h"
+#include "common/lang/filesystem.h"
+#include "common/lang/functional.h"
+#include "common/lang/random.h"
+#include "common/lang/string.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "oblsm/include/ob_lsm.h"
+#include "oblsm/include/ob_lsm_options.h"
+
+// A simple bench tool for oblsm, reference leveldb db_bench.
+//
+// Usage: oblsm_bench [--benchmarks=fillrandom,readrandom,readwarm] [--num=100000] [--reads=-1] [--threads=1]
+//                    [--value_size=100] [--cache_size=8388608] [--memtable_size=1048576] [--sync=0]
+//                    [--table_size=2097152] [--l1_level_size=10485760] [--db=oblsm_bench]
+//
+// Benchmarks:
+//   fillseq     write `num` keys in sequential order
+//   fillrandom  write `num` keys in random order
+//   readrandom  read `reads` keys in random order. The block cache is cold if it's the first read benchmark.
+//   readwarm    read every key once to warm up the block cache(not measured), then same as readrandom.
+//
+// Use `--cache_size=0` to disable the block cache and read all the blocks from disk.
+// Use `--sync=1` to sync the WAL on every write, the concurrent writes are synced together(group commit).
+// The default sstable and level sizes of `ObLsmOptions` are tiny for the unit tests, the bench uses larger ones.
+
+using namespace oceanbase;
+
+namespace {
+
+struct BenchFlags
+{
+  string  benchmarks    = "fillrandom,readrandom,readwarm";
+  int64_t num           = 100000;
+  int64_t reads         = -1;
+  int     threads       = 1;
+  int     value_size    = 100;
+  int64_t cache_size    = -1;
+  int64_t memtable_size = 1024 * 1024;
+  int64_t table_size    = 2 * 1024 * 1024;
+  int64_t l1_level_size = 10 * 1024 * 1024;
+  bool    sync          = false;
+  string  db            = "oblsm_bench";
+};
+
+BenchFlags flags;
+
+string make_key(int64_t k)
+{
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%016" PRId64, k);
+  return string(buf);
+}
+
+class Benchmark
+{
+public:
+  Benchmark() = default;
+  ~Benchmark() { delete lsm_; }
+
+  RC open()
+  {
+    filesystem::remove_all(flags.db);
+    filesystem::create_directories(flags.db);
+
+    ObLsmOptions options;
+    options.memtable_size         = flags.memtable_size;
+    options.table_size            = flags.table_size;
+    options.default_l1_level_size = flags.l1_level_size;
+    if (flags.cache_size >= 0) {
+      options.block_cache_capacity = flags.cache_size;
+    }
+    options.force_sync_new_log = flags.sync;
+    return ObLsm::open(options, flags.db, &lsm_);
+  }
+
+  void run()
+  {
+    size_t begin = 0;
+    while (begin <= flags.benchmarks.size()) {
+      size_t end = flags.benchmarks.find(',', begin);
+      if (end == string::npos) {
+        end = flags.benchmarks.size();
+      }
+      string name = flags.benchmarks.substr(begin, end - begin);
+      begin       = end + 1;
+      if (name.empty()) {
+        continue;
+      }
+
+      if (name == "fillseq") {
+        run_benchmark(name, flags.num, [this](int thread_index, int64_t ops) { write(thread_index, ops, false); });
+      } else if (name == "fillrandom") {
+        run_benchmark(name, flags.num, [this](int thread_index, int64_t ops) { write(thread_index, ops, true); });
+      } else if (name == "readrandom") {
+        run_benchmark(name, reads(), [this](int thread_index, int64_t ops) { read_random(thread_index, ops); });
+      } else if (name == "readwarm") {
+        for (int64_t i = 0; i < flags.num; i++) {
+          string value;
+          lsm_->get(make_key(i), &value);
+        }
+        run_benchmark(name, reads(), [this](int thread_index, int64_t ops) { read_random(thread_index, ops); });
+      } else {
+        fprintf(stderr, "unknown benchmark '%s'\n", name.c_str());
+      }
+    }
+  }
+
+private:
+  int64_t reads() const { return flags.reads < 0 ? flags.num : flags.reads; }
+
+  void run_benchmark(const string &name, int64_t total_ops, function<void(int, int64_t)> func)
+  {
+    const ObLsmBlockCacheStats stats_before = lsm_->block_cache_stats();
+
+    found_ = 0;
+    vector<thread> threads;
+    auto           start_time = chrono::steady_clock::now();
+    for (int i = 0; i < flags.threads; i++) {
+      int64_t ops = total_ops / flags.threads + (i < total_ops % flags.threads ? 1 : 0);
+      threads.emplace_back(func, i, ops);
+    }
+    for (thread &t : threads) {
+      t.join();
+    }
+    auto end_time = chrono::steady_clock::now();
+
+    const ObLsmBlockCacheStats stats_after = lsm_->block_cache_stats();
+
+    double   seconds  = chrono::duration<double>(end_time - start_time).count();
+    uint64_t hits     = stats_after.hits - stats_before.hits;
+    uint64_t misses   = stats_after.misses - stats_before.misses;
+    double   hit_rate = (hits + misses) == 0 ? 0.0 : 100.0 * hits / (hits + misses);
+    fprintf(stdout,
+        "%-12s : %11.3f micros/op; %10.0f ops/sec; block cache hits %" PRIu64 ", misses %" PRIu64
+        " (%.1f%%), usage %zu/%zu",
+        name.c_str(),
+        seconds * 1e6 / (total_ops == 0 ? 1 : total_ops) * flags.threads,
+        total_ops / seconds,
+        hits,
+        misses,
+        hit_rate,
+        stats_after.usage,
+        stats_after.capacity);
+    if (name.rfind("read", 0) == 0) {
+      fprintf(stdout, "; (%" PRId64 " of %" PRId64 " found)", found_.load(), total_ops);
+    }
+    fprintf(stdout, "\n");
+    fflush(stdout);
+  }
+
+  void write(int thread_index, int64_t ops, bool random)
+  {
+    mt19937                          rng(301 + thread_index);
+    uniform_int_distribution<int64_t> distrib(0, flags.num - 1);
+    string                           value(flags.value_size, 'x');
+    for (int64_t i = 0; i < ops; i++) {
+      int64_t k  = random ? distrib(rng) : i * flags.threads + thread_index;
+      RC      rc = lsm_->put(make_key(k), value);
+      if (rc != RC::SUCCESS) {
+        fprintf(stderr, "put error: %s\n", strrc(rc));
+        exit(1);
+      }
+    }
+  }
+
+  void read_random(int thread_index, int64_t ops)
+  {
+    mt19937                          rng(1000 + thread_index);
+    uniform_int_distribution<int64_t> distrib(0, flags.num - 1);
+    int64_t                          found = 0;
+    string                           value;
+    for (int64_t i = 0; i < ops; i++) {
+      if (lsm_->get(make_key(distrib(rng)), &value) == RC::SUCCESS) {
+        found++;
+      }
+    }
+    found_ += found;
+  }
+
+private:
+  ObLsm          *lsm_ = nullptr;
+  atomic<int64_t> found_{0};
+};
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++) {
+    int64_t n;
+    char    junk;
+    if (strncmp(argv[i], "--benchmarks=", 13) == 0) {
+      flags.benchmarks = argv[i] + 13;
+    } else if (sscanf(argv[i], "--num=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.num = n;
+    } else if (sscanf(argv[i], "--reads=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.reads = n;
+    } else if (sscanf(argv[i], "--threads=%" SCNd64 "%c", &n, &junk) == 1 && n > 0) {
+      flags.threads = static_cast<int>(n);
+    } else if (sscanf(argv[i], "--value_size=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.value_size = static_cast<int>(n);
+    } else if (sscanf(argv[i], "--cache_size=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.cache_size = n;
+    } else if (sscanf(argv[i], "--memtable_size=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.memtable_size = n;
+    } else if (sscanf(argv[i], "--table_size=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.table_size = n;
+    } else if (sscanf(argv[i], "--l1_level_size=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.l1_level_size = n;
+    } else if (sscanf(argv[i], "--sync=%" SCNd64 "%c", &n, &junk) == 1) {
+      flags.sync = n != 0;
+    } else if (strncmp(argv[i], "--db=", 5) == 0) {
+      flags.db = argv[i] + 5;
+    } else {
+      fprintf(stderr, "invalid flag '%s'\n", argv[i]);
+      return 1;
+    }
+  }
+
+  Benchmark benchmark;
+  RC        rc = benchmark.open();
+  if (rc != RC::SUCCESS) {
+    fprintf(stderr, "failed to open oblsm at %s: %s\n", flags.db.c_str(), strrc(rc));
+    return 1;
+  }
+  benchmark.run();
+  return 0;
+}
@@ -13,6 +13,9 @@ See the Mulan PSL v2 for more details. */
 
 namespace oceanbase {
 
+// the inputs of an expanded compaction are less than this number of sstables in size
+static constexpr size_t MAX_COMPACTION_TABLE_NUM = 25;
+
 // TODO: put it in options
 unique_ptr<ObCompaction> TiredCompactionPicker::pick(SSTablesPtr sstables)
 {
@@ -31,11 +34,155 @@ unique_ptr<ObCompaction> TiredCompactionPicker::pick(SSTablesPtr sstables)
   return compaction;
 }
 
+static size_t total_size(const vector<shared_ptr<ObSSTable>> &sstables)
+{
+  size_t size = 0;
+  for (const auto &sstable : sstables) {
+    size += sstable->size();
+  }
+  return size;
+}
+
+size_t LeveledCompactionPicker::max_level_size(size_t level) const
+{
+  size_t size = options_->default_l1_level_size;
+  for (size_t i = 1; i < level; ++i) {
+    size *= options_->default_level_ratio;
+  }
+  return size;
+}
+
+vector<shared_ptr<ObSSTable>> LeveledCompactionPicker::overlapping_sstables(
+    const vector<shared_ptr<ObSSTable>> &level, const string_view &smallest, const string_view &largest) const
+{
+  vector<shared_ptr<ObSSTable>> result;
+  for (const auto &sstable : level) {
+    if (sstable->block_count() == 0 || comparator_.compare(sstable->largest_user_key(), smallest) < 0 ||
+        comparator_.compare(sstable->smallest_user_key(), largest) > 0) {
+      continue;
+    }
+    result.emplace_back(sstable);
+  }
+  return result;
+}
+
+void LeveledCompactionPicker::key_range(const vector<shared_ptr<ObSSTable>> &sstables,
+    const vector<shared_ptr<ObSSTable>> &more, string_view &smallest, string_view &largest) const
+{
+  bool first = true;
+  for (const auto *list : {&sstables, &more}) {
+    for (const auto &sstable : *list) {
+      if (sstable->block_count() == 0) {
+        continue;
+      }
+      if (first || comparator_.compare(sstable->smallest_user_key(), smallest) < 0) {
+        smallest = sstable->smallest_user_key();
+      }
+      if (first || comparator_.compare(sstable->largest_user_key(), largest) > 0) {
+        largest = sstable->largest_user_key();
+      }
+      first = false;
+    }
+  }
+}
+
+unique_ptr<ObCompaction> LeveledCompactionPicker::pick(SSTablesPtr sstables)
+{
+  // the last level can't be compacted into the next level
+  const size_t level_num = sstables->size();
+  if (level_num < 2) {
+    return nullptr;
+  }
+
+  size_t best_level = 0;
+  double best_score = 0;
+  for (size_t level = 0; level + 1 < level_num; ++level) {
+    const vector<shared_ptr<ObSSTable>> &sstables_i = (*sstables)[level];
+    double                               score      = 0;
+    if (level == 0) {
+      score = static_cast<double>(sstables_i.size()) / options_->default_l0_file_num;
+    } else {
+      score = static_cast<double>(total_size(sstables_i)) / max_level_size(level);
+    }
+    if (score > best_score) {
+      best_score = score;
+      best_level = level;
+    }
+  }
+  if (best_score < 1) {
+    return nullptr;
+  }
+
+  const vector<shared_ptr<ObSSTable>> &level_sstables = (*sstables)[best_level];
+  const vector<shared_ptr<ObSSTable>> &next_sstables  = (*sstables)[best_level + 1];
+  unique_ptr<ObCompaction>             compaction(new ObCompaction(best_level));
+  vector<shared_ptr<ObSSTable>>       &inputs0 = compaction->inputs_[0];
+  vector<shared_ptr<ObSSTable>>       &inputs1 = compaction->inputs_[1];
+  string_view                          smallest;
+  string_view                          largest;
+
+  if (best_level == 0) {
+    // the oldest sstable, then the sstables of level 0 overlapping with the inputs, until there is no more
+    inputs0.emplace_back(level_sstables.front());
+    while (true) {
+      key_range(inputs0, {}, smallest, largest);
+      vector<shared_ptr<ObSSTable>> overlapping = overlapping_sstables(level_sstables, smallest, largest);
+      if (overlapping.size() == inputs0.size()) {
+        break;
+      }
+      inputs0 = std::move(overlapping);
+    }
+  } else {
+    // the sstable which rewrites the least data of the next level for every byte it moves down
+    double best_ratio = 0;
+    for (const auto &sstable : level_sstables) {
+      if (sstable->block_count() == 0) {
+        continue;
+      }
+      const size_t overlapping_size = total_size(
+          overlapping_sstables(next_sstables, sstable->smallest_user_key(), sstable->largest_user_key()));
+      const double ratio = static_cast<double>(overlapping_size) / std::max<size_t>(sstable->size(), 1);
+      if (inputs0.empty() || ratio < best_ratio) {
+        inputs0    = {sstable};
+        best_ratio = ratio;
+      }
+    }
+    if (inputs0.empty()) {
+      return nullptr;
+    }
+    key_range(inputs0, {}, smallest, largest);
+  }
+  inputs1 = overlapping_sstables(next_sstables, smallest, largest);
+
+  // Expand the inputs of the level to the key range of all the inputs, if it doesn't change the inputs of the next
+  // level. It is limited in size, as a compaction can't be stopped halfway. The inputs of level 0 are not expanded,
+  // they must contain every sstable of level 0 overlapping with them.
+  if (best_level > 0 && !inputs1.empty()) {
+    string_view all_smallest;
+    string_view all_largest;
+    key_range(inputs0, inputs1, all_smallest, all_largest);
+    vector<shared_ptr<ObSSTable>> expanded0 = overlapping_sstables(level_sstables, all_smallest, all_largest);
+    if (expanded0.size() > inputs0.size() &&
+        total_size(expanded0) + total_size(inputs1) < MAX_COMPACTION_TABLE_NUM * options_->table_size) {
+      string_view new_smallest;
+      string_view new_largest;
+      key_range(expanded0, {}, new_smallest, new_largest);
+      vector<shared_ptr<ObSSTable>> expanded1 = overlapping_sstables(next_sstables, new_smallest, new_largest);
+      if (expanded1.size() == inputs1.size()) {
+        inputs0 = std::move(expanded0);
+        inputs1 = std::move(expanded1);
+      }
+    }
+  }
+  return compaction;
+}
+
 ObCompactionPicker *ObCompactionPicker::create(CompactionType type, ObLsmOptions *options)
 {
 
   switch (type) {
     case CompactionType::TIRED: return new TiredCompactionPicker(options);
+    case CompactionType::LEVELED: return new LeveledCompactionPicker(options);
     default: return nullptr;
   }
   return nullptr;
@@ -76,4 +76,54 @@ public:
 private:
 };
 
+/**
+ * @class LeveledCompactionPicker
+ * @brief A class implementing the leveled compaction strategy.
+ *
+ * Every level gets a score: the file count of level 0 divided by `default_l0_file_num`, and the size of level i
+ * divided by `default_l1_level_size * default_level_ratio^(i-1)`. The level with the highest score is compacted
+ * into the next level if its score is at least 1.
+ */
+class LeveledCompactionPicker : public ObCompactionPicker
+{
+public:
+  /**
+   * @param options Pointer to the LSM-Tree options configuration.
+   */
+  LeveledCompactionPicker(ObLsmOptions *options) : ObCompactionPicker(options) {}
+
+  ~LeveledCompactionPicker() = default;
+
+  /**
+   * @brief Implementation of the pick method for leveled compaction.
+   *
+   * The inputs of level 0 are the oldest sstable and the sstables overlapping with it, as they overlap with each
+   * other. The input of the other levels is the sstable which overlaps the least with the next level, relative to
+   * its size. The inputs of the next level are the sstables overlapping with the inputs. Then the inputs of a level
+   * other than level 0 are expanded to the sstables in the key range of all the inputs, if it doesn't add inputs of the
+   * next level.
+   */
+  unique_ptr<ObCompaction> pick(SSTablesPtr sstables) override;
+
+  /**
+   * @brief The max size of a level, level 0 is limited by file count instead.
+   */
+  size_t max_level_size(size_t level) const;
+
+private:
+  /**
+   * @brief Returns the sstables of the level which overlap with the user key range [smallest, largest].
+   */
+  vector<shared_ptr<ObSSTable>> overlapping_sstables(
+      const vector<shared_ptr<ObSSTable>> &level, const string_view &smallest, const string_view &largest) const;
+
+  /**
+   * @brief Computes the user key range of the sstables.
+   */
+  void key_range(const vector<shared_ptr<ObSSTable>> &sstables, const vector<shared_ptr<ObSSTable>> &more,
+      string_view &smallest, string_view &largest) const;
+
+  ObDefaultComparator comparator_;
+};
+
 }  // namespace oceanbase
\ No newline at end of file
@@ -16,10 +16,23 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/utility.h"
 #include "oblsm/include/ob_lsm_options.h"
 #include "oblsm/include/ob_lsm_iterator.h"
+#include "oblsm/include/ob_lsm_write_batch.h"
 
 namespace oceanbase {
 
 class ObLsmTransaction;
+
+/**
+ * @brief Statistics of the block cache, see `ObLsm::block_cache_stats`.
+ */
+struct ObLsmBlockCacheStats
+{
+  size_t   capacity = 0;  ///< capacity in bytes
+  size_t   usage    = 0;  ///< total bytes of the cached blocks
+  uint64_t hits     = 0;
+  uint64_t misses   = 0;
+};
+
 /**
  * @brief ObLsm is a key-value storage engine for educational purpose.
  * ObLsm learned a lot about design from leveldb and streamlined it.
@@ -105,11 +118,24 @@ public:
   /**
    * @brief Inserts a batch of key-value entries into the LSM-Tree.
    *
+   * The entries are written atomically as one `ObLsmWriteBatch`.
+   *
    * @param kvs A vector of key-value pairs to insert.
    * @return An RC value indicating success or failure of the operation.
    */
   virtual RC batch_put(const vector<pair<string, string>> &kvs) = 0;
 
+  /**
+   * @brief Applies a batch of updates to the LSM-Tree atomically.
+   *
+   * The batch is written to the WAL as a single record and its updates get a contiguous range of sequence
+   * numbers. Readers see either none or all of them.
+   *
+   * @param batch The updates to apply. Its sequence number is set to the one of its first update.
+   * @return An RC value indicating success or failure of the operation.
+   */
+  virtual RC write(ObLsmWriteBatch *batch) = 0;
+
   /**
    * @brief Dumps all SSTables for debugging purposes.
    *
@@ -117,6 +143,11 @@ public:
    * LSM-Tree for debugging or inspection purposes.
    */
   virtual void dump_sstables() = 0;
+
+  /**
+   * @brief Returns the statistics of the block cache shared by all SSTables.
+   */
+  virtual ObLsmBlockCacheStats block_cache_stats() const = 0;
 };
 
 }  // namespace oceanbase
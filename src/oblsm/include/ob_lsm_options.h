@@ -40,6 +40,23 @@ struct ObLsmOptions
   // default compaction type
   CompactionType type = CompactionType::LEVELED;
 
+  // block cache, the capacity is the total bytes of the decoded blocks, 0 means no block is cached.
+  size_t block_cache_capacity = 8 * 1024 * 1024;
+  // the block cache is split into 2^block_cache_shard_bits shards, each shard has its own lock.
+  int block_cache_shard_bits = 4;
+
+  // bits of the bloom filter of a sstable for every key, 10 bits per key gives about 1% false positive rate.
+  // 0 means sstables have no bloom filter.
+  size_t bloom_filter_bits_per_key = 10;
+
+  // threads flushing memtables and running compactions in the background, the subcompactions run on them too.
+  size_t background_threads = 4;
+  // a large compaction is split into at most this number of key ranges, which are merged in parallel.
+  // 1 disables subcompactions.
+  size_t max_subcompactions = 4;
+  // bytes written per second by compactions, 0 means no limit. Flushes are not limited, as the writers wait for them.
+  size_t compaction_bytes_per_sec = 0;
+
   // it is used to control whether the WAL is forced to be written to the disk every time a new key is written.
   bool force_sync_new_log = true;
 };
@@ -23,6 +23,8 @@ See the Mulan PSL v2 for more details. */
 
 namespace oceanbase {
 
+class ObLsmSnapshotList;
+
 /**
  * @class ObLsmTransaction
  * @brief A class representing a transaction in oblsm.
@@ -43,10 +45,12 @@ public:
    *
    * @param db A pointer to the `ObLsm` database on which this transaction operates.
    * @param ts The timestamp for the transaction.
+   * @param snapshots The live snapshots of the database. `ts` must have been acquired in it, and it is released when
+   *                  the transaction is destroyed. Compaction keeps the versions the transaction can see until then.
    */
-  ObLsmTransaction(ObLsm *db, uint64_t ts);
+  ObLsmTransaction(ObLsm *db, uint64_t ts, ObLsmSnapshotList *snapshots = nullptr);
 
-  ~ObLsmTransaction() = default;
+  ~ObLsmTransaction();
 
   /*
    * @brief Retrieves the value associated with a given key.
@@ -104,6 +108,8 @@ private:
    */
   uint64_t ts_ = 0;
 
+  ObLsmSnapshotList *snapshots_ = nullptr;
+
   /**
    * @brief In-memory store for transactional changes.
    *
@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/functional.h"
+#include "common/lang/string.h"
+#include "common/lang/string_view.h"
+#include "common/sys/rc.h"
+
+namespace oceanbase {
+
+/**
+ * @class ObLsmWriteBatch
+ * @brief A batch of updates which is applied to the LSM-Tree atomically, see `ObLsm::write()`.
+ *
+ * The updates are encoded into one buffer when they are added. The buffer is written to the WAL as a single
+ * record, the updates get a contiguous range of sequence numbers, and they become visible to readers together.
+ *
+ * ### Data Serialization Format:
+ * - **Sequence Number (uint64_t)**: The sequence number of the first update, assigned when the batch is written.
+ * - **Count (uint32_t)**: The number of updates.
+ * - **Updates**: each update is:
+ *   - **Key Length (uint32_t)**: A value representing the length of the key.
+ *   - **Key (string)**: The actual key, as a string.
+ *   - **Value Length (uint32_t)**: A value representing the length of the value.
+ *   - **Value (string)**: The actual value, as a string. An empty value is a deletion.
+ */
+class ObLsmWriteBatch
+{
+public:
+  ObLsmWriteBatch();
+  ~ObLsmWriteBatch() = default;
+
+  /**
+   * @brief Adds a key-value pair to the batch.
+   */
+  void put(const string_view &key, const string_view &value);
+
+  /**
+   * @brief Adds a deletion of the key to the batch.
+   */
+  void remove(const string_view &key);
+
+  /**
+   * @brief Removes all the updates from the batch.
+   */
+  void clear();
+
+  /**
+   * @brief Appends the updates of another batch to this one.
+   */
+  void append(const ObLsmWriteBatch &other);
+
+  uint32_t count() const;
+  bool     empty() const { return count() == 0; }
+
+  /**
+   * @brief Returns the size of the encoded batch in bytes.
+   */
+  size_t byte_size() const { return rep_.size(); }
+
+  uint64_t sequence() const;
+  void     set_sequence(uint64_t seq);
+
+  /**
+   * @brief Returns the encoded batch, it is what the WAL stores.
+   */
+  string_view data() const { return rep_; }
+
+  /**
+   * @brief Replaces the content of the batch with an encoded batch, used when recovering from the WAL.
+   *
+   * @return `RC::INVALID_ARGUMENT` if the encoded batch is malformed.
+   */
+  RC set_data(const string_view &data);
+
+  /**
+   * @brief Calls `handler` with the sequence number, key and value of every update, in the order they were added.
+   */
+  void iterate(const function<void(uint64_t seq, const string_view &key, const string_view &value)> &handler) const;
+
+private:
+  string rep_;
+};
+
+}  // namespace oceanbase
@@ -44,6 +44,24 @@ void ObMemTable::put(uint64_t seq, const string_view &key, const string_view &va
   table_.insert(buf);
 }
 
+RC ObMemTable::get(const string_view &lookup_key, string *value) const
+{
+  // the internal keys of a user key are ordered by sequence descendingly, so the seek stops at the newest version
+  // which is not newer than the lookup key
+  Table::Iterator iter(&table_);
+  iter.seek(lookup_key.data());
+  if (!iter.valid()) {
+    return RC::NOT_EXIST;
+  }
+  string_view internal_key = get_length_prefixed_string(iter.key());
+  if (extract_user_key(internal_key) != extract_user_key_from_lookup_key(lookup_key)) {
+    return RC::NOT_EXIST;
+  }
+  string_view found_value = get_length_prefixed_string(internal_key.data() + internal_key.size());
+  value->assign(found_value.data(), found_value.size());
+  return RC::SUCCESS;
+}
+
 int ObMemTable::KeyComparator::operator()(const char *a, const char *b) const
 {
   // Internal keys are encoded as length-prefixed strings.
@@ -61,6 +61,17 @@ public:
    */
   void put(uint64_t seq, const string_view &key, const string_view &value);
 
+  /**
+   * @brief Looks up the newest version of a key which is visible to the sequence of the lookup key.
+   *
+   * It can run concurrently with `put`, the same as iterators.
+   *
+   * @param lookup_key The lookup key, see `ObUserIterator::seek()`.
+   * @param value The value of the key, it is empty if the key was deleted.
+   * @return `RC::SUCCESS` if a version of the key is found, `RC::NOT_EXIST` otherwise.
+   */
+  RC get(const string_view &lookup_key, string *value) const;
+
   /**
    * @brief Estimates the memory usage of the memtable.
    *
@@ -10,6 +10,9 @@ See the Mulan PSL v2 for more details. */
 
 #include "oblsm/ob_lsm_impl.h"
 
+#include "common/lang/algorithm.h"
+#include "common/lang/filesystem.h"
+#include "common/lang/limits.h"
 #include "common/log/log.h"
 #include "common/sys/rc.h"
 #include "oblsm/include/ob_lsm.h"
@@ -27,7 +30,13 @@ See the Mulan PSL v2 for more details. */
 
 namespace oceanbase {
 ObLsmImpl::ObLsmImpl(const ObLsmOptions &options, const string &path)
-    : options_(options), path_(path), mu_(), mem_table_(nullptr), imem_tables_(), manifest_(path)
+    : options_(options),
+      path_(path),
+      mu_(),
+      mem_table_(nullptr),
+      imem_tables_(),
+      manifest_(path),
+      compaction_rate_limiter_(options.compaction_bytes_per_sec)
 {
   mem_table_ = make_shared<ObMemTable>();
   sstables_  = make_shared<vector<vector<shared_ptr<ObSSTable>>>>();
@@ -35,9 +44,19 @@ ObLsmImpl::ObLsmImpl(const ObLsmOptions &options, const string &path)
     sstables_->resize(options_.default_levels);
   }
 
-  executor_.init("ObLsmBackground", 1, 1, 60 * 1000);
-  block_cache_ =
-      std::unique_ptr<ObLRUCache<uint64_t, shared_ptr<ObBlock>>>{new ObLRUCache<uint64_t, shared_ptr<ObBlock>>(1024)};
+  executor_.init("ObLsmBackground", 1, static_cast<int>(std::max<size_t>(options_.background_threads, 1)), 60 * 1000);
+  block_cache_ = std::unique_ptr<ObLRUCache<uint64_t, shared_ptr<ObBlock>>>{
+      new_lru_cache<uint64_t, shared_ptr<ObBlock>>(options_.block_cache_capacity, options_.block_cache_shard_bits)};
+  install_version();
+}
+
+void ObLsmImpl::install_version()
+{
+  shared_ptr<ObLsmVersion> version = make_shared<ObLsmVersion>();
+  version->mem_table               = mem_table_;
+  version->imem_tables             = imem_tables_;
+  version->sstables                = sstables_;
+  version_.store(std::move(version));
 }
 
 RC ObLsmImpl::recover()
@@ -76,8 +95,16 @@ RC ObLsmImpl::recover()
     return rc;
   }
 
+  if (new_memtable_record) {
+    memtable_id_ = new_memtable_record->memtable_id;
+  }
+
   // Recover memtable from WAL file.
-  wal_ = std::make_unique<WAL>();
+  rc = recover_from_wal();
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to recover from wal files, rc=%s", strrc(rc));
+    return rc;
+  }
 
   // After recover from the old manifest file, write the snapshot into a new manifest file.
   if (!compaction_records.empty()) {
@@ -101,62 +128,148 @@ RC ObLsm::open(const ObLsmOptions &options, const string &path, ObLsm **dbptr)
 }
 
 RC ObLsmImpl::put(const string_view &key, const string_view &value)
+{
+  LOG_TRACE("begin to put key=%s, value=%s", key.data(), value.data());
+  ObLsmWriteBatch batch;
+  batch.put(key, value);
+  return write(&batch);
+}
+
+RC ObLsmImpl::batch_put(const vector<pair<string, string>> &kvs)
+{
+  ObLsmWriteBatch batch;
+  for (const auto &[key, value] : kvs) {
+    batch.put(key, value);
+  }
+  return write(&batch);
+}
+
+RC ObLsmImpl::remove(const string_view &key)
+{
+  ObLsmWriteBatch batch;
+  batch.remove(key);
+  return write(&batch);
+}
+
+RC ObLsmImpl::write(ObLsmWriteBatch *batch)
 {
   // TODO: if put rate is too high, slow down writes is needed.
   // currently, the writes is stopped when the memtable is full.
-  LOG_TRACE("begin to put key=%s, value=%s", key.data(), value.data());
-  RC rc = RC::SUCCESS;
-  // TODO: currenttly the memtable use skiplist as the underlying data structure,
-  // and the skiplist concurently write is not thread safe, so we use mutex here,
-  // if the skiplist support `insert_concurrently()` interface, can we remove the mutex?
+  if (batch->empty()) {
+    return RC::SUCCESS;
+  }
+
+  // The skiplist of the memtable doesn't support concurrent writes, so the batches are queued, and the writer at
+  // the front of the queue writes the batches queued behind it together (group commit, like leveldb/rocksdb).
+  Writer             writer(batch);
   unique_lock<mutex> lock(mu_);
-  uint64_t           seq = seq_.fetch_add(1);
-  // Write WAL
-  rc = wal_->put(seq, key, value);
-  if (rc != RC::SUCCESS) {
-    return rc;
+  writers_.push_back(&writer);
+  while (!writer.done && &writer != writers_.front()) {
+    writer.cv.wait(lock);
+  }
+  if (writer.done) {
+    return writer.rc;
   }
 
-  if (options_.force_sync_new_log) {
-    rc = wal_->sync();
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("Failed to sync wal logs, rc=%s", strrc(rc));
-      return rc;
+  Writer *last_writer = &writer;
+  RC      rc          = write_group(lock, last_writer);
+
+  // wake up the followers in this group, and the writer that becomes the next leader
+  while (true) {
+    Writer *ready = writers_.front();
+    writers_.pop_front();
+    if (ready != &writer) {
+      ready->rc   = rc;
+      ready->done = true;
+      ready->cv.notify_one();
     }
+    if (ready == last_writer) {
+      break;
+    }
+  }
+  if (!writers_.empty()) {
+    writers_.front()->cv.notify_one();
+  }
+  return rc;
+}
+
+RC ObLsmImpl::write_group(unique_lock<mutex> &lock, Writer *&last_writer)
+{
+  // Limit the size of a group, and don't let a small write wait for too many bytes.
+  static constexpr size_t MAX_GROUP_BYTES   = 1024 * 1024;
+  static constexpr size_t SMALL_WRITE_BYTES = 128 * 1024;
+
+  ObLsmWriteBatch *batch      = writers_.front()->batch;
+  const size_t     first_size = batch->byte_size();
+  const size_t     max_size   = first_size <= SMALL_WRITE_BYTES ? first_size + SMALL_WRITE_BYTES : MAX_GROUP_BYTES;
+
+  // The batch of a single writer is written as it is, the batches of a group are merged into `group_batch`.
+  ObLsmWriteBatch group_batch;
+  size_t          size = first_size;
+  last_writer          = writers_.front();
+  for (auto iter = writers_.begin() + 1; iter != writers_.end(); ++iter) {
+    size += (*iter)->batch->byte_size();
+    if (size > max_size) {
+      break;
+    }
+    if (batch != &group_batch) {
+      group_batch.append(*batch);
+      batch = &group_batch;
+    }
+    batch->append(*(*iter)->batch);
+    last_writer = *iter;
+  }
+
+  // `seq_` is the last sequence number used
+  const uint64_t first_seq = seq_.load() + 1;
+  batch->set_sequence(first_seq);
+
+  // Only the leader changes `wal_` and `mem_table_`, so they can be used without the lock. The writers coming
+  // in the meantime are queued and will be written by the next group.
+  shared_ptr<WAL>        wal = wal_;
+  shared_ptr<ObMemTable> mem = mem_table_;
+  lock.unlock();
+
+  RC rc = wal->write(*batch);
+  if (OB_SUCC(rc) && options_.force_sync_new_log) {
+    rc = wal->sync();
   }
-  // write memtable
-  mem_table_->put(seq, key, value);
-  size_t mem_size = mem_table_->appro_memory_usage();
-  if (mem_size > options_.memtable_size) {
+  if (OB_SUCC(rc)) {
+    batch->iterate([&mem](uint64_t seq, const string_view &key, const string_view &value) {
+      mem->put(seq, key, value);
+    });
+  }
+
+  lock.lock();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to write wal logs, rc=%s", strrc(rc));
+    return rc;
+  }
+  // readers take `seq_` as their snapshot and see the versions not newer than it, so the whole group becomes visible
+  // at once
+  const uint64_t last_seq = first_seq + batch->count() - 1;
+  seq_.store(last_seq);
+
+  if (mem->appro_memory_usage() > options_.memtable_size) {
     // Thinking point: here vector is used to store imems,
     // but only one imem is stored at most. Is it possible
     // to store more than one imem and what are the implications
     // of storing more than one imem.
-    if (imem_tables_.size() >= 1) {
+    while (imem_tables_.size() >= 1) {
       cv_.wait(lock);
     }
-    // check again after get lock(maybe freeze memtable by another thread)
-    if (mem_table_->appro_memory_usage() > options_.memtable_size) {
-      manifest_.latest_seq = seq;
-      try_freeze_memtable();
-    } else {
-      // if there are multi put threads waiting here, need to notify one thread to
-      // continue to write to memtable.
-      cv_.notify_one();
-    }
+    manifest_.latest_seq = last_seq;
+    rc                   = try_freeze_memtable();
   }
   return rc;
 }
 
-RC ObLsmImpl::batch_put(const vector<pair<string, string>> &kvs) { return RC::UNIMPLEMENTED; }
-
-RC ObLsmImpl::remove(const string_view &key) { return RC::UNIMPLEMENTED; }
-
 RC ObLsmImpl::try_freeze_memtable()
 {
   RC rc = RC::SUCCESS;
   imem_tables_.emplace_back(mem_table_);
   mem_table_ = make_unique<ObMemTable>();
+  install_version();
   // frozen previous wal
   if (!options_.force_sync_new_log) {
     rc = wal_->sync();
@@ -183,30 +296,63 @@ RC ObLsmImpl::try_freeze_memtable()
 void ObLsmImpl::background_compaction(std::shared_ptr<ObLsmBgCompactCtx> ctx)
 {
   unique_lock<mutex> lock(mu_);
-  if (imem_tables_.size() >= 1) {
-    shared_ptr<ObMemTable> imem       = imem_tables_.back();
-    shared_ptr<WAL>        frozen_wal = frozen_wals_.back();
+  if (imem_tables_.empty()) {
+    return;
+  }
+  // the writers don't freeze another memtable before this one is flushed, so nobody else changes `imem_tables_`
+  // and `frozen_wals_` meanwhile
+  shared_ptr<ObMemTable> imem       = imem_tables_.back();
+  shared_ptr<WAL>        frozen_wal = frozen_wals_.back();
+  lock.unlock();
 
-    // TODO: build memtable to sst shouldn't in lock?
-    build_sstable(imem);
-    imem_tables_.pop_back();
-    frozen_wals_.pop_back();
-    manifest_.push(ObManifestNewMemtable{ctx->new_memtable_id});
+  // the sstable is written without the lock, the writers and the readers go on meanwhile
+  shared_ptr<ObSSTable> sstable;
+  RC                    rc = build_sstable(imem, sstable);
+  if (OB_FAIL(rc)) {
+    // the memtable and the WAL are kept, the data is still readable and recovered after restart
+    LOG_ERROR("failed to flush memtable to sstable, rc=%s", strrc(rc));
+    return;
+  }
+
+  lock.lock();
+  ObManifestCompaction record;
+  record.compaction_type     = options_.type;
+  record.sstable_sequence_id = sstable_id_.load();
+  record.seq_id              = manifest_.latest_seq;
+
+  // the readers may be using `sstables_`, modify a copy of it
+  SSTablesPtr new_sstables = make_shared<vector<vector<shared_ptr<ObSSTable>>>>(*sstables_);
+  // TODO: unify the build sstable logic in all compaction type
+  if (options_.type == CompactionType::TIRED) {
+    // TODO: record the changes for tired compaction
+    // here we use `level_i` to store `run_i`
+    new_sstables->insert(new_sstables->begin(), {sstable});
+  } else if (options_.type == CompactionType::LEVELED) {
+    new_sstables->at(0).emplace_back(sstable);
+    record.added_tables.emplace_back(sstable->sst_id(), 0);
+    manifest_.push(std::move(record));
+  }
+  sstables_ = new_sstables;
 
-    ::remove(frozen_wal->filename().c_str());
+  imem_tables_.pop_back();
+  install_version();
+  frozen_wals_.pop_back();
+  manifest_.push(ObManifestNewMemtable{ctx->new_memtable_id});
 
-    lock.unlock();
-    cv_.notify_one();
+  ::remove(frozen_wal->filename().c_str());
 
-    // TODO: trig compaction at more scenarios, for example,
-    // seek compaction in
-    // leveldb(https://github.com/google/leveldb/blob/578eeb702ec0fbb6b9780f3d4147b1076630d633/db/version_set.cc#L650).
-    if (!compacting_) {
-      compacting_.store(true);
-      try_major_compaction();
-      compacting_.store(false);
-    }
-    return;
+  lock.unlock();
+  cv_.notify_one();
+
+  // TODO: trig compaction at more scenarios, for example,
+  // seek compaction in
+  // leveldb(https://github.com/google/leveldb/blob/578eeb702ec0fbb6b9780f3d4147b1076630d633/db/version_set.cc#L650).
+  // The next memtable may be flushed by another background thread while this one is compacting, only one
+  // compaction runs at a time.
+  bool expected = false;
+  if (compacting_.compare_exchange_strong(expected, true)) {
+    try_major_compaction();
+    compacting_.store(false);
   }
 }
 
@@ -214,13 +360,21 @@ void ObLsmImpl::try_major_compaction()
 {
   unique_lock<mutex>             lock(mu_);
   unique_ptr<ObCompactionPicker> picker(ObCompactionPicker::create(options_.type, &options_));
-  unique_ptr<ObCompaction>       picked = picker->pick(sstables_);
+  if (picker == nullptr) {
+    return;
+  }
+  unique_ptr<ObCompaction> picked = picker->pick(sstables_);
   ObManifestCompaction           mf_record;
   lock.unlock();
   if (picked == nullptr || picked->size() == 0) {
     return;
   }
-  vector<shared_ptr<ObSSTable>> results = do_compaction(picked.get());
+  vector<shared_ptr<ObSSTable>> results;
+  RC                            rc = do_compaction(picked.get(), results);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to do compaction, rc=%s", strrc(rc));
+    return;
+  }
 
   SSTablesPtr new_sstables = make_shared<vector<vector<shared_ptr<ObSSTable>>>>();
   lock.lock();
@@ -258,48 +412,277 @@ void ObLsmImpl::try_major_compaction()
       }
     }
   } else if (options_.type == CompactionType::LEVELED) {
-    // TODO: apply the compaction results to sstable
+    // the inputs are replaced by the results in the next level
+    *new_sstables     = *sstables_;
+    const int level   = picked->level();
+    for (int which = 0; which < 2; ++which) {
+      vector<shared_ptr<ObSSTable>> &level_i = new_sstables->at(level + which);
+      for (const auto &sstable : picked->inputs(which)) {
+        mf_record.deleted_tables.emplace_back(sstable->sst_id(), level + which);
+      }
+      level_i.erase(std::remove_if(level_i.begin(),
+                        level_i.end(),
+                        [&](const shared_ptr<ObSSTable> &sstable) { return find_sstable(picked->inputs(which), sstable); }),
+          level_i.end());
+    }
+    vector<shared_ptr<ObSSTable>> &output_level = new_sstables->at(level + 1);
+    for (const auto &sstable : results) {
+      mf_record.added_tables.emplace_back(sstable->sst_id(), level + 1);
+      output_level.emplace_back(sstable);
+    }
+    std::sort(output_level.begin(), output_level.end(), [this](const auto &a, const auto &b) {
+      return default_comparator_.compare(a->smallest_user_key(), b->smallest_user_key()) < 0;
+    });
+    mf_record.compaction_type = CompactionType::LEVELED;
   }
 
   sstables_ = new_sstables;
+  install_version();
+
+  // the results must be recorded before the inputs are removed
+  mf_record.sstable_sequence_id = sstable_id_.load();
+  mf_record.seq_id              = manifest_.latest_seq;
+  manifest_.push(std::move(mf_record));
   lock.unlock();
 
   // remove from disk
   for (auto &sstable : picked_sstables) {
     sstable->remove();
   }
-
-  mf_record.sstable_sequence_id = sstable_id_.load();
-  mf_record.seq_id              = manifest_.latest_seq;
-  manifest_.push(std::move(mf_record));
   try_major_compaction();
 }
 
-vector<shared_ptr<ObSSTable>> ObLsmImpl::do_compaction(ObCompaction *picked) { return {}; }
+RC ObLsmImpl::do_compaction(ObCompaction *picked, vector<shared_ptr<ObSSTable>> &results)
+{
+  // the versions shadowed by a newer version which every live snapshot can see are dropped
+  const uint64_t smallest_snapshot = snapshots_.oldest(seq_);
 
-void ObLsmImpl::build_sstable(shared_ptr<ObMemTable> imem)
+  // the sstables below the results, a deletion is kept if they may contain the key
+  vector<shared_ptr<ObSSTable>> lower_sstables;
+  if (options_.type == CompactionType::LEVELED) {
+    shared_ptr<const ObLsmVersion> version = version_.load();
+    for (size_t level = picked->level() + 2; level < version->sstables->size(); ++level) {
+      const auto &level_i = version->sstables->at(level);
+      lower_sstables.insert(lower_sstables.end(), level_i.begin(), level_i.end());
+    }
+  }
+
+  // the key ranges don't overlap, so the results of the subcompactions are sorted one after another
+  const vector<string>                  boundaries = subcompaction_boundaries(*picked);
+  const size_t                          sub_num    = boundaries.size() + 1;
+  vector<vector<shared_ptr<ObSSTable>>> sub_results(sub_num);
+  vector<RC>                            sub_rcs(sub_num, RC::SUCCESS);
+  run_in_parallel(sub_num, [&](size_t i) {
+    const string *begin = i == 0 ? nullptr : &boundaries[i - 1];
+    const string *end   = i + 1 == sub_num ? nullptr : &boundaries[i];
+    sub_rcs[i]          = do_subcompaction(*picked, begin, end, smallest_snapshot, lower_sstables, sub_results[i]);
+  });
+
+  RC rc = RC::SUCCESS;
+  for (size_t i = 0; i < sub_num; ++i) {
+    if (OB_FAIL(sub_rcs[i]) && OB_SUCC(rc)) {
+      rc = sub_rcs[i];
+    }
+    results.insert(results.end(), sub_results[i].begin(), sub_results[i].end());
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write the results of compaction, rc=%s", strrc(rc));
+    for (auto &sstable : results) {
+      sstable->remove();
+    }
+    results.clear();
+  }
+  return rc;
+}
+
+vector<string> ObLsmImpl::subcompaction_boundaries(const ObCompaction &picked) const
 {
-  unique_ptr<ObSSTableBuilder> tb = make_unique<ObSSTableBuilder>(&default_comparator_, block_cache_.get());
+  // every input sstable is counted at its smallest key
+  vector<pair<string_view, size_t>> candidates;
+  size_t                            total_size = 0;
+  for (int which = 0; which < 2; ++which) {
+    for (const auto &sstable : picked.inputs(which)) {
+      if (sstable->block_count() > 0) {
+        candidates.emplace_back(sstable->smallest_user_key(), sstable->size());
+        total_size += sstable->size();
+      }
+    }
+  }
 
-  uint64_t sstable_id = sstable_id_.fetch_add(1);
-  tb->build(imem, get_sstable_path(sstable_id), sstable_id);
-  // unique_lock<mutex> lock(mu_);
+  const size_t sub_num = std::min(options_.max_subcompactions, total_size / std::max<size_t>(options_.table_size, 1));
+  if (sub_num <= 1) {
+    return {};
+  }
+  std::sort(candidates.begin(), candidates.end(), [this](const auto &a, const auto &b) {
+    return default_comparator_.compare(a.first, b.first) < 0;
+  });
+
+  vector<string> boundaries;
+  const size_t   size_per_sub = total_size / sub_num;
+  size_t         size_before  = 0;
+  for (const auto &[key, size] : candidates) {
+    if (boundaries.size() + 1 == sub_num) {
+      break;
+    }
+    const string_view last = boundaries.empty() ? candidates.front().first : string_view(boundaries.back());
+    if (size_before >= size_per_sub * (boundaries.size() + 1) && default_comparator_.compare(key, last) > 0) {
+      boundaries.emplace_back(key);
+    }
+    size_before += size;
+  }
+  return boundaries;
+}
 
-  ObManifestCompaction record;
-  record.compaction_type     = options_.type;
-  record.sstable_sequence_id = sstable_id_.load();
-  record.seq_id              = manifest_.latest_seq;
+RC ObLsmImpl::do_subcompaction(const ObCompaction &picked, const string *begin, const string *end,
+    uint64_t smallest_snapshot, const vector<shared_ptr<ObSSTable>> &lower_sstables,
+    vector<shared_ptr<ObSSTable>> &results)
+{
+  auto in_lower_sstables = [&lower_sstables](const string_view &user_key) {
+    for (const auto &sstable : lower_sstables) {
+      if (sstable->may_contain(user_key)) {
+        return true;
+      }
+    }
+    return false;
+  };
 
-  // TODO: unify the build sstable logic in all compaction type
-  if (options_.type == CompactionType::TIRED) {
-    // TODO: record the changes for tired compaction
-    // here we use `level_i` to store `run_i`
-    sstables_->insert(sstables_->begin(), {tb->get_built_table()});
-  } else if (options_.type == CompactionType::LEVELED) {
-    sstables_->at(0).emplace_back(tb->get_built_table());
-    record.added_tables.emplace_back(sstable_id, 0);
-    manifest_.push(std::move(record));
+  // the sstables of level 0 and the runs of tired compaction overlap with each other, they are merged one by one
+  vector<unique_ptr<ObLsmIterator>> iters;
+  if (options_.type == CompactionType::LEVELED && picked.level() > 0) {
+    iters.emplace_back(new_concat_iterator(picked.inputs(0)));
+  } else {
+    for (const auto &sstable : picked.inputs(0)) {
+      iters.emplace_back(sstable->new_iterator());
+    }
+  }
+  if (!picked.inputs(1).empty()) {
+    iters.emplace_back(new_concat_iterator(picked.inputs(1)));
+  }
+  unique_ptr<ObLsmIterator> iter(new_merging_iterator(&internal_key_comparator_, std::move(iters)));
+
+  RC                           rc = RC::SUCCESS;
+  unique_ptr<ObSSTableBuilder> builder;
+  string                       builder_path;
+  auto                         finish_builder = [&]() {
+    RC rc = builder->finish();
+    if (OB_SUCC(rc)) {
+      results.emplace_back(builder->get_built_table());
+      builder.reset();
+    }
+    return rc;
+  };
+
+  string   curr_user_key;
+  bool     has_curr_user_key = false;
+  uint64_t last_seq_for_key  = 0;
+  if (begin != nullptr) {
+    // the newest version of the key is the first one
+    iter->seek(make_lookup_key(*begin, numeric_limits<uint64_t>::max()));
+  } else {
+    iter->seek_to_first();
+  }
+  for (; iter->valid() && OB_SUCC(rc); iter->next()) {
+    const string_view key      = iter->key();
+    const string_view user_key = extract_user_key(key);
+    const uint64_t    seq      = extract_sequence(key);
+    if (!has_curr_user_key || default_comparator_.compare(user_key, curr_user_key) != 0) {
+      if (end != nullptr && default_comparator_.compare(user_key, *end) >= 0) {
+        break;
+      }
+      // a new sstable is started only between two user keys
+      if (builder != nullptr && builder->estimated_size() >= options_.table_size && OB_FAIL(rc = finish_builder())) {
+        break;
+      }
+      curr_user_key.assign(user_key.data(), user_key.size());
+      has_curr_user_key = true;
+      last_seq_for_key  = numeric_limits<uint64_t>::max();
+    }
+
+    bool drop = false;
+    if (last_seq_for_key <= smallest_snapshot) {
+      // a newer version of the key is visible to every snapshot
+      drop = true;
+    } else if (iter->value().empty() && seq <= smallest_snapshot && !in_lower_sstables(user_key)) {
+      // the deletion hides nothing, the older versions of the key in this compaction are dropped by the rule above
+      drop = true;
+    }
+    last_seq_for_key = seq;
+    if (drop) {
+      continue;
+    }
+
+    if (builder == nullptr) {
+      const uint64_t sstable_id = sstable_id_.fetch_add(1);
+      builder_path              = get_sstable_path(sstable_id);
+      builder = make_unique<ObSSTableBuilder>(&default_comparator_, block_cache_.get(), options_.bloom_filter_bits_per_key);
+      if (options_.compaction_bytes_per_sec > 0) {
+        builder->set_rate_limiter(&compaction_rate_limiter_);
+      }
+      if (OB_FAIL(rc = builder->open(builder_path, sstable_id))) {
+        break;
+      }
+    }
+    rc = builder->add(key, iter->value());
+  }
+  if (OB_SUCC(rc) && builder != nullptr) {
+    rc = finish_builder();
+  }
+
+  if (OB_FAIL(rc) && builder != nullptr) {
+    filesystem::remove(builder_path);
+  }
+  return rc;
+}
+
+void ObLsmImpl::run_in_parallel(size_t task_num, const function<void(size_t)> &task)
+{
+  struct State
+  {
+    atomic<size_t>     next{0};
+    mutex              mu;
+    condition_variable cv;
+    size_t             finished = 0;
+  };
+  // a background thread may start after all the tasks are done and this function returns, it only touches `state`
+  // then, as there is no task left for it
+  auto state = make_shared<State>();
+  auto work  = [state, task_num, &task]() {
+    for (size_t i = state->next.fetch_add(1); i < task_num; i = state->next.fetch_add(1)) {
+      task(i);
+      lock_guard<mutex> guard(state->mu);
+      if (++state->finished == task_num) {
+        state->cv.notify_all();
+      }
+    }
+  };
+
+  // leave a background thread for flushing memtables, the writers wait for it
+  const size_t max_helpers = options_.background_threads > 2 ? options_.background_threads - 2 : 0;
+  const size_t helper_num  = std::min(task_num - 1, max_helpers);
+  for (size_t i = 0; i < helper_num; ++i) {
+    if (executor_.execute(work) != 0) {
+      break;
+    }
+  }
+  work();
+
+  unique_lock<mutex> lock(state->mu);
+  state->cv.wait(lock, [&state, task_num]() { return state->finished == task_num; });
+}
+
+RC ObLsmImpl::build_sstable(shared_ptr<ObMemTable> imem, shared_ptr<ObSSTable> &sstable)
+{
+  unique_ptr<ObSSTableBuilder> tb =
+      make_unique<ObSSTableBuilder>(&default_comparator_, block_cache_.get(), options_.bloom_filter_bits_per_key);
+
+  uint64_t sstable_id = sstable_id_.fetch_add(1);
+  RC       rc         = tb->build(imem, get_sstable_path(sstable_id), sstable_id);
+  if (OB_FAIL(rc)) {
+    filesystem::remove(get_sstable_path(sstable_id));
+    return rc;
   }
+  sstable = tb->get_built_table();
+  return RC::SUCCESS;
 }
 
 string ObLsmImpl::get_sstable_path(uint64_t sstable_id)
@@ -314,50 +697,93 @@ string ObLsmImpl::get_wal_path(uint64_t memtable_id)
 
 RC ObLsmImpl::get(const string_view &key, string *value)
 {
-  RC                 rc = RC::SUCCESS;
-  unique_lock<mutex> lock(mu_);
-  auto               iter = unique_ptr<ObLsmIterator>(new_iterator(ObLsmReadOptions{}));
-  iter->seek(key);
-  if (iter->valid() && iter->key() == key) {
-    if (iter->value().empty()) {
-      rc = RC::NOT_EXIST;
-    } else {
-      value->assign(iter->value());
-    }
-  } else {
+  // Take the sequence before the version, the updates before the sequence are in the version, even if the memtable
+  // has been flushed in between.
+  const uint64_t                 seq     = seq_.load();
+  shared_ptr<const ObLsmVersion> version = version_.load();
+
+  // lookup key, the same as ObUserIterator::seek
+  string lookup_key;
+  lookup_key.reserve(LOOKUP_KEY_PREFIX_SIZE + key.size() + SEQ_SIZE);
+  put_numeric<uint64_t>(&lookup_key, key.size() + SEQ_SIZE);
+  lookup_key.append(key.data(), key.size());
+  put_numeric<uint64_t>(&lookup_key, seq);
+
+  // from the newest to the oldest, the first version found is the answer
+  RC rc = version->mem_table->get(lookup_key, value);
+  for (auto iter = version->imem_tables.rbegin(); rc == RC::NOT_EXIST && iter != version->imem_tables.rend(); ++iter) {
+    rc = (*iter)->get(lookup_key, value);
+  }
+  if (rc == RC::NOT_EXIST) {
+    rc = get_from_sstables(*version, lookup_key, value);
+  }
+  if (OB_SUCC(rc) && value->empty()) {  // deleted
     rc = RC::NOT_EXIST;
   }
   return rc;
 }
 
-ObLsmIterator *ObLsmImpl::new_iterator(ObLsmReadOptions options)
+RC ObLsmImpl::get_from_sstables(const ObLsmVersion &version, const string_view &lookup_key, string *value)
 {
-  unique_lock<mutex>     lock(mu_);
-  shared_ptr<ObMemTable> mem = mem_table_;
+  const string_view user_key = extract_user_key_from_lookup_key(lookup_key);
+  for (size_t level = 0; level < version.sstables->size(); level++) {
+    const vector<shared_ptr<ObSSTable>> &sstables = version.sstables->at(level);
+    if (sstables.empty()) {
+      continue;
+    }
 
-  shared_ptr<ObMemTable> imm = nullptr;
-  if (!imem_tables_.empty()) {
-    imm = imem_tables_.back();
-  }
-  vector<shared_ptr<ObSSTable>> sstables;
-  for (auto &level : *sstables_) {
-    sstables.insert(sstables.end(), level.begin(), level.end());
+    if (level == 0 && options_.type == CompactionType::LEVELED) {
+      // the sstables of level 0 overlap with each other, the newer ones are at the back
+      for (auto iter = sstables.rbegin(); iter != sstables.rend(); ++iter) {
+        RC rc = (*iter)->get(lookup_key, value);
+        if (rc != RC::NOT_EXIST) {
+          return rc;
+        }
+      }
+      continue;
+    }
+
+    // The sstables of the other levels (or a run of tired compaction) are sorted and don't overlap, only the first
+    // one whose largest key is not less than the key may contain it.
+    auto candidate = std::lower_bound(sstables.begin(),
+        sstables.end(),
+        user_key,
+        [this](const shared_ptr<ObSSTable> &sstable, const string_view &user_key) {
+          return default_comparator_.compare(sstable->largest_user_key(), user_key) < 0;
+        });
+    if (candidate != sstables.end()) {
+      RC rc = (*candidate)->get(lookup_key, value);
+      if (rc != RC::NOT_EXIST) {
+        return rc;
+      }
+    }
   }
-  lock.unlock();
+  return RC::NOT_EXIST;
+}
+
+ObLsmIterator *ObLsmImpl::new_iterator(ObLsmReadOptions options)
+{
+  const uint64_t                 seq     = options.seq == -1 ? seq_.load() : options.seq;
+  shared_ptr<const ObLsmVersion> version = version_.load();
+
   vector<unique_ptr<ObLsmIterator>> iters;
-  iters.emplace_back(mem->new_iterator());
-  if (imm != nullptr) {
-    iters.emplace_back(imm->new_iterator());
+  iters.emplace_back(version->mem_table->new_iterator());
+  for (auto iter = version->imem_tables.rbegin(); iter != version->imem_tables.rend(); ++iter) {
+    iters.emplace_back((*iter)->new_iterator());
   }
-  for (const auto &sst : sstables) {
-    iters.emplace_back(sst->new_iterator());
+  for (const auto &level : *version->sstables) {
+    for (const auto &sst : level) {
+      iters.emplace_back(sst->new_iterator());
+    }
   }
 
-  return new_user_iterator(
-      new_merging_iterator(&internal_key_comparator_, std::move(iters)), options.seq == -1 ? seq_.load() : options.seq);
+  return new_user_iterator(new_merging_iterator(&internal_key_comparator_, std::move(iters)), seq);
 }
 
-ObLsmTransaction *ObLsmImpl::begin_transaction() { return new ObLsmTransaction(this, seq_.load()); }
+ObLsmTransaction *ObLsmImpl::begin_transaction()
+{
+  return new ObLsmTransaction(this, snapshots_.acquire(seq_), &snapshots_);
+}
 
 void ObLsmImpl::dump_sstables()
 {
@@ -374,6 +800,82 @@ void ObLsmImpl::dump_sstables()
   }
 }
 
+ObLsmBlockCacheStats ObLsmImpl::block_cache_stats() const
+{
+  ObLsmBlockCacheStats stats;
+  stats.capacity = block_cache_->capacity();
+  stats.usage    = block_cache_->usage();
+  stats.hits     = block_cache_->hits();
+  stats.misses   = block_cache_->misses();
+  return stats;
+}
+
+RC ObLsmImpl::recover_from_wal()
+{
+  // The WAL of the current memtable, and the WALs of the memtables frozen after it whose sstables were not built
+  // before the crash. The WALs before the current memtable have been flushed into sstables already.
+  vector<uint64_t> wal_ids;
+  for (const auto &entry : filesystem::directory_iterator(path_)) {
+    const filesystem::path &file = entry.path();
+    if (file.extension() != WAL_SUFFIX) {
+      continue;
+    }
+    const uint64_t wal_id = std::stoull(file.stem().string());
+    if (wal_id >= memtable_id_.load()) {
+      wal_ids.push_back(wal_id);
+    } else {
+      filesystem::remove(file);
+    }
+  }
+  std::sort(wal_ids.begin(), wal_ids.end());
+
+  vector<WalRecord> records;
+  size_t            current_begin = 0;  // the records of the last WAL
+  for (uint64_t wal_id : wal_ids) {
+    current_begin = records.size();
+    RC rc         = WAL().recover(get_wal_path(wal_id), records);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to recover wal file, wal id=%lu, rc=%s", wal_id, strrc(rc));
+      return rc;
+    }
+  }
+
+  uint64_t last_seq = seq_.load();
+  for (const WalRecord &record : records) {
+    mem_table_->put(record.seq, record.key, record.val);
+    last_seq = std::max(last_seq, record.seq);
+  }
+  seq_.store(last_seq);
+  if (!wal_ids.empty()) {
+    memtable_id_.store(wal_ids.back());
+  }
+
+  wal_  = std::make_shared<WAL>();
+  RC rc = wal_->open(get_wal_path(memtable_id_.load()));
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to open wal file, rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // All the records are in the current memtable now, copy the records of the older WALs into the current WAL,
+  // then the older WALs can be removed.
+  if (wal_ids.size() > 1) {
+    for (size_t i = 0; i < current_begin && OB_SUCC(rc); i++) {
+      rc = wal_->put(records[i].seq, records[i].key, records[i].val);
+    }
+    if (OB_FAIL(rc) || OB_FAIL(rc = wal_->sync())) {
+      LOG_ERROR("Failed to rewrite wal records, rc=%s", strrc(rc));
+      return rc;
+    }
+    for (size_t i = 0; i + 1 < wal_ids.size(); i++) {
+      filesystem::remove(get_wal_path(wal_ids[i]));
+    }
+  }
+
+  LOG_INFO("recovered %lu records from %lu wal files", records.size(), wal_ids.size());
+  return RC::SUCCESS;
+}
+
 RC ObLsmImpl::recover_from_manifest_records(const std::vector<ObManifestCompaction> &records)
 {
   std::vector<std::vector<uint64_t>> tmp_sstables;
@@ -430,6 +932,17 @@ RC ObLsmImpl::load_manifest_sstable(const std::vector<std::vector<uint64_t>> &ss
       cur_level.emplace_back(sstable);
     }
   }
+  // the sstables of a level except level 0 are sorted by key, which is not the order of the records
+  if (options_.type == CompactionType::LEVELED) {
+    for (size_t level = 1; level < sstables_->size(); ++level) {
+      auto &level_i = sstables_->at(level);
+      std::sort(level_i.begin(), level_i.end(), [this](const auto &a, const auto &b) {
+        return a->block_count() > 0 && b->block_count() > 0 &&
+               default_comparator_.compare(a->smallest_user_key(), b->smallest_user_key()) < 0;
+      });
+    }
+  }
+  install_version();
   return RC::SUCCESS;
 }
 
@@ -16,6 +16,8 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/atomic.h"
 #include "common/lang/memory.h"
 #include "common/lang/condition_variable.h"
+#include "common/lang/deque.h"
+#include "common/lang/functional.h"
 #include "common/lang/utility.h"
 #include "common/thread/thread_pool_executor.h"
 #include "oblsm/include/ob_lsm_transaction.h"
@@ -24,6 +26,8 @@ See the Mulan PSL v2 for more details. */
 #include "oblsm/util/ob_lru_cache.h"
 #include "oblsm/compaction/ob_compaction.h"
 #include "oblsm/ob_manifest.h"
+#include "oblsm/ob_lsm_snapshot.h"
+#include "oblsm/util/ob_rate_limiter.h"
 #include "oblsm/wal/ob_lsm_wal.h"
 
 namespace oceanbase {
@@ -35,6 +39,19 @@ struct ObLsmBgCompactCtx
   uint64_t new_memtable_id;
 };
 
+/**
+ * @brief The memtables and sstables which are visible to readers.
+ *
+ * A version is never changed after it is installed. The writers build a new version and install it whenever the
+ * memtable is frozen or the sstables are changed, and the readers take the current version without locking.
+ */
+struct ObLsmVersion
+{
+  shared_ptr<ObMemTable>         mem_table;
+  vector<shared_ptr<ObMemTable>> imem_tables;  ///< from the oldest to the newest
+  SSTablesPtr                    sstables;
+};
+
 class ObLsmImpl : public ObLsm
 {
 public:
@@ -63,10 +80,50 @@ public:
   RC recover();
   RC batch_put(const std::vector<pair<string, string>> &kvs) override;
 
+  RC write(ObLsmWriteBatch *batch) override;
+
   // used for debug
   void dump_sstables() override;
 
+  ObLsmBlockCacheStats block_cache_stats() const override;
+
 private:
+  /**
+   * @brief A write batch waiting in the writer queue.
+   *
+   * The writer at the front of the queue is the leader. It takes the writers queued behind it as a group, writes
+   * them to the WAL as one record with one sync, applies them to the memtable, then wakes them up with the result.
+   */
+  struct Writer
+  {
+    explicit Writer(ObLsmWriteBatch *b) : batch(b) {}
+
+    ObLsmWriteBatch   *batch;
+    bool               done = false;
+    RC                 rc   = RC::SUCCESS;
+    condition_variable cv;
+  };
+
+  /**
+   * @brief Writes a group of writers to the WAL and the memtable, called by the leader.
+   *
+   * @param lock The lock of `mu_`, it is released while writing the WAL and the memtable.
+   * @param last_writer The last writer of the group.
+   */
+  RC write_group(unique_lock<mutex> &lock, Writer *&last_writer);
+
+  /**
+   * @brief Installs a new version with the current memtables and sstables, `mu_` must be held.
+   *
+   * @note `sstables_` is shared by the versions, so it must be replaced rather than modified in place.
+   */
+  void install_version();
+
+  /**
+   * @brief Looks up a key in the sstables of a version, from the newest to the oldest.
+   */
+  RC get_from_sstables(const ObLsmVersion &version, const string_view &lookup_key, string *value);
+
   RC recover_from_wal();
   RC recover_from_manifest_records(const std::vector<ObManifestCompaction> &records);
   RC load_manifest_snapshot(const ObManifestSnapshot &snapshot);
@@ -93,23 +150,53 @@ private:
    * compacted, merges their data, and writes the merged data into new SSTable files.
    *
    * @param picked A pointer to the compaction plan that specifies the input SSTables to merge.
-   *               If `picked` is `nullptr`, no compaction is performed and an empty result is returned.
+   * @param results The newly created SSTables resulting from the compaction process, sorted by key.
    *
-   * @return vector<shared_ptr<ObSSTable>> A vector of shared pointers to the newly created SSTables
-   *                                       resulting from the compaction process.
+   * @return RC Status code, the SSTables created are removed if the compaction fails.
    *
    * @details
    * - The function retrieves the inputs (SSTables) from the `picked` compaction plan.
-   * - For each SSTable, it creates a new iterator to sequentially scan its data.
-   * - It merges the iterators using a merging iterator (`ObLsmIterator`).
+   * - The inputs are read by a merging iterator (`ObLsmIterator`) in the order of internal keys, the sorted
+   *   SSTables of a level which don't overlap are read one after another by a single iterator.
+   * - A version of a key is dropped if a newer version of the key is visible to the oldest live snapshot. A
+   *   deletion is dropped too if the oldest live snapshot can see it and the levels below don't contain the key.
    * - It writes the merged key-value pairs into new SSTable files using `ObSSTableBuilder`.
    * - If the size of the new SSTable exceeds a predefined size (`options_.table_size`),
-   *   the builder finalizes the current SSTable and starts a new one.
+   *   the builder finalizes the current SSTable and starts a new one. The versions of a key are never split into
+   *   two SSTables, so the new SSTables don't overlap.
    *
    * @warning Ensure that the `picked` object is properly populated with valid inputs.
    *
    */
-  vector<shared_ptr<ObSSTable>> do_compaction(ObCompaction *compaction);
+  RC do_compaction(ObCompaction *picked, vector<shared_ptr<ObSSTable>> &results);
+
+  /**
+   * @brief Splits a compaction into key ranges which are merged in parallel.
+   *
+   * @return The user keys splitting the key ranges, so there are `boundaries.size() + 1` subcompactions. The
+   * boundaries are the smallest keys of the input SSTables, chosen to give the subcompactions about the same input
+   * size. A compaction of less than two SSTables in size is not split.
+   */
+  vector<string> subcompaction_boundaries(const ObCompaction &picked) const;
+
+  /**
+   * @brief Merges the user keys of the inputs in [`begin`, `end`) into new SSTables, see `do_compaction()`.
+   *
+   * @param begin The first user key, `nullptr` means the smallest key of the inputs.
+   * @param end The user key after the range, `nullptr` means the range goes to the largest key of the inputs.
+   * @param smallest_snapshot The sequence of the oldest live snapshot.
+   * @param lower_sstables The SSTables below the output level.
+   */
+  RC do_subcompaction(const ObCompaction &picked, const string *begin, const string *end, uint64_t smallest_snapshot,
+      const vector<shared_ptr<ObSSTable>> &lower_sstables, vector<shared_ptr<ObSSTable>> &results);
+
+  /**
+   * @brief Runs `task(0)` ... `task(task_num - 1)` on the background threads and the calling thread, returns when they
+   * are all done.
+   *
+   * The calling thread takes the tasks no background thread has taken, so it never waits for an idle thread.
+   */
+  void run_in_parallel(size_t task_num, const function<void(size_t)> &task);
 
   /**
    * @brief Initiates a major compaction process.
@@ -135,12 +222,14 @@ private:
    *
    * Converts the data in an immutable MemTable (`imem`) into a new SSTable and writes
    * it to persistent storage. This step is usually part of the compaction pipeline.
+   * It only writes the file and doesn't need `mu_`, the caller adds the SSTable to `sstables_`.
    *
    * @param imem A shared pointer to the immutable MemTable (`ObMemTable`) to be converted
    *             into an SSTable.
+   * @param sstable The SSTable built.
    * @note The caller must ensure that `imem` is immutable and ready for conversion.
    */
-  void build_sstable(shared_ptr<ObMemTable> imem);
+  RC build_sstable(shared_ptr<ObMemTable> imem, shared_ptr<ObSSTable> &sstable);
 
   /**
    * @brief Retrieves the file path for a given SSTable.
@@ -172,11 +261,15 @@ private:
   atomic<uint64_t>                  sstable_id_{0};
   atomic<uint64_t>                  memtable_id_{0};
   condition_variable                cv_;
+  deque<Writer *>                   writers_;  ///< The writer queue of group commit, protected by `mu_`.
   // TODO: use global variable?
   const ObDefaultComparator                                  default_comparator_;
   const ObInternalKeyComparator                              internal_key_comparator_;
   atomic<bool>                                               compacting_ = false;
   std::unique_ptr<ObLRUCache<uint64_t, shared_ptr<ObBlock>>> block_cache_;
+  ObLsmSnapshotList                                          snapshots_;  ///< The snapshots of the transactions.
+  ObRateLimiter compaction_rate_limiter_;  ///< Shared by the subcompactions, see `compaction_bytes_per_sec`.
+  atomic<shared_ptr<const ObLsmVersion>>                     version_;  ///< The current version, read without `mu_`.
 };
 
 }  // namespace oceanbase
\ No newline at end of file
@@ -0,0 +1,68 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/algorithm.h"
+#include "common/lang/atomic.h"
+#include "common/lang/mutex.h"
+#include "common/lang/set.h"
+
+namespace oceanbase {
+
+/**
+ * @class ObLsmSnapshotList
+ * @brief The sequences of the live snapshots of an LSM-Tree, such as the snapshots of transactions.
+ *
+ * A version of a key which is shadowed by a newer version can be dropped by compaction only if no live snapshot can
+ * see it, see `ObLsmImpl::do_compaction()`.
+ */
+class ObLsmSnapshotList
+{
+public:
+  /**
+   * @brief Takes the latest sequence as a new snapshot.
+   *
+   * The sequence is read under the lock, so a compaction never misses a snapshot older than the one it takes in
+   * `oldest()`.
+   */
+  uint64_t acquire(const atomic<uint64_t> &latest_seq)
+  {
+    lock_guard<mutex> guard(mutex_);
+    const uint64_t    seq = latest_seq.load();
+    seqs_.insert(seq);
+    return seq;
+  }
+
+  void release(uint64_t seq)
+  {
+    lock_guard<mutex> guard(mutex_);
+    auto              iter = seqs_.find(seq);
+    if (iter != seqs_.end()) {
+      seqs_.erase(iter);
+    }
+  }
+
+  /**
+   * @brief Returns the sequence of the oldest live snapshot, or `latest_seq` if there is no live snapshot.
+   */
+  uint64_t oldest(const atomic<uint64_t> &latest_seq) const
+  {
+    lock_guard<mutex> guard(mutex_);
+    const uint64_t    seq = latest_seq.load();
+    return seqs_.empty() ? seq : std::min(*seqs_.begin(), seq);
+  }
+
+private:
+  mutable mutex           mutex_;
+  std::multiset<uint64_t> seqs_;
+};
+
+}  // namespace oceanbase
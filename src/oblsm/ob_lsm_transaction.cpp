@@ -9,6 +9,7 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "oblsm/include/ob_lsm_transaction.h"
+#include "oblsm/ob_lsm_snapshot.h"
 #include "oblsm/util/ob_comparator.h"
 #include "common/lang/memory.h"
 
@@ -40,10 +41,17 @@ private:
   unique_ptr<ObLsmIterator> right_;
 };
 
-ObLsmTransaction::ObLsmTransaction(ObLsm *db, uint64_t ts) : db_(db), ts_(ts)
+ObLsmTransaction::ObLsmTransaction(ObLsm *db, uint64_t ts, ObLsmSnapshotList *snapshots)
+    : db_(db), ts_(ts), snapshots_(snapshots)
 {
   (void)db_;
-  (void)ts_;
+}
+
+ObLsmTransaction::~ObLsmTransaction()
+{
+  if (snapshots_ != nullptr) {
+    snapshots_->release(ts_);
+  }
 }
 
 RC ObLsmTransaction::get(const string_view &key, string *value) { return RC::UNIMPLEMENTED; }
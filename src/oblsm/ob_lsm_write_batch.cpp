@@ -0,0 +1,96 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "oblsm/include/ob_lsm_write_batch.h"
+#include "oblsm/util/ob_coding.h"
+
+namespace oceanbase {
+
+// sequence(uint64_t) + count(uint32_t)
+static constexpr size_t WRITE_BATCH_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+ObLsmWriteBatch::ObLsmWriteBatch() { clear(); }
+
+void ObLsmWriteBatch::put(const string_view &key, const string_view &value)
+{
+  put_numeric<uint32_t>(&rep_, static_cast<uint32_t>(key.size()));
+  rep_.append(key.data(), key.size());
+  put_numeric<uint32_t>(&rep_, static_cast<uint32_t>(value.size()));
+  rep_.append(value.data(), value.size());
+  const uint32_t new_count = count() + 1;
+  memcpy(rep_.data() + sizeof(uint64_t), &new_count, sizeof(new_count));
+}
+
+// an empty value means deletion, the same as memtable and sstable
+void ObLsmWriteBatch::remove(const string_view &key) { put(key, string_view()); }
+
+void ObLsmWriteBatch::clear() { rep_.assign(WRITE_BATCH_HEADER_SIZE, '\0'); }
+
+void ObLsmWriteBatch::append(const ObLsmWriteBatch &other)
+{
+  const uint32_t new_count = count() + other.count();
+  rep_.append(other.rep_, WRITE_BATCH_HEADER_SIZE);
+  memcpy(rep_.data() + sizeof(uint64_t), &new_count, sizeof(new_count));
+}
+
+uint32_t ObLsmWriteBatch::count() const { return get_numeric<uint32_t>(rep_.data() + sizeof(uint64_t)); }
+
+uint64_t ObLsmWriteBatch::sequence() const { return get_numeric<uint64_t>(rep_.data()); }
+
+void ObLsmWriteBatch::set_sequence(uint64_t seq) { memcpy(rep_.data(), &seq, sizeof(seq)); }
+
+RC ObLsmWriteBatch::set_data(const string_view &data)
+{
+  if (data.size() < WRITE_BATCH_HEADER_SIZE) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // check that every update is inside the buffer, so iterate() doesn't need to
+  const uint32_t num    = get_numeric<uint32_t>(data.data() + sizeof(uint64_t));
+  size_t         offset = WRITE_BATCH_HEADER_SIZE;
+  for (uint32_t i = 0; i < num; i++) {
+    for (int field = 0; field < 2; field++) {
+      if (data.size() - offset < sizeof(uint32_t)) {
+        return RC::INVALID_ARGUMENT;
+      }
+      const uint32_t len = get_numeric<uint32_t>(data.data() + offset);
+      offset += sizeof(uint32_t);
+      if (data.size() - offset < len) {
+        return RC::INVALID_ARGUMENT;
+      }
+      offset += len;
+    }
+  }
+  if (offset != data.size()) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  rep_.assign(data.data(), data.size());
+  return RC::SUCCESS;
+}
+
+void ObLsmWriteBatch::iterate(
+    const function<void(uint64_t seq, const string_view &key, const string_view &value)> &handler) const
+{
+  const uint64_t first_seq = sequence();
+  const uint32_t num       = count();
+  const char    *p         = rep_.data() + WRITE_BATCH_HEADER_SIZE;
+  for (uint32_t i = 0; i < num; i++) {
+    const uint32_t key_len = get_numeric<uint32_t>(p);
+    string_view    key(p + sizeof(uint32_t), key_len);
+    p += sizeof(uint32_t) + key_len;
+    const uint32_t value_len = get_numeric<uint32_t>(p);
+    string_view    value(p + sizeof(uint32_t), value_len);
+    p += sizeof(uint32_t) + value_len;
+    handler(first_seq + i, key, value);
+  }
+}
+
+}  // namespace oceanbase
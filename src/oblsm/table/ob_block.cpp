@@ -11,12 +11,39 @@ See the Mulan PSL v2 for more details. */
 #include "oblsm/table/ob_block.h"
 #include "oblsm/util/ob_coding.h"
 #include "common/lang/memory.h"
+#include "common/log/log.h"
 
 namespace oceanbase {
 
 RC ObBlock::decode(const string &data)
 {
-  return RC::UNIMPLEMENTED;
+  // the last 4 bytes is the start of the offsets(the size of all entries)
+  if (data.size() < 2 * sizeof(uint32_t)) {
+    LOG_WARN("block is too small to decode, size=%lu", data.size());
+    return RC::INVALID_ARGUMENT;
+  }
+  const char *data_end     = data.data() + data.size();
+  uint32_t    offset_start = get_numeric<uint32_t>(data_end - sizeof(uint32_t));
+  if (offset_start > data.size() - 2 * sizeof(uint32_t)) {
+    LOG_WARN("invalid block, offset start=%u, size=%lu", offset_start, data.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const char *p     = data.data() + offset_start;
+  uint32_t    count = get_numeric<uint32_t>(p);
+  p += sizeof(uint32_t);
+  if (p + count * sizeof(uint32_t) != data_end - sizeof(uint32_t)) {
+    LOG_WARN("invalid block, offset start=%u, entry count=%u, size=%lu", offset_start, count, data.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  offsets_.clear();
+  offsets_.reserve(count);
+  for (uint32_t i = 0; i < count; i++, p += sizeof(uint32_t)) {
+    offsets_.push_back(get_numeric<uint32_t>(p));
+  }
+  data_.assign(data.data(), offset_start);
+  return RC::SUCCESS;
 }
 
 string_view ObBlock::get_entry(uint32_t offset) const
@@ -70,13 +97,22 @@ RC BlockMeta::decode(const string &data)
 
 void BlockIterator::seek(const string_view &lookup_key)
 {
-   index_ = 0;
-   while(valid()) {
+  // the entries are sorted, find the first entry whose user key is not less than the lookup key
+  const string_view user_key = extract_user_key_from_lookup_key(lookup_key);
+  uint32_t          left     = 0;
+  uint32_t          right    = count_;
+  while (left < right) {
+    index_ = left + (right - left) / 2;
     parse_entry();
-    if (comparator_->compare(extract_user_key(key_), extract_user_key_from_lookup_key(lookup_key)) >= 0) {
-      break;
+    if (comparator_->compare(extract_user_key(key_), user_key) < 0) {
+      left = index_ + 1;
+    } else {
+      right = index_;
     }
-    index_++;
-   }
+  }
+  index_ = left;
+  if (valid()) {
+    parse_entry();
+  }
 }
 }  // namespace oceanbase
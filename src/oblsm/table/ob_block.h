@@ -60,6 +60,11 @@ public:
 
   int size() const { return offsets_.size(); }
 
+  /**
+   * @brief Approximate memory usage of the decoded block, used as the charge in the block cache.
+   */
+  size_t memory_size() const { return sizeof(ObBlock) + data_.size() + offsets_.size() * sizeof(uint32_t); }
+
   /**
    * @brief Decodes serialized block data.
    *
@@ -16,43 +16,193 @@ namespace oceanbase {
 
 void ObSSTable::init()
 {
-  // your code here
+  file_reader_ = ObFileReader::create_file_reader(file_name_);
+  if (file_reader_ == nullptr) {
+    LOG_ERROR("failed to open sstable %s", file_name_.c_str());
+    return;
+  }
+
+  uint32_t file_size = file_reader_->file_size();
+  file_size_         = file_size;
+  if (file_size < 3 * sizeof(uint32_t)) {
+    LOG_ERROR("invalid sstable %s, file size=%u", file_name_.c_str(), file_size);
+    return;
+  }
+  // the last 8 bytes are the offsets of the bloom filter and block metas
+  const uint32_t footer_size = 2 * sizeof(uint32_t);
+  string         footer      = file_reader_->read_pos(file_size - footer_size, footer_size);
+  if (footer.size() != footer_size) {
+    LOG_ERROR("failed to read the footer of sstable %s", file_name_.c_str());
+    return;
+  }
+  uint32_t filter_start = get_numeric<uint32_t>(footer.data());
+  uint32_t meta_start   = get_numeric<uint32_t>(footer.data() + sizeof(uint32_t));
+  if (meta_start > file_size - footer_size - sizeof(uint32_t) || filter_start > meta_start) {
+    LOG_ERROR("invalid sstable %s, file size=%u", file_name_.c_str(), file_size);
+    return;
+  }
+
+  bloom_filter_.reset();
+  if (filter_start < meta_start) {
+    string filter = file_reader_->read_pos(filter_start, meta_start - filter_start);
+    bloom_filter_ = make_unique<ObBloomfilter>();
+    if (OB_FAIL(bloom_filter_->decode(filter))) {
+      // the sstable is still readable without the bloom filter
+      LOG_WARN("invalid bloom filter in sstable %s", file_name_.c_str());
+      bloom_filter_.reset();
+    }
+  }
+
+  string      metas     = file_reader_->read_pos(meta_start, file_size - footer_size - meta_start);
+  const char *p         = metas.data();
+  const char *metas_end = metas.data() + metas.size();
+  uint32_t    meta_num  = get_numeric<uint32_t>(p);
+  p += sizeof(uint32_t);
+  block_metas_.clear();
+  block_metas_.reserve(meta_num);
+  for (uint32_t i = 0; i < meta_num && p + sizeof(uint32_t) <= metas_end; i++) {
+    uint32_t meta_size = get_numeric<uint32_t>(p);
+    p += sizeof(uint32_t);
+    BlockMeta block_meta;
+    block_meta.decode(string(p, meta_size));
+    block_metas_.emplace_back(std::move(block_meta));
+    p += meta_size;
+  }
+  if (block_metas_.size() != meta_num) {
+    LOG_ERROR("invalid sstable %s, expect %u block metas but got %lu", file_name_.c_str(), meta_num, block_metas_.size());
+  }
 }
 
 shared_ptr<ObBlock> ObSSTable::read_block_with_cache(uint32_t block_idx) const
 {
-  // your code here
-  return nullptr;
+  if (block_cache_ == nullptr) {
+    return read_block(block_idx);
+  }
+
+  const uint64_t      cache_key = block_cache_key(block_idx);
+  shared_ptr<ObBlock> block;
+  if (block_cache_->get(cache_key, block)) {
+    return block;
+  }
+
+  block = read_block(block_idx);
+  if (block != nullptr) {
+    block_cache_->put(cache_key, block, block->memory_size());
+  }
+  return block;
 }
 
 shared_ptr<ObBlock> ObSSTable::read_block(uint32_t block_idx) const
 {
-  // your code here
-  return nullptr;
+  if (block_idx >= block_metas_.size()) {
+    LOG_WARN("block index out of range. sstable=%s, block index=%u, block count=%lu",
+             file_name_.c_str(), block_idx, block_metas_.size());
+    return nullptr;
+  }
+
+  const BlockMeta    &block_meta = block_metas_[block_idx];
+  string              contents   = file_reader_->read_pos(block_meta.offset_, block_meta.size_);
+  shared_ptr<ObBlock> block      = make_shared<ObBlock>(comparator_);
+  RC                  rc         = block->decode(contents);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to decode block. sstable=%s, block index=%u, rc=%s", file_name_.c_str(), block_idx, strrc(rc));
+    return nullptr;
+  }
+  return block;
 }
 
-void ObSSTable::remove() { filesystem::remove(file_name_); }
+void ObSSTable::remove()
+{
+  // the sstable id is never reused, but there is no need to keep the blocks in cache any more
+  if (block_cache_ != nullptr) {
+    for (uint32_t i = 0; i < block_metas_.size(); i++) {
+      block_cache_->erase(block_cache_key(i));
+    }
+  }
+  filesystem::remove(file_name_);
+}
 
 ObLsmIterator *ObSSTable::new_iterator() { return new TableIterator(get_shared_ptr()); }
 
+bool ObSSTable::may_contain(const string_view &user_key) const
+{
+  if (block_metas_.empty()) {
+    return false;
+  }
+  if (comparator_->compare(user_key, smallest_user_key()) < 0 ||
+      comparator_->compare(user_key, largest_user_key()) > 0) {
+    return false;
+  }
+  return bloom_filter_ == nullptr || bloom_filter_->contains(user_key);
+}
+
+uint32_t ObSSTable::find_block(const string_view &user_key) const
+{
+  uint32_t left  = 0;
+  uint32_t right = block_metas_.size();
+  while (left < right) {
+    uint32_t mid = left + (right - left) / 2;
+    if (comparator_->compare(extract_user_key(block_metas_[mid].last_key_), user_key) < 0) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  return left;
+}
+
+RC ObSSTable::get(const string_view &lookup_key, string *value)
+{
+  const string_view user_key = extract_user_key_from_lookup_key(lookup_key);
+  if (!may_contain(user_key)) {
+    return RC::NOT_EXIST;
+  }
+
+  const uint64_t seq = extract_sequence(extract_internal_key(lookup_key));
+  TableIterator  iter(get_shared_ptr());
+  // the seek stops at the newest version of the key, skip the versions newer than the lookup key
+  for (iter.seek(lookup_key); iter.valid(); iter.next()) {
+    if (comparator_->compare(extract_user_key(iter.key()), user_key) != 0) {
+      break;
+    }
+    if (extract_sequence(iter.key()) <= seq) {
+      value->assign(iter.value());
+      return RC::SUCCESS;
+    }
+  }
+  return RC::NOT_EXIST;
+}
+
 void TableIterator::read_block_with_cache()
 {
   block_ = sst_->read_block_with_cache(curr_block_idx_);
-  block_iterator_.reset(block_->new_iterator());
+  block_iterator_.reset(block_ == nullptr ? nullptr : block_->new_iterator());
 }
 
 void TableIterator::seek_to_first()
 {
   curr_block_idx_ = 0;
+  if (block_cnt_ == 0) {
+    block_iterator_ = nullptr;
+    return;
+  }
   read_block_with_cache();
-  block_iterator_->seek_to_first();
+  if (block_iterator_ != nullptr) {
+    block_iterator_->seek_to_first();
+  }
 }
 
 void TableIterator::seek_to_last()
 {
+  if (block_cnt_ == 0) {
+    block_iterator_ = nullptr;
+    return;
+  }
   curr_block_idx_ = block_cnt_ - 1;
   read_block_with_cache();
-  block_iterator_->seek_to_last();
+  if (block_iterator_ != nullptr) {
+    block_iterator_->seek_to_last();
+  }
 }
 
 void TableIterator::next()
@@ -62,26 +212,100 @@ void TableIterator::next()
   } else if (curr_block_idx_ < block_cnt_ - 1) {
     curr_block_idx_++;
     read_block_with_cache();
-    block_iterator_->seek_to_first();
+    if (block_iterator_ != nullptr) {
+      block_iterator_->seek_to_first();
+    }
   }
 }
 
 void TableIterator::seek(const string_view &lookup_key)
 {
-  curr_block_idx_ = 0;
-  // TODO: use binary search
-  for (; curr_block_idx_ < block_cnt_; curr_block_idx_++) {
-    const auto &block_meta = sst_->block_meta(curr_block_idx_);
-    if (sst_->comparator()->compare(extract_user_key(block_meta.last_key_), extract_user_key_from_lookup_key(lookup_key)) >= 0) {
-      break;
-    }
-  }
+  curr_block_idx_ = sst_->find_block(extract_user_key_from_lookup_key(lookup_key));
   if (curr_block_idx_ == block_cnt_) {
     block_iterator_ = nullptr;
     return;
   }
   read_block_with_cache();
-  block_iterator_->seek(lookup_key);
+  if (block_iterator_ != nullptr) {
+    block_iterator_->seek(lookup_key);
+  }
+}
+
+class ObConcatIterator : public ObLsmIterator
+{
+public:
+  explicit ObConcatIterator(const vector<shared_ptr<ObSSTable>> &sstables) : sstables_(sstables) {}
+  ~ObConcatIterator() override = default;
+
+  bool valid() const override { return iter_ != nullptr && iter_->valid(); }
+
+  void seek_to_first() override
+  {
+    open_sstable(0);
+    if (iter_ != nullptr) {
+      iter_->seek_to_first();
+    }
+    skip_empty_sstables();
+  }
+
+  void seek_to_last() override
+  {
+    open_sstable(sstables_.size() - 1);
+    if (iter_ != nullptr) {
+      iter_->seek_to_last();
+    }
+  }
+
+  void seek(const string_view &lookup_key) override
+  {
+    // the first sstable whose largest key is not less than the key
+    const string_view user_key = extract_user_key_from_lookup_key(lookup_key);
+    size_t            idx      = 0;
+    while (idx < sstables_.size() &&
+           sstables_[idx]->comparator()->compare(sstables_[idx]->largest_user_key(), user_key) < 0) {
+      idx++;
+    }
+    open_sstable(idx);
+    if (iter_ != nullptr) {
+      iter_->seek(lookup_key);
+    }
+    skip_empty_sstables();
+  }
+
+  void next() override
+  {
+    iter_->next();
+    skip_empty_sstables();
+  }
+
+  string_view key() const override { return iter_->key(); }
+  string_view value() const override { return iter_->value(); }
+
+private:
+  void open_sstable(size_t idx)
+  {
+    idx_ = idx;
+    iter_.reset(idx_ < sstables_.size() ? sstables_[idx_]->new_iterator() : nullptr);
+  }
+
+  void skip_empty_sstables()
+  {
+    while (iter_ != nullptr && !iter_->valid()) {
+      open_sstable(idx_ + 1);
+      if (iter_ != nullptr) {
+        iter_->seek_to_first();
+      }
+    }
+  }
+
+  const vector<shared_ptr<ObSSTable>> sstables_;
+  size_t                              idx_ = 0;
+  unique_ptr<ObLsmIterator>           iter_;
 };
 
+ObLsmIterator *new_concat_iterator(const vector<shared_ptr<ObSSTable>> &sstables)
+{
+  return new ObConcatIterator(sstables);
+}
+
 }  // namespace oceanbase
@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/memory.h"
 #include "common/sys/rc.h"
 #include "oblsm/table/ob_block.h"
+#include "oblsm/util/ob_bloomfilter.h"
+#include "oblsm/util/ob_coding.h"
 #include "oblsm/util/ob_comparator.h"
 #include "oblsm/util/ob_lru_cache.h"
 
@@ -28,20 +30,25 @@ namespace oceanbase {
 //    ├─────────────────┤   │
 //    │    block n      │◄┐ │
 //    ├─────────────────┤ │ │
-// ┌─►│  meta size(n)   │ │ │
+// ┌─►│  bloom filter   │ │ │
 // │  ├─────────────────┤ │ │
-// │  │block meta 1 size│ │ │
-// │  ├─────────────────┤ │ │
-// │  │  block meta 1   ┼─┼─┘
-// │  ├─────────────────┤ │
-// │  │      ..         │ │
-// │  ├─────────────────┤ │
-// │  │block meta n size│ │
-// │  ├─────────────────┤ │
-// │  │  block meta n   ┼─┘
-// │  ├─────────────────┤
-// └──┼                 │
+// │┌►│  meta size(n)   │ │ │
+// ││ ├─────────────────┤ │ │
+// ││ │block meta 1 size│ │ │
+// ││ ├─────────────────┤ │ │
+// ││ │  block meta 1   ┼─┼─┘
+// ││ ├─────────────────┤ │
+// ││ │      ..         │ │
+// ││ ├─────────────────┤ │
+// ││ │block meta n size│ │
+// ││ ├─────────────────┤ │
+// ││ │  block meta n   ┼─┘
+// ││ ├─────────────────┤
+// └┼─┼  filter offset  │
+//  │ ├─────────────────┤
+//  └─┼   meta offset   │
 //    └─────────────────┘
+// The bloom filter of the user keys is empty if it is disabled, see `ObBloomfilter::encode()` for its format.
 
 /**
  * @class ObSSTable
@@ -72,9 +79,7 @@ public:
         comparator_(comparator),
         file_reader_(nullptr),
         block_cache_(block_cache)
-  {
-    (void)block_cache_;
-  }
+  {}
 
   ~ObSSTable() = default;
 
@@ -94,6 +99,22 @@ public:
 
   ObLsmIterator *new_iterator();
 
+  /**
+   * @brief Checks whether the SSTable may contain the user key, by its key range and bloom filter.
+   *
+   * @return false if the SSTable definitely doesn't contain the key.
+   */
+  bool may_contain(const string_view &user_key) const;
+
+  /**
+   * @brief Looks up the newest version of a key which is visible to the sequence of the lookup key.
+   *
+   * @param lookup_key The lookup key, see `ObUserIterator::seek()`.
+   * @param value The value of the key, it is empty if the key was deleted.
+   * @return `RC::SUCCESS` if a version of the key is found, `RC::NOT_EXIST` otherwise.
+   */
+  RC get(const string_view &lookup_key, string *value);
+
   /**
    * @brief Reads a block from the SSTable using the block cache.
    *
@@ -120,9 +141,9 @@ public:
 
   uint32_t block_count() const { return block_metas_.size(); }
 
-  uint32_t size() const { return file_reader_->file_size(); }
+  uint32_t size() const { return file_size_; }
 
-  const BlockMeta block_meta(int i) const { return block_metas_[i]; }
+  const BlockMeta &block_meta(int i) const { return block_metas_[i]; }
 
   const ObComparator *comparator() const { return comparator_; }
 
@@ -130,12 +151,31 @@ public:
   string first_key() const { return block_metas_.empty() ? "" : block_metas_[0].first_key_; }
   string last_key() const { return block_metas_.empty() ? "" : block_metas_.back().last_key_; }
 
+  /**
+   * @brief The smallest and largest user keys of the SSTable, the SSTable must not be empty.
+   */
+  string_view smallest_user_key() const { return extract_user_key(block_metas_[0].first_key_); }
+  string_view largest_user_key() const { return extract_user_key(block_metas_.back().last_key_); }
+
+  /**
+   * @brief Returns the index of the first block whose last key is not less than the user key, or `block_count()`.
+   */
+  uint32_t find_block(const string_view &user_key) const;
+
+private:
+  /**
+   * @brief Key of a block in the block cache, sstable id in the high 32 bits and block index in the low 32 bits.
+   */
+  uint64_t block_cache_key(uint32_t block_idx) const { return (static_cast<uint64_t>(sst_id_) << 32) | block_idx; }
+
 private:
   uint32_t                 sst_id_;
   string                   file_name_;
   const ObComparator      *comparator_ = nullptr;
   unique_ptr<ObFileReader> file_reader_;
+  uint32_t                 file_size_ = 0;
   vector<BlockMeta>        block_metas_;
+  unique_ptr<ObBloomfilter> bloom_filter_;  ///< nullptr if the SSTable has no bloom filter
 
   ObLRUCache<uint64_t, shared_ptr<ObBlock>> *block_cache_;
 };
@@ -164,6 +204,12 @@ private:
   unique_ptr<ObLsmIterator>   block_iterator_;
 };
 
+/**
+ * @brief Creates an iterator over sorted SSTables which don't overlap with each other, such as the SSTables of a level
+ * except level 0. The SSTables are read one by one, so it is cheaper than merging them.
+ */
+ObLsmIterator *new_concat_iterator(const vector<shared_ptr<ObSSTable>> &sstables);
+
 using SSTablesPtr = shared_ptr<vector<vector<shared_ptr<ObSSTable>>>>;
 
 }  // namespace oceanbase
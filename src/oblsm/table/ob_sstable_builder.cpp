@@ -9,25 +9,149 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "oblsm/table/ob_sstable_builder.h"
+#include "common/lang/algorithm.h"
+#include "oblsm/util/ob_bloomfilter.h"
 #include "oblsm/util/ob_coding.h"
+#include "common/log/log.h"
 
 namespace oceanbase {
 
-// TODO: refactor build with mem_table/iterator logic.
 RC ObSSTableBuilder::build(shared_ptr<ObMemTable> mem_table, const std::string &file_name, uint32_t sst_id)
 {
-  return RC::UNIMPLEMENTED;
+  RC rc = open(file_name, sst_id);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  unique_ptr<ObLsmIterator> iter(mem_table->new_iterator());
+  for (iter->seek_to_first(); iter->valid() && OB_SUCC(rc); iter->next()) {
+    rc = add(iter->key(), iter->value());
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return finish();
+}
+
+RC ObSSTableBuilder::open(const string &file_name, uint32_t sst_id)
+{
+  reset();
+  sst_id_      = sst_id;
+  file_writer_ = ObFileWriter::create_file_writer(file_name, false);
+  if (file_writer_ == nullptr) {
+    LOG_WARN("failed to create sstable file %s", file_name.c_str());
+    return RC::IOERR_OPEN;
+  }
+  file_writer_->set_rate_limiter(rate_limiter_);
+  return RC::SUCCESS;
+}
+
+RC ObSSTableBuilder::add(const string_view &key, const string_view &value)
+{
+  if (curr_blk_first_key_.empty()) {
+    curr_blk_first_key_.assign(key.data(), key.size());
+  }
+  if (bloom_filter_bits_per_key_ > 0) {
+    // the versions of a key are adjacent
+    string_view user_key = extract_user_key(key);
+    if (bloom_filter_keys_.empty() || bloom_filter_keys_.back() != user_key) {
+      bloom_filter_keys_.emplace_back(user_key);
+    }
+  }
+  RC rc = block_builder_.add(key, value);
+  if (rc == RC::FULL) {
+    if (OB_FAIL(rc = finish_build_block())) {
+      return rc;
+    }
+    curr_blk_first_key_.assign(key.data(), key.size());
+    rc = block_builder_.add(key, value);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to add kv to block, rc=%s", strrc(rc));
+  }
+  return rc;
 }
 
-void ObSSTableBuilder::finish_build_block()
+RC ObSSTableBuilder::finish()
+{
+  RC rc = RC::SUCCESS;
+  if (!curr_blk_first_key_.empty()) {
+    if (OB_FAIL(rc = finish_build_block())) {
+      return rc;
+    }
+  }
+
+  const uint32_t filter_offset = curr_offset_;
+  if (OB_FAIL(rc = write_bloom_filter())) {
+    return rc;
+  }
+
+  // block metas, see the layout in ObSSTable
+  const string  &file_name   = file_writer_->file_name();
+  const uint32_t meta_offset = curr_offset_;
+  string         meta_contents;
+  put_numeric<uint32_t>(&meta_contents, block_metas_.size());
+  for (const BlockMeta &block_meta : block_metas_) {
+    string meta = block_meta.encode();
+    put_numeric<uint32_t>(&meta_contents, meta.size());
+    meta_contents.append(meta);
+  }
+  put_numeric<uint32_t>(&meta_contents, filter_offset);
+  put_numeric<uint32_t>(&meta_contents, meta_offset);
+  if (OB_FAIL(rc = file_writer_->write(meta_contents))) {
+    LOG_WARN("failed to write block metas to sstable %s, rc=%s", file_name.c_str(), strrc(rc));
+    return rc;
+  }
+  // the sstable must be durable before the WAL or the compaction inputs it replaces are removed
+  if (OB_FAIL(rc = file_writer_->sync())) {
+    LOG_WARN("failed to sync sstable %s, rc=%s", file_name.c_str(), strrc(rc));
+    return rc;
+  }
+  file_size_ = curr_offset_ + meta_contents.size();
+  return rc;
+}
+
+RC ObSSTableBuilder::write_bloom_filter()
+{
+  if (bloom_filter_keys_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  // k = ln2 * bits_per_key minimizes the false positive rate, it is about 1% with 10 bits per key
+  const size_t  num_hash = std::clamp<size_t>(bloom_filter_bits_per_key_ * 69 / 100, 1, 30);
+  const size_t  num_bits = std::max<size_t>(bloom_filter_keys_.size() * bloom_filter_bits_per_key_, 64);
+  ObBloomfilter filter(num_hash, num_bits);
+  for (const string &key : bloom_filter_keys_) {
+    filter.insert(key);
+  }
+  bloom_filter_keys_.clear();
+
+  string contents;
+  filter.encode(&contents);
+  RC rc = file_writer_->write(contents);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write bloom filter to sstable %s, rc=%s", file_writer_->file_name().c_str(), strrc(rc));
+    return rc;
+  }
+  curr_offset_ += contents.size();
+  return rc;
+}
+
+RC ObSSTableBuilder::finish_build_block()
 {
   string      last_key       = block_builder_.last_key();
   string_view block_contents = block_builder_.finish();
-  file_writer_->write(block_contents);
+  RC          rc             = file_writer_->write(block_contents);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write block to sstable %s, rc=%s", file_writer_->file_name().c_str(), strrc(rc));
+    return rc;
+  }
   block_metas_.push_back(BlockMeta(curr_blk_first_key_, last_key, curr_offset_, block_contents.size()));
   // TODO: block aligned to BLOCK_SIZE
   curr_offset_ += block_contents.size();
   block_builder_.reset();
+  curr_blk_first_key_.clear();
+  return rc;
 }
 
 shared_ptr<ObSSTable> ObSSTableBuilder::get_built_table()
@@ -46,6 +170,7 @@ void ObSSTableBuilder::reset()
     file_writer_.reset(nullptr);
   }
   block_metas_.clear();
+  bloom_filter_keys_.clear();
   curr_offset_ = 0;
   sst_id_      = 0;
   file_size_   = 0;
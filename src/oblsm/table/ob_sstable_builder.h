@@ -27,8 +27,12 @@ namespace oceanbase {
 class ObSSTableBuilder
 {
 public:
-  ObSSTableBuilder(const ObComparator *comparator, ObLRUCache<uint64_t, shared_ptr<ObBlock>> *block_cache)
-      : comparator_(comparator), block_cache_(block_cache)
+  /**
+   * @param bloom_filter_bits_per_key The bits of the bloom filter for every key, 0 means no bloom filter is built.
+   */
+  ObSSTableBuilder(const ObComparator *comparator, ObLRUCache<uint64_t, shared_ptr<ObBlock>> *block_cache,
+      size_t bloom_filter_bits_per_key = 0)
+      : comparator_(comparator), bloom_filter_bits_per_key_(bloom_filter_bits_per_key), block_cache_(block_cache)
   {}
   ~ObSSTableBuilder() = default;
 
@@ -45,15 +49,38 @@ public:
    * @return RC A result code indicating the success or failure of the SSTable creation process.
    *
    */
-  RC                    build(shared_ptr<ObMemTable> mem_table, const string &file_name, uint32_t sst_id);
+  RC build(shared_ptr<ObMemTable> mem_table, const string &file_name, uint32_t sst_id);
+
+  /**
+   * @brief Starts to build an SSTable entry by entry, used when the entries come from an iterator (e.g. compaction).
+   *
+   * The entries are added by `add()` in the order of internal keys, then `finish()` completes the SSTable file.
+   */
+  RC open(const string &file_name, uint32_t sst_id);
+  RC add(const string_view &key, const string_view &value);
+  RC finish();
+
+  /**
+   * @brief The size of the SSTable if it is finished now, without the block metas.
+   */
+  size_t estimated_size() const { return curr_offset_ + block_builder_.appro_size(); }
+
+  /**
+   * @brief Limits the write rate of the SSTables opened after it is called, `nullptr` means no limit.
+   */
+  void set_rate_limiter(ObRateLimiter *rate_limiter) { rate_limiter_ = rate_limiter; }
+
   size_t                file_size() const { return file_size_; }
   shared_ptr<ObSSTable> get_built_table();
   void                  reset();
 
 private:
-  void finish_build_block();
+  RC finish_build_block();
+  RC write_bloom_filter();
 
   const ObComparator      *comparator_ = nullptr;
+  size_t                   bloom_filter_bits_per_key_ = 0;
+  vector<string>           bloom_filter_keys_;  ///< the distinct user keys of the sstable
   ObBlockBuilder           block_builder_;
   string                   curr_blk_first_key_;
   unique_ptr<ObFileWriter> file_writer_;
@@ -62,6 +89,7 @@ private:
   uint32_t                 sst_id_      = 0;
   size_t                   file_size_   = 0;
 
-  ObLRUCache<uint64_t, shared_ptr<ObBlock>> *block_cache_ = nullptr;
+  ObLRUCache<uint64_t, shared_ptr<ObBlock>> *block_cache_  = nullptr;
+  ObRateLimiter                             *rate_limiter_ = nullptr;
 };
 }  // namespace oceanbase
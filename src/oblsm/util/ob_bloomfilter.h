@@ -11,6 +11,9 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/lang/string.h"
+#include "common/lang/string_view.h"
+#include "common/sys/rc.h"
+#include "oblsm/util/ob_coding.h"
 #include <algorithm>
 #include <mutex>
 namespace oceanbase {
@@ -45,13 +48,14 @@ public:
    * @details This method computes hash values for the given object and sets corresponding bits in the filter.
    * @param object The object to be inserted.
    */
-  void insert(const string &object)
+  void insert(const string_view &object)
   {
-    auto indexs = hash(object.data(), object.size());
+    const uint64_t   h1 = fnv_1a(object.data(), object.size(), 0);
+    const uint64_t   h2 = fnv_1a(object.data(), object.size(), 1);
     std::scoped_lock insert_latch{latch_};
     ++obj_cnt_;
-    for (std::size_t idx : indexs) {
-      set(idx);
+    for (int i = 0; i < num_hash_; ++i) {
+      set(index(h1, h2, i));
     }
   }
 
@@ -74,12 +78,54 @@ public:
    * @param object The object to be checked.
    * @return true if the object might be in the filter, false if definitely not.
    */
-  bool contains(const string &object) const
+  bool contains(const string_view &object) const
   {
-    auto indexs = hash(object.data(), object.size());
-
+    const uint64_t h1 = fnv_1a(object.data(), object.size(), 0);
+    const uint64_t h2 = fnv_1a(object.data(), object.size(), 1);
     // mqybe false positive
-    return std::all_of(indexs.begin(), indexs.end(), [this](std::size_t idx) { return get(idx); });
+    for (int i = 0; i < num_hash_; ++i) {
+      if (!get(index(h1, h2, i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Serializes the Bloom filter, it is stored in the SSTable.
+   *
+   * @details Format: hash function count(uint32_t) | total bits(uint64_t) | object count(uint64_t) | bits
+   */
+  void encode(string *dst) const
+  {
+    put_numeric<uint32_t>(dst, num_hash_);
+    put_numeric<uint64_t>(dst, capacity_);
+    put_numeric<uint64_t>(dst, obj_cnt_);
+    dst->append(reinterpret_cast<const char *>(data_.data()), data_.size());
+  }
+
+  /**
+   * @brief Replaces the content of the Bloom filter with a serialized one, see `encode()`.
+   *
+   * @return `RC::INVALID_ARGUMENT` if the serialized Bloom filter is malformed.
+   */
+  RC decode(const string_view &data)
+  {
+    const size_t header_size = sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    if (data.size() < header_size) {
+      return RC::INVALID_ARGUMENT;
+    }
+    const uint32_t num_hash = get_numeric<uint32_t>(data.data());
+    const uint64_t capacity = get_numeric<uint64_t>(data.data() + sizeof(uint32_t));
+    const uint64_t obj_cnt  = get_numeric<uint64_t>(data.data() + sizeof(uint32_t) + sizeof(uint64_t));
+    if (capacity == 0 || data.size() - header_size != (capacity + 7) / 8) {
+      return RC::INVALID_ARGUMENT;
+    }
+    num_hash_ = num_hash;
+    capacity_ = capacity;
+    obj_cnt_  = obj_cnt;
+    data_.assign(data.begin() + header_size, data.end());
+    return RC::SUCCESS;
   }
 
   /**
@@ -98,7 +144,7 @@ public:
   {
     std::size_t local_idx = idx / 8;
     std::size_t offset    = 7 - (idx % 8);
-    uint8_t    &num       = data_.at(local_idx);
+    uint8_t    &num       = data_[local_idx];
 
     num = (0x1 << offset) | num;
   }
@@ -107,22 +153,14 @@ public:
   {
     std::size_t local_idx = idx / 8;
     std::size_t offset    = 7 - (idx % 8);
-    uint8_t     num       = data_.at(local_idx);
+    uint8_t     num       = data_[local_idx];
 
     return ((0x1 << offset) & num) != 0;
   }
 
 private:
-  auto hash(const char *key, const std::size_t len) const -> std::vector<std::size_t>
-  {
-    std::vector<std::size_t> result;
-    result.reserve(num_hash_);
-    for (int i = 0; i < num_hash_; ++i) {
-      uint64_t val = fnv_1a(key, len, i);
-      result.push_back(val % capacity_);
-    }
-    return result;
-  }
+  // the i-th hash is derived from two hashes (double hashing), the key is hashed only twice
+  auto index(uint64_t h1, uint64_t h2, int i) const -> std::size_t { return (h1 + i * h2) % capacity_; }
 
   // FNV-1a hash (http://www.isthe.com/chongo/tech/comp/fnv/)
   static uint64_t fnv_1a(const char *key, const std::size_t len, const int seed)
@@ -10,52 +10,74 @@ See the Mulan PSL v2 for more details. */
 
 #include "oblsm/util/ob_file_writer.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/log/log.h"
+#include "oblsm/util/ob_rate_limiter.h"
+
 namespace oceanbase {
 
 ObFileWriter::~ObFileWriter() { close_file(); }
 
 RC ObFileWriter::write(const string_view &data)
 {
-  RC rc = RC::SUCCESS;
-  file_  << data;
-  if (!file_.good()) {
-    rc = RC::IOERR_WRITE;
+  if (fd_ < 0) {
+    return RC::IOERR_WRITE;
   }
-  return rc;
+  if (rate_limiter_ != nullptr) {
+    rate_limiter_->request(data.size());
+  }
+
+  const char *buf  = data.data();
+  size_t      left = data.size();
+  while (left > 0) {
+    ssize_t ret = ::write(fd_, buf, left);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to write file %s, error=%s", filename_.c_str(), strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    buf += ret;
+    left -= ret;
+  }
+  return RC::SUCCESS;
 }
 
-RC ObFileWriter::flush()
+RC ObFileWriter::flush() { return fd_ < 0 ? RC::IOERR_SYNC : RC::SUCCESS; }
+
+RC ObFileWriter::sync()
 {
-  RC rc = RC::SUCCESS;
-  file_.flush();
-  if (!file_.good()) {
-    rc = RC::IOERR_SYNC;
+  if (fd_ < 0 || ::fdatasync(fd_) != 0) {
+    LOG_WARN("failed to sync file %s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_SYNC;
   }
-  return rc;
+  return RC::SUCCESS;
 }
 
 RC ObFileWriter::open_file()
 {
-  RC rc = RC::SUCCESS;
-  if (file_.is_open()) {
-    return rc;
-  }
-  if (append_) {
-    file_.open(filename_, std::ios::app | std::ios::binary);
-  } else {
-    file_.open(filename_, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (fd_ >= 0) {
+    return RC::SUCCESS;
   }
-  if (!file_.good()) {
-    rc = RC::IOERR_OPEN;
+  const int flags = O_WRONLY | O_CREAT | (append_ ? O_APPEND : O_TRUNC);
+  fd_             = ::open(filename_.c_str(), flags, 0644);
+  if (fd_ < 0) {
+    LOG_WARN("failed to open file %s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
   }
-  return rc;
+  return RC::SUCCESS;
 }
 
 void ObFileWriter::close_file()
 {
-  if (file_.is_open()) {
-    file_.flush();
-    file_.close();
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
   }
 }
 
@@ -10,7 +10,6 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
-#include "common/lang/fstream.h"
 #include "common/lang/string.h"
 #include "common/lang/string_view.h"
 #include "common/lang/memory.h"
@@ -18,15 +17,17 @@ See the Mulan PSL v2 for more details. */
 
 namespace oceanbase {
 
+class ObRateLimiter;
+
 /**
  * @class ObFileWriter
  * @brief A utility class for writing data to files.
  *
  * The `ObFileWriter` class provides a convenient interface for writing data to a file.
  * It supports creating and opening files for writing, appending data to existing files,
- * and flushing buffered data to disk. The class ensures proper resource management by
+ * and syncing the written data to disk. The class ensures proper resource management by
  * providing methods for explicitly closing the file.
- * TODO: use posix
+ * Data is written with posix `write()` and is not buffered in user space.
  */
 class ObFileWriter
 {
@@ -75,21 +76,37 @@ public:
   RC write(const string_view &data);
 
   /**
-   * @brief Flushes buffered data to disk.
+   * @brief Flushes buffered data to the operating system.
    *
-   * Ensures that all buffered data is written to the file system. This method is useful
-   * for ensuring data integrity in cases where the program may terminate unexpectedly.
+   * Nothing is buffered in user space, so the data is already visible to other readers of the file
+   * after `write()` returns. Use `sync()` if the data must survive a machine crash.
    *
    * @return An RC (return code) indicating the success or failure of the flush operation.
    */
   RC flush();
 
+  /**
+   * @brief Forces the written data to the storage device.
+   *
+   * Calls `fdatasync()` on the file. This is what the write-ahead log relies on for durability.
+   *
+   * @return An RC (return code) indicating the success or failure of the sync operation.
+   */
+  RC sync();
+
   /**
    * @brief Checks if the file is currently open.
    *
    * @return `true` if the file is open, `false` otherwise.
    */
-  bool is_open() const { return file_.is_open(); }
+  bool is_open() const { return fd_ >= 0; }
+
+  /**
+   * @brief Limits the bytes written per second, `write()` blocks until the limiter allows the bytes.
+   *
+   * @param rate_limiter The limiter, it may be shared by many writers. `nullptr` means no limit.
+   */
+  void set_rate_limiter(ObRateLimiter *rate_limiter) { rate_limiter_ = rate_limiter; }
 
   /**
    * @brief Returns the name of the file being written to.
@@ -125,8 +142,10 @@ private:
   bool append_;
 
   /**
-   * @brief The file stream used for writing data.
+   * @brief The file descriptor of the opened file, `-1` if the file is not open.
    */
-  ofstream file_;
+  int fd_ = -1;
+
+  ObRateLimiter *rate_limiter_ = nullptr;
 };
 }  // namespace oceanbase
@@ -13,6 +13,14 @@ See the Mulan PSL v2 for more details. */
 #include <stdint.h>
 #include <cstddef>
 
+#include "common/lang/atomic.h"
+#include "common/lang/functional.h"
+#include "common/lang/list.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+
 namespace oceanbase {
 
 /**
@@ -23,6 +31,14 @@ namespace oceanbase {
  * entries when the cache exceeds its capacity. It supports thread-safe operations for
  * inserting, retrieving, and checking the existence of cache entries.
  *
+ * The capacity is measured in "charge" units rather than in number of entries. Every entry
+ * is inserted with a charge (1 by default, so a cache that never passes a charge behaves like
+ * a count-bounded LRU). The block cache charges each block with its decoded size in bytes.
+ *
+ * The cache is split into `2^shard_bits` shards by the hash of the key. Each shard has its own
+ * lock, LRU list and `capacity / shard_count` of the charge, so concurrent readers hitting
+ * different shards don't contend on a single mutex. LRU order is maintained per shard.
+ *
  * @tparam KeyType The type of keys used to identify cache entries.
  * @tparam ValueType The type of values stored in the cache.
  */
@@ -33,9 +49,18 @@ public:
   /**
    * @brief Constructs an `ObLRUCache` with a specified capacity.
    *
-   * @param capacity The maximum number of elements the cache can hold.
+   * @param capacity The maximum total charge the cache can hold.
+   * @param shard_bits The cache is split into `2^shard_bits` shards.
    */
-  ObLRUCache(size_t capacity) : capacity_(capacity) {}
+  ObLRUCache(size_t capacity, int shard_bits = 0) : capacity_(capacity), shard_bits_(shard_bits)
+  {
+    const size_t shard_num      = static_cast<size_t>(1) << shard_bits_;
+    const size_t shard_capacity = (capacity_ + shard_num - 1) / shard_num;
+    shards_.reserve(shard_num);
+    for (size_t i = 0; i < shard_num; i++) {
+      shards_.emplace_back(make_unique<Shard>(shard_capacity));
+    }
+  }
 
   /**
    * @brief Retrieves a value from the cache using the specified key.
@@ -48,33 +73,179 @@ public:
    * @param value A reference to store the value associated with the key.
    * @return `true` if the key is found and the value is retrieved; `false` otherwise.
    */
-  bool get(const KeyType &key, ValueType &value) { return false; }
+  bool get(const KeyType &key, ValueType &value)
+  {
+    if (shard(key).get(key, value)) {
+      hits_++;
+      return true;
+    }
+    misses_++;
+    return false;
+  }
 
   /**
    * @brief Inserts a key-value pair into the cache.
    *
    * If the key already exists in the cache, its value is updated, and the key-value pair
    * is moved to the front of the LRU list. If the cache exceeds its capacity after insertion,
-   * the least recently used entry is evicted.
+   * the least recently used entries are evicted.
+   * An entry whose charge is larger than the capacity of its shard is not cached at all.
    *
    * @param key The key to insert into the cache.
    * @param value The value to associate with the specified key.
+   * @param charge The cost of the entry against the capacity of the cache.
    */
-  void put(const KeyType &key, const ValueType &value) {}
+  void put(const KeyType &key, const ValueType &value, size_t charge = 1)
+  {
+    evictions_ += shard(key).put(key, value, charge);
+  }
 
   /**
    * @brief Checks whether the specified key exists in the cache.
    *
+   * It doesn't change the LRU order and isn't counted as a hit or a miss.
+   *
    * @param key The key to check in the cache.
    * @return `true` if the key exists; `false` otherwise.
    */
-  bool contains(const KeyType &key) const { return false; }
+  bool contains(const KeyType &key) const { return shard(key).contains(key); }
+
+  /**
+   * @brief Removes the specified key from the cache if it exists.
+   */
+  void erase(const KeyType &key) { shard(key).erase(key); }
+
+  size_t capacity() const { return capacity_; }
+  int    shard_bits() const { return shard_bits_; }
+
+  /**
+   * @brief The total charge of all the entries in the cache.
+   */
+  size_t usage() const
+  {
+    size_t usage = 0;
+    for (const auto &shard : shards_) {
+      usage += shard->usage();
+    }
+    return usage;
+  }
+
+  uint64_t hits() const { return hits_.load(); }
+  uint64_t misses() const { return misses_.load(); }
+  uint64_t evictions() const { return evictions_.load(); }
+
+private:
+  /**
+   * @brief One shard of the cache, a classic hash map plus doubly linked list LRU.
+   */
+  class Shard
+  {
+  public:
+    explicit Shard(size_t capacity) : capacity_(capacity) {}
+
+    bool get(const KeyType &key, ValueType &value)
+    {
+      lock_guard<mutex> guard(mutex_);
+      auto              iter = table_.find(key);
+      if (iter == table_.end()) {
+        return false;
+      }
+      lru_.splice(lru_.begin(), lru_, iter->second);
+      value = iter->second->value;
+      return true;
+    }
+
+    /**
+     * @return The number of evicted entries.
+     */
+    size_t put(const KeyType &key, const ValueType &value, size_t charge)
+    {
+      lock_guard<mutex> guard(mutex_);
+      auto              iter = table_.find(key);
+      if (iter != table_.end()) {
+        usage_ -= iter->second->charge;
+        lru_.erase(iter->second);
+        table_.erase(iter);
+      }
+
+      if (charge > capacity_) {
+        return 0;
+      }
+
+      size_t evicted = 0;
+      while (usage_ + charge > capacity_ && !lru_.empty()) {
+        Entry &victim = lru_.back();
+        usage_ -= victim.charge;
+        table_.erase(victim.key);
+        lru_.pop_back();
+        evicted++;
+      }
+
+      lru_.push_front(Entry{key, value, charge});
+      table_.emplace(key, lru_.begin());
+      usage_ += charge;
+      return evicted;
+    }
+
+    bool contains(const KeyType &key) const
+    {
+      lock_guard<mutex> guard(mutex_);
+      return table_.find(key) != table_.end();
+    }
+
+    void erase(const KeyType &key)
+    {
+      lock_guard<mutex> guard(mutex_);
+      auto              iter = table_.find(key);
+      if (iter != table_.end()) {
+        usage_ -= iter->second->charge;
+        lru_.erase(iter->second);
+        table_.erase(iter);
+      }
+    }
+
+    size_t usage() const
+    {
+      lock_guard<mutex> guard(mutex_);
+      return usage_;
+    }
+
+  private:
+    struct Entry
+    {
+      KeyType   key;
+      ValueType value;
+      size_t    charge;
+    };
+
+    mutable mutex                                           mutex_;
+    size_t                                                  capacity_ = 0;
+    size_t                                                  usage_    = 0;
+    list<Entry>                                             lru_;  ///< the most recently used entry is at front
+    unordered_map<KeyType, typename list<Entry>::iterator> table_;
+  };
+
+  Shard &shard(const KeyType &key) const
+  {
+    if (shard_bits_ == 0) {
+      return *shards_[0];
+    }
+    // std::hash of integers is identity, mix it so that sequential keys spread over shards.
+    uint64_t h = static_cast<uint64_t>(hash<KeyType>()(key)) * 0x9E3779B97F4A7C15ULL;
+    return *shards_[h >> (64 - shard_bits_)];
+  }
 
 private:
   /**
-   * @brief The maximum number of elements the cache can hold.
+   * @brief The maximum total charge the cache can hold.
    */
-  size_t capacity_;
+  size_t                    capacity_;
+  int                       shard_bits_ = 0;
+  vector<unique_ptr<Shard>> shards_;
+
+  atomic<uint64_t> hits_{0};
+  atomic<uint64_t> misses_{0};
+  atomic<uint64_t> evictions_{0};
 };
 
 /**
@@ -85,13 +256,14 @@ private:
  *
  * @tparam Key The type of keys used to identify cache entries.
  * @tparam Value The type of values stored in the cache.
- * @param capacity The maximum number of elements the cache can hold.
+ * @param capacity The maximum total charge the cache can hold.
+ * @param shard_bits The cache is split into `2^shard_bits` shards.
  * @return A pointer to the newly created `ObLRUCache` instance.
  */
 template <typename Key, typename Value>
-ObLRUCache<Key, Value> *new_lru_cache(uint32_t capacity)
+ObLRUCache<Key, Value> *new_lru_cache(size_t capacity, int shard_bits = 0)
 {
-  return nullptr;
+  return new ObLRUCache<Key, Value>(capacity, shard_bits);
 }
 
 }  // namespace oceanbase
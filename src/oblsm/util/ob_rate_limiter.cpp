@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "oblsm/util/ob_rate_limiter.h"
+
+#include "common/lang/algorithm.h"
+#include "common/lang/thread.h"
+
+namespace oceanbase {
+
+ObRateLimiter::ObRateLimiter(size_t bytes_per_sec)
+    : bytes_per_sec_(bytes_per_sec),
+      max_tokens_(static_cast<double>(bytes_per_sec) * REFILL_PERIOD_US / 1000000),
+      tokens_(max_tokens_),
+      last_refill_(chrono::steady_clock::now())
+{}
+
+void ObRateLimiter::request(size_t bytes)
+{
+  int64_t wait_us = 0;
+  {
+    lock_guard<mutex> guard(mutex_);
+    total_bytes_ += bytes;
+    if (bytes_per_sec_ == 0) {
+      return;
+    }
+
+    const auto    now        = chrono::steady_clock::now();
+    const int64_t elapsed_us = chrono::duration_cast<chrono::microseconds>(now - last_refill_).count();
+    last_refill_             = now;
+    tokens_ = std::min(max_tokens_, tokens_ + static_cast<double>(bytes_per_sec_) * elapsed_us / 1000000);
+    tokens_ -= bytes;
+    if (tokens_ < 0) {
+      wait_us = static_cast<int64_t>(-tokens_ * 1000000 / bytes_per_sec_);
+    }
+  }
+
+  if (wait_us > 0) {
+    this_thread::sleep_for(chrono::microseconds(wait_us));
+  }
+}
+
+size_t ObRateLimiter::total_bytes() const
+{
+  lock_guard<mutex> guard(mutex_);
+  return total_bytes_;
+}
+
+}  // namespace oceanbase
@@ -0,0 +1,60 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/chrono.h"
+#include "common/lang/mutex.h"
+
+namespace oceanbase {
+
+/**
+ * @class ObRateLimiter
+ * @brief A token bucket limiting the bytes written per second, shared by the threads writing files.
+ *
+ * Tokens are added to the bucket at `bytes_per_sec`, and the bucket holds at most the tokens of
+ * `REFILL_PERIOD_US`, so the writes can't burst after being idle for a long time. A request larger than the tokens
+ * in the bucket takes all of them and owes the rest, the caller sleeps until the debt is paid. So the requests are
+ * served in order, and a large request is never starved by small ones.
+ */
+class ObRateLimiter
+{
+public:
+  /**
+   * @param bytes_per_sec The bytes allowed per second, 0 means no limit.
+   */
+  explicit ObRateLimiter(size_t bytes_per_sec);
+  ~ObRateLimiter() = default;
+
+  /**
+   * @brief Takes `bytes` tokens, blocks until the bytes may be written.
+   */
+  void request(size_t bytes);
+
+  size_t bytes_per_sec() const { return bytes_per_sec_; }
+
+  /**
+   * @brief The total bytes requested, for tests and statistics.
+   */
+  size_t total_bytes() const;
+
+private:
+  static constexpr int64_t REFILL_PERIOD_US = 100 * 1000;
+
+  const size_t bytes_per_sec_;
+  const double max_tokens_;
+
+  mutable mutex                    mutex_;
+  double                           tokens_;  ///< negative if the requests owe tokens
+  chrono::steady_clock::time_point last_refill_;
+  size_t                           total_bytes_ = 0;
+};
+
+}  // namespace oceanbase
@@ -10,16 +10,94 @@
 
 #include "oblsm/wal/ob_lsm_wal.h"
 #include "common/log/log.h"
+#include "common/math/crc.h"
 #include "oblsm/util/ob_file_reader.h"
+#include "oblsm/util/ob_coding.h"
 
 namespace oceanbase {
+
+static constexpr size_t WAL_RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t);
+
 RC WAL::recover(const std::string &wal_file, std::vector<WalRecord> &wal_records)
 {
-  return RC::UNIMPLEMENTED;
+  unique_ptr<ObFileReader> reader = ObFileReader::create_file_reader(wal_file);
+  if (reader == nullptr) {
+    LOG_WARN("failed to open wal file %s", wal_file.c_str());
+    return RC::IOERR_OPEN;
+  }
+
+  const uint32_t file_size = reader->file_size();
+  const string   data      = file_size == 0 ? string() : reader->read_pos(0, file_size);
+  if (data.size() != file_size) {
+    return RC::IOERR_READ;
+  }
+
+  size_t pos = 0;
+  while (pos + WAL_RECORD_HEADER_SIZE <= data.size()) {
+    const uint32_t crc         = get_numeric<uint32_t>(data.data() + pos);
+    const uint32_t payload_len = get_numeric<uint32_t>(data.data() + pos + sizeof(uint32_t));
+    const char    *payload     = data.data() + pos + WAL_RECORD_HEADER_SIZE;
+    if (payload_len > data.size() - pos - WAL_RECORD_HEADER_SIZE || crc32(payload, payload_len) != crc) {
+      break;
+    }
+
+    ObLsmWriteBatch batch;
+    RC              rc = batch.set_data(string_view(payload, payload_len));
+    if (OB_FAIL(rc)) {
+      LOG_WARN("malformed wal record in file %s. offset=%lu", wal_file.c_str(), pos);
+      return rc;
+    }
+    batch.iterate([&wal_records](uint64_t seq, const string_view &key, const string_view &val) {
+      wal_records.emplace_back(seq, string(key), string(val));
+    });
+    pos += WAL_RECORD_HEADER_SIZE + payload_len;
+  }
+
+  if (pos != data.size()) {
+    LOG_WARN("ignore the broken tail of wal file %s. offset=%lu, file size=%u", wal_file.c_str(), pos, file_size);
+  }
+  return RC::SUCCESS;
+}
+
+RC WAL::open(const std::string &filename)
+{
+  filename_    = filename;
+  file_writer_ = ObFileWriter::create_file_writer(filename, true);
+  if (file_writer_ == nullptr) {
+    LOG_WARN("failed to open wal file %s", filename.c_str());
+    return RC::IOERR_OPEN;
+  }
+  return RC::SUCCESS;
 }
 
 RC WAL::put(uint64_t seq, string_view key, string_view val)
 {
-  return RC::UNIMPLEMENTED;
+  ObLsmWriteBatch batch;
+  batch.put(key, val);
+  batch.set_sequence(seq);
+  return write(batch);
+}
+
+RC WAL::write(const ObLsmWriteBatch &batch)
+{
+  if (file_writer_ == nullptr) {
+    return RC::INTERNAL;
+  }
+
+  const string_view payload = batch.data();
+  string            record;
+  record.reserve(WAL_RECORD_HEADER_SIZE + payload.size());
+  put_numeric<uint32_t>(&record, crc32(payload.data(), static_cast<unsigned int>(payload.size())));
+  put_numeric<uint32_t>(&record, static_cast<uint32_t>(payload.size()));
+  record.append(payload.data(), payload.size());
+  return file_writer_->write(record);
+}
+
+RC WAL::sync()
+{
+  if (file_writer_ == nullptr) {
+    return RC::INTERNAL;
+  }
+  return file_writer_->sync();
 }
-}  // namespace oceanbase
\ No newline at end of file
+}  // namespace oceanbase
@@ -15,6 +15,7 @@
 
 #include "common/lang/mutex.h"
 #include "common/sys/rc.h"
+#include "oblsm/include/ob_lsm_write_batch.h"
 #include "oblsm/util/ob_file_writer.h"
 
 namespace oceanbase {
@@ -51,17 +52,15 @@ struct WalRecord
  * providing durability in case of system failures.
  *
  * ### Data Serialization Format:
- * The data is serialized as follows:
- * - Each entry in the WAL consists of a key-value pair.
- * - The data format is:
- *   - **Sequence Number (uint64_t)**: A 8-byte value representing the sequence of logs.
- *   - **Key Length (size_t)**: A value representing the length of the key.
- *   - **Key (string)**: The actual key, as a string.
- *   - **Value Length (size_t)**: A value representing the length of the value.
- *   - **Value (string)**: The actual value, as a string.
+ * Every write to the WAL is a record, which holds a batch of key-value pairs that are written (and synced) together:
+ * - **CRC (uint32_t)**: The crc32 of the payload.
+ * - **Payload Length (uint32_t)**: The length of the payload.
+ * - **Payload**: The encoded `ObLsmWriteBatch`, which holds the sequence number of its first key-value pair, and
+ *   the key-value pairs get consecutive sequence numbers.
  *
- * The data is written to the file in the order: key length, key, value length, value.
- * After writing the data, the system performs a `flush()` operation to ensure the data is persisted.
+ * The records are appended to the file, `sync()` forces them to the disk. When recovering, a record that is
+ * truncated or whose CRC doesn't match is treated as the end of the log: it is the tail of a write interrupted
+ * by a crash, and the write was never acknowledged to the client.
  */
 class WAL
 {
@@ -85,7 +84,7 @@ public:
    * @param filename The name of the WAL file to write logs.
    * @return `RC::SUCCESS` if the file was successfully opened, or an error code if it failed.
    */
-  RC open(const std::string &filename) { return RC::UNIMPLEMENTED; }
+  RC open(const std::string &filename);
 
   /**
    * @brief Recovers data from a specified WAL file.
@@ -102,7 +101,7 @@ public:
   /**
    * @brief Writes a key-value pair to the WAL.
    *
-   * This function serializes the key-value pair and appends it to the WAL file.
+   * This function serializes the key-value pair and appends it to the WAL file as a record of its own.
    *
    * @param seq The sequence number of the record.
    * @param key The key to write.
@@ -111,17 +110,28 @@ public:
    */
   RC put(uint64_t seq, std::string_view key, std::string_view val);
 
+  /**
+   * @brief Writes a batch of key-value pairs to the WAL as one record.
+   *
+   * Group commit uses it to write the batches of many writers with a single write (and a single sync).
+   *
+   * @param batch The batch whose sequence number has been set.
+   * @return `RC::SUCCESS` if the write operation is successful, or an error code if it fails.
+   */
+  RC write(const ObLsmWriteBatch &batch);
+
   /**
    * @brief Synchronizes the WAL to disk.
-   * Forces any buffered data in the WAL to be written to the underlying storage.
+   * Forces the data written to the WAL to the underlying storage with `fdatasync()`.
    *
    * @return `RC::SUCCESS` if the sync operation is successful, or an error code if it fails.
    */
-  RC sync() { return RC::UNIMPLEMENTED; }
+  RC sync();
 
   const string &filename() const { return filename_; }
 
 private:
-  string filename_;
+  string                   filename_;
+  unique_ptr<ObFileWriter> file_writer_;
 };
 }  // namespace oceanbase
@@ -9,15 +9,81 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "catalog/catalog.h"
+#include "common/lang/filesystem.h"
+#include "common/lang/fstream.h"
+#include "common/log/log.h"
 
-const TableStats &Catalog::get_table_stats(int table_id)
+TableStats Catalog::get_table_stats(int table_id)
 {
   lock_guard<mutex> lock(mutex_);
-  return table_stats_[table_id];
+  auto iter = table_stats_.find(table_id);
+  if (iter == table_stats_.end()) {
+    return TableStats();
+  }
+  return iter->second;
 }
 
 void Catalog::update_table_stats(int table_id, const TableStats &table_stats)
 {
   lock_guard<mutex> lock(mutex_);
   table_stats_[table_id] = table_stats;
-}
\ No newline at end of file
+}
+
+RC Catalog::save_table_stats(int table_id, const TableStats &table_stats, const string &file_name)
+{
+  const string tmp_file_name = file_name + ".tmp";
+
+  fstream fs;
+  fs.open(tmp_file_name, ios_base::out | ios_base::binary | ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open table stats file for write. file name=%s, errmsg=%s",
+        tmp_file_name.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  if (table_stats.serialize(fs) < 0 || !fs.good()) {
+    LOG_ERROR("Failed to write table stats file. file name=%s", tmp_file_name.c_str());
+    fs.close();
+    return RC::IOERR_WRITE;
+  }
+  fs.close();
+
+  error_code ec;
+  filesystem::rename(tmp_file_name, file_name, ec);
+  if (ec) {
+    LOG_ERROR("Failed to rename table stats file. file name=%s, error=%s", file_name.c_str(), ec.message().c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  update_table_stats(table_id, table_stats);
+  return RC::SUCCESS;
+}
+
+RC Catalog::load_table_stats(int table_id, const string &file_name)
+{
+  error_code ec;
+  if (!filesystem::exists(file_name, ec)) {
+    return RC::SUCCESS;
+  }
+
+  fstream fs;
+  fs.open(file_name, ios_base::in | ios_base::binary);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open table stats file for read. file name=%s, errmsg=%s", file_name.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  TableStats table_stats;
+  if (table_stats.deserialize(fs) < 0) {
+    LOG_ERROR("Failed to deserialize table stats. file name=%s", file_name.c_str());
+    return RC::IOERR_READ;
+  }
+
+  update_table_stats(table_id, table_stats);
+  return RC::SUCCESS;
+}
+
+void Catalog::remove_table_stats(int table_id)
+{
+  lock_guard<mutex> lock(mutex_);
+  table_stats_.erase(table_id);
+}
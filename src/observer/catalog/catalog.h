@@ -11,6 +11,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 #include "common/lang/unordered_map.h"
 #include "common/lang/mutex.h"
+#include "common/sys/rc.h"
 #include "catalog/table_stats.h"
 
 /**
@@ -37,9 +38,10 @@ public:
    * @brief Retrieves table statistics for a given table_id.
    *
    * @param table_id The identifier of the table for which statistics are requested.
-   * @return A constant reference to the TableStats of the specified table_id.
+   * @return A copy of the TableStats of the specified table_id. An empty TableStats
+   * is returned if the table has never been analyzed.
    */
-  const TableStats &get_table_stats(int table_id);
+  TableStats get_table_stats(int table_id);
 
   /**
    * @brief Updates table statistics for a given table.
@@ -49,6 +51,28 @@ public:
    */
   void update_table_stats(int table_id, const TableStats &table_stats);
 
+  /**
+   * @brief Writes table statistics to a file and then updates them in memory.
+   *
+   * The file is written to a temporary file first and renamed, so a crash never
+   * leaves a half-written statistics file behind.
+   *
+   * @param file_name The statistics file of the table.
+   */
+  RC save_table_stats(int table_id, const TableStats &table_stats, const string &file_name);
+
+  /**
+   * @brief Loads table statistics saved by save_table_stats.
+   *
+   * It is not an error if the file does not exist, the table has just never been analyzed.
+   */
+  RC load_table_stats(int table_id, const string &file_name);
+
+  /**
+   * @brief Forgets the statistics of a dropped table.
+   */
+  void remove_table_stats(int table_id);
+
   /**
    * @brief Gets the singleton instance of the Catalog.
    *
@@ -68,7 +92,7 @@ private:
   /**
    * @brief A map storing the table statistics indexed by table_id.
    *
-   * This map is currently not persisted and its persistence is planned via a system table.
+   * It is persisted per table by save_table_stats and loaded again when the table is opened.
    */
   unordered_map<int, TableStats> table_stats_;  ///< Table statistics storage.
 };
\ No newline at end of file
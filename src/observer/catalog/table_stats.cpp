@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "catalog/table_stats.h"
+#include "common/log/log.h"
+#include "json/json.h"
+
+#include <strings.h>
+
+static const Json::StaticString FIELD_ROW_NUMS("row_nums");
+static const Json::StaticString FIELD_SAMPLED_ROWS("sampled_rows");
+static const Json::StaticString FIELD_COLUMNS("columns");
+static const Json::StaticString FIELD_NAME("name");
+static const Json::StaticString FIELD_NULL_FRAC("null_frac");
+static const Json::StaticString FIELD_NDV("ndv");
+static const Json::StaticString FIELD_MIN("min");
+static const Json::StaticString FIELD_MAX("max");
+static const Json::StaticString FIELD_HISTOGRAM("histogram");
+
+const ColumnStats *TableStats::find_column(const char *name) const
+{
+  for (const ColumnStats &column : column_stats) {
+    if (0 == strcasecmp(column.name.c_str(), name)) {
+      return &column;
+    }
+  }
+  return nullptr;
+}
+
+int TableStats::serialize(ostream &os) const
+{
+  Json::Value table_value;
+  table_value[FIELD_ROW_NUMS]     = row_nums;
+  table_value[FIELD_SAMPLED_ROWS] = static_cast<Json::Int64>(sampled_rows);
+
+  Json::Value columns_value(Json::arrayValue);
+  for (const ColumnStats &column : column_stats) {
+    Json::Value column_value;
+    column_value[FIELD_NAME]      = column.name;
+    column_value[FIELD_NULL_FRAC] = column.null_frac;
+    column_value[FIELD_NDV]       = static_cast<Json::Int64>(column.ndv);
+    if (column.has_range) {
+      column_value[FIELD_MIN] = column.min;
+      column_value[FIELD_MAX] = column.max;
+
+      // 每个桶保存为 [lower, upper, rows, ndv]
+      Json::Value histogram_value(Json::arrayValue);
+      for (const Histogram::Bucket &bucket : column.histogram.buckets()) {
+        Json::Value bucket_value(Json::arrayValue);
+        bucket_value.append(bucket.lower);
+        bucket_value.append(bucket.upper);
+        bucket_value.append(bucket.rows);
+        bucket_value.append(bucket.ndv);
+        histogram_value.append(std::move(bucket_value));
+      }
+      column_value[FIELD_HISTOGRAM] = std::move(histogram_value);
+    }
+    columns_value.append(std::move(column_value));
+  }
+  table_value[FIELD_COLUMNS] = std::move(columns_value);
+
+  Json::StreamWriterBuilder builder;
+  Json::StreamWriter       *writer = builder.newStreamWriter();
+
+  streampos old_pos = os.tellp();
+  writer->write(table_value, &os);
+  int ret = (int)(os.tellp() - old_pos);
+
+  delete writer;
+  return ret;
+}
+
+int TableStats::deserialize(istream &is)
+{
+  Json::Value             table_value;
+  Json::CharReaderBuilder builder;
+  string                  errors;
+
+  streampos old_pos = is.tellg();
+  if (!Json::parseFromStream(builder, is, &table_value, &errors)) {
+    LOG_ERROR("Failed to deserialize table stats. error=%s", errors.c_str());
+    return -1;
+  }
+
+  const Json::Value &row_nums_value = table_value[FIELD_ROW_NUMS];
+  const Json::Value &columns_value  = table_value[FIELD_COLUMNS];
+  if (!row_nums_value.isInt() || !columns_value.isArray()) {
+    LOG_ERROR("Invalid table stats. json value=%s", table_value.toStyledString().c_str());
+    return -1;
+  }
+
+  row_nums     = row_nums_value.asInt();
+  sampled_rows = table_value[FIELD_SAMPLED_ROWS].asInt64();
+  column_stats.clear();
+  for (const Json::Value &column_value : columns_value) {
+    ColumnStats column;
+    column.name      = column_value[FIELD_NAME].asString();
+    column.null_frac = column_value[FIELD_NULL_FRAC].asDouble();
+    column.ndv       = column_value[FIELD_NDV].asInt64();
+    column.has_range = column_value.isMember(FIELD_MIN);
+    if (column.has_range) {
+      column.min = column_value[FIELD_MIN].asDouble();
+      column.max = column_value[FIELD_MAX].asDouble();
+      for (const Json::Value &bucket_value : column_value[FIELD_HISTOGRAM]) {
+        if (!bucket_value.isArray() || bucket_value.size() != 4) {
+          LOG_ERROR("Invalid histogram bucket. json value=%s", bucket_value.toStyledString().c_str());
+          return -1;
+        }
+        Histogram::Bucket bucket;
+        bucket.lower = bucket_value[0].asDouble();
+        bucket.upper = bucket_value[1].asDouble();
+        bucket.rows  = bucket_value[2].asDouble();
+        bucket.ndv   = bucket_value[3].asDouble();
+        column.histogram.add_bucket(bucket);
+      }
+    }
+    column_stats.push_back(std::move(column));
+  }
+
+  // 解析时可能读到了文件末尾，这时 tellg 拿不到位置
+  streampos new_pos = is.tellg();
+  return new_pos < 0 ? 0 : (int)(new_pos - old_pos);
+}
@@ -10,13 +10,38 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/iostream.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "sql/optimizer/statistics/histogram.h"
+
+/**
+ * @class ColumnStats
+ * @brief Represents statistics of a single column.
+ *
+ * Values are mapped to doubles by Histogram::position, so min/max and the
+ * histogram bounds of every supported type are comparable with constants
+ * mapped the same way.
+ */
+class ColumnStats
+{
+public:
+  string    name;
+  double    null_frac = 0;      ///< Fraction of rows whose value is NULL.
+  int64_t   ndv       = 0;      ///< Number of distinct non-NULL values.
+  bool      has_range = false;  ///< Whether min/max and the histogram are available for this type.
+  double    min       = 0;
+  double    max       = 0;
+  Histogram histogram;
+};
+
 /**
  * @class TableStats
  * @brief Represents statistics related to a table.
  *
- * The TableStats class holds statistical information about a table,
- * such as the number of rows it contains.
- * TODO: Add more statistics as needed.
+ * The TableStats class holds statistical information about a table, such as
+ * the number of rows it contains and per-column statistics collected by
+ * ANALYZE TABLE.
  */
 class TableStats
 {
@@ -25,15 +50,17 @@ public:
 
   TableStats() = default;
 
-  TableStats(const TableStats &other) { row_nums = other.row_nums; }
+  ~TableStats() = default;
 
-  TableStats &operator=(const TableStats &other)
-  {
-    row_nums = other.row_nums;
-    return *this;
-  }
+  /**
+   * @brief Returns the statistics of the column, or nullptr if the column was not analyzed.
+   */
+  const ColumnStats *find_column(const char *name) const;
 
-  ~TableStats() = default;
+  int serialize(ostream &os) const;
+  int deserialize(istream &is);
 
-  int row_nums = 0;
-};
\ No newline at end of file
+  int                 row_nums     = 0;
+  int64_t             sampled_rows = 0;  ///< Number of rows read by ANALYZE TABLE.
+  vector<ColumnStats> column_stats;
+};
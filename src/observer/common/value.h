@@ -198,6 +198,8 @@ public:
   const char *data() const;
 
   int      length() const { return length_; }
+  /// @brief 这个值占用的内存大小，包括自己申请的变长数据，算子用来控制缓存的数据量
+  int64_t  memory_size() const { return static_cast<int64_t>(sizeof(Value)) + (own_data_ ? length_ : 0); }
   AttrType attr_type() const { return attr_type_; }
   bool     is_null() const { return is_null_; }
 
@@ -15,11 +15,14 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/value.h"
 #include "event/sql_debug.h"
 #include "sql/executor/sql_result.h"
 
 class Session;
 class Communicator;
+class PreparedStatement;
 
 /**
  * @brief 表示一个SQL请求
@@ -40,9 +43,24 @@ public:
   SqlResult    *sql_result() { return &sql_result_; }
   SqlDebug     &sql_debug() { return sql_debug_; }
 
+  /**
+   * @brief 执行预处理语句的请求
+   * @details 查询就是预处理语句的SQL，语法分析和计算指纹时使用绑定的参数，结果以二进制协议返回
+   */
+  void set_prepared_statement(PreparedStatement *stmt, vector<Value> params)
+  {
+    prepared_statement_ = stmt;
+    prepared_params_    = std::move(params);
+  }
+  PreparedStatement   *prepared_statement() const { return prepared_statement_; }
+  const vector<Value> &prepared_params() const { return prepared_params_; }
+
 private:
   Communicator *communicator_ = nullptr;  ///< 与客户端通讯的对象
   SqlResult     sql_result_;              ///< SQL执行结果
   SqlDebug      sql_debug_;               ///< SQL调试信息
   string        query_;                   ///< SQL语句
+
+  PreparedStatement *prepared_statement_ = nullptr;  ///< 执行的预处理语句，不是预处理语句时为空
+  vector<Value>      prepared_params_;               ///< 预处理语句绑定的参数
 };
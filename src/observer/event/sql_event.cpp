@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 #include "event/sql_event.h"
 
 #include "event/session_event.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/query_cache/query_cache.h"
 #include "sql/stmt/stmt.h"
 
 SQLStageEvent::SQLStageEvent(SessionEvent *event, const string &sql) : session_event_(event), sql_(sql) {}
@@ -30,3 +32,13 @@ SQLStageEvent::~SQLStageEvent() noexcept
     stmt_ = nullptr;
   }
 }
+
+void SQLStageEvent::set_cached_plan(unique_ptr<CachedPlan> plan) { cached_plan_ = std::move(plan); }
+
+void SQLStageEvent::set_fingerprint(const string &fingerprint, vector<Value> params)
+{
+  fingerprint_ = fingerprint;
+  params_      = std::move(params);
+}
+
+void SQLStageEvent::set_cached_result(unique_ptr<CachedResult> result) { cached_result_ = std::move(result); }
@@ -21,6 +21,8 @@ See the Mulan PSL v2 for more details. */
 class SessionEvent;
 class Stmt;
 class ParsedSqlNode;
+class CachedPlan;
+class CachedResult;
 
 /**
  * @brief 与SessionEvent类似，也是处理SQL请求的事件，只是用在SQL的不同阶段
@@ -44,10 +46,31 @@ public:
   void set_stmt(Stmt *stmt) { stmt_ = stmt; }
   void set_operator(unique_ptr<PhysicalOperator> oper) { operator_ = std::move(oper); }
 
+  int                     param_count() const { return param_count_; }
+  void                    set_param_count(int count) { param_count_ = count; }
+  unique_ptr<CachedPlan> &cached_plan() { return cached_plan_; }
+  void                    set_cached_plan(unique_ptr<CachedPlan> plan);
+
+  /**
+   * @brief SQL的指纹以及从SQL中提取出来的常量
+   * @details 由查询缓存阶段计算，计划缓存阶段也会使用。不支持缓存的SQL，指纹是空的
+   */
+  const string        &fingerprint() const { return fingerprint_; }
+  const vector<Value> &params() const { return params_; }
+  void                 set_fingerprint(const string &fingerprint, vector<Value> params);
+
+  unique_ptr<CachedResult> &cached_result() { return cached_result_; }
+  void                      set_cached_result(unique_ptr<CachedResult> result);
+
 private:
   SessionEvent                *session_event_ = nullptr;
   string                       sql_;             ///< 处理的SQL语句
   unique_ptr<ParsedSqlNode>    sql_node_;        ///< 语法解析后的SQL命令
   Stmt                        *stmt_ = nullptr;  ///< Resolver之后生成的数据结构
   unique_ptr<PhysicalOperator> operator_;        ///< 生成的执行计划，也可能没有
+  int                          param_count_ = 0;  ///< 语法解析时遇到的字面量常量个数
+  unique_ptr<CachedPlan>       cached_plan_;       ///< 执行计划对应的计划缓存项，也可能没有
+  string                       fingerprint_;       ///< SQL的指纹，常量都替换成了占位符
+  vector<Value>                params_;            ///< SQL中的常量，与指纹中的占位符一一对应
+  unique_ptr<CachedResult>     cached_result_;     ///< 执行结果需要放入的查询缓存项，也可能没有
 };
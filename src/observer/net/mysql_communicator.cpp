@@ -15,12 +15,18 @@ See the Mulan PSL v2 for more details. */
 #include <string.h>
 
 #include "common/io/io.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/charconv.h"
+#include "common/lang/cmath.h"
+#include "common/lang/string.h"
 #include "common/log/log.h"
 #include "event/session_event.h"
+#include "session/prepared_statement.h"
 #include "session/session.h"
 #include "net/buffered_writer.h"
 #include "net/mysql_communicator.h"
 #include "sql/operator/string_list_physical_operator.h"
+#include "storage/common/chunk.h"
 
 /**
  * @brief MySQL协议相关实现
@@ -207,13 +213,13 @@ int store_lenenc_int(char *buf, uint64_t value)
     return 1;
   }
 
-  if (value < (2UL << 16)) {
+  if (value < (1UL << 16)) {
     *buf = 0xFC;
     memcpy(buf + 1, &value, 2);
     return 3;
   }
 
-  if (value < (2UL << 24)) {
+  if (value < (1UL << 24)) {
     *buf = 0xFD;
     memcpy(buf + 1, &value, 3);
     return 4;
@@ -535,6 +541,498 @@ RC decode_query_packet(vector<char> &net_packet, QueryPacket &query_packet)
   return RC::SUCCESS;
 }
 
+/**
+ * @brief 读取一个 length-encoded integer
+ * @return 数据不完整时返回false
+ * @ingroup MySQLProtocol
+ */
+bool read_lenenc_int(const char *&pos, const char *end, uint64_t &value)
+{
+  if (pos >= end) {
+    return false;
+  }
+
+  const uint8_t first = static_cast<uint8_t>(*pos++);
+  int           bytes = 0;
+  switch (first) {
+    case 0xFC: bytes = 2; break;
+    case 0xFD: bytes = 3; break;
+    case 0xFE: bytes = 8; break;
+    default: value = first; return first < 0xFB;
+  }
+  if (end - pos < bytes) {
+    return false;
+  }
+  value = 0;
+  memcpy(&value, pos, bytes);
+  pos += bytes;
+  return true;
+}
+
+/**
+ * @brief 把二进制协议中的一个参数直接转换成 Value
+ * @details 整数和浮点数不需要再从文本解析。日期转换成字符串，与SQL中的日期常量一样由后面的阶段转换成日期类型。
+ * MiniOB 中没有 double 和 decimal，都转换成 float
+ * [Binary Protocol Value](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_binary_resultset.html#sect_protocol_binary_resultset_row_value)
+ * @param type 参数类型，高位的 0x80 表示无符号
+ * @ingroup MySQLProtocol
+ */
+RC decode_binary_value(const char *&pos, const char *end, uint16_t type, Value &value)
+{
+  auto read_fixed = [&pos, end](void *data, int len) {
+    if (end - pos < len) {
+      return false;
+    }
+    memcpy(data, pos, len);
+    pos += len;
+    return true;
+  };
+
+  const bool is_unsigned = (type & 0x8000) != 0;
+  int64_t    int_value   = 0;
+  switch (type & 0xFF) {
+    case MYSQL_TYPE_TINY: {
+      uint8_t v = 0;
+      if (!read_fixed(&v, sizeof(v))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      int_value = is_unsigned ? static_cast<int64_t>(v) : static_cast<int8_t>(v);
+    } break;
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_YEAR: {
+      uint16_t v = 0;
+      if (!read_fixed(&v, sizeof(v))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      int_value = is_unsigned ? static_cast<int64_t>(v) : static_cast<int16_t>(v);
+    } break;
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_INT24: {
+      uint32_t v = 0;
+      if (!read_fixed(&v, sizeof(v))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      int_value = is_unsigned ? static_cast<int64_t>(v) : static_cast<int32_t>(v);
+    } break;
+    case MYSQL_TYPE_LONGLONG: {
+      uint64_t v = 0;
+      if (!read_fixed(&v, sizeof(v)) || (is_unsigned && v > static_cast<uint64_t>(INT32_MAX))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      int_value = static_cast<int64_t>(v);
+    } break;
+    case MYSQL_TYPE_FLOAT: {
+      float v = 0;
+      if (!read_fixed(&v, sizeof(v))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      value.set_float(v);
+    } return RC::SUCCESS;
+    case MYSQL_TYPE_DOUBLE: {
+      double v = 0;
+      if (!read_fixed(&v, sizeof(v))) {
+        return RC::INVALID_ARGUMENT;
+      }
+      value.set_float(static_cast<float>(v));
+    } return RC::SUCCESS;
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_TIMESTAMP: {
+      // 长度，然后是年(2字节)、月、日，可能还有时分秒和微秒。MiniOB只有日期类型，忽略时间部分
+      uint8_t len = 0;
+      if (!read_fixed(&len, sizeof(len)) || end - pos < len) {
+        return RC::INVALID_ARGUMENT;
+      }
+      uint16_t year = 0;
+      uint8_t  month = 0, day = 0;
+      if (len >= 4) {
+        memcpy(&year, pos, sizeof(year));
+        month = static_cast<uint8_t>(pos[2]);
+        day   = static_cast<uint8_t>(pos[3]);
+      }
+      pos += len;
+      char buf[16];
+      snprintf(buf, sizeof(buf), "%04d-%02d-%02d", year, month, day);
+      value.set_string(buf);
+    } return RC::SUCCESS;
+    case MYSQL_TYPE_TIME: return RC::UNSUPPORTED;
+    default: {
+      // 字符串、decimal 等类型都是 length-encoded string
+      uint64_t len = 0;
+      if (!read_lenenc_int(pos, end, len) || static_cast<uint64_t>(end - pos) < len) {
+        return RC::INVALID_ARGUMENT;
+      }
+      const string str(pos, len);
+      pos += len;
+      if ((type & 0xFF) == MYSQL_TYPE_DECIMAL || (type & 0xFF) == MYSQL_TYPE_NEWDECIMAL) {
+        value.set_float(strtof(str.c_str(), nullptr));
+      } else {
+        value.set_string(str.c_str(), static_cast<int>(str.size()));
+      }
+    } return RC::SUCCESS;
+  }
+
+  if (int_value < INT32_MIN || int_value > INT32_MAX) {
+    return RC::INVALID_ARGUMENT;
+  }
+  value.set_int(static_cast<int>(int_value));
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 解析执行预处理语句的请求包中的参数
+ * @details 包中依次是命令(0x17)、语句编号(4字节)、flags、iteration_count(4字节)，有参数时接着是NULL位图、
+ * new_params_bound_flag、参数类型(每个2字节，仅当new_params_bound_flag为1时出现)和非NULL参数的值。
+ * 客户端可以只在第一次执行时发送参数类型，所以参数类型需要保存下来。
+ * [COM_STMT_EXECUTE](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_stmt_execute.html)
+ * @param param_num       预处理语句的参数个数
+ * @param[in,out] param_types 上次执行时的参数类型，客户端发送了新的参数类型时会更新
+ * @param[out] params     参数
+ * @ingroup MySQLProtocol
+ */
+RC decode_execute_params(
+    const vector<char> &net_packet, int param_num, vector<uint16_t> &param_types, vector<Value> &params)
+{
+  params.clear();
+  if (param_num == 0) {
+    return RC::SUCCESS;
+  }
+
+  const char *pos             = net_packet.data() + 10;
+  const char *end             = net_packet.data() + net_packet.size();
+  const int   null_bitmap_len = (param_num + 7) / 8;
+  if (end - pos < null_bitmap_len + 1) {
+    return RC::INVALID_ARGUMENT;
+  }
+  const char *null_bitmap = pos;
+  pos += null_bitmap_len;
+
+  const bool new_params_bound = (*pos++ != 0);
+  if (new_params_bound) {
+    if (end - pos < 2 * param_num) {
+      return RC::INVALID_ARGUMENT;
+    }
+    param_types.resize(param_num);
+    for (int i = 0; i < param_num; i++, pos += 2) {
+      param_types[i] = static_cast<uint8_t>(pos[0]) | (static_cast<uint16_t>(static_cast<uint8_t>(pos[1])) << 8);
+    }
+  } else if (static_cast<int>(param_types.size()) != param_num) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  params.resize(param_num);
+  for (int i = 0; i < param_num; i++) {
+    if ((null_bitmap[i / 8] & (1 << (i % 8))) != 0 || (param_types[i] & 0xFF) == MYSQL_TYPE_NULL) {
+      params[i].set_int(0);
+      params[i].set_null(true);
+      continue;
+    }
+
+    RC rc = decode_binary_value(pos, end, param_types[i], params[i]);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to decode param. index=%d, type=%d, rc=%s", i, param_types[i], strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 写入一个列描述的内容，不包括包头
+ * @details 所有列的类型都当做 MYSQL_TYPE_VAR_STRING
+ * [Column Definition](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset_column_definition.html)
+ * @return int 写入的字节数
+ * @ingroup MySQLProtocol
+ */
+int store_column_definition(char *buf, const char *table, const char *name)
+{
+  const char *catalog   = "def";  // The catalog used. Currently always "def"
+  const char *schema    = "sys";  // schema name
+  const char *org_table = table;
+  // const char *org_name = spec.field_name();
+  const char *org_name         = name;
+  int         fixed_len_fields = 0x0c;
+  int         character_set    = 33;
+  int         column_length    = 16384;
+  int         type             = MYSQL_TYPE_VAR_STRING;
+  int16_t     flags            = 0;
+  int8_t      decimals         = 0x1f;
+
+  int pos = 0;
+  pos += store_lenenc_string(buf + pos, catalog);
+  pos += store_lenenc_string(buf + pos, schema);
+  pos += store_lenenc_string(buf + pos, table);
+  pos += store_lenenc_string(buf + pos, org_table);
+  pos += store_lenenc_string(buf + pos, name);
+  pos += store_lenenc_string(buf + pos, org_name);
+  pos += store_lenenc_int(buf + pos, fixed_len_fields);
+  store_int2(buf + pos, character_set);
+  pos += 2;
+  store_int4(buf + pos, column_length);
+  pos += 4;
+  store_int1(buf + pos, type);
+  pos += 1;
+  store_int2(buf + pos, flags);
+  pos += 2;
+  store_int1(buf + pos, decimals);
+  pos += 1;
+  store_int2(buf + pos, 0);  // 按照mariadb的文档描述，最后还有一个unused字段int<2>，不过mysql的文档没有给出这样的描述
+  pos += 2;
+  return pos;
+}
+
+/**
+ * @brief 按照MySQL协议把结果集的行编码成数据包，攒够一批之后再写到 BufferedWriter
+ * @ingroup MySQLProtocol
+ * @details 文本协议中每个值是一个 length-encoded string，NULL 是 0xFB。
+ * 二进制协议中每行以 0x00 开头，接着是 NULL 位图，然后是非 NULL 的值。列描述中的类型都是 MYSQL_TYPE_VAR_STRING，
+ * 所以二进制协议中的值也是 length-encoded string。
+ * 一行数据超过一个包的最大长度时拆成多个包。整个结果集不会缓存在内存中。
+ * [Text Resultset Row](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset_row.html)
+ * [Binary Protocol Resultset Row](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_binary_resultset.html)
+ */
+class ResultRowWriter
+{
+public:
+  ResultRowWriter(BufferedWriter &writer, int8_t &sequence_id, bool binary, int column_num)
+      : writer_(writer), sequence_id_(sequence_id), binary_(binary), column_num_(column_num)
+  {
+    buffer_.reserve(FLUSH_THRESHOLD + 1024);
+  }
+
+  void begin_row()
+  {
+    row_start_ = buffer_.size();
+    buffer_.resize(row_start_ + 4);  // 包头最后再填
+    if (binary_) {
+      buffer_.push_back(0x00);
+      // NULL 位图从第2位开始
+      buffer_.resize(buffer_.size() + (column_num_ + 7 + 2) / 8, 0);
+    }
+  }
+
+  void append_null(int col_idx)
+  {
+    if (binary_) {
+      const int bit = col_idx + 2;
+      buffer_[row_start_ + 5 + bit / 8] |= static_cast<char>(1 << (bit % 8));
+    } else {
+      buffer_.push_back(static_cast<char>(0xFB));
+    }
+  }
+
+  void append_string(const char *data, int len)
+  {
+    char lenenc[9];
+    int  lenenc_len = store_lenenc_int(lenenc, len);
+    buffer_.insert(buffer_.end(), lenenc, lenenc + lenenc_len);
+    buffer_.insert(buffer_.end(), data, data + len);
+  }
+
+  /**
+   * @brief 追加已经编码成 length-encoded string 的值
+   */
+  void append_encoded(const char *data, int len) { buffer_.insert(buffer_.end(), data, data + len); }
+
+  void append_value(int col_idx, const Value &value)
+  {
+    if (value.is_null()) {
+      append_null(col_idx);
+    } else {
+      string str = value.to_string();
+      append_string(str.data(), static_cast<int>(str.size()));
+    }
+  }
+
+  RC end_row()
+  {
+    const size_t payload_len = buffer_.size() - row_start_ - 4;
+    if (payload_len < MAX_PAYLOAD_LENGTH) {
+      store_int3(buffer_.data() + row_start_, static_cast<int32_t>(payload_len));
+      store_int1(buffer_.data() + row_start_ + 3, sequence_id_++);
+    } else {
+      split_row(payload_len);
+    }
+
+    if (buffer_.size() >= FLUSH_THRESHOLD) {
+      return flush();
+    }
+    return RC::SUCCESS;
+  }
+
+  RC flush()
+  {
+    if (buffer_.empty()) {
+      return RC::SUCCESS;
+    }
+    RC rc = writer_.writen(buffer_.data(), static_cast<int32_t>(buffer_.size()));
+    buffer_.clear();
+    return rc;
+  }
+
+private:
+  /**
+   * @brief 把最后一行拆成多个包，除了最后一个包，每个包的长度都是 MAX_PAYLOAD_LENGTH
+   */
+  void split_row(size_t payload_len)
+  {
+    vector<char> payload(buffer_.begin() + row_start_ + 4, buffer_.end());
+    buffer_.resize(row_start_);
+
+    size_t pos = 0;
+    while (true) {
+      const size_t len    = min(payload_len - pos, MAX_PAYLOAD_LENGTH);
+      const size_t header = buffer_.size();
+      buffer_.resize(header + 4);
+      store_int3(buffer_.data() + header, static_cast<int32_t>(len));
+      store_int1(buffer_.data() + header + 3, sequence_id_++);
+      buffer_.insert(buffer_.end(), payload.begin() + pos, payload.begin() + pos + len);
+      pos += len;
+      if (len < MAX_PAYLOAD_LENGTH) {
+        break;
+      }
+    }
+  }
+
+private:
+  static constexpr size_t MAX_PAYLOAD_LENGTH = 0xFFFFFF;
+  static constexpr size_t FLUSH_THRESHOLD    = 64 * 1024;
+
+  BufferedWriter &writer_;
+  int8_t         &sequence_id_;
+  bool            binary_     = false;
+  int             column_num_ = 0;
+  vector<char>    buffer_;
+  size_t          row_start_ = 0;
+};
+
+/**
+ * @brief 按照 common::double_to_str 的格式输出浮点数，保留两位小数并去掉末尾的0
+ * @param buf 至少64个字节
+ * @return 输出的字节数
+ * @ingroup MySQLProtocol
+ */
+int format_float(float value, char *buf)
+{
+  const double rounded = round(static_cast<double>(value) * 100.0);
+  if (!std::isfinite(rounded) || fabs(rounded) >= 1e15) {
+    string str = common::double_to_str(value);
+    const int len = static_cast<int>(min<size_t>(str.size(), 64));
+    memcpy(buf, str.data(), len);
+    return len;
+  }
+
+  char *pos = buf;
+  if (std::signbit(rounded)) {
+    *pos++ = '-';
+  }
+  const uint64_t scaled = static_cast<uint64_t>(fabs(rounded));
+  pos                   = to_chars(pos, buf + 64, scaled / 100).ptr;
+  const int fraction    = static_cast<int>(scaled % 100);
+  if (fraction != 0) {
+    *pos++ = '.';
+    *pos++ = static_cast<char>('0' + fraction / 10);
+    if (fraction % 10 != 0) {
+      *pos++ = static_cast<char>('0' + fraction % 10);
+    }
+  }
+  return static_cast<int>(pos - buf);
+}
+
+/**
+ * @brief 按列把 Chunk 中的值编码成 length-encoded string
+ * @ingroup MySQLProtocol
+ * @details 一次处理一列，按照列的类型使用专门的格式化方法，不需要为每个值构造 Value。
+ * 整数和浮点数直接转换成文本，字符串直接拷贝。其它类型还是通过 Value 转换成字符串。
+ * 所有列都编码完之后，再由 ResultRowWriter 按行把各列的值拼成数据包。
+ */
+class ChunkRowEncoder
+{
+public:
+  void encode(Chunk &chunk)
+  {
+    rows_ = chunk.rows();
+    columns_.resize(chunk.column_num());
+    for (int col_idx = 0; col_idx < chunk.column_num(); col_idx++) {
+      encode_column(chunk, col_idx, columns_[col_idx]);
+    }
+  }
+
+  void write_row(int row, ResultRowWriter &writer) const
+  {
+    writer.begin_row();
+    for (size_t col_idx = 0; col_idx < columns_.size(); col_idx++) {
+      const EncodedColumn &column = columns_[col_idx];
+      if (column.has_null && column.nulls[row]) {
+        writer.append_null(static_cast<int>(col_idx));
+      } else {
+        const uint32_t begin = column.offsets[row];
+        writer.append_encoded(column.data.data() + begin, column.offsets[row + 1] - begin);
+      }
+    }
+  }
+
+private:
+  struct EncodedColumn
+  {
+    vector<char>     data;     ///< 编码后的值依次存放
+    vector<uint32_t> offsets;  ///< 第 i 行的值在 data 中的范围是 [offsets[i], offsets[i+1])
+    vector<uint8_t>  nulls;
+    bool             has_null = false;
+  };
+
+  void encode_column(Chunk &chunk, int col_idx, EncodedColumn &encoded) const
+  {
+    const Column &column   = chunk.column(col_idx);
+    const bool    selected = chunk.has_selection();
+    const bool    constant = column.column_type() == Column::Type::CONSTANT_COLUMN;
+    const bool    raw      = constant || column.column_type() == Column::Type::NORMAL_COLUMN;
+
+    encoded.data.clear();
+    encoded.offsets.assign(1, 0);
+    encoded.has_null = column.has_null();
+    encoded.nulls.assign(encoded.has_null ? rows_ : 0, 0);
+
+    char buf[64];
+    for (int i = 0; i < rows_; i++) {
+      const int row = selected ? chunk.selection()[i] : i;
+      if (encoded.has_null && column.is_null(row)) {
+        encoded.nulls[i] = 1;
+        encoded.offsets.push_back(static_cast<uint32_t>(encoded.data.size()));
+        continue;
+      }
+
+      const int data_row = constant ? 0 : row;
+      if (raw && column.attr_type() == AttrType::INTS) {
+        const int value = reinterpret_cast<const int *>(column.data())[data_row];
+        append(encoded, buf, static_cast<int>(to_chars(buf, buf + sizeof(buf), value).ptr - buf));
+      } else if (raw && column.attr_type() == AttrType::FLOATS) {
+        const float value = reinterpret_cast<const float *>(column.data())[data_row];
+        append(encoded, buf, format_float(value, buf));
+      } else if (column.attr_type() == AttrType::CHARS) {
+        string_view str = column.get_string(row);
+        append(encoded, str.data(), static_cast<int>(str.size()));
+      } else {
+        string str = column.get_value(row).to_string();
+        append(encoded, str.data(), static_cast<int>(str.size()));
+      }
+    }
+  }
+
+  static void append(EncodedColumn &encoded, const char *data, int len)
+  {
+    char lenenc[9];
+    int  lenenc_len = store_lenenc_int(lenenc, len);
+    encoded.data.insert(encoded.data.end(), lenenc, lenenc + lenenc_len);
+    encoded.data.insert(encoded.data.end(), data, data + len);
+    encoded.offsets.push_back(static_cast<uint32_t>(encoded.data.size()));
+  }
+
+private:
+  int                   rows_ = 0;
+  vector<EncodedColumn> columns_;
+};
+
 /**
  * @brief MySQL客户端连接时会发起一个"select @@version_comment"的查询，这里对这个查询进行特殊处理
  * @param[out] sql_result 生成的结果
@@ -678,6 +1176,29 @@ RC MysqlCommunicator::read_event(SessionEvent *&event)
 
     event = new SessionEvent(this);
     event->set_query(query_packet.query);
+  } else if (command_type == 0x16) {  // COM_STMT_PREPARE
+    string sql(buf.data() + 1, buf.size() - 1);
+    sql.append(1, ';');
+    return handle_prepare(sql);
+  } else if (command_type == 0x17) {  // COM_STMT_EXECUTE
+    return read_execute_event(buf, event);
+  } else if (command_type == 0x19) {  // COM_STMT_CLOSE，不需要回复
+    uint32_t stmt_id = 0;
+    if (buf.size() >= 5) {
+      memcpy(&stmt_id, buf.data() + 1, sizeof(stmt_id));
+      session_->close_prepared_statement(stmt_id);
+    }
+  } else if (command_type == 0x1a) {  // COM_STMT_RESET，没有 COM_STMT_SEND_LONG_DATA 缓存的数据，直接回复OK
+    uint32_t stmt_id = 0;
+    if (buf.size() >= 5) {
+      memcpy(&stmt_id, buf.data() + 1, sizeof(stmt_id));
+    }
+    if (session_->prepared_statement(stmt_id) == nullptr) {
+      return send_error(RC::NOTFOUND, "unknown prepared statement");
+    }
+    OkPacket ok_packet(sequence_id_);
+    rc = send_packet(ok_packet);
+    writer_->flush();
   } else {
     /// 其它的非文本请求，暂时不支持
     OkPacket ok_packet(sequence_id_);
@@ -691,6 +1212,96 @@ RC MysqlCommunicator::read_event(SessionEvent *&event)
   return rc;
 }
 
+RC MysqlCommunicator::handle_prepare(const string &sql)
+{
+  PreparedStatement *stmt = nullptr;
+  RC                 rc   = session_->prepare_statement(sql, stmt);
+  if (OB_FAIL(rc)) {
+    return send_error(rc, "failed to prepare statement");
+  }
+
+  LOG_TRACE("prepared statement. id=%u, params=%d, sql=%s", stmt->id(), stmt->param_count(), sql.c_str());
+
+  // 执行之前不知道结果有哪些列，列的个数填0，执行时会发送列描述
+  vector<char> net_packet(1024);
+  char        *buf = net_packet.data();
+  int          pos = 0;
+  pos += 3;
+  pos += store_int1(buf + pos, sequence_id_++);
+  pos += store_int1(buf + pos, 0x00);
+  pos += store_int4(buf + pos, static_cast<int32_t>(stmt->id()));
+  pos += store_int2(buf + pos, 0);  // num_columns
+  pos += store_int2(buf + pos, static_cast<int16_t>(stmt->param_count()));
+  pos += store_int1(buf + pos, 0x00);  // reserved
+  pos += store_int2(buf + pos, 0);     // warning_count
+  if (client_capabilities_flag_ & CLIENT_OPTIONAL_RESULTSET_METADATA) {
+    pos += store_int1(buf + pos, static_cast<int>(ResultSetMetaData::RESULTSET_METADATA_FULL));
+  }
+  store_int3(buf, pos - 4);
+  rc = writer_->writen(buf, pos);
+
+  // 每个参数一个列描述
+  for (int i = 0; OB_SUCC(rc) && i < stmt->param_count(); i++) {
+    pos = 3;
+    pos += store_int1(buf + pos, sequence_id_++);
+    pos += store_column_definition(buf + pos, "", "?");
+    store_int3(buf, pos - 4);
+    rc = writer_->writen(buf, pos);
+  }
+
+  if (OB_SUCC(rc) && stmt->param_count() > 0 && !(client_capabilities_flag_ & CLIENT_DEPRECATE_EOF)) {
+    EofPacket eof_packet;
+    eof_packet.packet_header.sequence_id = sequence_id_++;
+    rc                                   = send_packet(eof_packet);
+  }
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to send prepare response to client. addr=%s, rc=%s", addr(), strrc(rc));
+    return rc;
+  }
+  return writer_->flush();
+}
+
+RC MysqlCommunicator::read_execute_event(const vector<char> &buf, SessionEvent *&event)
+{
+  if (buf.size() < 10) {
+    return send_error(RC::INVALID_ARGUMENT, "malformed execute packet");
+  }
+
+  uint32_t stmt_id = 0;
+  memcpy(&stmt_id, buf.data() + 1, sizeof(stmt_id));
+  PreparedStatement *stmt = session_->prepared_statement(stmt_id);
+  if (nullptr == stmt) {
+    return send_error(RC::NOTFOUND, "unknown prepared statement");
+  }
+
+  vector<Value> params;
+  RC            rc = decode_execute_params(buf, stmt->param_count(), stmt->param_types(), params);
+  if (OB_FAIL(rc)) {
+    return send_error(rc, "failed to decode parameters");
+  }
+
+  event = new SessionEvent(this);
+  event->set_query(stmt->sql());
+  event->set_prepared_statement(stmt, std::move(params));
+  return RC::SUCCESS;
+}
+
+RC MysqlCommunicator::send_error(RC error, const char *message)
+{
+  ErrPacket err_packet;
+  err_packet.packet_header.sequence_id = sequence_id_++;
+  err_packet.error_code                = static_cast<int>(error);
+  err_packet.error_message             = string(strrc(error)) + " > " + message;
+
+  RC rc = send_packet(err_packet);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to send error packet to client. addr=%s, rc=%s", addr(), strrc(rc));
+    return rc;
+  }
+  return writer_->flush();
+}
+
 RC MysqlCommunicator::write_state(SessionEvent *event, bool &need_disconnect)
 {
   SqlResult *sql_result = event->sql_result();
@@ -751,7 +1362,7 @@ RC MysqlCommunicator::write_result(SessionEvent *event, bool &need_disconnect)
 
     need_disconnect = false;
   } else {
-    if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
+    if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_result_set()) {
       return write_state(event, need_disconnect);
     }
 
@@ -866,40 +1477,8 @@ RC MysqlCommunicator::send_column_definition(SqlResult *sql_result, bool &need_d
     store_int1(buf + pos, sequence_id_++);
     pos += 1;
 
-    const TupleCellSpec &spec      = tuple_schema.cell_at(i);
-    const char          *catalog   = "def";  // The catalog used. Currently always "def"
-    const char          *schema    = "sys";  // schema name
-    const char          *table     = spec.table_name();
-    const char          *org_table = spec.table_name();
-    const char          *name      = spec.alias();
-    // const char *org_name = spec.field_name();
-    const char *org_name         = spec.alias();
-    int         fixed_len_fields = 0x0c;
-    int         character_set    = 33;
-    int         column_length    = 16384;
-    int         type             = MYSQL_TYPE_VAR_STRING;
-    int16_t     flags            = 0;
-    int8_t      decimals         = 0x1f;
-
-    pos += store_lenenc_string(buf + pos, catalog);
-    pos += store_lenenc_string(buf + pos, schema);
-    pos += store_lenenc_string(buf + pos, table);
-    pos += store_lenenc_string(buf + pos, org_table);
-    pos += store_lenenc_string(buf + pos, name);
-    pos += store_lenenc_string(buf + pos, org_name);
-    pos += store_lenenc_int(buf + pos, fixed_len_fields);
-    store_int2(buf + pos, character_set);
-    pos += 2;
-    store_int4(buf + pos, column_length);
-    pos += 4;
-    store_int1(buf + pos, type);
-    pos += 1;
-    store_int2(buf + pos, flags);
-    pos += 2;
-    store_int1(buf + pos, decimals);
-    pos += 1;
-    store_int2(buf + pos, 0);  // 按照mariadb的文档描述，最后还有一个unused字段int<2>，不过mysql的文档没有给出这样的描述
-    pos += 2;
+    const TupleCellSpec &spec = tuple_schema.cell_at(i);
+    pos += store_column_definition(buf + pos, spec.table_name(), spec.alias());
 
     payload_length = pos - 4;
     store_int3(buf, payload_length);
@@ -941,15 +1520,14 @@ RC MysqlCommunicator::send_result_rows(SessionEvent *event, SqlResult *sql_resul
 {
   RC rc = RC::SUCCESS;
 
-  vector<char> packet;
-  packet.resize(4 * 1024 * 1024);  // TODO warning: length cannot be fix
-
-  int    affected_rows = 0;
+  // COM_QUERY 的结果使用文本协议，执行预处理语句的结果使用二进制协议
+  const bool binary        = event->prepared_statement() != nullptr;
+  int        affected_rows = 0;
   if (event->session()->get_execution_mode() == ExecutionMode::CHUNK_ITERATOR
       && event->session()->used_chunk_mode()) {
-    rc = write_chunk_result(sql_result, packet, affected_rows, need_disconnect);
+    rc = write_chunk_result(sql_result, binary, affected_rows, need_disconnect);
   } else {
-    rc = write_tuple_result(sql_result, packet, affected_rows, need_disconnect);
+    rc = write_tuple_result(sql_result, binary, affected_rows, need_disconnect);
   }
 
   // 所有行发送完成后，发送一个EOF或OK包
@@ -971,79 +1549,72 @@ RC MysqlCommunicator::send_result_rows(SessionEvent *event, SqlResult *sql_resul
   return rc;
 }
 
-RC MysqlCommunicator::write_tuple_result(SqlResult *sql_result, vector<char> &packet, int &affected_rows, bool &need_disconnect)
+RC MysqlCommunicator::write_tuple_result(SqlResult *sql_result, bool binary, int &affected_rows, bool &need_disconnect)
 {
-  Tuple *tuple         = nullptr;
-  RC rc = RC::SUCCESS;
+  const int       cell_num = sql_result->tuple_schema().cell_num();
+  ResultRowWriter row_writer(*writer_, sequence_id_, binary, cell_num);
+
+  Tuple *tuple = nullptr;
+  RC     rc    = RC::SUCCESS;
   while (RC::SUCCESS == (rc = sql_result->next_tuple(tuple))) {
     assert(tuple != nullptr);
 
     affected_rows++;
 
-    const int cell_num = tuple->cell_num();
-    if (cell_num == 0) {
+    if (tuple->cell_num() == 0) {
       continue;
     }
 
-    // https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset.html
-    // https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset_row.html
-    // note: if some field is null, send a 0xFB
-    char *buf = packet.data();
-    int   pos = 0;
-
-    pos += 3;
-    pos += store_int1(buf + pos, sequence_id_++);
-
     Value value;
-    for (int i = 0; i < cell_num; i++) {
+    row_writer.begin_row();
+    for (int i = 0; i < tuple->cell_num(); i++) {
       rc = tuple->cell_at(i, value);
       if (rc != RC::SUCCESS) {
         sql_result->set_return_code(rc);
         break;  // TODO send error packet
       }
 
-      pos += store_lenenc_string(buf + pos, value.to_string().c_str());
+      row_writer.append_value(i, value);
     }
 
-    int payload_length = pos - 4;
-    store_int3(buf, payload_length);
-    rc = writer_->writen(buf, pos);
+    rc = row_writer.end_row();
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to send row packet to client. addr=%s, error=%s", addr(), strerror(errno));
       need_disconnect = true;
       return rc;
     }
   }
+
+  RC flush_rc = row_writer.flush();
+  if (OB_FAIL(flush_rc)) {
+    LOG_WARN("failed to send row packet to client. addr=%s, error=%s", addr(), strerror(errno));
+    need_disconnect = true;
+    return flush_rc;
+  }
   return rc;
 }
-RC MysqlCommunicator::write_chunk_result(SqlResult *sql_result, vector<char> &packet, int &affected_rows, bool &need_disconnect)
+
+/**
+ * 一次编码一个 Chunk，先按列格式化，再按行发送
+ */
+RC MysqlCommunicator::write_chunk_result(SqlResult *sql_result, bool binary, int &affected_rows, bool &need_disconnect)
 {
+  const int       cell_num = sql_result->tuple_schema().cell_num();
+  ResultRowWriter row_writer(*writer_, sequence_id_, binary, cell_num);
+  ChunkRowEncoder encoder;
+
   Chunk chunk;
-  RC rc = RC::SUCCESS;
+  RC    rc = RC::SUCCESS;
   while (RC::SUCCESS == (rc = sql_result->next_chunk(chunk))) {
-    int column_num = chunk.column_num();
-    if (column_num == 0) {
+    if (chunk.column_num() == 0) {
       continue;
     }
+
+    encoder.encode(chunk);
     for (int i = 0; i < chunk.rows(); i++) {
       affected_rows++;
-      // https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset.html
-      // https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset_row.html
-      // note: if some field is null, send a 0xFB
-      char *buf = packet.data();
-      int   pos = 0;
-
-      pos += 3;
-      pos += store_int1(buf + pos, sequence_id_++);
-
-      for (int col_idx = 0; col_idx < column_num; col_idx++) {
-        Value value = chunk.get_value(col_idx, i);
-        pos += store_lenenc_string(buf + pos, value.to_string().c_str());
-      }
-
-      int payload_length = pos - 4;
-      store_int3(buf, payload_length);
-      rc = writer_->writen(buf, pos);
+      encoder.write_row(i, row_writer);
+      rc = row_writer.end_row();
       if (OB_FAIL(rc)) {
         LOG_WARN("failed to send row packet to client. addr=%s, error=%s", addr(), strerror(errno));
         need_disconnect = true;
@@ -1051,5 +1622,12 @@ RC MysqlCommunicator::write_chunk_result(SqlResult *sql_result, vector<char> &pa
       }
     }
   }
+
+  RC flush_rc = row_writer.flush();
+  if (OB_FAIL(flush_rc)) {
+    LOG_WARN("failed to send row packet to client. addr=%s, error=%s", addr(), strerror(errno));
+    need_disconnect = true;
+    return flush_rc;
+  }
   return rc;
 }
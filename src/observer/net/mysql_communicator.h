@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "net/communicator.h"
 #include "common/lang/string.h"
+#include "common/lang/vector.h"
 
 class SqlResult;
 class BasePacket;
@@ -91,8 +92,29 @@ private:
    */
   RC handle_version_comment(bool &need_disconnect);
 
-  RC write_tuple_result(SqlResult *sql_result, vector<char> &packet, int &affected_rows, bool &need_disconnect);
-  RC write_chunk_result(SqlResult *sql_result, vector<char> &packet, int &affected_rows, bool &need_disconnect);
+  /**
+   * @brief 处理 COM_STMT_PREPARE 请求，创建预处理语句并回复 COM_STMT_PREPARE_OK
+   * @details [COM_STMT_PREPARE](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_stmt_prepare.html)
+   */
+  RC handle_prepare(const string &sql);
+
+  /**
+   * @brief 处理 COM_STMT_EXECUTE 请求，绑定参数之后生成一个执行预处理语句的请求
+   * @param[out] event 出错时不生成请求，直接回复错误
+   */
+  RC read_execute_event(const vector<char> &buf, SessionEvent *&event);
+
+  /**
+   * @brief 回复一个ERR包
+   */
+  RC send_error(RC error, const char *message);
+
+  /**
+   * @brief 发送结果集中的所有行，攒够一批数据之后再写到 BufferedWriter 中
+   * @param binary 是否使用二进制协议编码行数据，预处理语句的执行结果使用二进制协议
+   */
+  RC write_tuple_result(SqlResult *sql_result, bool binary, int &affected_rows, bool &need_disconnect);
+  RC write_chunk_result(SqlResult *sql_result, bool binary, int &affected_rows, bool &need_disconnect);
 
 private:
   //! 握手阶段(鉴权)，需要做一些特殊处理，所以加个字段单独标记
@@ -190,7 +190,7 @@ RC PlainCommunicator::write_result_internal(SessionEvent *event, bool &need_disc
 
   SqlResult *sql_result = event->sql_result();
 
-  if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_operator()) {
+  if (RC::SUCCESS != sql_result->return_code() || !sql_result->has_result_set()) {
     return write_state(event, need_disconnect);
   }
 
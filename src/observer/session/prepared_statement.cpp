@@ -0,0 +1,116 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "session/prepared_statement.h"
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/parser/parse.h"
+
+PreparedStatement::PreparedStatement(uint32_t id, const string &sql) : id_(id), sql_(sql) {}
+
+RC PreparedStatement::prepare()
+{
+  // 预处理时还没有参数，占位符都当做NULL
+  const vector<Value> no_values;
+  ParsedSqlResult     sql_result;
+  sql_result.set_placeholder_values(&no_values);
+  ::parse(sql_.c_str(), &sql_result);
+  if (sql_result.sql_nodes().size() != 1 || sql_result.sql_nodes().front()->flag == SCF_ERROR) {
+    LOG_INFO("failed to prepare sql. sql=%s", sql_.c_str());
+    return RC::SQL_SYNTAX;
+  }
+
+  param_count_ = sql_result.placeholder_count();
+
+  if (OB_FAIL(parse_fingerprint(sql_.c_str(), fingerprint_, params_, placeholders_))) {
+    fingerprint_.clear();
+    params_.clear();
+    placeholders_.clear();
+  }
+
+  ParsedSqlNode &sql_node = *sql_result.sql_nodes().front();
+  if (sql_node.flag == SCF_INSERT) {
+    // 占位符出现在表达式中的（比如 -?），需要每次重新计算，不能直接替换
+    int direct_num = 0;
+    for (int placeholder : sql_node.insertion.placeholders) {
+      if (placeholder >= 0) {
+        direct_num++;
+      }
+    }
+    if (direct_num == param_count_) {
+      insertion_ = make_unique<InsertSqlNode>(sql_node.insertion);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC PreparedStatement::fingerprint(const vector<Value> &values, string &fingerprint, vector<Value> &params) const
+{
+  fingerprint.clear();
+  params.clear();
+  if (fingerprint_.empty()) {
+    return RC::UNSUPPORTED;
+  }
+
+  // 占位符替换成与常量相同的带类型的占位符，NULL不是参数，保持原样
+  size_t copied      = 0;
+  size_t placeholder = 0;
+  for (const Value &param : params_) {
+    if (param.attr_type() != AttrType::UNDEFINED) {
+      params.push_back(param);
+      continue;
+    }
+
+    const size_t offset = placeholders_[placeholder];
+    fingerprint.append(fingerprint_, copied, offset - copied);
+    copied = offset + 1;
+
+    const Value &value = values[placeholder++];
+    if (value.is_null()) {
+      fingerprint.append("null");
+      continue;
+    }
+
+    switch (value.attr_type()) {
+      case AttrType::INTS: fingerprint.append("?i"); break;
+      case AttrType::FLOATS: fingerprint.append("?f"); break;
+      case AttrType::CHARS: fingerprint.append("?s"); break;
+      default: return RC::UNSUPPORTED;
+    }
+    params.push_back(value);
+  }
+  fingerprint.append(fingerprint_, copied);
+  return RC::SUCCESS;
+}
+
+RC PreparedStatement::parse(const vector<Value> &values, ParsedSqlResult *sql_result) const
+{
+  if (static_cast<int>(values.size()) != param_count_) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (insertion_ != nullptr) {
+    auto sql_node       = make_unique<ParsedSqlNode>(SCF_INSERT);
+    sql_node->insertion = *insertion_;
+    for (size_t i = 0; i < sql_node->insertion.values.size(); i++) {
+      const int placeholder = sql_node->insertion.placeholders[i];
+      if (placeholder >= 0) {
+        sql_node->insertion.values[i] = values[placeholder];
+      }
+    }
+    sql_result->add_sql_node(std::move(sql_node));
+    return RC::SUCCESS;
+  }
+
+  sql_result->set_placeholder_values(&values);
+  ::parse(sql_.c_str(), sql_result);
+  sql_result->set_placeholder_values(nullptr);
+  return RC::SUCCESS;
+}
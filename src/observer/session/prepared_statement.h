@@ -0,0 +1,72 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+
+/**
+ * @brief 预处理语句
+ * @details 客户端通过 COM_STMT_PREPARE 发送带有占位符'?'的SQL，之后每次执行只发送参数。
+ * 预处理时做一次语法检查，统计占位符个数，并记录执行时需要的信息：
+ * - SELECT 语句记录带有占位符的指纹。执行时把参数的类型填到指纹中，就得到与直接写出这些常量的SQL相同的指纹，
+ *   通过计划缓存复用执行计划，命中时不再需要语法分析、语义分析和优化；
+ * - INSERT 语句如果每个占位符都直接作为一个插入的值，就保存语法分析的结果，执行时替换其中的值，不再做语法分析；
+ * - 其它语句每次执行时带着参数重新做语法分析。
+ */
+class PreparedStatement
+{
+public:
+  PreparedStatement(uint32_t id, const string &sql);
+  ~PreparedStatement() = default;
+
+  /**
+   * @brief 预处理，检查SQL的语法
+   */
+  RC prepare();
+
+  uint32_t      id() const { return id_; }
+  const string &sql() const { return sql_; }
+  int           param_count() const { return param_count_; }
+
+  /**
+   * @brief 客户端上一次执行时发送的参数类型
+   * @details MySQL协议中，客户端可以只在第一次执行时发送参数类型
+   */
+  vector<uint16_t> &param_types() { return param_types_; }
+
+  /**
+   * @brief 绑定参数，计算SQL的指纹以及SQL中的常量
+   * @details 与 parse_fingerprint 使用直接写出这些参数的SQL计算出来的结果相同。不支持缓存的语句返回 RC::UNSUPPORTED
+   */
+  RC fingerprint(const vector<Value> &values, string &fingerprint, vector<Value> &params) const;
+
+  /**
+   * @brief 绑定参数，得到语法分析的结果
+   */
+  RC parse(const vector<Value> &values, ParsedSqlResult *sql_result) const;
+
+private:
+  uint32_t         id_;
+  string           sql_;
+  int              param_count_ = 0;  ///< 占位符的个数
+  vector<uint16_t> param_types_;
+
+  string         fingerprint_;   ///< 带有占位符的指纹，为空表示不支持缓存
+  vector<Value>  params_;        ///< SQL中的常量，占位符对应的是未定义的值
+  vector<size_t> placeholders_;  ///< 每个占位符在指纹中的偏移
+
+  unique_ptr<InsertSqlNode> insertion_;  ///< 可以直接替换参数的INSERT语句
+};
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "session/session.h"
 #include "common/global_context.h"
+#include "session/prepared_statement.h"
 #include "storage/db/db.h"
 #include "storage/default/default_handler.h"
 #include "storage/trx/trx.h"
@@ -26,6 +27,28 @@ Session &Session::default_session()
 
 Session::Session(const Session &other) : db_(other.db_) {}
 
+RC Session::prepare_statement(const string &sql, PreparedStatement *&stmt)
+{
+  auto prepared = make_unique<PreparedStatement>(next_statement_id_, sql);
+  RC   rc       = prepared->prepare();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  next_statement_id_++;
+  stmt = prepared.get();
+  prepared_statements_[stmt->id()] = std::move(prepared);
+  return RC::SUCCESS;
+}
+
+PreparedStatement *Session::prepared_statement(uint32_t id) const
+{
+  auto iter = prepared_statements_.find(id);
+  return iter == prepared_statements_.end() ? nullptr : iter->second.get();
+}
+
+void Session::close_prepared_statement(uint32_t id) { prepared_statements_.erase(id); }
+
 Session::~Session()
 {
   if (nullptr != trx_) {
@@ -15,11 +15,15 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/types.h"
+#include "common/lang/memory.h"
 #include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/sys/rc.h"
 
 class Trx;
 class Db;
 class SessionEvent;
+class PreparedStatement;
 
 /**
  * @brief 表示会话
@@ -88,6 +92,15 @@ public:
   void set_use_cascade(bool use_cascade) { use_cascade_ = use_cascade; }
   bool use_cascade() const { return use_cascade_; }
 
+  void set_query_cache(bool query_cache) { query_cache_ = query_cache; }
+  bool query_cache_on() const { return query_cache_; }
+
+  void    set_sort_buffer_size(int64_t sort_buffer_size) { sort_buffer_size_ = sort_buffer_size; }
+  int64_t sort_buffer_size() const { return sort_buffer_size_; }
+
+  void    set_join_buffer_size(int64_t join_buffer_size) { join_buffer_size_ = join_buffer_size; }
+  int64_t join_buffer_size() const { return join_buffer_size_; }
+
   void          set_execution_mode(const ExecutionMode mode) { execution_mode_ = mode; }
   ExecutionMode get_execution_mode() const { return execution_mode_; }
 
@@ -95,6 +108,20 @@ public:
 
   void set_used_chunk_mode(bool used_chunk_mode) { used_chunk_mode_ = used_chunk_mode; }
 
+  /**
+   * @brief 创建一个预处理语句
+   * @param sql  带有占位符'?'的SQL
+   * @param stmt 创建的预处理语句，由会话管理，直到关闭或会话结束
+   */
+  RC prepare_statement(const string &sql, PreparedStatement *&stmt);
+
+  /**
+   * @brief 按照编号查找预处理语句，找不到返回空
+   */
+  PreparedStatement *prepared_statement(uint32_t id) const;
+
+  void close_prepared_statement(uint32_t id);
+
   /**
    * @brief 将指定会话设置到线程变量中
    *
@@ -117,10 +144,17 @@ private:
   bool sql_debug_   = false;  ///< 是否输出SQL调试信息
   bool hash_join_   = false;  ///< 是否使用hash join
   bool use_cascade_ = false;  ///< 是否使用 cascade 优化器
+  bool query_cache_ = true;   ///< 是否使用查询结果缓存
+
+  int64_t sort_buffer_size_ = 16 * 1024 * 1024;  ///< 排序可以使用的内存大小，超过后会落盘
+  int64_t join_buffer_size_ = 16 * 1024 * 1024;  ///< Hash Join 的哈希表可以使用的内存大小，超过后会落盘
 
   // 是否使用了 `chunk_iterator` 模式。 只有在设置了 `chunk_iterator`
   // 并且可以生成相关物理执行计划时才会使用 `chunk_iterator` 模式。
   bool used_chunk_mode_ = false;
 
   ExecutionMode execution_mode_ = ExecutionMode::TUPLE_ITERATOR;
+
+  unordered_map<uint32_t, unique_ptr<PreparedStatement>> prepared_statements_;  ///< 当前会话的预处理语句
+  uint32_t                                               next_statement_id_ = 1;
 };
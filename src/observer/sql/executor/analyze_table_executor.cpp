@@ -18,7 +18,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/db/db.h"
 #include "storage/table/table.h"
 #include "catalog/catalog.h"
-#include "storage/record/record_scanner.h"
+#include "sql/optimizer/statistics/table_statistics.h"
+#include "storage/common/meta_util.h"
 
 using namespace std;
 
@@ -39,34 +40,23 @@ RC AnalyzeTableExecutor::execute(SQLStageEvent *sql_event)
   Db    *db    = session->get_current_db();
   Table *table = db->find_table(table_name);
   if (table != nullptr) {
-    // TODO: optimize the analyze table compute. we can only get table statistics from metadata
-    // Don't really scan the whole table!!
-    int table_id = table->table_id();
-    table->get_record_scanner(scanner_, session->current_trx(), ReadWriteMode::READ_ONLY);
-    Record dummy;
-    int row_nums = 0;
-    while (OB_SUCC(rc = scanner_->next(dummy))) {
-      row_nums++;
+    TableStats stats;
+    rc = TableStatistics::analyze(table, session->current_trx(), stats);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to analyze table. table=%s, rc=%s", table_name, strrc(rc));
+      return rc;
     }
-    if (rc == RC::RECORD_EOF) {
-      rc = RC::SUCCESS;
-    } else {
+
+    // 统计信息保存到文件中，重启之后不需要再分析一次
+    string stats_file = table_stats_file(db->path().c_str(), table_name);
+    rc = Catalog::get_instance().save_table_stats(table->table_id(), stats, stats_file);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to save table stats. table=%s, rc=%s", table_name, strrc(rc));
       return rc;
     }
-  
-    TableStats stats(row_nums);
-    Catalog::get_instance().update_table_stats(table_id, stats);
   } else {
     sql_result->set_return_code(RC::SCHEMA_TABLE_NOT_EXIST);
     sql_result->set_state_string("Table not exists");
   }
   return rc;
 }
-
-AnalyzeTableExecutor::~AnalyzeTableExecutor() 
-{
-  if (scanner_ != nullptr) {
-    delete scanner_;
-    scanner_ = nullptr;
-  }
-}
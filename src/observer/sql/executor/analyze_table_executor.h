@@ -13,7 +13,6 @@ See the Mulan PSL v2 for more details. */
 #include "common/sys/rc.h"
 
 class SQLStageEvent;
-class RecordScanner;
 
 /**
  * @brief 分析表的执行器(analyze table)
@@ -23,10 +22,7 @@ class AnalyzeTableExecutor
 {
 public:
   AnalyzeTableExecutor() = default;
-  virtual ~AnalyzeTableExecutor();
+  virtual ~AnalyzeTableExecutor() = default;
 
   RC execute(SQLStageEvent *sql_event);
-
-private:
-  RecordScanner *scanner_ = nullptr;
 };
@@ -25,9 +25,11 @@ See the Mulan PSL v2 for more details. */
 #include "sql/executor/help_executor.h"
 #include "sql/executor/load_data_executor.h"
 #include "sql/executor/set_variable_executor.h"
+#include "sql/executor/show_status_executor.h"
 #include "sql/executor/show_tables_executor.h"
 #include "sql/executor/trx_begin_executor.h"
 #include "sql/executor/trx_end_executor.h"
+#include "sql/plan_cache/plan_cache.h"
 #include "sql/stmt/stmt.h"
 
 RC CommandExecutor::execute(SQLStageEvent *sql_event)
@@ -81,6 +83,11 @@ RC CommandExecutor::execute(SQLStageEvent *sql_event)
       rc = executor.execute(sql_event);
     } break;
 
+    case StmtType::SHOW_STATUS: {
+      ShowStatusExecutor executor;
+      rc = executor.execute(sql_event);
+    } break;
+
     case StmtType::BEGIN: {
       TrxBeginExecutor executor;
       rc = executor.execute(sql_event);
@@ -112,6 +119,11 @@ RC CommandExecutor::execute(SQLStageEvent *sql_event)
     } break;
   }
 
+  if (OB_SUCC(rc) && (stmt_type_ddl(stmt->type()) || stmt->type() == StmtType::ANALYZE_TABLE)) {
+    // 表结构或者统计信息变化之后，缓存的执行计划可能不再正确
+    sql_event->session_event()->session()->get_current_db()->plan_cache().invalidate();
+  }
+
   if (OB_SUCC(rc) && stmt_type_ddl(stmt->type())) {
     // 每次做完DDL之后，做一次sync，保证元数据与日志保持一致
     rc = sql_event->session_event()->session()->get_current_db()->sync();
@@ -17,8 +17,11 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
+#include "session/session.h"
 #include "sql/executor/command_executor.h"
 #include "sql/operator/calc_physical_operator.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/query_cache/query_cache.h"
 #include "sql/stmt/select_stmt.h"
 #include "sql/stmt/stmt.h"
 #include "storage/default/default_handler.h"
@@ -55,6 +58,20 @@ RC ExecuteStage::handle_request_with_physical_operator(SQLStageEvent *sql_event)
   ASSERT(physical_operator != nullptr, "physical operator should not be null");
 
   SqlResult *sql_result = sql_event->session_event()->sql_result();
+
+  // 查询缓存只收集按行返回的结果。查询依赖的表需要在执行之前记录下数据版本
+  unique_ptr<CachedResult> &cached_result = sql_event->cached_result();
+  if (cached_result != nullptr && !sql_event->session_event()->session()->used_chunk_mode()) {
+    vector<const Table *> tables;
+    if (OB_SUCC(physical_operator->related_tables(tables))) {
+      cached_result->add_tables(tables);
+      sql_result->set_result_to_cache(std::move(cached_result));
+    }
+  }
+
   sql_result->set_operator(std::move(physical_operator));
+  if (sql_event->cached_plan() != nullptr) {
+    sql_result->set_cached_plan(std::move(sql_event->cached_plan()));
+  }
   return rc;
 }
@@ -33,19 +33,25 @@ RC LoadDataExecutor::execute(SQLStageEvent *sql_event)
 }
 
 /**
- * 从文件中导入数据时使用。尝试向表中插入解析后的一行数据。
+ * 一次插入多少行。一批记录一起交给存储引擎，LSM 引擎把它们作为一个 write batch 写入
+ */
+static constexpr size_t LOAD_DATA_BATCH_SIZE = 1024;
+
+/**
+ * 从文件中导入数据时使用。把解析后的一行数据生成一条记录。
  * @param table  要导入的表
  * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值
- * @param record_values Table::insert_record使用的参数，为了防止频繁的申请内存
+ * @param record_values Table::make_record使用的参数，为了防止频繁的申请内存
+ * @param record 生成的记录
  * @param errmsg 如果出现错误，通过这个参数返回错误信息
  * @return 成功返回RC::SUCCESS
  */
-RC insert_record_from_file(
-    Table *table, vector<string> &file_values, vector<Value> &record_values, stringstream &errmsg)
+RC make_record_from_file(
+    Table *table, vector<string> &file_values, vector<Value> &record_values, Record &record, stringstream &errmsg)
 {
 
-  const int field_num     = record_values.size();
-  const int sys_field_num = table->table_meta().sys_field_num();
+  const int field_num           = record_values.size();
+  const int unvisible_field_num = table->table_meta().unvisible_field_num();
 
   if (file_values.size() < record_values.size()) {
     return RC::SCHEMA_FIELD_MISSING;
@@ -55,7 +61,7 @@ RC insert_record_from_file(
 
   stringstream deserialize_stream;
   for (int i = 0; i < field_num && RC::SUCCESS == rc; i++) {
-    const FieldMeta *field = table->table_meta().field(i + sys_field_num);
+    const FieldMeta *field = table->table_meta().field(i + unvisible_field_num);
 
     string &file_value = file_values[i];
     if (field->type() != AttrType::CHARS) {
@@ -65,12 +71,9 @@ RC insert_record_from_file(
   }
 
   if (RC::SUCCESS == rc) {
-    Record record;
     rc = table->make_record(field_num, record_values.data(), record);
     if (rc != RC::SUCCESS) {
       errmsg << "insert failed.";
-    } else if (RC::SUCCESS != (rc = table->insert_record(record))) {
-      errmsg << "insert failed.";
     }
   }
   return rc;
@@ -91,8 +94,8 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
 
   struct timespec begin_time;
   clock_gettime(CLOCK_MONOTONIC, &begin_time);
-  const int sys_field_num = table->table_meta().sys_field_num();
-  const int field_num     = table->table_meta().field_num() - sys_field_num;
+  // 系统字段和 null bitmap 字段不在文件中
+  const int field_num = table->table_meta().visible_field_num();
 
   vector<Value>       record_values(field_num);
   string              line;
@@ -101,6 +104,25 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
   int                      line_num        = 0;
   int                      insertion_count = 0;
   RC                       rc              = RC::SUCCESS;
+
+  vector<Record> records;
+  int            batch_begin_line = 0;
+  int            batch_end_line   = 0;
+  auto           insert_batch     = [&]() {
+    if (records.empty()) {
+      return RC::SUCCESS;
+    }
+    RC rc = table->insert_records(records);
+    if (rc != RC::SUCCESS) {
+      result_string << "Line:" << batch_begin_line << "-" << batch_end_line
+                    << " insert records failed. error:" << strrc(rc) << endl;
+    } else {
+      insertion_count += static_cast<int>(records.size());
+    }
+    records.clear();
+    return rc;
+  };
+
   while (!fs.eof() && RC::SUCCESS == rc) {
     getline(fs, line);
     line_num++;
@@ -111,14 +133,28 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
     file_values.clear();
     common::split_string(line, delim, file_values);
     stringstream errmsg;
-    rc = insert_record_from_file(table, file_values, record_values, errmsg);
+    Record       record;
+    rc = make_record_from_file(table, file_values, record_values, record, errmsg);
     if (rc != RC::SUCCESS) {
       result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
                     << endl;
-    } else {
-      insertion_count++;
+      // 和逐行插入时一样，出错之前的行都插入进去
+      insert_batch();
+      break;
+    }
+
+    if (records.empty()) {
+      batch_begin_line = line_num;
+    }
+    records.emplace_back(std::move(record));
+    batch_end_line = line_num;
+    if (records.size() >= LOAD_DATA_BATCH_SIZE) {
+      rc = insert_batch();
     }
   }
+  if (RC::SUCCESS == rc) {
+    rc = insert_batch();
+  }
   fs.close();
 
   struct timespec end_time;
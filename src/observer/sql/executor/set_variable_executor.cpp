@@ -50,6 +50,27 @@ RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
       session->set_use_cascade(bool_value);
       LOG_TRACE("set use_cascade to %d", bool_value);
     }
+  } else if (strcasecmp(var_name, "query_cache") == 0) {
+    bool bool_value = false;
+    rc              = var_value_to_boolean(var_value, bool_value);
+    if (rc == RC::SUCCESS) {
+      session->set_query_cache(bool_value);
+      LOG_TRACE("set query_cache to %d", bool_value);
+    }
+  } else if (strcasecmp(var_name, "sort_buffer_size") == 0) {
+    if (var_value.attr_type() == AttrType::INTS && var_value.get_int() > 0) {
+      session->set_sort_buffer_size(var_value.get_int());
+      LOG_TRACE("set sort_buffer_size to %d", var_value.get_int());
+    } else {
+      rc = RC::VARIABLE_NOT_VALID;
+    }
+  } else if (strcasecmp(var_name, "join_buffer_size") == 0) {
+    if (var_value.attr_type() == AttrType::INTS && var_value.get_int() > 0) {
+      session->set_join_buffer_size(var_value.get_int());
+      LOG_TRACE("set join_buffer_size to %d", var_value.get_int());
+    } else {
+      rc = RC::VARIABLE_NOT_VALID;
+    }
   } else if (strcasecmp(var_name, "names") == 0) {
     // for ann_benchmark
     return RC::SUCCESS;
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/sys/rc.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/executor/sql_result.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/query_cache/query_cache.h"
+#include "storage/db/db.h"
+
+/**
+ * @brief 显示数据库运行状态的执行器
+ * @ingroup Executor
+ * @details 每一行是一个状态变量的名字和值，与MySQL的SHOW STATUS类似
+ */
+class ShowStatusExecutor
+{
+public:
+  ShowStatusExecutor()          = default;
+  virtual ~ShowStatusExecutor() = default;
+
+  RC execute(SQLStageEvent *sql_event)
+  {
+    SqlResult    *sql_result    = sql_event->session_event()->sql_result();
+    SessionEvent *session_event = sql_event->session_event();
+
+    Db *db = session_event->session()->get_current_db();
+
+    TupleSchema tuple_schema;
+    tuple_schema.append_cell(TupleCellSpec("", "Variable_name", "Variable_name"));
+    tuple_schema.append_cell(TupleCellSpec("", "Value", "Value"));
+    sql_result->set_tuple_schema(tuple_schema);
+
+    auto oper = new StringListPhysicalOperator;
+
+    PlanCache &plan_cache = db->plan_cache();
+    oper->append({"Plan_cache_hits", std::to_string(plan_cache.hits())});
+    oper->append({"Plan_cache_misses", std::to_string(plan_cache.misses())});
+    oper->append({"Plan_cache_evictions", std::to_string(plan_cache.evictions())});
+    oper->append({"Plan_cache_invalidations", std::to_string(plan_cache.invalidations())});
+    oper->append({"Plan_cache_entries", std::to_string(plan_cache.count())});
+
+    QueryCache &query_cache = db->query_cache();
+    oper->append({"Query_cache_hits", std::to_string(query_cache.hits())});
+    oper->append({"Query_cache_misses", std::to_string(query_cache.misses())});
+    oper->append({"Query_cache_inserts", std::to_string(query_cache.inserts())});
+    oper->append({"Query_cache_evictions", std::to_string(query_cache.evictions())});
+    oper->append({"Query_cache_invalidations", std::to_string(query_cache.invalidations())});
+    oper->append({"Query_cache_entries", std::to_string(query_cache.count())});
+    oper->append({"Query_cache_memory", std::to_string(query_cache.memory_usage())});
+
+    sql_result->set_operator(unique_ptr<PhysicalOperator>(oper));
+    return RC::SUCCESS;
+  }
+};
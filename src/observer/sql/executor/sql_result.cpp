@@ -16,14 +16,28 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "common/sys/rc.h"
 #include "session/session.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/query_cache/query_cache.h"
 #include "storage/trx/trx.h"
 
 SqlResult::SqlResult(Session *session) : session_(session) {}
 
+SqlResult::~SqlResult() = default;
+
 void SqlResult::set_tuple_schema(const TupleSchema &schema) { tuple_schema_ = schema; }
 
 RC SqlResult::open()
 {
+  if (cached_result_ != nullptr) {
+    vector<TupleCellSpec> specs;
+    for (int i = 0; i < tuple_schema_.cell_num(); i++) {
+      specs.push_back(tuple_schema_.cell_at(i));
+    }
+    cached_tuple_.set_names(specs);
+    cached_row_index_ = 0;
+    return RC::SUCCESS;
+  }
+
   if (nullptr == operator_) {
     return RC::INVALID_ARGUMENT;
   }
@@ -35,6 +49,12 @@ RC SqlResult::open()
 
 RC SqlResult::close()
 {
+  if (cached_result_ != nullptr) {
+    // 缓存的结果没有执行计划，也没有开启事务
+    cached_result_.reset();
+    return RC::SUCCESS;
+  }
+
   if (nullptr == operator_) {
     return RC::INVALID_ARGUMENT;
   }
@@ -43,6 +63,24 @@ RC SqlResult::close()
     LOG_WARN("failed to close operator. rc=%s", strrc(rc));
   }
 
+  if (result_to_cache_ != nullptr) {
+    if (rc == RC::SUCCESS && result_eof_) {
+      result_to_cache_->set_tuple_schema(tuple_schema_);
+      QueryCache *query_cache = result_to_cache_->owner();
+      query_cache->put(std::move(result_to_cache_), session_->get_current_db());
+    }
+    result_to_cache_.reset();
+  }
+
+  if (cached_plan_ != nullptr) {
+    if (rc == RC::SUCCESS) {
+      cached_plan_->set_operator(std::move(operator_));
+      PlanCache *plan_cache = cached_plan_->owner();
+      plan_cache->release(std::move(cached_plan_));
+    }
+    cached_plan_.reset();
+  }
+
   operator_.reset();
 
   if (session_ && !session_->is_trx_multi_operation_mode()) {
@@ -61,21 +99,61 @@ RC SqlResult::close()
 
 RC SqlResult::next_tuple(Tuple *&tuple)
 {
+  if (cached_result_ != nullptr) {
+    return next_cached_tuple(tuple);
+  }
+
   RC rc = operator_->next();
   if (rc != RC::SUCCESS) {
+    result_eof_ = (rc == RC::RECORD_EOF);
     return rc;
   }
 
   tuple = operator_->current_tuple();
+  if (result_to_cache_ != nullptr) {
+    RC cache_rc = result_to_cache_->add_row(*tuple);
+    if (OB_FAIL(cache_rc)) {
+      // 结果太大或者无法获取字段值，不再缓存这个结果
+      LOG_TRACE("give up caching query result. rc=%s", strrc(cache_rc));
+      result_to_cache_.reset();
+    }
+  }
   return rc;
 }
 
+RC SqlResult::next_cached_tuple(Tuple *&tuple)
+{
+  const vector<vector<Value>> &rows = cached_result_->rows();
+  if (cached_row_index_ >= rows.size()) {
+    return RC::RECORD_EOF;
+  }
+
+  cached_tuple_.set_cells(rows[cached_row_index_]);
+  cached_row_index_++;
+  tuple = &cached_tuple_;
+  return RC::SUCCESS;
+}
+
 RC SqlResult::next_chunk(Chunk &chunk)
 {
   RC rc = operator_->next(chunk);
   return rc;
 }
 
+void SqlResult::set_cached_plan(unique_ptr<CachedPlan> cached_plan) { cached_plan_ = std::move(cached_plan); }
+
+void SqlResult::set_cached_result(shared_ptr<const CachedResult> cached_result)
+{
+  cached_result_ = std::move(cached_result);
+  tuple_schema_  = cached_result_->tuple_schema();
+}
+
+void SqlResult::set_result_to_cache(unique_ptr<CachedResult> result_to_cache)
+{
+  result_to_cache_ = std::move(result_to_cache);
+  result_eof_      = false;
+}
+
 void SqlResult::set_operator(unique_ptr<PhysicalOperator> oper)
 {
   ASSERT(operator_ == nullptr, "current operator is not null. Result is not closed?");
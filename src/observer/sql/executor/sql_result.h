@@ -20,6 +20,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/physical_operator.h"
 
 class Session;
+class CachedPlan;
+class CachedResult;
 
 /**
  * @brief SQL执行结果
@@ -32,7 +34,7 @@ class SqlResult
 {
 public:
   SqlResult(Session *session);
-  ~SqlResult() {}
+  ~SqlResult();
 
   void set_tuple_schema(const TupleSchema &schema);
   void set_return_code(RC rc) { return_code_ = rc; }
@@ -40,7 +42,31 @@ public:
 
   void set_operator(unique_ptr<PhysicalOperator> oper);
 
+  /**
+   * @brief 设置执行计划对应的计划缓存项
+   * @details 执行成功之后，执行计划会放回计划缓存中
+   */
+  void set_cached_plan(unique_ptr<CachedPlan> cached_plan);
+
+  /**
+   * @brief 设置查询缓存中的结果
+   * @details 设置之后直接返回缓存的结果，不需要执行计划
+   */
+  void set_cached_result(shared_ptr<const CachedResult> cached_result);
+
+  /**
+   * @brief 设置需要放入查询缓存的结果
+   * @details 执行计划返回的每一行都会记录下来，全部返回并且执行成功之后放入查询缓存
+   */
+  void set_result_to_cache(unique_ptr<CachedResult> result_to_cache);
+
   bool               has_operator() const { return operator_ != nullptr; }
+  bool               has_cached_result() const { return cached_result_ != nullptr; }
+
+  /**
+   * @brief 是否有结果集要返回给客户端，结果可能来自执行计划或者查询缓存
+   */
+  bool               has_result_set() const { return has_operator() || has_cached_result(); }
   const TupleSchema &tuple_schema() const { return tuple_schema_; }
   RC                 return_code() const { return return_code_; }
   const string      &state_string() const { return state_string_; }
@@ -51,9 +77,18 @@ public:
   RC next_chunk(Chunk &chunk);
 
 private:
-  Session                     *session_ = nullptr;  ///< 当前所属会话
-  unique_ptr<PhysicalOperator> operator_;           ///< 执行计划
-  TupleSchema                  tuple_schema_;       ///< 返回的表头信息。可能有也可能没有
-  RC                           return_code_ = RC::SUCCESS;
-  string                       state_string_;
+  RC next_cached_tuple(Tuple *&tuple);
+
+private:
+  Session                       *session_ = nullptr;   ///< 当前所属会话
+  unique_ptr<PhysicalOperator>   operator_;             ///< 执行计划
+  unique_ptr<CachedPlan>         cached_plan_;          ///< 执行计划来自或者将要放入计划缓存
+  unique_ptr<CachedResult>       result_to_cache_;      ///< 正在收集的结果，执行完成后放入查询缓存
+  bool                           result_eof_ = false;   ///< 执行计划是否已经返回了所有结果
+  shared_ptr<const CachedResult> cached_result_;        ///< 来自查询缓存的结果
+  size_t                         cached_row_index_ = 0; ///< 下一个要返回的缓存结果中的行
+  ValueListTuple                 cached_tuple_;         ///< 返回缓存结果时使用的元组
+  TupleSchema                    tuple_schema_;         ///< 返回的表头信息。可能有也可能没有
+  RC                             return_code_ = RC::SUCCESS;
+  string                         state_string_;
 };
@@ -10,12 +10,153 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/expr/aggregate_hash_table.h"
 
+namespace {
+
+/**
+ * @brief chunk 中的行数，常量列只有一个值，不计入行数
+ */
+int chunk_rows(Chunk &chunk)
+{
+  int rows = 0;
+  for (int i = 0; i < chunk.column_num(); i++) {
+    Column &column = chunk.column(i);
+    if (column.column_type() != Column::Type::CONSTANT_COLUMN) {
+      rows = max(rows, column.count());
+    } else {
+      rows = max(rows, 1);
+    }
+  }
+  return rows;
+}
+
+RC append_value(Column &column, const Value &value)
+{
+  if (value.is_null()) {
+    return column.append_null();
+  }
+  switch (column.attr_type()) {
+    case AttrType::INTS: {
+      int int_value = value.get_int();
+      return column.append_one((char *)&int_value);
+    }
+    case AttrType::FLOATS: {
+      float float_value = value.get_float();
+      return column.append_one((char *)&float_value);
+    }
+    case AttrType::CHARS: {
+      // 字符串的长度可能比列的长度短，剩余部分补0
+      vector<char> buffer(column.attr_len(), 0);
+      memcpy(buffer.data(), value.data(), min(value.length(), column.attr_len()));
+      return column.append_one(buffer.data());
+    }
+    default: {
+      return column.append_one((char *)value.data());
+    }
+  }
+}
+
+}  // namespace
+
 // ----------------------------------StandardAggregateHashTable------------------
 
 RC StandardAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
 {
-  // your code here
-  exit(-1);
+  if (aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("aggregate column number mismatch. expect=%d, actual=%d", aggr_types_.size(), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC            rc   = RC::SUCCESS;
+  const int     rows = max(chunk_rows(groups_chunk), chunk_rows(aggrs_chunk));
+  vector<Value> group_by_values(groups_chunk.column_num());
+  for (int row = 0; row < rows; row++) {
+    for (int i = 0; i < groups_chunk.column_num(); i++) {
+      group_by_values[i] = groups_chunk.column(i).get_value(row);
+    }
+
+    auto iter = aggr_values_.find(group_by_values);
+    if (iter == aggr_values_.end()) {
+      vector<Value> aggr_states(aggr_types_.size() + avg_num_);
+      for (size_t i = 0; i < aggr_types_.size(); i++) {
+        if (aggr_types_[i] == AggregateExpr::Type::COUNT) {
+          aggr_states[i] = Value(0);
+        } else if (aggr_types_[i] == AggregateExpr::Type::AVG) {
+          aggr_states[count_pos_[i]] = Value(0);
+        }
+      }
+      iter = aggr_values_.emplace(group_by_values, std::move(aggr_states)).first;
+    }
+
+    vector<Value> &aggr_states = iter->second;
+    for (size_t i = 0; i < aggr_types_.size(); i++) {
+      if (OB_FAIL(rc = update(aggr_states, i, aggrs_chunk.column(i).get_value(row)))) {
+        LOG_WARN("failed to update aggregate state. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return rc;
+}
+
+RC StandardAggregateHashTable::update(vector<Value> &aggr_states, size_t aggr_idx, const Value &value)
+{
+  if (value.is_null()) {
+    return RC::SUCCESS;
+  }
+
+  RC     rc    = RC::SUCCESS;
+  Value &state = aggr_states[aggr_idx];
+  switch (aggr_types_[aggr_idx]) {
+    case AggregateExpr::Type::COUNT: {
+      state.set_int(state.get_int() + 1);
+    } break;
+    case AggregateExpr::Type::AVG: {
+      Value &count = aggr_states[count_pos_[aggr_idx]];
+      count.set_int(count.get_int() + 1);
+      if (state.attr_type() == AttrType::UNDEFINED) {
+        state = value;
+      } else {
+        rc = Value::add(state, value, state);
+      }
+    } break;
+    case AggregateExpr::Type::SUM: {
+      if (state.attr_type() == AttrType::UNDEFINED) {
+        state = value;
+      } else {
+        rc = Value::add(state, value, state);
+      }
+    } break;
+    case AggregateExpr::Type::MAX: {
+      if (state.attr_type() == AttrType::UNDEFINED || state.compare(value) < 0) {
+        state = value;
+      }
+    } break;
+    case AggregateExpr::Type::MIN: {
+      if (state.attr_type() == AttrType::UNDEFINED || state.compare(value) > 0) {
+        state = value;
+      }
+    } break;
+    default: {
+      LOG_WARN("unsupported aggregate type: %d", static_cast<int>(aggr_types_[aggr_idx]));
+      rc = RC::UNIMPLEMENTED;
+    } break;
+  }
+  return rc;
+}
+
+void StandardAggregateHashTable::evaluate(const vector<Value> &aggr_states, size_t aggr_idx, Value &result) const
+{
+  const Value &state = aggr_states[aggr_idx];
+  if (state.attr_type() == AttrType::UNDEFINED) {
+    // 这个分组中全部是 NULL
+    result = Value();
+    result.set_null(true);
+  } else if (aggr_types_[aggr_idx] == AggregateExpr::Type::AVG) {
+    const int count = aggr_states[count_pos_[aggr_idx]].get_int();
+    result.set_float(count == 0 ? 0 : state.get_float() / count);
+  } else {
+    result = state;
+  }
 }
 
 void StandardAggregateHashTable::Scanner::open_scan()
@@ -29,31 +170,41 @@ RC StandardAggregateHashTable::Scanner::next(Chunk &output_chunk)
   if (it_ == end_) {
     return RC::RECORD_EOF;
   }
-  while (it_ != end_ && output_chunk.rows() <= output_chunk.capacity()) {
+  auto *hash_table = static_cast<StandardAggregateHashTable *>(hash_table_);
+  RC    rc         = RC::SUCCESS;
+  Value aggr_value;
+  while (it_ != end_ && output_chunk.rows() < output_chunk.capacity()) {
     auto &group_by_values = it_->first;
     auto &aggrs           = it_->second;
     for (int i = 0; i < output_chunk.column_num(); i++) {
       auto col_idx = output_chunk.column_ids(i);
       if (col_idx >= static_cast<int>(group_by_values.size())) {
-        output_chunk.column(i).append_one((char *)aggrs[col_idx - group_by_values.size()].data());
+        hash_table->evaluate(aggrs, col_idx - group_by_values.size(), aggr_value);
+        rc = append_value(output_chunk.column(i), aggr_value);
       } else {
-        output_chunk.column(i).append_one((char *)group_by_values[col_idx].data());
+        rc = append_value(output_chunk.column(i), group_by_values[col_idx]);
+      }
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append value to output chunk. rc=%s", strrc(rc));
+        return rc;
       }
     }
     it_++;
   }
-  if (it_ == end_) {
-    return RC::SUCCESS;
-  }
 
-  return RC::SUCCESS;
+  return rc;
 }
 
 size_t StandardAggregateHashTable::VectorHash::operator()(const vector<Value> &vec) const
 {
   size_t hash_val = 0;
   for (const auto &elem : vec) {
-    hash_val ^= hash<string>()(elem.to_string());
+    size_t elem_hash = 0;
+    if (OB_FAIL(Value::hash(elem, elem_hash))) {
+      elem_hash = hash<string>()(elem.to_string());
+    }
+    // 不能直接异或，否则 (1, 2) 和 (2, 1) 的哈希值相同
+    hash_val ^= elem_hash + 0x9e3779b97f4a7c15 + (hash_val << 6) + (hash_val >> 2);
   }
   return hash_val;
 }
@@ -104,7 +255,7 @@ RC LinearProbingAggregateHashTable<V>::Scanner::next(Chunk &output_chunk)
     return RC::RECORD_EOF;
   }
   auto linear_probing_hash_table = static_cast<LinearProbingAggregateHashTable *>(hash_table_);
-  while (scan_pos_ < capacity_ && scan_count_ < size_ && output_chunk.rows() <= output_chunk.capacity()) {
+  while (scan_pos_ < capacity_ && scan_count_ < size_ && output_chunk.rows() < output_chunk.capacity()) {
     int key;
     V   value;
     RC  rc = linear_probing_hash_table->iter_get(scan_pos_, key, value);
@@ -171,6 +322,10 @@ void LinearProbingAggregateHashTable<V>::aggregate(V *value, V value_to_aggregat
 {
   if (aggregate_type_ == AggregateExpr::Type::SUM) {
     *value += value_to_aggregate;
+  } else if (aggregate_type_ == AggregateExpr::Type::MAX) {
+    *value = max(*value, value_to_aggregate);
+  } else if (aggregate_type_ == AggregateExpr::Type::MIN) {
+    *value = min(*value, value_to_aggregate);
   } else {
     ASSERT(false, "unsupported aggregate type");
   }
@@ -180,7 +335,7 @@ template <typename V>
 void LinearProbingAggregateHashTable<V>::resize()
 {
   capacity_ *= 2;
-  vector<int> new_keys(capacity_);
+  vector<int> new_keys(capacity_, EMPTY_KEY);
   vector<V>   new_values(capacity_);
 
   for (size_t i = 0; i < keys_.size(); i++) {
@@ -209,31 +364,107 @@ void LinearProbingAggregateHashTable<V>::resize_if_need()
 }
 
 template <typename V>
-void LinearProbingAggregateHashTable<V>::add_batch(int *input_keys, V *input_values, int len)
+void LinearProbingAggregateHashTable<V>::add_one(int key, V value)
 {
-  // your code here
-  exit(-1);
+  resize_if_need();
+
+  int index = (key % capacity_ + capacity_) % capacity_;
+  while (keys_[index] != EMPTY_KEY && keys_[index] != key) {
+    index = (index + 1) % capacity_;
+  }
+  if (keys_[index] == EMPTY_KEY) {
+    keys_[index]   = key;
+    values_[index] = value;
+    size_++;
+  } else {
+    aggregate(&values_[index], value);
+  }
+}
 
+template <typename V>
+void LinearProbingAggregateHashTable<V>::add_batch(int *input_keys, V *input_values, int len)
+{
   // inv (invalid) 表示是否有效，inv[i] = -1 表示有效，inv[i] = 0 表示无效。
   // key[SIMD_WIDTH],value[SIMD_WIDTH] 表示当前循环中处理的键值对。
   // off (offset) 表示线性探测冲突时的偏移量，key[i] 每次遇到冲突键，则off[i]++，如果key[i] 已经完成聚合，则off[i] = 0，
   // i = 0 表示selective load 的起始位置。
-  // inv 全部初始化为 -1
-  // off 全部初始化为 0
-
-  // for (; i + SIMD_WIDTH <= len;) {
-    // 1: 根据 `inv` 变量的值，从 `input_keys` 中 `selective load` `SIMD_WIDTH` 个不同的输入键值对。
-    // 2. 计算 i += |inv|, `|inv|` 表示 `inv` 中有效的个数 
-    // 3. 计算 hash 值，
-    // 4. 根据聚合类型（目前只支持 sum），在哈希表中更新聚合结果。如果本次循环，没有找到key[i] 在哈希表中的位置，则不更新聚合结果。
-    // 5. gather 操作，根据 hash 值将 keys_ 的 gather 结果写入 table_key 中。
-    // 6. 更新 inv 和 off。如果本次循环key[i] 聚合完成，则inv[i]=-1，表示该位置在下次循环中读取新的键值对。
-    // 如果本次循环 key[i] 未在哈希表中聚合完成（table_key[i] != key[i]），则inv[i] = 0，表示该位置在下次循环中不需要读取新的键值对。
-    // 如果本次循环中，key[i]聚合完成，则off[i] 更新为 0，表示线性探测偏移量为 0，key[i] 未完成聚合，则off[i]++,表示线性探测偏移量加 1。
-  // }
-  //7. 通过标量线性探测，处理剩余键值对
-
-  // resize_if_need();
+  __m256i inv = _mm256_set1_epi32(-1);
+  __m256i off = _mm256_setzero_si256();
+  int     key[SIMD_WIDTH];
+  V       value[SIMD_WIDTH];
+  int     i = 0;
+
+  const __m256i empty_key_vec = _mm256_set1_epi32(EMPTY_KEY);
+  for (; i + SIMD_WIDTH <= len;) {
+    // 每一轮最多插入 SIMD_WIDTH 个新的键。扩容会改变键的位置，需要先把正在探测的键用标量方式处理完
+    if (size_ + SIMD_WIDTH >= capacity_ / 2) {
+      int *inv_ptr = reinterpret_cast<int *>(&inv);
+      for (int j = 0; j < SIMD_WIDTH; j++) {
+        if (inv_ptr[j] == 0) {
+          add_one(key[j], value[j]);
+        }
+      }
+      resize();
+      inv = _mm256_set1_epi32(-1);
+      off = _mm256_setzero_si256();
+    }
+    const __m256i capacity_vec = _mm256_set1_epi32(capacity_);
+
+    // 1. 根据 inv 从输入中 selective load 新的键值对，2. i += |inv|
+    selective_load(input_keys, i, key, inv);
+    selective_load(input_values, i, value, inv);
+    i += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(inv)));
+
+    // 3. 计算 hash 值。AVX2 没有整数取模指令，取模用标量完成，加上偏移量之后超出容量的部分再减掉
+    __m256i key_vec = _mm256_loadu_si256(reinterpret_cast<__m256i *>(key));
+    int     hash_val[SIMD_WIDTH];
+    for (int j = 0; j < SIMD_WIDTH; j++) {
+      hash_val[j] = (key[j] % capacity_ + capacity_) % capacity_;
+    }
+    __m256i hash_vec = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i *>(hash_val)), off);
+    __m256i overflow = _mm256_cmpgt_epi32(hash_vec, _mm256_sub_epi32(capacity_vec, _mm256_set1_epi32(1)));
+    hash_vec         = _mm256_sub_epi32(hash_vec, _mm256_and_si256(overflow, capacity_vec));
+
+    // 5. gather 出哈希表中对应槽位的键
+    __m256i table_key = _mm256_i32gather_epi32(keys_.data(), hash_vec, sizeof(int));
+    __m256i matched   = _mm256_or_si256(_mm256_cmpeq_epi32(table_key, key_vec), _mm256_cmpeq_epi32(table_key, empty_key_vec));
+
+    // 4. 在哈希表中更新聚合结果。同一批中的多个键可能落在同一个空槽位上，所以写入时需要再检查一次槽位
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(hash_val), hash_vec);
+    int matched_mask = _mm256_movemask_ps(_mm256_castsi256_ps(matched));
+    int done[SIMD_WIDTH];
+    for (int j = 0; j < SIMD_WIDTH; j++) {
+      done[j] = 0;
+      if ((matched_mask & (1 << j)) == 0) {
+        continue;
+      }
+      int &slot_key = keys_[hash_val[j]];
+      if (slot_key == EMPTY_KEY) {
+        slot_key             = key[j];
+        values_[hash_val[j]] = value[j];
+        size_++;
+        done[j] = -1;
+      } else if (slot_key == key[j]) {
+        aggregate(&values_[hash_val[j]], value[j]);
+        done[j] = -1;
+      }
+    }
+
+    // 6. 更新 inv 和 off。完成聚合的位置下次读取新的键值对，偏移量清零；否则继续探测下一个槽位
+    inv = _mm256_loadu_si256(reinterpret_cast<__m256i *>(done));
+    off = _mm256_andnot_si256(inv, _mm256_add_epi32(off, _mm256_set1_epi32(1)));
+  }
+
+  // 7. 通过标量线性探测，处理剩余键值对
+  int *inv_ptr = reinterpret_cast<int *>(&inv);
+  for (int j = 0; j < SIMD_WIDTH; j++) {
+    if (inv_ptr[j] == 0) {
+      add_one(key[j], value[j]);
+    }
+  }
+  for (; i < len; i++) {
+    add_one(input_keys[i], input_values[i]);
+  }
 }
 
 template <typename V>
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/algorithm.h"
 #include "common/lang/vector.h"
 #include "common/lang/unordered_map.h"
 #include "common/math/simd_util.h"
@@ -84,6 +85,13 @@ public:
       ASSERT(expr->type() == ExprType::AGGREGATION, "expect aggregate expression");
       auto *aggregation_expr = static_cast<AggregateExpr *>(expr);
       aggr_types_.push_back(aggregation_expr->aggregate_type());
+      // AVG 需要额外记录参与计算的行数，放在所有聚合值的后面
+      if (aggregation_expr->aggregate_type() == AggregateExpr::Type::AVG) {
+        count_pos_.push_back(aggregations.size() + avg_num_);
+        avg_num_++;
+      } else {
+        count_pos_.push_back(-1);
+      }
     }
   }
 
@@ -91,18 +99,29 @@ public:
 
   RC add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk) override;
 
+  /**
+   * @brief 根据哈希表中记录的中间状态计算第 aggr_idx 个聚合的最终结果
+   */
+  void evaluate(const vector<Value> &aggr_states, size_t aggr_idx, Value &result) const;
+
   StandardHashTable::iterator begin() { return aggr_values_.begin(); }
   StandardHashTable::iterator end() { return aggr_values_.end(); }
 
+private:
+  RC update(vector<Value> &aggr_states, size_t aggr_idx, const Value &value);
+
 private:
   /// group by values -> aggregate values
   StandardHashTable           aggr_values_;
   vector<AggregateExpr::Type> aggr_types_;
+  vector<int>                 count_pos_;  ///< AVG 的行数在中间状态中的下标，其它聚合为-1
+  int                         avg_num_ = 0;
 };
 
 /**
  * @brief 线性探测哈希表实现
- * @note 当前只支持group by 列为 char/char(4) 类型，且聚合列为单列。
+ * @note 当前只支持group by 列为 int 类型，且聚合列为单列，聚合函数为 SUM/MAX/MIN。
+ * 键值 EMPTY_KEY(-1) 用来标记空槽位，不能作为 group by 的值。
  */
 #ifdef USE_SIMD
 template <typename V>
@@ -154,6 +173,11 @@ private:
 
   void aggregate(V *value, V value_to_aggregate);
 
+  /**
+   * @brief 标量的线性探测，找到 key 所在(或应该插入)的槽位后聚合
+   */
+  void add_one(int key, V value);
+
   void resize();
 
   void resize_if_need();
@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 template <typename T>
 void SumState<T>::update(const T *values, int size)
 {
+  has_value = has_value || size > 0;
 #ifdef USE_SIMD
   if constexpr (std::is_same<T, float>::value) {
     value += mm256_sum_ps(values, size);
@@ -25,10 +26,47 @@ void SumState<T>::update(const T *values, int size)
   }
 #else
   for (int i = 0; i < size; ++i) {
- 	  value += values[i];
+    value += values[i];
   }
 #endif
 }
 
+template <typename T>
+void AvgState<T>::update(const T *values, int size)
+{
+  SumState<T> sum;
+  sum.update(values, size);
+  value += sum.value;
+  count += size;
+}
+
+template <typename T>
+void MaxState<T>::update(const T *values, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    if (!has_value || values[i] > value) {
+      value     = values[i];
+      has_value = true;
+    }
+  }
+}
+
+template <typename T>
+void MinState<T>::update(const T *values, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    if (!has_value || values[i] < value) {
+      value     = values[i];
+      has_value = true;
+    }
+  }
+}
+
 template class SumState<int>;
 template class SumState<float>;
+template class AvgState<int>;
+template class AvgState<float>;
+template class MaxState<int>;
+template class MaxState<float>;
+template class MinState<int>;
+template class MinState<float>;
@@ -8,11 +8,68 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#pragma once
+
+/**
+ * @brief 向量化聚合的中间状态
+ * @details 每个状态都提供 update 按批次累加一列数据，以及 result 返回最终的聚合结果。
+ * 没有累加过任何值时 is_null 返回 true，这时聚合结果是 NULL（COUNT 除外）。
+ */
 template <class T>
 class SumState
 {
 public:
-  SumState() : value(0) {}
+  SumState() : value(0), has_value(false) {}
+  T    value;
+  bool has_value;
+  void update(const T *values, int size);
+  T    result() const { return value; }
+  bool is_null() const { return !has_value; }
+};
+
+template <class T>
+class CountState
+{
+public:
+  CountState() : value(0) {}
+  int  value;
+  void update(const T *values, int size) { value += size; }
+  int  result() const { return value; }
+  bool is_null() const { return false; }
+};
+
+template <class T>
+class AvgState
+{
+public:
+  AvgState() : value(0), count(0) {}
+  T     value;
+  int   count;
+  void  update(const T *values, int size);
+  float result() const { return count == 0 ? 0 : static_cast<float>(value) / count; }
+  bool  is_null() const { return count == 0; }
+};
+
+template <class T>
+class MaxState
+{
+public:
+  MaxState() : value(0), has_value(false) {}
+  T    value;
+  bool has_value;
+  void update(const T *values, int size);
+  T    result() const { return value; }
+  bool is_null() const { return !has_value; }
+};
+
+template <class T>
+class MinState
+{
+public:
+  MinState() : value(0), has_value(false) {}
   T    value;
+  bool has_value;
   void update(const T *values, int size);
-};
\ No newline at end of file
+  T    result() const { return value; }
+  bool is_null() const { return !has_value; }
+};
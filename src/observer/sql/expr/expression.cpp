@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/expr/expression.h"
+#include "common/lang/comparator.h"
 #include "common/type/vector_type.h"
 #include "sql/expr/subquery_expression.h"
 #include "sql/expr/tuple.h"
@@ -74,11 +75,16 @@ bool TableFieldExpr::equal(const Expression &other) const
 RC TableFieldExpr::get_column(Chunk &chunk, Column &column)
 {
   if (pos_ != -1) {
-    column.reference(chunk.column(pos_));
-  } else {
-    column.reference(chunk.column(field().meta()->field_id()));
+    return chunk.get_column(pos_, column);
   }
-  return RC::SUCCESS;
+
+  // 表扫描只输出用到的列，列号是字段在页面中的列号，不可见的字段排在用户字段的前面
+  const int col_id = field().table()->table_meta().unvisible_field_num() + field().meta()->field_id();
+  int       idx    = chunk.column_index(col_id);
+  if (idx < 0) {
+    idx = field().meta()->field_id();
+  }
+  return chunk.get_column(idx, column);
 }
 
 bool ValueExpr::equal(const Expression &other) const
@@ -285,18 +291,97 @@ RC ComparisonExpr::eval(Chunk &chunk, vector<uint8_t> &select)
     LOG_WARN("failed to get value of right expression. rc=%s", strrc(rc));
     return rc;
   }
-  if (left_column.attr_type() != right_column.attr_type()) {
-    LOG_WARN("cannot compare columns with different types");
-    return RC::INTERNAL;
+
+  const bool left_const  = left_column.column_type() == Column::Type::CONSTANT_COLUMN;
+  const bool right_const = right_column.column_type() == Column::Type::CONSTANT_COLUMN;
+  int        rows        = static_cast<int>(select.size());
+  if (!left_const) {
+    rows = left_column.count();
+  } else if (!right_const) {
+    rows = right_column.count();
   }
-  if (left_column.attr_type() == AttrType::INTS) {
+
+  // 类型相同的普通比较使用按列比较的实现，其它的情况逐行比较
+  const bool same_type  = left_column.attr_type() == right_column.attr_type();
+  const bool simple_cmp = comp_ >= CompOp::EQUAL_TO && comp_ <= CompOp::GREAT_THAN;
+  const bool fixed_len  = (left_const || left_column.column_type() == Column::Type::NORMAL_COLUMN) &&
+                         (right_const || right_column.column_type() == Column::Type::NORMAL_COLUMN);
+  if (same_type && simple_cmp && fixed_len && left_column.attr_type() == AttrType::INTS) {
     rc = compare_column<int>(left_column, right_column, select);
-  } else if (left_column.attr_type() == AttrType::FLOATS) {
+  } else if (same_type && simple_cmp && fixed_len && left_column.attr_type() == AttrType::FLOATS) {
     rc = compare_column<float>(left_column, right_column, select);
+  } else if (same_type && simple_cmp && left_column.attr_type() == AttrType::CHARS) {
+    return compare_string_column(left_column, right_column, rows, select);
   } else {
-    // TODO: support string compare
-    LOG_WARN("unsupported data type %d", left_column.attr_type());
-    return RC::INTERNAL;
+    return compare_column_by_value(left_column, right_column, rows, select);
+  }
+
+  // NULL 和任何值比较的结果都不是 true
+  if (OB_SUCC(rc) && (left_column.has_null() || right_column.has_null())) {
+    for (int i = 0; i < rows; i++) {
+      if (left_column.is_null(i) || right_column.is_null(i)) {
+        select[i] = 0;
+      }
+    }
+  }
+  return rc;
+}
+
+RC ComparisonExpr::compare_string_column(const Column &left, const Column &right, int rows, vector<uint8_t> &result) const
+{
+  const bool has_null = left.has_null() || right.has_null();
+  for (int i = 0; i < rows; i++) {
+    if (result[i] == 0) {
+      continue;
+    }
+    if (has_null && (left.is_null(i) || right.is_null(i))) {
+      result[i] = 0;
+      continue;
+    }
+
+    string_view left_str  = left.get_string(i);
+    string_view right_str = right.get_string(i);
+    const int   cmp_result = common::compare_string(
+        (void *)left_str.data(), left_str.size(), (void *)right_str.data(), right_str.size());
+
+    bool match = false;
+    switch (comp_) {
+      case EQUAL_TO: match = (cmp_result == 0); break;
+      case LESS_EQUAL: match = (cmp_result <= 0); break;
+      case NOT_EQUAL: match = (cmp_result != 0); break;
+      case LESS_THAN: match = (cmp_result < 0); break;
+      case GREAT_EQUAL: match = (cmp_result >= 0); break;
+      case GREAT_THAN: match = (cmp_result > 0); break;
+      default: {
+        LOG_WARN("unsupported comparison. %d", comp_);
+        return RC::INTERNAL;
+      }
+    }
+    if (!match) {
+      result[i] = 0;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC ComparisonExpr::compare_column_by_value(
+    const Column &left, const Column &right, int rows, vector<uint8_t> &result) const
+{
+  RC rc = RC::SUCCESS;
+  for (int i = 0; i < rows; i++) {
+    if (result[i] == 0) {
+      continue;
+    }
+
+    bool match = false;
+    rc         = compare_value(left.get_value(i), right.get_value(i), match);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to compare values. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (!match) {
+      result[i] = 0;
+    }
   }
   return rc;
 }
@@ -482,7 +567,9 @@ RC ComparisonExpr::to_compareable()
         LOG_WARN("failed to get value from child", strrc(rc));
         return rc;
       }
-      expr = make_unique<ValueExpr>(val);
+      auto value_expr = make_unique<ValueExpr>(val);
+      value_expr->set_param_index(static_cast<ValueExpr *>(cast_expr->child().get())->param_index());
+      expr = std::move(value_expr);
     } else {
       expr = std::move(cast_expr);
     }
@@ -543,6 +630,30 @@ RC ConjunctionExpr::get_value(const Tuple &tuple, Value &value) const
   return RC::SUCCESS;
 }
 
+RC ConjunctionExpr::eval(Chunk &chunk, vector<uint8_t> &select)
+{
+  RC rc = RC::SUCCESS;
+  // 比较表达式的结果会和 select 中原有的值做与运算
+  if (conjunction_type_ == Type::AND) {
+    if (OB_FAIL(rc = left_->eval(chunk, select))) {
+      return rc;
+    }
+    return right_->eval(chunk, select);
+  }
+
+  vector<uint8_t> right_select = select;
+  if (OB_FAIL(rc = left_->eval(chunk, select))) {
+    return rc;
+  }
+  if (OB_FAIL(rc = right_->eval(chunk, right_select))) {
+    return rc;
+  }
+  for (size_t i = 0; i < select.size(); i++) {
+    select[i] |= right_select[i];
+  }
+  return rc;
+}
+
 RC ConjunctionExpr::try_get_value(Value &value) const
 {
   RC    rc = RC::SUCCESS;
@@ -921,8 +1032,7 @@ RC ArithmeticExpr::get_column(Chunk &chunk, Column &column)
 {
   RC rc = RC::SUCCESS;
   if (pos_ != -1) {
-    column.reference(chunk.column(pos_));
-    return rc;
+    return chunk.get_column(pos_, column);
   }
   Column left_column;
   Column right_column;
@@ -940,11 +1050,54 @@ RC ArithmeticExpr::get_column(Chunk &chunk, Column &column)
   return calc_column(left_column, right_column, column);
 }
 
-RC ArithmeticExpr::calc_column(const Column &left_column, const Column &right_column, Column &column) const
+namespace {
+/**
+ * @brief 把整数列转换成浮点数列，用于整数和浮点数的混合运算以及整数除法
+ */
+void cast_int_to_float(const Column &source, Column &target)
+{
+  const int count = source.count();
+  target.init(AttrType::FLOATS, sizeof(float), max(count, 1));
+  target.set_column_type(source.column_type());
+
+  const int *src  = reinterpret_cast<const int *>(source.data());
+  float     *dest = reinterpret_cast<float *>(target.data());
+  for (int i = 0; i < count; i++) {
+    dest[i] = static_cast<float>(src[i]);
+  }
+  target.set_count(count);
+  if (source.has_null()) {
+    for (int i = 0; i < count; i++) {
+      if (source.is_null(i)) {
+        target.set_null(i);
+      }
+    }
+  }
+}
+}  // namespace
+
+RC ArithmeticExpr::calc_column(const Column &input_left, const Column &input_right, Column &column) const
 {
   RC rc = RC::SUCCESS;
 
   const AttrType target_type = value_type();
+
+  // 两边的类型和结果不同时，先把整数转换成浮点数
+  Column        left_cast;
+  Column        right_cast;
+  const Column *left  = &input_left;
+  const Column *right = &input_right;
+  if (target_type == AttrType::FLOATS && input_left.attr_type() == AttrType::INTS) {
+    cast_int_to_float(input_left, left_cast);
+    left = &left_cast;
+  }
+  if (target_type == AttrType::FLOATS && input_right.attr_type() == AttrType::INTS) {
+    cast_int_to_float(input_right, right_cast);
+    right = &right_cast;
+  }
+  const Column &left_column  = *left;
+  const Column &right_column = *right;
+
   column.init(target_type, left_column.attr_len(), max(left_column.count(), right_column.count()));
   bool left_const  = left_column.column_type() == Column::Type::CONSTANT_COLUMN;
   bool right_const = right_column.column_type() == Column::Type::CONSTANT_COLUMN;
@@ -961,6 +1114,15 @@ RC ArithmeticExpr::calc_column(const Column &left_column, const Column &right_co
     column.set_column_type(Column::Type::NORMAL_COLUMN);
     rc = execute_calc<false, false>(left_column, right_column, column, arithmetic_type_, target_type);
   }
+
+  // 任何一边是 NULL 时结果也是 NULL
+  if (OB_SUCC(rc) && (left_column.has_null() || right_column.has_null())) {
+    for (int i = 0; i < column.count(); i++) {
+      if (left_column.is_null(i) || right_column.is_null(i)) {
+        column.set_null(i);
+      }
+    }
+  }
   return rc;
 }
 
@@ -1016,7 +1178,7 @@ RC AggregateExpr::get_column(Chunk &chunk, Column &column)
 {
   RC rc = RC::SUCCESS;
   if (pos_ != -1) {
-    column.reference(chunk.column(pos_));
+    rc = chunk.get_column(pos_, column);
   } else {
     rc = RC::INTERNAL;
   }
@@ -271,7 +271,13 @@ public:
 
   bool equal(const Expression &other) const override;
 
-  unique_ptr<Expression> copy() const override { return make_unique<ValueExpr>(value_); }
+  unique_ptr<Expression> copy() const override
+  {
+    auto expr = make_unique<ValueExpr>(value_);
+    expr->set_param_index(param_index_);
+    expr->set_placeholder_index(placeholder_index_);
+    return expr;
+  }
 
   RC get_value(const Tuple &tuple, Value &value) const override;
   RC get_column(Chunk &chunk, Column &column) override;
@@ -287,6 +293,21 @@ public:
 
   void         get_value(Value &value) const { value = value_; }
   const Value &get_value() const { return value_; }
+  void         set_value(const Value &value) { value_ = value; }
+
+  /**
+   * @brief 该常量对应SQL文本中第几个字面量
+   * @details 由语法分析器在生成常量表达式时设置，-1表示不是SQL中直接出现的字面量。
+   * 计划缓存通过它把新的SQL中的字面量重新绑定到缓存的执行计划中。
+   */
+  int  param_index() const { return param_index_; }
+  void set_param_index(int index) { param_index_ = index; }
+
+  /**
+   * @brief 该常量是预处理语句中的第几个占位符'?'，-1表示不是占位符
+   */
+  int  placeholder_index() const { return placeholder_index_; }
+  void set_placeholder_index(int index) { placeholder_index_ = index; }
 
   RC related_tables(vector<const Table *> &tables) const override { return RC::SUCCESS; }
 
@@ -294,6 +315,8 @@ public:
 
 private:
   Value value_;
+  int   param_index_       = -1;  ///< 字面量在SQL中的序号
+  int   placeholder_index_ = -1;  ///< 占位符在预处理语句中的序号
 };
 
 /**
@@ -383,6 +406,16 @@ public:
   template <typename T>
   RC compare_column(const Column &left, const Column &right, vector<uint8_t> &result) const;
 
+  /**
+   * @brief 逐行比较两个字符串列，不需要为每一行构造 Value
+   */
+  RC compare_string_column(const Column &left, const Column &right, int rows, vector<uint8_t> &result) const;
+
+  /**
+   * @brief 逐行取出 Value 再比较，用于没有专门实现的类型和比较运算符，比如 IS NULL 和 LIKE
+   */
+  RC compare_column_by_value(const Column &left, const Column &right, int rows, vector<uint8_t> &result) const;
+
   RC related_tables(vector<const Table *> &tables) const override;
 
   string to_string() const override
@@ -438,6 +471,8 @@ public:
   RC       get_value(const Tuple &tuple, Value &value) const override;
   RC       try_get_value(Value &value) const override;
 
+  RC eval(Chunk &chunk, vector<uint8_t> &select) override;
+
   RC related_tables(vector<const Table *> &tables) const override;
 
   Type conjunction_type() const { return conjunction_type_; }
@@ -614,10 +649,18 @@ public:
 
   ExprType type() const override { return ExprType::AGGREGATION; }
 
-  AttrType value_type() const override { return child_->value_type(); }
-  int      value_length() const override
+  AttrType value_type() const override
   {
     if (aggregate_type_ == AggregateExpr::Type::COUNT) {
+      return AttrType::INTS;
+    } else if (aggregate_type_ == AggregateExpr::Type::AVG) {
+      return AttrType::FLOATS;
+    }
+    return child_->value_type();
+  }
+  int value_length() const override
+  {
+    if (aggregate_type_ == AggregateExpr::Type::COUNT || aggregate_type_ == AggregateExpr::Type::AVG) {
       return 4;
     }
     return child_->value_length();
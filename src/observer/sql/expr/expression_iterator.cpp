@@ -88,3 +88,23 @@ RC ExpressionIterator::iterate_child_expr(Expression &expr, function<RC(unique_p
 
   return rc;
 }
+
+bool ExpressionIterator::has_param(Expression &expr)
+{
+  if (expr.type() == ExprType::SUBQUERY) {
+    return true;
+  }
+  if (expr.type() == ExprType::VALUE) {
+    return static_cast<ValueExpr &>(expr).param_index() >= 0;
+  }
+
+  bool found = false;
+  iterate_child_expr(expr, [&found](unique_ptr<Expression> &child) {
+    if (has_param(*child)) {
+      found = true;
+      return RC::INTERNAL;  // stop iterating
+    }
+    return RC::SUCCESS;
+  });
+  return found;
+}
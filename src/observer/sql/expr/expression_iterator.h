@@ -24,4 +24,10 @@ class ExpressionIterator
 {
 public:
   static RC iterate_child_expr(Expression &expr, function<RC(unique_ptr<Expression> &)> callback);
+
+  /**
+   * @brief 表达式中是否包含SQL中的字面量常量(参考 ValueExpr::param_index)
+   * @note 子查询无法遍历，保守地认为包含常量
+   */
+  static bool has_param(Expression &expr);
 };
@@ -465,6 +465,60 @@ private:
   vector<TupleCellSpec> specs_;
 };
 
+/**
+ * @brief 指向一组连续存放的Value的元组
+ * @ingroup Tuple
+ * @details 不复制数据，列描述和数据都由使用者管理，数据变化之前有效。
+ * 在需要把很多行缓存到内存中的算子中使用，比如 Hash Join 和 Nested Loop Join，这些行共用一份列描述。
+ */
+class ValueArrayTuple : public Tuple
+{
+public:
+  ValueArrayTuple()          = default;
+  virtual ~ValueArrayTuple() = default;
+
+  void set_specs(const vector<TupleCellSpec> *specs) { specs_ = specs; }
+  void set_cells(const Value *cells) { cells_ = cells; }
+
+  int cell_num() const override { return static_cast<int>(specs_->size()); }
+
+  RC cell_at(int index, Value &cell) const override
+  {
+    if (index < 0 || index >= cell_num()) {
+      return RC::NOTFOUND;
+    }
+
+    cell = cells_[index];
+    return RC::SUCCESS;
+  }
+
+  RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    if (index < 0 || index >= cell_num()) {
+      return RC::NOTFOUND;
+    }
+
+    spec = (*specs_)[index];
+    return RC::SUCCESS;
+  }
+
+  RC find_cell(const TupleCellSpec &spec, Value &cell) const override
+  {
+    const int size = cell_num();
+    for (int i = 0; i < size; i++) {
+      if ((*specs_)[i].equals(spec)) {
+        cell = cells_[i];
+        return RC::SUCCESS;
+      }
+    }
+    return RC::NOTFOUND;
+  }
+
+private:
+  const vector<TupleCellSpec> *specs_ = nullptr;
+  const Value                 *cells_ = nullptr;
+};
+
 /**
  * @brief 将两个tuple合并为一个tuple
  * @ingroup Tuple
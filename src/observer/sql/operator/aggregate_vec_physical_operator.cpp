@@ -32,23 +32,21 @@ AggregateVecPhysicalOperator::AggregateVecPhysicalOperator(vector<Expression *>
   for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
     auto &expr = aggregate_expressions_[i];
     ASSERT(expr->type() == ExprType::AGGREGATION, "expected an aggregation expression");
-    auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
-
-    if (aggregate_expr->aggregate_type() == AggregateExpr::Type::SUM) {
-      if (aggregate_expr->value_type() == AttrType::INTS) {
-        void *aggr_value                     = malloc(sizeof(SumState<int>));
-        ((SumState<int> *)aggr_value)->value = 0;
-        aggr_values_.insert(aggr_value);
-        output_chunk_.add_column(make_unique<Column>(AttrType::INTS, sizeof(int)), i);
-      } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
-        void *aggr_value                       = malloc(sizeof(SumState<float>));
-        ((SumState<float> *)aggr_value)->value = 0;
-        aggr_values_.insert(aggr_value);
-        output_chunk_.add_column(make_unique<Column>(AttrType::FLOATS, sizeof(float)), i);
-      }
-    } else {
-      ASSERT(false, "not supported aggregation type");
-    }
+    auto    *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    AttrType value_type     = value_expressions_[i]->value_type();
+    ASSERT(value_type == AttrType::INTS || value_type == AttrType::FLOATS, "not supported value type");
+
+    AttrType result_type = AggregateVecPhysicalOperator::result_type(aggregate_expr->aggregate_type(), value_type);
+    output_chunk_.add_column(make_unique<Column>(result_type, 4), i);
+  }
+}
+
+AttrType AggregateVecPhysicalOperator::result_type(AggregateExpr::Type aggregate_type, AttrType value_type)
+{
+  switch (aggregate_type) {
+    case AggregateExpr::Type::COUNT: return AttrType::INTS;
+    case AggregateExpr::Type::AVG: return AttrType::FLOATS;
+    default: return value_type;
   }
 }
 
@@ -63,22 +61,35 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
+  // 执行计划可能被复用，每次打开时都要重新初始化聚合状态
+  aggr_values_.clear();
+  emitted_ = false;
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    if (value_expressions_[aggr_idx]->value_type() == AttrType::INTS) {
+      aggr_values_.insert(create_state<int>(aggregate_expr->aggregate_type()));
+    } else {
+      aggr_values_.insert(create_state<float>(aggregate_expr->aggregate_type()));
+    }
+  }
+
   while (OB_SUCC(rc = child.next(chunk_))) {
+    const int rows = chunk_.rows();
     for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
       Column column;
-      value_expressions_[aggr_idx]->get_column(chunk_, column);
+      rc = value_expressions_[aggr_idx]->get_column(chunk_, column);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get column of aggregation. rc=%s", strrc(rc));
+        return rc;
+      }
       ASSERT(aggregate_expressions_[aggr_idx]->type() == ExprType::AGGREGATION, "expect aggregate expression");
-      auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
-      if (aggregate_expr->aggregate_type() == AggregateExpr::Type::SUM) {
-        if (aggregate_expr->value_type() == AttrType::INTS) {
-          update_aggregate_state<SumState<int>, int>(aggr_values_.at(aggr_idx), column);
-        } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
-          update_aggregate_state<SumState<float>, float>(aggr_values_.at(aggr_idx), column);
-        } else {
-          ASSERT(false, "not supported value type");
-        }
+      auto               *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+      AggregateExpr::Type aggregate_type = aggregate_expr->aggregate_type();
+      ASSERT(column.attr_type() == value_expressions_[aggr_idx]->value_type(), "column type mismatch");
+      if (column.attr_type() == AttrType::INTS) {
+        update_state<int>(aggregate_type, aggr_values_.at(aggr_idx), column, rows);
       } else {
-        ASSERT(false, "not supported aggregation type");
+        update_state<float>(aggregate_type, aggr_values_.at(aggr_idx), column, rows);
       }
     }
   }
@@ -89,18 +100,95 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
 
   return rc;
 }
+
+template <typename T>
+void *AggregateVecPhysicalOperator::create_state(AggregateExpr::Type aggregate_type)
+{
+  void *state = nullptr;
+  switch (aggregate_type) {
+    case AggregateExpr::Type::SUM: state = new (malloc(sizeof(SumState<T>))) SumState<T>(); break;
+    case AggregateExpr::Type::COUNT: state = new (malloc(sizeof(CountState<T>))) CountState<T>(); break;
+    case AggregateExpr::Type::AVG: state = new (malloc(sizeof(AvgState<T>))) AvgState<T>(); break;
+    case AggregateExpr::Type::MAX: state = new (malloc(sizeof(MaxState<T>))) MaxState<T>(); break;
+    case AggregateExpr::Type::MIN: state = new (malloc(sizeof(MinState<T>))) MinState<T>(); break;
+    default: ASSERT(false, "not supported aggregation type");
+  }
+  return state;
+}
+
+template <typename T>
+void AggregateVecPhysicalOperator::update_state(
+    AggregateExpr::Type aggregate_type, void *state, const Column &column, int rows)
+{
+  switch (aggregate_type) {
+    case AggregateExpr::Type::SUM: update_aggregate_state<SumState<T>, T>(state, column, rows); break;
+    case AggregateExpr::Type::COUNT: update_aggregate_state<CountState<T>, T>(state, column, rows); break;
+    case AggregateExpr::Type::AVG: update_aggregate_state<AvgState<T>, T>(state, column, rows); break;
+    case AggregateExpr::Type::MAX: update_aggregate_state<MaxState<T>, T>(state, column, rows); break;
+    case AggregateExpr::Type::MIN: update_aggregate_state<MinState<T>, T>(state, column, rows); break;
+    default: ASSERT(false, "not supported aggregation type");
+  }
+}
+
+template <typename T>
+void AggregateVecPhysicalOperator::append_state(AggregateExpr::Type aggregate_type, void *state, Column &column)
+{
+  switch (aggregate_type) {
+    case AggregateExpr::Type::SUM: append_to_column<SumState<T>, T>(state, column); break;
+    case AggregateExpr::Type::COUNT: append_to_column<CountState<T>, T>(state, column); break;
+    case AggregateExpr::Type::AVG: append_to_column<AvgState<T>, T>(state, column); break;
+    case AggregateExpr::Type::MAX: append_to_column<MaxState<T>, T>(state, column); break;
+    case AggregateExpr::Type::MIN: append_to_column<MinState<T>, T>(state, column); break;
+    default: ASSERT(false, "not supported aggregation type");
+  }
+}
+
 template <class STATE, typename T>
-void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Column &column)
+void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Column &column, int rows)
 {
   STATE *state_ptr = reinterpret_cast<STATE *>(state);
   T *    data      = (T *)column.data();
-  state_ptr->update(data, column.count());
+  if (column.column_type() == Column::Type::CONSTANT_COLUMN) {
+    // 常量列只有一个值，比如 count(*) 中的常量
+    if (column.has_null()) {
+      return;
+    }
+    for (int i = 0; i < rows; i++) {
+      state_ptr->update(data, 1);
+    }
+  } else if (column.has_null()) {
+    // NULL 不参与聚合，先把非 NULL 的值收集起来
+    vector<T> values;
+    values.reserve(column.count());
+    for (int i = 0; i < column.count(); i++) {
+      if (!column.is_null(i)) {
+        values.push_back(data[i]);
+      }
+    }
+    state_ptr->update(values.data(), static_cast<int>(values.size()));
+  } else {
+    state_ptr->update(data, column.count());
+  }
 }
 
 RC AggregateVecPhysicalOperator::next(Chunk &chunk)
 {
-  // your code here
-  exit(-1);
+  if (emitted_) {
+    return RC::RECORD_EOF;
+  }
+
+  output_chunk_.reset_data();
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    auto               *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    AggregateExpr::Type aggregate_type = aggregate_expr->aggregate_type();
+    if (value_expressions_[aggr_idx]->value_type() == AttrType::INTS) {
+      append_state<int>(aggregate_type, aggr_values_.at(aggr_idx), output_chunk_.column(aggr_idx));
+    } else {
+      append_state<float>(aggregate_type, aggr_values_.at(aggr_idx), output_chunk_.column(aggr_idx));
+    }
+  }
+  emitted_ = true;
+  return chunk.reference(output_chunk_);
 }
 
 RC AggregateVecPhysicalOperator::close()
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "sql/expr/expression.h"
 #include "sql/operator/physical_operator.h"
 
 /**
@@ -29,15 +30,35 @@ public:
   RC next(Chunk &chunk) override;
   RC close() override;
 
+  /**
+   * @brief 聚合的结果类型
+   * @details COUNT 总是返回整数，AVG 总是返回浮点数，其它聚合函数与参数的类型相同
+   */
+  static AttrType result_type(AggregateExpr::Type aggregate_type, AttrType value_type);
+
 private:
+  template <typename T>
+  static void *create_state(AggregateExpr::Type aggregate_type);
+
+  template <typename T>
+  void update_state(AggregateExpr::Type aggregate_type, void *state, const Column &column, int rows);
+
+  template <typename T>
+  void append_state(AggregateExpr::Type aggregate_type, void *state, Column &column);
+
   template <class STATE, typename T>
-  void update_aggregate_state(void *state, const Column &column);
+  void update_aggregate_state(void *state, const Column &column, int rows);
 
   template <class STATE, typename T>
   void append_to_column(void *state, Column &column)
   {
     STATE *state_ptr = reinterpret_cast<STATE *>(state);
-    column.append_one((char *)&state_ptr->value);
+    if (state_ptr->is_null()) {
+      column.append_null();
+      return;
+    }
+    auto result = state_ptr->result();
+    column.append_one((char *)&result);
   }
 
 private:
@@ -55,12 +76,15 @@ private:
     }
 
     size_t size() { return data_.size(); }
-    ~AggregateValues()
+    ~AggregateValues() { clear(); }
+
+    void clear()
     {
       for (auto &aggr_value : data_) {
         free(aggr_value);
         aggr_value = nullptr;
       }
+      data_.clear();
     }
 
   private:
@@ -71,4 +95,5 @@ private:
   Chunk                chunk_;
   Chunk                output_chunk_;
   AggregateValues      aggr_values_;
+  bool                 emitted_ = false;  /// 聚合结果只输出一次
 };
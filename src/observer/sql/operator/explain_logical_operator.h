@@ -23,10 +23,15 @@ See the Mulan PSL v2 for more details. */
 class ExplainLogicalOperator : public LogicalOperator
 {
 public:
-  ExplainLogicalOperator()          = default;
+  ExplainLogicalOperator(bool analyze = false) : analyze_(analyze) {}
   virtual ~ExplainLogicalOperator() = default;
 
   LogicalOperatorType type() const override { return LogicalOperatorType::EXPLAIN; }
 
   OpType get_op_type() const override { return OpType::LOGICALEXPLAIN; }
+
+  bool analyze() const { return analyze_; }
+
+private:
+  bool analyze_ = false;  ///< 是否是 EXPLAIN ANALYZE
 };
@@ -18,9 +18,11 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
-RC ExplainPhysicalOperator::open(Trx *)
+RC ExplainPhysicalOperator::open(Trx *trx)
 {
   ASSERT(children_.size() == 1, "explain must has 1 child");
+  trx_ = trx;
+  physical_plan_.clear();
   return RC::SUCCESS;
 }
 
@@ -29,7 +31,36 @@ RC ExplainPhysicalOperator::close() { return RC::SUCCESS; }
 void ExplainPhysicalOperator::generate_physical_plan()
 {
   ASSERT(children_.size() == 1, "explain must has 1 child");
-  physical_plan_ = OptimizerUtils::dump_physical_plan(children_.front());
+  physical_plan_ = OptimizerUtils::dump_physical_plan(children_.front(), analyze_);
+}
+
+RC ExplainPhysicalOperator::execute_child(bool chunk_mode)
+{
+  PhysicalOperator &child = *children_.front();
+  RC                rc    = child.open(trx_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (chunk_mode) {
+    Chunk chunk;
+    while (OB_SUCC(rc = child.next(chunk))) {
+      chunk.reset();
+    }
+  } else {
+    while (OB_SUCC(rc = child.next())) {
+    }
+  }
+
+  RC close_rc = child.close();
+  if (rc == RC::RECORD_EOF) {
+    rc = close_rc;
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to execute child operator. rc=%s", strrc(rc));
+  }
+  return rc;
 }
 
 RC ExplainPhysicalOperator::next()
@@ -37,6 +68,13 @@ RC ExplainPhysicalOperator::next()
   if (!physical_plan_.empty()) {
     return RC::RECORD_EOF;
   }
+
+  if (analyze_) {
+    RC rc = execute_child(false /*chunk_mode*/);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
   generate_physical_plan();
 
   vector<Value> cells;
@@ -51,6 +89,13 @@ RC ExplainPhysicalOperator::next(Chunk &chunk)
   if (!physical_plan_.empty()) {
     return RC::RECORD_EOF;
   }
+
+  if (analyze_) {
+    RC rc = execute_child(true /*chunk_mode*/);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
   generate_physical_plan();
 
   Value         cell(physical_plan_.c_str());
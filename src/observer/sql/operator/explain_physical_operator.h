@@ -19,11 +19,12 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief Explain物理算子
  * @ingroup PhysicalOperator
+ * @details EXPLAIN ANALYZE 会先把子算子执行完，再输出带有执行统计信息的执行计划
  */
 class ExplainPhysicalOperator : public PhysicalOperator
 {
 public:
-  ExplainPhysicalOperator()          = default;
+  ExplainPhysicalOperator(bool analyze = false) : analyze_(analyze) {}
   virtual ~ExplainPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::EXPLAIN; }
@@ -50,7 +51,12 @@ public:
 private:
   void generate_physical_plan();
 
+  /// @brief 按照tuple或者chunk的方式执行子算子，并丢弃所有的结果
+  RC execute_child(bool chunk_mode);
+
 private:
+  bool           analyze_ = false;
+  Trx           *trx_     = nullptr;
   string         physical_plan_;
   ValueListTuple tuple_;
 };
@@ -0,0 +1,611 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/external_sorter.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/atomic.h"
+#include "common/lang/filesystem.h"
+#include "common/log/log.h"
+
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+bool is_var_length(AttrType type)
+{
+  return type == AttrType::CHARS || type == AttrType::BITMAP || type == AttrType::VECTORS;
+}
+
+/**
+ * @brief 把一行编码追加到buffer中
+ * @details 格式：| row length(4) | value 0 | value 1 | ...
+ * 每个值：| type(1) | is null(1) | 定长类型 length(1) + data，变长类型 length(4) + data，NULL没有后面的部分 |
+ */
+RC encode_row(const vector<Value> &values, vector<char> &buffer)
+{
+  const size_t row_begin = buffer.size();
+  int32_t      row_len   = 0;
+  buffer.insert(buffer.end(), sizeof(row_len), 0);
+
+  for (const Value &value : values) {
+    const AttrType type = value.attr_type();
+    buffer.push_back(static_cast<char>(type));
+    buffer.push_back(static_cast<char>(value.is_null() ? 1 : 0));
+    if (value.is_null()) {
+      continue;
+    }
+
+    const int32_t length = value.length();
+    if (is_var_length(type)) {
+      const char *len_data = reinterpret_cast<const char *>(&length);
+      buffer.insert(buffer.end(), len_data, len_data + sizeof(length));
+    } else if (length <= static_cast<int32_t>(sizeof(int64_t)) && type != AttrType::UNDEFINED && type != AttrType::TEXT) {
+      buffer.push_back(static_cast<char>(length));
+    } else {
+      LOG_WARN("unsupported value type to spill. type=%s, length=%d", attr_type_to_string(type), length);
+      return RC::UNSUPPORTED;
+    }
+    if (length > 0) {
+      buffer.insert(buffer.end(), value.data(), value.data() + length);
+    }
+  }
+
+  row_len = static_cast<int32_t>(buffer.size() - row_begin - sizeof(row_len));
+  memcpy(buffer.data() + row_begin, &row_len, sizeof(row_len));
+  return RC::SUCCESS;
+}
+
+RC decode_row(const char *data, int32_t row_len, vector<Value> &values)
+{
+  values.clear();
+  const char *end = data + row_len;
+  while (data < end) {
+    if (end - data < 2) {
+      return RC::IOERR_READ;
+    }
+    const AttrType type    = static_cast<AttrType>(data[0]);
+    const bool     is_null = data[1] != 0;
+    data += 2;
+
+    Value &value = values.emplace_back();
+    value.set_type(type);
+    if (is_null) {
+      value.set_null(true);
+      continue;
+    }
+
+    int32_t length = 0;
+    if (is_var_length(type)) {
+      if (end - data < static_cast<int64_t>(sizeof(length))) {
+        return RC::IOERR_READ;
+      }
+      memcpy(&length, data, sizeof(length));
+      data += sizeof(length);
+    } else {
+      length = static_cast<uint8_t>(*data);
+      data++;
+    }
+    if (length < 0 || end - data < length) {
+      return RC::IOERR_READ;
+    }
+
+    if (is_var_length(type)) {
+      value.set_data(data, length);
+    } else {
+      // 定长类型按照4字节读取，补齐到8字节避免越界
+      char fixed[sizeof(int64_t)] = {0};
+      memcpy(fixed, data, length);
+      value.set_data(fixed, length);
+    }
+    data += length;
+  }
+  return RC::SUCCESS;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+SortRunWriter::~SortRunWriter()
+{
+  file_.close_file();
+}
+
+RC SortRunWriter::open(const string &file_name)
+{
+  RC rc = file_.create_file(file_name.c_str());
+  if (OB_SUCC(rc)) {
+    rc = file_.open_file();
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create sort run file. file=%s, rc=%s", file_name.c_str(), strrc(rc));
+    return rc;
+  }
+
+  file_name_ = file_name;
+  buffer_.reserve(ExternalSorter::RUN_BUFFER_SIZE);
+  return rc;
+}
+
+RC SortRunWriter::write(const ValueListTuple &tuple)
+{
+  const int     cell_num = tuple.cell_num();
+  vector<Value> values(cell_num);
+  for (int i = 0; i < cell_num; i++) {
+    RC rc = tuple.cell_at(i, values[i]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return write(values);
+}
+
+RC SortRunWriter::write(const vector<Value> &values)
+{
+  RC rc = encode_row(values, buffer_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  row_count_++;
+  if (static_cast<int64_t>(buffer_.size()) >= ExternalSorter::RUN_BUFFER_SIZE) {
+    rc = flush_buffer();
+  }
+  return rc;
+}
+
+RC SortRunWriter::finish(SortRun &run)
+{
+  RC rc = flush_buffer();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = file_.close_file();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  run.file_name = file_name_;
+  run.bytes     = bytes_;
+  run.row_count = row_count_;
+  return rc;
+}
+
+RC SortRunWriter::flush_buffer()
+{
+  if (buffer_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = file_.write_file(static_cast<int>(buffer_.size()), buffer_.data());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write sort run file. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  bytes_ += buffer_.size();
+  buffer_.clear();
+  return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SortRunReader::~SortRunReader()
+{
+  file_.close_file();
+}
+
+RC SortRunReader::open(const SortRun &run)
+{
+  RC rc = file_.open_file(run.file_name.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open sort run file. file=%s, rc=%s", run.file_name.c_str(), strrc(rc));
+    return rc;
+  }
+
+  file_size_ = run.bytes;
+  buffer_.resize(ExternalSorter::RUN_BUFFER_SIZE);
+  return rc;
+}
+
+RC SortRunReader::next(ValueListTuple &tuple)
+{
+  vector<Value> values;
+  RC            rc = next(values);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  tuple.set_names(specs_);
+  tuple.set_cells(values);
+  return rc;
+}
+
+RC SortRunReader::next(vector<Value> &values)
+{
+  if (buffer_pos_ == buffer_len_ && file_offset_ >= file_size_) {
+    return RC::RECORD_EOF;
+  }
+
+  int32_t row_len = 0;
+  RC      rc      = fill_buffer(sizeof(row_len));
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  memcpy(&row_len, buffer_.data() + buffer_pos_, sizeof(row_len));
+  buffer_pos_ += sizeof(row_len);
+
+  rc = fill_buffer(row_len);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = decode_row(buffer_.data() + buffer_pos_, row_len, values);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to decode sort run row. rc=%s", strrc(rc));
+    return rc;
+  }
+  buffer_pos_ += row_len;
+  return rc;
+}
+
+RC SortRunReader::fill_buffer(int64_t size)
+{
+  const int64_t remain = buffer_len_ - buffer_pos_;
+  if (remain >= size) {
+    return RC::SUCCESS;
+  }
+
+  memmove(buffer_.data(), buffer_.data() + buffer_pos_, remain);
+  buffer_pos_ = 0;
+  buffer_len_ = remain;
+  if (static_cast<int64_t>(buffer_.size()) < size) {
+    buffer_.resize(size);
+  }
+
+  while (buffer_len_ < size) {
+    if (file_offset_ >= file_size_) {
+      LOG_WARN("sort run file is truncated. offset=%ld, size=%ld", file_offset_, file_size_);
+      return RC::IOERR_READ;
+    }
+
+    const int64_t to_read   = min(static_cast<int64_t>(buffer_.size()) - buffer_len_, file_size_ - file_offset_);
+    int64_t       read_size = 0;
+    RC rc = file_.read_at(file_offset_, static_cast<int>(to_read), buffer_.data() + buffer_len_, &read_size);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (read_size <= 0) {
+      return RC::IOERR_READ;
+    }
+    file_offset_ += read_size;
+    buffer_len_ += read_size;
+  }
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SortRunMerger::SortRunMerger(const vector<unique_ptr<OrderBy>> &orderbys, const vector<TupleCellSpec> &specs)
+    : orderbys_(orderbys), specs_(specs), comp_(orderbys)
+{}
+
+RC SortRunMerger::open(const vector<SortRun> &runs)
+{
+  const int k = static_cast<int>(runs.size());
+  readers_.clear();
+  leaves_.clear();
+  leaves_.resize(k);
+  exhausted_.assign(k, false);
+
+  RC rc = RC::SUCCESS;
+  for (int i = 0; i < k; i++) {
+    auto reader = make_unique<SortRunReader>(specs_);
+    if (OB_FAIL(rc = reader->open(runs[i]))) {
+      return rc;
+    }
+    readers_.push_back(std::move(reader));
+    if (OB_FAIL(rc = read_leaf(i))) {
+      return rc;
+    }
+  }
+
+  // 所有内部节点先指向哨兵k，它比所有的行都小，然后从后往前依次调整每个叶子
+  losers_.assign(max(k, 1), k);
+  for (int i = k - 1; i >= 0; i--) {
+    adjust(i);
+  }
+  first_ = true;
+  return rc;
+}
+
+RC SortRunMerger::next(SortEntry *&entry)
+{
+  if (!first_) {
+    // 上一次输出的那一路读入下一行，再重新调整
+    const int winner = losers_[0];
+    RC        rc     = read_leaf(winner);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    adjust(winner);
+  }
+  first_ = false;
+
+  const int winner = losers_[0];
+  if (winner >= static_cast<int>(leaves_.size()) || exhausted_[winner]) {
+    return RC::RECORD_EOF;
+  }
+
+  current_ = std::move(leaves_[winner]);
+  entry    = &current_;
+  return RC::SUCCESS;
+}
+
+RC SortRunMerger::read_leaf(int leaf)
+{
+  ValueListTuple tuple;
+  RC             rc = readers_[leaf]->next(tuple);
+  if (RC::RECORD_EOF == rc) {
+    exhausted_[leaf] = true;
+    return RC::SUCCESS;
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to read sort run. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  vector<Value> keys;
+  keys.reserve(orderbys_.size());
+  for (const unique_ptr<OrderBy> &orderby : orderbys_) {
+    Value value;
+    if (OB_FAIL(rc = orderby->expr->get_value(tuple, value))) {
+      LOG_WARN("failed to get sort key. rc=%s", strrc(rc));
+      return rc;
+    }
+    keys.push_back(std::move(value));
+  }
+
+  leaves_[leaf].set_keys(std::move(keys));
+  leaves_[leaf].set_tuple(std::move(tuple));
+  return RC::SUCCESS;
+}
+
+void SortRunMerger::adjust(int leaf)
+{
+  const int k = static_cast<int>(leaves_.size());
+  int       s = leaf;
+  for (int t = (leaf + k) / 2; t > 0; t /= 2) {
+    // 失败者留在节点上，胜者继续往上比较
+    if (less(losers_[t], s)) {
+      swap(s, losers_[t]);
+    }
+  }
+  losers_[0] = s;
+}
+
+bool SortRunMerger::less(int left, int right)
+{
+  const int k = static_cast<int>(leaves_.size());
+  if (left == k || right == k) {
+    return left == k && right != k;
+  }
+  if (exhausted_[right]) {
+    return !exhausted_[left];
+  }
+  if (exhausted_[left]) {
+    return false;
+  }
+  return comp_(leaves_[left], leaves_[right]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ExternalSorter::ExternalSorter(const vector<unique_ptr<OrderBy>> &orderbys, int64_t memory_budget, const string &spill_dir)
+    : orderbys_(orderbys), comp_(orderbys), memory_budget_(max(memory_budget, MIN_MEMORY_BUDGET)), spill_dir_(spill_dir)
+{}
+
+ExternalSorter::~ExternalSorter()
+{
+  merger_.reset();
+  remove_runs();
+}
+
+RC ExternalSorter::add(ValueListTuple &&tuple)
+{
+  RC rc = RC::SUCCESS;
+  if (specs_.empty() && tuple.cell_num() > 0) {
+    specs_memory_ = 0;
+    for (int i = 0; i < tuple.cell_num(); i++) {
+      TupleCellSpec spec;
+      tuple.spec_at(i, spec);
+      specs_memory_ += sizeof(TupleCellSpec) + strlen(spec.table_name()) + strlen(spec.field_name()) +
+                       strlen(spec.alias());
+      specs_.push_back(spec);
+    }
+  }
+
+  vector<Value> keys;
+  keys.reserve(orderbys_.size());
+  size_t entry_size = sizeof(SortEntry) + specs_memory_;
+  for (const unique_ptr<OrderBy> &orderby : orderbys_) {
+    Value value;
+    if (OB_FAIL(rc = orderby->expr->get_value(tuple, value))) {
+      LOG_WARN("failed to get sort key. rc=%s", strrc(rc));
+      return rc;
+    }
+    entry_size += value.memory_size();
+    keys.push_back(std::move(value));
+  }
+  for (int i = 0; i < tuple.cell_num(); i++) {
+    Value value;
+    tuple.cell_at(i, value);
+    entry_size += value.memory_size();
+  }
+
+  if (memory_usage_ + static_cast<int64_t>(entry_size) > memory_budget_ && !entries_.empty()) {
+    if (OB_FAIL(rc = spill())) {
+      return rc;
+    }
+  }
+
+  entries_.emplace_back(std::move(keys), std::move(tuple));
+  memory_usage_ += entry_size;
+  return rc;
+}
+
+RC ExternalSorter::finish()
+{
+  RC rc = RC::SUCCESS;
+  if (runs_.empty()) {
+    // 内存放得下，不需要落盘
+    std::sort(entries_.begin(), entries_.end(), comp_);
+    iter_ = 0;
+    return rc;
+  }
+
+  if (!entries_.empty() && OB_FAIL(rc = spill())) {
+    return rc;
+  }
+
+  // 每一路归并都要一个读缓冲区，路数太多的话先归并一部分，直到一次可以归并完成
+  const int fan_in = static_cast<int>(max<int64_t>(2, memory_budget_ / RUN_BUFFER_SIZE));
+  while (static_cast<int>(runs_.size()) > fan_in) {
+    if (OB_FAIL(rc = merge_runs(fan_in))) {
+      return rc;
+    }
+  }
+
+  merger_ = make_unique<SortRunMerger>(orderbys_, specs_);
+  rc      = merger_->open(runs_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open sort run merger. rc=%s", strrc(rc));
+  }
+  merge_passes_++;
+  return rc;
+}
+
+RC ExternalSorter::next(SortEntry *&entry)
+{
+  if (merger_) {
+    return merger_->next(entry);
+  }
+
+  if (iter_ >= entries_.size()) {
+    return RC::RECORD_EOF;
+  }
+  entry = &entries_[iter_++];
+  return RC::SUCCESS;
+}
+
+RC ExternalSorter::spill()
+{
+  std::sort(entries_.begin(), entries_.end(), comp_);
+
+  string file_name;
+  RC     rc = create_run_file(file_name);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  SortRunWriter writer;
+  if (OB_FAIL(rc = writer.open(file_name))) {
+    return rc;
+  }
+  // 先记下来，出错的时候也能删除文件
+  runs_.push_back(SortRun{file_name});
+
+  for (const SortEntry &entry : entries_) {
+    if (OB_FAIL(rc = writer.write(entry.tuple()))) {
+      LOG_WARN("failed to write sort run. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  if (OB_FAIL(rc = writer.finish(runs_.back()))) {
+    return rc;
+  }
+
+  LOG_TRACE("spill sort run. file=%s, rows=%ld, bytes=%ld", file_name.c_str(), runs_.back().row_count, runs_.back().bytes);
+  spilled_runs_++;
+  spilled_bytes_ += runs_.back().bytes;
+  entries_.clear();
+  memory_usage_ = 0;
+  return rc;
+}
+
+RC ExternalSorter::merge_runs(int fan_in)
+{
+  vector<SortRun> inputs(runs_.begin(), runs_.begin() + fan_in);
+
+  string file_name;
+  RC     rc = create_run_file(file_name);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  SortRunWriter writer;
+  if (OB_FAIL(rc = writer.open(file_name))) {
+    return rc;
+  }
+  runs_.push_back(SortRun{file_name});
+
+  {
+    SortRunMerger merger(orderbys_, specs_);
+    if (OB_FAIL(rc = merger.open(inputs))) {
+      return rc;
+    }
+
+    SortEntry *entry = nullptr;
+    while (OB_SUCC(rc = merger.next(entry))) {
+      if (OB_FAIL(rc = writer.write(entry->tuple()))) {
+        return rc;
+      }
+    }
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+
+  if (OB_FAIL(rc = writer.finish(runs_.back()))) {
+    return rc;
+  }
+
+  for (const SortRun &run : inputs) {
+    PersistHandler().remove_file(run.file_name.c_str());
+  }
+  runs_.erase(runs_.begin(), runs_.begin() + fan_in);
+
+  spilled_bytes_ += runs_.back().bytes;
+  merge_passes_++;
+  return rc;
+}
+
+RC ExternalSorter::create_run_file(string &file_name)
+{
+  static atomic<uint64_t> sequence{0};
+
+  error_code ec;
+  filesystem::create_directories(spill_dir_, ec);
+  if (ec) {
+    LOG_WARN("failed to create sort spill directory. dir=%s, error=%s", spill_dir_.c_str(), ec.message().c_str());
+    return RC::FILE_CREATE;
+  }
+
+  file_name = (filesystem::path(spill_dir_) / ("sort_" + to_string(getpid()) + "_" + to_string(sequence++) + ".run"))
+                  .string();
+  return RC::SUCCESS;
+}
+
+void ExternalSorter::remove_runs()
+{
+  for (const SortRun &run : runs_) {
+    PersistHandler().remove_file(run.file_name.c_str());
+  }
+  runs_.clear();
+}
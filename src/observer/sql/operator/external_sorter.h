@@ -0,0 +1,192 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "sql/operator/order_by_physical_operator.h"
+#include "storage/persist/persist.h"
+
+/**
+ * @brief 排序时落盘的一个有序段(run)
+ * @ingroup PhysicalOperator
+ * @details 每一行使用紧凑的二进制格式连续存放：4字节的行长度，然后是每个值的类型、是否为NULL、长度和数据。
+ * 只保存行本身，排序键在读出来之后重新计算。
+ * Hash Join 落盘的分区也使用同样的格式，只是分区中的行没有顺序。
+ */
+struct SortRun
+{
+  string  file_name;
+  int64_t bytes     = 0;
+  int64_t row_count = 0;
+};
+
+/**
+ * @brief 顺序写一个有序段文件
+ * @ingroup PhysicalOperator
+ */
+class SortRunWriter
+{
+public:
+  SortRunWriter() = default;
+  ~SortRunWriter();
+
+  RC open(const string &file_name);
+  RC write(const ValueListTuple &tuple);
+  RC write(const vector<Value> &values);
+  /// @brief 把缓存的数据写到文件并关闭文件
+  RC finish(SortRun &run);
+
+private:
+  RC flush_buffer();
+
+private:
+  PersistHandler file_;
+  string         file_name_;
+  vector<char>   buffer_;
+  int64_t        bytes_     = 0;
+  int64_t        row_count_ = 0;
+};
+
+/**
+ * @brief 顺序读一个有序段文件
+ * @ingroup PhysicalOperator
+ */
+class SortRunReader
+{
+public:
+  SortRunReader(const vector<TupleCellSpec> &specs) : specs_(specs) {}
+  ~SortRunReader();
+
+  RC open(const SortRun &run);
+  /// @brief 读取下一行，读完时返回 RC::RECORD_EOF
+  RC next(ValueListTuple &tuple);
+  RC next(vector<Value> &values);
+
+private:
+  /// @brief 保证缓冲区中至少有size个字节没有读
+  RC fill_buffer(int64_t size);
+
+private:
+  const vector<TupleCellSpec> &specs_;
+
+  PersistHandler file_;
+  int64_t        file_size_   = 0;
+  int64_t        file_offset_ = 0;  ///< 下一次从文件的哪个位置读
+  vector<char>   buffer_;
+  int64_t        buffer_pos_ = 0;  ///< 缓冲区中下一个没有读的字节
+  int64_t        buffer_len_ = 0;  ///< 缓冲区中有效数据的长度
+};
+
+/**
+ * @brief 使用败者树(loser tree)多路归并若干个有序段
+ * @ingroup PhysicalOperator
+ * @details 败者树的内部节点记录比较中失败的那一路，根节点之上记录最终的胜者。
+ * 每输出一行，只需要沿着胜者所在的叶子到根的路径比较 log(k) 次。
+ */
+class SortRunMerger
+{
+public:
+  SortRunMerger(const vector<unique_ptr<OrderBy>> &orderbys, const vector<TupleCellSpec> &specs);
+  ~SortRunMerger() = default;
+
+  RC open(const vector<SortRun> &runs);
+  /// @brief 取出所有有序段中最小的一行，全部取完时返回 RC::RECORD_EOF
+  RC next(SortEntry *&entry);
+
+private:
+  RC   read_leaf(int leaf);
+  void adjust(int leaf);
+  /// @brief 第left路是否应该排在第right路之前。k表示一个比所有行都小的哨兵，读完的路比所有行都大
+  bool less(int left, int right);
+
+private:
+  const vector<unique_ptr<OrderBy>> &orderbys_;
+  const vector<TupleCellSpec>       &specs_;
+  Comparator                         comp_;
+
+  vector<unique_ptr<SortRunReader>> readers_;
+  vector<SortEntry>                 leaves_;
+  vector<bool>                      exhausted_;
+  vector<int>                       losers_;  ///< losers_[0]是胜者，其它是内部节点上的败者
+  SortEntry                         current_;
+  bool                              first_ = true;
+};
+
+/**
+ * @brief 在限定的内存中排序
+ * @ingroup PhysicalOperator
+ * @details 行先缓存在内存中，内存超过限制时把当前缓存的行排好序，作为一个有序段写到临时文件中。
+ * 所有的行都加进来之后，如果没有落盘就直接在内存中排序输出，否则把剩下的行也写成一个有序段，
+ * 然后使用败者树多路归并所有的有序段。有序段太多时会先做几轮归并，减少同时打开的文件，
+ * 每一路归并都需要一个读缓冲区，所以同时归并多少路也受内存限制。
+ */
+class ExternalSorter
+{
+public:
+  static constexpr int64_t MIN_MEMORY_BUDGET = 32 * 1024;  ///< 最少使用32K内存
+  static constexpr int64_t RUN_BUFFER_SIZE   = 16 * 1024;  ///< 读写有序段文件时缓冲区的大小
+
+public:
+  ExternalSorter(const vector<unique_ptr<OrderBy>> &orderbys, int64_t memory_budget, const string &spill_dir);
+  ~ExternalSorter();
+
+  /**
+   * @brief 增加一行
+   * @details 会计算这一行的排序键，内存超过限制时会把已经缓存的行落盘
+   */
+  RC add(ValueListTuple &&tuple);
+
+  /**
+   * @brief 所有的行都增加完成，准备输出
+   */
+  RC finish();
+
+  /**
+   * @brief 按照顺序输出下一行，全部输出完成时返回 RC::RECORD_EOF
+   * @details 返回的行在下一次调用之前都是有效的
+   */
+  RC next(SortEntry *&entry);
+
+  int64_t spilled_runs() const { return spilled_runs_; }
+  int64_t spilled_bytes() const { return spilled_bytes_; }
+  int     merge_passes() const { return merge_passes_; }
+
+private:
+  /// @brief 把内存中的行排序后写成一个有序段
+  RC spill();
+  /// @brief 归并前面fan_in个有序段，生成一个新的有序段
+  RC merge_runs(int fan_in);
+  RC create_run_file(string &file_name);
+  void remove_runs();
+
+private:
+  const vector<unique_ptr<OrderBy>> &orderbys_;
+  Comparator                         comp_;
+  int64_t                            memory_budget_ = MIN_MEMORY_BUDGET;
+  string                             spill_dir_;
+
+  vector<TupleCellSpec> specs_;            ///< 所有行的列描述都是一样的，只记录一份
+  size_t                specs_memory_ = 0;  ///< 每一行中列描述占用的内存
+
+  vector<SortEntry> entries_;  ///< 内存中缓存的行
+  int64_t           memory_usage_ = 0;
+  size_t            iter_         = 0;
+
+  vector<SortRun>           runs_;
+  unique_ptr<SortRunMerger> merger_;
+
+  int64_t spilled_runs_  = 0;
+  int64_t spilled_bytes_ = 0;
+  int     merge_passes_  = 0;
+};
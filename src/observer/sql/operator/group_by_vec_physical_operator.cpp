@@ -8,4 +8,137 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
-#include "sql/operator/group_by_vec_physical_operator.h"
\ No newline at end of file
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "common/log/log.h"
+#include "sql/operator/aggregate_vec_physical_operator.h"
+
+using namespace std;
+using namespace common;
+
+GroupByVecPhysicalOperator::GroupByVecPhysicalOperator(
+    vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions)
+    : group_by_expressions_(std::move(group_by_exprs)), aggregate_expressions_(std::move(expressions))
+{
+  value_expressions_.reserve(aggregate_expressions_.size());
+  for (Expression *expr : aggregate_expressions_) {
+    ASSERT(expr->type() == ExprType::AGGREGATION, "expected an aggregation expression");
+    auto       *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    Expression *child_expr     = aggregate_expr->child().get();
+    ASSERT(child_expr != nullptr, "aggregation expression must have a child expression");
+    value_expressions_.emplace_back(child_expr);
+  }
+
+  int col_id = 0;
+  for (const unique_ptr<Expression> &expr : group_by_expressions_) {
+    output_chunk_.add_column(make_unique<Column>(expr->value_type(), expr->value_length()), col_id++);
+  }
+  for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
+    auto    *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[i]);
+    AttrType result_type =
+        AggregateVecPhysicalOperator::result_type(aggregate_expr->aggregate_type(), value_expressions_[i]->value_type());
+    int result_len = (result_type == value_expressions_[i]->value_type()) ? value_expressions_[i]->value_length() : 4;
+    output_chunk_.add_column(make_unique<Column>(result_type, result_len), col_id++);
+  }
+}
+
+void GroupByVecPhysicalOperator::create_hash_table()
+{
+#ifdef USE_SIMD
+  if (group_by_expressions_.size() == 1 && group_by_expressions_[0]->value_type() == AttrType::INTS &&
+      aggregate_expressions_.size() == 1 && value_expressions_[0]->type() != ExprType::VALUE) {
+    auto               *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[0]);
+    AggregateExpr::Type aggregate_type = aggregate_expr->aggregate_type();
+    AttrType            value_type     = value_expressions_[0]->value_type();
+    if (aggregate_type == AggregateExpr::Type::SUM || aggregate_type == AggregateExpr::Type::MAX ||
+        aggregate_type == AggregateExpr::Type::MIN) {
+      if (value_type == AttrType::INTS) {
+        hash_table_ = make_unique<LinearProbingAggregateHashTable<int>>(aggregate_type);
+        scanner_    = make_unique<LinearProbingAggregateHashTable<int>::Scanner>(hash_table_.get());
+        return;
+      } else if (value_type == AttrType::FLOATS) {
+        hash_table_ = make_unique<LinearProbingAggregateHashTable<float>>(aggregate_type);
+        scanner_    = make_unique<LinearProbingAggregateHashTable<float>::Scanner>(hash_table_.get());
+        return;
+      }
+    }
+  }
+#endif
+
+  hash_table_ = make_unique<StandardAggregateHashTable>(aggregate_expressions_);
+  scanner_    = make_unique<StandardAggregateHashTable::Scanner>(hash_table_.get());
+}
+
+RC GroupByVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = child.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_INFO("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 执行计划可能被复用，每次打开时都使用新的哈希表
+  create_hash_table();
+
+  while (OB_SUCC(rc = child.next(chunk_))) {
+    if (OB_FAIL(rc = aggregate_chunk(chunk_))) {
+      LOG_WARN("failed to aggregate chunk. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  if (rc == RC::RECORD_EOF) {
+    rc = RC::SUCCESS;
+  }
+
+  scanner_->open_scan();
+  return rc;
+}
+
+RC GroupByVecPhysicalOperator::aggregate_chunk(Chunk &chunk)
+{
+  RC rc = RC::SUCCESS;
+  groups_chunk_.reset();
+  aggrs_chunk_.reset();
+  for (size_t i = 0; i < group_by_expressions_.size(); i++) {
+    auto column = make_unique<Column>();
+    if (OB_FAIL(rc = group_by_expressions_[i]->get_column(chunk, *column))) {
+      LOG_WARN("failed to get column of group by expression. rc=%s", strrc(rc));
+      return rc;
+    }
+    groups_chunk_.add_column(std::move(column), i);
+  }
+
+  for (size_t i = 0; i < value_expressions_.size(); i++) {
+    auto column = make_unique<Column>();
+    if (OB_FAIL(rc = value_expressions_[i]->get_column(chunk, *column))) {
+      LOG_WARN("failed to get column of aggregation. rc=%s", strrc(rc));
+      return rc;
+    }
+    aggrs_chunk_.add_column(std::move(column), i);
+  }
+
+  return hash_table_->add_chunk(groups_chunk_, aggrs_chunk_);
+}
+
+RC GroupByVecPhysicalOperator::next(Chunk &chunk)
+{
+  output_chunk_.reset_data();
+  RC rc = scanner_->next(output_chunk_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return chunk.reference(output_chunk_);
+}
+
+RC GroupByVecPhysicalOperator::close()
+{
+  if (scanner_ != nullptr) {
+    scanner_->close_scan();
+  }
+  children_[0]->close();
+  LOG_INFO("close group by operator");
+  return RC::SUCCESS;
+}
@@ -16,19 +16,46 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief Group By 物理算子(vectorized)
  * @ingroup PhysicalOperator
+ * @details 在 open 时消费下层算子的所有 chunk，计算出 group by 表达式和聚合函数参数的值，
+ * 写入到哈希表(AggregateHashTable)中完成聚合，next 时从哈希表中扫描出聚合结果。
+ * 输出 chunk 中先是所有的 group by 表达式，然后是所有的聚合表达式，与表达式的 pos 对应。
+ * 在开启 USE_SIMD 时，单个 int 类型的分组列加上单个 SUM/MAX/MIN 聚合会使用线性探测哈希表，
+ * 其它情况使用 StandardAggregateHashTable。
  */
 class GroupByVecPhysicalOperator : public PhysicalOperator
 {
 public:
-  GroupByVecPhysicalOperator(vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions){};
+  GroupByVecPhysicalOperator(vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions);
 
   virtual ~GroupByVecPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::GROUP_BY_VEC; }
 
-  RC open(Trx *trx) override { return RC::UNIMPLEMENTED; }
-  RC next(Chunk &chunk) override { return RC::UNIMPLEMENTED; }
-  RC close() override { return RC::UNIMPLEMENTED; }
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
 
 private:
+  /**
+   * @brief 创建聚合使用的哈希表以及对应的扫描器
+   */
+  void create_hash_table();
+
+  /**
+   * @brief 计算一个 chunk 中的分组值和聚合函数参数，写入哈希表
+   */
+  RC aggregate_chunk(Chunk &chunk);
+
+private:
+  vector<unique_ptr<Expression>> group_by_expressions_;   /// 分组表达式
+  vector<Expression *>           aggregate_expressions_;  /// 聚合表达式
+  vector<Expression *>           value_expressions_;      /// 计算聚合时的表达式
+
+  unique_ptr<AggregateHashTable>          hash_table_;
+  unique_ptr<AggregateHashTable::Scanner> scanner_;
+
+  Chunk chunk_;
+  Chunk groups_chunk_;
+  Chunk aggrs_chunk_;
+  Chunk output_chunk_;
 };
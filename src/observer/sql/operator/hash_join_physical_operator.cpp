@@ -9,6 +9,139 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/hash_join_physical_operator.h"
+#include "common/lang/atomic.h"
+#include "common/lang/filesystem.h"
+#include "sql/operator/table_scan_physical_operator.h"
+
+#include <unistd.h>
+
+using namespace std;
+
+void HashJoinHashTable::init(int key_num, int cell_num)
+{
+  clear();
+  key_num_ = key_num;
+  stride_  = key_num + cell_num;
+}
+
+void HashJoinHashTable::insert(uint64_t hash, const vector<Value> &keys, vector<Value> &&cells)
+{
+  ASSERT(static_cast<int>(keys.size() + cells.size()) == stride_, "invalid row size");
+  for (const Value &key : keys) {
+    memory_size_ += key.memory_size();
+    values_.push_back(key);
+  }
+  for (Value &cell : cells) {
+    memory_size_ += cell.memory_size();
+    values_.push_back(std::move(cell));
+  }
+  entries_.push_back(Entry{hash, -1});
+  memory_size_ += sizeof(Entry);
+}
+
+void HashJoinHashTable::insert(uint64_t hash, vector<Value> &&values)
+{
+  ASSERT(static_cast<int>(values.size()) == stride_, "invalid row size");
+  for (Value &value : values) {
+    memory_size_ += value.memory_size();
+    values_.push_back(std::move(value));
+  }
+  entries_.push_back(Entry{hash, -1});
+  memory_size_ += sizeof(Entry);
+}
+
+void HashJoinHashTable::build()
+{
+  size_t bucket_num = 16;
+  while (bucket_num < entries_.size()) {
+    bucket_num <<= 1;
+  }
+  buckets_.assign(bucket_num, -1);
+  bucket_mask_ = bucket_num - 1;
+
+  // 从后往前插入到链表头，这样同一个桶中的行保持插入时的顺序
+  for (int i = static_cast<int>(entries_.size()) - 1; i >= 0; i--) {
+    int &head         = buckets_[entries_[i].hash & bucket_mask_];
+    entries_[i].next = head;
+    head             = i;
+  }
+  memory_size_ += bucket_num * sizeof(int);
+}
+
+void HashJoinHashTable::clear()
+{
+  // 使用swap释放内存
+  vector<Value>().swap(values_);
+  vector<Entry>().swap(entries_);
+  vector<int>().swap(buckets_);
+  bucket_mask_ = 0;
+  memory_size_ = 0;
+}
+
+int HashJoinHashTable::find(uint64_t hash, const vector<Value> &keys) const
+{
+  if (buckets_.empty()) {
+    return -1;
+  }
+
+  for (int index = buckets_[hash & bucket_mask_]; index != -1; index = entries_[index].next) {
+    if (entries_[index].hash == hash && keys_equal(index, keys)) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+int HashJoinHashTable::find_next(int index, uint64_t hash, const vector<Value> &keys) const
+{
+  for (index = entries_[index].next; index != -1; index = entries_[index].next) {
+    if (entries_[index].hash == hash && keys_equal(index, keys)) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+bool HashJoinHashTable::keys_equal(int index, const vector<Value> &keys) const
+{
+  const Value *row = row_values(index);
+  for (int i = 0; i < key_num_; i++) {
+    if (!(row[i] == keys[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+HashJoinPhysicalOperator::HashJoinPhysicalOperator(int64_t join_buffer_size, const string &spill_dir)
+    : join_buffer_size_(join_buffer_size),
+      spill_dir_(spill_dir.empty() ? filesystem::temp_directory_path().string() : spill_dir)
+{}
+
+HashJoinPhysicalOperator::~HashJoinPhysicalOperator() { remove_spill_files(); }
+
+string HashJoinPhysicalOperator::param() const
+{
+  string ret;
+  for (size_t i = 0; i < left_key_exprs_.size(); i++) {
+    if (i > 0) {
+      ret.append(" AND ");
+    }
+    ret.append(left_key_exprs_[i]->to_string());
+    ret.push_back('=');
+    ret.append(right_key_exprs_[i]->to_string());
+  }
+  return ret;
+}
+
+string HashJoinPhysicalOperator::runtime_stats() const
+{
+  const int64_t bloom_filtered = bloom_filtered_ + (runtime_filter_ ? runtime_filter_->filtered_rows() : 0);
+  return "join_buffer_size=" + to_string(join_buffer_size_) + ", build_rows=" + to_string(build_rows_) +
+         ", spilled_partitions=" + to_string(spilled_partitions_) + ", spilled_bytes=" + to_string(spilled_bytes_) +
+         ", bloom_filtered=" + to_string(bloom_filtered);
+}
 
 RC HashJoinPhysicalOperator::open(Trx *trx)
 {
@@ -16,11 +149,34 @@ RC HashJoinPhysicalOperator::open(Trx *trx)
     LOG_WARN("hash join operator should have 2 children");
     return RC::INTERNAL;
   }
+  if (left_key_exprs_.empty() || left_key_exprs_.size() != right_key_exprs_.size()) {
+    LOG_WARN("invalid hash join keys. left=%d, right=%d",
+        static_cast<int>(left_key_exprs_.size()), static_cast<int>(right_key_exprs_.size()));
+    return RC::INTERNAL;
+  }
 
   left_  = children_[0].get();
   right_ = children_[1].get();
   trx_   = trx;
 
+  // 执行计划可能被缓存下来重复执行，每次都重新初始化
+  probe_reader_.reset();
+  remove_spill_files();
+  partitions_.clear();
+  partitions_.resize(PARTITION_NUM);
+  left_specs_.clear();
+  right_specs_.clear();
+  memory_usage_       = 0;
+  probing_spilled_    = false;
+  spilled_partition_  = -1;
+  match_table_        = nullptr;
+  match_index_        = -1;
+  build_rows_         = 0;
+  spilled_partitions_ = 0;
+  spilled_bytes_      = 0;
+  bloom_filtered_     = 0;
+  runtime_filter_.reset();
+
   RC rc = RC::SUCCESS;
   if (OB_FAIL(rc = right_->open(trx_))) {
     return rc;
@@ -30,96 +186,469 @@ RC HashJoinPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
-  begin_iter_ = ht_.end();
-  end_iter_   = ht_.end();
+  left_tuple_.set_specs(&left_specs_);
+  joined_tuple_.set_left(&left_tuple_);
+  push_down_runtime_filter();
   return rc;
 }
 
-RC HashJoinPhysicalOperator::next() {
-  if (begin_iter_ != end_iter_) {
-    auto& left_tuple = begin_iter_.val();
-    joined_tuple_.set_left(&left_tuple);
-    ++begin_iter_;
+RC HashJoinPhysicalOperator::next()
+{
+  if (next_match()) {
     return RC::SUCCESS;
   }
 
+  if (build_rows_ == 0) {
+    // 构建端是空的，不需要再读探测端
+    return RC::RECORD_EOF;
+  }
+
   RC rc = RC::SUCCESS;
+  if (!probing_spilled_) {
+    rc = probe_next();
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+    probing_spilled_ = true;
+  }
+  return spilled_next();
+}
 
-  while (OB_SUCC(rc = right_->next())) {
-    right_tuple_ = right_->current_tuple();
-    joined_tuple_.set_right(right_tuple_);
+RC HashJoinPhysicalOperator::close()
+{
+  if (filter_pushed_down_) {
+    static_cast<TableScanPhysicalOperator *>(right_)->set_runtime_filter(nullptr);
+    filter_pushed_down_ = false;
+  }
+
+  RC rc = right_->close();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to close right oper. rc=%s", strrc(rc));
+  }
 
-    HashJoinKey right_key;
-    if (OB_FAIL(rc = right_key_exprs_.at(0)->get_value(*right_tuple_, right_key.key_))) {
+  probe_reader_.reset();
+  remove_spill_files();
+  partitions_.clear();
+  return rc;
+}
+
+Tuple *HashJoinPhysicalOperator::current_tuple() { return &joined_tuple_; }
+
+RC HashJoinPhysicalOperator::iterate_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  RC rc = RC::SUCCESS;
+  for (unique_ptr<Expression> &expr : left_key_exprs_) {
+    if (OB_FAIL(rc = callback(expr))) {
       return rc;
     }
+  }
+  for (unique_ptr<Expression> &expr : right_key_exprs_) {
+    if (OB_FAIL(rc = callback(expr))) {
+      return rc;
+    }
+  }
+  return iterate_children_expressions(callback);
+}
 
-    // 如果是null值，直接跳过
-    if (right_key.key_.is_null()) {
+RC HashJoinPhysicalOperator::build_hash_table()
+{
+  RC rc = RC::SUCCESS;
+
+  if (OB_FAIL(rc = left_->open(trx_))) {
+    return rc;
+  }
+
+  const int     key_num = static_cast<int>(left_key_exprs_.size());
+  vector<Value> keys;
+  uint64_t      hash     = 0;
+  bool          has_null = false;
+  while (OB_SUCC(rc = left_->next())) {
+    Tuple *tuple = left_->current_tuple();
+    if (OB_FAIL(rc = JoinKeyHasher::hash_keys(left_key_exprs_, *tuple, keys, hash, has_null))) {
+      LOG_WARN("failed to get join keys of left tuple. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    // 连接键中有NULL时不会连接上任何行，不加入hash表
+    if (has_null) {
       continue;
     }
 
-    auto [beg, end] = ht_.find(right_key);
-    if (beg != end) {
-      auto& left_tuple = beg.val();
-      joined_tuple_.set_left(&left_tuple);
-      ++beg;
-      begin_iter_ = beg;
-      end_iter_ = end;
-      return RC::SUCCESS;
+    const int cell_num = tuple->cell_num();
+    if (left_specs_.empty() && cell_num > 0) {
+      left_specs_.resize(cell_num);
+      for (int i = 0; i < cell_num; i++) {
+        if (OB_FAIL(rc = tuple->spec_at(i, left_specs_[i]))) {
+          return rc;
+        }
+      }
+      for (Partition &partition : partitions_) {
+        partition.table.init(key_num, cell_num);
+      }
+    }
+
+    vector<Value> cells(cell_num);
+    for (int i = 0; i < cell_num; i++) {
+      if (OB_FAIL(rc = tuple->cell_at(i, cells[i]))) {
+        return rc;
+      }
+    }
+
+    if (OB_FAIL(rc = insert_build_row(hash, keys, std::move(cells)))) {
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read left oper. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (OB_FAIL(rc = left_->close())) {
+    LOG_WARN("failed to close left oper. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 生成运行时过滤器，并把落盘分区中剩下的数据写到文件中
+  runtime_filter_ = make_unique<JoinRuntimeFilter>(right_key_exprs_);
+  runtime_filter_->init(build_rows_);
+  for (Partition &partition : partitions_) {
+    if (!partition.spilled) {
+      for (int i = 0; i < partition.table.size(); i++) {
+        runtime_filter_->add(partition.table.row_hash(i));
+      }
+      partition.table.build();
+      continue;
+    }
+
+    if (OB_FAIL(rc = partition.build_writer->finish(partition.build_run))) {
+      LOG_WARN("failed to finish hash join partition file. rc=%s", strrc(rc));
+      return rc;
+    }
+    partition.build_writer.reset();
+    spilled_bytes_ += partition.build_run.bytes;
+
+    // 落盘分区的哈希值没有保存在内存中，重新读一遍文件加到过滤器中
+    SortRunReader reader(left_specs_);
+    if (OB_FAIL(rc = reader.open(partition.build_run))) {
+      return rc;
+    }
+    vector<Value> values;
+    while (OB_SUCC(rc = reader.next(values))) {
+      if (OB_FAIL(rc = JoinKeyHasher::hash_keys(values.data(), key_num, hash))) {
+        return rc;
+      }
+      runtime_filter_->add(hash);
+    }
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+
+  LOG_TRACE("hash join build side is ready. rows=%ld, memory=%ld, spilled partitions=%ld",
+      build_rows_, memory_usage_, spilled_partitions_);
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::insert_build_row(uint64_t hash, vector<Value> &keys, vector<Value> &&cells)
+{
+  build_rows_++;
+
+  Partition &partition = partitions_[partition_of(hash)];
+  if (partition.spilled) {
+    return spill_row(partition.build_writer, keys, cells);
+  }
+
+  const int64_t memory_before = partition.table.memory_size();
+  partition.table.insert(hash, keys, std::move(cells));
+  memory_usage_ += partition.table.memory_size() - memory_before;
+  if (memory_usage_ > join_buffer_size_) {
+    return spill_partitions();
+  }
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::spill_partitions()
+{
+  RC rc = RC::SUCCESS;
+  while (memory_usage_ > join_buffer_size_) {
+    int victim = -1;
+    for (int i = 0; i < PARTITION_NUM; i++) {
+      const Partition &partition = partitions_[i];
+      if (!partition.spilled && partition.table.size() > 0 &&
+          (victim == -1 || partition.table.memory_size() > partitions_[victim].table.memory_size())) {
+        victim = i;
+      }
+    }
+    if (victim == -1) {
+      break;
+    }
+
+    if (OB_FAIL(rc = spill_partition(victim))) {
+      return rc;
     }
   }
   return rc;
 }
 
-RC HashJoinPhysicalOperator::close() { 
-  RC rc = right_->close();
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to close right oper. rc=%s", strrc(rc));
+RC HashJoinPhysicalOperator::spill_partition(int index)
+{
+  Partition &partition = partitions_[index];
+
+  string file_name;
+  RC     rc = create_spill_file("build", index, file_name);
+  if (OB_FAIL(rc)) {
+    return rc;
   }
+
+  partition.build_writer = make_unique<SortRunWriter>();
+  if (OB_FAIL(rc = partition.build_writer->open(file_name))) {
+    return rc;
+  }
+  partition.build_run.file_name = file_name;
+
+  HashJoinHashTable &table     = partition.table;
+  const int          value_num = table.row_value_num();
+  vector<Value>      values(value_num);
+  for (int i = 0; i < table.size(); i++) {
+    const Value *row = table.row_values(i);
+    values.assign(row, row + value_num);
+    if (OB_FAIL(rc = partition.build_writer->write(values))) {
+      LOG_WARN("failed to spill hash join partition. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  LOG_TRACE("spill hash join partition. partition=%d, rows=%d, memory=%ld", index, table.size(), table.memory_size());
+  memory_usage_ -= table.memory_size();
+  table.init(static_cast<int>(left_key_exprs_.size()), static_cast<int>(left_specs_.size()));
+  partition.spilled = true;
+  spilled_partitions_++;
   return rc;
 }
 
-Tuple *HashJoinPhysicalOperator::current_tuple() { return &joined_tuple_; }
+RC HashJoinPhysicalOperator::spill_row(
+    unique_ptr<SortRunWriter> &writer, const vector<Value> &keys, const vector<Value> &cells)
+{
+  vector<Value> values;
+  values.reserve(keys.size() + cells.size());
+  values.insert(values.end(), keys.begin(), keys.end());
+  values.insert(values.end(), cells.begin(), cells.end());
+  return writer->write(values);
+}
 
-auto HashJoinPhysicalOperator::build_hash_table() -> RC
+RC HashJoinPhysicalOperator::probe_next()
 {
   RC rc = RC::SUCCESS;
 
-  if (OB_FAIL(rc = left_->open(trx_))) {
-    return rc;
+  bool has_null = false;
+  while (OB_SUCC(rc = right_->next())) {
+    right_tuple_ = right_->current_tuple();
+    if (OB_FAIL(rc = JoinKeyHasher::hash_keys(right_key_exprs_, *right_tuple_, probe_keys_, probe_hash_, has_null))) {
+      LOG_WARN("failed to get join keys of right tuple. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    // 如果是null值，直接跳过
+    if (has_null) {
+      continue;
+    }
+
+    if (!filter_pushed_down_ && !runtime_filter_->may_contain(probe_hash_)) {
+      bloom_filtered_++;
+      continue;
+    }
+
+    const int  index     = partition_of(probe_hash_);
+    Partition &partition = partitions_[index];
+    if (!partition.spilled) {
+      joined_tuple_.set_right(right_tuple_);
+      if (probe(partition.table)) {
+        return RC::SUCCESS;
+      }
+      continue;
+    }
+
+    // 落在落盘分区中的行，等分区读到内存中之后再探测
+    if (partition.probe_writer == nullptr) {
+      string file_name;
+      if (OB_FAIL(rc = create_spill_file("probe", index, file_name))) {
+        return rc;
+      }
+      partition.probe_writer = make_unique<SortRunWriter>();
+      if (OB_FAIL(rc = partition.probe_writer->open(file_name))) {
+        return rc;
+      }
+      partition.probe_run.file_name = file_name;
+    }
+
+    const int cell_num = right_tuple_->cell_num();
+    if (right_specs_.empty() && cell_num > 0) {
+      right_specs_.resize(cell_num);
+      for (int i = 0; i < cell_num; i++) {
+        if (OB_FAIL(rc = right_tuple_->spec_at(i, right_specs_[i]))) {
+          return rc;
+        }
+      }
+    }
+
+    vector<Value> cells(cell_num);
+    for (int i = 0; i < cell_num; i++) {
+      if (OB_FAIL(rc = right_tuple_->cell_at(i, cells[i]))) {
+        return rc;
+      }
+    }
+    if (OB_FAIL(rc = spill_row(partition.probe_writer, probe_keys_, cells))) {
+      LOG_WARN("failed to spill hash join probe row. rc=%s", strrc(rc));
+      return rc;
+    }
   }
+  return rc;
+}
 
+RC HashJoinPhysicalOperator::spilled_next()
+{
+  RC            rc      = RC::SUCCESS;
+  const int     key_num = static_cast<int>(right_key_exprs_.size());
+  vector<Value> values;
   while (true) {
-    rc = left_->next();
-    if (rc != RC::SUCCESS) {
-      if (rc == RC::RECORD_EOF) {
-        break;
+    if (probe_reader_ == nullptr) {
+      if (OB_FAIL(rc = load_next_spilled_partition())) {
+        return rc;
       }
+    }
+
+    rc = probe_reader_->next(values);
+    if (rc == RC::RECORD_EOF) {
+      probe_reader_.reset();
+      partitions_[spilled_partition_].table.clear();
+      continue;
+    }
+    if (OB_FAIL(rc)) {
       return rc;
     }
 
-    left_tuple_ = left_->current_tuple();
-    HashJoinKey left_key;
-    if (OB_FAIL(rc = left_key_exprs_[0]->get_value(*left_tuple_, left_key.key_))) {
+    probe_keys_.assign(values.begin(), values.begin() + key_num);
+    if (OB_FAIL(rc = JoinKeyHasher::hash_keys(probe_keys_.data(), key_num, probe_hash_))) {
       return rc;
     }
+    values.erase(values.begin(), values.begin() + key_num);
+    spilled_probe_tuple_.set_names(right_specs_);
+    spilled_probe_tuple_.set_cells(values);
+    joined_tuple_.set_right(&spilled_probe_tuple_);
+    if (probe(partitions_[spilled_partition_].table)) {
+      return RC::SUCCESS;
+    }
+  }
+}
 
-    // 如果是NULL,不加入hash表
-    if (left_key.key_.is_null()) {
+RC HashJoinPhysicalOperator::load_next_spilled_partition()
+{
+  RC rc = RC::SUCCESS;
+  for (spilled_partition_++; spilled_partition_ < PARTITION_NUM; spilled_partition_++) {
+    Partition &partition = partitions_[spilled_partition_];
+    if (!partition.spilled || partition.probe_writer == nullptr) {
       continue;
     }
 
-    ValueListTuple val_list_tuple;
-    if (OB_FAIL(rc = ValueListTuple::make(*left_tuple_, val_list_tuple))) {
+    if (OB_FAIL(rc = partition.probe_writer->finish(partition.probe_run))) {
+      return rc;
+    }
+    partition.probe_writer.reset();
+    spilled_bytes_ += partition.probe_run.bytes;
+
+    // 分区比内存限制还大时也整个读进来，不再递归分区
+    const int     key_num = static_cast<int>(left_key_exprs_.size());
+    SortRunReader reader(left_specs_);
+    if (OB_FAIL(rc = reader.open(partition.build_run))) {
+      return rc;
+    }
+    vector<Value> values;
+    uint64_t      hash = 0;
+    while (OB_SUCC(rc = reader.next(values))) {
+      if (OB_FAIL(rc = JoinKeyHasher::hash_keys(values.data(), key_num, hash))) {
+        return rc;
+      }
+      partition.table.insert(hash, std::move(values));
+      values.clear();
+    }
+    if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+    partition.table.build();
+
+    probe_reader_ = make_unique<SortRunReader>(right_specs_);
+    if (OB_FAIL(rc = probe_reader_->open(partition.probe_run))) {
       return rc;
     }
-    ht_.insert(left_key, val_list_tuple);
+    return RC::SUCCESS;
   }
+  return RC::RECORD_EOF;
+}
 
-  if (OB_FAIL(rc = left_->close())) {
-    LOG_WARN("failed to close left oper. rc=%s", strrc(rc));
-    return rc;
+bool HashJoinPhysicalOperator::probe(const HashJoinHashTable &table)
+{
+  match_table_ = &table;
+  match_index_ = table.find(probe_hash_, probe_keys_);
+  if (match_index_ == -1) {
+    return false;
+  }
+  left_tuple_.set_cells(table.row_cells(match_index_));
+  return true;
+}
+
+bool HashJoinPhysicalOperator::next_match()
+{
+  if (match_index_ == -1) {
+    return false;
+  }
+
+  match_index_ = match_table_->find_next(match_index_, probe_hash_, probe_keys_);
+  if (match_index_ == -1) {
+    return false;
+  }
+  left_tuple_.set_cells(match_table_->row_cells(match_index_));
+  return true;
+}
+
+void HashJoinPhysicalOperator::push_down_runtime_filter()
+{
+  // 只有探测端直接是表扫描时才下推，否则在探测之前由自己过滤
+  if (right_->type() == PhysicalOperatorType::TABLE_SCAN && build_rows_ > 0) {
+    static_cast<TableScanPhysicalOperator *>(right_)->set_runtime_filter(runtime_filter_.get());
+    filter_pushed_down_ = true;
+  }
+}
+
+RC HashJoinPhysicalOperator::create_spill_file(const char *side, int partition, string &file_name)
+{
+  static atomic<uint64_t> sequence{0};
+
+  error_code ec;
+  filesystem::create_directories(spill_dir_, ec);
+  if (ec) {
+    LOG_WARN("failed to create hash join spill directory. dir=%s, error=%s", spill_dir_.c_str(), ec.message().c_str());
+    return RC::FILE_CREATE;
   }
+
+  file_name = (filesystem::path(spill_dir_) / ("hash_join_" + to_string(getpid()) + "_" + to_string(sequence++) +
+                                                  "_" + side + "_" + to_string(partition) + ".run"))
+                  .string();
   return RC::SUCCESS;
 }
+
+void HashJoinPhysicalOperator::remove_spill_files()
+{
+  for (Partition &partition : partitions_) {
+    partition.build_writer.reset();
+    partition.probe_writer.reset();
+    if (!partition.build_run.file_name.empty()) {
+      PersistHandler().remove_file(partition.build_run.file_name.c_str());
+      partition.build_run = SortRun();
+    }
+    if (!partition.probe_run.file_name.empty()) {
+      PersistHandler().remove_file(partition.probe_run.file_name.c_str());
+      partition.probe_run = SortRun();
+    }
+  }
+}
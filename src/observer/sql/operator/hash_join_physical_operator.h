@@ -10,104 +10,102 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
-#include "common/lang/unordered_map.h"
+#include "sql/operator/external_sorter.h"
+#include "sql/operator/join_runtime_filter.h"
 #include "sql/operator/physical_operator.h"
 #include "sql/parser/parse.h"
 
-struct HashJoinKey
-{
-  // TODO: ValueListtuple may be better
-  Value key_;
-
-  auto operator==(const HashJoinKey &other) const -> bool { return key_ == other.key_; }
-};
-
-namespace std {
-
-/** Implements std::hash on HashJoinKey */
-template <>
-struct hash<HashJoinKey>
-{
-  auto operator()(const HashJoinKey &key) const -> std::size_t
-  {
-    std::size_t ret;
-    RC          rc = Value::hash(key.key_, ret);
-    ASSERT(rc == RC::SUCCESS, "hash failed");
-    return ret;
-  }
-};
-
-}  // namespace std
-
+/**
+ * @brief Hash Join 使用的哈希表
+ * @ingroup PhysicalOperator
+ * @details 所有的行连续地存放在一个数组中，每一行先放连接键，后面跟着这一行所有的列。
+ * 每一行的哈希值在插入时就已经算好，和行号一起记录在 entries_ 中，探测时先比较哈希值再比较连接键。
+ * 所有的行都插入之后再调用 build 建立哈希桶，同一个桶中的行通过 next 串起来，并保持插入的顺序。
+ */
 class HashJoinHashTable
 {
 public:
   HashJoinHashTable() = default;
-  void insert(const HashJoinKey &key, const ValueListTuple &value) { ht_.insert({key, value}); }
 
-  void Remove(const HashJoinKey &key) { ht_.erase(key); }
+  void init(int key_num, int cell_num);
+  void insert(uint64_t hash, const vector<Value> &keys, vector<Value> &&cells);
+  /// @brief 插入一行落盘后读出来的数据，values 中是连接键和所有的列
+  void insert(uint64_t hash, vector<Value> &&values);
+  void build();
+  void clear();
 
-  struct Iterator
-  {
-  public:
-    Iterator() = default;
-    explicit Iterator(std::unordered_multimap<HashJoinKey, ValueListTuple>::iterator iter) : iter_{iter} {}
+  /// @brief 查找连接键相同的第一行，没有时返回-1
+  int find(uint64_t hash, const vector<Value> &keys) const;
+  /// @brief 查找连接键相同的下一行，没有时返回-1
+  int find_next(int index, uint64_t hash, const vector<Value> &keys) const;
 
-    auto key() -> const HashJoinKey & { return iter_->first; }
+  const Value *row_values(int index) const { return &values_[static_cast<size_t>(index) * stride_]; }
+  const Value *row_cells(int index) const { return row_values(index) + key_num_; }
+  uint64_t     row_hash(int index) const { return entries_[index].hash; }
+  int          row_value_num() const { return stride_; }
 
-    auto val() -> ValueListTuple & { return iter_->second; }
+  int     size() const { return static_cast<int>(entries_.size()); }
+  int64_t memory_size() const { return memory_size_; }
 
-    auto operator++() -> Iterator &
-    {
-      ++iter_;
-      return *this;
-    }
-
-    auto operator==(const Iterator &other) -> bool { return this->iter_ == other.iter_; }
-    auto operator!=(const Iterator &other) -> bool { return this->iter_ != other.iter_; }
+private:
+  bool keys_equal(int index, const vector<Value> &keys) const;
 
-  private:
-    std::unordered_multimap<HashJoinKey, ValueListTuple>::iterator iter_;
+private:
+  struct Entry
+  {
+    uint64_t hash;
+    int      next;  ///< 同一个桶中的下一行，-1表示没有
   };
 
-  auto begin() -> Iterator { return Iterator{ht_.begin()}; }
-  auto end() -> Iterator { return Iterator{ht_.end()}; }
+  int key_num_ = 0;
+  int stride_  = 0;  ///< 每一行占用多少个Value
 
-  auto find(const HashJoinKey &key) -> std::pair<Iterator, Iterator>
-  {
-    auto [begin_iter, end_iter] = ht_.equal_range(key);
-    return {Iterator{begin_iter}, Iterator{end_iter}};
-  }
-
-private:
-  unordered_multimap<HashJoinKey, ValueListTuple> ht_;
+  vector<Value> values_;
+  vector<Entry> entries_;
+  vector<int>   buckets_;
+  uint64_t      bucket_mask_ = 0;
+  int64_t       memory_size_ = 0;
 };
 
 /**
  * @brief Hash Join 算子
  * @ingroup PhysicalOperator
+ * @details 左边是构建端，右边是探测端，支持多个等值连接键。
+ * 构建端的行按照哈希值的高位分到 PARTITION_NUM 个分区中，每个分区一个哈希表。
+ * 所有分区占用的内存超过 join_buffer_size 时，把最大的分区写到临时文件中，之后这个分区的行都直接落盘
+ * (hybrid hash join)。探测时，落在内存中分区的行直接探测哈希表，落在落盘分区的行也写到临时文件中。
+ * 探测端读完之后，再依次把每个落盘的分区读到内存中，用对应的探测端文件探测。
+ * 构建完成后还会生成一个布隆过滤器，下推给探测端的表扫描算子，提前过滤掉连接不上的行。
  */
 class HashJoinPhysicalOperator : public PhysicalOperator
 {
 public:
-  HashJoinPhysicalOperator()          = default;
-  virtual ~HashJoinPhysicalOperator() = default;
-
-  string param() const override { 
-    string ret = left_key_exprs_.at(0)->to_string();
-    ret.push_back('=');
-    ret.append(right_key_exprs_.at(0)->to_string());
-    return ret;
-  }
+  static constexpr int     PARTITION_BITS           = 4;
+  static constexpr int     PARTITION_NUM            = 1 << PARTITION_BITS;
+  static constexpr int64_t DEFAULT_JOIN_BUFFER_SIZE = 16 * 1024 * 1024;
+
+public:
+  HashJoinPhysicalOperator(int64_t join_buffer_size = DEFAULT_JOIN_BUFFER_SIZE, const string &spill_dir = "");
+  virtual ~HashJoinPhysicalOperator();
+
+  string param() const override;
+  string runtime_stats() const override;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_JOIN; }
 
   OpType get_op_type() const override { return OpType::INNERHASHJOIN; }
 
+  /// @brief 左边每一行插入哈希表，右边每一行探测一次，另外每个分区的哈希表有固定的初始化代价
   virtual double calculate_cost(
       LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm) override
   {
-    return 0.0;
+    if (child_log_props.size() != 2) {
+      return 0.0;
+    }
+    const double left_card  = child_log_props[0]->get_card();
+    const double right_card = child_log_props[1]->get_card();
+    return cm->hash_cost() * left_card + cm->hash_probe() * right_card +
+           cm->cpu_op() * (PARTITION_NUM + prop->get_card());
   }
 
   RC     open(Trx *trx) override;
@@ -115,25 +113,84 @@ public:
   RC     close() override;
   Tuple *current_tuple() override;
 
+  RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) override;
+
   vector<unique_ptr<Expression>>       &left_key_exprs() { return left_key_exprs_; }
   const vector<unique_ptr<Expression>> &left_key_exprs() const { return left_key_exprs_; }
   vector<unique_ptr<Expression>>       &right_key_exprs() { return right_key_exprs_; }
   const vector<unique_ptr<Expression>> &right_key_exprs() const { return right_key_exprs_; }
 
 private:
-  auto build_hash_table() -> RC;
+  /// @brief 一个分区。落盘之后，构建端和探测端的行分别写到两个临时文件中
+  struct Partition
+  {
+    HashJoinHashTable         table;
+    bool                      spilled = false;
+    unique_ptr<SortRunWriter> build_writer;
+    unique_ptr<SortRunWriter> probe_writer;
+    SortRun                   build_run;
+    SortRun                   probe_run;
+  };
+
+  RC build_hash_table();
+  RC insert_build_row(uint64_t hash, vector<Value> &keys, vector<Value> &&cells);
+  /// @brief 把内存中最大的分区落盘，直到内存不超过限制
+  RC spill_partitions();
+  RC spill_partition(int index);
+  RC spill_row(unique_ptr<SortRunWriter> &writer, const vector<Value> &keys, const vector<Value> &cells);
+
+  /// @brief 从探测端读一行并探测内存中的分区，落在落盘分区中的行写到临时文件里
+  RC probe_next();
+  /// @brief 依次处理落盘的分区
+  RC spilled_next();
+  /// @brief 把下一个落盘的分区读到内存中，没有时返回 RC::RECORD_EOF
+  RC load_next_spilled_partition();
 
+  /// @brief 在哈希表中查找当前探测的行，找到时设置好 joined_tuple_
+  bool probe(const HashJoinHashTable &table);
+  bool next_match();
+
+  void push_down_runtime_filter();
+  RC   create_spill_file(const char *side, int partition, string &file_name);
+  void remove_spill_files();
+
+  static int partition_of(uint64_t hash) { return static_cast<int>(hash >> (64 - PARTITION_BITS)); }
+
+private:
   Trx *trx_ = nullptr;
 
   PhysicalOperator              *left_        = nullptr;
   PhysicalOperator              *right_       = nullptr;
-  Tuple                         *left_tuple_  = nullptr;
   Tuple                         *right_tuple_ = nullptr;
   JoinedTuple                    joined_tuple_;  //! 当前关联的左右两个tuple
   vector<unique_ptr<Expression>> left_key_exprs_;
   vector<unique_ptr<Expression>> right_key_exprs_;
 
-  HashJoinHashTable           ht_;
-  HashJoinHashTable::Iterator begin_iter_;
-  HashJoinHashTable::Iterator end_iter_;
+  int64_t join_buffer_size_ = DEFAULT_JOIN_BUFFER_SIZE;
+  string  spill_dir_;
+
+  vector<TupleCellSpec> left_specs_;
+  vector<TupleCellSpec> right_specs_;
+  vector<Partition>     partitions_;
+  int64_t               memory_usage_ = 0;
+
+  unique_ptr<JoinRuntimeFilter> runtime_filter_;
+  bool                          filter_pushed_down_ = false;
+
+  // 探测的状态
+  bool                      probing_spilled_   = false;  ///< 探测端已经读完，正在处理落盘的分区
+  int                       spilled_partition_ = -1;     ///< 正在处理的落盘分区
+  unique_ptr<SortRunReader> probe_reader_;
+  ValueListTuple            spilled_probe_tuple_;
+  const HashJoinHashTable  *match_table_ = nullptr;
+  int                       match_index_ = -1;
+  uint64_t                  probe_hash_  = 0;
+  vector<Value>             probe_keys_;
+  ValueArrayTuple           left_tuple_;
+
+  // 运行时统计信息
+  int64_t build_rows_         = 0;
+  int64_t spilled_partitions_ = 0;
+  int64_t spilled_bytes_      = 0;
+  int64_t bloom_filtered_     = 0;
 };
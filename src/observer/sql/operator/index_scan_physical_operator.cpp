@@ -109,6 +109,12 @@ Tuple *IndexScanPhysicalOperator::current_tuple()
   return &tuple_;
 }
 
+RC IndexScanPhysicalOperator::related_tables(vector<const Table *> &tables) const
+{
+  tables.push_back(table_);
+  return RC::SUCCESS;
+}
+
 void IndexScanPhysicalOperator::set_predicate(unique_ptr<Expression> &&exprs)
 {
   predicate_ = std::move(exprs);
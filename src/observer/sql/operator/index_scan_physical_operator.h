@@ -40,6 +40,8 @@ public:
 
   Tuple *current_tuple() override;
 
+  RC related_tables(vector<const Table *> &tables) const override;
+
   void set_predicate(unique_ptr<Expression> &&exprs);
 
 private:
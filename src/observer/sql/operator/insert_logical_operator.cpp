@@ -14,5 +14,6 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/insert_logical_operator.h"
 
-InsertLogicalOperator::InsertLogicalOperator(Table *table, vector<Value>&& values) : table_(table), values_(std::move(values))
+InsertLogicalOperator::InsertLogicalOperator(Table *table, vector<Value>&& values, int row_num)
+    : table_(table), values_(std::move(values)), row_num_(row_num)
 {}
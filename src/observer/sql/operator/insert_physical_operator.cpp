@@ -19,22 +19,42 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
-InsertPhysicalOperator::InsertPhysicalOperator(Table *table, vector<Value> &&values)
-    : table_(table), values_(std::move(values))
+InsertPhysicalOperator::InsertPhysicalOperator(Table *table, vector<Value> &&values, int row_num)
+    : table_(table), values_(std::move(values)), row_num_(row_num)
 {}
 
 RC InsertPhysicalOperator::open(Trx *trx)
 {
-  Record record;
-  RC     rc = table_->make_record(static_cast<int>(values_.size()), values_.data(), record);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to make record. rc=%s", strrc(rc));
+  RC rc = RC::SUCCESS;
+  if (row_num_ == 1) {
+    Record record;
+    rc = table_->make_record(static_cast<int>(values_.size()), values_.data(), record);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to make record. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    rc = trx->insert_record(table_, record);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to insert record by transaction. rc=%s", strrc(rc));
+    }
     return rc;
   }
 
-  rc = trx->insert_record(table_, record);
+  // 多行一起插入，存储引擎可以批量写入
+  const int      value_num = static_cast<int>(values_.size()) / row_num_;
+  vector<Record> records(row_num_);
+  for (int i = 0; i < row_num_; i++) {
+    rc = table_->make_record(value_num, values_.data() + i * value_num, records[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to make record. row=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+  }
+
+  rc = trx->insert_records(table_, records);
   if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to insert record by transaction. rc=%s", strrc(rc));
+    LOG_WARN("failed to insert records by transaction. row num=%d, rc=%s", row_num_, strrc(rc));
   }
   return rc;
 }
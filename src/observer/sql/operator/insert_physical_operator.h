@@ -26,7 +26,7 @@ class InsertStmt;
 class InsertPhysicalOperator : public PhysicalOperator
 {
 public:
-  InsertPhysicalOperator(Table *table, vector<Value> &&values);
+  InsertPhysicalOperator(Table *table, vector<Value> &&values, int row_num);
 
   virtual ~InsertPhysicalOperator() = default;
 
@@ -42,5 +42,6 @@ public:
 
 private:
   Table        *table_ = nullptr;
-  vector<Value> values_;
+  vector<Value> values_;  ///< 所有行的值，一行接一行地存放
+  int           row_num_ = 1;
 };
@@ -14,7 +14,9 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/algorithm.h"
 #include "sql/operator/logical_operator.h"
+#include "sql/optimizer/statistics/selectivity.h"
 
 /**
  * @brief 连接算子
@@ -51,8 +53,9 @@ public:
 
     LogicalProperty *left_log_prop  = log_props[0];
     LogicalProperty *right_log_prop = log_props[1];
-    int              card           = left_log_prop->get_card() * right_log_prop->get_card();
-    return make_unique<LogicalProperty>(card);
+    double           card           = left_log_prop->get_card() * right_log_prop->get_card();
+    card *= SelectivityEstimator::estimate(join_predicate_.get());
+    return make_unique<LogicalProperty>(max(1.0, card));
   }
 
   void     set_join_type(JoinType type) { type_ = type; }
@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/join_runtime_filter.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/tuple.h"
+
+using namespace std;
+
+RC JoinKeyHasher::hash_keys(
+    const vector<unique_ptr<Expression>> &key_exprs, const Tuple &tuple, vector<Value> &keys, uint64_t &hash, bool &has_null)
+{
+  RC rc = RC::SUCCESS;
+  keys.resize(key_exprs.size());
+  has_null = false;
+  for (size_t i = 0; i < key_exprs.size(); i++) {
+    if (OB_FAIL(rc = key_exprs[i]->get_value(tuple, keys[i]))) {
+      return rc;
+    }
+    if (keys[i].is_null()) {
+      has_null = true;
+      return rc;
+    }
+  }
+  return hash_keys(keys.data(), static_cast<int>(keys.size()), hash);
+}
+
+RC JoinKeyHasher::hash_keys(const Value *keys, int key_num, uint64_t &hash)
+{
+  uint64_t hash_val = 0;
+  for (int i = 0; i < key_num; i++) {
+    size_t elem_hash = 0;
+    RC     rc        = Value::hash(keys[i], elem_hash);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to hash join key. type=%s, rc=%s", attr_type_to_string(keys[i].attr_type()), strrc(rc));
+      return rc;
+    }
+    // 不能直接异或，否则 (1, 2) 和 (2, 1) 的哈希值相同
+    hash_val ^= elem_hash + 0x9e3779b97f4a7c15 + (hash_val << 6) + (hash_val >> 2);
+  }
+
+  // 整数的std::hash就是它本身，再打散一次，让高位和低位都可以用来分区和分桶
+  hash_val ^= hash_val >> 33;
+  hash_val *= 0xff51afd7ed558ccdULL;
+  hash_val ^= hash_val >> 33;
+  hash_val *= 0xc4ceb9fe1a85ec53ULL;
+  hash_val ^= hash_val >> 33;
+  hash = hash_val;
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void JoinRuntimeFilter::init(int64_t key_num)
+{
+  int64_t bits = MIN_BITS;
+  while (bits < key_num * BITS_PER_KEY && bits < MAX_BITS) {
+    bits <<= 1;
+  }
+  bits_.assign(bits / 64, 0);
+  bit_mask_      = static_cast<uint64_t>(bits - 1);
+  filtered_rows_ = 0;
+}
+
+void JoinRuntimeFilter::add(uint64_t hash)
+{
+  // 使用两个哈希值组合出多个哈希函数
+  const uint64_t delta = (hash >> 32) | 1;
+  for (int i = 0; i < HASH_FUNC_NUM; i++) {
+    const uint64_t bit = hash & bit_mask_;
+    bits_[bit >> 6] |= 1ULL << (bit & 63);
+    hash += delta;
+  }
+}
+
+bool JoinRuntimeFilter::may_contain(uint64_t hash) const
+{
+  const uint64_t delta = (hash >> 32) | 1;
+  for (int i = 0; i < HASH_FUNC_NUM; i++) {
+    const uint64_t bit = hash & bit_mask_;
+    if ((bits_[bit >> 6] & (1ULL << (bit & 63))) == 0) {
+      return false;
+    }
+    hash += delta;
+  }
+  return true;
+}
+
+bool JoinRuntimeFilter::filter(const Tuple &tuple)
+{
+  uint64_t hash     = 0;
+  bool     has_null = false;
+  if (OB_FAIL(JoinKeyHasher::hash_keys(key_exprs_, tuple, keys_, hash, has_null))) {
+    return true;
+  }
+
+  if (has_null || !may_contain(hash)) {
+    filtered_rows_++;
+    return false;
+  }
+  return true;
+}
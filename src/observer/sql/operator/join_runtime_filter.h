@@ -0,0 +1,80 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "common/value.h"
+
+class Expression;
+class Tuple;
+
+/**
+ * @brief 连接键的哈希函数
+ * @ingroup PhysicalOperator
+ * @details Hash Join 的哈希表、分区和运行时过滤器都使用同一个哈希值，这样只需要计算一次。
+ * 哈希值的高位用来选择分区，低位用来选择哈希桶，布隆过滤器使用整个哈希值。
+ */
+class JoinKeyHasher
+{
+public:
+  /**
+   * @brief 计算连接键表达式的值和哈希值
+   * @param has_null 连接键中有NULL时为true，这一行不会和任何行连接上，此时不计算哈希值
+   */
+  static RC hash_keys(const vector<unique_ptr<Expression>> &key_exprs, const Tuple &tuple, vector<Value> &keys,
+      uint64_t &hash, bool &has_null);
+
+  static RC hash_keys(const Value *keys, int key_num, uint64_t &hash);
+};
+
+/**
+ * @brief Hash Join 的运行时过滤器
+ * @ingroup PhysicalOperator
+ * @details 构建端读完之后，用所有连接键的哈希值生成一个布隆过滤器，在探测端读数据之前下推给探测端的表扫描算子。
+ * 表扫描时先用它过滤掉肯定连接不上的行，这些行就不需要再向上传递、探测哈希表或者写到落盘的分区中。
+ * 布隆过滤器可能误判，所以通过过滤的行仍然需要探测哈希表。
+ */
+class JoinRuntimeFilter
+{
+public:
+  static constexpr int     HASH_FUNC_NUM = 3;
+  static constexpr int     BITS_PER_KEY  = 10;
+  static constexpr int64_t MIN_BITS      = 512;
+  static constexpr int64_t MAX_BITS      = 64LL * 1024 * 1024;  ///< 最多使用8M内存
+
+public:
+  explicit JoinRuntimeFilter(const vector<unique_ptr<Expression>> &key_exprs) : key_exprs_(key_exprs) {}
+  ~JoinRuntimeFilter() = default;
+
+  /// @brief 按照构建端的行数初始化位图
+  void init(int64_t key_num);
+  void add(uint64_t hash);
+  bool may_contain(uint64_t hash) const;
+
+  /**
+   * @brief 探测端的一行是否可能连接上
+   * @details 连接键中有NULL的行不会连接上。连接键无法计算时不过滤，交给 Hash Join 处理
+   */
+  bool filter(const Tuple &tuple);
+
+  int64_t filtered_rows() const { return filtered_rows_; }
+
+private:
+  const vector<unique_ptr<Expression>> &key_exprs_;
+
+  vector<uint64_t> bits_;
+  uint64_t         bit_mask_ = 0;
+
+  vector<Value> keys_;  ///< 计算连接键时复用，避免每行都分配内存
+  int64_t       filtered_rows_ = 0;
+};
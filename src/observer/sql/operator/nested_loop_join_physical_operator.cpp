@@ -13,8 +13,25 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/nested_loop_join_physical_operator.h"
+#include "common/lang/atomic.h"
+#include "common/lang/filesystem.h"
 
-NestedLoopJoinPhysicalOperator::NestedLoopJoinPhysicalOperator() {}
+#include <unistd.h>
+
+using namespace std;
+
+NestedLoopJoinPhysicalOperator::NestedLoopJoinPhysicalOperator(int64_t join_buffer_size, const string &spill_dir)
+    : join_buffer_size_(join_buffer_size),
+      spill_dir_(spill_dir.empty() ? filesystem::temp_directory_path().string() : spill_dir)
+{}
+
+NestedLoopJoinPhysicalOperator::~NestedLoopJoinPhysicalOperator() { remove_spill_file(); }
+
+string NestedLoopJoinPhysicalOperator::runtime_stats() const
+{
+  return "join_buffer_size=" + to_string(join_buffer_size_) + ", inner_rows=" + to_string(right_rows_) +
+         ", inner_spilled_bytes=" + to_string(spilled_bytes_) + ", left_blocks=" + to_string(left_blocks_);
+}
 
 RC NestedLoopJoinPhysicalOperator::open(Trx *trx)
 {
@@ -23,130 +40,324 @@ RC NestedLoopJoinPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
-  RC rc         = RC::SUCCESS;
-  left_         = children_[0].get();
-  right_        = children_[1].get();
-  right_closed_ = true;
-  round_done_   = true;
+  left_  = children_[0].get();
+  right_ = children_[1].get();
+  trx_   = trx;
 
-  rc   = left_->open(trx);
-  trx_ = trx;
-  return rc;
+  // 执行计划可能被计划缓存复用，需要重置上一次执行的状态
+  remove_spill_file();
+  left_tuple_   = nullptr;
+  right_ready_  = false;
+  right_opened_ = false;
+  right_specs_.clear();
+  right_values_.clear();
+  right_rows_   = 0;
+  right_memory_ = 0;
+  right_index_  = 0;
+  left_specs_.clear();
+  block_values_.clear();
+  block_rows_    = 0;
+  block_index_   = 0;
+  left_pending_  = false;
+  left_eof_      = false;
+  left_blocks_   = 0;
+  spilled_bytes_ = 0;
+
+  return left_->open(trx);
 }
 
 RC NestedLoopJoinPhysicalOperator::next()
 {
-  RC   left_rc             = RC::SUCCESS;
-  RC   right_rc             = RC::SUCCESS;
   RC rc = RC::SUCCESS;
-
-  // first left next
-  if (left_tuple_ == nullptr) {
-    if (OB_FAIL(left_rc = left_->next())) {
-      return left_rc;
+  if (!right_ready_) {
+    // 左表是空的时候不需要读右表
+    if (OB_FAIL(rc = left_->next())) {
+      return rc;
     }
-    left_tuple_ = left_->current_tuple();
-    if (OB_FAIL(right_rc = right_->open(trx_))) {
-      return right_rc;
+    left_tuple_   = left_->current_tuple();
+    left_pending_ = true;
+
+    if (OB_FAIL(rc = materialize_right())) {
+      return rc;
     }
   }
 
-  while (true) {
-    right_rc = right_->next();
-    if (right_rc != RC::SUCCESS && right_rc != RC::RECORD_EOF) {
-      return right_rc;
+  if (right_rows_ == 0) {
+    return RC::RECORD_EOF;
+  }
+
+  if (right_run_.file_name.empty()) {
+    return memory_next();
+  }
+  return block_next();
+}
+
+RC NestedLoopJoinPhysicalOperator::close()
+{
+  RC rc = left_->close();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to close left oper. rc=%s", strrc(rc));
+  }
+
+  // 右表在读完之后就已经关闭了，只有读的过程中出错时才需要关闭
+  if (right_opened_) {
+    right_opened_ = false;
+    RC right_rc   = right_->close();
+    if (right_rc != RC::SUCCESS) {
+      LOG_WARN("failed to close right oper. rc=%s", strrc(right_rc));
     }
+  }
 
-    while (right_rc == RC::RECORD_EOF) {
-      if (OB_FAIL(right_rc = right_->close())) {
-        return right_rc;
-      }
+  remove_spill_file();
+  right_values_.clear();
+  block_values_.clear();
+  return rc;
+}
 
-      left_rc = left_->next();
-      if (left_rc != RC::SUCCESS) { // record_eof or error
-        return left_rc;
-      }
-      left_tuple_ = left_->current_tuple();
+Tuple *NestedLoopJoinPhysicalOperator::current_tuple() { return &joined_tuple_; }
+
+RC NestedLoopJoinPhysicalOperator::materialize_right()
+{
+  RC rc = right_->open(trx_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open right oper. rc=%s", strrc(rc));
+    return rc;
+  }
+  right_opened_ = true;
 
-      if (OB_FAIL(right_rc = right_->open(trx_))) {
-        return right_rc;
+  vector<Value> row;
+  while (OB_SUCC(rc = right_->next())) {
+    Tuple *tuple = right_->current_tuple();
+    if (right_writer_ == nullptr) {
+      if (OB_FAIL(rc = copy_tuple(*tuple, right_specs_, right_values_, right_memory_))) {
+        return rc;
       }
-      right_rc = right_->next();
-      if (right_rc != RC::SUCCESS && right_rc != RC::RECORD_EOF) {
-        return right_rc;
+      right_rows_++;
+      if (right_memory_ > join_buffer_size_ && OB_FAIL(rc = spill_right())) {
+        return rc;
       }
+      continue;
     }
-    right_tuple_ = right_->current_tuple();
-    joined_tuple_.set_left(left_tuple_);
-    joined_tuple_.set_right(right_tuple_);
 
-    bool filter_result;
-    rc = filter(joined_tuple_, filter_result);
-    if (rc != RC::SUCCESS) {
-      LOG_TRACE("Joined tuple filtered failed=%s", strrc(rc));
+    row.clear();
+    int64_t memory = 0;
+    if (OB_FAIL(rc = copy_tuple(*tuple, right_specs_, row, memory))) {
       return rc;
     }
+    if (OB_FAIL(rc = right_writer_->write(row))) {
+      LOG_WARN("failed to spill right row of nested loop join. rc=%s", strrc(rc));
+      return rc;
+    }
+    right_rows_++;
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read right oper. rc=%s", strrc(rc));
+    return rc;
+  }
 
-    if (filter_result) {
-      return RC::SUCCESS;
+  if (right_writer_ != nullptr) {
+    if (OB_FAIL(rc = right_writer_->finish(right_run_))) {
+      return rc;
     }
+    right_writer_.reset();
+    spilled_bytes_ = right_run_.bytes;
+  }
+
+  right_ready_  = true;
+  right_opened_ = false;
+  if (OB_FAIL(rc = right_->close())) {
+    LOG_WARN("failed to close right oper. rc=%s", strrc(rc));
+    return rc;
   }
+
+  LOG_TRACE("nested loop join inner side is ready. rows=%ld, memory=%ld, spilled bytes=%ld",
+      right_rows_, right_memory_, spilled_bytes_);
+  right_tuple_.set_specs(&right_specs_);
+  return RC::SUCCESS;
 }
 
-RC NestedLoopJoinPhysicalOperator::close()
+RC NestedLoopJoinPhysicalOperator::spill_right()
 {
-  RC rc = left_->close();
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to close left oper. rc=%s", strrc(rc));
+  static atomic<uint64_t> sequence{0};
+
+  error_code ec;
+  filesystem::create_directories(spill_dir_, ec);
+  if (ec) {
+    LOG_WARN("failed to create nested loop join spill directory. dir=%s, error=%s",
+        spill_dir_.c_str(), ec.message().c_str());
+    return RC::FILE_CREATE;
+  }
+
+  const string file_name =
+      (filesystem::path(spill_dir_) / ("nested_loop_join_" + to_string(getpid()) + "_" + to_string(sequence++) + ".run"))
+          .string();
+
+  right_writer_ = make_unique<SortRunWriter>();
+  RC rc         = right_writer_->open(file_name);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  right_run_.file_name = file_name;
+
+  const size_t  stride = right_specs_.size();
+  vector<Value> row(stride);
+  for (size_t offset = 0; offset < right_values_.size(); offset += stride) {
+    row.assign(right_values_.begin() + offset, right_values_.begin() + offset + stride);
+    if (OB_FAIL(rc = right_writer_->write(row))) {
+      LOG_WARN("failed to spill right rows of nested loop join. rc=%s", strrc(rc));
+      return rc;
+    }
   }
+
+  LOG_TRACE("spill nested loop join inner side. rows=%ld, memory=%ld", right_rows_, right_memory_);
+  right_values_.clear();
+  right_values_.shrink_to_fit();
+  right_memory_ = 0;
   return rc;
 }
- 
-Tuple *NestedLoopJoinPhysicalOperator::current_tuple() { return &joined_tuple_; }
 
-RC NestedLoopJoinPhysicalOperator::left_next()
+RC NestedLoopJoinPhysicalOperator::memory_next()
 {
-  RC rc = RC::SUCCESS;
-  rc = left_->next();
-  if (rc != RC::SUCCESS) { // record_eof or error
-    return rc;
+  RC           rc     = RC::SUCCESS;
+  const size_t stride = right_specs_.size();
+  while (true) {
+    if (left_pending_) {
+      left_pending_ = false;
+      right_index_  = 0;
+      joined_tuple_.set_left(left_tuple_);
+    }
+
+    while (right_index_ < right_rows_) {
+      right_tuple_.set_cells(&right_values_[right_index_ * stride]);
+      right_index_++;
+      joined_tuple_.set_right(&right_tuple_);
+
+      bool filter_result = false;
+      if (OB_FAIL(rc = filter(joined_tuple_, filter_result))) {
+        LOG_TRACE("Joined tuple filtered failed=%s", strrc(rc));
+        return rc;
+      }
+      if (filter_result) {
+        return RC::SUCCESS;
+      }
+    }
+
+    if (OB_FAIL(rc = left_->next())) {  // record_eof or error
+      return rc;
+    }
+    left_tuple_   = left_->current_tuple();
+    left_pending_ = true;
+  }
+}
+
+RC NestedLoopJoinPhysicalOperator::block_next()
+{
+  RC           rc     = RC::SUCCESS;
+  const size_t stride = left_specs_.size();
+  while (true) {
+    if (right_reader_ == nullptr) {
+      if (OB_FAIL(rc = load_left_block())) {  // record_eof or error
+        return rc;
+      }
+    }
+
+    if (block_index_ >= block_rows_) {
+      rc = right_reader_->next(spilled_right_row_);
+      if (rc == RC::RECORD_EOF) {
+        right_reader_.reset();
+        continue;
+      }
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      right_tuple_.set_cells(spilled_right_row_.data());
+      joined_tuple_.set_right(&right_tuple_);
+      block_index_ = 0;
+    }
+
+    while (block_index_ < block_rows_) {
+      block_tuple_.set_cells(&block_values_[block_index_ * stride]);
+      block_index_++;
+
+      bool filter_result = false;
+      if (OB_FAIL(rc = filter(joined_tuple_, filter_result))) {
+        LOG_TRACE("Joined tuple filtered failed=%s", strrc(rc));
+        return rc;
+      }
+      if (filter_result) {
+        return RC::SUCCESS;
+      }
+    }
   }
-  left_tuple_ = left_->current_tuple();
-  return rc;
 }
 
-RC NestedLoopJoinPhysicalOperator::right_next()
+RC NestedLoopJoinPhysicalOperator::load_left_block()
 {
   RC rc = RC::SUCCESS;
-  if (round_done_) {
-    if (!right_closed_) {
-      rc = right_->close();
+  block_values_.clear();
+  block_rows_  = 0;
+  block_index_ = 0;
 
-      right_closed_ = true;
-      if (rc != RC::SUCCESS) {
+  int64_t memory = 0;
+  while (memory < join_buffer_size_) {
+    if (!left_pending_) {
+      if (left_eof_) {
+        break;
+      }
+      rc = left_->next();
+      if (rc == RC::RECORD_EOF) {
+        left_eof_ = true;
+        break;
+      }
+      if (OB_FAIL(rc)) {
         return rc;
       }
+      left_tuple_ = left_->current_tuple();
     }
 
-    rc = right_->open(trx_);
-    if (rc != RC::SUCCESS) {
+    left_pending_ = false;
+    if (OB_FAIL(rc = copy_tuple(*left_tuple_, left_specs_, block_values_, memory))) {
       return rc;
     }
-    right_closed_ = false;
+    block_rows_++;
+  }
 
-    round_done_ = false;
+  if (block_rows_ == 0) {
+    return RC::RECORD_EOF;
   }
 
-  rc = right_->next();
-  if (rc != RC::SUCCESS) {
-    if (rc == RC::RECORD_EOF) {
-      round_done_ = true;
+  // 一批左表的行对应读一遍右表
+  left_blocks_++;
+  block_index_ = block_rows_;
+  block_tuple_.set_specs(&left_specs_);
+  joined_tuple_.set_left(&block_tuple_);
+
+  right_reader_ = make_unique<SortRunReader>(right_specs_);
+  return right_reader_->open(right_run_);
+}
+
+RC NestedLoopJoinPhysicalOperator::copy_tuple(
+    const Tuple &tuple, vector<TupleCellSpec> &specs, vector<Value> &values, int64_t &memory)
+{
+  RC        rc       = RC::SUCCESS;
+  const int cell_num = tuple.cell_num();
+  if (specs.empty() && cell_num > 0) {
+    specs.resize(cell_num);
+    for (int i = 0; i < cell_num; i++) {
+      if (OB_FAIL(rc = tuple.spec_at(i, specs[i]))) {
+        return rc;
+      }
     }
-    return rc;
   }
 
-  right_tuple_ = right_->current_tuple();
-  joined_tuple_.set_right(right_tuple_);
+  for (int i = 0; i < cell_num; i++) {
+    Value value;
+    if (OB_FAIL(rc = tuple.cell_at(i, value))) {
+      return rc;
+    }
+    memory += value.memory_size();
+    values.emplace_back(std::move(value));
+  }
   return rc;
 }
 
@@ -173,3 +384,22 @@ RC NestedLoopJoinPhysicalOperator::filter(const JoinedTuple &tuple, bool &result
   result = true;
   return rc;
 }
+
+void NestedLoopJoinPhysicalOperator::remove_spill_file()
+{
+  right_reader_.reset();
+  right_writer_.reset();
+  if (!right_run_.file_name.empty()) {
+    PersistHandler().remove_file(right_run_.file_name.c_str());
+    right_run_ = SortRun();
+  }
+}
+
+RC NestedLoopJoinPhysicalOperator::iterate_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  RC rc = RC::SUCCESS;
+  if (join_predicate_ != nullptr && OB_FAIL(rc = callback(join_predicate_))) {
+    return rc;
+  }
+  return iterate_children_expressions(callback);
+}
@@ -14,32 +14,48 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "sql/operator/external_sorter.h"
 #include "sql/operator/physical_operator.h"
 #include "sql/parser/parse.h"
 
 /**
  * @brief 最简单的两表（称为左表、右表）join算子
- * @details 依次遍历左表的每一行，然后关联右表的每一行
+ * @details 右表只会读一遍，读出来的行紧凑地缓存在内存中，然后依次遍历左表的每一行，关联缓存的右表的每一行，
+ * 不需要对每一行左表都重新打开右表，再做一遍过滤和可见性判断。
+ * 右表超过 join_buffer_size 时，把右表写到临时文件中，改为 block nested loop：
+ * 每次缓存 join_buffer_size 大小的一批左表的行，读一遍右表的临时文件，关联这一批左表的行。
+ * 这样读右表的次数从左表的行数减少到左表的批数。
  * @ingroup PhysicalOperator
  */
 class NestedLoopJoinPhysicalOperator : public PhysicalOperator
 {
 public:
-  NestedLoopJoinPhysicalOperator();
-  virtual ~NestedLoopJoinPhysicalOperator() = default;
+  static constexpr int64_t DEFAULT_JOIN_BUFFER_SIZE = 16 * 1024 * 1024;
+
+public:
+  NestedLoopJoinPhysicalOperator(int64_t join_buffer_size = DEFAULT_JOIN_BUFFER_SIZE, const string &spill_dir = "");
+  virtual ~NestedLoopJoinPhysicalOperator();
 
   string param() const override { 
     return join_predicate_ == nullptr ? "" : join_predicate_->to_string();
   }
 
+  string runtime_stats() const override;
+
   PhysicalOperatorType type() const override { return PhysicalOperatorType::NESTED_LOOP_JOIN; }
 
   OpType get_op_type() const override { return OpType::INNERNLJOIN; }
 
+  /// @brief 左右两边的每一对行都要计算一次连接条件
   virtual double calculate_cost(
       LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm) override
   {
-    return 0.0;
+    if (child_log_props.size() != 2) {
+      return 0.0;
+    }
+    const double left_card  = child_log_props[0]->get_card();
+    const double right_card = child_log_props[1]->get_card();
+    return cm->cpu_op() * (left_card * right_card + prop->get_card());
   }
 
   RC     open(Trx *trx) override;
@@ -51,10 +67,23 @@ public:
 
   unique_ptr<Expression>& join_predicate() { return join_predicate_; }
 
+  RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) override;
+
 private:
-  RC left_next();   //! 左表遍历下一条数据
-  RC right_next();  //! 右表遍历下一条数据，如果上一轮结束了就重新开始新的一轮
+  /// @brief 读出右表所有的行，超过内存限制时写到临时文件中
+  RC materialize_right();
+  /// @brief 右表缓存在内存中时，左表一行一行地关联
+  RC memory_next();
+  /// @brief 右表落盘时，左表一批一批地关联
+  RC block_next();
+  /// @brief 读入下一批左表的行并重新打开右表的临时文件，左表读完时返回 RC::RECORD_EOF
+  RC load_left_block();
+  /// @brief 把已经缓存的右表的行写到临时文件中，之后的行也直接写到文件里
+  RC spill_right();
   RC filter(const JoinedTuple &tuple, bool &result);
+  void remove_spill_file();
+
+  static RC copy_tuple(const Tuple &tuple, vector<TupleCellSpec> &specs, vector<Value> &values, int64_t &memory);
 
 private:
   Trx *trx_ = nullptr;
@@ -63,9 +92,36 @@ private:
   PhysicalOperator *left_        = nullptr;
   PhysicalOperator *right_       = nullptr;
   Tuple            *left_tuple_  = nullptr;
-  Tuple            *right_tuple_ = nullptr;
-  JoinedTuple       joined_tuple_;         //! 当前关联的左右两个tuple
-  bool              round_done_   = true;  //! 右表遍历的一轮是否结束
-  bool              right_closed_ = true;  //! 右表算子是否已经关闭
+  JoinedTuple       joined_tuple_;  //! 当前关联的左右两个tuple
   unique_ptr<Expression> join_predicate_ = nullptr;
+
+  int64_t join_buffer_size_ = DEFAULT_JOIN_BUFFER_SIZE;
+  string  spill_dir_;
+
+  // 缓存的右表
+  bool                      right_ready_  = false;  //! 右表是否已经读完
+  bool                      right_opened_ = false;
+  vector<TupleCellSpec>     right_specs_;
+  vector<Value>             right_values_;  //! 所有行的数据连续存放
+  int64_t                   right_rows_   = 0;
+  int64_t                   right_memory_ = 0;
+  int64_t                   right_index_  = 0;  //! 下一个要关联的右表的行
+  ValueArrayTuple           right_tuple_;
+  unique_ptr<SortRunWriter> right_writer_;
+  SortRun                   right_run_;  //! 右表落盘后的临时文件，为空表示没有落盘
+
+  // 右表落盘后使用的左表的批
+  vector<TupleCellSpec>     left_specs_;
+  vector<Value>             block_values_;
+  int64_t                   block_rows_  = 0;
+  int64_t                   block_index_ = 0;  //! 下一个要关联的左表的行
+  ValueArrayTuple           block_tuple_;
+  bool                      left_pending_ = false;  //! 当前的左表的行还没有放到批中
+  bool                      left_eof_     = false;
+  unique_ptr<SortRunReader> right_reader_;
+  vector<Value>             spilled_right_row_;  //! 从临时文件中读出来的右表的行
+
+  // 运行时统计信息
+  int64_t left_blocks_   = 0;
+  int64_t spilled_bytes_ = 0;
 };
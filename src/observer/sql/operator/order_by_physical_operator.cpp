@@ -1,4 +1,6 @@
 #include "sql/operator/order_by_physical_operator.h"
+#include "common/lang/filesystem.h"
+#include "sql/operator/external_sorter.h"
 #include "sql/operator/physical_operator.h"
 
 void TopNHeap::insert(const SortEntry &sort_entry)
@@ -93,8 +95,23 @@ void TopNHeap::sink_down()
   }
 }
 
+OrderByPhysicalOperator::OrderByPhysicalOperator(
+    vector<unique_ptr<OrderBy>> orderbys, int limit, int64_t sort_buffer_size, const string &spill_dir)
+    : orderbys_(std::move(orderbys)),
+      comp_(orderbys_),
+      limit_(limit),
+      sort_buffer_size_(sort_buffer_size),
+      spill_dir_(spill_dir.empty() ? filesystem::temp_directory_path().string() : spill_dir)
+{}
+
+OrderByPhysicalOperator::~OrderByPhysicalOperator() = default;
+
 RC OrderByPhysicalOperator::open(Trx *trx)
 {
+  sort_entries_.clear();
+  sorter_.reset();
+  current_entry_ = nullptr;
+
   if (limit_ == -1) {
     return non_limit_open(trx);
   }
@@ -122,6 +139,14 @@ RC OrderByPhysicalOperator::next()
    *     return RC::RECORD_EOF;
    *   }
    *   return RC::SUCCESS; */
+  if (sorter_) {
+    RC rc = sorter_->next(current_entry_);
+    if (OB_FAIL(rc)) {
+      current_entry_ = nullptr;
+    }
+    return rc;
+  }
+
   if (first_emit_) {
     first_emit_ = false;
     if (iter_ == sort_entries_.size()) {
@@ -137,15 +162,34 @@ RC OrderByPhysicalOperator::next()
   return RC::SUCCESS;
 }
 
-RC OrderByPhysicalOperator::close() { return RC::SUCCESS; }
+RC OrderByPhysicalOperator::close()
+{
+  // 删除落盘的临时文件
+  sorter_.reset();
+  current_entry_ = nullptr;
+  sort_entries_.clear();
+  return RC::SUCCESS;
+}
 
 Tuple *OrderByPhysicalOperator::current_tuple()
 {
   /* size_t id = ids_[iter_];
    * return &tuples_.at(id); */
+  if (sorter_) {
+    return current_entry_ == nullptr ? nullptr : &current_entry_->tuple();
+  }
   return &sort_entries_.at(iter_).tuple();
 }
 
+string OrderByPhysicalOperator::runtime_stats() const
+{
+  if (limit_ != -1) {
+    return "";
+  }
+  return "sort_buffer_size=" + to_string(sort_buffer_size_) + ", spilled_runs=" + to_string(spilled_runs_) +
+         ", spilled_bytes=" + to_string(spilled_bytes_) + ", merge_passes=" + to_string(merge_passes_);
+}
+
 RC OrderByPhysicalOperator::limit_open(Trx *trx)
 {
 
@@ -219,6 +263,7 @@ RC OrderByPhysicalOperator::non_limit_open(Trx *trx)
     return rc;
   }
 
+  sorter_ = make_unique<ExternalSorter>(orderbys_, sort_buffer_size_, spill_dir_);
   while (OB_SUCC(rc = child.next())) {
     Tuple *child_tuple = child.current_tuple();
     if (nullptr == child_tuple) {
@@ -228,16 +273,11 @@ RC OrderByPhysicalOperator::non_limit_open(Trx *trx)
 
     ValueListTuple value_list_tuple;
     ValueListTuple::make(*child_tuple, value_list_tuple);
-
-    vector<Value> sort_key;
-    for (auto &orderby : orderbys_) {
-      Value val;
-      if (OB_FAIL(orderby->expr->get_value(value_list_tuple, val))) {
-        return rc;
-      }
-      sort_key.push_back(val);
+    if (OB_FAIL(rc = sorter_->add(std::move(value_list_tuple)))) {
+      LOG_WARN("failed to add tuple to sorter. rc=%s", strrc(rc));
+      child.close();
+      return rc;
     }
-    sort_entries_.emplace_back(std::move(sort_key), std::move(value_list_tuple));
   }
 
   if (RC::RECORD_EOF == rc) {
@@ -254,10 +294,15 @@ RC OrderByPhysicalOperator::non_limit_open(Trx *trx)
     return rc;
   }
 
-  std::sort(sort_entries_.begin(), sort_entries_.end(), comp_);
-  iter_       = 0;
-  first_emit_ = true;
+  rc = sorter_->finish();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sort tuples. rc=%s", strrc(rc));
+    return rc;
+  }
 
+  spilled_runs_  = sorter_->spilled_runs();
+  spilled_bytes_ = sorter_->spilled_bytes();
+  merge_passes_  = sorter_->merge_passes();
   return RC::SUCCESS;
 }
 
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 class SortEntry
 {
 public:
+  SortEntry() = default;
   SortEntry(const vector<Value> &keys, const ValueListTuple &tuple) : keys_(keys), tuple_(tuple) {}
   SortEntry(vector<Value> &&keys, ValueListTuple &&tuple) : keys_(std::move(keys)), tuple_(std::move(tuple)) {}
 
@@ -136,18 +137,24 @@ private:
   vector<SortEntry> heap_;
 };
 
+class ExternalSorter;
+
 /**
  * @brief Order By
  * @ingroup PhysicalOperator
+ * @details 带limit时使用堆排序只保留前limit行。否则使用 ExternalSorter 在限定的内存中排序，
+ * 内存不够时会把数据落盘，内存大小由会话变量 sort_buffer_size 控制。
  */
 class OrderByPhysicalOperator : public PhysicalOperator
 {
 public:
-  OrderByPhysicalOperator(vector<unique_ptr<OrderBy>> orderbys, int limit = -1)
-      : orderbys_(std::move(orderbys)), comp_(orderbys_), limit_(limit)
-  {}
+  static constexpr int64_t DEFAULT_SORT_BUFFER_SIZE = 16 * 1024 * 1024;
+
+public:
+  OrderByPhysicalOperator(vector<unique_ptr<OrderBy>> orderbys, int limit = -1,
+      int64_t sort_buffer_size = DEFAULT_SORT_BUFFER_SIZE, const string &spill_dir = "");
 
-  virtual ~OrderByPhysicalOperator() = default;
+  virtual ~OrderByPhysicalOperator();
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::ORDER_BY; }
   OpType               get_op_type() const override { return OpType::ORDERBY; }
@@ -158,6 +165,8 @@ public:
 
   Tuple *current_tuple() override;
 
+  string runtime_stats() const override;
+
 private:
   RC limit_open(Trx *trx);
   RC non_limit_open(Trx *trx);
@@ -172,4 +181,12 @@ private:
   size_t            iter_;
   bool              first_emit_;
   int               limit_ = -1;
+
+  int64_t                    sort_buffer_size_ = DEFAULT_SORT_BUFFER_SIZE;
+  string                     spill_dir_;  ///< 排序数据落盘时临时文件存放的目录
+  unique_ptr<ExternalSorter> sorter_;
+  SortEntry                 *current_entry_ = nullptr;
+  int64_t                    spilled_runs_  = 0;
+  int64_t                    spilled_bytes_ = 0;
+  int                        merge_passes_  = 0;
 };
@@ -46,3 +46,25 @@ string physical_operator_type_name(PhysicalOperatorType type)
 string PhysicalOperator::name() const { return physical_operator_type_name(type()); }
 
 string PhysicalOperator::param() const { return ""; }
+
+RC PhysicalOperator::related_tables(vector<const Table *> &tables) const
+{
+  RC rc = RC::SUCCESS;
+  for (const unique_ptr<PhysicalOperator> &child : children_) {
+    if (OB_FAIL(rc = child->related_tables(tables))) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC PhysicalOperator::iterate_children_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  RC rc = RC::SUCCESS;
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    if (OB_FAIL(rc = child->iterate_expressions(callback))) {
+      return rc;
+    }
+  }
+  return rc;
+}
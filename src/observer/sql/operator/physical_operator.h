@@ -15,10 +15,12 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/sys/rc.h"
+#include "common/lang/functional.h"
 #include "sql/expr/tuple.h"
 #include "sql/operator/operator_node.h"
 
 class Record;
+class Table;
 class TupleCellSpec;
 class Trx;
 
@@ -77,6 +79,12 @@ public:
   virtual string name() const;
   virtual string param() const;
 
+  /**
+   * @brief 算子执行过程中的统计信息，比如排序落盘的数据量
+   * @details EXPLAIN ANALYZE 执行完查询之后输出。没有统计信息的算子返回空字符串
+   */
+  virtual string runtime_stats() const { return ""; }
+
   bool is_physical() const override { return true; }
   bool is_logical() const override { return false; }
 
@@ -91,6 +99,20 @@ public:
 
   virtual RC tuple_schema(TupleSchema &schema) const { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 遍历当前算子以及所有子算子中的表达式
+   * @details 计划缓存使用这个接口找到执行计划中的常量并替换。
+   * 没有实现这个接口的算子返回 RC::UNIMPLEMENTED，包含这类算子的执行计划不会被缓存。
+   */
+  virtual RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) { return RC::UNIMPLEMENTED; }
+
+  /**
+   * @brief 收集执行计划中访问的所有表
+   * @details 查询缓存使用这个接口记录查询结果依赖的表。默认只收集子算子中的表，
+   * 直接访问表的算子或者带有子查询的算子需要重写这个接口。
+   */
+  virtual RC related_tables(vector<const Table *> &tables) const;
+
   void add_child(unique_ptr<PhysicalOperator> oper) { children_.emplace_back(std::move(oper)); }
 
   void set_env_tuple(const Tuple* env_tuple) {
@@ -102,6 +124,9 @@ public:
 
   vector<unique_ptr<PhysicalOperator>> &children() { return children_; }
 
+protected:
+  RC iterate_children_expressions(function<RC(unique_ptr<Expression> &)> callback);
+
 protected:
   vector<unique_ptr<PhysicalOperator>> children_;
   const Tuple* env_tuple_{nullptr};
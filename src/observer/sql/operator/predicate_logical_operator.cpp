@@ -13,8 +13,21 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/predicate_logical_operator.h"
+#include "common/lang/algorithm.h"
+#include "sql/optimizer/statistics/selectivity.h"
 
 PredicateLogicalOperator::PredicateLogicalOperator(unique_ptr<Expression> expression, std::vector<SubQueryExpr*> subqueries) {
   expressions_.emplace_back(std::move(expression));
   subqueries_ = subqueries;
 }
+
+unique_ptr<LogicalProperty> PredicateLogicalOperator::find_log_prop(const vector<LogicalProperty *> &log_props)
+{
+  if (log_props.size() != 1 || log_props[0] == nullptr) {
+    return nullptr;
+  }
+
+  const Expression *predicate = expressions_.empty() ? nullptr : expressions_.front().get();
+  const double      card      = log_props[0]->get_card() * SelectivityEstimator::estimate(predicate);
+  return make_unique<LogicalProperty>(max(1.0, card));
+}
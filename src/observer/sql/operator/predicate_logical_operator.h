@@ -34,6 +34,9 @@ public:
   LogicalOperatorType type() const override { return LogicalOperatorType::PREDICATE; }
 
   OpType get_op_type() const override { return OpType::LOGICALFILTER; }
+
+  unique_ptr<LogicalProperty> find_log_prop(const vector<LogicalProperty *> &log_props) override;
+
 private:
   std::vector<SubQueryExpr*> subqueries_;
 };
@@ -235,6 +235,32 @@ Tuple *PredicatePhysicalOperator::current_tuple()
 
 RC PredicatePhysicalOperator::tuple_schema(TupleSchema &schema) const { return children_.back()->tuple_schema(schema); }
 
+RC PredicatePhysicalOperator::iterate_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  // 子查询的执行计划挂在表达式上，暂不支持遍历
+  if (!subqueries_.empty()) {
+    return RC::UNIMPLEMENTED;
+  }
+
+  RC rc = callback(expression_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return iterate_children_expressions(callback);
+}
+
+RC PredicatePhysicalOperator::related_tables(vector<const Table *> &tables) const
+{
+  RC rc = RC::SUCCESS;
+  for (SubQueryExpr *subquery : subqueries_) {
+    const unique_ptr<PhysicalOperator> &subquery_oper = subquery->physical_oper();
+    if (subquery_oper != nullptr && OB_FAIL(rc = subquery_oper->related_tables(tables))) {
+      return rc;
+    }
+  }
+  return PhysicalOperator::related_tables(tables);
+}
+
 RC PredicatePhysicalOperator::open_correlated_subquery(Tuple *env_tuple)
 {
   RC rc = RC::SUCCESS;
@@ -43,6 +43,10 @@ public:
 
   RC tuple_schema(TupleSchema &schema) const override;
 
+  RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) override;
+
+  RC related_tables(vector<const Table *> &tables) const override;
+
   void add_subquery(SubQueryExpr* subquery) {
     subqueries_.push_back(subquery);
   }
@@ -24,7 +24,7 @@ ProjectLogicalOperator::ProjectLogicalOperator(vector<unique_ptr<Expression>> &&
 
 unique_ptr<LogicalProperty> ProjectLogicalOperator::find_log_prop(const vector<LogicalProperty*> &log_props)
 {
-  int card = 0;
+  double card = 0;
   for (auto log_prop : log_props) {
     if (log_prop != nullptr) {
       card += log_prop->get_card();
@@ -47,6 +47,8 @@ public:
 
   RC tuple_schema(TupleSchema &schema) const override;
 
+  RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) override;
+
   vector<unique_ptr<Expression>>&& expressions() { return std::move(expressions_); }
 
 private:
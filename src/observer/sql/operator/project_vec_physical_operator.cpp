@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/project_vec_physical_operator.h"
 #include "common/log/log.h"
+#include "sql/expr/expression_iterator.h"
 #include "storage/record/record.h"
 #include "storage/table/table.h"
 
@@ -71,3 +72,14 @@ RC ProjectVecPhysicalOperator::tuple_schema(TupleSchema &schema) const
   }
   return RC::SUCCESS;
 }
+
+RC ProjectVecPhysicalOperator::iterate_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  // 输出列的名字取自SQL原文，投影中的常量被替换后列名就不对了
+  for (unique_ptr<Expression> &expression : expressions_) {
+    if (ExpressionIterator::has_param(*expression)) {
+      return RC::UNIMPLEMENTED;
+    }
+  }
+  return iterate_children_expressions(callback);
+}
@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/table_get_logical_operator.h"
 #include "sql/optimizer/cascade/property.h"
 #include "catalog/catalog.h"
+#include "common/lang/algorithm.h"
+#include "sql/optimizer/statistics/selectivity.h"
 
 TableGetLogicalOperator::TableGetLogicalOperator(Table *table, ReadWriteMode mode)
     : LogicalOperator(), table_(table), table_ref_name_(table->name()), mode_(mode)
@@ -31,7 +33,8 @@ void TableGetLogicalOperator::set_predicate(unique_ptr<Expression> &&exprs)
 
 unique_ptr<LogicalProperty> TableGetLogicalOperator::find_log_prop(const vector<LogicalProperty*> &log_props)
 {
-  int card = Catalog::get_instance().get_table_stats(table_->table_id()).row_nums;
-  // TODO: think about predicates.
+  const double rows = Catalog::get_instance().get_table_stats(table_->table_id()).row_nums;
+  // 至少保留一行，否则后面的算子代价都是0，无法比较
+  const double card = max(1.0, rows * SelectivityEstimator::estimate(predicate_.get()));
   return make_unique<LogicalProperty>(card);
 }
@@ -37,6 +37,7 @@ public:
   {
     uint64_t hash = std::hash<int>()(static_cast<int>(get_op_type()));
     hash ^= std::hash<int>()(table_->table_id());
+    hash ^= std::hash<string>()(table_ref_name_);
     return hash;
   }
 
@@ -47,6 +48,9 @@ public:
     const auto &other_get = dynamic_cast<const TableGetLogicalOperator *>(&other);
     if (table_->table_id() != other_get->table()->table_id())
       return false;
+    // 自连接时同一张表的两个别名是不同的数据源
+    if (table_ref_name_ != other_get->table_ref_name())
+      return false;
     return true;
   }
 
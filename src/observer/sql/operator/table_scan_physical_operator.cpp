@@ -14,21 +14,50 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_scan_physical_operator.h"
 #include "event/sql_debug.h"
+#include "catalog/catalog.h"
+#include "common/lang/algorithm.h"
+#include "sql/optimizer/cascade/cost_model.h"
 #include "storage/table/table.h"
 
 using namespace std;
 
+double TableScanPhysicalOperator::calculate_cost(
+    LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm)
+{
+  const double rows = Catalog::get_instance().get_table_stats(table_->table_id()).row_nums;
+  return (cm->io() + cm->cpu_op()) * max(rows, prop->get_card());
+}
+
 RC TableScanPhysicalOperator::open(Trx *trx)
 {
   RC rc = table_->get_record_scanner(record_scanner_, trx, mode_);
   if (rc == RC::SUCCESS) {
     // tuple_.set_schema(table_, table_->table_meta().field_metas());
     tuple_.set_schema(table_, table_->table_meta().field_metas(), table_ref_name_);
+    push_down_predicate();
   }
   trx_ = trx;
   return rc;
 }
 
+void TableScanPhysicalOperator::push_down_predicate()
+{
+  predicate_pushed_down_ = false;
+  residual_predicates_.clear();
+  if (predicate_ == nullptr) {
+    return;
+  }
+
+  RC rc = scan_filter_.init(*table_, table_ref_name_.c_str(), predicate_.get(), residual_predicates_);
+  if (OB_SUCC(rc) && !scan_filter_.empty()) {
+    rc = record_scanner_->set_condition_filter(&scan_filter_);
+  }
+  predicate_pushed_down_ = OB_SUCC(rc) && !scan_filter_.empty();
+  if (!predicate_pushed_down_) {
+    residual_predicates_.clear();
+  }
+}
+
 RC TableScanPhysicalOperator::next()
 {
   RC rc = RC::SUCCESS;
@@ -44,6 +73,10 @@ RC TableScanPhysicalOperator::next()
       return rc;
     }
 
+    if (filter_result && runtime_filter_ != nullptr) {
+      filter_result = runtime_filter_->filter(tuple_);
+    }
+
     if (filter_result) {
       sql_debug("get a tuple: %s", tuple_.to_string().c_str());
       break;
@@ -68,6 +101,20 @@ RC TableScanPhysicalOperator::close() {
 
 }
 
+RC TableScanPhysicalOperator::iterate_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  if (predicate_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  return callback(predicate_);
+}
+
+RC TableScanPhysicalOperator::related_tables(vector<const Table *> &tables) const
+{
+  tables.push_back(table_);
+  return RC::SUCCESS;
+}
+
 Tuple *TableScanPhysicalOperator::current_tuple()
 {
   tuple_.set_record(&current_record_);
@@ -98,6 +145,22 @@ RC TableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
   RC    rc = RC::SUCCESS;
   Value value;
 
+  // 下推的条件存储层已经计算过了，只需要计算剩下的
+  if (predicate_pushed_down_) {
+    for (Expression *expr : residual_predicates_) {
+      rc = expr->get_value(tuple, value);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (!value.get_boolean()) {
+        result = false;
+        return rc;
+      }
+    }
+    result = true;
+    return rc;
+  }
+
   rc = predicate_->get_value(tuple, value);
   if (rc != RC::SUCCESS) {
     return rc;
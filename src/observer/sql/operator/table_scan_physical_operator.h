@@ -15,7 +15,9 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/sys/rc.h"
+#include "sql/operator/join_runtime_filter.h"
 #include "sql/operator/physical_operator.h"
+#include "storage/common/condition_filter.h"
 #include "storage/record/record_manager.h"
 #include "storage/record/record_scanner.h"
 #include "common/types.h"
@@ -46,6 +48,7 @@ public:
   {
     uint64_t hash = std::hash<int>()(static_cast<int>(get_op_type()));
     hash ^= std::hash<int>()(table_->table_id());
+    hash ^= std::hash<string>()(table_ref_name_);
     return hash;
   }
 
@@ -56,13 +59,13 @@ public:
     const auto &other_get = dynamic_cast<const TableScanPhysicalOperator *>(&other);
     if (table_->table_id() != other_get->table_id())
       return false;
+    if (table_ref_name_ != other_get->table_ref_name_)
+      return false;
     return true;
   }
 
-  double calculate_cost(LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm) override
-  {
-    return (cm->io() + cm->cpu_op()) * prop->get_card();
-  }
+  /// @brief 不管过滤之后剩下多少行，都要把整张表读一遍
+  double calculate_cost(LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm) override;
 
   RC open(Trx *trx) override;
   RC next() override;
@@ -70,12 +73,28 @@ public:
 
   Tuple *current_tuple() override;
 
+  RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) override;
+
+  RC related_tables(vector<const Table *> &tables) const override;
+
   int table_id() const { return table_->table_id(); }
 
   // void set_predicates(vector<unique_ptr<Expression>> &&exprs);
   void set_predicate(unique_ptr<Expression> &&exprs);
 
+  /**
+   * @brief 设置 Hash Join 下推的运行时过滤器
+   * @details 过滤器属于 Hash Join 算子，在它关闭时会清除
+   */
+  void set_runtime_filter(JoinRuntimeFilter *runtime_filter) { runtime_filter_ = runtime_filter; }
+
 private:
+  /**
+   * @brief 把过滤条件中能下推的部分交给存储层，在扫描页面时批量计算
+   * @details 计划缓存复用执行计划时，条件中的常量可能会变，所以每次 open 都要重新生成
+   */
+  void push_down_predicate();
+
   RC filter(RowTuple &tuple, bool &result);
 
 private:
@@ -83,10 +102,14 @@ private:
   string         table_ref_name_;
   Trx           *trx_  = nullptr;
   ReadWriteMode  mode_ = ReadWriteMode::READ_WRITE;
-  RecordScanner *record_scanner_;
+  RecordScanner *record_scanner_ = nullptr;
   Record         current_record_;
   RowTuple       tuple_;
   JoinedTuple    joined_tuple_;
   // vector<unique_ptr<Expression>> predicates_;  // TODO chang predicate to table tuple filter
   unique_ptr<Expression> predicate_;  // TODO chang predicate to table tuple filter
+  ScanConditionFilter    scan_filter_;                ///< 下推到存储层的过滤条件
+  vector<Expression *>   residual_predicates_;        ///< 没有下推的过滤条件，指向 predicate_ 中的表达式
+  bool                   predicate_pushed_down_ = false;
+  JoinRuntimeFilter     *runtime_filter_        = nullptr;
 };
@@ -9,11 +9,44 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_scan_vec_physical_operator.h"
+#include "common/lang/algorithm.h"
 #include "event/sql_debug.h"
+#include "sql/expr/expression_iterator.h"
 #include "storage/table/table.h"
 
 using namespace std;
 
+namespace {
+
+/**
+ * @brief 收集表达式中引用的 table 的字段在页面中的列号
+ * @return 表达式中有无法分析的部分时返回 UNIMPLEMENTED
+ */
+RC collect_columns(const Table *table, Expression &expr, vector<int> &col_ids)
+{
+  switch (expr.type()) {
+    case ExprType::TABLE_FIELD: {
+      const Field &field = static_cast<TableFieldExpr &>(expr).field();
+      if (field.table() == table) {
+        col_ids.push_back(table->table_meta().unvisible_field_num() + field.meta()->field_id());
+      }
+      return RC::SUCCESS;
+    }
+    case ExprType::VALUE: return RC::SUCCESS;
+    case ExprType::CAST:
+    case ExprType::COMPARISON:
+    case ExprType::CONJUNCTION:
+    case ExprType::ARITHMETIC:
+    case ExprType::AGGREGATION:
+    case ExprType::VECTOR_FUNC:
+      return ExpressionIterator::iterate_child_expr(
+          expr, [table, &col_ids](unique_ptr<Expression> &child) { return collect_columns(table, *child, col_ids); });
+    default: return RC::UNIMPLEMENTED;
+  }
+}
+
+}  // namespace
+
 RC TableScanVecPhysicalOperator::open(Trx *trx)
 {
   RC rc = table_->get_chunk_scanner(chunk_scanner_, trx, mode_);
@@ -21,47 +54,95 @@ RC TableScanVecPhysicalOperator::open(Trx *trx)
     LOG_WARN("failed to get chunk scanner", strrc(rc));
     return rc;
   }
-  // TODO: don't need to fetch all columns from record manager
-  for (int i = 0; i < table_->table_meta().field_num(); ++i) {
-    all_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
-    filterd_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
+
+  // 能下推的过滤条件交给存储层在扫描页面时计算。计划缓存复用时常量可能会变，每次都重新生成
+  predicate_pushed_down_ = false;
+  residual_predicates_.clear();
+  if (predicate_ != nullptr &&
+      OB_SUCC(scan_filter_.init(*table_, table_->name(), predicate_.get(), residual_predicates_)) &&
+      !scan_filter_.empty()) {
+    chunk_scanner_.set_condition_filter(&scan_filter_);
+    predicate_pushed_down_ = true;
+  } else {
+    residual_predicates_.clear();
   }
+
+  prepare_columns();
   return rc;
 }
 
+void TableScanVecPhysicalOperator::prepare_columns()
+{
+  // chunk 中的列号是字段在页面中的列号，事务字段和null位图这些不可见的字段排在用户字段的前面
+  const TableMeta &table_meta = table_->table_meta();
+
+  vector<int> col_ids;
+  bool        all_columns = !has_projection_;
+  if (!all_columns) {
+    col_ids = projection_;
+
+    vector<Expression *> filter_exprs = residual_predicates_;
+    if (!predicate_pushed_down_ && predicate_ != nullptr) {
+      filter_exprs.push_back(predicate_.get());
+    }
+    for (Expression *expr : filter_exprs) {
+      if (OB_FAIL(collect_columns(table_, *expr, col_ids))) {
+        all_columns = true;
+        break;
+      }
+    }
+  }
+
+  if (all_columns) {
+    col_ids.clear();
+    for (int i = table_meta.unvisible_field_num(); i < table_meta.field_num(); ++i) {
+      col_ids.push_back(i);
+    }
+  }
+  // 比如 count(*) 不需要任何列，但是需要通过一列得到行数
+  if (col_ids.empty()) {
+    col_ids.push_back(table_meta.unvisible_field_num());
+  }
+  sort(col_ids.begin(), col_ids.end());
+  col_ids.erase(unique(col_ids.begin(), col_ids.end()), col_ids.end());
+
+  // 执行计划可能被计划缓存复用，列没有变化时不要重新创建
+  bool same_columns = all_columns_.column_num() == static_cast<int>(col_ids.size());
+  for (size_t i = 0; same_columns && i < col_ids.size(); i++) {
+    same_columns = all_columns_.column_ids(i) == col_ids[i];
+  }
+  if (same_columns) {
+    return;
+  }
+
+  all_columns_.reset();
+  for (int col_id : col_ids) {
+    all_columns_.add_column(make_unique<Column>(*table_meta.field(col_id)), col_id);
+  }
+}
+
 RC TableScanVecPhysicalOperator::next(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
 
   all_columns_.reset_data();
-  filterd_columns_.reset_data();
-  if (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
+  if (OB_FAIL(rc = chunk_scanner_.next_chunk(all_columns_))) {
+    return rc;
+  }
+
+  // 过滤之后不移动数据，只记录剩下哪些行，需要紧凑数据的算子再去拷贝
+  if (predicate_ != nullptr && !(predicate_pushed_down_ && residual_predicates_.empty())) {
     select_.assign(all_columns_.rows(), 1);
-    // if (predicates_.empty()) {
-    if (predicate_ == nullptr) {
-      chunk.reference(all_columns_);
-    } else {
-      rc = filter(all_columns_);
-      if (rc != RC::SUCCESS) {
-        LOG_TRACE("filtered failed=%s", strrc(rc));
-        return rc;
-      }
-      // TODO: if all setted, it doesn't need to set one by one
-      for (int i = 0; i < all_columns_.rows(); i++) {
-        if (select_[i] == 0) {
-          continue;
-        }
-        for (int j = 0; j < all_columns_.column_num(); j++) {
-          filterd_columns_.column(j).append_one(
-              (char *)all_columns_.column(filterd_columns_.column_ids(j)).get_value(i).data());
-        }
-      }
-      chunk.reference(filterd_columns_);
+    rc = filter(all_columns_);
+    if (rc != RC::SUCCESS) {
+      LOG_TRACE("filtered failed=%s", strrc(rc));
+      return rc;
+    }
+    if (find(select_.begin(), select_.end(), 0) != select_.end()) {
+      all_columns_.set_selection(select_);
     }
   }
-  return rc;
+  return chunk.reference(all_columns_);
 }
 
 RC TableScanVecPhysicalOperator::close() { return chunk_scanner_.close_scan(); }
@@ -70,9 +151,45 @@ string TableScanVecPhysicalOperator::param() const { return table_->name(); }
 
 void TableScanVecPhysicalOperator::set_predicate(unique_ptr<Expression> &&exprs) { predicate_ = std::move(exprs); }
 
+void TableScanVecPhysicalOperator::set_projection(const vector<Expression *> &expressions)
+{
+  projection_.clear();
+  has_projection_ = true;
+  for (Expression *expr : expressions) {
+    if (OB_FAIL(collect_columns(table_, *expr, projection_))) {
+      has_projection_ = false;
+      projection_.clear();
+      return;
+    }
+  }
+}
+
+RC TableScanVecPhysicalOperator::iterate_expressions(function<RC(unique_ptr<Expression> &)> callback)
+{
+  if (predicate_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  return callback(predicate_);
+}
+
+RC TableScanVecPhysicalOperator::related_tables(vector<const Table *> &tables) const
+{
+  tables.push_back(table_);
+  return RC::SUCCESS;
+}
+
 RC TableScanVecPhysicalOperator::filter(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
+  if (predicate_pushed_down_) {
+    for (Expression *expr : residual_predicates_) {
+      if (OB_FAIL(rc = expr->eval(chunk, select_))) {
+        return rc;
+      }
+    }
+    return rc;
+  }
+
   rc = predicate_->eval(chunk, select_);
   if (rc != RC::SUCCESS) {
     return rc;
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/sys/rc.h"
 #include "sql/operator/physical_operator.h"
+#include "storage/common/condition_filter.h"
 #include "storage/record/record_manager.h"
 #include "common/types.h"
 
@@ -38,15 +39,34 @@ public:
 
   void set_predicate(unique_ptr<Expression> &&exprs);
 
+  /**
+   * @brief 设置上层算子用到的表达式，只读取这些表达式引用的列
+   * @details 没有设置或者表达式中有无法分析的部分时读取所有的列
+   */
+  void set_projection(const vector<Expression *> &expressions);
+
+  RC iterate_expressions(function<RC(unique_ptr<Expression> &)> callback) override;
+
+  RC related_tables(vector<const Table *> &tables) const override;
+
 private:
+  /**
+   * @brief 计算需要从页面中读取哪些列：上层算子用到的列加上过滤时用到的列
+   */
+  void prepare_columns();
+
   RC filter(Chunk &chunk);
 
 private:
   Table                 *table_ = nullptr;
   ReadWriteMode          mode_  = ReadWriteMode::READ_WRITE;
   ChunkFileScanner       chunk_scanner_;
-  Chunk                  all_columns_;
-  Chunk                  filterd_columns_;
+  Chunk                  all_columns_;  ///< 从页面中读取的列，过滤之后通过选择向量标记剩下的行
   vector<uint8_t>        select_;
   unique_ptr<Expression> predicate_;
+  ScanConditionFilter    scan_filter_;                  ///< 下推到存储层的过滤条件
+  vector<Expression *>   residual_predicates_;          ///< 没有下推的过滤条件，指向 predicate_ 中的表达式
+  bool                   predicate_pushed_down_ = false;
+  bool                   has_projection_        = false;
+  vector<int>            projection_;                   ///< 上层算子用到的列在页面中的列号
 };
@@ -38,3 +38,9 @@ RC VectorIndexScanPhysicalOperator::next()
 RC VectorIndexScanPhysicalOperator::close() { return RC::SUCCESS; }
 
 Tuple *VectorIndexScanPhysicalOperator::current_tuple() { return &tuple_; }
+
+RC VectorIndexScanPhysicalOperator::related_tables(vector<const Table *> &tables) const
+{
+  tables.push_back(table_);
+  return RC::SUCCESS;
+}
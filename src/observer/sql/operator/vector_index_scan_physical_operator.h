@@ -28,6 +28,8 @@ public:
 
   Tuple *current_tuple() override;
 
+  RC related_tables(vector<const Table *> &tables) const override;
+
 private:
   RC filter(RowTuple &tuple, bool &result);
 
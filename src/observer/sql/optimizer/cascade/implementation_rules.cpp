@@ -27,6 +27,10 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/group_by_logical_operator.h"
 #include "sql/operator/scalar_group_by_physical_operator.h"
 #include "sql/operator/hash_group_by_physical_operator.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/nested_loop_join_physical_operator.h"
+#include "sql/operator/hash_join_physical_operator.h"
+#include "sql/optimizer/physical_plan_generator.h"
 
 // -------------------------------------------------------------------------------------------------
 // PhysicalSeqScan
@@ -42,11 +46,13 @@ void LogicalGetToPhysicalSeqScan::transform(OperatorNode* input,
   TableGetLogicalOperator* table_get_oper = dynamic_cast<TableGetLogicalOperator*>(input);
 
   unique_ptr<Expression> &log_pred = table_get_oper->predicate();
-  unique_ptr<Expression> phys_pred(log_pred->copy());
 
   Table *table = table_get_oper->table();
-  auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper->read_write_mode());
-  table_scan_oper->set_predicate(std::move(phys_pred));
+  auto table_scan_oper = new TableScanPhysicalOperator(
+      table, table_get_oper->table_ref_name(), table_get_oper->read_write_mode());
+  if (log_pred != nullptr) {
+    table_scan_oper->set_predicate(log_pred->copy());
+  }
   auto oper = unique_ptr<OperatorNode>(table_scan_oper);
 
   transformed->emplace_back(std::move(oper));
@@ -95,7 +101,7 @@ void LogicalInsertToInsert::transform(OperatorNode* input,
 
   Table                  *table           = insert_oper->table();
   vector<Value>          &values          = insert_oper->values();
-  auto insert_phy_oper = make_unique<InsertPhysicalOperator>(table, std::move(values));
+  auto insert_phy_oper = make_unique<InsertPhysicalOperator>(table, std::move(values), insert_oper->row_num());
 
   transformed->emplace_back(std::move(insert_phy_oper));
 }
@@ -116,7 +122,7 @@ void LogicalExplainToExplain::transform(OperatorNode* input,
                          OptimizerContext *context) const
 {
   auto explain_oper = dynamic_cast<ExplainLogicalOperator*>(input);
-  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator());
+  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator(explain_oper->analyze()));
   for (auto &child : explain_oper->children()) {
     explain_physical_oper->add_general_child(child.get());
   }
@@ -196,6 +202,68 @@ void LogicalPredicateToPredicate::transform(OperatorNode* input,
   transformed->emplace_back(std::move(oper));
 }
 
+// -------------------------------------------------------------------------------------------------
+// Physical Nested Loop Join
+// -------------------------------------------------------------------------------------------------
+LogicalInnerJoinToNestedLoopJoin::LogicalInnerJoinToNestedLoopJoin()
+{
+  type_ = RuleType::INNER_JOIN_TO_NL_JOIN;
+  match_pattern_ = unique_ptr<Pattern>(new Pattern(OpType::LOGICALINNERJOIN));
+  match_pattern_->add_child(new Pattern(OpType::LEAF));
+  match_pattern_->add_child(new Pattern(OpType::LEAF));
+}
+
+void LogicalInnerJoinToNestedLoopJoin::transform(OperatorNode* input,
+                         std::vector<std::unique_ptr<OperatorNode>> *transformed,
+                         OptimizerContext *context) const
+{
+  auto join_oper = dynamic_cast<JoinLogicalOperator*>(input);
+
+  // 同一个逻辑连接还会生成 Hash Join，所以这里拷贝连接条件
+  auto join_phys_oper = make_unique<NestedLoopJoinPhysicalOperator>();
+  if (join_oper->join_predicate() != nullptr) {
+    join_phys_oper->set_join_predicate(join_oper->join_predicate()->copy());
+  }
+  for (auto &child : join_oper->children()) {
+    join_phys_oper->add_general_child(child.get());
+  }
+
+  transformed->emplace_back(std::move(join_phys_oper));
+}
+
+// -------------------------------------------------------------------------------------------------
+// Physical Hash Join
+// -------------------------------------------------------------------------------------------------
+LogicalInnerJoinToHashJoin::LogicalInnerJoinToHashJoin()
+{
+  type_ = RuleType::INNER_JOIN_TO_HASH_JOIN;
+  match_pattern_ = unique_ptr<Pattern>(new Pattern(OpType::LOGICALINNERJOIN));
+  match_pattern_->add_child(new Pattern(OpType::LEAF));
+  match_pattern_->add_child(new Pattern(OpType::LEAF));
+}
+
+void LogicalInnerJoinToHashJoin::transform(OperatorNode* input,
+                         std::vector<std::unique_ptr<OperatorNode>> *transformed,
+                         OptimizerContext *context) const
+{
+  auto join_oper = dynamic_cast<JoinLogicalOperator*>(input);
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  if (!PhysicalPlanGenerator::split_hash_join_keys(*join_oper, left_keys, right_keys)) {
+    return;
+  }
+
+  auto join_phys_oper = make_unique<HashJoinPhysicalOperator>();
+  join_phys_oper->left_key_exprs()  = std::move(left_keys);
+  join_phys_oper->right_key_exprs() = std::move(right_keys);
+  for (auto &child : join_oper->children()) {
+    join_phys_oper->add_general_child(child.get());
+  }
+
+  transformed->emplace_back(std::move(join_phys_oper));
+}
+
 // -------------------------------------------------------------------------------------------------
 // Physical Aggregation
 // -------------------------------------------------------------------------------------------------
@@ -19,12 +19,12 @@ class Property
 class LogicalProperty
 {
 public:
-  explicit LogicalProperty(int card) : card_(card) {}
+  explicit LogicalProperty(double card) : card_(card) {}
   LogicalProperty()  = default;
   ~LogicalProperty() = default;
 
-  int get_card() const { return card_; }
+  double get_card() const { return card_; }
 
 private:
-  int card_ = 0;  /// cardinality
+  double card_ = 0;  /// cardinality, estimated by table statistics and predicate selectivity
 };
\ No newline at end of file
@@ -41,6 +41,11 @@ void OptimizeInputs::perform()
       push_task(new OptimizeInputs(this));
       push_task(new OptimizeGroup(child_group, context_));
       return;
+    } else {
+      // child group has been optimized but no physical expression can implement it,
+      // so current group expr can not be implemented either
+      LOG_INFO("child group %d has no winner", child_group->get_id());
+      return;
     }
   }
 
@@ -304,7 +304,8 @@ RC LogicalPlanGenerator::create_plan(InsertStmt *insert_stmt, unique_ptr<Logical
   // vector<Value> values(insert_stmt->values(), insert_stmt->values() + insert_stmt->value_amount());
 
   // InsertLogicalOperator *insert_operator = new InsertLogicalOperator(table, values);
-  InsertLogicalOperator *insert_operator = new InsertLogicalOperator(table, std::move(insert_stmt->values()));
+  InsertLogicalOperator *insert_operator =
+      new InsertLogicalOperator(table, std::move(insert_stmt->values()), insert_stmt->row_num());
   logical_operator.reset(insert_operator);
   return RC::SUCCESS;
 }
@@ -347,7 +348,7 @@ RC LogicalPlanGenerator::create_plan(ExplainStmt *explain_stmt, unique_ptr<Logic
     return rc;
   }
 
-  logical_operator = unique_ptr<LogicalOperator>(new ExplainLogicalOperator);
+  logical_operator = unique_ptr<LogicalOperator>(new ExplainLogicalOperator(explain_stmt->analyze()));
   logical_operator->add_child(std::move(child_oper));
   return rc;
 }
@@ -10,7 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/optimizer/optimizer_utils.h"
 
-string OptimizerUtils::dump_physical_plan(const unique_ptr<PhysicalOperator>& children)
+string OptimizerUtils::dump_physical_plan(const unique_ptr<PhysicalOperator>& children, bool with_runtime_stats)
 {
   std::function<void(ostream &, PhysicalOperator *, int, bool, vector<uint8_t> &)> to_string = [&](
     ostream &os, PhysicalOperator *oper, int level, bool last_child, vector<uint8_t> &ends)
@@ -36,6 +36,12 @@ string OptimizerUtils::dump_physical_plan(const unique_ptr<PhysicalOperator>& ch
     if (!param.empty()) {
       os << "(" << param << ")";
     }
+    if (with_runtime_stats) {
+      string stats = oper->runtime_stats();
+      if (!stats.empty()) {
+        os << " [" << stats << "]";
+      }
+    }
     os << '\n';
 
     if (static_cast<int>(ends.size()) < level + 2) {
@@ -17,5 +17,9 @@ See the Mulan PSL v2 for more details. */
 class OptimizerUtils
 {
 public:
-  static string dump_physical_plan(const unique_ptr<PhysicalOperator> &root);
+  /**
+   * @brief 把物理执行计划输出成字符串
+   * @param with_runtime_stats 是否输出算子执行时的统计信息(PhysicalOperator::runtime_stats)，EXPLAIN ANALYZE 使用
+   */
+  static string dump_physical_plan(const unique_ptr<PhysicalOperator> &root, bool with_runtime_stats = false);
 };
\ No newline at end of file
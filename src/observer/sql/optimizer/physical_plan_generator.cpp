@@ -15,7 +15,11 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "sql/expr/expression.h"
 #include "session/session.h"
+#include "common/lang/filesystem.h"
+#include "common/lang/unordered_set.h"
+#include "storage/db/db.h"
 #include "storage/index/index.h"
+#include "sql/expr/expression_iterator.h"
 #include "sql/expr/subquery_expression.h"
 #include "sql/operator/aggregate_vec_physical_operator.h"
 #include "sql/operator/calc_logical_operator.h"
@@ -53,6 +57,95 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
+namespace {
+
+/**
+ * @brief 连接条件中的表达式引用了哪一边的表
+ */
+enum class JoinSide
+{
+  NONE,     ///< 没有引用任何表，比如常量
+  LEFT,     ///< 只引用了左边的表
+  RIGHT,    ///< 只引用了右边的表
+  UNKNOWN,  ///< 两边都引用了，或者无法判断
+};
+
+/// @brief 排序、Hash Join 等算子落盘时，临时文件放在当前数据库目录下
+string spill_directory(Session *session)
+{
+  Db *db = session->get_current_db();
+  return db == nullptr ? "" : (filesystem::path(db->path()) / "tmp").string();
+}
+
+void collect_table_refs(LogicalOperator &oper, unordered_set<string> &refs)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    refs.insert(static_cast<TableGetLogicalOperator &>(oper).table_ref_name());
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_table_refs(*child, refs);
+  }
+}
+
+JoinSide join_side_of(Expression &expr, const unordered_set<string> &left_refs, const unordered_set<string> &right_refs)
+{
+  switch (expr.type()) {
+    case ExprType::VALUE: return JoinSide::NONE;
+    case ExprType::TABLE_FIELD: {
+      const string ref_name = static_cast<TableFieldExpr &>(expr).table_alias_name();
+      const bool   in_left  = left_refs.count(ref_name) > 0;
+      const bool   in_right = right_refs.count(ref_name) > 0;
+      if (in_left == in_right) {
+        return JoinSide::UNKNOWN;
+      }
+      return in_left ? JoinSide::LEFT : JoinSide::RIGHT;
+    }
+    case ExprType::CAST:
+    case ExprType::ARITHMETIC: break;
+    default: return JoinSide::UNKNOWN;
+  }
+
+  JoinSide side = JoinSide::NONE;
+  ExpressionIterator::iterate_child_expr(expr, [&](unique_ptr<Expression> &child) {
+    const JoinSide child_side = join_side_of(*child, left_refs, right_refs);
+    if (side == JoinSide::NONE) {
+      side = child_side;
+    } else if (child_side != JoinSide::NONE && child_side != side) {
+      side = JoinSide::UNKNOWN;
+    }
+    return RC::SUCCESS;
+  });
+  return side;
+}
+
+bool can_eval_on(JoinSide side, JoinSide target) { return side == JoinSide::NONE || side == target; }
+
+/**
+ * @brief 收集使用AND连接的所有等值比较
+ * @return 连接条件中有等值比较以外的条件时返回false
+ */
+bool collect_equal_conditions(unique_ptr<Expression> &expr, vector<ComparisonExpr *> &conditions)
+{
+  if (expr->type() == ExprType::COMPARISON) {
+    auto comp_expr = static_cast<ComparisonExpr *>(expr.get());
+    if (comp_expr->comp() != CompOp::EQUAL_TO) {
+      return false;
+    }
+    conditions.push_back(comp_expr);
+    return true;
+  }
+
+  if (expr->type() == ExprType::CONJUNCTION) {
+    auto conjunction_expr = static_cast<ConjunctionExpr *>(expr.get());
+    return conjunction_expr->conjunction_type() == ConjunctionExpr::Type::AND &&
+           collect_equal_conditions(conjunction_expr->left(), conditions) &&
+           collect_equal_conditions(conjunction_expr->right(), conditions);
+  }
+  return false;
+}
+
+}  // namespace
+
 RC PhysicalPlanGenerator::create(
     LogicalOperator &logical_operator, unique_ptr<PhysicalOperator> &oper, Session *session)
 {
@@ -278,7 +371,7 @@ RC PhysicalPlanGenerator::create_plan(
 {
   Table                  *table           = insert_oper.table();
   vector<Value>          &values          = insert_oper.values();
-  InsertPhysicalOperator *insert_phy_oper = new InsertPhysicalOperator(table, std::move(values));
+  InsertPhysicalOperator *insert_phy_oper = new InsertPhysicalOperator(table, std::move(values), insert_oper.row_num());
   oper.reset(insert_phy_oper);
   return RC::SUCCESS;
 }
@@ -316,7 +409,7 @@ RC PhysicalPlanGenerator::create_plan(
 
   RC rc = RC::SUCCESS;
 
-  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator);
+  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator(explain_oper.analyze()));
   for (unique_ptr<LogicalOperator> &child_oper : child_opers) {
     unique_ptr<PhysicalOperator> child_physical_oper;
     rc = create(*child_oper, child_physical_oper, session);
@@ -342,10 +435,12 @@ RC PhysicalPlanGenerator::create_plan(
     LOG_WARN("join operator should have 2 children, but have %d", child_opers.size());
     return RC::INTERNAL;
   }
-  // if (session->hash_join_on() && can_use_hash_join(join_oper)) {
-  if (can_use_hash_join(join_oper)) {
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  if (split_hash_join_keys(join_oper, left_keys, right_keys)) {
     LOG_TRACE("use hash join");
-    HashJoinPhysicalOperator *join_physical_oper = new HashJoinPhysicalOperator();
+    HashJoinPhysicalOperator *join_physical_oper =
+        new HashJoinPhysicalOperator(session->join_buffer_size(), spill_directory(session));
     for (auto &child_oper : child_opers) {
       unique_ptr<PhysicalOperator> child_physical_oper;
       rc = create(*child_oper, child_physical_oper, session);
@@ -355,21 +450,14 @@ RC PhysicalPlanGenerator::create_plan(
       }
       join_physical_oper->add_child(std::move(child_physical_oper));
     }
-
-    auto &join_predicate = join_oper.join_predicate();
-    if (join_predicate->type() == ExprType::COMPARISON) {
-      auto comp_expr = static_cast<ComparisonExpr *>(join_predicate.get());
-      join_physical_oper->left_key_exprs().emplace_back(std::move(comp_expr->left()));
-      join_physical_oper->right_key_exprs().emplace_back(std::move(comp_expr->right()));
-    } else {
-      delete join_physical_oper;
-      return RC::UNIMPLEMENTED;
-    }
+    join_physical_oper->left_key_exprs()  = std::move(left_keys);
+    join_physical_oper->right_key_exprs() = std::move(right_keys);
 
     oper.reset(join_physical_oper);
   } else {
     LOG_TRACE("use nlj join");
-    NestedLoopJoinPhysicalOperator *join_physical_oper = new NestedLoopJoinPhysicalOperator();
+    NestedLoopJoinPhysicalOperator *join_physical_oper =
+        new NestedLoopJoinPhysicalOperator(session->join_buffer_size(), spill_directory(session));
 
     for (auto &child_oper : child_opers) {
       unique_ptr<PhysicalOperator> child_physical_oper;
@@ -391,31 +479,39 @@ RC PhysicalPlanGenerator::create_plan(
   return rc;
 }
 
-bool PhysicalPlanGenerator::can_use_hash_join(JoinLogicalOperator &join_oper)
+bool PhysicalPlanGenerator::split_hash_join_keys(
+    JoinLogicalOperator &join_oper, vector<unique_ptr<Expression>> &left_keys, vector<unique_ptr<Expression>> &right_keys)
 {
-  if (join_oper.join_type() != JoinType::INNER) {
+  if (join_oper.join_type() != JoinType::INNER || join_oper.join_predicate() == nullptr ||
+      join_oper.children().size() != 2) {
     return false;
   }
 
-  auto &predicate = join_oper.join_predicate();
-  if (predicate->type() == ExprType::COMPARISON) {
-    auto comp_expr = static_cast<ComparisonExpr *>(predicate.get());
-    return comp_expr->comp() == CompOp::EQUAL_TO;
+  vector<ComparisonExpr *> conditions;
+  if (!collect_equal_conditions(join_oper.join_predicate(), conditions)) {
+    return false;
   }
 
-  if (predicate->type() == ExprType::CONJUNCTION) {
-    auto conjunction_expr = static_cast<ConjunctionExpr *>(predicate.get());
-    auto exprs            = conjunction_expr->flatten(ExprType::COMPARISON);
-    for (auto expr : exprs) {
-      auto comp_expr = static_cast<ComparisonExpr *>(expr->get());
-      if (comp_expr->comp() != CompOp::EQUAL_TO) {
-        return false;
-      }
+  // 把每个等值条件拆成左右两边的连接键，表达式写反了的时候交换一下
+  unordered_set<string> left_refs;
+  unordered_set<string> right_refs;
+  collect_table_refs(*join_oper.children()[0], left_refs);
+  collect_table_refs(*join_oper.children()[1], right_refs);
+
+  for (ComparisonExpr *comp_expr : conditions) {
+    const JoinSide left_side  = join_side_of(*comp_expr->left(), left_refs, right_refs);
+    const JoinSide right_side = join_side_of(*comp_expr->right(), left_refs, right_refs);
+    const bool     in_order   = can_eval_on(left_side, JoinSide::LEFT) && can_eval_on(right_side, JoinSide::RIGHT);
+    const bool     reversed   = can_eval_on(right_side, JoinSide::LEFT) && can_eval_on(left_side, JoinSide::RIGHT);
+    if (!in_order && reversed) {
+      left_keys.emplace_back(comp_expr->right()->copy());
+      right_keys.emplace_back(comp_expr->left()->copy());
+    } else {
+      left_keys.emplace_back(comp_expr->left()->copy());
+      right_keys.emplace_back(comp_expr->right()->copy());
     }
-    return true;
   }
-
-  return false;
+  return true;
 }
 
 RC PhysicalPlanGenerator::create_plan(
@@ -465,7 +561,8 @@ RC PhysicalPlanGenerator::create_plan(
   ASSERT(logical_oper.children().size() == 1, "order by operator should have 1 child");
 
   vector<unique_ptr<OrderBy>>        &orderbys      = logical_oper.orderbys();
-  unique_ptr<OrderByPhysicalOperator> order_by_oper = make_unique<OrderByPhysicalOperator>(std::move(orderbys), logical_oper.limit());
+  unique_ptr<OrderByPhysicalOperator> order_by_oper = make_unique<OrderByPhysicalOperator>(
+      std::move(orderbys), logical_oper.limit(), session->sort_buffer_size(), spill_directory(session));
 
   LogicalOperator             &child_oper = *logical_oper.children().front();
   unique_ptr<PhysicalOperator> child_physical_oper;
@@ -513,7 +610,22 @@ RC PhysicalPlanGenerator::create_vec_plan(
 {
   RC                           rc            = RC::SUCCESS;
   unique_ptr<PhysicalOperator> physical_oper = nullptr;
-  if (logical_oper.group_by_expressions().empty()) {
+  // 不分组的聚合只支持数值类型的参数，其它类型(比如字符串的 max/min)按照没有分组列的 group by 处理
+  bool numeric_aggregation = true;
+  for (Expression *expr : logical_oper.aggregate_expressions()) {
+    AttrType value_type = static_cast<AggregateExpr *>(expr)->child()->value_type();
+    if (value_type != AttrType::INTS && value_type != AttrType::FLOATS) {
+      numeric_aggregation = false;
+    }
+  }
+
+  // 表扫描只需要读取分组和聚合用到的列
+  vector<Expression *> used_expressions = logical_oper.aggregate_expressions();
+  for (const unique_ptr<Expression> &expr : logical_oper.group_by_expressions()) {
+    used_expressions.push_back(expr.get());
+  }
+
+  if (logical_oper.group_by_expressions().empty() && numeric_aggregation) {
     physical_oper = make_unique<AggregateVecPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
   } else {
     physical_oper = make_unique<GroupByVecPhysicalOperator>(
@@ -529,6 +641,9 @@ RC PhysicalPlanGenerator::create_vec_plan(
     LOG_WARN("failed to create child physical operator of group by(vec) operator. rc=%s", strrc(rc));
     return rc;
   }
+  if (child_physical_oper->type() == PhysicalOperatorType::TABLE_SCAN_VEC) {
+    static_cast<TableScanVecPhysicalOperator *>(child_physical_oper.get())->set_projection(used_expressions);
+  }
 
   physical_oper->add_child(std::move(child_physical_oper));
 
@@ -562,6 +677,10 @@ RC PhysicalPlanGenerator::create_vec_plan(
     for (auto &expr : project_operator->expressions()) {
       expressions.push_back(expr.get());
     }
+    // 表扫描只需要读取投影用到的列
+    if (child_phy_oper->type() == PhysicalOperatorType::TABLE_SCAN_VEC) {
+      static_cast<TableScanVecPhysicalOperator *>(child_phy_oper.get())->set_projection(expressions);
+    }
     auto expr_operator = make_unique<ExprVecPhysicalOperator>(std::move(expressions));
     expr_operator->add_child(std::move(child_phy_oper));
     project_operator->add_child(std::move(expr_operator));
@@ -580,7 +699,7 @@ RC PhysicalPlanGenerator::create_vec_plan(
 
   RC rc = RC::SUCCESS;
   // reuse `ExplainPhysicalOperator` in explain vectorized physical plan
-  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator);
+  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator(explain_oper.analyze()));
   for (unique_ptr<LogicalOperator> &child_oper : child_opers) {
     unique_ptr<PhysicalOperator> child_physical_oper;
     rc = create_vec(*child_oper, child_physical_oper, session);
@@ -49,6 +49,14 @@ public:
   RC create(LogicalOperator &logical_operator, unique_ptr<PhysicalOperator> &oper, Session *session);
   RC create_vec(LogicalOperator &logical_operator, unique_ptr<PhysicalOperator> &oper, Session *session);
 
+  /**
+   * @brief 判断连接能否使用 Hash Join，可以的话把连接条件拆成左右两边的连接键
+   * @details 只有内连接并且连接条件都是使用AND连接的等值比较时才可以。
+   * 连接键是连接条件中表达式的拷贝，不会修改连接算子，cascade 优化器的实现规则也使用这个函数。
+   */
+  static bool split_hash_join_keys(JoinLogicalOperator &join_oper, vector<unique_ptr<Expression>> &left_keys,
+      vector<unique_ptr<Expression>> &right_keys);
+
 private:
   RC create_plan(TableGetLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper, Session *session);
   RC create_plan(ViewGetLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper, Session *session);
@@ -67,7 +75,4 @@ private:
   RC create_vec_plan(TableGetLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper, Session *session);
   RC create_vec_plan(GroupByLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper, Session *session);
   RC create_vec_plan(ExplainLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper, Session *session);
-
-  // TODO: remove this and add CBO rules
-  bool can_use_hash_join(JoinLogicalOperator &logical_oper);
 };
@@ -0,0 +1,133 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/histogram.h"
+#include "common/lang/algorithm.h"
+#include "common/value.h"
+
+#include <string.h>
+
+void Histogram::build(const vector<double> &values, int bucket_num, double ndv)
+{
+  buckets_.clear();
+  if (values.empty() || bucket_num <= 0) {
+    return;
+  }
+
+  const size_t total      = values.size();
+  const size_t depth      = (total + bucket_num - 1) / bucket_num;
+  size_t       sample_ndv = 0;
+  for (size_t begin = 0; begin < total;) {
+    size_t end = min(begin + depth, total);
+    // 同一个值不能跨桶。桶的最后一个值出现的次数很多时，让它单独占一个桶，
+    // 否则它的频率会被桶内其它的值平均掉
+    const double last      = values[end - 1];
+    const size_t run_begin = lower_bound(values.begin() + begin, values.begin() + end, last) - values.begin();
+    const size_t run_end   = upper_bound(values.begin() + end - 1, values.end(), last) - values.begin();
+    if (run_begin > begin && run_end - run_begin >= depth) {
+      end = run_begin;
+    } else {
+      end = run_end;
+    }
+
+    Bucket bucket;
+    bucket.lower = values[begin];
+    bucket.upper = values[end - 1];
+    bucket.rows  = static_cast<double>(end - begin) / total;
+    for (size_t i = begin; i < end; i++) {
+      if (i == begin || values[i] != values[i - 1]) {
+        bucket.ndv += 1;
+      }
+    }
+    sample_ndv += static_cast<size_t>(bucket.ndv);
+    buckets_.push_back(bucket);
+    begin = end;
+  }
+
+  // 抽样只看到了一部分不同的值，按照比例放大到整张表
+  const double scale = ndv > sample_ndv ? ndv / sample_ndv : 1.0;
+  for (Bucket &bucket : buckets_) {
+    bucket.ndv *= scale;
+  }
+}
+
+double Histogram::equal_selectivity(double value) const
+{
+  for (const Bucket &bucket : buckets_) {
+    if (value < bucket.lower) {
+      break;
+    }
+    if (value <= bucket.upper) {
+      return bucket.rows / max(bucket.ndv, 1.0);
+    }
+  }
+  return 0;
+}
+
+double Histogram::less_selectivity(double value, bool inclusive) const
+{
+  double selectivity = 0;
+  for (const Bucket &bucket : buckets_) {
+    if (value < bucket.lower) {
+      break;
+    }
+
+    if (value > bucket.upper) {
+      selectivity += bucket.rows;
+      continue;
+    }
+
+    // 值落在桶内，按照均匀分布估算
+    const double equal = bucket.rows / max(bucket.ndv, 1.0);
+    if (bucket.upper > bucket.lower) {
+      selectivity += (bucket.rows - equal) * (value - bucket.lower) / (bucket.upper - bucket.lower);
+    }
+    if (inclusive) {
+      selectivity += equal;
+    }
+    break;
+  }
+  return min(selectivity, 1.0);
+}
+
+bool Histogram::position(const Value &value, double &pos)
+{
+  switch (value.attr_type()) {
+    case AttrType::INTS:
+    case AttrType::BOOLEANS: {
+      pos = value.get_int();
+    } break;
+    case AttrType::FLOATS: {
+      pos = value.get_float();
+    } break;
+    case AttrType::DATES: {
+      int date = 0;
+      memcpy(&date, value.data(), sizeof(date));
+      pos = date;
+    } break;
+    case AttrType::CHARS: {
+      // 把前8个字节按照大端序拼成一个整数，这样就和字符串的字典序一致
+      uint64_t    prefix = 0;
+      const char *data   = value.data();
+      const int   length = value.length();
+      bool        ended  = false;
+      for (int i = 0; i < 8; i++) {
+        ended                 = ended || i >= length || data[i] == '\0';
+        const unsigned char c = ended ? 0 : static_cast<unsigned char>(data[i]);
+        prefix                = (prefix << 8) | c;
+      }
+      pos = static_cast<double>(prefix);
+    } break;
+    default: {
+      return false;
+    }
+  }
+  return true;
+}
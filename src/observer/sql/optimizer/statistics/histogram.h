@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/vector.h"
+
+#include <stdint.h>
+
+class Value;
+
+/**
+ * @brief 等深直方图
+ * @details 每个桶中的行数大致相同，同一个值不会跨桶，出现次数超过一个桶的值会单独占一个桶。
+ * 桶的边界使用 double 表示，不同类型的值通过 position 映射到 double 上，映射保持值的大小顺序。
+ * 桶内认为值是均匀分布的，等值条件的选择率是桶的行数除以桶内不同值的个数。
+ */
+class Histogram
+{
+public:
+  struct Bucket
+  {
+    double lower = 0;  ///< 桶内最小的值
+    double upper = 0;  ///< 桶内最大的值
+    double rows  = 0;  ///< 桶内的行数占所有非NULL行的比例
+    double ndv   = 0;  ///< 桶内不同值的个数，已经按照整张表的不同值个数放大过
+  };
+
+public:
+  Histogram() = default;
+
+  /**
+   * @brief 使用排好序的抽样数据构建直方图
+   * @param values     排好序的非NULL值
+   * @param bucket_num 最多多少个桶
+   * @param ndv        整张表中不同值的个数，用来放大每个桶内抽样得到的不同值个数
+   */
+  void build(const vector<double> &values, int bucket_num, double ndv);
+
+  bool                  empty() const { return buckets_.empty(); }
+  const vector<Bucket> &buckets() const { return buckets_; }
+  void                  add_bucket(const Bucket &bucket) { buckets_.push_back(bucket); }
+
+  /// @brief 等于value的行占非NULL行的比例
+  double equal_selectivity(double value) const;
+  /// @brief 小于(inclusive时为小于等于)value的行占非NULL行的比例
+  double less_selectivity(double value, bool inclusive) const;
+
+  /**
+   * @brief 把值映射到 double 上，映射之后仍然保持原来的大小顺序
+   * @details 字符串使用前8个字节，所以前缀相同的字符串会映射成相同的值
+   * @return 不支持的类型返回false
+   */
+  static bool position(const Value &value, double &pos);
+
+private:
+  vector<Bucket> buckets_;
+};
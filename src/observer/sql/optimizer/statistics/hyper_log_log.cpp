@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/hyper_log_log.h"
+#include "common/lang/cmath.h"
+
+void HyperLogLog::add(uint64_t hash)
+{
+  const uint64_t index = hash >> (64 - PRECISION);
+  // 最低位补一个1，保证剩下的位全是0时也能得到一个有限的位置
+  const uint64_t rest = (hash << PRECISION) | (1ULL << (PRECISION - 1));
+  const uint8_t  rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+  if (registers_[index] < rank) {
+    registers_[index] = rank;
+  }
+}
+
+int64_t HyperLogLog::estimate() const
+{
+  const double m     = REGISTER_NUM;
+  const double alpha = 0.7213 / (1 + 1.079 / m);
+
+  double sum  = 0;
+  int    zero = 0;
+  for (uint8_t rank : registers_) {
+    sum += ldexp(1.0, -rank);
+    if (rank == 0) {
+      zero++;
+    }
+  }
+
+  double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zero > 0) {
+    estimate = m * log(m / zero);
+  }
+  return llround(estimate);
+}
@@ -0,0 +1,38 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/vector.h"
+
+#include <stdint.h>
+
+/**
+ * @brief 估算不同值个数(NDV)的 HyperLogLog
+ * @details 使用哈希值的高 PRECISION 位选择寄存器，寄存器中记录剩下的位中第一个1出现的最大位置。
+ * 占用的内存固定为 2^PRECISION 字节，标准误差约为 1.04/sqrt(2^PRECISION)，即 1.6% 左右。
+ * 基数比较小的时候使用 linear counting 修正。
+ * 输入的哈希值需要是均匀分布的，不能直接使用整数的 std::hash。
+ */
+class HyperLogLog
+{
+public:
+  static constexpr int PRECISION    = 12;
+  static constexpr int REGISTER_NUM = 1 << PRECISION;
+
+public:
+  HyperLogLog() : registers_(REGISTER_NUM, 0) {}
+
+  void    add(uint64_t hash);
+  int64_t estimate() const;
+
+private:
+  vector<uint8_t> registers_;
+};
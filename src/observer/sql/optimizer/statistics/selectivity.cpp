@@ -0,0 +1,205 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/selectivity.h"
+#include "catalog/catalog.h"
+#include "common/lang/algorithm.h"
+#include "common/value.h"
+#include "sql/expr/expression.h"
+#include "storage/table/table.h"
+
+namespace {
+
+double default_selectivity(CompOp comp)
+{
+  switch (comp) {
+    case CompOp::EQUAL_TO:
+    case CompOp::IS: return SelectivityEstimator::DEFAULT_EQUAL_SELECTIVITY;
+    case CompOp::NOT_EQUAL:
+    case CompOp::IS_NOT: return 1 - SelectivityEstimator::DEFAULT_EQUAL_SELECTIVITY;
+    case CompOp::LESS_THAN:
+    case CompOp::LESS_EQUAL:
+    case CompOp::GREAT_THAN:
+    case CompOp::GREAT_EQUAL: return SelectivityEstimator::DEFAULT_RANGE_SELECTIVITY;
+    default: return SelectivityEstimator::DEFAULT_SELECTIVITY;
+  }
+}
+
+/// @brief 常量写在左边时，交换左右两边之后的比较运算
+CompOp swap_comp(CompOp comp)
+{
+  switch (comp) {
+    case CompOp::LESS_THAN: return CompOp::GREAT_THAN;
+    case CompOp::LESS_EQUAL: return CompOp::GREAT_EQUAL;
+    case CompOp::GREAT_THAN: return CompOp::LESS_THAN;
+    case CompOp::GREAT_EQUAL: return CompOp::LESS_EQUAL;
+    default: return comp;
+  }
+}
+
+double clamp_selectivity(double selectivity) { return max(0.0, min(1.0, selectivity)); }
+
+}  // namespace
+
+double SelectivityEstimator::estimate(const Expression *expr)
+{
+  if (expr == nullptr) {
+    return 1;
+  }
+
+  // 表达式的子节点只提供了非const的访问接口
+  Expression *mutable_expr = const_cast<Expression *>(expr);
+  switch (expr->type()) {
+    case ExprType::CONJUNCTION: {
+      auto         conjunction_expr = static_cast<ConjunctionExpr *>(mutable_expr);
+      const double left             = estimate(conjunction_expr->left().get());
+      const double right            = estimate(conjunction_expr->right().get());
+      if (conjunction_expr->conjunction_type() == ConjunctionExpr::Type::AND) {
+        return left * right;
+      }
+      return clamp_selectivity(left + right - left * right);
+    }
+
+    case ExprType::COMPARISON: {
+      auto        comp_expr   = static_cast<ComparisonExpr *>(mutable_expr);
+      Expression *left        = comp_expr->left().get();
+      Expression *right       = comp_expr->right().get();
+      const bool  left_field  = left->type() == ExprType::TABLE_FIELD;
+      const bool  right_field = right->type() == ExprType::TABLE_FIELD;
+
+      Value value;
+      if (left_field && right_field) {
+        return estimate_field_field(
+            *static_cast<TableFieldExpr *>(left), *static_cast<TableFieldExpr *>(right), comp_expr->comp());
+      }
+      if (left_field && OB_SUCC(right->try_get_value(value))) {
+        return estimate_field_value(*static_cast<TableFieldExpr *>(left), comp_expr->comp(), value);
+      }
+      if (right_field && OB_SUCC(left->try_get_value(value))) {
+        return estimate_field_value(*static_cast<TableFieldExpr *>(right), swap_comp(comp_expr->comp()), value);
+      }
+      return default_selectivity(comp_expr->comp());
+    }
+
+    default: {
+      return DEFAULT_SELECTIVITY;
+    }
+  }
+}
+
+double SelectivityEstimator::estimate_field_value(const TableFieldExpr &field, CompOp comp, const Value &value)
+{
+  ColumnStats stats;
+  if (!find_column_stats(field, stats)) {
+    return default_selectivity(comp);
+  }
+
+  const double non_null = 1 - stats.null_frac;
+  if (comp == CompOp::IS || comp == CompOp::IS_NOT) {
+    if (!value.is_null()) {
+      return default_selectivity(comp);
+    }
+    return comp == CompOp::IS ? stats.null_frac : non_null;
+  }
+  if (value.is_null()) {
+    // 和NULL比较的结果永远不是true
+    return 0;
+  }
+
+  const double equal = 1.0 / max<int64_t>(stats.ndv, 1);
+
+  // 常量的类型和字段不同时，先转换成字段的类型，这样才能和直方图的边界比较
+  Value  field_value;
+  double pos     = 0;
+  bool   has_pos = false;
+  if (stats.has_range) {
+    if (value.attr_type() == field.value_type()) {
+      has_pos = Histogram::position(value, pos);
+    } else if (OB_SUCC(Value::cast_to(value, field.value_type(), field_value))) {
+      has_pos = Histogram::position(field_value, pos);
+    }
+  }
+
+  if (!has_pos) {
+    switch (comp) {
+      case CompOp::EQUAL_TO: return non_null * equal;
+      case CompOp::NOT_EQUAL: return non_null * (1 - equal);
+      default: return non_null * default_selectivity(comp);
+    }
+  }
+
+  const Histogram &histogram = stats.histogram;
+  double           less      = 0;  // 小于pos的比例
+  double           less_eq   = 0;  // 小于等于pos的比例
+  if (!histogram.empty()) {
+    less    = histogram.less_selectivity(pos, false);
+    less_eq = histogram.less_selectivity(pos, true);
+  } else if (pos < stats.min) {
+    less = less_eq = 0;
+  } else if (pos > stats.max) {
+    less = less_eq = 1;
+  } else {
+    less    = stats.max > stats.min ? (pos - stats.min) / (stats.max - stats.min) : 0;
+    less_eq = min(1.0, less + equal);
+  }
+
+  double selectivity = 0;
+  switch (comp) {
+    case CompOp::EQUAL_TO: {
+      if (pos < stats.min || pos > stats.max) {
+        selectivity = 0;
+      } else {
+        selectivity = histogram.empty() ? equal : histogram.equal_selectivity(pos);
+      }
+    } break;
+    case CompOp::NOT_EQUAL: {
+      selectivity = 1 - (histogram.empty() ? equal : histogram.equal_selectivity(pos));
+    } break;
+    case CompOp::LESS_THAN: selectivity = less; break;
+    case CompOp::LESS_EQUAL: selectivity = less_eq; break;
+    case CompOp::GREAT_THAN: selectivity = 1 - less_eq; break;
+    case CompOp::GREAT_EQUAL: selectivity = 1 - less; break;
+    default: return non_null * default_selectivity(comp);
+  }
+  return non_null * clamp_selectivity(selectivity);
+}
+
+double SelectivityEstimator::estimate_field_field(const TableFieldExpr &left, const TableFieldExpr &right, CompOp comp)
+{
+  if (comp != CompOp::EQUAL_TO) {
+    return default_selectivity(comp);
+  }
+
+  ColumnStats left_stats;
+  ColumnStats right_stats;
+  if (!find_column_stats(left, left_stats) || !find_column_stats(right, right_stats)) {
+    return DEFAULT_EQUAL_SELECTIVITY;
+  }
+
+  // 认为不同值较少的一边的值都能在另一边找到
+  const int64_t ndv = max<int64_t>(max(left_stats.ndv, right_stats.ndv), 1);
+  return (1 - left_stats.null_frac) * (1 - right_stats.null_frac) / ndv;
+}
+
+bool SelectivityEstimator::find_column_stats(const TableFieldExpr &field, ColumnStats &column_stats)
+{
+  const Table *table = field.field().table();
+  if (table == nullptr) {
+    return false;
+  }
+
+  TableStats         table_stats = Catalog::get_instance().get_table_stats(table->table_id());
+  const ColumnStats *stats       = table_stats.find_column(field.field_name());
+  if (stats == nullptr) {
+    return false;
+  }
+  column_stats = *stats;
+  return true;
+}
@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+class Expression;
+class TableFieldExpr;
+class ColumnStats;
+class Value;
+
+#include "sql/parser/parse_defs.h"
+
+/**
+ * @brief 使用 ANALYZE TABLE 收集的统计信息估算谓词的选择率
+ * @details 选择率是满足条件的行占所有行的比例。
+ * AND 认为各个条件相互独立，OR 使用 s1+s2-s1*s2。
+ * 字段和常量比较时使用直方图，没有直方图时使用最小最大值，字段之间的等值比较使用 1/max(ndv)。
+ * 没有统计信息或者表达式比较复杂时使用固定的默认值。
+ */
+class SelectivityEstimator
+{
+public:
+  static constexpr double DEFAULT_EQUAL_SELECTIVITY = 0.1;
+  static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3;
+  static constexpr double DEFAULT_SELECTIVITY       = 0.5;
+
+public:
+  /// @brief 估算谓词的选择率，expr 为空时返回1
+  static double estimate(const Expression *expr);
+
+private:
+  static double estimate_field_value(const TableFieldExpr &field, CompOp comp, const Value &value);
+  static double estimate_field_field(const TableFieldExpr &left, const TableFieldExpr &right, CompOp comp);
+
+  /// @brief 查找字段的统计信息，没有分析过的表返回false
+  static bool find_column_stats(const TableFieldExpr &field, ColumnStats &column_stats);
+};
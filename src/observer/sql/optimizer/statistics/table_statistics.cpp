@@ -0,0 +1,168 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/table_statistics.h"
+#include "catalog/table_stats.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/cmath.h"
+#include "common/lang/limits.h"
+#include "common/lang/random.h"
+#include "common/log/log.h"
+#include "sql/expr/tuple.h"
+#include "sql/operator/join_runtime_filter.h"
+#include "sql/optimizer/statistics/hyper_log_log.h"
+#include "storage/table/table.h"
+
+namespace {
+
+/**
+ * @brief 收集一列的统计信息
+ */
+struct ColumnCollector
+{
+  int            index     = 0;  ///< 列在 RowTuple 中的下标
+  const char    *name      = nullptr;
+  int64_t        null_rows = 0;
+  HyperLogLog    hll;
+  bool           has_range = false;
+  double         min       = 0;
+  double         max       = 0;
+  vector<double> samples;  ///< 与行的蓄水池样本一一对应，NULL或者不支持的类型不放进来
+};
+
+}  // namespace
+
+int64_t TableStatistics::estimate_ndv(int64_t sample_ndv, int64_t sample_rows, int64_t total_rows)
+{
+  if (sample_rows <= 0) {
+    return 0;
+  }
+  if (sample_rows >= total_rows) {
+    return min(sample_ndv, total_rows);
+  }
+  if (sample_ndv > sample_rows * 0.9) {
+    return min(static_cast<int64_t>(static_cast<double>(sample_ndv) * total_rows / sample_rows), total_rows);
+  }
+  return sample_ndv;
+}
+
+RC TableStatistics::analyze(Table *table, Trx *trx, TableStats &stats)
+{
+  const TableMeta         &table_meta = table->table_meta();
+  const vector<FieldMeta> *fields     = table_meta.field_metas();
+
+  vector<ColumnCollector> columns;
+  for (int i = table_meta.sys_field_num(); i < static_cast<int>(fields->size()); i++) {
+    const FieldMeta &field = (*fields)[i];
+    // 大字段需要再去读LOB文件，不收集统计信息
+    if (!field.visible() || field.type() == AttrType::LOBID) {
+      continue;
+    }
+    ColumnCollector column;
+    column.index = i;
+    column.name  = field.name();
+    columns.push_back(std::move(column));
+  }
+
+  RowTuple tuple;
+  tuple.set_schema(table, fields);
+
+  mt19937 random(static_cast<uint32_t>(table->table_id()));
+  int64_t rows = 0;
+  Value   value;
+  Record  row;
+
+  auto visitor = [&](const Record &record) -> RC {
+    row.copy_data(record.data(), record.len());
+    tuple.set_record(&row);
+
+    // 蓄水池抽样，决定这一行放到样本的哪个位置，-1表示不要这一行
+    int64_t slot = -1;
+    if (rows < MAX_SAMPLE_ROWS) {
+      slot = rows;
+    } else {
+      const int64_t index = uniform_int_distribution<int64_t>(0, rows)(random);
+      slot                = index < MAX_SAMPLE_ROWS ? index : -1;
+    }
+    rows++;
+
+    for (ColumnCollector &column : columns) {
+      RC rc = tuple.cell_at(column.index, value);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get cell. table=%s, field=%s, rc=%s", table->name(), column.name, strrc(rc));
+        return rc;
+      }
+
+      double     pos     = 0;
+      const bool has_pos = !value.is_null() && Histogram::position(value, pos);
+      if (value.is_null()) {
+        column.null_rows++;
+      } else {
+        uint64_t hash = 0;
+        if (OB_SUCC(JoinKeyHasher::hash_keys(&value, 1, hash))) {
+          column.hll.add(hash);
+        }
+        if (has_pos) {
+          column.min       = column.has_range ? std::min(column.min, pos) : pos;
+          column.max       = column.has_range ? std::max(column.max, pos) : pos;
+          column.has_range = true;
+        }
+      }
+
+      // 样本按行替换，NULL用NaN占位，构建直方图时再去掉
+      if (slot >= 0) {
+        const double sample = has_pos ? pos : std::numeric_limits<double>::quiet_NaN();
+        if (slot == static_cast<int64_t>(column.samples.size())) {
+          column.samples.push_back(sample);
+        } else {
+          column.samples[slot] = sample;
+        }
+      }
+    }
+    return RC::SUCCESS;
+  };
+
+  int64_t estimated_rows = 0;
+  RC      rc             = table->sample_records(trx, MAX_SAMPLE_PAGES, visitor, estimated_rows);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sample table records. table=%s, rc=%s", table->name(), strrc(rc));
+    return rc;
+  }
+
+  estimated_rows     = max(estimated_rows, rows);
+  stats.row_nums     = static_cast<int>(estimated_rows);
+  stats.sampled_rows = rows;
+  stats.column_stats.clear();
+  for (ColumnCollector &column : columns) {
+    ColumnStats column_stats;
+    column_stats.name      = column.name;
+    column_stats.null_frac = rows > 0 ? static_cast<double>(column.null_rows) / rows : 0;
+
+    const int64_t non_null_rows  = rows - column.null_rows;
+    const int64_t total_non_null = static_cast<int64_t>(estimated_rows * (1 - column_stats.null_frac));
+    column_stats.ndv             = estimate_ndv(column.hll.estimate(), non_null_rows, total_non_null);
+
+    column_stats.has_range = column.has_range;
+    if (column.has_range) {
+      column_stats.min = column.min;
+      column_stats.max = column.max;
+
+      vector<double> &samples = column.samples;
+      samples.erase(remove_if(samples.begin(), samples.end(), [](double v) { return std::isnan(v); }), samples.end());
+      sort(samples.begin(), samples.end());
+      column_stats.histogram.build(samples, HISTOGRAM_BUCKETS, static_cast<double>(column_stats.ndv));
+    }
+    stats.column_stats.push_back(std::move(column_stats));
+  }
+
+  LOG_INFO("analyze table done. table=%s, sampled rows=%ld, estimated rows=%ld",
+           table->name(), rows, estimated_rows);
+  return RC::SUCCESS;
+}
@@ -10,5 +10,37 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/sys/rc.h"
+
+#include <stdint.h>
+
+class Table;
+class Trx;
+class TableStats;
+
+/**
+ * @brief 收集表的统计信息(ANALYZE TABLE)
+ * @details 从表中抽样读取一部分数据页，计算每一列的NULL比例、不同值个数、最小最大值和等深直方图。
+ * 不同值个数使用 HyperLogLog 估算，直方图使用读到的记录中的一个蓄水池样本构建。
+ * 只读取了部分数据页时，行数按照页数比例放大，不同值个数按照 estimate_ndv 的规则放大。
+ */
 class TableStatistics
-{};
\ No newline at end of file
+{
+public:
+  static constexpr int MAX_SAMPLE_PAGES  = 256;    ///< 最多读取多少个数据页
+  static constexpr int MAX_SAMPLE_ROWS   = 10000;  ///< 构建直方图时最多使用多少行
+  static constexpr int HISTOGRAM_BUCKETS = 32;
+
+public:
+  static RC analyze(Table *table, Trx *trx, TableStats &stats);
+
+  /**
+   * @brief 根据样本中的不同值个数估算整张表的不同值个数
+   * @param sample_ndv  样本中的不同值个数
+   * @param sample_rows 样本中的非NULL行数
+   * @param total_rows  估算的整张表的非NULL行数
+   * @details 样本中几乎每个值都不一样时，认为这一列接近唯一，按照行数比例放大；
+   * 否则认为样本已经看到了大部分不同的值。
+   */
+  static int64_t estimate_ndv(int64_t sample_ndv, int64_t sample_rows, int64_t total_rows);
+};
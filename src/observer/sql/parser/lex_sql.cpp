@@ -0,0 +1,113 @@
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include "sql/parser/parse_defs.h"
+#include "yacc_sql.hpp"
+#include "lex_sql.h"
+struct Scanner { void *extra; std::string s; size_t pos = 0; int line = 1; int col = 0; };
+int yylex_init_extra(void *extra, yyscan_t *scanner) { auto *s = new Scanner; s->extra = extra; *scanner = s; return 0; }
+int yylex_destroy(yyscan_t scanner) { delete (Scanner*)scanner; return 0; }
+void scan_string(const char *str, yyscan_t scanner) { auto *s=(Scanner*)scanner; s->s = str; s->pos = 0; }
+static char *keep(Scanner *s, const std::string &v) { char *p = strdup(v.c_str()); static_cast<std::vector<char*>*>(s->extra)->push_back(p); return p; }
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner) {
+  Scanner *s = (Scanner*)scanner;
+  const std::string &in = s->s;
+  while (true) {
+    if (s->pos >= in.size()) return 0;
+    char ch = in[s->pos];
+    if (ch == '\n') { s->pos++; s->line++; s->col = 0; continue; }
+    if (ch==' '||ch=='\t'||ch=='\b'||ch=='\f'||ch=='\r') { s->pos++; s->col++; continue; }
+    break;
+  }
+  size_t start = s->pos; int tok = 0;
+  auto finish = [&](int t) { size_t len = s->pos - start; yylloc->first_line = yylloc->last_line = s->line; yylloc->first_column = s->col; yylloc->last_column = s->col + (int)len - 1; s->col += (int)len; return t; };
+  char ch = in[start];
+  if (isdigit((unsigned char)ch)) {
+    size_t p = start; while (p < in.size() && isdigit((unsigned char)in[p])) p++;
+    if (p + 1 < in.size() && in[p] == '.' && isdigit((unsigned char)in[p+1])) { p++; while (p < in.size() && isdigit((unsigned char)in[p])) p++; s->pos = p; yylval->floats = (float)atof(in.substr(start, p-start).c_str()); return finish(FLOAT); }
+    s->pos = p; yylval->number = atoi(in.substr(start, p-start).c_str()); return finish(NUMBER);
+  }
+  if (isalpha((unsigned char)ch) || ch == '_') {
+    size_t p = start; while (p < in.size() && (isalnum((unsigned char)in[p]) || in[p]=='_')) p++;
+    std::string w = in.substr(start, p-start); std::string u = w; for (auto &x : u) x = toupper((unsigned char)x);
+    s->pos = p;
+    if (u == "EXIT") return finish(EXIT);
+    if (u == "HELP") return finish(HELP);
+    if (u == "ASC") return finish(ASC);
+    if (u == "DESC") return finish(DESC);
+    if (u == "CREATE") return finish(CREATE);
+    if (u == "DROP") return finish(DROP);
+    if (u == "VIEW") return finish(VIEW);
+    if (u == "TABLE") return finish(TABLE);
+    if (u == "TABLES") return finish(TABLES);
+    if (u == "INDEX") return finish(INDEX);
+    if (u == "ON") return finish(ON);
+    if (u == "SHOW") return finish(SHOW);
+    if (u == "SYNC") return finish(SYNC);
+    if (u == "SELECT") return finish(SELECT);
+    if (u == "CALC") return finish(CALC);
+    if (u == "FROM") return finish(FROM);
+    if (u == "WHERE") return finish(WHERE);
+    if (u == "AND") return finish(AND);
+    if (u == "OR") return finish(OR);
+    if (u == "INSERT") return finish(INSERT);
+    if (u == "INTO") return finish(INTO);
+    if (u == "VALUES") return finish(VALUES);
+    if (u == "DELETE") return finish(DELETE);
+    if (u == "UPDATE") return finish(UPDATE);
+    if (u == "SET") return finish(SET);
+    if (u == "BEGIN") return finish(TRX_BEGIN);
+    if (u == "COMMIT") return finish(TRX_COMMIT);
+    if (u == "ROLLBACK") return finish(TRX_ROLLBACK);
+    if (u == "INT") return finish(INT_T);
+    if (u == "CHAR") return finish(STRING_T);
+    if (u == "FLOAT") return finish(FLOAT_T);
+    if (u == "VECTOR") return finish(VECTOR_T);
+    if (u == "DATE") return finish(DATE_T);
+    if (u == "LOAD") return finish(LOAD);
+    if (u == "EXPLAIN") return finish(EXPLAIN);
+    if (u == "GROUP") return finish(GROUP);
+    if (u == "BY") return finish(BY);
+    if (u == "STORAGE") return finish(STORAGE);
+    if (u == "FORMAT") return finish(FORMAT);
+    if (u == "PRIMARY") return finish(PRIMARY);
+    if (u == "KEY") return finish(KEY);
+    if (u == "ANALYZE") return finish(ANALYZE);
+    if (u == "NOT") return finish(NOT);
+    if (u == "NULL") return finish(NULL_T);
+    if (u == "IS") return finish(IS_T);
+    if (u == "INNER") return finish(INNER_T);
+    if (u == "JOIN") return finish(JOIN_T);
+    if (u == "IN") return finish(IN_T);
+    if (u == "ORDER") return finish(ORDER_T);
+    if (u == "TEXT") return finish(TEXT_T);
+    if (u == "LIKE") return finish(LIKE_T);
+    if (u == "AS") return finish(AS_T);
+    if (u == "HAVING") return finish(HAVING_T);
+    if (u == "UNIQUE") return finish(UNIQUE_T);
+    if (u == "WITH") return finish(WITH_T);
+    if (u == "LIMIT") return finish(LIMIT_T);
+    yylval->cstring = keep(s, w); return finish(ID);
+  }
+  if (ch == '"' || ch == '\'') {
+    size_t p = in.find(ch, start + 1);
+    if (p != std::string::npos) { s->pos = p + 1; yylval->cstring = keep(s, in.substr(start, p + 1 - start)); return finish(SSS); }
+  }
+  if (in.compare(start, 2, "<=") == 0) { s->pos += 2; return finish(LE); }
+  if (in.compare(start, 2, "<>") == 0) { s->pos += 2; return finish(NE); }
+  if (in.compare(start, 2, "!=") == 0) { s->pos += 2; return finish(NE); }
+  if (in.compare(start, 2, ">=") == 0) { s->pos += 2; return finish(GE); }
+  if (in.compare(start, 1, ";") == 0) { s->pos += 1; return finish(SEMICOLON); }
+  if (in.compare(start, 1, "(") == 0) { s->pos += 1; return finish(LBRACE); }
+  if (in.compare(start, 1, ")") == 0) { s->pos += 1; return finish(RBRACE); }
+  if (in.compare(start, 1, "[") == 0) { s->pos += 1; return finish(LBRACKET); }
+  if (in.compare(start, 1, "]") == 0) { s->pos += 1; return finish(RBRACKET); }
+  if (in.compare(start, 1, ",") == 0) { s->pos += 1; return finish(COMMA); }
+  if (in.compare(start, 1, "=") == 0) { s->pos += 1; return finish(EQ); }
+  if (in.compare(start, 1, "<") == 0) { s->pos += 1; return finish(LT); }
+  if (in.compare(start, 1, ">") == 0) { s->pos += 1; return finish(GT); }
+  if (ch == '.') { s->pos++; return finish(DOT); }
+  s->pos++; return finish((int)(unsigned char)ch);
+}
@@ -0,0 +1,5 @@
+#pragma once
+typedef void *yyscan_t;
+int yylex_init_extra(void *extra, yyscan_t *scanner);
+int yylex_destroy(yyscan_t scanner);
+int yylex(union YYSTYPE *yylval, struct YYLTYPE *yylloc, yyscan_t scanner);
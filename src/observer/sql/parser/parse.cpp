@@ -27,6 +27,17 @@ void ParsedSqlResult::add_sql_node(unique_ptr<ParsedSqlNode> sql_node)
   sql_nodes_.emplace_back(std::move(sql_node));
 }
 
+Value ParsedSqlResult::placeholder_value(int index) const
+{
+  if (placeholder_values_ != nullptr && index < static_cast<int>(placeholder_values_->size())) {
+    return (*placeholder_values_)[index];
+  }
+
+  Value value((int)0);
+  value.set_null(true);
+  return value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int sql_parse(const char *st, ParsedSqlResult *sql_result);
@@ -36,3 +47,26 @@ RC parse(const char *st, ParsedSqlResult *sql_result)
   sql_parse(st, sql_result);
   return RC::SUCCESS;
 }
+
+int sql_fingerprint(const char *st, string *fingerprint, vector<Value> *params, vector<size_t> *placeholders);
+
+RC parse_fingerprint(const char *st, string &fingerprint, vector<Value> &params)
+{
+  fingerprint.clear();
+  params.clear();
+  if (sql_fingerprint(st, &fingerprint, &params, nullptr) != 0 || fingerprint.empty()) {
+    return RC::UNSUPPORTED;
+  }
+  return RC::SUCCESS;
+}
+
+RC parse_fingerprint(const char *st, string &fingerprint, vector<Value> &params, vector<size_t> &placeholders)
+{
+  fingerprint.clear();
+  params.clear();
+  placeholders.clear();
+  if (sql_fingerprint(st, &fingerprint, &params, &placeholders) != 0 || fingerprint.empty()) {
+    return RC::UNSUPPORTED;
+  }
+  return RC::SUCCESS;
+}
@@ -18,3 +18,17 @@ See the Mulan PSL v2 for more details. */
 #include "sql/parser/parse_defs.h"
 
 RC parse(const char *st, ParsedSqlResult *sql_result);
+
+/**
+ * @brief 计算SQL的指纹
+ * @details 指纹是把SQL中的字面量常量替换成带类型的占位符之后的文本，常量按照出现的顺序放到params中。
+ * 当前仅支持单条SELECT语句，其它语句返回 RC::UNSUPPORTED。
+ */
+RC parse_fingerprint(const char *st, string &fingerprint, vector<Value> &params);
+
+/**
+ * @brief 计算预处理语句的指纹
+ * @details 与上面的函数相同，只是允许出现占位符'?'。占位符在指纹中保持原样，它在指纹中的偏移放到placeholders中，
+ * params中对应的位置是一个未定义的值，执行时使用绑定的参数替换
+ */
+RC parse_fingerprint(const char *st, string &fingerprint, vector<Value> &params, vector<size_t> &placeholders);
@@ -162,7 +162,9 @@ struct CalcSqlNode
 struct InsertSqlNode
 {
   string        relation_name;  ///< Relation to insert into
-  vector<Value> values;         ///< 要插入的值
+  vector<Value> values;         ///< 要插入的值，多行时一行接一行地存放
+  vector<int>   placeholders;   ///< 预处理语句中每个值对应的占位符序号，不是占位符的为-1
+  size_t        row_num = 0;    ///< 插入的行数
 };
 
 /**
@@ -347,6 +349,7 @@ class ParsedSqlNode;
 struct ExplainSqlNode
 {
   unique_ptr<ParsedSqlNode> sql_node;
+  bool                      analyze = false;  ///< EXPLAIN ANALYZE，执行语句并输出执行时的统计信息
 };
 
 /**
@@ -382,6 +385,7 @@ enum SqlCommandFlag
   SCF_DROP_INDEX,
   SCF_SYNC,
   SCF_SHOW_TABLES,
+  SCF_SHOW_STATUS,
   SCF_DESC_TABLE,
   SCF_BEGIN,  ///< 事务开始语句，可以在这里扩展只读事务
   SCF_COMMIT,
@@ -435,6 +439,30 @@ public:
 
   vector<unique_ptr<ParsedSqlNode>> &sql_nodes() { return sql_nodes_; }
 
+  /**
+   * @brief 为SQL中出现的一个字面量常量分配序号
+   * @details 序号按照字面量在SQL文本中出现的顺序递增，计划缓存使用它来替换缓存计划中的常量
+   */
+  int add_param() { return param_count_++; }
+  int param_count() const { return param_count_; }
+
+  /**
+   * @brief 设置预处理语句的占位符'?'绑定的参数
+   * @details 没有设置时SQL中不允许出现占位符。预处理时还没有参数，可以设置一个空的数组，占位符的值都是NULL
+   */
+  void set_placeholder_values(const vector<Value> *values) { placeholder_values_ = values; }
+  bool placeholder_enabled() const { return placeholder_values_ != nullptr; }
+
+  /**
+   * @brief 为SQL中出现的一个占位符分配序号，并取出它绑定的参数
+   */
+  int   add_placeholder() { return placeholder_count_++; }
+  int   placeholder_count() const { return placeholder_count_; }
+  Value placeholder_value(int index) const;
+
 private:
   vector<unique_ptr<ParsedSqlNode>> sql_nodes_;  ///< 这里记录SQL命令。虽然看起来支持多个，但是当前仅处理一个
+  int                               param_count_ = 0;  ///< 字面量常量的个数
+  const vector<Value>              *placeholder_values_ = nullptr;  ///< 占位符绑定的参数
+  int                               placeholder_count_  = 0;        ///< 占位符的个数
 };
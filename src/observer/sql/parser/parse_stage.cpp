@@ -22,6 +22,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
+#include "session/prepared_statement.h"
 #include "sql/parser/parse.h"
 
 using namespace common;
@@ -35,7 +36,16 @@ RC ParseStage::handle_request(SQLStageEvent *sql_event)
 
   ParsedSqlResult parsed_sql_result;
 
-  parse(sql.c_str(), &parsed_sql_result);
+  PreparedStatement *prepared = sql_event->session_event()->prepared_statement();
+  if (prepared != nullptr) {
+    rc = prepared->parse(sql_event->session_event()->prepared_params(), &parsed_sql_result);
+    if (OB_FAIL(rc)) {
+      sql_result->set_return_code(rc);
+      return rc;
+    }
+  } else {
+    parse(sql.c_str(), &parsed_sql_result);
+  }
   if (parsed_sql_result.sql_nodes().empty()) {
     sql_result->set_return_code(RC::SUCCESS);
     sql_result->set_state_string("");
@@ -57,6 +67,7 @@ RC ParseStage::handle_request(SQLStageEvent *sql_event)
   }
 
   sql_event->set_sql_node(std::move(sql_node));
+  sql_event->set_param_count(parsed_sql_result.param_count());
 
   return RC::SUCCESS;
 }
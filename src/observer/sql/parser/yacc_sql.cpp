@@ -0,0 +1,3624 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "yacc_sql.y"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/log/log.h"
+#include "common/lang/string.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/yacc_sql.hpp"
+#include "sql/parser/lex_sql.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/subquery_expression.h"
+#include "sql/expr/vector_func_expr.h"
+
+using namespace std;
+
+string token_name(const char *sql_string, YYLTYPE *llocp)
+{
+  return string(sql_string + llocp->first_column, llocp->last_column - llocp->first_column + 1);
+}
+
+int yyerror(YYLTYPE *llocp, const char *sql_string, ParsedSqlResult *sql_result, yyscan_t scanner, const char *msg)
+{
+  unique_ptr<ParsedSqlNode> error_sql_node = make_unique<ParsedSqlNode>(SCF_ERROR);
+  error_sql_node->error.error_msg = msg;
+  error_sql_node->error.line = llocp->first_line;
+  error_sql_node->error.column = llocp->first_column;
+  sql_result->add_sql_node(std::move(error_sql_node));
+  return 0;
+}
+
+ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
+                                             Expression *left,
+                                             Expression *right,
+                                             const char *sql_string,
+                                             YYLTYPE *llocp)
+{
+  ArithmeticExpr *expr = new ArithmeticExpr(type, left, right);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
+                                           Expression *child,
+                                           const char *sql_string,
+                                           YYLTYPE *llocp)
+{
+  UnboundAggregateExpr *expr = new UnboundAggregateExpr(aggregate_name, child);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+
+UnboundVectorFuncExpr *create_vectorfunc_expression(const char *function_name,
+                                           Expression *left_child,
+                                           Expression *right_child,
+                                           const char *sql_string,
+                                           YYLTYPE *llocp)
+{
+  UnboundVectorFuncExpr *expr = new UnboundVectorFuncExpr(function_name, left_child, right_child);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+/**
+ * INSERT 语句的一行值追加到 insertion 中，每一行值的个数必须相同。会释放 exprs
+ */
+RC append_insert_row(InsertSqlNode &insertion, vector<unique_ptr<Expression>> *exprs)
+{
+  unique_ptr<vector<unique_ptr<Expression>>> row(exprs);
+  if (insertion.row_num > 0 && insertion.values.size() != insertion.row_num * row->size()) {
+    return RC::INVALID_ARGUMENT;
+  }
+  for (const unique_ptr<Expression> &expr : *row) {
+    Value val;
+    RC    rc = expr->try_get_value(val);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    insertion.values.push_back(val);
+    insertion.placeholders.push_back(expr->type() == ExprType::VALUE
+        ? static_cast<const ValueExpr *>(expr.get())->placeholder_index() : -1);
+  }
+  insertion.row_num++;
+  return RC::SUCCESS;
+}
+
+SubQueryExpr *create_subquery_expression(ParsedSqlNode* sql_node, const char *sql_string, YYLTYPE *llocp) {
+ SubQueryExpr *expr = new SubQueryExpr(sql_node);
+ expr->set_name(token_name(sql_string, llocp));
+ return expr;
+}
+
+SubQueryExpr *create_subquery_expression(const vector<Value>& value_list) {
+ SubQueryExpr *expr = new SubQueryExpr(value_list);
+ return expr;
+}
+
+
+#line 172 "yacc_sql.cpp"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "yacc_sql.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SEMICOLON = 3,                  /* SEMICOLON  */
+  YYSYMBOL_BY = 4,                         /* BY  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_DROP = 6,                       /* DROP  */
+  YYSYMBOL_GROUP = 7,                      /* GROUP  */
+  YYSYMBOL_VIEW = 8,                       /* VIEW  */
+  YYSYMBOL_TABLE = 9,                      /* TABLE  */
+  YYSYMBOL_TABLES = 10,                    /* TABLES  */
+  YYSYMBOL_INDEX = 11,                     /* INDEX  */
+  YYSYMBOL_CALC = 12,                      /* CALC  */
+  YYSYMBOL_SELECT = 13,                    /* SELECT  */
+  YYSYMBOL_DESC = 14,                      /* DESC  */
+  YYSYMBOL_ASC = 15,                       /* ASC  */
+  YYSYMBOL_SHOW = 16,                      /* SHOW  */
+  YYSYMBOL_SYNC = 17,                      /* SYNC  */
+  YYSYMBOL_INSERT = 18,                    /* INSERT  */
+  YYSYMBOL_DELETE = 19,                    /* DELETE  */
+  YYSYMBOL_UPDATE = 20,                    /* UPDATE  */
+  YYSYMBOL_LBRACE = 21,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 22,                    /* RBRACE  */
+  YYSYMBOL_LBRACKET = 23,                  /* LBRACKET  */
+  YYSYMBOL_RBRACKET = 24,                  /* RBRACKET  */
+  YYSYMBOL_COMMA = 25,                     /* COMMA  */
+  YYSYMBOL_TRX_BEGIN = 26,                 /* TRX_BEGIN  */
+  YYSYMBOL_TRX_COMMIT = 27,                /* TRX_COMMIT  */
+  YYSYMBOL_TRX_ROLLBACK = 28,              /* TRX_ROLLBACK  */
+  YYSYMBOL_INT_T = 29,                     /* INT_T  */
+  YYSYMBOL_STRING_T = 30,                  /* STRING_T  */
+  YYSYMBOL_FLOAT_T = 31,                   /* FLOAT_T  */
+  YYSYMBOL_VECTOR_T = 32,                  /* VECTOR_T  */
+  YYSYMBOL_DATE_T = 33,                    /* DATE_T  */
+  YYSYMBOL_HELP = 34,                      /* HELP  */
+  YYSYMBOL_EXIT = 35,                      /* EXIT  */
+  YYSYMBOL_DOT = 36,                       /* DOT  */
+  YYSYMBOL_INTO = 37,                      /* INTO  */
+  YYSYMBOL_VALUES = 38,                    /* VALUES  */
+  YYSYMBOL_FROM = 39,                      /* FROM  */
+  YYSYMBOL_WHERE = 40,                     /* WHERE  */
+  YYSYMBOL_AND = 41,                       /* AND  */
+  YYSYMBOL_OR = 42,                        /* OR  */
+  YYSYMBOL_SET = 43,                       /* SET  */
+  YYSYMBOL_ON = 44,                        /* ON  */
+  YYSYMBOL_LOAD = 45,                      /* LOAD  */
+  YYSYMBOL_EXPLAIN = 46,                   /* EXPLAIN  */
+  YYSYMBOL_STORAGE = 47,                   /* STORAGE  */
+  YYSYMBOL_FORMAT = 48,                    /* FORMAT  */
+  YYSYMBOL_PRIMARY = 49,                   /* PRIMARY  */
+  YYSYMBOL_KEY = 50,                       /* KEY  */
+  YYSYMBOL_ANALYZE = 51,                   /* ANALYZE  */
+  YYSYMBOL_NOT = 52,                       /* NOT  */
+  YYSYMBOL_NULL_T = 53,                    /* NULL_T  */
+  YYSYMBOL_IS_T = 54,                      /* IS_T  */
+  YYSYMBOL_INNER_T = 55,                   /* INNER_T  */
+  YYSYMBOL_JOIN_T = 56,                    /* JOIN_T  */
+  YYSYMBOL_IN_T = 57,                      /* IN_T  */
+  YYSYMBOL_ORDER_T = 58,                   /* ORDER_T  */
+  YYSYMBOL_TEXT_T = 59,                    /* TEXT_T  */
+  YYSYMBOL_LIKE_T = 60,                    /* LIKE_T  */
+  YYSYMBOL_AS_T = 61,                      /* AS_T  */
+  YYSYMBOL_HAVING_T = 62,                  /* HAVING_T  */
+  YYSYMBOL_UNIQUE_T = 63,                  /* UNIQUE_T  */
+  YYSYMBOL_WITH_T = 64,                    /* WITH_T  */
+  YYSYMBOL_LIMIT_T = 65,                   /* LIMIT_T  */
+  YYSYMBOL_EQ = 66,                        /* EQ  */
+  YYSYMBOL_LT = 67,                        /* LT  */
+  YYSYMBOL_GT = 68,                        /* GT  */
+  YYSYMBOL_LE = 69,                        /* LE  */
+  YYSYMBOL_GE = 70,                        /* GE  */
+  YYSYMBOL_NE = 71,                        /* NE  */
+  YYSYMBOL_NUMBER = 72,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 73,                     /* FLOAT  */
+  YYSYMBOL_ID = 74,                        /* ID  */
+  YYSYMBOL_SSS = 75,                       /* SSS  */
+  YYSYMBOL_76_ = 76,                       /* '+'  */
+  YYSYMBOL_77_ = 77,                       /* '-'  */
+  YYSYMBOL_78_ = 78,                       /* '*'  */
+  YYSYMBOL_79_ = 79,                       /* '/'  */
+  YYSYMBOL_UMINUS = 80,                    /* UMINUS  */
+  YYSYMBOL_81_ = 81,                       /* '?'  */
+  YYSYMBOL_YYACCEPT = 82,                  /* $accept  */
+  YYSYMBOL_commands = 83,                  /* commands  */
+  YYSYMBOL_command_wrapper = 84,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 85,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 86,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 87,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 88,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 89,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 90,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 91,           /* drop_table_stmt  */
+  YYSYMBOL_analyze_table_stmt = 92,        /* analyze_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 93,          /* show_tables_stmt  */
+  YYSYMBOL_show_status_stmt = 94,          /* show_status_stmt  */
+  YYSYMBOL_desc_table_stmt = 95,           /* desc_table_stmt  */
+  YYSYMBOL_create_index_stmt = 96,         /* create_index_stmt  */
+  YYSYMBOL_param = 97,                     /* param  */
+  YYSYMBOL_param_list = 98,                /* param_list  */
+  YYSYMBOL_create_vector_index_stmt = 99,  /* create_vector_index_stmt  */
+  YYSYMBOL_drop_index_stmt = 100,          /* drop_index_stmt  */
+  YYSYMBOL_create_view_stmt = 101,         /* create_view_stmt  */
+  YYSYMBOL_create_table_stmt = 102,        /* create_table_stmt  */
+  YYSYMBOL_attr_def_list = 103,            /* attr_def_list  */
+  YYSYMBOL_null_opt = 104,                 /* null_opt  */
+  YYSYMBOL_attr_def = 105,                 /* attr_def  */
+  YYSYMBOL_number = 106,                   /* number  */
+  YYSYMBOL_limit_opt = 107,                /* limit_opt  */
+  YYSYMBOL_type = 108,                     /* type  */
+  YYSYMBOL_primary_key = 109,              /* primary_key  */
+  YYSYMBOL_attr_list = 110,                /* attr_list  */
+  YYSYMBOL_insert_stmt = 111,              /* insert_stmt  */
+  YYSYMBOL_insert_rows = 112,              /* insert_rows  */
+  YYSYMBOL_number_list = 113,              /* number_list  */
+  YYSYMBOL_value = 114,                    /* value  */
+  YYSYMBOL_value_list = 115,               /* value_list  */
+  YYSYMBOL_storage_format = 116,           /* storage_format  */
+  YYSYMBOL_delete_stmt = 117,              /* delete_stmt  */
+  YYSYMBOL_assignment = 118,               /* assignment  */
+  YYSYMBOL_assignment_list = 119,          /* assignment_list  */
+  YYSYMBOL_update_stmt = 120,              /* update_stmt  */
+  YYSYMBOL_select_stmt = 121,              /* select_stmt  */
+  YYSYMBOL_select_stmt_opt = 122,          /* select_stmt_opt  */
+  YYSYMBOL_calc_stmt = 123,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 124,          /* expression_list  */
+  YYSYMBOL_expression = 125,               /* expression  */
+  YYSYMBOL_boolean_primary = 126,          /* boolean_primary  */
+  YYSYMBOL_predicate = 127,                /* predicate  */
+  YYSYMBOL_bit_expr = 128,                 /* bit_expr  */
+  YYSYMBOL_simple_expr = 129,              /* simple_expr  */
+  YYSYMBOL_subquery_expr = 130,            /* subquery_expr  */
+  YYSYMBOL_rel_attr = 131,                 /* rel_attr  */
+  YYSYMBOL_relation = 132,                 /* relation  */
+  YYSYMBOL_table_refs = 133,               /* table_refs  */
+  YYSYMBOL_table_factor = 134,             /* table_factor  */
+  YYSYMBOL_joined_table = 135,             /* joined_table  */
+  YYSYMBOL_where = 136,                    /* where  */
+  YYSYMBOL_comp_op = 137,                  /* comp_op  */
+  YYSYMBOL_in_opt = 138,                   /* in_opt  */
+  YYSYMBOL_like_opt = 139,                 /* like_opt  */
+  YYSYMBOL_alias_opt = 140,                /* alias_opt  */
+  YYSYMBOL_unique_opt = 141,               /* unique_opt  */
+  YYSYMBOL_group_by = 142,                 /* group_by  */
+  YYSYMBOL_order_by_entry = 143,           /* order_by_entry  */
+  YYSYMBOL_order_by_list = 144,            /* order_by_list  */
+  YYSYMBOL_order_by = 145,                 /* order_by  */
+  YYSYMBOL_explain_stmt = 146,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 147,        /* set_variable_stmt  */
+  YYSYMBOL_load_data_stmt = 148,           /* load_data_stmt  */
+  YYSYMBOL_opt_semicolon = 149             /* opt_semicolon  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  85
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   314
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  82
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  68
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  165
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  300
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   331
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,    78,    76,     2,    77,     2,    79,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    81,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    80
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   292,   292,   300,   301,   302,   303,   304,   305,   306,
+     307,   308,   309,   310,   311,   312,   313,   314,   315,   316,
+     317,   318,   319,   320,   321,   322,   323,   327,   333,   338,
+     344,   350,   356,   362,   368,   375,   381,   395,   402,   417,
+     423,   432,   437,   449,   462,   470,   478,   490,   519,   537,
+     540,   554,   557,   561,   568,   581,   591,   595,   598,   604,
+     605,   606,   607,   608,   609,   613,   616,   623,   627,   639,
+     647,   656,   668,   672,   676,   685,   697,   701,   705,   710,
+     715,   723,   733,   751,   754,   761,   772,   780,   785,   798,
+     812,   844,   847,   850,   856,   865,   876,   891,   894,   898,
+     905,   909,   915,   918,   922,   928,   936,   939,   942,   945,
+     948,   954,   963,   978,   984,   987,   990,   994,   997,  1000,
+    1003,  1009,  1015,  1019,  1027,  1033,  1036,  1042,  1053,  1060,
+    1072,  1075,  1081,  1082,  1083,  1084,  1085,  1086,  1087,  1088,
+    1094,  1095,  1099,  1100,  1104,  1107,  1110,  1115,  1118,  1124,
+    1127,  1133,  1141,  1146,  1151,  1158,  1162,  1173,  1176,  1182,
+    1187,  1196,  1203,  1215,  1229,  1230
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "SEMICOLON", "BY",
+  "CREATE", "DROP", "GROUP", "VIEW", "TABLE", "TABLES", "INDEX", "CALC",
+  "SELECT", "DESC", "ASC", "SHOW", "SYNC", "INSERT", "DELETE", "UPDATE",
+  "LBRACE", "RBRACE", "LBRACKET", "RBRACKET", "COMMA", "TRX_BEGIN",
+  "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "STRING_T", "FLOAT_T", "VECTOR_T",
+  "DATE_T", "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM", "WHERE",
+  "AND", "OR", "SET", "ON", "LOAD", "EXPLAIN", "STORAGE", "FORMAT",
+  "PRIMARY", "KEY", "ANALYZE", "NOT", "NULL_T", "IS_T", "INNER_T",
+  "JOIN_T", "IN_T", "ORDER_T", "TEXT_T", "LIKE_T", "AS_T", "HAVING_T",
+  "UNIQUE_T", "WITH_T", "LIMIT_T", "EQ", "LT", "GT", "LE", "GE", "NE",
+  "NUMBER", "FLOAT", "ID", "SSS", "'+'", "'-'", "'*'", "'/'", "UMINUS",
+  "'?'", "$accept", "commands", "command_wrapper", "exit_stmt",
+  "help_stmt", "sync_stmt", "begin_stmt", "commit_stmt", "rollback_stmt",
+  "drop_table_stmt", "analyze_table_stmt", "show_tables_stmt",
+  "show_status_stmt", "desc_table_stmt", "create_index_stmt", "param",
+  "param_list", "create_vector_index_stmt", "drop_index_stmt",
+  "create_view_stmt", "create_table_stmt", "attr_def_list", "null_opt",
+  "attr_def", "number", "limit_opt", "type", "primary_key", "attr_list",
+  "insert_stmt", "insert_rows", "number_list", "value", "value_list",
+  "storage_format", "delete_stmt", "assignment", "assignment_list",
+  "update_stmt", "select_stmt", "select_stmt_opt", "calc_stmt",
+  "expression_list", "expression", "boolean_primary", "predicate",
+  "bit_expr", "simple_expr", "subquery_expr", "rel_attr", "relation",
+  "table_refs", "table_factor", "joined_table", "where", "comp_op",
+  "in_opt", "like_opt", "alias_opt", "unique_opt", "group_by",
+  "order_by_entry", "order_by_list", "order_by", "explain_stmt",
+  "set_variable_stmt", "load_data_stmt", "opt_semicolon", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-203)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     159,    12,   149,    19,    19,   -65,    -5,  -203,   -15,    38,
+     -45,  -203,  -203,  -203,  -203,  -203,   -33,   -21,   212,    15,
+      58,    92,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,
+    -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,
+    -203,  -203,  -203,  -203,  -203,  -203,    31,    45,   112,  -203,
+     122,    74,    78,   -10,    68,  -203,  -203,  -203,    -6,  -203,
+      19,  -203,  -203,  -203,  -203,   -25,   130,  -203,    30,  -203,
+    -203,  -203,   116,  -203,  -203,  -203,    94,    96,  -203,   119,
+      14,   100,   108,  -203,   106,  -203,  -203,  -203,   -13,     5,
+     118,   129,  -203,   163,   186,    57,   187,   188,   190,    19,
+     -55,  -203,    19,    19,   142,  -203,   194,   168,  -203,  -203,
+    -203,  -203,  -203,  -203,    19,    24,  -203,  -203,    19,    19,
+      19,    19,   201,    19,   -45,   177,   183,   153,   -16,  -203,
+     158,  -203,  -203,   161,   223,   169,   223,  -203,   195,   193,
+     200,   174,  -203,  -203,    68,    68,  -203,    90,  -203,  -203,
+    -203,  -203,  -203,    19,  -203,  -203,  -203,  -203,    88,    88,
+    -203,  -203,   -10,  -203,  -203,    55,    49,  -203,  -203,   228,
+      19,  -203,   184,   226,   183,  -203,   215,   229,   231,  -203,
+       2,  -203,  -203,   208,  -203,   185,   191,  -203,  -203,  -203,
+    -203,    19,  -203,   238,    61,  -203,   -45,   205,   255,    19,
+     239,   141,    19,   153,  -203,   257,   161,   206,  -203,  -203,
+    -203,  -203,  -203,  -203,    -7,   243,   203,   249,   250,   115,
+    -203,    19,  -203,   -45,   268,   216,   251,   254,   141,  -203,
+     202,  -203,   223,   207,   224,  -203,  -203,    27,   256,   209,
+     210,   161,  -203,  -203,   236,    19,   277,   217,  -203,    19,
+    -203,  -203,  -203,   263,  -203,   237,  -203,    -1,  -203,   264,
+     266,    19,   227,    19,   207,  -203,   269,   136,   271,   195,
+     230,  -203,   141,    19,    13,   265,  -203,  -203,  -203,  -203,
+     161,  -203,   272,   141,  -203,  -203,    19,   273,   222,  -203,
+    -203,   232,   274,   275,    89,   222,  -203,  -203,  -203,  -203
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,   147,     0,     0,     0,     0,     0,    29,     0,     0,
+       0,    30,    31,    32,    28,    27,     0,     0,     0,     0,
+       0,   164,    26,    25,    18,    19,    20,    21,    10,    11,
+      12,    13,    14,    15,    16,    17,     8,     9,     5,     7,
+       6,     4,     3,    22,    23,    24,     0,     0,     0,   148,
+       0,     0,     0,     0,     0,    80,    76,    77,   122,    78,
+       0,   114,   112,   111,    94,   144,    97,   101,   102,   110,
+     120,   113,     0,    37,    35,    36,     0,     0,   124,     0,
+       0,     0,     0,   159,     0,     1,   165,     2,     0,    91,
+       0,     0,    33,     0,     0,     0,    72,    73,     0,     0,
+       0,   117,     0,     0,     0,   145,    95,   138,   132,   133,
+     134,   135,   136,   137,     0,     0,   140,   142,     0,     0,
+       0,     0,     0,     0,     0,     0,   130,     0,     0,   162,
+       0,   160,    34,     0,     0,     0,     0,    92,    83,     0,
+       0,     0,   121,   116,     0,     0,    79,     0,   123,   115,
+      98,    99,   146,     0,   139,   100,   141,   143,   106,   107,
+     108,   109,     0,   105,   103,   144,   130,   125,   126,     0,
+       0,    85,     0,    87,   130,   161,     0,    67,     0,    45,
+       0,    49,    93,     0,    48,     0,     0,    44,    74,    75,
+     118,     0,    96,     0,    81,   127,     0,     0,   149,     0,
+      69,   131,     0,     0,    89,     0,     0,     0,    59,    60,
+      61,    62,    63,    64,    51,    65,     0,     0,     0,     0,
+     104,     0,   128,     0,     0,   157,     0,     0,    86,    88,
+       0,    68,     0,     0,     0,    52,    55,     0,     0,     0,
+       0,     0,   119,    82,     0,     0,     0,    57,    70,     0,
+     163,    46,    56,     0,    53,     0,    50,    91,    84,     0,
+       0,     0,   150,     0,     0,    90,     0,    51,     0,    83,
+       0,    38,   129,     0,   152,   155,   158,    58,    71,    54,
+       0,    47,     0,   151,   154,   153,     0,     0,     0,   156,
+      66,     0,    41,     0,     0,     0,    43,    40,    39,    42
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -203,  -203,   -12,  -203,  -203,  -203,  -203,  -203,  -203,  -203,
+    -203,  -203,  -203,  -203,  -203,  -203,     6,  -203,  -203,  -203,
+    -203,  -203,    33,    65,    39,  -203,  -203,  -203,  -202,  -203,
+    -203,    46,   176,    84,    37,  -203,  -203,   104,  -203,   -51,
+      51,  -203,    -4,   -52,  -203,   196,    26,   -50,   189,  -203,
+     299,  -203,  -171,  -203,   -36,  -203,  -203,  -203,   147,  -203,
+    -203,  -203,    28,  -203,  -203,  -203,  -203,  -203
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,   292,   293,    34,    35,    36,
+      37,   215,   236,   181,   253,   265,   214,   238,   178,    38,
+     200,    98,    63,   193,   184,    39,   173,   174,    40,    41,
+     138,    42,    64,    65,    66,    67,    68,    69,    70,    71,
+     165,   166,   167,   168,   171,   114,   122,   123,   106,    50,
+     225,   275,   276,   247,    43,    44,    45,    87
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      72,    95,    94,     4,   231,    74,    83,    54,   133,    73,
+     101,    53,     4,    54,   233,    99,   102,   103,     4,   148,
+      46,    47,    76,   149,    84,   222,   135,   284,   285,    78,
+     100,   208,   209,   210,   211,   212,   104,    55,   137,   260,
+      53,    80,    54,    55,    48,   234,   235,   147,   134,   105,
+     150,   151,   244,    81,   102,   103,    56,    57,    85,    59,
+     136,   213,    56,    57,    58,    59,   136,    60,    61,    75,
+     131,    62,    55,   164,   196,    49,   255,    77,   287,   143,
+     128,   156,   115,   179,   157,   182,   221,   116,   129,   170,
+     117,    56,    57,    58,    59,    86,    60,    61,   102,   103,
+      62,   180,   102,   103,   197,    88,   118,   119,   120,   121,
+     194,    94,   190,     1,     2,   191,   104,    84,   201,    89,
+       3,     4,     5,    90,     6,     7,     8,     9,    10,   105,
+     198,   102,   103,    91,    11,    12,    13,   242,   204,   219,
+      96,    97,    14,    15,   158,   159,   160,   161,    92,   192,
+     228,    16,    93,    17,    18,   124,   102,   103,    51,    19,
+      52,   297,   127,   298,     1,     2,   120,   121,   125,   194,
+     126,     3,     4,     5,   130,     6,     7,     8,     9,    10,
+     132,   251,   102,   103,   107,    11,    12,    13,   234,   235,
+     188,   189,   139,    14,    15,   226,   108,   109,   110,   111,
+     112,   113,    16,   140,    17,    18,   137,   141,   142,   272,
+      19,   274,   144,   145,   146,   169,   152,     1,     2,   153,
+     154,   283,   162,   170,     3,     4,     5,   172,     6,     7,
+       8,     9,    10,   176,   274,   177,     4,   185,    11,    12,
+      13,   262,   183,   180,   186,   266,    14,    15,   187,   199,
+     202,   203,   205,   207,   206,    16,   216,    17,    18,   217,
+     220,   223,   224,    82,   227,   218,   230,   232,   237,   239,
+     240,   241,   245,   248,   246,   249,   250,   254,   257,   252,
+     261,   263,   264,   258,   259,   267,   270,   268,   271,   273,
+     286,   278,   280,   288,   282,   290,   291,   296,   294,   295,
+     279,   299,   256,   277,   175,   243,   281,   229,   269,    79,
+     155,   163,   195,     0,   289
+};
+
+static const yytype_int16 yycheck[] =
+{
+       4,    53,    53,    13,   206,    10,    18,    23,    21,    74,
+      60,    21,    13,    23,    21,    21,    41,    42,    13,    74,
+       8,     9,    37,    78,     9,   196,    21,    14,    15,    74,
+      36,    29,    30,    31,    32,    33,    61,    53,    89,   241,
+      21,    74,    23,    53,    32,    52,    53,    99,    61,    74,
+     102,   103,   223,    74,    41,    42,    72,    73,     0,    75,
+      61,    59,    72,    73,    74,    75,    61,    77,    78,    74,
+      82,    81,    53,   123,    25,    63,    49,    39,   280,    22,
+      66,    57,    52,   134,    60,   136,    25,    57,    74,    40,
+      60,    72,    73,    74,    75,     3,    77,    78,    41,    42,
+      81,    74,    41,    42,    55,    74,    76,    77,    78,    79,
+     162,   162,    22,     5,     6,    25,    61,     9,   170,    74,
+      12,    13,    14,    11,    16,    17,    18,    19,    20,    74,
+     166,    41,    42,    11,    26,    27,    28,    22,   174,   191,
+      72,    73,    34,    35,   118,   119,   120,   121,    74,   153,
+     202,    43,    74,    45,    46,    39,    41,    42,     9,    51,
+      11,    72,    43,    74,     5,     6,    78,    79,    74,   221,
+      74,    12,    13,    14,    74,    16,    17,    18,    19,    20,
+      74,   232,    41,    42,    54,    26,    27,    28,    52,    53,
+     144,   145,    74,    34,    35,   199,    66,    67,    68,    69,
+      70,    71,    43,    74,    45,    46,   257,    44,    22,   261,
+      51,   263,    25,    25,    24,    38,    74,     5,     6,    25,
+      52,   273,    21,    40,    12,    13,    14,    74,    16,    17,
+      18,    19,    20,    75,   286,    74,    13,    44,    26,    27,
+      28,   245,    47,    74,    44,   249,    34,    35,    74,    21,
+      66,    25,    37,    22,    25,    43,    48,    45,    46,    74,
+      22,    56,     7,    51,    25,    74,     9,    61,    25,    66,
+      21,    21,     4,    22,    58,    21,    74,    53,    22,    72,
+      44,     4,    65,    74,    74,    22,    22,    50,    22,    62,
+      25,    22,    21,    21,    64,    22,    74,    22,    66,    25,
+     267,   295,   237,   264,   128,   221,   269,   203,   257,    10,
+     114,   122,   165,    -1,   286
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,     5,     6,    12,    13,    14,    16,    17,    18,    19,
+      20,    26,    27,    28,    34,    35,    43,    45,    46,    51,
+      83,    84,    85,    86,    87,    88,    89,    90,    91,    92,
+      93,    94,    95,    96,    99,   100,   101,   102,   111,   117,
+     120,   121,   123,   146,   147,   148,     8,     9,    32,    63,
+     141,     9,    11,    21,    23,    53,    72,    73,    74,    75,
+      77,    78,    81,   114,   124,   125,   126,   127,   128,   129,
+     130,   131,   124,    74,    10,    74,    37,    39,    74,   132,
+      74,    74,    51,    84,     9,     0,     3,   149,    74,    74,
+      11,    11,    74,    74,   121,   125,    72,    73,   113,    21,
+      36,   129,    41,    42,    61,    74,   140,    54,    66,    67,
+      68,    69,    70,    71,   137,    52,    57,    60,    76,    77,
+      78,    79,   138,   139,    39,    74,    74,    43,    66,    74,
+      74,    84,    74,    21,    61,    21,    61,   121,   122,    74,
+      74,    44,    22,    22,    25,    25,    24,   125,    74,    78,
+     125,   125,    74,    25,    52,   127,    57,    60,   128,   128,
+     128,   128,    21,   130,   129,   132,   133,   134,   135,    38,
+      40,   136,    74,   118,   119,   114,    75,    74,   110,   121,
+      74,   105,   121,    47,   116,    44,    44,    74,   113,   113,
+      22,    25,   124,   115,   125,   140,    25,    55,   136,    21,
+     112,   125,    66,    25,   136,    37,    25,    22,    29,    30,
+      31,    32,    33,    59,   108,   103,    48,    74,    74,   125,
+      22,    25,   134,    56,     7,   142,   124,    25,   125,   119,
+       9,   110,    61,    21,    52,    53,   104,    25,   109,    66,
+      21,    21,    22,   115,   134,     4,    58,   145,    22,    21,
+      74,   121,    72,   106,    53,    49,   105,    22,    74,    74,
+     110,    44,   124,     4,    65,   107,   124,    22,    50,   122,
+      22,    22,   125,    62,   125,   143,   144,   106,    22,   104,
+      21,   116,    64,   125,    14,    15,    25,   110,    21,   144,
+      22,    74,    97,    98,    66,    25,    22,    72,    74,    98
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    82,    83,    84,    84,    84,    84,    84,    84,    84,
+      84,    84,    84,    84,    84,    84,    84,    84,    84,    84,
+      84,    84,    84,    84,    84,    84,    84,    85,    86,    87,
+      88,    89,    90,    91,    92,    93,    94,    95,    96,    97,
+      97,    98,    98,    99,   100,   101,   101,   102,   102,   103,
+     103,   104,   104,   104,   105,   105,   106,   107,   107,   108,
+     108,   108,   108,   108,   108,   109,   109,   110,   110,   111,
+     112,   112,   113,   113,   113,   113,   114,   114,   114,   114,
+     114,   115,   115,   116,   116,   117,   118,   119,   119,   120,
+     121,   122,   122,   122,   123,   124,   124,   125,   125,   125,
+     126,   126,   127,   127,   127,   127,   128,   128,   128,   128,
+     128,   129,   129,   129,   129,   129,   129,   129,   129,   129,
+     129,   130,   131,   131,   132,   133,   133,   134,   135,   135,
+     136,   136,   137,   137,   137,   137,   137,   137,   137,   137,
+     138,   138,   139,   139,   140,   140,   140,   141,   141,   142,
+     142,   142,   143,   143,   143,   144,   144,   145,   145,   146,
+     146,   147,   147,   148,   149,   149
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     3,     3,     2,     2,     2,     9,     3,
+       3,     1,     3,    13,     5,     5,     8,    10,     5,     0,
+       3,     0,     1,     2,     6,     3,     1,     0,     2,     1,
+       1,     1,     1,     1,     1,     0,     6,     1,     3,     5,
+       3,     5,     1,     1,     3,     3,     1,     1,     1,     3,
+       1,     1,     3,     0,     4,     4,     3,     1,     3,     5,
+       8,     0,     1,     2,     2,     2,     4,     1,     3,     3,
+       3,     1,     1,     3,     5,     3,     3,     3,     3,     3,
+       1,     1,     1,     1,     1,     3,     3,     2,     4,     6,
+       1,     3,     1,     3,     1,     1,     1,     2,     3,     6,
+       0,     2,     1,     1,     1,     1,     1,     1,     1,     2,
+       1,     2,     1,     2,     0,     1,     2,     0,     1,     0,
+       3,     5,     1,     2,     2,     1,     3,     0,     3,     2,
+       3,     4,     3,     7,     0,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, sql_string, sql_result, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, sql_string, sql_result, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, sql_string, sql_result, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), sql_string, sql_result, scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, sql_string, sql_result, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* commands: command_wrapper opt_semicolon  */
+#line 293 "yacc_sql.y"
+  {
+    unique_ptr<ParsedSqlNode> sql_node = unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
+    sql_result->add_sql_node(std::move(sql_node));
+  }
+#line 1940 "yacc_sql.cpp"
+    break;
+
+  case 27: /* exit_stmt: EXIT  */
+#line 327 "yacc_sql.y"
+         {
+      (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
+    }
+#line 1949 "yacc_sql.cpp"
+    break;
+
+  case 28: /* help_stmt: HELP  */
+#line 333 "yacc_sql.y"
+         {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
+    }
+#line 1957 "yacc_sql.cpp"
+    break;
+
+  case 29: /* sync_stmt: SYNC  */
+#line 338 "yacc_sql.y"
+         {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
+    }
+#line 1965 "yacc_sql.cpp"
+    break;
+
+  case 30: /* begin_stmt: TRX_BEGIN  */
+#line 344 "yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
+    }
+#line 1973 "yacc_sql.cpp"
+    break;
+
+  case 31: /* commit_stmt: TRX_COMMIT  */
+#line 350 "yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
+    }
+#line 1981 "yacc_sql.cpp"
+    break;
+
+  case 32: /* rollback_stmt: TRX_ROLLBACK  */
+#line 356 "yacc_sql.y"
+                  {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
+    }
+#line 1989 "yacc_sql.cpp"
+    break;
+
+  case 33: /* drop_table_stmt: DROP TABLE ID  */
+#line 362 "yacc_sql.y"
+                  {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
+      (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].cstring);
+    }
+#line 1998 "yacc_sql.cpp"
+    break;
+
+  case 34: /* analyze_table_stmt: ANALYZE TABLE ID  */
+#line 368 "yacc_sql.y"
+                     {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+      (yyval.sql_node)->analyze_table.relation_name = (yyvsp[0].cstring);
+    }
+#line 2007 "yacc_sql.cpp"
+    break;
+
+  case 35: /* show_tables_stmt: SHOW TABLES  */
+#line 375 "yacc_sql.y"
+                {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
+    }
+#line 2015 "yacc_sql.cpp"
+    break;
+
+  case 36: /* show_status_stmt: SHOW ID  */
+#line 381 "yacc_sql.y"
+            {
+      // 不把STATUS作为关键字，避免与字段名冲突
+      if (0 == strcasecmp((yyvsp[0].cstring), "status")) {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_STATUS);
+      } else {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_ERROR);
+        (yyval.sql_node)->error.error_msg = "syntax error";
+        (yyval.sql_node)->error.line = (yylsp[0]).first_line;
+        (yyval.sql_node)->error.column = (yylsp[0]).first_column;
+      }
+    }
+#line 2031 "yacc_sql.cpp"
+    break;
+
+  case 37: /* desc_table_stmt: DESC ID  */
+#line 395 "yacc_sql.y"
+             {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
+      (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].cstring);
+    }
+#line 2040 "yacc_sql.cpp"
+    break;
+
+  case 38: /* create_index_stmt: CREATE unique_opt INDEX ID ON ID LBRACE attr_list RBRACE  */
+#line 403 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+      CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+      create_index.is_unique = (yyvsp[-7].boolean);
+      create_index.index_name = (yyvsp[-5].cstring);
+      create_index.relation_name = (yyvsp[-3].cstring);
+      // create_index.attribute_name = $7;
+      create_index.attr_names.swap(*(yyvsp[-1].key_list));
+      delete (yyvsp[-1].key_list);
+    }
+#line 2055 "yacc_sql.cpp"
+    break;
+
+  case 39: /* param: ID EQ ID  */
+#line 418 "yacc_sql.y"
+    {
+      (yyval.param) = new Param();
+      (yyval.param)->key = (yyvsp[-2].cstring);
+      (yyval.param)->value = (yyvsp[0].cstring);
+    }
+#line 2065 "yacc_sql.cpp"
+    break;
+
+  case 40: /* param: ID EQ NUMBER  */
+#line 424 "yacc_sql.y"
+    {
+      (yyval.param) = new Param();
+      (yyval.param)->key = (yyvsp[-2].cstring);
+      (yyval.param)->value = std::to_string((yyvsp[0].number));
+    }
+#line 2075 "yacc_sql.cpp"
+    break;
+
+  case 41: /* param_list: param  */
+#line 433 "yacc_sql.y"
+    {
+      (yyval.param_list) = new vector<unique_ptr<Param>>;
+      (yyval.param_list)->emplace_back((yyvsp[0].param));
+    }
+#line 2084 "yacc_sql.cpp"
+    break;
+
+  case 42: /* param_list: param COMMA param_list  */
+#line 438 "yacc_sql.y"
+    {
+      if ((yyvsp[0].param_list) != nullptr) {
+        (yyval.param_list) = (yyvsp[0].param_list);
+      } else {
+        (yyval.param_list) = new vector<unique_ptr<Param>>;
+      }
+      (yyval.param_list)->emplace((yyval.param_list)->begin(), (yyvsp[-2].param));
+    }
+#line 2097 "yacc_sql.cpp"
+    break;
+
+  case 43: /* create_vector_index_stmt: CREATE VECTOR_T INDEX ID ON ID LBRACE ID RBRACE WITH_T LBRACE param_list RBRACE  */
+#line 450 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VECTOR_INDEX);
+      CreateVectorIndexSqlNode &create_vector_index = (yyval.sql_node)->create_vector_index;
+      create_vector_index.index_name = (yyvsp[-9].cstring);
+      create_vector_index.relation_name = (yyvsp[-7].cstring);
+      create_vector_index.attr_name = (yyvsp[-5].cstring);
+      create_vector_index.param_list.swap(*(yyvsp[-1].param_list));
+      delete (yyvsp[-1].param_list);
+    }
+#line 2111 "yacc_sql.cpp"
+    break;
+
+  case 44: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 463 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
+      (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].cstring);
+      (yyval.sql_node)->drop_index.relation_name = (yyvsp[0].cstring);
+    }
+#line 2121 "yacc_sql.cpp"
+    break;
+
+  case 45: /* create_view_stmt: CREATE VIEW ID AS_T select_stmt  */
+#line 471 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
+      CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
+      create_view.view_name = (yyvsp[-2].cstring);
+      create_view.select_sql = token_name(sql_string, &(yylsp[0]));
+      delete (yyvsp[0].sql_node);
+    }
+#line 2133 "yacc_sql.cpp"
+    break;
+
+  case 46: /* create_view_stmt: CREATE VIEW ID LBRACE attr_list RBRACE AS_T select_stmt  */
+#line 479 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
+      CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
+      create_view.view_name = (yyvsp[-5].cstring);
+      create_view.attr_names.swap(*(yyvsp[-3].key_list));
+      delete (yyvsp[-3].key_list);
+      create_view.select_sql = token_name(sql_string, &(yylsp[0]));
+      delete (yyvsp[0].sql_node);
+    }
+#line 2147 "yacc_sql.cpp"
+    break;
+
+  case 47: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list primary_key RBRACE select_stmt_opt storage_format  */
+#line 491 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-7].cstring);
+
+      vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-4].attr_infos);
+
+      if (src_attrs != nullptr) {
+        create_table.attr_infos.swap(*src_attrs);
+        delete src_attrs;
+      }
+      create_table.attr_infos.emplace_back(*(yyvsp[-5].attr_info));
+      reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
+      delete (yyvsp[-5].attr_info);
+      if ((yyvsp[-3].key_list) != nullptr) {
+        create_table.primary_keys.swap(*(yyvsp[-3].key_list));
+        delete (yyvsp[-3].key_list);
+      }
+      if ((yyvsp[-1].sql_node) != nullptr) {
+        create_table.select_sql_node = &((yyvsp[-1].sql_node)->selection);
+      }
+      else {
+        create_table.select_sql_node = nullptr;
+      }
+      if ((yyvsp[0].cstring) != nullptr) {
+        create_table.storage_format = (yyvsp[0].cstring);
+      }
+    }
+#line 2180 "yacc_sql.cpp"
+    break;
+
+  case 48: /* create_table_stmt: CREATE TABLE ID select_stmt_opt storage_format  */
+#line 519 "yacc_sql.y"
+                                                     {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-2].cstring);
+      if ((yyvsp[-1].sql_node) != nullptr) {
+        create_table.select_sql_node = &((yyvsp[-1].sql_node)->selection);
+      }
+      else {
+        create_table.select_sql_node = nullptr;
+      }
+      if ((yyvsp[0].cstring) != nullptr) {
+        create_table.storage_format = (yyvsp[0].cstring);
+      }
+    }
+#line 2199 "yacc_sql.cpp"
+    break;
+
+  case 49: /* attr_def_list: %empty  */
+#line 537 "yacc_sql.y"
+    {
+      (yyval.attr_infos) = nullptr;
+    }
+#line 2207 "yacc_sql.cpp"
+    break;
+
+  case 50: /* attr_def_list: attr_def_list COMMA attr_def  */
+#line 541 "yacc_sql.y"
+    {
+      if ((yyvsp[-2].attr_infos) != nullptr) {
+        (yyval.attr_infos) = (yyvsp[-2].attr_infos);
+      } else {
+        (yyval.attr_infos) = new vector<AttrInfoSqlNode>;
+      }
+      (yyval.attr_infos)->insert((yyval.attr_infos)->begin(), *(yyvsp[0].attr_info));
+      delete (yyvsp[0].attr_info);
+    }
+#line 2221 "yacc_sql.cpp"
+    break;
+
+  case 51: /* null_opt: %empty  */
+#line 554 "yacc_sql.y"
+    {
+      (yyval.boolean) = true;
+    }
+#line 2229 "yacc_sql.cpp"
+    break;
+
+  case 52: /* null_opt: NULL_T  */
+#line 558 "yacc_sql.y"
+    {
+      (yyval.boolean) = true;
+    }
+#line 2237 "yacc_sql.cpp"
+    break;
+
+  case 53: /* null_opt: NOT NULL_T  */
+#line 562 "yacc_sql.y"
+    {
+      (yyval.boolean) = false;
+    }
+#line 2245 "yacc_sql.cpp"
+    break;
+
+  case 54: /* attr_def: ID type LBRACE number RBRACE null_opt  */
+#line 569 "yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
+      (yyval.attr_info)->name = (yyvsp[-5].cstring);
+      if ((yyval.attr_info)->type == AttrType::VECTORS) {
+        (yyval.attr_info)->length = (yyvsp[-2].number) * sizeof(float);
+      }
+      else {
+        (yyval.attr_info)->length = (yyvsp[-2].number);
+      }
+      (yyval.attr_info)->nullable = (yyvsp[0].boolean);
+    }
+#line 2262 "yacc_sql.cpp"
+    break;
+
+  case 55: /* attr_def: ID type null_opt  */
+#line 582 "yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
+      (yyval.attr_info)->name = (yyvsp[-2].cstring);
+      (yyval.attr_info)->length = 4;
+      (yyval.attr_info)->nullable = (yyvsp[0].boolean);
+    }
+#line 2274 "yacc_sql.cpp"
+    break;
+
+  case 56: /* number: NUMBER  */
+#line 591 "yacc_sql.y"
+           {(yyval.number) = (yyvsp[0].number);}
+#line 2280 "yacc_sql.cpp"
+    break;
+
+  case 57: /* limit_opt: %empty  */
+#line 595 "yacc_sql.y"
+    {
+      (yyval.number) = -1;
+    }
+#line 2288 "yacc_sql.cpp"
+    break;
+
+  case 58: /* limit_opt: LIMIT_T number  */
+#line 598 "yacc_sql.y"
+                     {
+      (yyval.number) = (yyvsp[0].number);
+    }
+#line 2296 "yacc_sql.cpp"
+    break;
+
+  case 59: /* type: INT_T  */
+#line 604 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::INTS); }
+#line 2302 "yacc_sql.cpp"
+    break;
+
+  case 60: /* type: STRING_T  */
+#line 605 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::CHARS); }
+#line 2308 "yacc_sql.cpp"
+    break;
+
+  case 61: /* type: FLOAT_T  */
+#line 606 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::FLOATS); }
+#line 2314 "yacc_sql.cpp"
+    break;
+
+  case 62: /* type: VECTOR_T  */
+#line 607 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::VECTORS); }
+#line 2320 "yacc_sql.cpp"
+    break;
+
+  case 63: /* type: DATE_T  */
+#line 608 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::DATES); }
+#line 2326 "yacc_sql.cpp"
+    break;
+
+  case 64: /* type: TEXT_T  */
+#line 609 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::TEXT); }
+#line 2332 "yacc_sql.cpp"
+    break;
+
+  case 65: /* primary_key: %empty  */
+#line 613 "yacc_sql.y"
+    {
+      (yyval.key_list) = nullptr;
+    }
+#line 2340 "yacc_sql.cpp"
+    break;
+
+  case 66: /* primary_key: COMMA PRIMARY KEY LBRACE attr_list RBRACE  */
+#line 617 "yacc_sql.y"
+    {
+      (yyval.key_list) = (yyvsp[-1].key_list);
+    }
+#line 2348 "yacc_sql.cpp"
+    break;
+
+  case 67: /* attr_list: ID  */
+#line 623 "yacc_sql.y"
+       {
+      (yyval.key_list) = new vector<string>();
+      (yyval.key_list)->push_back((yyvsp[0].cstring));
+    }
+#line 2357 "yacc_sql.cpp"
+    break;
+
+  case 68: /* attr_list: ID COMMA attr_list  */
+#line 627 "yacc_sql.y"
+                         {
+      if ((yyvsp[0].key_list) != nullptr) {
+        (yyval.key_list) = (yyvsp[0].key_list);
+      } else {
+        (yyval.key_list) = new vector<string>;
+      }
+
+      (yyval.key_list)->insert((yyval.key_list)->begin(), (yyvsp[-2].cstring));
+    }
+#line 2371 "yacc_sql.cpp"
+    break;
+
+  case 69: /* insert_stmt: INSERT INTO ID VALUES insert_rows  */
+#line 640 "yacc_sql.y"
+    {
+      (yyval.sql_node) = (yyvsp[0].sql_node);
+      (yyval.sql_node)->insertion.relation_name = (yyvsp[-2].cstring);
+    }
+#line 2380 "yacc_sql.cpp"
+    break;
+
+  case 70: /* insert_rows: LBRACE expression_list RBRACE  */
+#line 648 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
+      if (OB_FAIL(append_insert_row((yyval.sql_node)->insertion, (yyvsp[-1].expression_list)))) {
+        delete (yyval.sql_node);
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "invalid insert values");
+        YYERROR;
+      }
+    }
+#line 2393 "yacc_sql.cpp"
+    break;
+
+  case 71: /* insert_rows: insert_rows COMMA LBRACE expression_list RBRACE  */
+#line 657 "yacc_sql.y"
+    {
+      (yyval.sql_node) = (yyvsp[-4].sql_node);
+      if (OB_FAIL(append_insert_row((yyval.sql_node)->insertion, (yyvsp[-1].expression_list)))) {
+        delete (yyval.sql_node);
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "invalid insert values");
+        YYERROR;
+      }
+    }
+#line 2406 "yacc_sql.cpp"
+    break;
+
+  case 72: /* number_list: NUMBER  */
+#line 668 "yacc_sql.y"
+           {
+      (yyval.number_list) = new vector<float>();
+      (yyval.number_list)->push_back((float)(yyvsp[0].number));
+    }
+#line 2415 "yacc_sql.cpp"
+    break;
+
+  case 73: /* number_list: FLOAT  */
+#line 672 "yacc_sql.y"
+            {
+      (yyval.number_list) = new vector<float>();
+      (yyval.number_list)->push_back((float)(yyvsp[0].floats));
+    }
+#line 2424 "yacc_sql.cpp"
+    break;
+
+  case 74: /* number_list: NUMBER COMMA number_list  */
+#line 676 "yacc_sql.y"
+                               {
+      if ((yyvsp[0].number_list) != nullptr) {
+        (yyval.number_list) = (yyvsp[0].number_list);
+      } else {
+        (yyval.number_list) = new vector<float>;
+      }
+
+      (yyval.number_list)->insert((yyval.number_list)->begin(), (float)(yyvsp[-2].number));
+    }
+#line 2438 "yacc_sql.cpp"
+    break;
+
+  case 75: /* number_list: FLOAT COMMA number_list  */
+#line 685 "yacc_sql.y"
+                              {
+      if ((yyvsp[0].number_list) != nullptr) {
+        (yyval.number_list) = (yyvsp[0].number_list);
+      } else {
+        (yyval.number_list) = new vector<float>;
+      }
+
+      (yyval.number_list)->insert((yyval.number_list)->begin(), (float)(yyvsp[-2].floats));
+    }
+#line 2452 "yacc_sql.cpp"
+    break;
+
+  case 76: /* value: NUMBER  */
+#line 697 "yacc_sql.y"
+           {
+      (yyval.value) = new Value((int)(yyvsp[0].number));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2461 "yacc_sql.cpp"
+    break;
+
+  case 77: /* value: FLOAT  */
+#line 701 "yacc_sql.y"
+           {
+      (yyval.value) = new Value((float)(yyvsp[0].floats));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2470 "yacc_sql.cpp"
+    break;
+
+  case 78: /* value: SSS  */
+#line 705 "yacc_sql.y"
+         {
+      char *tmp = common::substr((yyvsp[0].cstring),1,strlen((yyvsp[0].cstring))-2);
+      (yyval.value) = new Value(tmp);
+      free(tmp);
+    }
+#line 2480 "yacc_sql.cpp"
+    break;
+
+  case 79: /* value: LBRACKET number_list RBRACKET  */
+#line 710 "yacc_sql.y"
+                                    {
+      (yyval.value) = new Value;
+      (yyval.value)->set_vector(std::move(*(yyvsp[-1].number_list)));
+      delete (yyvsp[-1].number_list);
+    }
+#line 2490 "yacc_sql.cpp"
+    break;
+
+  case 80: /* value: NULL_T  */
+#line 715 "yacc_sql.y"
+            {
+      (yyval.value) = new Value((int)0);
+      (yyval.value)->set_null(true);
+      (yyloc) = (yylsp[0]);
+    }
+#line 2500 "yacc_sql.cpp"
+    break;
+
+  case 81: /* value_list: expression  */
+#line 724 "yacc_sql.y"
+    {
+      (yyval.value_list) = new vector<Value>;
+      Value val;
+      if (OB_FAIL((yyvsp[0].expression)->try_get_value(val))) {
+        YYERROR;
+      }
+      (yyval.value_list)->emplace_back(val);
+      delete (yyvsp[0].expression);
+    }
+#line 2514 "yacc_sql.cpp"
+    break;
+
+  case 82: /* value_list: expression COMMA value_list  */
+#line 734 "yacc_sql.y"
+    {
+      if ((yyvsp[0].value_list) != nullptr) {
+        (yyval.value_list) = (yyvsp[0].value_list);
+      } else {
+        (yyval.value_list) = new vector<Value>;
+      }
+      Value val;
+      if (OB_FAIL((yyvsp[-2].expression)->try_get_value(val))) {
+        YYERROR;
+      }
+      (yyval.value_list)->emplace((yyval.value_list)->begin(), val);
+      delete (yyvsp[-2].expression);
+    }
+#line 2532 "yacc_sql.cpp"
+    break;
+
+  case 83: /* storage_format: %empty  */
+#line 751 "yacc_sql.y"
+    {
+      (yyval.cstring) = nullptr;
+    }
+#line 2540 "yacc_sql.cpp"
+    break;
+
+  case 84: /* storage_format: STORAGE FORMAT EQ ID  */
+#line 755 "yacc_sql.y"
+    {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 2548 "yacc_sql.cpp"
+    break;
+
+  case 85: /* delete_stmt: DELETE FROM ID where  */
+#line 762 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
+      (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].cstring);
+      if ((yyvsp[0].expression) != nullptr) {
+        (yyval.sql_node)->deletion.condition.reset((yyvsp[0].expression));
+      }
+    }
+#line 2560 "yacc_sql.cpp"
+    break;
+
+  case 86: /* assignment: ID EQ expression  */
+#line 773 "yacc_sql.y"
+    {
+      (yyval.assignment) = new Assignment();
+      (yyval.assignment)->attribute_name = (yyvsp[-2].cstring);
+      (yyval.assignment)->expr = (yyvsp[0].expression);
+    }
+#line 2570 "yacc_sql.cpp"
+    break;
+
+  case 87: /* assignment_list: assignment  */
+#line 781 "yacc_sql.y"
+    {
+      (yyval.assignment_list) = new vector<unique_ptr<Assignment>>;
+      (yyval.assignment_list)->emplace_back((yyvsp[0].assignment));
+    }
+#line 2579 "yacc_sql.cpp"
+    break;
+
+  case 88: /* assignment_list: assignment COMMA assignment_list  */
+#line 786 "yacc_sql.y"
+    {
+      if ((yyvsp[0].assignment_list) != nullptr) {
+        (yyval.assignment_list) = (yyvsp[0].assignment_list);
+      } else {
+        (yyval.assignment_list) = new vector<unique_ptr<Assignment>>;
+      }
+      (yyval.assignment_list)->emplace((yyval.assignment_list)->begin(), (yyvsp[-2].assignment));
+    }
+#line 2592 "yacc_sql.cpp"
+    break;
+
+  case 89: /* update_stmt: UPDATE relation SET assignment_list where  */
+#line 799 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
+      (yyval.sql_node)->update.relation_name = (yyvsp[-3].cstring);
+      if ((yyvsp[-1].assignment_list) != nullptr) {
+        (yyval.sql_node)->update.assignment_list.swap(*(yyvsp[-1].assignment_list));
+        delete (yyvsp[-1].assignment_list);
+      }
+      if ((yyvsp[0].expression) != nullptr) {
+        (yyval.sql_node)->update.condition.reset((yyvsp[0].expression));
+      }
+    }
+#line 2608 "yacc_sql.cpp"
+    break;
+
+  case 90: /* select_stmt: SELECT expression_list FROM table_refs where group_by order_by limit_opt  */
+#line 813 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
+      if ((yyvsp[-6].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-6].expression_list));
+        delete (yyvsp[-6].expression_list);
+      }
+
+      if ((yyvsp[-4].table_ref) != nullptr) {
+        // $$->selection.relations.swap(*$4);
+        (yyval.sql_node)->selection.table_refs.reset((yyvsp[-4].table_ref));
+      }
+
+      if ((yyvsp[-3].expression) != nullptr) {
+        (yyval.sql_node)->selection.condition.reset((yyvsp[-3].expression));
+      }
+
+      if ((yyvsp[-2].group_by) != nullptr) {
+        // $$->selection.group_by.swap(*$6);
+        (yyval.sql_node)->selection.group_by.reset((yyvsp[-2].group_by));
+      }
+
+      if ((yyvsp[-1].order_by_list) != nullptr) {
+        (yyval.sql_node)->selection.order_by.swap(*(yyvsp[-1].order_by_list));
+        delete (yyvsp[-1].order_by_list);
+      }
+
+      (yyval.sql_node)->selection.limit = (yyvsp[0].number);
+    }
+#line 2641 "yacc_sql.cpp"
+    break;
+
+  case 91: /* select_stmt_opt: %empty  */
+#line 844 "yacc_sql.y"
+    {
+      (yyval.sql_node) = nullptr;
+    }
+#line 2649 "yacc_sql.cpp"
+    break;
+
+  case 92: /* select_stmt_opt: select_stmt  */
+#line 847 "yacc_sql.y"
+                  {
+      (yyval.sql_node) = (yyvsp[0].sql_node);
+    }
+#line 2657 "yacc_sql.cpp"
+    break;
+
+  case 93: /* select_stmt_opt: AS_T select_stmt  */
+#line 850 "yacc_sql.y"
+                       {
+      (yyval.sql_node) = (yyvsp[0].sql_node);
+    }
+#line 2665 "yacc_sql.cpp"
+    break;
+
+  case 94: /* calc_stmt: CALC expression_list  */
+#line 857 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
+      (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
+      delete (yyvsp[0].expression_list);
+    }
+#line 2675 "yacc_sql.cpp"
+    break;
+
+  case 95: /* expression_list: expression alias_opt  */
+#line 866 "yacc_sql.y"
+    {
+      if ((yyvsp[-1].expression)->type() == ExprType::STAR && (yyvsp[0].cstring) != nullptr) {
+        YYERROR;
+      }
+      if ((yyvsp[0].cstring) != nullptr) {
+        (yyvsp[-1].expression)->set_alias_name((yyvsp[0].cstring));
+      }
+      (yyval.expression_list) = new vector<unique_ptr<Expression>>;
+      (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
+    }
+#line 2690 "yacc_sql.cpp"
+    break;
+
+  case 96: /* expression_list: expression alias_opt COMMA expression_list  */
+#line 877 "yacc_sql.y"
+    {
+      if ((yyvsp[0].expression_list) != nullptr) {
+        (yyval.expression_list) = (yyvsp[0].expression_list);
+      } else {
+        (yyval.expression_list) = new vector<unique_ptr<Expression>>;
+      }
+      if ((yyvsp[-2].cstring) != nullptr) {
+        (yyvsp[-3].expression)->set_alias_name((yyvsp[-2].cstring));
+      }
+      (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-3].expression));
+    }
+#line 2706 "yacc_sql.cpp"
+    break;
+
+  case 97: /* expression: boolean_primary  */
+#line 891 "yacc_sql.y"
+                    {
+      (yyval.expression) = (yyvsp[0].expression);
+    }
+#line 2714 "yacc_sql.cpp"
+    break;
+
+  case 98: /* expression: expression AND expression  */
+#line 894 "yacc_sql.y"
+                                {
+      (yyval.expression) = new ConjunctionExpr(ConjunctionExpr::Type::AND, (yyvsp[-2].expression), (yyvsp[0].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2723 "yacc_sql.cpp"
+    break;
+
+  case 99: /* expression: expression OR expression  */
+#line 898 "yacc_sql.y"
+                               {
+      (yyval.expression) = new ConjunctionExpr(ConjunctionExpr::Type::OR, (yyvsp[-2].expression), (yyvsp[0].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2732 "yacc_sql.cpp"
+    break;
+
+  case 100: /* boolean_primary: boolean_primary comp_op predicate  */
+#line 905 "yacc_sql.y"
+                                      {
+      (yyval.expression) = new ComparisonExpr((yyvsp[-1].comp), (yyvsp[-2].expression), (yyvsp[0].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2741 "yacc_sql.cpp"
+    break;
+
+  case 101: /* boolean_primary: predicate  */
+#line 909 "yacc_sql.y"
+                {
+      (yyval.expression) = (yyvsp[0].expression);
+    }
+#line 2749 "yacc_sql.cpp"
+    break;
+
+  case 102: /* predicate: bit_expr  */
+#line 915 "yacc_sql.y"
+             {
+      (yyval.expression) = (yyvsp[0].expression);
+    }
+#line 2757 "yacc_sql.cpp"
+    break;
+
+  case 103: /* predicate: bit_expr like_opt simple_expr  */
+#line 918 "yacc_sql.y"
+                                    {
+      (yyval.expression) = new ComparisonExpr((yyvsp[-1].comp), (yyvsp[-2].expression), (yyvsp[0].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2766 "yacc_sql.cpp"
+    break;
+
+  case 104: /* predicate: bit_expr in_opt LBRACE value_list RBRACE  */
+#line 922 "yacc_sql.y"
+                                               {
+      SubQueryExpr* subquery_expr = create_subquery_expression(*(yyvsp[-1].value_list));
+      (yyval.expression) = new ComparisonExpr((yyvsp[-3].comp), (yyvsp[-4].expression), subquery_expr);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[-1].value_list);
+    }
+#line 2777 "yacc_sql.cpp"
+    break;
+
+  case 105: /* predicate: bit_expr in_opt subquery_expr  */
+#line 928 "yacc_sql.y"
+                                    {
+      (yyval.expression) = new ComparisonExpr((yyvsp[-1].comp), (yyvsp[-2].expression), (yyvsp[0].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2786 "yacc_sql.cpp"
+    break;
+
+  case 106: /* bit_expr: bit_expr '+' bit_expr  */
+#line 936 "yacc_sql.y"
+                          {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2794 "yacc_sql.cpp"
+    break;
+
+  case 107: /* bit_expr: bit_expr '-' bit_expr  */
+#line 939 "yacc_sql.y"
+                            {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2802 "yacc_sql.cpp"
+    break;
+
+  case 108: /* bit_expr: bit_expr '*' bit_expr  */
+#line 942 "yacc_sql.y"
+                            {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2810 "yacc_sql.cpp"
+    break;
+
+  case 109: /* bit_expr: bit_expr '/' bit_expr  */
+#line 945 "yacc_sql.y"
+                            {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2818 "yacc_sql.cpp"
+    break;
+
+  case 110: /* bit_expr: simple_expr  */
+#line 948 "yacc_sql.y"
+                  {
+      (yyval.expression) = (yyvsp[0].expression);
+    }
+#line 2826 "yacc_sql.cpp"
+    break;
+
+  case 111: /* simple_expr: value  */
+#line 954 "yacc_sql.y"
+          {
+      ValueExpr *value_expr = new ValueExpr(*(yyvsp[0].value));
+      if (!(yyvsp[0].value)->is_null() && (yyvsp[0].value)->attr_type() != AttrType::VECTORS) {
+        value_expr->set_param_index(sql_result->add_param());
+      }
+      (yyval.expression) = value_expr;
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[0].value);
+    }
+#line 2840 "yacc_sql.cpp"
+    break;
+
+  case 112: /* simple_expr: '?'  */
+#line 963 "yacc_sql.y"
+          {
+      if (!sql_result->placeholder_enabled()) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "placeholder is only allowed in prepared statements");
+        YYERROR;
+      }
+      const int  placeholder = sql_result->add_placeholder();
+      const Value value      = sql_result->placeholder_value(placeholder);
+      ValueExpr *value_expr  = new ValueExpr(value);
+      if (!value.is_null()) {
+        value_expr->set_param_index(sql_result->add_param());
+      }
+      value_expr->set_placeholder_index(placeholder);
+      (yyval.expression) = value_expr;
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2860 "yacc_sql.cpp"
+    break;
+
+  case 113: /* simple_expr: rel_attr  */
+#line 978 "yacc_sql.y"
+               {
+      RelAttrSqlNode *node = (yyvsp[0].rel_attr);
+      (yyval.expression) = new UnboundFieldExpr(node->relation_name, node->attribute_name);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[0].rel_attr);
+    }
+#line 2871 "yacc_sql.cpp"
+    break;
+
+  case 114: /* simple_expr: '*'  */
+#line 984 "yacc_sql.y"
+          {
+      (yyval.expression) = new StarExpr();
+    }
+#line 2879 "yacc_sql.cpp"
+    break;
+
+  case 115: /* simple_expr: ID DOT '*'  */
+#line 987 "yacc_sql.y"
+                 {
+      (yyval.expression) = new StarExpr((yyvsp[-2].cstring));
+    }
+#line 2887 "yacc_sql.cpp"
+    break;
+
+  case 116: /* simple_expr: LBRACE expression RBRACE  */
+#line 990 "yacc_sql.y"
+                               {
+      (yyval.expression) = (yyvsp[-1].expression);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2896 "yacc_sql.cpp"
+    break;
+
+  case 117: /* simple_expr: '-' simple_expr  */
+#line 994 "yacc_sql.y"
+                                   {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
+    }
+#line 2904 "yacc_sql.cpp"
+    break;
+
+  case 118: /* simple_expr: ID LBRACE expression RBRACE  */
+#line 997 "yacc_sql.y"
+                                  {
+      (yyval.expression) = create_aggregate_expression((yyvsp[-3].cstring), (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2912 "yacc_sql.cpp"
+    break;
+
+  case 119: /* simple_expr: ID LBRACE expression COMMA expression RBRACE  */
+#line 1000 "yacc_sql.y"
+                                                   {
+      (yyval.expression) = create_vectorfunc_expression((yyvsp[-5].cstring), (yyvsp[-3].expression), (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2920 "yacc_sql.cpp"
+    break;
+
+  case 120: /* simple_expr: subquery_expr  */
+#line 1003 "yacc_sql.y"
+                    {
+      (yyval.expression) = (yyvsp[0].expression);
+    }
+#line 2928 "yacc_sql.cpp"
+    break;
+
+  case 121: /* subquery_expr: LBRACE select_stmt RBRACE  */
+#line 1009 "yacc_sql.y"
+                              {
+      (yyval.expression) = create_subquery_expression((yyvsp[-1].sql_node), sql_string, &(yyloc));
+    }
+#line 2936 "yacc_sql.cpp"
+    break;
+
+  case 122: /* rel_attr: ID  */
+#line 1015 "yacc_sql.y"
+       {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->attribute_name = (yyvsp[0].cstring);
+    }
+#line 2945 "yacc_sql.cpp"
+    break;
+
+  case 123: /* rel_attr: ID DOT ID  */
+#line 1019 "yacc_sql.y"
+                {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->relation_name  = (yyvsp[-2].cstring);
+      (yyval.rel_attr)->attribute_name = (yyvsp[0].cstring);
+    }
+#line 2955 "yacc_sql.cpp"
+    break;
+
+  case 124: /* relation: ID  */
+#line 1027 "yacc_sql.y"
+       {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 2963 "yacc_sql.cpp"
+    break;
+
+  case 125: /* table_refs: table_factor  */
+#line 1033 "yacc_sql.y"
+                 {
+      (yyval.table_ref) = (yyvsp[0].table_ref);
+    }
+#line 2971 "yacc_sql.cpp"
+    break;
+
+  case 126: /* table_refs: joined_table  */
+#line 1036 "yacc_sql.y"
+                   {
+      (yyval.table_ref) = (yyvsp[0].table_ref);
+    }
+#line 2979 "yacc_sql.cpp"
+    break;
+
+  case 127: /* table_factor: relation alias_opt  */
+#line 1042 "yacc_sql.y"
+                       {
+      UnboundSingleTable* tmp = new UnboundSingleTable();
+      tmp->relation_name = (yyvsp[-1].cstring);
+      if ((yyvsp[0].cstring) != nullptr) {
+        tmp->alias_name = (yyvsp[0].cstring);
+      }
+      (yyval.table_ref) = tmp;
+    }
+#line 2992 "yacc_sql.cpp"
+    break;
+
+  case 128: /* joined_table: table_refs COMMA table_factor  */
+#line 1053 "yacc_sql.y"
+                                  {
+      UnboundJoinedTable* tmp = new UnboundJoinedTable();
+      tmp->type = JoinType::CROSS;
+      tmp->left.reset((yyvsp[-2].table_ref));
+      tmp->right.reset((yyvsp[0].table_ref));
+      (yyval.table_ref) = tmp;
+    }
+#line 3004 "yacc_sql.cpp"
+    break;
+
+  case 129: /* joined_table: table_refs INNER_T JOIN_T table_factor ON expression  */
+#line 1060 "yacc_sql.y"
+                                                           {
+      UnboundJoinedTable* tmp = new UnboundJoinedTable();
+      tmp->type = JoinType::INNER;
+      tmp->left.reset((yyvsp[-5].table_ref));
+      tmp->right.reset((yyvsp[-2].table_ref));
+      tmp->expr.reset((yyvsp[0].expression));
+      (yyval.table_ref) = tmp;
+    }
+#line 3017 "yacc_sql.cpp"
+    break;
+
+  case 130: /* where: %empty  */
+#line 1072 "yacc_sql.y"
+    {
+      (yyval.expression) = nullptr;
+    }
+#line 3025 "yacc_sql.cpp"
+    break;
+
+  case 131: /* where: WHERE expression  */
+#line 1075 "yacc_sql.y"
+                       {
+      (yyval.expression) = (yyvsp[0].expression);  
+    }
+#line 3033 "yacc_sql.cpp"
+    break;
+
+  case 132: /* comp_op: EQ  */
+#line 1081 "yacc_sql.y"
+         { (yyval.comp) = EQUAL_TO; }
+#line 3039 "yacc_sql.cpp"
+    break;
+
+  case 133: /* comp_op: LT  */
+#line 1082 "yacc_sql.y"
+         { (yyval.comp) = LESS_THAN; }
+#line 3045 "yacc_sql.cpp"
+    break;
+
+  case 134: /* comp_op: GT  */
+#line 1083 "yacc_sql.y"
+         { (yyval.comp) = GREAT_THAN; }
+#line 3051 "yacc_sql.cpp"
+    break;
+
+  case 135: /* comp_op: LE  */
+#line 1084 "yacc_sql.y"
+         { (yyval.comp) = LESS_EQUAL; }
+#line 3057 "yacc_sql.cpp"
+    break;
+
+  case 136: /* comp_op: GE  */
+#line 1085 "yacc_sql.y"
+         { (yyval.comp) = GREAT_EQUAL; }
+#line 3063 "yacc_sql.cpp"
+    break;
+
+  case 137: /* comp_op: NE  */
+#line 1086 "yacc_sql.y"
+         { (yyval.comp) = NOT_EQUAL; }
+#line 3069 "yacc_sql.cpp"
+    break;
+
+  case 138: /* comp_op: IS_T  */
+#line 1087 "yacc_sql.y"
+           { (yyval.comp) = IS; }
+#line 3075 "yacc_sql.cpp"
+    break;
+
+  case 139: /* comp_op: IS_T NOT  */
+#line 1088 "yacc_sql.y"
+               { (yyval.comp) = IS_NOT; }
+#line 3081 "yacc_sql.cpp"
+    break;
+
+  case 140: /* in_opt: IN_T  */
+#line 1094 "yacc_sql.y"
+         { (yyval.comp) = IN; }
+#line 3087 "yacc_sql.cpp"
+    break;
+
+  case 141: /* in_opt: NOT IN_T  */
+#line 1095 "yacc_sql.y"
+               { (yyval.comp) = NOT_IN; }
+#line 3093 "yacc_sql.cpp"
+    break;
+
+  case 142: /* like_opt: LIKE_T  */
+#line 1099 "yacc_sql.y"
+           { (yyval.comp) = LIKE; }
+#line 3099 "yacc_sql.cpp"
+    break;
+
+  case 143: /* like_opt: NOT LIKE_T  */
+#line 1100 "yacc_sql.y"
+                 { (yyval.comp) = NOT_LIKE; }
+#line 3105 "yacc_sql.cpp"
+    break;
+
+  case 144: /* alias_opt: %empty  */
+#line 1104 "yacc_sql.y"
+    {
+      (yyval.cstring) = nullptr;
+    }
+#line 3113 "yacc_sql.cpp"
+    break;
+
+  case 145: /* alias_opt: ID  */
+#line 1107 "yacc_sql.y"
+         {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 3121 "yacc_sql.cpp"
+    break;
+
+  case 146: /* alias_opt: AS_T ID  */
+#line 1110 "yacc_sql.y"
+              {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 3129 "yacc_sql.cpp"
+    break;
+
+  case 147: /* unique_opt: %empty  */
+#line 1115 "yacc_sql.y"
+    {
+      (yyval.boolean) = false;
+    }
+#line 3137 "yacc_sql.cpp"
+    break;
+
+  case 148: /* unique_opt: UNIQUE_T  */
+#line 1118 "yacc_sql.y"
+               {
+      (yyval.boolean) = true;
+    }
+#line 3145 "yacc_sql.cpp"
+    break;
+
+  case 149: /* group_by: %empty  */
+#line 1124 "yacc_sql.y"
+    {
+      (yyval.group_by) = nullptr;
+    }
+#line 3153 "yacc_sql.cpp"
+    break;
+
+  case 150: /* group_by: GROUP BY expression_list  */
+#line 1127 "yacc_sql.y"
+                               {
+      (yyval.group_by) = new GroupBy;
+      (yyval.group_by)->exprs.swap(*(yyvsp[0].expression_list));
+      delete (yyvsp[0].expression_list);
+      (yyval.group_by)->having_predicate = nullptr;
+    }
+#line 3164 "yacc_sql.cpp"
+    break;
+
+  case 151: /* group_by: GROUP BY expression_list HAVING_T expression  */
+#line 1133 "yacc_sql.y"
+                                                   {
+      (yyval.group_by) = new GroupBy;
+      (yyval.group_by)->exprs.swap(*(yyvsp[-2].expression_list));
+      delete (yyvsp[-2].expression_list);
+      (yyval.group_by)->having_predicate.reset((yyvsp[0].expression));
+    }
+#line 3175 "yacc_sql.cpp"
+    break;
+
+  case 152: /* order_by_entry: expression  */
+#line 1141 "yacc_sql.y"
+               {
+      (yyval.order_by_entry) = new OrderBy;
+      (yyval.order_by_entry)->is_asc = true;
+      (yyval.order_by_entry)->expr.reset((yyvsp[0].expression));
+    }
+#line 3185 "yacc_sql.cpp"
+    break;
+
+  case 153: /* order_by_entry: expression ASC  */
+#line 1146 "yacc_sql.y"
+                     {
+      (yyval.order_by_entry) = new OrderBy;
+      (yyval.order_by_entry)->is_asc = true;
+      (yyval.order_by_entry)->expr.reset((yyvsp[-1].expression));
+    }
+#line 3195 "yacc_sql.cpp"
+    break;
+
+  case 154: /* order_by_entry: expression DESC  */
+#line 1151 "yacc_sql.y"
+                      {
+      (yyval.order_by_entry) = new OrderBy;
+      (yyval.order_by_entry)->is_asc = false;
+      (yyval.order_by_entry)->expr.reset((yyvsp[-1].expression));
+    }
+#line 3205 "yacc_sql.cpp"
+    break;
+
+  case 155: /* order_by_list: order_by_entry  */
+#line 1158 "yacc_sql.y"
+                   {
+      (yyval.order_by_list) = new vector<unique_ptr<OrderBy>>;
+      (yyval.order_by_list)->emplace_back((yyvsp[0].order_by_entry));
+    }
+#line 3214 "yacc_sql.cpp"
+    break;
+
+  case 156: /* order_by_list: order_by_entry COMMA order_by_list  */
+#line 1162 "yacc_sql.y"
+                                         {
+      if ((yyvsp[0].order_by_list) != nullptr) {
+        (yyval.order_by_list) = (yyvsp[0].order_by_list);
+      }
+      else {
+        (yyval.order_by_list) = new vector<unique_ptr<OrderBy>>;
+      }
+      (yyval.order_by_list)->emplace((yyval.order_by_list)->begin(), (yyvsp[-2].order_by_entry));
+    }
+#line 3228 "yacc_sql.cpp"
+    break;
+
+  case 157: /* order_by: %empty  */
+#line 1173 "yacc_sql.y"
+    {
+      (yyval.order_by_list) = nullptr;
+    }
+#line 3236 "yacc_sql.cpp"
+    break;
+
+  case 158: /* order_by: ORDER_T BY order_by_list  */
+#line 1176 "yacc_sql.y"
+                               {
+      (yyval.order_by_list) = (yyvsp[0].order_by_list);
+    }
+#line 3244 "yacc_sql.cpp"
+    break;
+
+  case 159: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1183 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
+      (yyval.sql_node)->explain.sql_node = unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+    }
+#line 3253 "yacc_sql.cpp"
+    break;
+
+  case 160: /* explain_stmt: EXPLAIN ANALYZE command_wrapper  */
+#line 1188 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
+      (yyval.sql_node)->explain.sql_node = unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+      (yyval.sql_node)->explain.analyze = true;
+    }
+#line 3263 "yacc_sql.cpp"
+    break;
+
+  case 161: /* set_variable_stmt: SET ID EQ value  */
+#line 1197 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+      (yyval.sql_node)->set_variable.name  = (yyvsp[-2].cstring);
+      (yyval.sql_node)->set_variable.value = *(yyvsp[0].value);
+      delete (yyvsp[0].value);
+    }
+#line 3274 "yacc_sql.cpp"
+    break;
+
+  case 162: /* set_variable_stmt: SET ID ID  */
+#line 1204 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+      (yyval.sql_node)->set_variable.name  = (yyvsp[-1].cstring);
+      char *tmp = common::substr((yyvsp[0].cstring),1,strlen((yyvsp[0].cstring))-2);
+      (yyval.sql_node)->set_variable.value = Value(tmp);
+      free(tmp);
+    }
+#line 3286 "yacc_sql.cpp"
+    break;
+
+  case 163: /* load_data_stmt: LOAD ID ID SSS INTO TABLE ID  */
+#line 1216 "yacc_sql.y"
+    {
+      if (strcasecmp((yyvsp[-5].cstring), "data") != 0 || strcasecmp((yyvsp[-4].cstring), "infile") != 0) {
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "syntax error, expect LOAD DATA INFILE");
+        YYERROR;
+      }
+      char *tmp_file_name = common::substr((yyvsp[-3].cstring), 1, strlen((yyvsp[-3].cstring)) - 2);
+      (yyval.sql_node) = new ParsedSqlNode(SCF_LOAD_DATA);
+      (yyval.sql_node)->load_data.relation_name = (yyvsp[0].cstring);
+      (yyval.sql_node)->load_data.file_name = tmp_file_name;
+      free(tmp_file_name);
+    }
+#line 3302 "yacc_sql.cpp"
+    break;
+
+
+#line 3306 "yacc_sql.cpp"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, sql_string, sql_result, scanner, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, sql_string, sql_result, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, sql_string, sql_result, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, sql_string, sql_result, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, sql_string, sql_result, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, sql_string, sql_result, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 1232 "yacc_sql.y"
+
+//_____________________________________________________________________
+extern void scan_string(const char *str, yyscan_t scanner);
+
+int sql_parse(const char *s, ParsedSqlResult *sql_result) {
+  yyscan_t scanner;
+  std::vector<char *> allocated_strings;
+  yylex_init_extra(static_cast<void*>(&allocated_strings),&scanner);
+  scan_string(s, scanner);
+  int result = yyparse(s, sql_result, scanner);
+
+  for (char *ptr : allocated_strings) {
+    free(ptr);
+  }
+  allocated_strings.clear();
+
+  yylex_destroy(scanner);
+  return result;
+}
+
+int sql_fingerprint(const char *s, string *fingerprint, vector<Value> *params, vector<size_t> *placeholders) {
+  yyscan_t scanner;
+  std::vector<char *> allocated_strings;
+  yylex_init_extra(static_cast<void*>(&allocated_strings),&scanner);
+  scan_string(s, scanner);
+
+  // 只使用词法分析，把能够被语法分析器当做常量表达式的字面量替换成占位符
+  // LIMIT 后面的数字与向量中的数字不会生成常量表达式，保持原样
+  // 预处理语句中的占位符'?'保持原样，记录它在指纹中的位置，params中放一个未定义的值占位
+  int result         = 0;
+  int prev_token     = 0;
+  int bracket_depth  = 0;
+  bool end_statement = false;
+  YYSTYPE yylval;
+  YYLTYPE yylloc;
+  for (int token = yylex(&yylval, &yylloc, scanner); token != 0; token = yylex(&yylval, &yylloc, scanner)) {
+    if (end_statement || (prev_token == 0 && token != SELECT)) {
+      result = -1;
+      break;
+    }
+
+    if (token == SEMICOLON) {
+      end_statement = true;
+      continue;
+    }
+
+    if (!fingerprint->empty()) {
+      fingerprint->push_back(' ');
+    }
+
+    const bool parameterize = (prev_token != LIMIT_T && bracket_depth == 0);
+    if (token == NUMBER && parameterize) {
+      fingerprint->append("?i");
+      params->emplace_back(yylval.number);
+    } else if (token == FLOAT && parameterize) {
+      fingerprint->append("?f");
+      params->emplace_back(yylval.floats);
+    } else if (token == SSS && parameterize) {
+      char *tmp = common::substr(yylval.cstring, 1, strlen(yylval.cstring) - 2);
+      fingerprint->append("?s");
+      params->emplace_back(tmp);
+      free(tmp);
+    } else if (token == '?') {
+      if (placeholders == nullptr) {
+        result = -1;
+        break;
+      }
+      placeholders->push_back(fingerprint->size());
+      fingerprint->push_back('?');
+      params->emplace_back();
+    } else {
+      fingerprint->append(token_name(s, &yylloc));
+    }
+
+    if (token == LBRACKET) {
+      bracket_depth++;
+    } else if (token == RBRACKET) {
+      bracket_depth--;
+    }
+    prev_token = token;
+  }
+
+  for (char *ptr : allocated_strings) {
+    free(ptr);
+  }
+  allocated_strings.clear();
+
+  yylex_destroy(scanner);
+  return result;
+}
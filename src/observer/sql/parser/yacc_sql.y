@@ -63,6 +63,29 @@ UnboundVectorFuncExpr *create_vectorfunc_expression(const char *function_name,
   return expr;
 }
 
+/**
+ * INSERT 语句的一行值追加到 insertion 中，每一行值的个数必须相同。会释放 exprs
+ */
+RC append_insert_row(InsertSqlNode &insertion, vector<unique_ptr<Expression>> *exprs)
+{
+  unique_ptr<vector<unique_ptr<Expression>>> row(exprs);
+  if (insertion.row_num > 0 && insertion.values.size() != insertion.row_num * row->size()) {
+    return RC::INVALID_ARGUMENT;
+  }
+  for (const unique_ptr<Expression> &expr : *row) {
+    Value val;
+    RC    rc = expr->try_get_value(val);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    insertion.values.push_back(val);
+    insertion.placeholders.push_back(expr->type() == ExprType::VALUE
+        ? static_cast<const ValueExpr *>(expr.get())->placeholder_index() : -1);
+  }
+  insertion.row_num++;
+  return RC::SUCCESS;
+}
+
 SubQueryExpr *create_subquery_expression(ParsedSqlNode* sql_node, const char *sql_string, YYLTYPE *llocp) {
  SubQueryExpr *expr = new SubQueryExpr(sql_node);
  expr->set_name(token_name(sql_string, llocp));
@@ -234,6 +257,7 @@ SubQueryExpr *create_subquery_expression(const vector<Value>& value_list) {
 %type <sql_node>            select_stmt
 %type <sql_node>            select_stmt_opt
 %type <sql_node>            insert_stmt
+%type <sql_node>            insert_rows
 %type <sql_node>            update_stmt
 %type <sql_node>            delete_stmt
 %type <sql_node>            create_view_stmt
@@ -241,6 +265,7 @@ SubQueryExpr *create_subquery_expression(const vector<Value>& value_list) {
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            analyze_table_stmt
 %type <sql_node>            show_tables_stmt
+%type <sql_node>            show_status_stmt
 %type <sql_node>            desc_table_stmt
 %type <sql_node>            create_index_stmt
 %type <sql_node>            create_vector_index_stmt
@@ -251,6 +276,7 @@ SubQueryExpr *create_subquery_expression(const vector<Value>& value_list) {
 %type <sql_node>            rollback_stmt
 %type <sql_node>            explain_stmt
 %type <sql_node>            set_variable_stmt
+%type <sql_node>            load_data_stmt
 %type <sql_node>            help_stmt
 %type <sql_node>            exit_stmt
 %type <sql_node>            command_wrapper
@@ -281,6 +307,7 @@ command_wrapper:
   | drop_table_stmt
   | analyze_table_stmt
   | show_tables_stmt
+  | show_status_stmt
   | desc_table_stmt
   | create_index_stmt
   | create_vector_index_stmt
@@ -291,6 +318,7 @@ command_wrapper:
   | rollback_stmt
   | explain_stmt
   | set_variable_stmt
+  | load_data_stmt
   | help_stmt
   | exit_stmt
     ;
@@ -349,6 +377,20 @@ show_tables_stmt:
     }
     ;
 
+show_status_stmt:
+    SHOW ID {
+      // 不把STATUS作为关键字，避免与字段名冲突
+      if (0 == strcasecmp($2, "status")) {
+        $$ = new ParsedSqlNode(SCF_SHOW_STATUS);
+      } else {
+        $$ = new ParsedSqlNode(SCF_ERROR);
+        $$->error.error_msg = "syntax error";
+        $$->error.line = @2.first_line;
+        $$->error.column = @2.first_column;
+      }
+    }
+    ;
+
 desc_table_stmt:
     DESC ID  {
       $$ = new ParsedSqlNode(SCF_DESC_TABLE);
@@ -594,20 +636,30 @@ attr_list:
     ;
 
 insert_stmt:        /*insert   语句的语法解析树*/
-    INSERT INTO ID VALUES LBRACE expression_list RBRACE 
+    INSERT INTO ID VALUES insert_rows
     {
-      $$ = new ParsedSqlNode(SCF_INSERT);
+      $$ = $5;
       $$->insertion.relation_name = $3;
-      if ($6 != nullptr) {
-        for (const std::unique_ptr<Expression>& expr: *$6) {
-          Value val;
-          if (OB_FAIL(expr->try_get_value(val))) {
-            delete $6;
-            YYERROR;
-          }
-          $$->insertion.values.push_back(val);
-        }
-        delete $6;
+    }
+    ;
+
+insert_rows:
+    LBRACE expression_list RBRACE
+    {
+      $$ = new ParsedSqlNode(SCF_INSERT);
+      if (OB_FAIL(append_insert_row($$->insertion, $2))) {
+        delete $$;
+        yyerror(&@$, sql_string, sql_result, scanner, "invalid insert values");
+        YYERROR;
+      }
+    }
+    | insert_rows COMMA LBRACE expression_list RBRACE
+    {
+      $$ = $1;
+      if (OB_FAIL(append_insert_row($$->insertion, $4))) {
+        delete $$;
+        yyerror(&@$, sql_string, sql_result, scanner, "invalid insert values");
+        YYERROR;
       }
     }
     ;
@@ -900,10 +952,29 @@ bit_expr:
 
 simple_expr:
     value {
-      $$ = new ValueExpr(*$1);
+      ValueExpr *value_expr = new ValueExpr(*$1);
+      if (!$1->is_null() && $1->attr_type() != AttrType::VECTORS) {
+        value_expr->set_param_index(sql_result->add_param());
+      }
+      $$ = value_expr;
       $$->set_name(token_name(sql_string, &@$));
       delete $1;
     }
+    | '?' {
+      if (!sql_result->placeholder_enabled()) {
+        yyerror(&@$, sql_string, sql_result, scanner, "placeholder is only allowed in prepared statements");
+        YYERROR;
+      }
+      const int  placeholder = sql_result->add_placeholder();
+      const Value value      = sql_result->placeholder_value(placeholder);
+      ValueExpr *value_expr  = new ValueExpr(value);
+      if (!value.is_null()) {
+        value_expr->set_param_index(sql_result->add_param());
+      }
+      value_expr->set_placeholder_index(placeholder);
+      $$ = value_expr;
+      $$->set_name(token_name(sql_string, &@$));
+    }
     | rel_attr {
       RelAttrSqlNode *node = $1;
       $$ = new UnboundFieldExpr(node->relation_name, node->attribute_name);
@@ -1113,6 +1184,12 @@ explain_stmt:
       $$ = new ParsedSqlNode(SCF_EXPLAIN);
       $$->explain.sql_node = unique_ptr<ParsedSqlNode>($2);
     }
+    | EXPLAIN ANALYZE command_wrapper
+    {
+      $$ = new ParsedSqlNode(SCF_EXPLAIN);
+      $$->explain.sql_node = unique_ptr<ParsedSqlNode>($3);
+      $$->explain.analyze = true;
+    }
     ;
 
 set_variable_stmt:
@@ -1133,6 +1210,22 @@ set_variable_stmt:
     }
     ;
 
+/* DATA 和 INFILE 不作为关键字，避免不能再用作列名或别名 */
+load_data_stmt:
+    LOAD ID ID SSS INTO TABLE ID
+    {
+      if (strcasecmp($2, "data") != 0 || strcasecmp($3, "infile") != 0) {
+        yyerror(&@$, sql_string, sql_result, scanner, "syntax error, expect LOAD DATA INFILE");
+        YYERROR;
+      }
+      char *tmp_file_name = common::substr($4, 1, strlen($4) - 2);
+      $$ = new ParsedSqlNode(SCF_LOAD_DATA);
+      $$->load_data.relation_name = $7;
+      $$->load_data.file_name = tmp_file_name;
+      free(tmp_file_name);
+    }
+    ;
+
 opt_semicolon: /*empty*/
     | SEMICOLON
     ;
@@ -1155,3 +1248,74 @@ int sql_parse(const char *s, ParsedSqlResult *sql_result) {
   yylex_destroy(scanner);
   return result;
 }
+
+int sql_fingerprint(const char *s, string *fingerprint, vector<Value> *params, vector<size_t> *placeholders) {
+  yyscan_t scanner;
+  std::vector<char *> allocated_strings;
+  yylex_init_extra(static_cast<void*>(&allocated_strings),&scanner);
+  scan_string(s, scanner);
+
+  // 只使用词法分析，把能够被语法分析器当做常量表达式的字面量替换成占位符
+  // LIMIT 后面的数字与向量中的数字不会生成常量表达式，保持原样
+  // 预处理语句中的占位符'?'保持原样，记录它在指纹中的位置，params中放一个未定义的值占位
+  int result         = 0;
+  int prev_token     = 0;
+  int bracket_depth  = 0;
+  bool end_statement = false;
+  YYSTYPE yylval;
+  YYLTYPE yylloc;
+  for (int token = yylex(&yylval, &yylloc, scanner); token != 0; token = yylex(&yylval, &yylloc, scanner)) {
+    if (end_statement || (prev_token == 0 && token != SELECT)) {
+      result = -1;
+      break;
+    }
+
+    if (token == SEMICOLON) {
+      end_statement = true;
+      continue;
+    }
+
+    if (!fingerprint->empty()) {
+      fingerprint->push_back(' ');
+    }
+
+    const bool parameterize = (prev_token != LIMIT_T && bracket_depth == 0);
+    if (token == NUMBER && parameterize) {
+      fingerprint->append("?i");
+      params->emplace_back(yylval.number);
+    } else if (token == FLOAT && parameterize) {
+      fingerprint->append("?f");
+      params->emplace_back(yylval.floats);
+    } else if (token == SSS && parameterize) {
+      char *tmp = common::substr(yylval.cstring, 1, strlen(yylval.cstring) - 2);
+      fingerprint->append("?s");
+      params->emplace_back(tmp);
+      free(tmp);
+    } else if (token == '?') {
+      if (placeholders == nullptr) {
+        result = -1;
+        break;
+      }
+      placeholders->push_back(fingerprint->size());
+      fingerprint->push_back('?');
+      params->emplace_back();
+    } else {
+      fingerprint->append(token_name(s, &yylloc));
+    }
+
+    if (token == LBRACKET) {
+      bracket_depth++;
+    } else if (token == RBRACKET) {
+      bracket_depth--;
+    }
+    prev_token = token;
+  }
+
+  for (char *ptr : allocated_strings) {
+    free(ptr);
+  }
+  allocated_strings.clear();
+
+  yylex_destroy(scanner);
+  return result;
+}
@@ -0,0 +1,178 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/plan_cache/plan_cache.h"
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
+#include "sql/operator/physical_operator.h"
+
+using namespace std;
+
+CachedPlan::CachedPlan(PlanCache *owner, const string &key, uint64_t version, int param_count)
+    : owner_(owner), key_(key), version_(version), param_count_(param_count)
+{}
+
+CachedPlan::~CachedPlan() = default;
+
+void CachedPlan::set_operator(unique_ptr<PhysicalOperator> oper) { operator_ = std::move(oper); }
+
+RC CachedPlan::collect_params()
+{
+  if (operator_ == nullptr) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  params_.clear();
+
+  function<RC(unique_ptr<Expression> &)> collector = [&](unique_ptr<Expression> &expr) -> RC {
+    if (expr == nullptr) {
+      return RC::SUCCESS;
+    }
+    if (expr->type() == ExprType::SUBQUERY) {
+      return RC::UNIMPLEMENTED;
+    }
+    if (expr->type() == ExprType::VALUE) {
+      auto value_expr = static_cast<ValueExpr *>(expr.get());
+      if (value_expr->param_index() >= param_count_) {
+        return RC::INTERNAL;
+      }
+      if (value_expr->param_index() >= 0) {
+        params_.push_back(value_expr);
+      }
+      return RC::SUCCESS;
+    }
+    return ExpressionIterator::iterate_child_expr(*expr, collector);
+  };
+
+  RC rc = operator_->iterate_expressions(collector);
+  if (OB_FAIL(rc)) {
+    params_.clear();
+    return rc;
+  }
+
+  // 每个常量都必须能在执行计划中找到，否则说明这个常量被优化掉了(比如常量折叠)，替换后的结果不可预期
+  vector<bool> found(param_count_, false);
+  for (ValueExpr *value_expr : params_) {
+    found[value_expr->param_index()] = true;
+  }
+  for (int i = 0; i < param_count_; i++) {
+    if (!found[i]) {
+      LOG_TRACE("param %d is not found in physical plan, cannot cache it", i);
+      params_.clear();
+      return RC::UNSUPPORTED;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC CachedPlan::bind_params(const vector<Value> &params)
+{
+  if (static_cast<int>(params.size()) != param_count_) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = RC::SUCCESS;
+  for (ValueExpr *value_expr : params_) {
+    const Value &param = params[value_expr->param_index()];
+    if (param.attr_type() == value_expr->value_type()) {
+      value_expr->set_value(param);
+      continue;
+    }
+
+    Value casted_value;
+    if (OB_FAIL(rc = Value::cast_to(param, value_expr->value_type(), casted_value))) {
+      LOG_TRACE("failed to cast param. param=%s, target type=%s, rc=%s",
+          param.to_string().c_str(), attr_type_to_string(value_expr->value_type()), strrc(rc));
+      return rc;
+    }
+    value_expr->set_value(casted_value);
+  }
+  return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PlanCache::PlanCache(size_t capacity) : capacity_(capacity), plans_(capacity) {}
+
+PlanCache::~PlanCache() { clear(); }
+
+unique_ptr<CachedPlan> PlanCache::acquire(const string &key)
+{
+  lock_guard<mutex> guard(lock_);
+
+  CachedPlan *plan = nullptr;
+  if (!plans_.get(key, plan)) {
+    misses_++;
+    return nullptr;
+  }
+
+  plans_.remove(key);
+  hits_++;
+  return unique_ptr<CachedPlan>(plan);
+}
+
+void PlanCache::release(unique_ptr<CachedPlan> plan)
+{
+  if (plan == nullptr || plan->physical_operator() == nullptr) {
+    return;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  if (plan->version() != version_.load()) {
+    // 计划生成之后执行过DDL，丢掉
+    return;
+  }
+
+  CachedPlan *exist_plan = nullptr;
+  if (plans_.get(plan->key(), exist_plan)) {
+    // 并发执行相同的SQL时，各自生成了执行计划，保留一个就可以了
+    return;
+  }
+
+  while (plans_.count() >= capacity_) {
+    string victim_key;
+    plans_.foreach_reverse([&victim_key](const string &key, CachedPlan *const &) {
+      victim_key = key;
+      return false;
+    });
+
+    CachedPlan *victim = nullptr;
+    plans_.get(victim_key, victim);
+    plans_.remove(victim_key);
+    delete victim;
+    evictions_++;
+  }
+
+  const string &key = plan->key();
+  plans_.put(key, plan.release());
+}
+
+void PlanCache::invalidate()
+{
+  lock_guard<mutex> guard(lock_);
+  version_++;
+  invalidations_++;
+  clear();
+}
+
+size_t PlanCache::count() const
+{
+  lock_guard<mutex> guard(lock_);
+  return plans_.count();
+}
+
+void PlanCache::clear()
+{
+  plans_.foreach([](const string &, CachedPlan *const &plan) {
+    delete plan;
+    return true;
+  });
+  plans_.destroy();
+}
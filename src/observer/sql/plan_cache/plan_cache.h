@@ -0,0 +1,124 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/lru_cache.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "common/value.h"
+
+class PhysicalOperator;
+class PlanCache;
+class ValueExpr;
+
+/**
+ * @brief 计划缓存中的一个执行计划
+ * @ingroup SQLStage
+ * @details 缓存的执行计划中，SQL里的字面量常量都保留了它们的序号(ValueExpr::param_index)，
+ * 命中缓存时把新SQL中的常量按照序号替换进去，就可以直接执行，不需要再做语法分析、语义解析和优化。
+ * 一个执行计划同时只能被一个请求使用，使用时从缓存中取出，执行完成后再放回去。
+ */
+class CachedPlan
+{
+public:
+  CachedPlan(PlanCache *owner, const string &key, uint64_t version, int param_count);
+  ~CachedPlan();
+
+  PlanCache    *owner() const { return owner_; }
+  const string &key() const { return key_; }
+  uint64_t      version() const { return version_; }
+  int           param_count() const { return param_count_; }
+
+  unique_ptr<PhysicalOperator> &physical_operator() { return operator_; }
+  void                          set_operator(unique_ptr<PhysicalOperator> oper);
+
+  bool used_chunk_mode() const { return used_chunk_mode_; }
+  void set_used_chunk_mode(bool used_chunk_mode) { used_chunk_mode_ = used_chunk_mode; }
+
+  /**
+   * @brief 收集执行计划中所有带序号的常量
+   * @details 如果有算子不支持遍历表达式，或者某个常量在优化过程中被折叠掉了，就不能缓存这个计划
+   */
+  RC collect_params();
+
+  /**
+   * @brief 把新的常量绑定到执行计划中
+   * @details 常量会转换成计划中对应位置的类型，比如与浮点数字段比较的整数常量
+   */
+  RC bind_params(const vector<Value> &params);
+
+private:
+  PlanCache                   *owner_ = nullptr;
+  string                       key_;
+  uint64_t                     version_     = 0;  ///< 生成计划时计划缓存的版本，DDL之后版本变化
+  int                          param_count_ = 0;  ///< SQL中字面量常量的个数
+  unique_ptr<PhysicalOperator> operator_;
+  vector<ValueExpr *>          params_;  ///< 执行计划中所有带序号的常量，同一个序号可能出现多次
+  bool                         used_chunk_mode_ = false;
+};
+
+/**
+ * @brief 执行计划缓存
+ * @ingroup SQLStage
+ * @details 每个DB一个，使用LRU淘汰。key是SQL指纹和会话中影响执行计划的变量。
+ * 执行DDL(包括ANALYZE)之后整个缓存失效，正在被使用的计划执行完成后也不会再放回缓存。
+ */
+class PlanCache
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 128;
+
+public:
+  explicit PlanCache(size_t capacity = DEFAULT_CAPACITY);
+  ~PlanCache();
+
+  uint64_t version() const { return version_.load(); }
+
+  /**
+   * @brief 从缓存中取出执行计划
+   * @return 没有命中时返回空
+   */
+  unique_ptr<CachedPlan> acquire(const string &key);
+
+  /**
+   * @brief 把执行完的计划放回缓存
+   */
+  void release(unique_ptr<CachedPlan> plan);
+
+  /**
+   * @brief 表结构等发生变化，让所有缓存的计划失效
+   */
+  void invalidate();
+
+  uint64_t hits() const { return hits_.load(); }
+  uint64_t misses() const { return misses_.load(); }
+  uint64_t evictions() const { return evictions_.load(); }
+  uint64_t invalidations() const { return invalidations_.load(); }
+  size_t   count() const;
+
+private:
+  void clear();
+
+private:
+  mutable mutex                          lock_;
+  size_t                                 capacity_ = DEFAULT_CAPACITY;
+  common::LruCache<string, CachedPlan *> plans_;
+  atomic<uint64_t>                       version_{0};
+
+  atomic<uint64_t> hits_{0};
+  atomic<uint64_t> misses_{0};
+  atomic<uint64_t> evictions_{0};
+  atomic<uint64_t> invalidations_{0};
+};
@@ -20,5 +20,90 @@ See the Mulan PSL v2 for more details. */
 #include "common/io/io.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "storage/db/db.h"
 
 using namespace common;
+
+RC PlanCacheStage::handle_request(SQLStageEvent *sql_event)
+{
+  Session *session = sql_event->session_event()->session();
+  Db      *db      = session->get_current_db();
+  if (nullptr == db) {
+    return RC::SUCCESS;
+  }
+
+  // 指纹在查询缓存阶段已经计算过了
+  const string        &fingerprint = sql_event->fingerprint();
+  const vector<Value> &params      = sql_event->params();
+  if (fingerprint.empty()) {
+    // 不支持缓存的语句
+    return RC::SUCCESS;
+  }
+
+  PlanCache             &plan_cache = db->plan_cache();
+  const string           key        = plan_key(fingerprint, session);
+  unique_ptr<CachedPlan> plan       = plan_cache.acquire(key);
+  if (nullptr == plan) {
+    sql_event->set_cached_plan(
+        make_unique<CachedPlan>(&plan_cache, key, plan_cache.version(), static_cast<int>(params.size())));
+    return RC::SUCCESS;
+  }
+
+  RC rc = plan->bind_params(params);
+  if (OB_FAIL(rc)) {
+    // 常量不能转换成执行计划需要的类型，按照正常流程处理，由后面的阶段报告错误
+    LOG_TRACE("failed to bind params to cached plan. sql=%s, rc=%s", sql_event->sql().c_str(), strrc(rc));
+    plan_cache.release(std::move(plan));
+    return RC::SUCCESS;
+  }
+
+  LOG_TRACE("plan cache hit. sql=%s", sql_event->sql().c_str());
+  session->set_used_chunk_mode(plan->used_chunk_mode());
+  sql_event->set_operator(std::move(plan->physical_operator()));
+  sql_event->set_cached_plan(std::move(plan));
+  return RC::SUCCESS;
+}
+
+RC PlanCacheStage::add_plan(SQLStageEvent *sql_event)
+{
+  unique_ptr<CachedPlan> &plan = sql_event->cached_plan();
+  if (nullptr == plan) {
+    return RC::SUCCESS;
+  }
+
+  unique_ptr<PhysicalOperator> &physical_operator = sql_event->physical_operator();
+  if (nullptr == physical_operator || sql_event->param_count() != plan->param_count()) {
+    plan.reset();
+    return RC::SUCCESS;
+  }
+
+  plan->set_operator(std::move(physical_operator));
+  RC rc = plan->collect_params();
+  physical_operator = std::move(plan->physical_operator());
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("physical plan cannot be cached. sql=%s, rc=%s", sql_event->sql().c_str(), strrc(rc));
+    plan.reset();
+    return RC::SUCCESS;
+  }
+
+  plan->set_used_chunk_mode(sql_event->session_event()->session()->used_chunk_mode());
+  return RC::SUCCESS;
+}
+
+string PlanCacheStage::plan_key(const string &fingerprint, Session *session)
+{
+  // 会影响执行计划生成的会话变量也需要放到key中
+  string key = fingerprint;
+  key.append("\n");
+  key.append(std::to_string(static_cast<int>(session->get_execution_mode())));
+  key.append(session->hash_join_on() ? "1" : "0");
+  key.append(session->use_cascade() ? "1" : "0");
+  key.append(std::to_string(session->sort_buffer_size()));
+  key.append(",");
+  key.append(std::to_string(session->join_buffer_size()));
+  return key;
+}
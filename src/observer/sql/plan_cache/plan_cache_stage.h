@@ -14,13 +14,38 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/string.h"
 #include "common/sys/rc.h"
 
+class SQLStageEvent;
+class Session;
+
 /**
  * @brief 尝试从Plan的缓存中获取Plan，如果没有命中，则执行Optimizer
  * @ingroup SQLStage
- * @details 实际上现在什么都没做。不过PlanCache对数据库的优化提升明显，是一个非常有趣的功能，
- * 感兴趣的同学可以参考OceanBase的实现
+ * @details 计划缓存是按照SQL指纹来查找的，指纹就是把SQL中的常量替换成占位符之后的文本(参考 parse_fingerprint)。
+ * 命中之后把当前SQL中的常量替换到缓存的执行计划中，跳过语法分析、语义解析和优化，直接执行。
+ * 没有命中时，正常走完Optimizer之后，调用 add_plan 尝试把生成的执行计划加入缓存。
+ * 当前只缓存单条SELECT语句，更多实现可以参考OceanBase。
  */
 class PlanCacheStage
-{};
+{
+public:
+  PlanCacheStage()          = default;
+  virtual ~PlanCacheStage() = default;
+
+public:
+  /**
+   * @brief 在计划缓存中查找执行计划
+   * @details 命中时设置 SQLStageEvent 的物理执行计划，没有命中也返回成功
+   */
+  RC handle_request(SQLStageEvent *sql_event);
+
+  /**
+   * @brief 优化完成后，记录可以缓存的执行计划，执行完成后由 SqlResult 放回缓存
+   */
+  RC add_plan(SQLStageEvent *sql_event);
+
+private:
+  static string plan_key(const string &fingerprint, Session *session);
+};
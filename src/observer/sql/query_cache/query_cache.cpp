@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/query_cache/query_cache.h"
+#include "common/log/log.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+
+using namespace std;
+
+CachedResult::CachedResult(QueryCache *owner, const string &key)
+    : owner_(owner), key_(key), memory_size_(sizeof(CachedResult) + key.size())
+{}
+
+void CachedResult::add_tables(const vector<const Table *> &tables)
+{
+  for (const Table *table : tables) {
+    table_versions_.push_back(TableVersion{table->table_id(), table->data_version()});
+  }
+  memory_size_ += tables.size() * sizeof(TableVersion);
+}
+
+bool CachedResult::valid(Db *db) const
+{
+  for (const TableVersion &table_version : table_versions_) {
+    Table *table = db->find_table(table_version.table_id);
+    if (nullptr == table || table->data_version() != table_version.data_version) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RC CachedResult::add_row(const Tuple &tuple)
+{
+  RC            rc       = RC::SUCCESS;
+  const int     cell_num = tuple.cell_num();
+  vector<Value> row(cell_num);
+  size_t        row_size = sizeof(vector<Value>);
+  for (int i = 0; i < cell_num; i++) {
+    if (OB_FAIL(rc = tuple.cell_at(i, row[i]))) {
+      LOG_WARN("failed to get cell from tuple. index=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+    row_size += value_memory_size(row[i]);
+  }
+
+  if (memory_size_ + row_size > owner_->max_result_size()) {
+    return RC::FULL;
+  }
+
+  rows_.push_back(std::move(row));
+  memory_size_ += row_size;
+  return rc;
+}
+
+size_t CachedResult::value_memory_size(const Value &value)
+{
+  size_t size = sizeof(Value);
+  if (value.is_null()) {
+    return size;
+  }
+
+  switch (value.attr_type()) {
+    case AttrType::CHARS:
+    case AttrType::TEXT:
+    case AttrType::BITMAP:
+    case AttrType::VECTORS: size += value.length(); break;
+    default: break;
+  }
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+QueryCache::QueryCache(size_t capacity, size_t max_result_size)
+    : capacity_(capacity), max_result_size_(max_result_size)
+{}
+
+QueryCache::~QueryCache() = default;
+
+shared_ptr<const CachedResult> QueryCache::get(const string &key, Db *db)
+{
+  lock_guard<mutex> guard(lock_);
+
+  ResultPtr result;
+  if (!results_.get(key, result)) {
+    misses_++;
+    return nullptr;
+  }
+
+  if (!result->valid(db)) {
+    LOG_TRACE("cached query result is stale. key=%s", key.c_str());
+    remove(key);
+    invalidations_++;
+    misses_++;
+    return nullptr;
+  }
+
+  hits_++;
+  return result;
+}
+
+void QueryCache::put(unique_ptr<CachedResult> result, Db *db)
+{
+  if (nullptr == result || result->memory_size() > max_result_size_) {
+    return;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  if (!result->valid(db)) {
+    // 查询执行期间表中的数据被修改了，这个结果可能已经不对了
+    return;
+  }
+
+  ResultPtr exist_result;
+  if (results_.get(result->key(), exist_result)) {
+    remove(result->key());
+  }
+
+  while (memory_usage_ + result->memory_size() > capacity_ && results_.count() > 0) {
+    string victim_key;
+    results_.foreach_reverse([&victim_key](const string &key, const ResultPtr &) {
+      victim_key = key;
+      return false;
+    });
+    remove(victim_key);
+    evictions_++;
+  }
+
+  memory_usage_ += result->memory_size();
+  const string key = result->key();
+  results_.put(key, ResultPtr(std::move(result)));
+  inserts_++;
+}
+
+size_t QueryCache::memory_usage() const
+{
+  lock_guard<mutex> guard(lock_);
+  return memory_usage_;
+}
+
+size_t QueryCache::count() const
+{
+  lock_guard<mutex> guard(lock_);
+  return results_.count();
+}
+
+void QueryCache::remove(const string &key)
+{
+  ResultPtr result;
+  if (results_.get(key, result)) {
+    memory_usage_ -= result->memory_size();
+    results_.remove(key);
+  }
+}
@@ -0,0 +1,149 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/lru_cache.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "common/value.h"
+#include "sql/expr/tuple.h"
+
+class Db;
+class Table;
+class QueryCache;
+
+/**
+ * @brief 查询缓存中的一个查询结果
+ * @ingroup SQLStage
+ * @details 除了结果集之外，还记录了查询访问的表以及执行查询前这些表的数据版本号(Table::data_version)。
+ * 只要有一个表的版本号发生变化(或者表被删除)，这个结果就失效了。
+ * 结果放入缓存之后就不再修改，可以同时被多个请求读取。
+ */
+class CachedResult
+{
+public:
+  CachedResult(QueryCache *owner, const string &key);
+  ~CachedResult() = default;
+
+  QueryCache   *owner() const { return owner_; }
+  const string &key() const { return key_; }
+
+  const TupleSchema &tuple_schema() const { return tuple_schema_; }
+  void               set_tuple_schema(const TupleSchema &schema) { tuple_schema_ = schema; }
+
+  const vector<vector<Value>> &rows() const { return rows_; }
+
+  /**
+   * @brief 当前结果占用的内存大小，包括key和所有的行
+   */
+  size_t memory_size() const { return memory_size_; }
+
+  /**
+   * @brief 记录查询依赖的表和表当前的数据版本
+   * @details 需要在查询执行之前调用
+   */
+  void add_tables(const vector<const Table *> &tables);
+
+  /**
+   * @brief 依赖的表是否都没有变化
+   */
+  bool valid(Db *db) const;
+
+  /**
+   * @brief 追加一行结果
+   * @return 结果超过单个缓存项大小的上限时返回 RC::FULL，这个结果就不能缓存了
+   */
+  RC add_row(const Tuple &tuple);
+
+private:
+  static size_t value_memory_size(const Value &value);
+
+private:
+  /**
+   * @brief 查询依赖的表
+   * @details 记录表ID而不是指针，表被删除之后在DB中就找不到了
+   */
+  struct TableVersion
+  {
+    int32_t  table_id     = -1;
+    uint64_t data_version = 0;
+  };
+
+  QueryCache           *owner_ = nullptr;
+  string                key_;
+  TupleSchema           tuple_schema_;
+  vector<vector<Value>> rows_;
+  vector<TableVersion>  table_versions_;
+  size_t                memory_size_ = 0;
+};
+
+/**
+ * @brief 查询结果缓存
+ * @ingroup SQLStage
+ * @details 每个DB一个，所以key中不需要再包含DB名称。key是规范化之后的SQL(见 parse_fingerprint)以及SQL中的常量。
+ * 缓存按照结果占用的内存大小做LRU淘汰。
+ * 表中的数据变化时不会主动清理缓存，而是在读取缓存时检查依赖的表的版本号，发现过期之后再删除。
+ */
+class QueryCache
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY        = 16 * 1024 * 1024;  ///< 默认最多使用16M内存
+  static constexpr size_t DEFAULT_MAX_RESULT_SIZE = 1024 * 1024;       ///< 单个结果超过1M就不缓存了
+
+public:
+  explicit QueryCache(size_t capacity = DEFAULT_CAPACITY, size_t max_result_size = DEFAULT_MAX_RESULT_SIZE);
+  ~QueryCache();
+
+  size_t max_result_size() const { return max_result_size_; }
+
+  /**
+   * @brief 查找缓存的查询结果
+   * @details 查到的结果如果已经过期，会从缓存中删除
+   * @return 没有命中时返回空
+   */
+  shared_ptr<const CachedResult> get(const string &key, Db *db);
+
+  /**
+   * @brief 把查询结果放入缓存
+   * @details 查询执行期间依赖的表被修改过的话就丢弃
+   */
+  void put(unique_ptr<CachedResult> result, Db *db);
+
+  uint64_t hits() const { return hits_.load(); }
+  uint64_t misses() const { return misses_.load(); }
+  uint64_t inserts() const { return inserts_.load(); }
+  uint64_t evictions() const { return evictions_.load(); }
+  uint64_t invalidations() const { return invalidations_.load(); }
+  size_t   memory_usage() const;
+  size_t   count() const;
+
+private:
+  void remove(const string &key);
+
+private:
+  using ResultPtr = shared_ptr<const CachedResult>;
+
+  mutable mutex                       lock_;
+  size_t                              capacity_        = DEFAULT_CAPACITY;
+  size_t                              max_result_size_ = DEFAULT_MAX_RESULT_SIZE;
+  size_t                              memory_usage_    = 0;
+  common::LruCache<string, ResultPtr> results_;
+
+  atomic<uint64_t> hits_{0};
+  atomic<uint64_t> misses_{0};
+  atomic<uint64_t> inserts_{0};
+  atomic<uint64_t> evictions_{0};
+  atomic<uint64_t> invalidations_{0};
+};
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/13.
 //
 
+#include <bit>
 #include <string.h>
 
 #include "query_cache_stage.h"
@@ -20,10 +21,71 @@ See the Mulan PSL v2 for more details. */
 #include "common/io/io.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/prepared_statement.h"
+#include "session/session.h"
+#include "sql/executor/sql_result.h"
+#include "sql/parser/parse.h"
+#include "sql/query_cache/query_cache.h"
+#include "storage/db/db.h"
 
 using namespace common;
 
 RC QueryCacheStage::handle_request(SQLStageEvent *sql_event)
 {
+  Session *session = sql_event->session_event()->session();
+  Db      *db      = session->get_current_db();
+  if (nullptr == db) {
+    return RC::SUCCESS;
+  }
+
+  string             fingerprint;
+  vector<Value>      params;
+  SessionEvent      *session_event = sql_event->session_event();
+  PreparedStatement *prepared      = session_event->prepared_statement();
+  RC rc = prepared != nullptr ? prepared->fingerprint(session_event->prepared_params(), fingerprint, params)
+                              : parse_fingerprint(sql_event->sql().c_str(), fingerprint, params);
+  if (OB_FAIL(rc)) {
+    // 不支持缓存的语句
+    return RC::SUCCESS;
+  }
+
+  const string key = result_key(fingerprint, params);
+  sql_event->set_fingerprint(fingerprint, std::move(params));
+
+  if (!session->query_cache_on() || session->is_trx_multi_operation_mode()) {
+    return RC::SUCCESS;
+  }
+
+  QueryCache                    &query_cache = db->query_cache();
+  shared_ptr<const CachedResult> result      = query_cache.get(key, db);
+  if (nullptr == result) {
+    sql_event->set_cached_result(make_unique<CachedResult>(&query_cache, key));
+    return RC::SUCCESS;
+  }
+
+  LOG_TRACE("query cache hit. sql=%s", sql_event->sql().c_str());
+  session->set_used_chunk_mode(false);
+  sql_event->session_event()->sql_result()->set_cached_result(std::move(result));
   return RC::SUCCESS;
 }
+
+string QueryCacheStage::result_key(const string &fingerprint, const vector<Value> &params)
+{
+  // 常量的类型和值都放到key中，字符串常量可能包含任意字符，所以带上长度。
+  // 浮点数转换成字符串时可能丢失精度，直接使用它的二进制表示
+  string key = fingerprint;
+  for (const Value &param : params) {
+    const string value = param.attr_type() == AttrType::FLOATS
+                             ? std::to_string(std::bit_cast<uint32_t>(param.get_float()))
+                             : param.to_string();
+    key.append("\n");
+    key.append(std::to_string(static_cast<int>(param.attr_type())));
+    key.append(":");
+    key.append(std::to_string(value.size()));
+    key.append(":");
+    key.append(value);
+  }
+  return key;
+}
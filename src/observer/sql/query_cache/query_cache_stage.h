@@ -14,14 +14,21 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
 #include "common/sys/rc.h"
+#include "common/value.h"
 
 class SQLStageEvent;
 
 /**
  * @brief 查询缓存处理
  * @ingroup SQLStage
- * @details 当前什么都没做
+ * @details 按照SQL指纹(参考 parse_fingerprint)和SQL中的常量查找缓存的查询结果，
+ * 命中之后直接把缓存的结果交给 SqlResult 返回给客户端，不再生成执行计划。
+ * 没有命中时，由执行阶段记录查询依赖的表，SqlResult 在执行完成后把结果放入缓存。
+ * 当前只缓存单条SELECT语句，可以通过会话变量 query_cache 关闭。
+ * 多语句事务中可以看到自己未提交的修改，这时不使用查询缓存。
  */
 class QueryCacheStage
 {
@@ -30,5 +37,12 @@ public:
   virtual ~QueryCacheStage() = default;
 
 public:
+  /**
+   * @brief 计算SQL指纹并查找缓存的查询结果
+   * @details 命中时设置 SqlResult 中的缓存结果，没有命中也返回成功
+   */
   RC handle_request(SQLStageEvent *sql_event);
+
+private:
+  static string result_key(const string &fingerprint, const vector<Value> &params);
 };
@@ -16,7 +16,9 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "sql/stmt/stmt.h"
 
-ExplainStmt::ExplainStmt(unique_ptr<Stmt> child_stmt) : child_stmt_(std::move(child_stmt)) {}
+ExplainStmt::ExplainStmt(unique_ptr<Stmt> child_stmt, bool analyze)
+    : child_stmt_(std::move(child_stmt)), analyze_(analyze)
+{}
 
 RC ExplainStmt::create(Db *db, const ExplainSqlNode &explain, Stmt *&stmt)
 {
@@ -28,6 +30,6 @@ RC ExplainStmt::create(Db *db, const ExplainSqlNode &explain, Stmt *&stmt)
   }
 
   unique_ptr<Stmt> child_stmt_ptr = unique_ptr<Stmt>(child_stmt);
-  stmt                                 = new ExplainStmt(std::move(child_stmt_ptr));
+  stmt                                 = new ExplainStmt(std::move(child_stmt_ptr), explain.analyze);
   return rc;
 }
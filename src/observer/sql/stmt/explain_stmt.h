@@ -23,15 +23,17 @@ See the Mulan PSL v2 for more details. */
 class ExplainStmt : public Stmt
 {
 public:
-  ExplainStmt(unique_ptr<Stmt> child_stmt);
+  ExplainStmt(unique_ptr<Stmt> child_stmt, bool analyze = false);
   virtual ~ExplainStmt() = default;
 
   StmtType type() const override { return StmtType::EXPLAIN; }
 
   Stmt *child() const { return child_stmt_.get(); }
+  bool  analyze() const { return analyze_; }
 
   static RC create(Db *db, const ExplainSqlNode &query, Stmt *&stmt);
 
 private:
   unique_ptr<Stmt> child_stmt_;
+  bool             analyze_ = false;
 };
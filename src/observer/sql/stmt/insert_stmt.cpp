@@ -18,12 +18,14 @@ See the Mulan PSL v2 for more details. */
 #include "storage/db/db.h"
 #include "storage/table/table.h"
 
-InsertStmt::InsertStmt(Table *table, const vector<Value>& values): table_(table), values_(values) {}
+InsertStmt::InsertStmt(Table *table, const vector<Value> &values, int row_num)
+    : table_(table), values_(values), row_num_(row_num)
+{}
 
 RC InsertStmt::create(Db *db, const InsertSqlNode &inserts, Stmt *&stmt)
 {
   const char *relation_name = inserts.relation_name.c_str();
-  if (nullptr == db || nullptr == relation_name || inserts.values.empty()) {
+  if (nullptr == db || nullptr == relation_name || inserts.values.empty() || inserts.row_num == 0) {
     LOG_WARN("invalid argument. db=%p, table_name=%p, value_num=%d",
         db, relation_name, static_cast<int>(inserts.values.size()));
     return RC::INVALID_ARGUMENT;
@@ -31,7 +33,7 @@ RC InsertStmt::create(Db *db, const InsertSqlNode &inserts, Stmt *&stmt)
 
   Table *table = db->find_table(relation_name);
   if (table != nullptr) {
-    return InsertStmt::create(table, inserts.values, stmt);
+    return InsertStmt::create(table, inserts.values, static_cast<int>(inserts.row_num), stmt);
   }
 
   View *view = db->find_view(relation_name);
@@ -51,62 +53,73 @@ RC InsertStmt::create(Db *db, const InsertSqlNode &inserts, Stmt *&stmt)
   ASSERT(table != nullptr, "view's table must not be nullptr");
   const TableMeta& table_meta = table->table_meta();
 
+  const size_t view_value_num = inserts.values.size() / inserts.row_num;
+  if (view_value_num != view_field_metas.size()) {
+    LOG_WARN("schema mismatch. value num=%lu, field num in view=%lu", view_value_num, view_field_metas.size());
+    return RC::SCHEMA_FIELD_MISSING;
+  }
+
   std::vector<Value> values;
-  for (int i = table_meta.unvisible_field_num(); i < table_meta.field_num(); ++i) {
-    const FieldMeta& table_field_meta = *table_meta.field(i);
-    size_t index = 0;
-    for (; index < view_field_metas.size(); ++index) {
-      const auto& view_field_meta = view_field_metas.at(index);
-      if (string{table_field_meta.name()} == view_field_meta.original_field_name()) {
-        break;
+  for (size_t row = 0; row < inserts.row_num; ++row) {
+    for (int i = table_meta.unvisible_field_num(); i < table_meta.field_num(); ++i) {
+      const FieldMeta& table_field_meta = *table_meta.field(i);
+      size_t index = 0;
+      for (; index < view_field_metas.size(); ++index) {
+        const auto& view_field_meta = view_field_metas.at(index);
+        if (string{table_field_meta.name()} == view_field_meta.original_field_name()) {
+          break;
+        }
+      }
+      if (index == view_field_metas.size()) {
+        Value tmp = Value::default_value(table_field_meta.type());
+        tmp.set_null(true);
+        values.push_back(tmp);
+      }
+      else {
+        values.push_back(inserts.values.at(row * view_value_num + index));
       }
-    }
-    if (index == view_field_metas.size()) {
-      Value tmp = Value::default_value(table_field_meta.type());
-      tmp.set_null(true);
-      values.push_back(tmp);
-    }
-    else {
-      values.push_back(inserts.values.at(index));
     }
   }
 
-  return InsertStmt::create(table, values, stmt);
+  return InsertStmt::create(table, values, static_cast<int>(inserts.row_num), stmt);
 }
 
-RC InsertStmt::create(Table* table, const vector<Value>& values, Stmt *&stmt) {
+RC InsertStmt::create(Table* table, const vector<Value>& values, int row_num, Stmt *&stmt) {
   // check the fields number
   const int        value_num  = static_cast<int>(values.size());
   const TableMeta &table_meta = table->table_meta();
   const int        visible_field_num  = table_meta.visible_field_num();
-  if (visible_field_num != value_num) {
-    LOG_WARN("schema mismatch. value num=%d, field num in schema=%d", value_num, visible_field_num);
+  if (visible_field_num * row_num != value_num) {
+    LOG_WARN("schema mismatch. value num=%d, row num=%d, field num in schema=%d", value_num, row_num, visible_field_num);
     return RC::SCHEMA_FIELD_MISSING;
   } 
 
-  // check whether value can be null
   const int unvisible_field_num = table_meta.unvisible_field_num();
-  for (int i = unvisible_field_num; i < table_meta.field_num(); ++i) {
-    const FieldMeta *field_meta = table_meta.field(i);
-    if (!field_meta->nullable() && values[i - unvisible_field_num].is_null()) {
-      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+  for (int row = 0; row < row_num; ++row) {
+    const Value *row_values = values.data() + row * visible_field_num;
+
+    // check whether value can be null
+    for (int i = unvisible_field_num; i < table_meta.field_num(); ++i) {
+      const FieldMeta *field_meta = table_meta.field(i);
+      if (!field_meta->nullable() && row_values[i - unvisible_field_num].is_null()) {
+        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+      }
     }
-  }
 
-  // check text length
-  for (int i = unvisible_field_num; i < table_meta.field_num(); ++i) {
-    const AttrType field_type = table_meta.field(i)->real_type();
-    const Value& value = values[i - unvisible_field_num];
-    if (field_type == AttrType::TEXT && value.attr_type() == AttrType::CHARS) {
-      if (value.length() > TEXT_MAX_SIZE) {
-        LOG_WARN("This string is too long");
-        return RC::INVALID_ARGUMENT;
+    // check text length
+    for (int i = unvisible_field_num; i < table_meta.field_num(); ++i) {
+      const AttrType field_type = table_meta.field(i)->real_type();
+      const Value& value = row_values[i - unvisible_field_num];
+      if (field_type == AttrType::TEXT && value.attr_type() == AttrType::CHARS) {
+        if (value.length() > TEXT_MAX_SIZE) {
+          LOG_WARN("This string is too long");
+          return RC::INVALID_ARGUMENT;
+        }
       }
     }
   }
 
   // everything alright
-  stmt = new InsertStmt(table, values);
+  stmt = new InsertStmt(table, values, row_num);
   return RC::SUCCESS;
 }
-
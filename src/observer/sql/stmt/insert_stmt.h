@@ -29,7 +29,7 @@ class InsertStmt : public Stmt
 public:
   InsertStmt() = default;
   // InsertStmt(Table *table, const Value *values, int value_amount);
-  InsertStmt(Table *table, const vector<Value> &values);
+  InsertStmt(Table *table, const vector<Value> &values, int row_num);
 
   StmtType type() const override { return StmtType::INSERT; }
 
@@ -44,12 +44,14 @@ public:
   int          value_amount() const { return values_.size(); }
 
   vector<Value> &values() { return values_; }
+  int            row_num() const { return row_num_; }
 
 private:
-  static RC create(Table *table, const vector<Value> &values, Stmt *&stmt);
+  static RC create(Table *table, const vector<Value> &values, int row_num, Stmt *&stmt);
 
   Table *table_ = nullptr;
   // const Value *values_       = nullptr;
-  vector<Value> values_;
+  vector<Value> values_;  ///< 所有行的值，一行接一行地存放
+  int           row_num_ = 1;
   // int          value_amount_ = 0;
 };
@@ -0,0 +1,35 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/stmt/stmt.h"
+
+class Db;
+
+/**
+ * @brief 显示数据库运行状态的语句
+ * @ingroup Statement
+ * @details 当前只包含计划缓存的统计信息
+ */
+class ShowStatusStmt : public Stmt
+{
+public:
+  ShowStatusStmt()          = default;
+  virtual ~ShowStatusStmt() = default;
+
+  StmtType type() const override { return StmtType::SHOW_STATUS; }
+
+  static RC create(Db *db, Stmt *&stmt)
+  {
+    stmt = new ShowStatusStmt();
+    return RC::SUCCESS;
+  }
+};
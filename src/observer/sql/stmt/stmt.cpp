@@ -31,6 +31,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/update_stmt.h"
 #include "sql/stmt/select_stmt.h"
 #include "sql/stmt/set_variable_stmt.h"
+#include "sql/stmt/show_status_stmt.h"
 #include "sql/stmt/show_tables_stmt.h"
 #include "sql/stmt/trx_begin_stmt.h"
 #include "sql/stmt/trx_end_stmt.h"
@@ -42,7 +43,8 @@ bool stmt_type_ddl(StmtType type)
     case StmtType::CREATE_VIEW:
     case StmtType::DROP_TABLE:
     case StmtType::DROP_INDEX:
-    case StmtType::CREATE_INDEX: {
+    case StmtType::CREATE_INDEX:
+    case StmtType::CREATE_VECTOR_INDEX: {
       return true;
     }
     default: {
@@ -104,6 +106,10 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt)
       return ShowTablesStmt::create(db, stmt);
     }
 
+    case SCF_SHOW_STATUS: {
+      return ShowStatusStmt::create(db, stmt);
+    }
+
     case SCF_BEGIN: {
       return TrxBeginStmt::create(stmt);
     }
@@ -14,9 +14,13 @@ See the Mulan PSL v2 for more details. */
 #include <errno.h>
 #include <string.h>
 
+#include "common/conf/ini.h"
 #include "common/io/io.h"
 #include "common/lang/mutex.h"
 #include "common/lang/algorithm.h"
+#include "common/lang/limits.h"
+#include "common/lang/string.h"
+#include "common/lang/thread.h"
 #include "common/log/log.h"
 #include "common/math/crc.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -27,6 +31,10 @@ using namespace common;
 
 static const int MEM_POOL_ITEM_NUM = 20;
 
+static const int    DEFAULT_FRAME_SHARD_NUM      = 16;
+static const size_t MAX_FRAME_SHARD_NUM          = 1024;
+static const int    DEFAULT_FRAME_REPLACER_LRU_K = 2;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 string BPFileHeader::to_string() const
@@ -40,36 +48,107 @@ string BPFileHeader::to_string() const
 
 BPFrameManager::BPFrameManager(const char *name) : allocator_(name) {}
 
-RC BPFrameManager::init(int pool_num)
+RC BPFrameManager::init(int pool_num, int shard_num /* = 0 */, FrameReplacerType replacer_type /* = UNDEFINED */)
 {
+  Ini *properties = get_properties();
+
+  if (shard_num <= 0) {
+    shard_num = DEFAULT_FRAME_SHARD_NUM;
+    if (properties != nullptr) {
+      string value = properties->get("FRAME_SHARD_NUM", "", "BUFFER_POOL");
+      if (!value.empty()) {
+        str_to_val(value, shard_num);
+      }
+    }
+  }
+
+  if (replacer_type == FrameReplacerType::UNDEFINED) {
+    replacer_type = FrameReplacerType::LRU;
+    if (properties != nullptr) {
+      string value = properties->get("FRAME_REPLACER", "", "BUFFER_POOL");
+      if (!value.empty() && OB_FAIL(frame_replacer_type_from_string(value, replacer_type))) {
+        LOG_WARN("unknown frame replacer %s, use LRU instead", value.c_str());
+        replacer_type = FrameReplacerType::LRU;
+      }
+    }
+  }
+
+  int lru_k = DEFAULT_FRAME_REPLACER_LRU_K;
+  if (properties != nullptr) {
+    string value = properties->get("FRAME_REPLACER_LRU_K", "", "BUFFER_POOL");
+    if (!value.empty()) {
+      str_to_val(value, lru_k);
+    }
+  }
+
+  // 分片个数取2的幂，这样可以直接用掩码计算页帧所在的分片
+  size_t real_shard_num = 1;
+  while (real_shard_num < static_cast<size_t>(max(shard_num, 1)) && real_shard_num < MAX_FRAME_SHARD_NUM) {
+    real_shard_num <<= 1;
+  }
+
+  shards_.clear();
+  for (size_t i = 0; i < real_shard_num; i++) {
+    auto shard      = make_unique<Shard>();
+    shard->replacer = FrameReplacer::create(replacer_type, lru_k);
+    if (shard->replacer == nullptr) {
+      return RC::INVALID_ARGUMENT;
+    }
+    shards_.push_back(std::move(shard));
+  }
+  shard_mask_    = real_shard_num - 1;
+  replacer_type_ = replacer_type;
+
   int ret = allocator_.init(false, pool_num);
-  if (ret == 0) {
-    return RC::SUCCESS;
+  if (ret != 0) {
+    return RC::NOMEM;
   }
-  return RC::NOMEM;
+
+  LOG_INFO("frame manager init done. shard num=%ld, replacer=%s, lru k=%d",
+           shards_.size(), frame_replacer_type_name(replacer_type_), lru_k);
+  return RC::SUCCESS;
 }
 
 RC BPFrameManager::cleanup()
 {
-  if (frames_.count() > 0) {
+  if (frame_num_.load() > 0) {
     return RC::INTERNAL;
   }
 
-  frames_.destroy();
+  shards_.clear();
   return RC::SUCCESS;
 }
 
-int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+BPFrameManager::Shard &BPFrameManager::shard_of(const FrameId &frame_id)
 {
-  lock_guard<mutex> lock_guard(lock_);
+  // 同一个文件的页面号是连续的，先打散一下再取分片
+  const uint64_t hash = static_cast<uint64_t>(frame_id.hash()) * 0x9E3779B97F4A7C15ULL;
+  return *shards_[(hash >> 32) & shard_mask_];
+}
 
-  vector<Frame *> frames_can_purge;
+int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+{
   if (count <= 0) {
     count = 1;
   }
+
+  /// 每次从不同的分片开始寻找，避免总是淘汰同一个分片中的页面
+  const size_t start       = purge_cursor_.fetch_add(1);
+  int          freed_count = 0;
+  for (size_t i = 0; i < shards_.size() && freed_count < count; i++) {
+    Shard &shard = *shards_[(start + i) & shard_mask_];
+    freed_count += purge_shard_frames(shard, count - freed_count, purger);
+  }
+  LOG_INFO("purge frame done. number=%d", freed_count);
+  return freed_count;
+}
+
+int BPFrameManager::purge_shard_frames(Shard &shard, int count, const function<RC(Frame *frame)> &purger)
+{
+  vector<Frame *> frames_can_purge;
   frames_can_purge.reserve(count);
 
-  auto purge_finder = [&frames_can_purge, count](const FrameId &frame_id, Frame *const frame) {
+  auto purge_finder = [&frames_can_purge, count](Frame *frame) {
     if (frame->can_purge()) {
       frame->pin();
       frames_can_purge.push_back(frame);
@@ -80,53 +159,89 @@ int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
     return true;  // true continue to look up
   };
 
-  frames_.foreach_reverse(purge_finder);
-  LOG_INFO("purge frames find %ld pages total", frames_can_purge.size());
+  {
+    lock_guard<mutex> lock_guard(shard.lock);
+    // 扫描读入的页面优先淘汰，不够时再按照淘汰策略寻找
+    bool need_more = true;
+    for (Frame *frame : shard.scan_frames) {
+      if (!purge_finder(frame)) {
+        need_more = false;
+        break;
+      }
+    }
+    if (need_more) {
+      shard.replacer->foreach_victim(purge_finder);
+    }
+  }
+  LOG_DEBUG("purge frames find %ld pages in shard", frames_can_purge.size());
 
-  /// 当前还在frameManager的锁内，而 purger 是一个非常耗时的操作
-  /// 他需要把脏页数据刷新到磁盘上去，所以这里会极大地降低并发度
+  /// purger 是一个非常耗时的操作，他需要把脏页数据刷新到磁盘上去，
+  /// 所以在分片锁之外执行，刷盘期间其他线程依然可以访问这个分片
   int freed_count = 0;
   for (Frame *frame : frames_can_purge) {
     RC rc = purger(frame);
-    if (RC::SUCCESS == rc) {
-      free_internal(frame->frame_id(), frame);
-      freed_count++;
-    } else {
+    if (OB_FAIL(rc)) {
       frame->unpin();
       LOG_WARN("failed to purge frame. frame_id=%s, rc=%s", 
                frame->frame_id().to_string().c_str(), strrc(rc));
+      continue;
+    }
+
+    lock_guard<mutex> lock_guard(shard.lock);
+    if (frame->pin_count() != 1 || frame->dirty()) {
+      // 刷盘期间页面又被其他线程拿走或者修改了，不能淘汰
+      frame->unpin();
+      continue;
     }
+    free_internal(shard, frame->frame_id(), frame);
+    freed_count++;
   }
-  LOG_INFO("purge frame done. number=%d", freed_count);
   return freed_count;
 }
 
-Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num)
+Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num, BufferAccessMode access /* = NORMAL */)
 {
-  FrameId                     frame_id(buffer_pool_id, page_num);
+  FrameId frame_id(buffer_pool_id, page_num);
+  Shard  &shard = shard_of(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
-  return get_internal(frame_id);
+  lock_guard<mutex> lock_guard(shard.lock);
+  return get_internal(shard, frame_id, access);
 }
 
-Frame *BPFrameManager::get_internal(const FrameId &frame_id)
+Frame *BPFrameManager::get_internal(Shard &shard, const FrameId &frame_id, BufferAccessMode access)
 {
-  Frame *frame = nullptr;
-  (void)frames_.get(frame_id, frame);
-  if (frame != nullptr) {
-    frame->pin();
-    LOG_DEBUG("got a frame. frame=%s", frame->to_string().c_str());
+  auto iter = shard.frames.find(frame_id);
+  if (iter == shard.frames.end()) {
+    return nullptr;
   }
+
+  Frame *frame = iter->second;
+  frame->pin();
+
+  auto scan_iter = shard.scan_nodes.find(frame);
+  if (scan_iter == shard.scan_nodes.end()) {
+    // 扫描不会提高已有页面的淘汰优先级
+    if (access == BufferAccessMode::NORMAL) {
+      shard.replacer->access(frame);
+    }
+  } else if (access == BufferAccessMode::NORMAL) {
+    // 扫描读入的页面又被普通访问了，交给淘汰策略管理
+    shard.scan_frames.erase(scan_iter->second);
+    shard.scan_nodes.erase(scan_iter);
+    shard.replacer->insert(frame);
+  }
+  LOG_DEBUG("got a frame. frame=%s", frame->to_string().c_str());
   return frame;
 }
 
-Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
+Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num, BufferAccessMode access /* = NORMAL */)
 {
   FrameId frame_id(buffer_pool_id, page_num);
+  Shard  &shard = shard_of(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
+  lock_guard<mutex> lock_guard(shard.lock);
 
-  Frame                      *frame = get_internal(frame_id);
+  Frame *frame = get_internal(shard, frame_id, access);
   if (frame != nullptr) {
     return frame;
   }
@@ -138,7 +253,13 @@ Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
     frame->set_buffer_pool_id(buffer_pool_id);
     frame->set_page_num(page_num);
     frame->pin();
-    frames_.put(frame_id, frame);
+    shard.frames.emplace(frame_id, frame);
+    if (access == BufferAccessMode::SCAN) {
+      shard.scan_nodes[frame] = shard.scan_frames.insert(shard.scan_frames.end(), frame);
+    } else {
+      shard.replacer->insert(frame);
+    }
+    frame_num_.fetch_add(1);
     LOG_DEBUG("allocate a new frame. frame=%s", frame->to_string().c_str());
   }
   return frame;
@@ -147,46 +268,91 @@ Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
 RC BPFrameManager::free(int buffer_pool_id, PageNum page_num, Frame *frame)
 {
   FrameId frame_id(buffer_pool_id, page_num);
+  Shard  &shard = shard_of(frame_id);
+
+  lock_guard<mutex> lock_guard(shard.lock);
+  return free_internal(shard, frame_id, frame);
+}
+
+RC BPFrameManager::try_free(int buffer_pool_id, PageNum page_num, Frame *frame)
+{
+  FrameId frame_id(buffer_pool_id, page_num);
+  Shard  &shard = shard_of(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
-  return free_internal(frame_id, frame);
+  lock_guard<mutex> lock_guard(shard.lock);
+  if (frame->pin_count() != 1) {
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+  return free_internal(shard, frame_id, frame);
 }
 
-RC BPFrameManager::free_internal(const FrameId &frame_id, Frame *frame)
+RC BPFrameManager::free_internal(Shard &shard, const FrameId &frame_id, Frame *frame)
 {
-  Frame                *frame_source = nullptr;
-  [[maybe_unused]] bool found        = frames_.get(frame_id, frame_source);
+  auto                  iter         = shard.frames.find(frame_id);
+  Frame                *frame_source = (iter == shard.frames.end()) ? nullptr : iter->second;
+  [[maybe_unused]] bool found        = (frame_source != nullptr);
   ASSERT(found && frame == frame_source && frame->pin_count() == 1,
       "failed to free frame. found=%d, frameId=%s, frame_source=%p, frame=%p, pinCount=%d, lbt=%s",
       found, frame_id.to_string().c_str(), frame_source, frame, frame->pin_count(), lbt());
 
   frame->set_page_num(-1);
   frame->unpin();
-  frames_.remove(frame_id);
+  auto scan_iter = shard.scan_nodes.find(frame);
+  if (scan_iter != shard.scan_nodes.end()) {
+    shard.scan_frames.erase(scan_iter->second);
+    shard.scan_nodes.erase(scan_iter);
+  } else {
+    shard.replacer->remove(frame);
+  }
+  shard.frames.erase(iter);
+  frame_num_.fetch_sub(1);
   allocator_.free(frame);
   return RC::SUCCESS;
 }
 
-list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
+size_t BPFrameManager::scan_frame_num()
 {
-  lock_guard<mutex> lock_guard(lock_);
+  size_t num = 0;
+  for (auto &shard : shards_) {
+    lock_guard<mutex> lock_guard(shard->lock);
+    num += shard->scan_frames.size();
+  }
+  return num;
+}
 
+list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
+{
   list<Frame *> frames;
-  auto               fetcher = [&frames, buffer_pool_id](const FrameId &frame_id, Frame *const frame) -> bool {
-    if (buffer_pool_id == frame_id.buffer_pool_id()) {
-      frame->pin();
-      frames.push_back(frame);
+  for (auto &shard : shards_) {
+    lock_guard<mutex> lock_guard(shard->lock);
+    for (auto &[frame_id, frame] : shard->frames) {
+      if (buffer_pool_id == frame_id.buffer_pool_id()) {
+        frame->pin();
+        frames.push_back(frame);
+      }
     }
-    return true;
-  };
-  frames_.foreach (fetcher);
+  }
   return frames;
 }
 
+void BPFrameManager::dirty_frames(vector<pair<FrameId, LSN>> &frames)
+{
+  frames.clear();
+  for (auto &shard : shards_) {
+    lock_guard<mutex> lock_guard(shard->lock);
+    for (auto &[frame_id, frame] : shard->frames) {
+      const LSN rec_lsn = frame->rec_lsn();
+      if (frame->dirty() || rec_lsn != 0) {
+        frames.emplace_back(frame_id, rec_lsn);
+      }
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 BufferPoolIterator::BufferPoolIterator() {}
 BufferPoolIterator::~BufferPoolIterator() {}
-RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
+RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */, bool prefetch /* = false */)
 {
   bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
   if (start_page <= 0) {
@@ -194,6 +360,11 @@ RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
   } else {
     current_page_num_ = start_page - 1;
   }
+
+  buffer_pool_      = &bp;
+  prefetch_pages_   = prefetch ? max(bp.bp_manager_.io_options().scan_prefetch_pages, 0) : 0;
+  prefetch_end_     = -1;
+  prefetch_trigger_ = -1;
   return RC::SUCCESS;
 }
 
@@ -204,13 +375,50 @@ PageNum BufferPoolIterator::next()
   PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
   if (next_page != -1) {
     current_page_num_ = next_page;
+    if (prefetch_pages_ > 0 && next_page >= prefetch_trigger_) {
+      prefetch(next_page);
+    }
   }
   return next_page;
 }
 
+void BufferPoolIterator::prefetch(PageNum page_num)
+{
+  vector<PageNum> page_nums;
+  page_nums.reserve(prefetch_pages_);
+
+  // 已经预读过的页面不再重复提交
+  PageNum page = max(page_num, prefetch_end_);
+  while (static_cast<int>(page_nums.size()) < prefetch_pages_) {
+    page = bitmap_.next_setted_bit(page);
+    if (page == -1) {
+      break;
+    }
+    page_nums.push_back(page);
+    page++;
+  }
+
+  if (page_nums.empty()) {
+    // 后面没有页面了
+    prefetch_trigger_ = numeric_limits<PageNum>::max();
+    return;
+  }
+
+  prefetch_end_     = page_nums.back() + 1;
+  prefetch_trigger_ = page_nums[page_nums.size() / 2];
+
+  RC rc = buffer_pool_->prefetch_pages(page_nums);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to prefetch pages. file=%s, first page=%d, page num=%d, rc=%s",
+             buffer_pool_->filename(), page_nums.front(), static_cast<int>(page_nums.size()), strrc(rc));
+  }
+}
+
 RC BufferPoolIterator::reset()
 {
   current_page_num_ = 0;
+  prefetch_end_     = -1;
+  prefetch_trigger_ = -1;
   return RC::SUCCESS;
 }
 
@@ -261,7 +469,9 @@ RC DiskBufferPool::open_file(const char *file_name)
   hdr_frame_->set_buffer_pool_id(id());
   hdr_frame_->access();
 
-  if ((rc = load_page(BP_HEADER_PAGE, hdr_frame_)) != RC::SUCCESS) {
+  rc = load_page(BP_HEADER_PAGE, hdr_frame_);
+  hdr_frame_->finish_load(OB_SUCC(rc));
+  if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to load first page of %s, due to %s.", file_name, strerror(errno));
     purge_frame(BP_HEADER_PAGE, hdr_frame_);
     close(fd);
@@ -283,6 +493,9 @@ RC DiskBufferPool::close_file()
     return rc;
   }
 
+  // 预读的页帧在读取完成之前一直pin着，不能释放
+  wait_prefetch_done();
+
   hdr_frame_->unpin();
 
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
@@ -300,54 +513,229 @@ RC DiskBufferPool::close_file()
 
   disposed_pages_.clear();
 
-  if (close(file_desc_) < 0) {
-    LOG_ERROR("Failed to close fileId:%d, fileName:%s, error:%s", file_desc_, file_name_.c_str(), strerror(errno));
-    return RC::IOERR_CLOSE;
+  {
+    // page cleaner 持有 lock_ 时会检查文件是否已经关闭，见 BufferPoolManager::lock_buffer_pool
+    scoped_lock lock_guard(lock_);
+    if (close(file_desc_) < 0) {
+      LOG_ERROR("Failed to close fileId:%d, fileName:%s, error:%s", file_desc_, file_name_.c_str(), strerror(errno));
+      return RC::IOERR_CLOSE;
+    }
+    LOG_INFO("Successfully close file %d:%s.", file_desc_, file_name_.c_str());
+    file_desc_ = -1;
   }
-  LOG_INFO("Successfully close file %d:%s.", file_desc_, file_name_.c_str());
-  file_desc_ = -1;
 
   bp_manager_.close_file(file_name_.c_str());
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
+RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame, BufferAccessMode access /* = NORMAL */)
 {
   RC rc  = RC::SUCCESS;
   *frame = nullptr;
 
-  Frame *used_match_frame = frame_manager_.get(id(), page_num);
-  if (used_match_frame != nullptr) {
-    used_match_frame->access();
-    *frame = used_match_frame;
-    return RC::SUCCESS;
-  }
+  read_ahead(page_num);
 
-  scoped_lock lock_guard(lock_);  // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
+  Frame *used_match_frame = frame_manager_.get(id(), page_num, access);
+  if (used_match_frame == nullptr) {
+    scoped_lock lock_guard(lock_);  // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
 
-  // Allocate one page and load the data into this page
-  Frame *allocated_frame = nullptr;
+    // 等锁期间其它线程可能已经加载或者正在预读这个页面
+    used_match_frame = frame_manager_.get(id(), page_num, access);
+    if (used_match_frame == nullptr) {
+      // Allocate one page and load the data into this page
+      Frame *allocated_frame = nullptr;
 
-  rc = allocate_frame(page_num, &allocated_frame);
-  if (rc != RC::SUCCESS) {
-    LOG_ERROR("Failed to alloc frame %s:%d, due to failed to alloc page.", file_name_.c_str(), page_num);
-    return rc;
-  }
+      rc = allocate_frame(page_num, &allocated_frame, access);
+      if (rc != RC::SUCCESS) {
+        LOG_ERROR("Failed to alloc frame %s:%d, due to failed to alloc page.", file_name_.c_str(), page_num);
+        return rc;
+      }
 
-  allocated_frame->set_buffer_pool_id(id());
-  // allocated_frame->pin(); // pined in manager::get
-  allocated_frame->access();
+      allocated_frame->set_buffer_pool_id(id());
+      // allocated_frame->pin(); // pined in manager::get
+      allocated_frame->access();
+
+      // 页帧已经放到frame manager中，其它线程可以直接拿到它。加载期间持有写锁，
+      // 加锁读的线程会等待加载完成，乐观读的线程也能通过版本号发现页面内容变了
+      allocated_frame->write_latch();
+      rc = load_page(page_num, allocated_frame);
+      allocated_frame->write_unlatch();
+      allocated_frame->finish_load(OB_SUCC(rc));
+      if (rc != RC::SUCCESS) {
+        LOG_ERROR("Failed to load page %s:%d", file_name_.c_str(), page_num);
+        purge_frame(page_num, allocated_frame);
+        return rc;
+      }
+
+      *frame = allocated_frame;
+      return RC::SUCCESS;
+    }
+  }
 
-  if ((rc = load_page(page_num, allocated_frame)) != RC::SUCCESS) {
-    LOG_ERROR("Failed to load page %s:%d", file_name_.c_str(), page_num);
-    purge_frame(page_num, allocated_frame);
+  used_match_frame->access();
+  rc = wait_page_loaded(page_num, used_match_frame);
+  if (OB_FAIL(rc)) {
+    used_match_frame->unpin();
     return rc;
   }
 
-  *frame = allocated_frame;
+  *frame = used_match_frame;
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::wait_page_loaded(PageNum page_num, Frame *frame)
+{
+  while (!frame->wait_loaded()) {
+    if (!frame->reset_load()) {
+      // 其它线程正在重新加载
+      continue;
+    }
+
+    // 预读失败了，再同步读一次
+    frame->write_latch();
+    RC rc = load_page(page_num, frame);
+    frame->write_unlatch();
+    frame->finish_load(OB_SUCC(rc));
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to reload page %s:%d. rc=%s", file_name_.c_str(), page_num, strrc(rc));
+      return rc;
+    }
+  }
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::prefetch_pages(const vector<PageNum> &page_nums)
+{
+  RC rc = RC::SUCCESS;
+
+  vector<IoRequest> requests;
+  {
+    scoped_lock lock_guard(lock_);
+    if (file_desc_ < 0) {
+      return RC::SUCCESS;
+    }
+
+    for (PageNum page_num : page_nums) {
+      if (!page_allocated(page_num)) {
+        continue;
+      }
+
+      Frame *frame = frame_manager_.get(id(), page_num, BufferAccessMode::SCAN);
+      if (frame != nullptr) {
+        frame->unpin();
+        continue;
+      }
+
+      rc = allocate_frame(page_num, &frame, BufferAccessMode::SCAN);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to allocate frame for prefetch. file=%s, page=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+        break;
+      }
+      frame->set_buffer_pool_id(id());
+
+      // double write buffer 中的页面比磁盘上的新，直接从内存中拷贝
+      if (OB_SUCC(dblwr_manager_.read_page(this, page_num, frame->page()))) {
+        frame->finish_load(true);
+        frame->unpin();
+        continue;
+      }
+
+      // 页帧在读取完成之前一直pin着，不会被淘汰。IO线程中不能访问buffer pool的其它数据
+      auto callback = [this, frame, page_num](RC rc) {
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to prefetch page %s:%d. rc=%s", file_name_.c_str(), page_num, strrc(rc));
+        }
+        frame->finish_load(OB_SUCC(rc));
+        frame->unpin();
+
+        scoped_lock guard(prefetch_lock_);
+        if (--prefetch_num_ == 0) {
+          prefetch_cv_.notify_all();
+        }
+      };
+
+      requests.emplace_back(IoRequest::read(
+          file_desc_, &frame->page(), BP_PAGE_SIZE, static_cast<int64_t>(page_num) * BP_PAGE_SIZE, std::move(callback)));
+    }
+
+    if (!requests.empty()) {
+      scoped_lock guard(prefetch_lock_);
+      prefetch_num_ += static_cast<int>(requests.size());
+    }
+  }
+
+  // 记录预读到了哪里，BufferPoolIterator 预读时顺序访问检测就不需要再预读一遍
+  if (!page_nums.empty()) {
+    const PageNum end     = *max_element(page_nums.begin(), page_nums.end()) + 1;
+    PageNum       old_end = read_ahead_end_.load(std::memory_order_relaxed);
+    while (old_end < end && !read_ahead_end_.compare_exchange_weak(old_end, end, std::memory_order_relaxed)) {
+    }
+  }
+
+  if (!requests.empty()) {
+    LOG_DEBUG("prefetch pages. file=%s, first page=%d, page num=%d",
+              file_name_.c_str(), page_nums.front(), static_cast<int>(requests.size()));
+    RC ret = bp_manager_.io_backend().submit(requests);
+    if (OB_FAIL(ret)) {
+      rc = ret;
+    }
+  }
+  return rc;
+}
+
+void DiskBufferPool::read_ahead(PageNum page_num)
+{
+  const PageIoOptions &options = bp_manager_.io_options();
+  if (options.read_ahead_pages <= 0) {
+    return;
+  }
+
+  const PageNum last_page = last_access_page_.exchange(page_num, std::memory_order_relaxed);
+  if (page_num == last_page) {
+    return;
+  }
+  if (page_num != last_page + 1) {
+    sequential_count_.store(0, std::memory_order_relaxed);
+    return;
+  }
+  if (sequential_count_.fetch_add(1, std::memory_order_relaxed) + 1 < options.read_ahead_threshold) {
+    return;
+  }
+
+  // 前面预读的页面还有一半以上没有访问，先不预读。
+  // 预读位置远在当前页面之后，说明是上一次顺序访问留下的，重新从当前页面开始
+  PageNum end = read_ahead_end_.load(std::memory_order_relaxed);
+  if (end > page_num + options.read_ahead_pages / 2 && end <= page_num + options.read_ahead_pages * 2) {
+    return;
+  }
+
+  PageNum start = (end > page_num && end <= page_num + options.read_ahead_pages * 2) ? end : page_num + 1;
+  // 页面个数在没有加锁的情况下读取，只用来限制预读的范围，预读时还会在锁内检查
+  PageNum new_end = min(start + options.read_ahead_pages, static_cast<PageNum>(file_header_->page_count));
+  if (start >= new_end || !read_ahead_end_.compare_exchange_strong(end, new_end, std::memory_order_relaxed)) {
+    // 没有页面可以预读，或者其它线程已经在预读了
+    return;
+  }
+
+  vector<PageNum> page_nums;
+  page_nums.reserve(new_end - start);
+  for (PageNum page = start; page < new_end; page++) {
+    page_nums.push_back(page);
+  }
+
+  LOG_TRACE("sequential access detected. file=%s, page=%d, read ahead [%d, %d)", file_name_.c_str(), page_num, start, new_end);
+  RC rc = prefetch_pages(page_nums);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to read ahead pages. file=%s, first page=%d, rc=%s", file_name_.c_str(), start, strrc(rc));
+  }
+}
+
+void DiskBufferPool::wait_prefetch_done()
+{
+  unique_lock<mutex> guard(prefetch_lock_);
+  prefetch_cv_.wait(guard, [this]() { return prefetch_num_ == 0; });
+}
+
 RC DiskBufferPool::allocate_page(Frame **frame)
 {
   RC rc = RC::SUCCESS;
@@ -420,6 +808,7 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   allocated_frame->access();
   allocated_frame->clear_page();
   allocated_frame->set_page_num(file_header_->page_count - 1);
+  allocated_frame->finish_load(true);
 
   // Use flush operation to extension file
   if ((rc = flush_page_internal(*allocated_frame)) != RC::SUCCESS) {
@@ -444,8 +833,10 @@ RC DiskBufferPool::dispose_page(PageNum page_num)
   scoped_lock lock_guard(lock_);
   Frame           *used_frame = frame_manager_.get(id(), page_num);
   if (used_frame != nullptr) {
-    ASSERT("the page try to dispose is in use. frame:%s", used_frame->to_string().c_str());
-    frame_manager_.free(id(), page_num, used_frame);
+    // B+树的乐观读可能还pin着这个页面，它们不会再申请其它资源，校验失败后马上就会释放
+    while (frame_manager_.try_free(id(), page_num, used_frame) == RC::LOCKED_CONCURRENCY_CONFLICT) {
+      this_thread::yield();
+    }
   } else {
     LOG_DEBUG("page not found in memory while disposing it. pageNum=%d", page_num);
   }
@@ -566,6 +957,29 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::clean_page_internal(PageNum page_num)
+{
+  // 后台刷脏不算是对页面的访问，不能影响淘汰顺序
+  Frame *frame = frame_manager_.get(id(), page_num, BufferAccessMode::SCAN);
+  if (frame == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  // 持有 lock_ 时不能阻塞等待页面的锁，修改页面的线程会先加页面锁再申请 lock_
+  RC rc = RC::SUCCESS;
+  if (frame->try_read_latch()) {
+    if (frame->dirty() || frame->rec_lsn() != 0) {
+      rc = flush_page_internal(*frame);
+    }
+    frame->read_unlatch();
+  } else {
+    rc = RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  frame->unpin();
+  return rc;
+}
+
 RC DiskBufferPool::flush_all_pages()
 {
   list<Frame *> used = frame_manager_.find_list(id());
@@ -685,7 +1099,7 @@ RC DiskBufferPool::redo_deallocate_page(LSN lsn, PageNum page_num)
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
+RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer, BufferAccessMode access /* = NORMAL */)
 {
   auto purger = [this](Frame *frame) {
     if (!frame->dirty()) {
@@ -706,7 +1120,7 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
   };
 
   while (true) {
-    Frame *frame = frame_manager_.alloc(id(), page_num);
+    Frame *frame = frame_manager_.alloc(id(), page_num, access);
     if (frame != nullptr) {
       *buffer = frame;
       LOG_DEBUG("allocate frame %p, page num %d, frame=%s", frame, page_num, frame->to_string().c_str());
@@ -721,17 +1135,21 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
 
 RC DiskBufferPool::check_page_num(PageNum page_num)
 {
-  if (page_num >= file_header_->page_count) {
-    LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
-    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
-  }
-  if ((file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
+  if (!page_allocated(page_num)) {
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
   return RC::SUCCESS;
 }
 
+bool DiskBufferPool::page_allocated(PageNum page_num) const
+{
+  if (page_num < 0 || page_num >= file_header_->page_count) {
+    return false;
+  }
+  return (file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) != 0;
+}
+
 RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
 {
   Page &page = frame->page();
@@ -772,6 +1190,7 @@ BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */)
   }
   const int pool_num = max(memory_size / BP_PAGE_SIZE / DEFAULT_ITEM_NUM_PER_POOL, 1);
   frame_manager_.init(pool_num);
+  io_backend_ = make_unique<SyncIoBackend>();
   LOG_INFO("buffer pool manager init with memory size %d, page num: %d, pool num: %d",
            memory_size, pool_num * DEFAULT_ITEM_NUM_PER_POOL, pool_num);
 }
@@ -788,6 +1207,8 @@ BufferPoolManager::~BufferPoolManager()
 
 RC BufferPoolManager::init(unique_ptr<DoubleWriteBuffer> dblwr_buffer)
 {
+  io_options_   = PageIoOptions::from_properties();
+  io_backend_   = IoBackend::create(io_options_);
   dblwr_buffer_ = std::move(dblwr_buffer);
   return RC::SUCCESS;
 }
@@ -892,17 +1313,57 @@ RC BufferPoolManager::close_file(const char *_file_name)
 
 RC BufferPoolManager::flush_page(Frame &frame)
 {
-  int buffer_pool_id = frame.buffer_pool_id();
+  DiskBufferPool *bp = nullptr;
+  RC              rc = lock_buffer_pool(frame.buffer_pool_id(), bp);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = bp->flush_page_internal(frame);
+  bp->lock_.unlock();
+  return rc;
+}
+
+RC BufferPoolManager::clean_page(const FrameId &frame_id)
+{
+  DiskBufferPool *bp = nullptr;
+  RC              rc = lock_buffer_pool(frame_id.buffer_pool_id(), bp);
+  if (rc == RC::INTERNAL) {
+    // 文件已经关闭了，页面也会跟着释放
+    return RC::SUCCESS;
+  } else if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = bp->clean_page_internal(frame_id.page_num());
+  bp->lock_.unlock();
+  return rc;
+}
+
+RC BufferPoolManager::lock_buffer_pool(int32_t id, DiskBufferPool *&bp)
+{
+  bp = nullptr;
 
   scoped_lock lock_guard(lock_);
-  auto             iter = id_to_buffer_pools_.find(buffer_pool_id);
+  auto        iter = id_to_buffer_pools_.find(id);
   if (iter == id_to_buffer_pools_.end()) {
-    LOG_WARN("unknown buffer pool of id %d", buffer_pool_id);
+    LOG_WARN("unknown buffer pool of id %d", id);
     return RC::INTERNAL;
   }
 
-  DiskBufferPool *bp = iter->second;
-  return bp->flush_page(frame);
+  DiskBufferPool *tmp_bp = iter->second;
+  if (!tmp_bp->lock_.try_lock()) {
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  if (tmp_bp->file_desc_ < 0) {
+    // 正在关闭
+    tmp_bp->lock_.unlock();
+    return RC::INTERNAL;
+  }
+
+  bp = tmp_bp;
+  return RC::SUCCESS;
 }
 
 RC BufferPoolManager::get_buffer_pool(int32_t id, DiskBufferPool *&bp)
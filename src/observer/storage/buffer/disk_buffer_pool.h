@@ -25,15 +25,19 @@ See the Mulan PSL v2 for more details. */
 #include <time.h>
 #include <optional>
 
+#include "common/lang/atomic.h"
 #include "common/lang/bitmap.h"
 #include "common/lang/lru_cache.h"
 #include "common/lang/mutex.h"
 #include "common/lang/memory.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
 #include "common/mm/mem_pool.h"
 #include "common/sys/rc.h"
 #include "common/types.h"
 #include "storage/buffer/frame.h"
+#include "storage/buffer/frame_replacer.h"
+#include "storage/buffer/io_backend.h"
 #include "storage/buffer/page.h"
 #include "storage/buffer/buffer_pool_log.h"
 
@@ -77,6 +81,20 @@ struct BPFileHeader
   string to_string() const;
 };
 
+/**
+ * @brief 访问页面的方式
+ * @ingroup BufferPool
+ * @details 大表的顺序扫描通常每个页面只访问一次，如果和普通访问一样交给淘汰策略，扫描一遍就会把
+ * 其它查询反复访问的页面挤出内存。扫描读入的页面放在单独的先进先出队列中，淘汰时优先淘汰它们，
+ * 类似 PostgreSQL 顺序扫描使用的环形缓冲区(BufferAccessStrategy)。
+ * 扫描页面被普通方式访问时才交给淘汰策略管理；扫描访问已经在淘汰策略中的页面，不会提高它的优先级。
+ */
+enum class BufferAccessMode
+{
+  NORMAL,  ///< 普通访问
+  SCAN,    ///< 顺序扫描或者预读，页面大概率只会访问一次
+};
+
 /**
  * @brief 管理页面Frame
  * @ingroup BufferPool
@@ -84,13 +102,23 @@ struct BPFileHeader
  * 当内存中的页帧不够用时，需要从内存中淘汰一些页帧，以便为新的页帧腾出空间。
  * 这个管理器负责为所有的BufferPool提供页帧管理服务，也就是所有的BufferPool磁盘文件
  * 在访问时都使用这个管理器映射到内存。
+ * 页帧按照FrameId的哈希值分散到多个分片中，每个分片有自己的锁和淘汰策略，不同分片上的
+ * 操作可以并行执行。页帧内存由所有分片共享，淘汰时从多个分片中轮流寻找可以淘汰的页帧。
+ * 扫描读入的页面不进入淘汰策略，见 BufferAccessMode。
  */
 class BPFrameManager
 {
 public:
   BPFrameManager(const char *tag);
 
-  RC init(int pool_num);
+  /**
+   * @brief 初始化
+   *
+   * @param pool_num 页帧内存池的个数，每个内存池有 DEFAULT_ITEM_NUM_PER_POOL 个页帧
+   * @param shard_num 分片个数，会向上取整为2的幂。小于等于0时从配置文件中读取
+   * @param replacer_type 淘汰策略。UNDEFINED 时从配置文件中读取
+   */
+  RC init(int pool_num, int shard_num = 0, FrameReplacerType replacer_type = FrameReplacerType::UNDEFINED);
   RC cleanup();
 
   /**
@@ -98,9 +126,10 @@ public:
    *
    * @param buffer_pool_id buffer Pool标识
    * @param page_num  页面号
+   * @param access 访问方式
    * @return Frame* 页帧指针
    */
-  Frame *get(int buffer_pool_id, PageNum page_num);
+  Frame *get(int buffer_pool_id, PageNum page_num, BufferAccessMode access = BufferAccessMode::NORMAL);
 
   /**
    * @brief 列出所有指定文件的页面
@@ -110,14 +139,23 @@ public:
    */
   list<Frame *> find_list(int buffer_pool_id);
 
+  /**
+   * @brief 列出所有的脏页以及它们的rec lsn
+   * @details 不会pin页帧，拿到的只是一个快照，给 page cleaner 挑选要刷新的页面以及计算检查点使用。
+   * 写完日志还没有来得及标记为脏的页帧(rec lsn不是0)也会列出来。
+   * @param frames 页帧编号和rec lsn
+   */
+  void dirty_frames(vector<pair<FrameId, LSN>> &frames);
+
   /**
    * @brief 分配一个新的页面
    *
    * @param buffer_pool_id buffer Pool标识
    * @param page_num 页面编号
+   * @param access 访问方式，扫描读入的页面会优先淘汰
    * @return Frame* 页帧指针
    */
-  Frame *alloc(int buffer_pool_id, PageNum page_num);
+  Frame *alloc(int buffer_pool_id, PageNum page_num, BufferAccessMode access = BufferAccessMode::NORMAL);
 
   /**
    * 尽管frame中已经包含了buffer_pool_id和page_num，但是依然要求
@@ -125,25 +163,37 @@ public:
    */
   RC free(int buffer_pool_id, PageNum page_num, Frame *frame);
 
+  /**
+   * @brief 如果只有调用者自己pin着这个页帧，就释放它
+   * @details 乐观读的线程不加锁，可能还短暂地pin着已经从B+树中删除的页面，它们校验版本号失败后就会释放
+   * @return 还有其他人pin着时返回 LOCKED_CONCURRENCY_CONFLICT，页帧保持不变
+   */
+  RC try_free(int buffer_pool_id, PageNum page_num, Frame *frame);
+
   /**
    * 如果不能从空闲链表中分配新的页面，就使用这个接口，
    * 尝试从pin count=0的页面中淘汰一些
    * @param count 想要purge多少个页面
-   * @param purger 需要在释放frame之前，对页面做些什么操作。当前是刷新脏数据到磁盘
+   * @param purger 需要在释放frame之前，对页面做些什么操作。当前是刷新脏数据到磁盘。
+   *               purger 在分片锁之外执行
    * @return 返回本次清理了多少个页面
    */
   int purge_frames(int count, function<RC(Frame *frame)> purger);
 
-  size_t frame_num() const { return frames_.count(); }
+  size_t frame_num() const { return frame_num_.load(); }
+
+  /**
+   * @brief 扫描队列中的页帧个数
+   */
+  size_t scan_frame_num();
 
   /**
    * 测试使用。返回已经从内存申请的个数
    */
   size_t total_frame_num() const { return allocator_.get_size(); }
 
-private:
-  Frame *get_internal(const FrameId &frame_id);
-  RC     free_internal(const FrameId &frame_id, Frame *frame);
+  int               shard_num() const { return static_cast<int>(shards_.size()); }
+  FrameReplacerType replacer_type() const { return replacer_type_; }
 
 private:
   class BPFrameIdHasher
@@ -152,17 +202,44 @@ private:
     size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
   };
 
-  using FrameLruCache  = common::LruCache<FrameId, Frame *, BPFrameIdHasher>;
+  using FrameMap       = unordered_map<FrameId, Frame *, BPFrameIdHasher>;
   using FrameAllocator = common::MemPoolSimple<Frame>;
 
-  mutex          lock_;
-  FrameLruCache  frames_;
-  FrameAllocator allocator_;
+  /**
+   * @brief 页帧分片
+   * @details 所有成员都由 lock 保护。一个页帧要么在 scan_frames 中，要么由 replacer 管理
+   */
+  struct Shard
+  {
+    mutex                     lock;
+    FrameMap                  frames;
+    unique_ptr<FrameReplacer> replacer;
+
+    list<Frame *>                                   scan_frames;  ///< 扫描读入的页帧，头部最先淘汰
+    unordered_map<Frame *, list<Frame *>::iterator> scan_nodes;
+  };
+
+private:
+  Shard &shard_of(const FrameId &frame_id);
+
+  Frame *get_internal(Shard &shard, const FrameId &frame_id, BufferAccessMode access);
+  RC     free_internal(Shard &shard, const FrameId &frame_id, Frame *frame);
+  int    purge_shard_frames(Shard &shard, int count, const function<RC(Frame *frame)> &purger);
+
+private:
+  vector<unique_ptr<Shard>> shards_;
+  size_t                    shard_mask_    = 0;
+  FrameReplacerType         replacer_type_ = FrameReplacerType::UNDEFINED;
+  atomic<size_t>            frame_num_{0};     ///< 所有分片中的页帧个数
+  atomic<size_t>            purge_cursor_{0};  ///< 下一次淘汰从哪个分片开始找
+  FrameAllocator            allocator_;
 };
 
 /**
  * @brief 用于遍历BufferPool中的所有页面
  * @ingroup BufferPool
+ * @details 可以开启预读，遍历的同时异步加载后面的页面，见 DiskBufferPool::prefetch_pages。
+ * 预读窗口的大小由配置项 SCAN_PREFETCH_PAGES 决定，遍历到窗口的一半时就开始预读下一个窗口。
  */
 class BufferPoolIterator
 {
@@ -170,14 +247,24 @@ public:
   BufferPoolIterator();
   ~BufferPoolIterator();
 
-  RC      init(DiskBufferPool &bp, PageNum start_page = 0);
+  /**
+   * @param prefetch 是否预读后面的页面，只有接下来要访问每个页面的场景(比如全表扫描)才值得开启
+   */
+  RC      init(DiskBufferPool &bp, PageNum start_page = 0, bool prefetch = false);
   bool    has_next();
   PageNum next();
   RC      reset();
 
 private:
-  common::Bitmap bitmap_;
-  PageNum        current_page_num_ = -1;
+  void prefetch(PageNum page_num);
+
+private:
+  common::Bitmap  bitmap_;
+  PageNum         current_page_num_ = -1;
+  DiskBufferPool *buffer_pool_      = nullptr;
+  int             prefetch_pages_   = 0;   ///< 预读窗口的大小，0 表示不预读
+  PageNum         prefetch_end_     = -1;  ///< 已经预读到了哪个页面(不包含)
+  PageNum         prefetch_trigger_ = -1;  ///< 遍历到这个页面时开始预读下一个窗口
 };
 
 /**
@@ -185,6 +272,8 @@ private:
  * @ingroup BufferPool
  * @details 一个文件被划分成多个相同大小的页面，并在需要访问的时候，会从文件读取到内存中。
  * DiskBufferPool 就负责管理磁盘文件，以及负责管理页面在文件与内存中的交互，比如读取、写回。
+ * 连续访问了 READ_AHEAD_THRESHOLD 个相邻的页面后，认为是在顺序访问，会异步预读后面的 READ_AHEAD_PAGES
+ * 个页面，访问到预读窗口的一半时再预读下一个窗口。这样没有使用 BufferPoolIterator 的顺序访问也能用上预读。
  */
 class DiskBufferPool final
 {
@@ -205,8 +294,17 @@ public:
 
   /**
    * 根据文件ID和页号获取指定页面到缓冲区，返回页面句柄指针。
+   * @param access 访问方式。全表扫描这种每个页面只访问一次的场景使用 SCAN，避免把热点页面挤出内存
+   */
+  RC get_this_page(PageNum page_num, Frame **frame, BufferAccessMode access = BufferAccessMode::NORMAL);
+
+  /**
+   * @brief 异步预读一批页面
+   * @details 不在内存中的页面会分配页帧，通过IO后端一次提交所有的读请求，不等待读取完成。
+   * 之后 get_this_page 拿到还在读取的页面时会等待读取结束。预读的页面不会一直pin在内存中，
+   * 读取完成后放在扫描队列中，被普通访问之前优先淘汰。没有分配的页面会直接跳过。
    */
-  RC get_this_page(PageNum page_num, Frame **frame);
+  RC prefetch_pages(const vector<PageNum> &page_nums);
 
   /**
    * @brief 在指定文件中分配一个新的页面，并将其放入缓冲区，返回页面句柄指针。
@@ -275,24 +373,48 @@ public:
   const char *filename() const { return file_name_.c_str(); }
 
 protected:
-  RC allocate_frame(PageNum page_num, Frame **buf);
+  RC allocate_frame(PageNum page_num, Frame **buf, BufferAccessMode access = BufferAccessMode::NORMAL);
 
   /**
    * 刷新指定页面到磁盘(flush)，并且释放关联的Frame
    */
   RC purge_frame(PageNum page_num, Frame *used_frame);
   RC check_page_num(PageNum page_num);
+  bool page_allocated(PageNum page_num) const;
 
   /**
    * 加载指定页面的数据到内存中
    */
   RC load_page(PageNum page_num, Frame *frame);
 
+  /**
+   * @brief 等待页面加载完成，预读失败时重新同步加载
+   */
+  RC wait_page_loaded(PageNum page_num, Frame *frame);
+
+  /**
+   * @brief 检测顺序访问，需要的话预读后面的页面
+   * @details 多个线程同时访问时可能会误判，只会影响是否预读，不影响正确性
+   */
+  void read_ahead(PageNum page_num);
+
+  /**
+   * @brief 等待所有预读请求结束，关闭文件之前调用
+   */
+  void wait_prefetch_done();
+
   /**
    * 如果页面是脏的，就将数据刷新到磁盘
    */
   RC flush_page_internal(Frame &frame);
 
+  /**
+   * @brief 后台刷新一个脏页，调用者需要持有 lock_
+   * @details 页面已经被淘汰或者刷新过就什么都不做。拿不到页面的读锁说明有人正在修改，返回
+   * LOCKED_CONCURRENCY_CONFLICT，等下一轮再刷。
+   */
+  RC clean_page_internal(PageNum page_num);
+
 private:
   BufferPoolManager   &bp_manager_;     /// BufferPool 管理器
   BPFrameManager      &frame_manager_;  /// Frame 管理器
@@ -311,8 +433,18 @@ private:
   common::Mutex lock_;
   common::Mutex wr_lock_;
 
+  /// 还没有完成的预读请求个数。IO线程完成请求时不管是否使用CONCURRENCY编译都会并发访问，所以使用std::mutex
+  mutex              prefetch_lock_;
+  condition_variable prefetch_cv_;
+  int                prefetch_num_ = 0;
+
+  atomic<PageNum> last_access_page_{-1};  ///< 上一次访问的页面
+  atomic<int>     sequential_count_{0};   ///< 连续访问了多少个相邻的页面
+  atomic<PageNum> read_ahead_end_{0};     ///< 已经预读到了哪个页面(不包含)
+
 private:
   friend class BufferPoolIterator;
+  friend class BufferPoolManager;
 };
 
 /**
@@ -333,9 +465,23 @@ public:
 
   RC flush_page(Frame &frame);
 
+  /**
+   * @brief 刷新一个脏页到double write buffer，给 page cleaner 使用
+   * @details 会持有页面的读锁刷新，不会阻塞等待buffer pool的锁。buffer pool已经关闭时返回成功。
+   * @param frame_id 页帧编号
+   */
+  RC clean_page(const FrameId &frame_id);
+
   BPFrameManager    &get_frame_manager() { return frame_manager_; }
   DoubleWriteBuffer *get_dblwr_buffer() { return dblwr_buffer_.get(); }
 
+  /**
+   * @brief 批量、异步读写页面使用的IO后端
+   * @details init 之前是同步执行的后端，init 时根据配置创建
+   */
+  IoBackend           &io_backend() { return *io_backend_; }
+  const PageIoOptions &io_options() const { return io_options_; }
+
   /**
    * @brief 根据ID获取对应的BufferPool对象
    * @details 在做redo时，需要根据ID获取对应的BufferPool对象，然后让bufferPool对象自己做redo
@@ -344,9 +490,23 @@ public:
    */
   RC get_buffer_pool(int32_t id, DiskBufferPool *&bp);
 
+private:
+  /**
+   * @brief 根据ID找到buffer pool并加上它的锁
+   * @details 持有 lock_ 时不能阻塞等待buffer pool的锁：buffer pool持有自己的锁刷新页面时，可能因为
+   * double write buffer满了要通过 get_buffer_pool 把页面写回其它文件，会反过来请求 lock_。
+   * 所以这里只是尝试加锁，拿不到锁返回 LOCKED_CONCURRENCY_CONFLICT。拿到锁之后buffer pool就不会被关闭，
+   * 用完后需要调用者释放。
+   */
+  RC lock_buffer_pool(int32_t id, DiskBufferPool *&bp);
+
 private:
   BPFrameManager frame_manager_{"BufPool"};
 
+  /// double write buffer 析构时可能还要写回页面，IO后端要在它之后析构
+  PageIoOptions         io_options_;
+  unique_ptr<IoBackend> io_backend_;
+
   unique_ptr<DoubleWriteBuffer> dblwr_buffer_;
 
   common::Mutex                            lock_;
@@ -73,16 +73,58 @@ RC DiskDoubleWriteBuffer::open_file(const char *filename)
 }
 
 RC DiskDoubleWriteBuffer::flush_page()
+{
+  scoped_lock lock_guard(lock_);
+  return flush_page_internal();
+}
+
+RC DiskDoubleWriteBuffer::flush_page_internal()
 {
   sync();
 
+  vector<IoRequest> requests;
+  requests.reserve(dblwr_pages_.size());
   for (const auto &pair : dblwr_pages_) {
-    RC rc = write_page(pair.second);
-    if (rc != RC::SUCCESS) {
-      return rc;
+    DoubleWritePage *dblwr_page = pair.second;
+    // skip invalid page
+    if (!dblwr_page->valid) {
+      LOG_TRACE("double write buffer write page invalid. buffer_pool_id:%d,page_num:%d,lsn=%d",
+                dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
+      continue;
     }
-    pair.second->valid = false;
-    write_page_internal(pair.second);
+
+    DiskBufferPool *disk_buffer = nullptr;
+    RC rc = bp_manager_.get_buffer_pool(dblwr_page->key.buffer_pool_id, disk_buffer);
+    ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", dblwr_page->key.buffer_pool_id);
+
+    LOG_TRACE("double write buffer write page. buffer_pool_id:%d,page_num:%d,lsn=%d",
+              dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
+    requests.emplace_back(IoRequest::write(disk_buffer->file_desc(), &dblwr_page->page, sizeof(Page),
+        static_cast<int64_t>(dblwr_page->key.page_num) * sizeof(Page)));
+  }
+
+  RC rc = bp_manager_.io_backend().submit_and_wait(requests);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write pages in double write buffer to disk. page num=%d, rc=%s",
+             static_cast<int>(requests.size()), strrc(rc));
+    return rc;
+  }
+
+  requests.clear();
+  for (const auto &pair : dblwr_pages_) {
+    DoubleWritePage *dblwr_page = pair.second;
+    dblwr_page->valid           = false;
+    requests.emplace_back(IoRequest::write(file_desc_, dblwr_page, DoubleWritePage::SIZE,
+        static_cast<int64_t>(dblwr_page->page_index) * DoubleWritePage::SIZE + DoubleWriteBufferHeader::SIZE));
+  }
+
+  rc = bp_manager_.io_backend().submit_and_wait(requests);
+  if (OB_FAIL(rc)) {
+    // 数据页已经写到磁盘上了，标记失败只会让重启时多写一次
+    LOG_WARN("failed to invalidate pages in double write buffer. rc=%s", strrc(rc));
+  }
+
+  for (const auto &pair : dblwr_pages_) {
     delete pair.second;
   }
 
@@ -131,7 +173,7 @@ RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &p
   }
 
   if (static_cast<int>(dblwr_pages_.size()) >= max_pages_) {
-    RC rc = flush_page();
+    RC rc = flush_page_internal();
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to flush pages in double write buffer");
       return rc;
@@ -158,24 +200,6 @@ RC DiskDoubleWriteBuffer::write_page_internal(DoubleWritePage *page)
   return RC::SUCCESS;
 }
 
-RC DiskDoubleWriteBuffer::write_page(DoubleWritePage *dblwr_page)
-{
-  DiskBufferPool *disk_buffer = nullptr;
-  // skip invalid page
-  if (!dblwr_page->valid) {
-    LOG_TRACE("double write buffer write page invalid. buffer_pool_id:%d,page_num:%d,lsn=%d",
-              dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
-    return RC::SUCCESS;
-  }
-  RC rc = bp_manager_.get_buffer_pool(dblwr_page->key.buffer_pool_id, disk_buffer);
-  ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", dblwr_page->key.buffer_pool_id);
-
-  LOG_TRACE("double write buffer write page. buffer_pool_id:%d,page_num:%d,lsn=%d",
-            dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
-
-  return disk_buffer->write_page(dblwr_page->key.page_num, dblwr_page->page);
-}
-
 RC DiskDoubleWriteBuffer::read_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
   scoped_lock lock_guard(lock_);
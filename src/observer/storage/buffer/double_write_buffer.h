@@ -102,6 +102,7 @@ public:
   /**
    * 将buffer中的页全部写入磁盘，并且清空buffer
    * TODO 目前的解决方案是等buffer装满后再刷盘，可能会导致程序卡住一段时间
+   * @details 做检查点时 page cleaner 也会调用，会和 add_page 并发，所以需要加锁
    */
   RC flush_page();
 
@@ -124,9 +125,11 @@ public:
 
 private:
   /**
-   * 将buffer中的页面写入对应的磁盘
+   * flush_page 的实现，调用者需要持有 lock_
+   * @details 页面已经持久化到double write buffer文件中，写回各自数据文件的顺序无关紧要，
+   * 所有页面一次提交给IO后端并发写入，全部写完后再批量把double write buffer中的页面标记为无效。
    */
-  RC write_page(DoubleWritePage *page);
+  RC flush_page_internal();
 
   /**
    * 将页面写到当前double write buffer文件中
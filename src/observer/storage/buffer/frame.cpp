@@ -57,6 +57,8 @@ intptr_t get_default_debug_xid()
   }
 }
 
+#ifdef DEBUG
+
 void Frame::write_latch() { write_latch(get_default_debug_xid()); }
 
 void Frame::write_latch(intptr_t xid)
@@ -74,15 +76,13 @@ void Frame::write_latch(intptr_t xid)
         this, pin_count_.load(), frame_id_.to_string().c_str(), xid, lbt());
   }
 
-  lock_.lock();
+  latch_.lock();
 
-#ifdef DEBUG
   write_locker_ = xid;
   ++write_recursive_count_;
   TRACE("frame write lock success."
         "this=%p, pin=%d, frameId=%s, write locker=%lx(recursive=%d), xid=%lx, lbt=%s",
         this, pin_count_.load(), frame_id_.to_string().c_str(), write_locker_, write_recursive_count_, xid, lbt());
-#endif
 }
 
 void Frame::write_unlatch() { write_unlatch(get_default_debug_xid()); }
@@ -110,7 +110,7 @@ void Frame::write_unlatch(intptr_t xid)
   }
   debug_lock_.unlock();
 
-  lock_.unlock();
+  latch_.unlock();
 }
 
 void Frame::read_latch() { read_latch(get_default_debug_xid()); }
@@ -130,16 +130,14 @@ void Frame::read_latch(intptr_t xid)
         this, pin_count_.load(), frame_id_.to_string().c_str(), xid, lbt());
   }
 
-  lock_.lock_shared();
+  latch_.lock_shared();
 
   {
-#ifdef DEBUG
     scoped_lock debug_lock(debug_lock_);
     ++read_lockers_[xid];
     TRACE("frame read lock success."
           "this=%p, pin=%d, frameId=%s, xid=%lx, recursive=%d, lbt=%s",
           this, pin_count_.load(), frame_id_.to_string().c_str(), xid, read_lockers_[xid], lbt());
-#endif
   }
 }
 
@@ -159,16 +157,14 @@ bool Frame::try_read_latch()
         this, pin_count_.load(), frame_id_.to_string().c_str(), xid, lbt());
   }
 
-  bool ret = lock_.try_lock_shared();
+  bool ret = latch_.try_lock_shared();
   if (ret) {
-#ifdef DEBUG
     debug_lock_.lock();
     ++read_lockers_[xid];
     TRACE("frame read lock success."
           "this=%p, pin=%d, frameId=%s, xid=%lx, recursive=%d, lbt=%s",
           this, pin_count_.load(), frame_id_.to_string().c_str(), xid, read_lockers_[xid], lbt());
     debug_lock_.unlock();
-#endif
   }
 
   return ret;
@@ -185,7 +181,6 @@ void Frame::read_unlatch(intptr_t xid)
         "this=%p, pin=%d, frameId=%s, xid=%lx, lbt=%s",
         this, pin_count_.load(), frame_id_.to_string().c_str(), xid, lbt());
 
-#ifdef DEBUG
     auto read_lock_iter  = read_lockers_.find(xid);
     int  recursive_count = read_lock_iter != read_lockers_.end() ? read_lock_iter->second : 0;
     ASSERT(recursive_count > 0,
@@ -198,14 +193,13 @@ void Frame::read_unlatch(intptr_t xid)
     } else {
       read_lockers_[xid] = recursive_count - 1;
     }
-#endif
   }
 
   TRACE("frame read unlock success."
         "this=%p, pin=%d, frameId=%s, xid=%lx, lbt=%s",
         this, pin_count_.load(), frame_id_.to_string().c_str(), xid, lbt());
 
-  lock_.unlock_shared();
+  latch_.unlock_shared();
 }
 
 void Frame::pin()
@@ -249,6 +243,34 @@ int Frame::unpin()
   return pin_count;
 }
 
+#else  // DEBUG
+
+// 非调试模式下不记录加锁的人，xid 只是为了保持接口一致
+void Frame::write_latch() { latch_.lock(); }
+void Frame::write_latch(intptr_t /*xid*/) { latch_.lock(); }
+
+void Frame::write_unlatch() { latch_.unlock(); }
+void Frame::write_unlatch(intptr_t /*xid*/) { latch_.unlock(); }
+
+void Frame::read_latch() { latch_.lock_shared(); }
+void Frame::read_latch(intptr_t /*xid*/) { latch_.lock_shared(); }
+bool Frame::try_read_latch() { return latch_.try_lock_shared(); }
+
+void Frame::read_unlatch() { latch_.unlock_shared(); }
+void Frame::read_unlatch(intptr_t /*xid*/) { latch_.unlock_shared(); }
+
+void Frame::pin() { ++pin_count_; }
+
+int Frame::unpin()
+{
+  ASSERT(pin_count_.load() > 0,
+      "try to unpin a frame that pin count <= 0. this=%p, pin=%d, frameId=%s",
+      this, pin_count_.load(), frame_id_.to_string().c_str());
+  return --pin_count_;
+}
+
+#endif  // DEBUG
+
 unsigned long current_time()
 {
   struct timespec tp;
@@ -258,6 +280,24 @@ unsigned long current_time()
 
 void Frame::access() { acc_time_ = current_time(); }
 
+void Frame::finish_load(bool success)
+{
+  load_state_.store(success ? LOADED : LOAD_FAILED, std::memory_order_release);
+  load_state_.notify_all();
+}
+
+bool Frame::wait_loaded() const
+{
+  load_state_.wait(LOADING, std::memory_order_acquire);
+  return load_state_.load(std::memory_order_acquire) == LOADED;
+}
+
+bool Frame::reset_load()
+{
+  int expected = LOAD_FAILED;
+  return load_state_.compare_exchange_strong(expected, LOADING);
+}
+
 string Frame::to_string() const
 {
   stringstream ss;
@@ -23,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/unordered_map.h"
 #include "common/log/log.h"
 #include "common/types.h"
+#include "storage/buffer/frame_latch.h"
 #include "storage/buffer/page.h"
 
 /**
@@ -75,8 +76,12 @@ public:
    * @details 在 MemPoolSimple 分配和释放一个Frame对象时，不会调用构造函数和析构函数，
    * 而是调用reinit和reset。
    */
-  void reinit() {}
-  void reset() {}
+  void reinit()
+  {
+    rec_lsn_.store(0);
+    load_state_.store(LOADING);
+  }
+  void reset() { rec_lsn_.store(0); }
 
   void clear_page() { memset(&page_, 0, sizeof(page_)); }
 
@@ -104,7 +109,19 @@ public:
    * 序列号要小，那就可以从日志中读取这些更大序列号的日志，做重做操作，将页面恢复到最新状态，也就是redo。
    */
   LSN  lsn() const { return page_.lsn; }
-  void set_lsn(LSN lsn) { page_.lsn = lsn; }
+  void set_lsn(LSN lsn)
+  {
+    page_.lsn = lsn;
+    LSN expected = 0;
+    rec_lsn_.compare_exchange_strong(expected, lsn);
+  }
+
+  /**
+   * @brief 页面变脏之后第一次修改对应的日志序列号(recovery LSN)
+   * @details 页面刷盘之后清零。所有脏页中最小的rec lsn之前的日志，修改都已经落到磁盘上了，
+   * 做检查点时不需要再回放，page cleaner 按照它的顺序刷新脏页，并用它来推进检查点。
+   */
+  LSN rec_lsn() const { return rec_lsn_.load(); }
 
   /**
    * @brief 页面校验和
@@ -132,7 +149,11 @@ public:
    * @brief 重置“脏”标记
    * @details 如果页面已经被写入磁盘文件，则应调用此函数。
    */
-  void clear_dirty() { dirty_ = false; }
+  void clear_dirty()
+  {
+    dirty_ = false;
+    rec_lsn_.store(0);
+  }
   bool dirty() const { return dirty_; }
 
   char *data() { return page_.data; }
@@ -166,24 +187,62 @@ public:
   void read_unlatch();
   void read_unlatch(intptr_t xid);
 
+  /**
+   * @brief 乐观读，不加锁，只记录页面当前的版本号
+   * @details 读完页面之后调用 validate_latch 校验，失败说明读的过程中页面被修改过，读到的内容不能使用。
+   * 乐观读之前需要先pin住页面，防止页帧被淘汰后用来存放其它页面。
+   * @return 有人持有写锁时返回false
+   */
+  bool optimistic_latch(uint64_t &version) const { return latch_.optimistic_lock(version); }
+  bool validate_latch(uint64_t version) const { return latch_.validate(version); }
+
+  /**
+   * @brief 页面数据是否已经加载完成
+   * @details 页帧放到frame manager之后，其它线程就可以拿到它，但是数据可能还在加载，比如正在异步预读。
+   * 从内存池中新分配的页帧处于加载中的状态，分配页帧的线程负责调用 finish_load，拿到页帧的线程在使用
+   * 页面数据之前调用 wait_loaded 等待。
+   * @param success 加载失败的页帧内容不可用，等待的线程需要重新加载
+   */
+  void finish_load(bool success);
+
+  /**
+   * @brief 等待页面加载结束
+   * @return 加载失败时返回false
+   */
+  bool wait_loaded() const;
+
+  /**
+   * @brief 加载失败后重新加载之前调用
+   * @return 如果其他线程已经开始重新加载或者已经加载成功了，就返回false
+   */
+  bool reset_load();
+
   string to_string() const;
 
 private:
   friend class BufferPool;
 
+  static constexpr int LOADING     = 0;
+  static constexpr int LOADED      = 1;
+  static constexpr int LOAD_FAILED = 2;
+
   bool          dirty_ = false;
   atomic<int>   pin_count_{0};
+  atomic<LSN>   rec_lsn_{0};
+  atomic<int>   load_state_{LOADED};
   unsigned long acc_time_ = 0;
   FrameId       frame_id_;
   Page          page_;
 
   /// 在非并发编译时，加锁解锁动作将什么都不做
-  common::RecursiveSharedMutex lock_;
+  FrameLatch latch_;
 
+#ifdef DEBUG
   /// 使用一些手段来做测试，提前检测出头疼的死锁问题
-  /// 如果编译时没有增加调试选项，这些代码什么都不做
+  /// 记录加锁的人需要额外的内存和开销，只在调试模式下编译
   common::DebugMutex           debug_lock_;
   intptr_t                     write_locker_          = 0;
   int                          write_recursive_count_ = 0;
   unordered_map<intptr_t, int> read_lockers_;
+#endif
 };
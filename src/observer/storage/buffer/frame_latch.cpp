@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/frame_latch.h"
+
+#ifdef CONCURRENCY
+
+void FrameLatch::backoff(int &spin_count)
+{
+  // 页面上的锁持有时间都很短，先自旋一会儿，等不到再让出CPU
+  const int max_spin_count = 64;
+  if (++spin_count < max_spin_count) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  } else {
+    this_thread::yield();
+  }
+}
+
+void FrameLatch::lock()
+{
+  const thread::id self = this_thread::get_id();
+  if (write_owner_.load(std::memory_order_relaxed) == self) {
+    recursive_count_++;
+    return;
+  }
+
+  int spin_count = 0;
+  while (true) {
+    uint64_t word = word_.load(std::memory_order_relaxed);
+    if ((word & (WRITER_BIT | READER_MASK)) == 0 &&
+        word_.compare_exchange_weak(word, word | WRITER_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+      break;
+    }
+    backoff(spin_count);
+  }
+  // 后面对页面的修改不能重排到加锁之前，否则乐观读的线程可能读到修改了一半的数据却校验成功
+  std::atomic_thread_fence(std::memory_order_release);
+
+  write_owner_.store(self, std::memory_order_relaxed);
+  recursive_count_ = 1;
+}
+
+void FrameLatch::unlock()
+{
+  if (--recursive_count_ > 0) {
+    return;
+  }
+
+  write_owner_.store(thread::id(), std::memory_order_relaxed);
+  // 清除写锁标识的同时把版本号加1，乐观读的线程就能发现页面被修改过
+  word_.fetch_add(VERSION_ONE - WRITER_BIT, std::memory_order_release);
+}
+
+#endif  // CONCURRENCY
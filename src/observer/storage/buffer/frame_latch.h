@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/lang/atomic.h"
+#include "common/lang/thread.h"
+
+/**
+ * @brief 页帧上的轻量级读写锁
+ * @ingroup BufferPool
+ * @details 所有状态都放在一个64位的原子变量中：
+ * - 第0位：写锁标识；
+ * - 第1~31位：持有读锁的个数；
+ * - 第32~63位：版本号，每次释放写锁时加1。
+ *
+ * 除了普通的读写锁，还支持乐观读(optimistic lock coupling)：读之前记下版本号，读完之后校验版本号
+ * 没有变化并且没有人持有写锁，就说明读到的内容是一致的，否则需要重新读取。乐观读不修改锁的状态，
+ * 多个线程同时读一个热点页面(比如B+树的根节点)时不会在同一个缓存行上争抢。
+ *
+ * 写锁可以被同一个线程递归获取，读锁只是一个计数，也可以递归获取。同一个线程持有读锁时不能再加写锁。
+ * 加锁失败时先自旋，再让出CPU，没有排队，也不保证公平。
+ *
+ * 与其它类型的锁一样，在CONCURRENCY编译模式下才会真正的生效，否则加锁解锁什么都不做，乐观读总是成功。
+ */
+class FrameLatch final
+{
+public:
+  FrameLatch()  = default;
+  ~FrameLatch() = default;
+
+  void lock();
+  void unlock();
+
+  void lock_shared();
+  bool try_lock_shared();
+  void unlock_shared();
+
+  /**
+   * @brief 开始乐观读，记录当前的版本号
+   * @return 有人持有写锁时返回false，这时读到的内容一定不可靠
+   */
+  bool optimistic_lock(uint64_t &version) const;
+
+  /**
+   * @brief 乐观读结束后校验版本号
+   * @return 从 optimistic_lock 到现在没有人修改过页面时返回true
+   */
+  bool validate(uint64_t version) const;
+
+private:
+#ifdef CONCURRENCY
+  static constexpr uint64_t WRITER_BIT    = 1ULL;
+  static constexpr uint64_t READER_ONE    = 1ULL << 1;
+  static constexpr uint64_t READER_MASK   = 0xFFFFFFFEULL;
+  static constexpr int      VERSION_SHIFT = 32;
+  static constexpr uint64_t VERSION_ONE   = 1ULL << VERSION_SHIFT;
+
+  static void backoff(int &spin_count);
+
+  atomic<uint64_t>   word_{0};
+  atomic<thread::id> write_owner_;          ///< 持有写锁的线程，用来支持写锁递归
+  int                recursive_count_ = 0;  ///< 写锁递归的次数，只有持有写锁的线程才会访问
+#endif  // CONCURRENCY
+};
+
+#ifdef CONCURRENCY
+
+inline bool FrameLatch::try_lock_shared()
+{
+  uint64_t word = word_.load(std::memory_order_relaxed);
+  while ((word & WRITER_BIT) == 0) {
+    if (word_.compare_exchange_weak(word, word + READER_ONE, std::memory_order_acquire, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void FrameLatch::lock_shared()
+{
+  int spin_count = 0;
+  while (!try_lock_shared()) {
+    backoff(spin_count);
+  }
+}
+
+inline void FrameLatch::unlock_shared() { word_.fetch_sub(READER_ONE, std::memory_order_release); }
+
+inline bool FrameLatch::optimistic_lock(uint64_t &version) const
+{
+  const uint64_t word = word_.load(std::memory_order_acquire);
+  version             = word >> VERSION_SHIFT;
+  return (word & WRITER_BIT) == 0;
+}
+
+inline bool FrameLatch::validate(uint64_t version) const
+{
+  // 保证前面读取页面内容的动作不会被重排到读取版本号之后
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t word = word_.load(std::memory_order_relaxed);
+  return (word & WRITER_BIT) == 0 && (word >> VERSION_SHIFT) == version;
+}
+
+#else  // CONCURRENCY
+
+inline void FrameLatch::lock() {}
+inline void FrameLatch::unlock() {}
+inline void FrameLatch::lock_shared() {}
+inline bool FrameLatch::try_lock_shared() { return true; }
+inline void FrameLatch::unlock_shared() {}
+
+inline bool FrameLatch::optimistic_lock(uint64_t &version) const
+{
+  version = 0;
+  return true;
+}
+
+inline bool FrameLatch::validate(uint64_t /*version*/) const { return true; }
+
+#endif  // CONCURRENCY
@@ -0,0 +1,224 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <strings.h>
+
+#include "storage/buffer/frame_replacer.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+
+const char *frame_replacer_type_name(FrameReplacerType type)
+{
+  switch (type) {
+    case FrameReplacerType::LRU: return "LRU";
+    case FrameReplacerType::CLOCK: return "CLOCK";
+    case FrameReplacerType::LRU_K: return "LRU-K";
+    default: return "UNDEFINED";
+  }
+}
+
+RC frame_replacer_type_from_string(const string &name, FrameReplacerType &type)
+{
+  if (0 == strcasecmp(name.c_str(), "LRU")) {
+    type = FrameReplacerType::LRU;
+  } else if (0 == strcasecmp(name.c_str(), "CLOCK")) {
+    type = FrameReplacerType::CLOCK;
+  } else if (0 == strcasecmp(name.c_str(), "LRU-K") || 0 == strcasecmp(name.c_str(), "LRU_K")) {
+    type = FrameReplacerType::LRU_K;
+  } else {
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
+
+unique_ptr<FrameReplacer> FrameReplacer::create(FrameReplacerType type, int lru_k)
+{
+  switch (type) {
+    case FrameReplacerType::LRU: return make_unique<LruFrameReplacer>();
+    case FrameReplacerType::CLOCK: return make_unique<ClockFrameReplacer>();
+    case FrameReplacerType::LRU_K: return make_unique<LruKFrameReplacer>(lru_k);
+    default: {
+      LOG_WARN("unknown frame replacer type %d", static_cast<int>(type));
+      return nullptr;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LruFrameReplacer::insert(Frame *frame)
+{
+  lru_list_.push_front(frame);
+  nodes_[frame] = lru_list_.begin();
+}
+
+void LruFrameReplacer::access(Frame *frame)
+{
+  auto iter = nodes_.find(frame);
+  if (iter == nodes_.end()) {
+    return;
+  }
+  lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+}
+
+void LruFrameReplacer::remove(Frame *frame)
+{
+  auto iter = nodes_.find(frame);
+  if (iter == nodes_.end()) {
+    return;
+  }
+  lru_list_.erase(iter->second);
+  nodes_.erase(iter);
+}
+
+void LruFrameReplacer::foreach_victim(const function<bool(Frame *)> &func)
+{
+  for (auto iter = lru_list_.rbegin(); iter != lru_list_.rend(); ++iter) {
+    if (!func(*iter)) {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ClockFrameReplacer::insert(Frame *frame)
+{
+  // 新页帧放在指针的后面，也就是转一圈之后才会检查它
+  auto iter     = ring_.insert(hand_, Node{frame, true, 0});
+  nodes_[frame] = iter;
+}
+
+void ClockFrameReplacer::access(Frame *frame)
+{
+  auto iter = nodes_.find(frame);
+  if (iter != nodes_.end()) {
+    iter->second->referenced = true;
+  }
+}
+
+void ClockFrameReplacer::remove(Frame *frame)
+{
+  auto iter = nodes_.find(frame);
+  if (iter == nodes_.end()) {
+    return;
+  }
+
+  if (hand_ == iter->second) {
+    hand_ = ring_.erase(iter->second);
+  } else {
+    ring_.erase(iter->second);
+  }
+  nodes_.erase(iter);
+}
+
+void ClockFrameReplacer::foreach_victim(const function<bool(Frame *)> &func)
+{
+  // 最多转两圈：第一圈清理访问位，第二圈一定能看到所有页帧
+  const size_t max_steps = ring_.size() * 2;
+  scan_id_++;
+  for (size_t step = 0; step < max_steps; step++) {
+    if (hand_ == ring_.end()) {
+      hand_ = ring_.begin();
+    }
+
+    Node &node = *hand_;
+    ++hand_;
+    if (node.referenced) {
+      node.referenced = false;
+      continue;
+    }
+
+    if (node.scan_id == scan_id_) {
+      continue;
+    }
+    node.scan_id = scan_id_;
+
+    if (!func(node.frame)) {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LruKFrameReplacer::LruKFrameReplacer(int k) : k_(max(k, 1)) {}
+
+void LruKFrameReplacer::record(Node &node)
+{
+  node.history.push_back(++current_);
+  if (static_cast<int>(node.history.size()) > k_) {
+    node.history.pop_front();
+  }
+}
+
+void LruKFrameReplacer::insert(Frame *frame)
+{
+  Node &node = nodes_[frame];
+  record(node);
+  if (k_ <= 1) {
+    node.in_cache = true;
+    cache_.emplace(node.history.front(), frame);
+  } else {
+    node.history_pos = history_queue_.insert(history_queue_.end(), frame);
+  }
+}
+
+void LruKFrameReplacer::access(Frame *frame)
+{
+  auto iter = nodes_.find(frame);
+  if (iter == nodes_.end()) {
+    return;
+  }
+
+  Node &node = iter->second;
+  if (node.in_cache) {
+    cache_.erase(CacheKey(node.history.front(), frame));
+    record(node);
+    cache_.emplace(node.history.front(), frame);
+    return;
+  }
+
+  record(node);
+  if (static_cast<int>(node.history.size()) >= k_) {
+    history_queue_.erase(node.history_pos);
+    node.in_cache = true;
+    cache_.emplace(node.history.front(), frame);
+  }
+}
+
+void LruKFrameReplacer::remove(Frame *frame)
+{
+  auto iter = nodes_.find(frame);
+  if (iter == nodes_.end()) {
+    return;
+  }
+
+  Node &node = iter->second;
+  if (node.in_cache) {
+    cache_.erase(CacheKey(node.history.front(), frame));
+  } else {
+    history_queue_.erase(node.history_pos);
+  }
+  nodes_.erase(iter);
+}
+
+void LruKFrameReplacer::foreach_victim(const function<bool(Frame *)> &func)
+{
+  // 访问不足K次的页帧，倒数第K次访问的距离认为是无穷大，优先淘汰
+  for (Frame *frame : history_queue_) {
+    if (!func(frame)) {
+      return;
+    }
+  }
+
+  for (const CacheKey &key : cache_) {
+    if (!func(key.second)) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,159 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/lang/functional.h"
+#include "common/lang/list.h"
+#include "common/lang/memory.h"
+#include "common/lang/set.h"
+#include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/utility.h"
+#include "common/sys/rc.h"
+
+class Frame;
+
+/**
+ * @brief 页帧淘汰策略
+ * @ingroup BufferPool
+ */
+enum class FrameReplacerType
+{
+  UNDEFINED,
+  LRU,    ///< 经典LRU，每次访问都移动到链表头部
+  CLOCK,  ///< 时钟算法，只维护一个访问位，命中时不需要移动链表节点
+  LRU_K,  ///< LRU-K，按照倒数第K次访问时间淘汰，一次性的扫描不会把热点页面挤出去
+};
+
+const char *frame_replacer_type_name(FrameReplacerType type);
+RC          frame_replacer_type_from_string(const string &name, FrameReplacerType &type);
+
+/**
+ * @brief 页帧淘汰策略的接口
+ * @ingroup BufferPool
+ * @details 每个BPFrameManager的分片都持有一个FrameReplacer，所有接口都在分片的锁内调用，
+ * 所以实现时不需要考虑并发。FrameReplacer只负责维护淘汰顺序，页面能否淘汰(pin count)
+ * 由调用者判断。
+ */
+class FrameReplacer
+{
+public:
+  virtual ~FrameReplacer() = default;
+
+  virtual FrameReplacerType type() const = 0;
+
+  /// 新的页帧加入缓存
+  virtual void insert(Frame *frame) = 0;
+  /// 缓存中的页帧被访问了一次
+  virtual void access(Frame *frame) = 0;
+  /// 页帧从缓存中移除
+  virtual void remove(Frame *frame) = 0;
+
+  /**
+   * @brief 按照淘汰优先级从高到低遍历页帧
+   * @param func 返回false时停止遍历
+   * @details 遍历过程可能会修改淘汰策略的内部状态，比如CLOCK会清理扫描过的访问位
+   */
+  virtual void foreach_victim(const function<bool(Frame *)> &func) = 0;
+
+  static unique_ptr<FrameReplacer> create(FrameReplacerType type, int lru_k);
+};
+
+/**
+ * @brief LRU 淘汰策略
+ * @ingroup BufferPool
+ */
+class LruFrameReplacer : public FrameReplacer
+{
+public:
+  FrameReplacerType type() const override { return FrameReplacerType::LRU; }
+
+  void insert(Frame *frame) override;
+  void access(Frame *frame) override;
+  void remove(Frame *frame) override;
+  void foreach_victim(const function<bool(Frame *)> &func) override;
+
+private:
+  list<Frame *>                                   lru_list_;  ///< 头部是最近访问的页帧
+  unordered_map<Frame *, list<Frame *>::iterator> nodes_;
+};
+
+/**
+ * @brief CLOCK 淘汰策略
+ * @ingroup BufferPool
+ * @details 页帧组成一个环，命中时只设置访问位。淘汰时指针沿着环移动，访问位为1的页帧
+ * 清零后跳过，访问位为0的页帧作为淘汰候选。
+ */
+class ClockFrameReplacer : public FrameReplacer
+{
+public:
+  FrameReplacerType type() const override { return FrameReplacerType::CLOCK; }
+
+  void insert(Frame *frame) override;
+  void access(Frame *frame) override;
+  void remove(Frame *frame) override;
+  void foreach_victim(const function<bool(Frame *)> &func) override;
+
+private:
+  struct Node
+  {
+    Frame   *frame      = nullptr;
+    bool     referenced = false;
+    uint64_t scan_id    = 0;  ///< 最后一次作为候选被遍历时的scan id，避免一次遍历中重复返回
+  };
+
+  uint64_t                                     scan_id_ = 0;
+  list<Node>                                   ring_;
+  list<Node>::iterator                         hand_ = ring_.end();  ///< 下一次开始扫描的位置
+  unordered_map<Frame *, list<Node>::iterator> nodes_;
+};
+
+/**
+ * @brief LRU-K 淘汰策略
+ * @ingroup BufferPool
+ * @details 访问次数不足K次的页帧放在历史队列中，按照第一次访问的时间先进先出，优先淘汰；
+ * 访问次数达到K次的页帧按照倒数第K次访问的时间排序，时间越早越先淘汰。
+ * 这样一次全表扫描读入的页面只会在历史队列中停留，不会把反复访问的热点页面淘汰出去。
+ */
+class LruKFrameReplacer : public FrameReplacer
+{
+public:
+  explicit LruKFrameReplacer(int k);
+
+  FrameReplacerType type() const override { return FrameReplacerType::LRU_K; }
+
+  void insert(Frame *frame) override;
+  void access(Frame *frame) override;
+  void remove(Frame *frame) override;
+  void foreach_victim(const function<bool(Frame *)> &func) override;
+
+private:
+  using Timestamp = uint64_t;
+  using CacheKey  = pair<Timestamp, Frame *>;
+
+  struct Node
+  {
+    list<Timestamp>         history;           ///< 最近K次访问的时间，头部是最早的一次
+    bool                    in_cache = false;  ///< 是否已经访问了K次
+    list<Frame *>::iterator history_pos;       ///< in_cache == false 时有效
+  };
+
+  void record(Node &node);
+
+private:
+  int                          k_       = 2;
+  Timestamp                    current_ = 0;
+  list<Frame *>                history_queue_;  ///< 访问次数不足K次的页帧，头部最先进入
+  set<CacheKey>                cache_;          ///< 访问次数达到K次的页帧
+  unordered_map<Frame *, Node> nodes_;
+};
@@ -0,0 +1,514 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#include "storage/buffer/io_backend.h"
+#include "common/conf/ini.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+
+using namespace common;
+
+PageIoOptions PageIoOptions::from_properties()
+{
+  PageIoOptions options;
+
+  Ini *properties = get_properties();
+  if (properties == nullptr) {
+    return options;
+  }
+
+  auto load = [properties](const char *key, auto &value) {
+    string str = properties->get(key, "", "BUFFER_POOL");
+    if (!str.empty()) {
+      str_to_val(str, value);
+    }
+  };
+
+  string backend = properties->get("IO_BACKEND", "", "BUFFER_POOL");
+  if (!backend.empty()) {
+    options.backend = backend;
+  }
+  load("IO_THREADS", options.thread_num);
+  load("IO_QUEUE_DEPTH", options.queue_depth);
+  load("SCAN_PREFETCH_PAGES", options.scan_prefetch_pages);
+  load("READ_AHEAD_PAGES", options.read_ahead_pages);
+  load("READ_AHEAD_THRESHOLD", options.read_ahead_threshold);
+  return options;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+IoRequest IoRequest::read(int fd, void *buffer, int64_t size, int64_t offset, function<void(RC)> callback)
+{
+  IoRequest request;
+  request.type     = Type::READ;
+  request.fd       = fd;
+  request.buffer   = static_cast<char *>(buffer);
+  request.size     = size;
+  request.offset   = offset;
+  request.callback = std::move(callback);
+  return request;
+}
+
+IoRequest IoRequest::write(int fd, const void *buffer, int64_t size, int64_t offset, function<void(RC)> callback)
+{
+  IoRequest request;
+  request.type     = Type::WRITE;
+  request.fd       = fd;
+  request.buffer   = const_cast<char *>(static_cast<const char *>(buffer));
+  request.size     = size;
+  request.offset   = offset;
+  request.callback = std::move(callback);
+  return request;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_ptr<IoBackend> IoBackend::create(const PageIoOptions &options)
+{
+  unique_ptr<IoBackend> backend;
+  if (0 == strcasecmp(options.backend.c_str(), "io_uring")) {
+#ifdef __linux__
+    backend = make_unique<IoUringBackend>();
+#endif
+  } else if (0 == strcasecmp(options.backend.c_str(), "sync")) {
+    backend = make_unique<SyncIoBackend>();
+  } else if (0 != strcasecmp(options.backend.c_str(), "thread_pool")) {
+    LOG_WARN("unknown io backend %s, use thread_pool instead", options.backend.c_str());
+  }
+
+  if (backend && OB_FAIL(backend->init(options))) {
+    LOG_WARN("failed to init io backend %s, use thread_pool instead", backend->name());
+    backend.reset();
+  }
+
+  if (!backend) {
+    backend = make_unique<ThreadPoolIoBackend>();
+    if (OB_FAIL(backend->init(options))) {
+      LOG_WARN("failed to init io backend %s, use sync instead", backend->name());
+      backend = make_unique<SyncIoBackend>();
+    }
+  }
+
+  LOG_INFO("io backend created. backend=%s", backend->name());
+  return backend;
+}
+
+RC IoBackend::submit_and_wait(vector<IoRequest> &requests)
+{
+  if (requests.empty()) {
+    return RC::SUCCESS;
+  }
+
+  mutex              lock;
+  condition_variable cv;
+  size_t             remain_num = requests.size();
+  RC                 result     = RC::SUCCESS;
+
+  for (IoRequest &request : requests) {
+    request.callback = [&, callback = std::move(request.callback)](RC rc) {
+      if (callback) {
+        callback(rc);
+      }
+
+      // 在锁内通知，否则等待的线程可能已经返回，条件变量都被销毁了
+      lock_guard<mutex> guard(lock);
+      if (OB_FAIL(rc)) {
+        result = rc;
+      }
+      if (--remain_num == 0) {
+        cv.notify_all();
+      }
+    };
+  }
+
+  RC rc = submit(requests);
+
+  unique_lock<mutex> guard(lock);
+  cv.wait(guard, [&remain_num]() { return remain_num == 0; });
+  return OB_FAIL(result) ? result : rc;
+}
+
+RC IoBackend::execute(const IoRequest &request)
+{
+  char   *buffer = request.buffer;
+  int64_t size   = request.size;
+  int64_t offset = request.offset;
+  while (size > 0) {
+    ssize_t ret = 0;
+    if (request.type == IoRequest::Type::READ) {
+      ret = ::pread(request.fd, buffer, size, offset);
+    } else {
+      ret = ::pwrite(request.fd, buffer, size, offset);
+    }
+
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (ret <= 0) {
+      // 读到文件末尾也认为是失败，buffer pool 只会读取已经存在的页面
+      LOG_WARN("failed to %s. fd=%d, offset=%ld, size=%ld, ret=%ld, error=%s",
+               request.type == IoRequest::Type::READ ? "read" : "write",
+               request.fd, offset, size, ret, strerror(errno));
+      return request.type == IoRequest::Type::READ ? RC::IOERR_READ : RC::IOERR_WRITE;
+    }
+
+    buffer += ret;
+    size -= ret;
+    offset += ret;
+  }
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+RC SyncIoBackend::submit(vector<IoRequest> &requests)
+{
+  for (IoRequest &request : requests) {
+    RC rc = execute(request);
+    if (request.callback) {
+      request.callback(rc);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPoolIoBackend::~ThreadPoolIoBackend() { cleanup(); }
+
+RC ThreadPoolIoBackend::init(const PageIoOptions &options)
+{
+  const int thread_num = max(options.thread_num, 1);
+  for (int i = 0; i < thread_num; i++) {
+    threads_.emplace_back(&ThreadPoolIoBackend::thread_func, this);
+  }
+  LOG_INFO("thread pool io backend started. threads=%d", thread_num);
+  return RC::SUCCESS;
+}
+
+void ThreadPoolIoBackend::cleanup()
+{
+  {
+    lock_guard<mutex> guard(lock_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+
+  for (thread &t : threads_) {
+    t.join();
+  }
+  threads_.clear();
+}
+
+RC ThreadPoolIoBackend::submit(vector<IoRequest> &requests)
+{
+  {
+    lock_guard<mutex> guard(lock_);
+    for (IoRequest &request : requests) {
+      requests_.emplace_back(std::move(request));
+    }
+  }
+  cv_.notify_all();
+  return RC::SUCCESS;
+}
+
+void ThreadPoolIoBackend::thread_func()
+{
+  thread_set_name("PageIO");
+
+  while (true) {
+    IoRequest request;
+    {
+      unique_lock<mutex> guard(lock_);
+      cv_.wait(guard, [this]() { return stopping_ || !requests_.empty(); });
+      // 退出前把已经提交的请求都处理掉，每个请求都要调用回调
+      if (requests_.empty()) {
+        break;
+      }
+      request = std::move(requests_.front());
+      requests_.pop_front();
+    }
+
+    RC rc = execute(request);
+    if (request.callback) {
+      request.callback(rc);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#ifdef __linux__
+
+/**
+ * @brief 提交给 io_uring 的请求
+ * @details 地址作为 user_data 交给内核，完成时再拿回来。user_data 是0的是退出时用来唤醒后台线程的空请求
+ */
+struct IoUringBackend::Context
+{
+  IoRequest request;
+  iovec     iov;
+};
+
+IoUringBackend::~IoUringBackend() { cleanup(); }
+
+RC IoUringBackend::init(const PageIoOptions &options)
+{
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  const unsigned queue_depth = static_cast<unsigned>(max(options.queue_depth, 1));
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, queue_depth, &params));
+  if (ring_fd_ < 0) {
+    LOG_WARN("failed to setup io_uring. queue depth=%u, error=%s", queue_depth, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  sq_entries_   = params.sq_entries;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  sqes_size_    = params.sq_entries * sizeof(io_uring_sqe);
+
+  // 老版本内核的提交队列和完成队列需要分别映射，新版本内核分别映射也没有问题
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+      IORING_OFF_SQ_RING);
+  cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+      IORING_OFF_CQ_RING);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+    LOG_WARN("failed to mmap io_uring rings. error=%s", strerror(errno));
+    unmap_rings();
+    close(ring_fd_);
+    ring_fd_ = -1;
+    return RC::IOERR_OPEN;
+  }
+
+  char *sq_ring = static_cast<char *>(sq_ring_);
+  sq_head_      = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.head);
+  sq_tail_      = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.tail);
+  sq_mask_      = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.ring_mask);
+  sq_array_     = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.array);
+
+  char *cq_ring = static_cast<char *>(cq_ring_);
+  cq_head_      = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.head);
+  cq_tail_      = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.tail);
+  cq_mask_      = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.ring_mask);
+  cqes_         = cq_ring + params.cq_off.cqes;
+
+  stopping_ = false;
+  reaper_   = thread(&IoUringBackend::reap_completions, this);
+
+  LOG_INFO("io_uring backend started. sq entries=%u, cq entries=%u", params.sq_entries, params.cq_entries);
+  return RC::SUCCESS;
+}
+
+void IoUringBackend::cleanup()
+{
+  if (ring_fd_ < 0) {
+    return;
+  }
+
+  {
+    // 提交一个空请求唤醒后台线程，它处理完所有在途的请求后退出
+    unique_lock<mutex> guard(submit_lock_);
+    submit_cv_.wait(guard, [this]() { return inflight_num_ < sq_entries_; });
+    stopping_ = true;
+
+    const unsigned tail = *sq_tail_;
+    const unsigned index = tail & *sq_mask_;
+    io_uring_sqe  *sqe   = static_cast<io_uring_sqe *>(sqes_) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode      = IORING_OP_NOP;
+    sqe->user_data   = 0;
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    inflight_num_++;
+
+    RC rc = enter(1, 0, 0);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to wake up io_uring reaper. rc=%s", strrc(rc));
+    }
+  }
+  submit_cv_.notify_all();
+
+  if (reaper_.joinable()) {
+    reaper_.join();
+  }
+
+  unmap_rings();
+  close(ring_fd_);
+  ring_fd_ = -1;
+}
+
+void IoUringBackend::unmap_rings()
+{
+  if (sq_ring_ != nullptr && sq_ring_ != MAP_FAILED) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != MAP_FAILED) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sqes_ != nullptr && sqes_ != MAP_FAILED) {
+    munmap(sqes_, sqes_size_);
+  }
+  sq_ring_ = nullptr;
+  cq_ring_ = nullptr;
+  sqes_    = nullptr;
+}
+
+RC IoUringBackend::enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+  while (true) {
+    int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0));
+    if (ret < 0) {
+      if (errno == EINTR && to_submit == 0) {
+        return RC::SUCCESS;
+      }
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+        this_thread::yield();
+        continue;
+      }
+      LOG_ERROR("failed to enter io_uring. to submit=%u, error=%s", to_submit, strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+
+    if (static_cast<unsigned>(ret) >= to_submit) {
+      return RC::SUCCESS;
+    }
+    to_submit -= ret;
+  }
+}
+
+RC IoUringBackend::submit(vector<IoRequest> &requests)
+{
+  RC rc = RC::SUCCESS;
+
+  unique_lock<mutex> guard(submit_lock_);
+
+  unsigned pending_num = 0;
+  for (IoRequest &request : requests) {
+    if (inflight_num_ >= sq_entries_ && pending_num > 0) {
+      // 提交队列满了，先把已经填好的请求提交了，再等待一些请求完成
+      rc          = enter(pending_num, 0, 0);
+      pending_num = 0;
+    }
+    submit_cv_.wait(guard, [this]() { return inflight_num_ < sq_entries_ || stopping_; });
+
+    if (stopping_) {
+      if (request.callback) {
+        request.callback(RC::IOERR_ACCESS);
+      }
+      continue;
+    }
+
+    auto *context         = new Context;
+    context->request      = std::move(request);
+    context->iov.iov_base = context->request.buffer;
+    context->iov.iov_len  = context->request.size;
+
+    const unsigned tail  = *sq_tail_;
+    const unsigned index = tail & *sq_mask_;
+    io_uring_sqe  *sqe   = static_cast<io_uring_sqe *>(sqes_) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = context->request.type == IoRequest::Type::READ ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd        = context->request.fd;
+    sqe->addr      = reinterpret_cast<uint64_t>(&context->iov);
+    sqe->len       = 1;
+    sqe->off       = context->request.offset;
+    sqe->user_data = reinterpret_cast<uint64_t>(context);
+
+    sq_array_[index] = index;
+    // 内核在 io_uring_enter 时读取提交队列，尾指针要在请求填好之后再更新
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    inflight_num_++;
+    pending_num++;
+  }
+
+  if (pending_num > 0) {
+    RC ret = enter(pending_num, 0, 0);
+    if (OB_FAIL(ret)) {
+      rc = ret;
+    }
+  }
+
+  if (OB_FAIL(rc)) {
+    // 已经放到提交队列中的请求不会丢，下次 io_uring_enter 时会被内核取走
+    LOG_WARN("failed to submit io requests to io_uring. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+void IoUringBackend::reap_completions()
+{
+  thread_set_name("IoUringReaper");
+
+  while (true) {
+    unsigned       head = *cq_head_;
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      {
+        lock_guard<mutex> guard(submit_lock_);
+        if (stopping_ && inflight_num_ == 0) {
+          break;
+        }
+      }
+      (void)enter(0, 1, IORING_ENTER_GETEVENTS);
+      continue;
+    }
+
+    unsigned reaped_num = 0;
+    for (; head != tail; head++, reaped_num++) {
+      const io_uring_cqe *cqe     = static_cast<const io_uring_cqe *>(cqes_) + (head & *cq_mask_);
+      auto               *context = reinterpret_cast<Context *>(cqe->user_data);
+      const int           res     = cqe->res;
+      if (context == nullptr) {
+        continue;
+      }
+
+      IoRequest &request = context->request;
+      RC         rc      = RC::SUCCESS;
+      if (res < 0) {
+        LOG_WARN("io_uring request failed. fd=%d, offset=%ld, size=%ld, error=%s",
+                 request.fd, request.offset, request.size, strerror(-res));
+        rc = request.type == IoRequest::Type::READ ? RC::IOERR_READ : RC::IOERR_WRITE;
+      } else if (res < request.size) {
+        // 读写的数据不够，剩下的部分同步完成
+        IoRequest rest = IoRequest::read(request.fd, request.buffer + res, request.size - res, request.offset + res);
+        rest.type      = request.type;
+        rc             = execute(rest);
+      }
+
+      if (request.callback) {
+        request.callback(rc);
+      }
+      delete context;
+    }
+
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+    {
+      lock_guard<mutex> guard(submit_lock_);
+      inflight_num_ -= reaped_num;
+    }
+    submit_cv_.notify_all();
+  }
+}
+
+#endif  // __linux__
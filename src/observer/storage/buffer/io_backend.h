@@ -0,0 +1,213 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/lang/deque.h"
+#include "common/lang/functional.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/string.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+
+/**
+ * @brief 页面IO的参数
+ * @ingroup BufferPool
+ * @details 没有设置时从配置文件 [BUFFER_POOL] 中读取，见 etc/observer.ini
+ */
+struct PageIoOptions
+{
+  string backend              = "io_uring";  ///< io_uring、thread_pool 或 sync。io_uring 不可用时退化成 thread_pool
+  int    thread_num           = 4;           ///< thread_pool 后端的IO线程个数
+  int    queue_depth          = 64;          ///< io_uring 后端最多同时提交多少个请求
+  int    scan_prefetch_pages  = 8;           ///< 顺序扫描时预读多少个页面，0 表示不预读
+  int    read_ahead_pages     = 16;          ///< 发现顺序访问时一次预读多少个页面，0 表示不预读
+  int    read_ahead_threshold = 4;           ///< 连续访问多少个相邻的页面才认为是顺序访问
+
+  static PageIoOptions from_properties();
+};
+
+/**
+ * @brief 一个页面读写请求
+ * @ingroup BufferPool
+ * @details 使用 pread/pwrite 的语义，不会修改文件的偏移量，同一个文件上的多个请求可以并发执行。
+ */
+struct IoRequest
+{
+  enum class Type
+  {
+    READ,
+    WRITE,
+  };
+
+  Type    type   = Type::READ;
+  int     fd     = -1;
+  char   *buffer = nullptr;
+  int64_t size   = 0;
+  int64_t offset = 0;
+
+  /// 请求完成后在IO线程中调用，读写的字节数不足 size 时也认为失败
+  function<void(RC)> callback;
+
+  static IoRequest read(int fd, void *buffer, int64_t size, int64_t offset, function<void(RC)> callback = nullptr);
+  static IoRequest write(int fd, const void *buffer, int64_t size, int64_t offset, function<void(RC)> callback = nullptr);
+};
+
+/**
+ * @brief 页面IO后端
+ * @ingroup BufferPool
+ * @details buffer pool 通过它批量、异步地读写页面，比如顺序扫描时预读后面的页面，
+ * 或者 double write buffer 一次写回一批脏页。一批请求之间没有先后顺序。
+ * 有下面几种实现：
+ * - io_uring：一次系统调用提交一批请求，由一个后台线程收割完成事件；
+ * - thread_pool：每个请求交给线程池中的线程执行 pread/pwrite，在不支持 io_uring 的环境中使用；
+ * - sync：在提交请求的线程中直接执行，相当于没有异步IO。
+ */
+class IoBackend
+{
+public:
+  IoBackend()          = default;
+  virtual ~IoBackend() = default;
+
+  /**
+   * @brief 按照参数创建IO后端
+   * @details 指定的后端初始化失败时会退化成 thread_pool，再失败就使用 sync，总是能返回一个可用的后端
+   */
+  static unique_ptr<IoBackend> create(const PageIoOptions &options);
+
+  virtual RC          init(const PageIoOptions &options) = 0;
+  virtual void        cleanup()                          = 0;
+  virtual const char *name() const                       = 0;
+
+  /**
+   * @brief 提交一批请求，不等待完成
+   * @details 每个请求完成后调用它自己的 callback。返回失败时没有提交成功的请求也会以失败调用 callback，
+   * 调用者不需要区分哪些请求已经提交了。
+   */
+  virtual RC submit(vector<IoRequest> &requests) = 0;
+
+  /**
+   * @brief 提交一批请求并等待全部完成
+   * @return 所有请求都成功时返回成功，否则返回其中一个失败的错误码
+   */
+  RC submit_and_wait(vector<IoRequest> &requests);
+
+protected:
+  /**
+   * @brief 在当前线程中同步执行一个请求
+   */
+  static RC execute(const IoRequest &request);
+};
+
+/**
+ * @brief 在提交请求的线程中直接执行的IO后端
+ * @ingroup BufferPool
+ */
+class SyncIoBackend final : public IoBackend
+{
+public:
+  SyncIoBackend()          = default;
+  virtual ~SyncIoBackend() = default;
+
+  RC          init(const PageIoOptions &options) override { return RC::SUCCESS; }
+  void        cleanup() override {}
+  const char *name() const override { return "sync"; }
+  RC          submit(vector<IoRequest> &requests) override;
+};
+
+/**
+ * @brief 使用线程池模拟异步IO
+ * @ingroup BufferPool
+ * @details 没有使用 common::ThreadPoolExecutor，它的线程空闲时每次睡眠10ms才检查一次任务队列，
+ * 对于一个页面只需要零点几毫秒的IO来说延迟太大了。这里的线程使用条件变量等待请求。
+ */
+class ThreadPoolIoBackend final : public IoBackend
+{
+public:
+  ThreadPoolIoBackend() = default;
+  virtual ~ThreadPoolIoBackend();
+
+  RC          init(const PageIoOptions &options) override;
+  void        cleanup() override;
+  const char *name() const override { return "thread_pool"; }
+  RC          submit(vector<IoRequest> &requests) override;
+
+private:
+  void thread_func();
+
+private:
+  mutex              lock_;
+  condition_variable cv_;
+  deque<IoRequest>   requests_;
+  vector<thread>     threads_;
+  bool               stopping_ = false;
+};
+
+#ifdef __linux__
+
+/**
+ * @brief 基于 io_uring 的IO后端
+ * @ingroup BufferPool
+ * @details 直接使用系统调用，不依赖liburing。提交时把请求填到共享的提交队列中，一次 io_uring_enter
+ * 提交一批；后台线程等待完成队列中的事件，调用请求的回调。同时在途的请求不超过提交队列的大小，
+ * 完成队列是提交队列的两倍，不会溢出。
+ */
+class IoUringBackend final : public IoBackend
+{
+public:
+  IoUringBackend() = default;
+  virtual ~IoUringBackend();
+
+  RC          init(const PageIoOptions &options) override;
+  void        cleanup() override;
+  const char *name() const override { return "io_uring"; }
+  RC          submit(vector<IoRequest> &requests) override;
+
+private:
+  struct Context;
+
+  void reap_completions();
+  RC   enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+  void unmap_rings();
+
+private:
+  int ring_fd_ = -1;
+
+  void    *sq_ring_      = nullptr;
+  size_t   sq_ring_size_ = 0;
+  void    *cq_ring_      = nullptr;
+  size_t   cq_ring_size_ = 0;
+  void    *sqes_         = nullptr;
+  size_t   sqes_size_    = 0;
+  unsigned sq_entries_   = 0;
+
+  /// 提交队列和完成队列中各个字段的地址，都在和内核共享的内存中
+  unsigned *sq_head_  = nullptr;
+  unsigned *sq_tail_  = nullptr;
+  unsigned *sq_mask_  = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned *cq_head_  = nullptr;
+  unsigned *cq_tail_  = nullptr;
+  unsigned *cq_mask_  = nullptr;
+  void     *cqes_     = nullptr;
+
+  mutex              submit_lock_;  ///< 保护提交队列和 inflight_num_
+  condition_variable submit_cv_;    ///< 在途请求太多时等待
+  unsigned           inflight_num_ = 0;
+  bool               stopping_     = false;
+
+  thread reaper_;
+};
+
+#endif  // __linux__
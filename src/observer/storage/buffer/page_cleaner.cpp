@@ -0,0 +1,295 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/page_cleaner.h"
+#include "common/conf/ini.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/limits.h"
+#include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/log_handler.h"
+
+using namespace common;
+
+PageCleanerOptions PageCleanerOptions::from_properties()
+{
+  PageCleanerOptions options;
+#ifndef CONCURRENCY
+  // 没有使用 CONCURRENCY 编译时锁什么都不做，后台线程不能和前台线程同时访问buffer pool
+  options.thread_num = 0;
+#endif
+
+  Ini *properties = get_properties();
+  if (properties == nullptr) {
+    return options;
+  }
+
+  auto load = [properties](const char *key, auto &value) {
+    string str = properties->get(key, "", "BUFFER_POOL");
+    if (!str.empty()) {
+      str_to_val(str, value);
+    }
+  };
+
+  load("PAGE_CLEANER_THREADS", options.thread_num);
+  load("PAGE_CLEANER_INTERVAL_MS", options.interval_ms);
+  load("PAGE_CLEANER_IO_CAPACITY", options.io_capacity);
+  load("PAGE_CLEANER_DIRTY_LOW_WATERMARK", options.dirty_low_watermark);
+  load("PAGE_CLEANER_DIRTY_HIGH_WATERMARK", options.dirty_high_watermark);
+  load("PAGE_CLEANER_REDO_CAPACITY", options.redo_capacity);
+  return options;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PageCleaner::~PageCleaner() { stop(); }
+
+RC PageCleaner::init(BufferPoolManager &bp_manager, LogHandler &log_handler, LSN check_point_lsn,
+    CheckpointHandler handler, const PageCleanerOptions &options /* = PageCleanerOptions::from_properties() */)
+{
+  options_                      = options;
+  options_.thread_num           = max(options_.thread_num, 0);
+  options_.interval_ms          = max(options_.interval_ms, 1);
+  options_.io_capacity          = max(options_.io_capacity, 1);
+  options_.dirty_low_watermark  = min(max(options_.dirty_low_watermark, 0), 99);
+  options_.dirty_high_watermark = min(max(options_.dirty_high_watermark, options_.dirty_low_watermark + 1), 100);
+  options_.redo_capacity        = max(options_.redo_capacity, static_cast<LSN>(1));
+
+  bp_manager_          = &bp_manager;
+  log_handler_         = &log_handler;
+  check_point_handler_ = std::move(handler);
+  check_point_lsn_.store(check_point_lsn);
+  round_start_lsn_ = log_handler.current_lsn();
+  last_round_lsn_  = round_start_lsn_;
+
+  LOG_INFO("page cleaner init. threads=%d, interval=%dms, io capacity=%d, dirty watermark=[%d,%d], redo capacity=%ld, "
+           "check point lsn=%ld",
+           options_.thread_num, options_.interval_ms, options_.io_capacity, options_.dirty_low_watermark,
+           options_.dirty_high_watermark, options_.redo_capacity, check_point_lsn);
+  return RC::SUCCESS;
+}
+
+RC PageCleaner::start()
+{
+  if (options_.thread_num <= 0) {
+    LOG_INFO("page cleaner is disabled");
+    return RC::SUCCESS;
+  }
+
+  if (thread_) {
+    LOG_WARN("page cleaner has been started");
+    return RC::INTERNAL;
+  }
+
+  if (options_.thread_num > 1) {
+    int ret = executor_.init("PageCleaner", options_.thread_num, options_.thread_num, 60 * 1000);
+    if (ret != 0) {
+      LOG_WARN("failed to init page cleaner executor. ret=%d", ret);
+      return RC::INTERNAL;
+    }
+  }
+
+  running_ = true;
+  thread_  = make_unique<thread>(&PageCleaner::thread_func, this);
+  LOG_INFO("page cleaner started");
+  return RC::SUCCESS;
+}
+
+RC PageCleaner::stop()
+{
+  if (!thread_) {
+    return RC::SUCCESS;
+  }
+
+  {
+    lock_guard<mutex> guard(mutex_);
+    running_ = false;
+  }
+  cv_.notify_all();
+  thread_->join();
+  thread_.reset();
+
+  if (options_.thread_num > 1) {
+    executor_.shutdown();
+    executor_.await_termination();
+  }
+  LOG_INFO("page cleaner stopped");
+  return RC::SUCCESS;
+}
+
+void PageCleaner::thread_func()
+{
+  thread_set_name("PageCleaner");
+
+  while (running_.load()) {
+    int flushed_count = 0;
+    int pressure      = run_once(flushed_count);
+
+    chrono::milliseconds interval(options_.interval_ms);
+    if (pressure >= 100) {
+      interval = max(interval / 10, chrono::milliseconds(1));
+    }
+
+    unique_lock<mutex> lock(mutex_);
+    cv_.wait_for(lock, interval, [this]() { return !running_.load(); });
+  }
+}
+
+int PageCleaner::run_once(int &flushed_count)
+{
+  flushed_count = 0;
+
+  const LSN current_lsn = log_handler_->current_lsn();
+
+  vector<pair<FrameId, LSN>> dirty_frames;
+  bp_manager_->get_frame_manager().dirty_frames(dirty_frames);
+
+  const int pressure = calc_pressure(dirty_frames.size(), current_lsn);
+
+  // 一轮中没有新的日志说明系统比较空闲，可以放开刷
+  int batch_pressure = pressure;
+  if (current_lsn == last_round_lsn_) {
+    batch_pressure = 100;
+  }
+  last_round_lsn_ = current_lsn;
+
+  if (batch_pressure > 0 && !dirty_frames.empty()) {
+    size_t batch_size = max(static_cast<size_t>(options_.io_capacity) * batch_pressure / 100, static_cast<size_t>(1));
+    batch_size        = min(batch_size, dirty_frames.size());
+
+    // rec lsn 为0的页面没有日志，不影响检查点，放在最后
+    auto sort_key = [](const pair<FrameId, LSN> &frame) {
+      return frame.second == 0 ? numeric_limits<LSN>::max() : frame.second;
+    };
+    partial_sort(dirty_frames.begin(),
+        dirty_frames.begin() + batch_size,
+        dirty_frames.end(),
+        [&sort_key](const pair<FrameId, LSN> &a, const pair<FrameId, LSN> &b) { return sort_key(a) < sort_key(b); });
+    dirty_frames.resize(batch_size);
+
+    flushed_count = flush_frames(dirty_frames);
+    LOG_DEBUG("page cleaner flushed %d/%ld pages. pressure=%d", flushed_count, batch_size, batch_pressure);
+  }
+
+  advance_check_point();
+  round_start_lsn_ = current_lsn;
+  return pressure;
+}
+
+int PageCleaner::calc_pressure(size_t dirty_num, LSN current_lsn) const
+{
+  const size_t total_num = bp_manager_->get_frame_manager().total_frame_num();
+
+  int dirty_pressure = 0;
+  if (total_num > 0) {
+    const int dirty_percent = static_cast<int>(dirty_num * 100 / total_num);
+    if (dirty_percent >= options_.dirty_high_watermark) {
+      dirty_pressure = 100;
+    } else if (dirty_percent > options_.dirty_low_watermark) {
+      dirty_pressure = (dirty_percent - options_.dirty_low_watermark) * 100 /
+                       (options_.dirty_high_watermark - options_.dirty_low_watermark);
+    }
+  }
+
+  const LSN redo_size     = max(current_lsn - check_point_lsn_.load(), static_cast<LSN>(0));
+  const int redo_pressure = static_cast<int>(min(redo_size * 100 / options_.redo_capacity, static_cast<LSN>(100)));
+  return max(dirty_pressure, redo_pressure);
+}
+
+int PageCleaner::flush_frames(const vector<pair<FrameId, LSN>> &frames)
+{
+  // 同一个buffer pool的页面放在一起，保持LSN的顺序
+  vector<vector<FrameId>>        groups;
+  unordered_map<int32_t, size_t> group_index;
+  for (const auto &[frame_id, rec_lsn] : frames) {
+    auto iter = group_index.find(frame_id.buffer_pool_id());
+    if (iter == group_index.end()) {
+      iter = group_index.emplace(frame_id.buffer_pool_id(), groups.size()).first;
+      groups.emplace_back();
+    }
+    groups[iter->second].push_back(frame_id);
+  }
+
+  if (options_.thread_num <= 1 || groups.size() <= 1) {
+    int flushed_count = 0;
+    for (const vector<FrameId> &group : groups) {
+      flushed_count += flush_frames_internal(group);
+    }
+    return flushed_count;
+  }
+
+  atomic<int>        flushed_count{0};
+  int                running_count = static_cast<int>(groups.size());
+  mutex              done_mutex;
+  condition_variable done_cv;
+  for (const vector<FrameId> &group : groups) {
+    auto task = [this, &group, &flushed_count, &running_count, &done_mutex, &done_cv]() {
+      flushed_count += flush_frames_internal(group);
+
+      lock_guard<mutex> guard(done_mutex);
+      if (--running_count == 0) {
+        done_cv.notify_one();
+      }
+    };
+
+    if (executor_.execute(task) != 0) {
+      // 线程池已经停止了，直接在当前线程执行
+      task();
+    }
+  }
+
+  unique_lock<mutex> lock(done_mutex);
+  done_cv.wait(lock, [&running_count]() { return running_count == 0; });
+  return flushed_count.load();
+}
+
+int PageCleaner::flush_frames_internal(const vector<FrameId> &frames)
+{
+  int flushed_count = 0;
+  for (const FrameId &frame_id : frames) {
+    RC rc = bp_manager_->clean_page(frame_id);
+    if (OB_SUCC(rc)) {
+      flushed_count++;
+    } else if (rc != RC::LOCKED_CONCURRENCY_CONFLICT) {
+      LOG_WARN("failed to clean page. frame id=%s, rc=%s", frame_id.to_string().c_str(), strrc(rc));
+    }
+  }
+  return flushed_count;
+}
+
+void PageCleaner::advance_check_point()
+{
+  vector<pair<FrameId, LSN>> dirty_frames;
+  bp_manager_->get_frame_manager().dirty_frames(dirty_frames);
+
+  LSN lsn = round_start_lsn_ + 1;
+  for (const auto &[frame_id, rec_lsn] : dirty_frames) {
+    if (rec_lsn > 0 && rec_lsn < lsn) {
+      lsn = rec_lsn;
+    }
+  }
+
+  if (lsn <= check_point_lsn_.load() || !check_point_handler_) {
+    return;
+  }
+
+  RC rc = check_point_handler_(lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to make check point. lsn=%ld, rc=%s", lsn, strrc(rc));
+    return;
+  }
+
+  if (lsn > check_point_lsn_.load()) {
+    LOG_DEBUG("check point advanced. lsn=%ld, last=%ld", lsn, check_point_lsn_.load());
+    check_point_lsn_.store(lsn);
+  }
+}
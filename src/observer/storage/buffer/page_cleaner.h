@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/chrono.h"
+#include "common/lang/functional.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "common/thread/thread_pool_executor.h"
+#include "common/types.h"
+#include "storage/buffer/frame.h"
+
+class BufferPoolManager;
+class LogHandler;
+
+/**
+ * @brief page cleaner 的参数
+ * @ingroup BufferPool
+ * @details 没有设置时从配置文件 [BUFFER_POOL] 中读取，见 etc/observer.ini
+ */
+struct PageCleanerOptions
+{
+  int thread_num           = 1;     ///< 刷脏页的线程个数，0 表示不启动page cleaner
+  int interval_ms          = 1000;  ///< 两轮刷脏之间的间隔
+  int io_capacity          = 200;   ///< 压力最大时一轮最多刷多少个页面
+  int dirty_low_watermark  = 10;    ///< 脏页比例(百分比)低于这个值时，只有日志压力才会刷脏页
+  int dirty_high_watermark = 75;    ///< 脏页比例(百分比)达到这个值时，按照 io_capacity 全力刷脏页
+  LSN redo_capacity        = 8000;  ///< 检查点之后允许积累多少条日志，积累的越多，刷脏页越快
+
+  static PageCleanerOptions from_properties();
+};
+
+/**
+ * @brief 后台刷脏页，并推进模糊检查点(fuzzy checkpoint)
+ * @ingroup BufferPool
+ * @details 没有page cleaner时，脏页只有在淘汰或者sync时才写回磁盘，前台的查询需要同步等待刷盘，
+ * 并且检查点只在sync时推进，重启时要回放的日志越来越多。
+ * page cleaner 在后台周期性地执行下面的动作：
+ * 1. 按照页面的rec lsn从小到大挑选一批脏页，通过 BufferPoolManager::clean_page 刷新到double write buffer。
+ *    刷盘前会等待页面对应的日志落盘(write-ahead logging)；
+ * 2. 计算检查点：所有还没有落盘的页面中最小的rec lsn，同时不能超过上一轮开始时的LSN(+1)。
+ *    修改页面时先写日志再设置页面的LSN，上一轮开始之前分配的日志，页面LSN早就设置好了；
+ * 3. 通过回调让DB持久化检查点，并回收检查点之前的日志文件。
+ *
+ * 每一轮刷多少页面根据脏页比例和日志压力自适应调整：脏页比例在高低水位之间线性增长，日志压力是
+ * 检查点之后积累的日志占 redo_capacity 的比例，取两者中较大的一个乘以 io_capacity。系统空闲
+ * (一轮中没有新日志)时也全力刷脏页。压力达到100%时下一轮不再等待完整的间隔。
+ *
+ * @note 后台线程和前台线程并发访问buffer pool，需要使用 CONCURRENCY 编译，否则默认不启动。
+ */
+class PageCleaner final
+{
+public:
+  /**
+   * @brief 做检查点的回调
+   * @details 传入buffer pool允许的检查点LSN，返回真正生效的检查点LSN。回放日志时从检查点开始。
+   */
+  using CheckpointHandler = function<RC(LSN &check_point_lsn)>;
+
+  PageCleaner() = default;
+  ~PageCleaner();
+
+  /**
+   * @brief 初始化
+   * @param bp_manager 要刷新哪个buffer pool manager中的脏页
+   * @param log_handler 日志模块，用来获取当前的LSN
+   * @param check_point_lsn 当前的检查点
+   * @param handler 推进检查点的回调
+   * @param options 参数，使用默认参数时从配置文件中读取
+   */
+  RC init(BufferPoolManager &bp_manager, LogHandler &log_handler, LSN check_point_lsn, CheckpointHandler handler,
+      const PageCleanerOptions &options = PageCleanerOptions::from_properties());
+
+  /**
+   * @brief 启动后台线程。thread_num 是0时什么都不做
+   */
+  RC start();
+
+  /**
+   * @brief 停止后台线程并等待退出
+   */
+  RC stop();
+
+  /**
+   * @brief 执行一轮刷脏页并推进检查点
+   * @details 后台线程循环调用这个函数，测试时也可以直接调用
+   * @param[out] flushed_count 这一轮刷了多少页面
+   * @return 这一轮的压力(百分比)，100 表示需要尽快开始下一轮
+   */
+  int run_once(int &flushed_count);
+
+  LSN check_point_lsn() const { return check_point_lsn_.load(); }
+
+  const PageCleanerOptions &options() const { return options_; }
+
+private:
+  void thread_func();
+
+  /**
+   * @brief 根据脏页比例和日志压力计算这一轮的刷脏压力，百分比
+   */
+  int calc_pressure(size_t dirty_num, LSN current_lsn) const;
+
+  /**
+   * @brief 刷新挑选出来的脏页
+   * @details 同一个buffer pool的页面会分给同一个线程，因为刷盘时需要持有buffer pool的锁
+   */
+  int flush_frames(const vector<pair<FrameId, LSN>> &frames);
+  int flush_frames_internal(const vector<FrameId> &frames);
+
+  /**
+   * @brief 计算并推进检查点
+   */
+  void advance_check_point();
+
+private:
+  BufferPoolManager *bp_manager_  = nullptr;
+  LogHandler        *log_handler_ = nullptr;
+  CheckpointHandler  check_point_handler_;
+  PageCleanerOptions options_;
+
+  atomic<LSN> check_point_lsn_{0};
+  LSN         round_start_lsn_ = 0;  ///< 上一轮开始时的LSN，检查点不能超过它+1
+  LSN         last_round_lsn_  = 0;  ///< 上一轮刷脏页时的LSN，用来判断系统是否空闲
+
+  unique_ptr<thread>         thread_;
+  atomic_bool                running_{false};
+  mutex                      mutex_;  ///< 配合cv_，让停止的时候可以立即唤醒后台线程
+  condition_variable         cv_;
+  common::ThreadPoolExecutor executor_;  ///< thread_num > 1 时用来并行刷脏页
+};
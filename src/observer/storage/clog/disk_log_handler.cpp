@@ -16,7 +16,10 @@ See the Mulan PSL v2 for more details. */
 #include "storage/clog/disk_log_handler.h"
 #include "storage/clog/log_file.h"
 #include "storage/clog/log_replayer.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/chrono.h"
+#include "common/conf/ini.h"
+#include "common/lang/string.h"
 
 using namespace common;
 
@@ -29,6 +32,12 @@ RC DiskLogHandler::init(const char *path)
   return file_manager_.init(path, max_entry_number_per_file);
 }
 
+void DiskLogHandler::set_group_commit(int64_t max_batch_bytes, chrono::microseconds max_delay)
+{
+  group_commit_max_batch_bytes_ = max_batch_bytes;
+  group_commit_max_delay_       = max_delay;
+}
+
 RC DiskLogHandler::start()
 {
   if (thread_) {
@@ -36,6 +45,29 @@ RC DiskLogHandler::start()
     return RC::INTERNAL;
   }
 
+  Ini *properties = get_properties();
+  if (group_commit_max_batch_bytes_ < 0) {
+    group_commit_max_batch_bytes_ = DEFAULT_GROUP_COMMIT_MAX_BATCH_BYTES;
+    if (properties != nullptr) {
+      string value = properties->get("GROUP_COMMIT_MAX_BATCH_BYTES", "", "CLOG");
+      if (!value.empty()) {
+        str_to_val(value, group_commit_max_batch_bytes_);
+      }
+    }
+  }
+  if (group_commit_max_delay_.count() < 0) {
+    int64_t delay_us = 0;
+    if (properties != nullptr) {
+      string value = properties->get("GROUP_COMMIT_MAX_DELAY_US", "", "CLOG");
+      if (!value.empty()) {
+        str_to_val(value, delay_us);
+      }
+    }
+    group_commit_max_delay_ = chrono::microseconds(delay_us);
+  }
+  LOG_INFO("log handler group commit. max batch bytes=%ld, max delay=%ldus",
+           group_commit_max_batch_bytes_, group_commit_max_delay_.count());
+
   running_.store(true);
   thread_ = make_unique<thread>(&DiskLogHandler::thread_func, this);
   LOG_INFO("log handler started");
@@ -49,7 +81,11 @@ RC DiskLogHandler::stop()
     return RC::INTERNAL;
   }
 
-  running_.store(false);
+  {
+    lock_guard<mutex> guard(flush_mutex_);
+    running_.store(false);
+  }
+  flush_cv_.notify_one();
 
   LOG_INFO("log handler stopped");
   return RC::SUCCESS;
@@ -75,7 +111,8 @@ RC DiskLogHandler::await_termination()
 
 RC DiskLogHandler::replay(LogReplayer &replayer, LSN start_lsn)
 {
-  LSN max_lsn = 0;
+  // 检查点之后可能没有任何日志，新的日志LSN也不能比检查点小
+  LSN max_lsn = max(start_lsn - 1, static_cast<LSN>(0));
   auto replay_callback = [&replayer, &max_lsn](LogEntry &entry) -> RC {
     if (entry.lsn() > max_lsn) {
       max_lsn = entry.lsn();
@@ -133,6 +170,17 @@ RC DiskLogHandler::iterate(function<RC(LogEntry&)> consumer, LSN start_lsn)
   return RC::SUCCESS;
 }
 
+RC DiskLogHandler::recycle(LSN check_point_lsn)
+{
+  int removed_count = 0;
+  RC  rc            = file_manager_.recycle(check_point_lsn, removed_count);
+  if (removed_count > 0) {
+    LOG_INFO("recycle clog files. check point lsn=%ld, removed files=%d, rc=%s", 
+             check_point_lsn, removed_count, strrc(rc));
+  }
+  return rc;
+}
+
 RC DiskLogHandler::_append(LSN &lsn, LogModule module, vector<char> &&data)
 {
   ASSERT(running_.load(), "log handler is not running. lsn=%ld, module=%s, size=%d", 
@@ -144,16 +192,32 @@ RC DiskLogHandler::_append(LSN &lsn, LogModule module, vector<char> &&data)
     return rc;
   }
 
+  {
+    // 加锁是为了防止刷盘线程检查完缓冲区为空但还没有开始等待的时候，丢失这次唤醒
+    lock_guard<mutex> guard(flush_mutex_);
+  }
+  flush_cv_.notify_one();
   return RC::SUCCESS;
 }
 
 RC DiskLogHandler::wait_lsn(LSN lsn)
 {
-  // 直接强制等待。在生产系统中，我们可能会使用条件变量来等待。
-  while (running_.load() && current_flushed_lsn() < lsn) {
-    this_thread::sleep_for(chrono::milliseconds(100));
+  if (current_flushed_lsn() >= lsn) {
+    return RC::SUCCESS;
   }
 
+  LsnWaiter         waiter;
+  unique_lock<mutex> lock(wait_mutex_);
+  auto               iter = lsn_waiters_.emplace(lsn, &waiter);
+  // 刷盘线程更新flushed_lsn之后才会加锁唤醒等待者，所以这里加锁之后检查不会丢失唤醒
+  waiter.cv.wait(lock, [this, &waiter, lsn]() {
+    return waiter.notified || current_flushed_lsn() >= lsn || !running_.load();
+  });
+  if (!waiter.notified) {
+    lsn_waiters_.erase(iter);
+  }
+  lock.unlock();
+
   if (current_flushed_lsn() >= lsn) {
     return RC::SUCCESS;
   } else {
@@ -161,12 +225,42 @@ RC DiskLogHandler::wait_lsn(LSN lsn)
   }
 }
 
+void DiskLogHandler::wait_for_entries()
+{
+  unique_lock<mutex> lock(flush_mutex_);
+  flush_cv_.wait(lock, [this]() { return entry_buffer_.entry_number() > 0 || !running_.load(); });
+
+  // 刷盘之前再等一会儿，让更多的事务把日志放进来，一起刷盘。
+  // 已经凑够一批或者要停止了就不再等待。
+  if (group_commit_max_delay_.count() > 0) {
+    auto deadline = chrono::steady_clock::now() + group_commit_max_delay_;
+    flush_cv_.wait_until(lock, deadline, [this]() {
+      return !running_.load() ||
+             (group_commit_max_batch_bytes_ > 0 && entry_buffer_.bytes() >= group_commit_max_batch_bytes_);
+    });
+  }
+}
+
+void DiskLogHandler::notify_waiters(bool all)
+{
+  lock_guard<mutex> guard(wait_mutex_);
+
+  const LSN flushed_lsn = current_flushed_lsn();
+  auto      end_iter    = all ? lsn_waiters_.end() : lsn_waiters_.upper_bound(flushed_lsn);
+  for (auto iter = lsn_waiters_.begin(); iter != end_iter; ++iter) {
+    iter->second->notified = true;
+    iter->second->cv.notify_one();
+  }
+  lsn_waiters_.erase(lsn_waiters_.begin(), end_iter);
+}
+
 void DiskLogHandler::thread_func()
 {
   /*
-  这个线程一直不停的循环，检查日志缓冲区中是否有日志在内存中，如果在内存中就刷新到磁盘。
-  这种做法很粗暴简单，与生产数据库的做法不同。生产数据库通常会在内存达到一定量，或者一定时间
-  之后，会刷新一下磁盘。这样做的好处是减少磁盘的IO次数，提高性能。
+  这个线程等待日志缓冲区中有日志，然后把缓冲区中的日志一批一批的刷新到磁盘。
+  每一批日志只写一次文件、刷一次盘，然后唤醒等待这批日志的事务，也就是组提交。
+  在刷盘的过程中新提交的事务会把日志放到缓冲区中，下一次就会作为一批一起刷盘，
+  所以并发提交的事务越多，每一批日志就越大，平均每个事务的刷盘代价就越小。
   */
   thread_set_name("LogHandler");
   LOG_INFO("log handler thread started");
@@ -192,17 +286,22 @@ void DiskLogHandler::thread_func()
       LOG_INFO("open log file success. file=%s", file_writer.to_string().c_str());
     }
 
+    if (rc == RC::SUCCESS) {
+      wait_for_entries();
+    }
+
     int flush_count = 0;
-    rc = entry_buffer_.flush(file_writer, flush_count);
+    rc = entry_buffer_.flush(file_writer, flush_count, group_commit_max_batch_bytes_);
     if (OB_FAIL(rc) && RC::LOG_FILE_FULL != rc) {
       LOG_WARN("failed to flush log entry buffer. rc=%s", strrc(rc));
+      this_thread::sleep_for(chrono::milliseconds(100));
     }
 
-    if (flush_count == 0 && rc == RC::SUCCESS) {
-      this_thread::sleep_for(chrono::milliseconds(100));
-      continue;
+    if (flush_count > 0) {
+      notify_waiters(false /*all*/);
     }
   }
 
+  notify_waiters(true /*all*/);
   LOG_INFO("log handler thread stopped");
 }
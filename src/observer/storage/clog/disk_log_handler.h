@@ -20,6 +20,10 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/deque.h"
 #include "common/lang/memory.h"
 #include "common/lang/thread.h"
+#include "common/lang/mutex.h"
+#include "common/lang/condition_variable.h"
+#include "common/lang/chrono.h"
+#include "common/lang/map.h"
 #include "storage/clog/log_module.h"
 #include "storage/clog/log_file.h"
 #include "storage/clog/log_buffer.h"
@@ -31,7 +35,9 @@ class LogReplayer;
  * @brief 对外提供服务的CLog模块
  * @ingroup CLog
  * @details 该模块负责日志的写入、读取、回放等功能。
- * 会在后台开启一个线程，一直尝试刷新内存中的日志到磁盘。
+ * 会在后台开启一个线程，刷新内存中的日志到磁盘。
+ * 日志刷盘使用组提交(group commit)：后台线程每次把缓冲区中所有的日志作为一批，只写一次文件、刷一次盘，
+ * 然后只唤醒那些等待的日志已经刷盘的事务。事务提交时在条件变量上等待，而不是轮询。
  * 所有的CLog日志文件都存放在指定的目录下，每个日志文件按照日志条数来划分。
  * 调用的顺序应该是：
  * @code {.cpp}
@@ -58,6 +64,15 @@ public:
    */
   RC init(const char *path) override;
 
+  /**
+   * @brief 设置组提交的参数
+   * @details 需要在start之前调用。没有调用时使用配置文件中 [CLOG] 的 GROUP_COMMIT_MAX_BATCH_BYTES
+   * 和 GROUP_COMMIT_MAX_DELAY_US，配置文件中也没有时使用默认值。
+   * @param max_batch_bytes 一批日志最多多少字节，0 表示不限制
+   * @param max_delay 等待更多的日志凑成一批的最长时间，0 表示有日志就立即刷盘
+   */
+  void set_group_commit(int64_t max_batch_bytes, chrono::microseconds max_delay);
+
   /**
    * @brief 启动线程刷新日志到磁盘
    */
@@ -92,11 +107,17 @@ public:
 
   /**
    * @brief 等待指定的日志刷盘
-   *
+   * @details 在条件变量上等待，刷盘线程刷完一批日志后会唤醒LSN不大于已刷盘LSN的等待者。
    * @param lsn 想要等待的日志
    */
   RC wait_lsn(LSN lsn) override;
 
+  /**
+   * @brief 删除所有日志都在检查点之前的日志文件
+   * @param check_point_lsn 检查点LSN
+   */
+  RC recycle(LSN check_point_lsn) override;
+
   /// @brief 当前的LSN
   LSN current_lsn() const override { return entry_buffer_.current_lsn(); }
   /// @brief 当前刷新到哪个日志
@@ -118,10 +139,42 @@ private:
    */
   void thread_func();
 
+  /**
+   * @brief 等待缓冲区中有日志需要刷新
+   * @details 有日志之后，如果配置了组提交延迟，会再等待一会儿让一批日志凑得更大一些
+   */
+  void wait_for_entries();
+
+  /**
+   * @brief 唤醒等待的日志已经刷盘的事务
+   * @param all 是否唤醒所有的等待者，停止的时候使用
+   */
+  void notify_waiters(bool all);
+
 private:
+  static constexpr int64_t DEFAULT_GROUP_COMMIT_MAX_BATCH_BYTES = 1024 * 1024;  /// 默认一批日志最多1M
+
+  /**
+   * @brief 一个等待日志刷盘的事务
+   * @details 每个等待者有自己的条件变量，刷盘线程只唤醒满足条件的等待者，避免惊群
+   */
+  struct LsnWaiter
+  {
+    condition_variable cv;
+    bool               notified = false;  /// 是否已经被刷盘线程唤醒并从等待队列中删除
+  };
+
   unique_ptr<thread> thread_;          /// 刷新日志的线程
   atomic_bool        running_{false};  /// 是否还要继续运行
 
+  int64_t              group_commit_max_batch_bytes_ = -1;  /// 一批日志最多多少字节，小于0表示还没有设置
+  chrono::microseconds group_commit_max_delay_{-1};         /// 凑一批日志最多等待多久，小于0表示还没有设置
+
+  mutex                      flush_mutex_;  /// 保护flush_cv_，追加日志时唤醒刷盘线程
+  condition_variable         flush_cv_;
+  mutex                      wait_mutex_;   /// 保护lsn_waiters_
+  multimap<LSN, LsnWaiter *> lsn_waiters_;  /// 按照LSN排序的等待者
+
   LogFileManager file_manager_;  /// 管理所有的日志文件
   LogEntryBuffer entry_buffer_;  /// 缓存日志
 
@@ -54,44 +54,59 @@ RC LogEntryBuffer::append(LSN &lsn, LogModule module, vector<char> &&data)
   lsn = ++current_lsn_;
   entry.set_lsn(lsn);
 
-  entries_.push_back(std::move(entry));
   bytes_ += entry.total_size();
+  entries_.push_back(std::move(entry));
   return RC::SUCCESS;
 }
 
-RC LogEntryBuffer::flush(LogFileWriter &writer, int &count)
+RC LogEntryBuffer::flush(LogFileWriter &writer, int &count, int64_t max_batch_bytes /*= 0*/)
 {
   count = 0;
 
+  vector<LogEntry> batch;
   while (entry_number() > 0) {
-    LogEntry entry;
+    batch.clear();
+    int64_t batch_bytes = 0;
     {
       lock_guard guard(mutex_);
-      if (entries_.empty()) {
-        break;
+      while (!entries_.empty()) {
+        LogEntry &front_entry = entries_.front();
+        ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
+        if (max_batch_bytes > 0 && !batch.empty() && batch_bytes + front_entry.total_size() > max_batch_bytes) {
+          break;
+        }
+
+        batch_bytes += front_entry.total_size();
+        batch.emplace_back(std::move(front_entry));
+        entries_.pop_front();
       }
+    }
+
+    if (batch.empty()) {
+      break;
+    }
 
-      LogEntry &front_entry = entries_.front();
-      ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
-      entry = std::move(entries_.front());
-      ASSERT(entry.payload_size() > 0 && entry.lsn() > 0, "invalid log entry");
-      entries_.pop_front();
-      bytes_ -= entry.total_size();
+    int batch_count = 0;
+    RC  rc          = writer.write(span<LogEntry>(batch), batch_count);
+    if (batch_count > 0) {
+      count += batch_count;
+      flushed_lsn_ = batch[batch_count - 1].lsn();
     }
-    
-    RC rc = writer.write(entry);
+
     if (OB_FAIL(rc)) {
+      // 没有写成功的日志放回缓冲区，保持原来的顺序
       lock_guard guard(mutex_);
-      entries_.emplace_front(std::move(entry));
-      LogEntry &front_entry = entries_.front();
-      ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
+      for (int i = static_cast<int>(batch.size()) - 1; i >= batch_count; i--) {
+        entries_.emplace_front(std::move(batch[i]));
+        batch_bytes -= entries_.front().total_size();
+      }
+      bytes_ -= batch_bytes;
       return rc;
-    } else {
-      ++count;
-      flushed_lsn_ = entry.lsn();
     }
+
+    bytes_ -= batch_bytes;
   }
-  
+
   return RC::SUCCESS;
 }
 
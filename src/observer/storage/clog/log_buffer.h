@@ -48,11 +48,12 @@ public:
 
   /**
    * @brief 刷新缓冲区中的日志到磁盘
-   *
+   * @details 每次从缓冲区中取出一批日志，一次写入并刷盘，直到缓冲区为空
    * @param file_handle 使用它来写文件
    * @param count 刷了多少条日志
+   * @param max_batch_bytes 每一批日志最多多少字节，0 表示不限制。至少会取一条日志
    */
-  RC flush(LogFileWriter &file_writer, int &count);
+  RC flush(LogFileWriter &file_writer, int &count, int64_t max_batch_bytes = 0);
 
   /**
    * @brief 当前缓冲区中有多少字节的日志
@@ -70,7 +71,7 @@ public:
 private:
   mutex           mutex_;  /// 当前数据结构一定会在多线程中访问，所以强制使用有效的锁，而不是有条件生效的common::Mutex
   deque<LogEntry> entries_;  /// 日志缓冲区
-  atomic<int64_t> bytes_;    /// 当前缓冲区中的日志数据大小
+  atomic<int64_t> bytes_{0}; /// 当前缓冲区中的日志数据大小
 
   atomic<LSN> current_lsn_{0};
   atomic<LSN> flushed_lsn_{0};
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include <fcntl.h>
+#include <unistd.h>
 
 #include "common/lang/string_view.h"
 #include "common/lang/charconv.h"
@@ -155,7 +156,7 @@ RC LogFileWriter::open(const char *filename, int end_lsn)
   filename_ = filename;
   end_lsn_ = end_lsn;
 
-  fd_ = ::open(filename, O_WRONLY | O_APPEND | O_CREAT | O_SYNC, 0644);
+  fd_ = ::open(filename, O_WRONLY | O_APPEND | O_CREAT, 0644);
   if (fd_ < 0) {
     LOG_WARN("open file failed. filename=%s, error=%s", filename, strerror(errno));
     return RC::FILE_OPEN;
@@ -178,40 +179,70 @@ RC LogFileWriter::close()
 
 RC LogFileWriter::write(LogEntry &entry)
 {
-  // 一个日志文件写的日志条数是有限制的
-  if (entry.lsn() > end_lsn_) {
-    return RC::LOG_FILE_FULL;
-  }
+  int count = 0;
+  return write(span<LogEntry>(&entry, 1), count);
+}
 
+RC LogFileWriter::write(span<LogEntry> entries, int &count)
+{
+  count = 0;
   if (fd_ < 0) {
     return RC::FILE_NOT_OPENED;
   }
 
-  if (entry.lsn() <= last_lsn_) {
-    LOG_WARN("write log entry failed. lsn is too small. filename=%s, last_lsn=%ld, entry=%s", 
-             filename_.c_str(), last_lsn_, entry.to_string().c_str());
-    return RC::INVALID_ARGUMENT;
+  // 一个日志文件写的日志条数是有限制的，只写能放到当前文件中的那部分日志
+  int     entry_num = 0;
+  int64_t bytes     = 0;
+  LSN     last_lsn  = last_lsn_;
+  for (LogEntry &entry : entries) {
+    if (entry.lsn() > end_lsn_) {
+      break;
+    }
+
+    if (entry.lsn() <= last_lsn) {
+      LOG_WARN("write log entry failed. lsn is too small. filename=%s, last_lsn=%ld, entry=%s", 
+               filename_.c_str(), last_lsn, entry.to_string().c_str());
+      return RC::INVALID_ARGUMENT;
+    }
+
+    last_lsn = entry.lsn();
+    bytes += entry.total_size();
+    entry_num++;
+  }
+
+  if (entry_num == 0) {
+    return entries.empty() ? RC::SUCCESS : RC::LOG_FILE_FULL;
+  }
+
+  vector<char> buffer;
+  buffer.reserve(bytes);
+  for (int i = 0; i < entry_num; i++) {
+    const LogEntry &entry  = entries[i];
+    const char     *header = reinterpret_cast<const char *>(&entry.header());
+    buffer.insert(buffer.end(), header, header + LogHeader::SIZE);
+    buffer.insert(buffer.end(), entry.data(), entry.data() + entry.payload_size());
   }
 
   /// WARNING 这里需要处理日志写一半的情况
   /// 日志只写成功一部分到文件中非常难处理
-  int ret = writen(fd_, reinterpret_cast<const char *>(&entry.header()), LogHeader::SIZE);
+  int ret = writen(fd_, buffer.data(), buffer.size());
   if (0 != ret) {
-    LOG_WARN("write log entry header failed. filename=%s, ret = %d, error=%s, entry=%s", 
-             filename_.c_str(), ret, strerror(errno), entry.to_string().c_str());
+    LOG_WARN("write log entries failed. filename=%s, ret = %d, error=%s, entry_num=%d, bytes=%ld", 
+             filename_.c_str(), ret, strerror(errno), entry_num, bytes);
     return RC::IOERR_WRITE;
   }
 
-  ret = writen(fd_, entry.data(), entry.payload_size());
+  // 一批日志只刷一次盘，这是组提交(group commit)能够提高性能的关键
+  ret = fsync(fd_);
   if (0 != ret) {
-    LOG_WARN("write log entry payload failed. filename=%s, ret = %d, error=%s, entry=%s", 
-             filename_.c_str(), ret, strerror(errno), entry.to_string().c_str());
-    return RC::IOERR_WRITE;
+    LOG_WARN("sync log file failed. filename=%s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_SYNC;
   }
 
-  last_lsn_ = entry.lsn();
-  LOG_TRACE("write log entry success. filename=%s, entry=%s", filename_.c_str(), entry.to_string().c_str());
-  return RC::SUCCESS;
+  last_lsn_ = last_lsn;
+  count     = entry_num;
+  LOG_TRACE("write log entries success. filename=%s, entry_num=%d, last_lsn=%ld", filename_.c_str(), entry_num, last_lsn);
+  return entry_num < static_cast<int>(entries.size()) ? RC::LOG_FILE_FULL : RC::SUCCESS;
 }
 
 bool LogFileWriter::valid() const
@@ -298,6 +329,7 @@ RC LogFileManager::list_files(vector<string> &files, LSN start_lsn)
 {
   files.clear();
 
+  lock_guard<mutex> guard(lock_);
   // 这里的代码是AI自动生成的
   // 其实写的不好，我们只需要找到比start_lsn相等或者小的第一个日志文件就可以了
   for (auto &file : log_files_) {
@@ -311,7 +343,9 @@ RC LogFileManager::list_files(vector<string> &files, LSN start_lsn)
 
 RC LogFileManager::last_file(LogFileWriter &file_writer)
 {
+  unique_lock<mutex> guard(lock_);
   if (log_files_.empty()) {
+    guard.unlock();
     return next_file(file_writer);
   }
 
@@ -327,13 +361,53 @@ RC LogFileManager::next_file(LogFileWriter &file_writer)
   file_writer.close();
 
   LSN lsn = 0;
-  if (!log_files_.empty()) {
-    lsn = log_files_.rbegin()->first + max_entry_number_per_file_;
-  }
+  filesystem::path file_path;
+  {
+    lock_guard<mutex> guard(lock_);
+    if (!log_files_.empty()) {
+      lsn = log_files_.rbegin()->first + max_entry_number_per_file_;
+    }
 
-  string filename = file_prefix_ + to_string(lsn) + file_suffix_;
-  filesystem::path file_path = directory_ / filename;
-  log_files_.emplace(lsn, file_path);
+    string filename = file_prefix_ + to_string(lsn) + file_suffix_;
+    file_path = directory_ / filename;
+    log_files_.emplace(lsn, file_path);
+  }
 
   return file_writer.open(file_path.c_str(), lsn + max_entry_number_per_file_ - 1);
 }
+
+RC LogFileManager::recycle(LSN lsn, int &removed_count)
+{
+  removed_count = 0;
+
+  vector<filesystem::path> files;
+  {
+    lock_guard<mutex> guard(lock_);
+    if (log_files_.size() <= 1) {
+      return RC::SUCCESS;
+    }
+
+    auto last_iter = prev(log_files_.end());
+    for (auto iter = log_files_.begin(); iter != last_iter;) {
+      if (iter->first + max_entry_number_per_file_ - 1 >= lsn) {
+        break;
+      }
+      files.push_back(iter->second);
+      iter = log_files_.erase(iter);
+    }
+  }
+
+  RC rc = RC::SUCCESS;
+  for (const filesystem::path &file : files) {
+    error_code ec;
+    filesystem::remove(file, ec);
+    if (ec) {
+      LOG_WARN("failed to remove clog file. file=%s, error=%s", file.c_str(), ec.message().c_str());
+      rc = RC::IOERR_WRITE;
+      continue;
+    }
+    removed_count++;
+    LOG_INFO("clog file recycled. file=%s, checkpoint lsn=%ld", file.c_str(), lsn);
+  }
+  return rc;
+}
@@ -17,10 +17,12 @@ See the Mulan PSL v2 for more details. */
 #include "common/sys/rc.h"
 #include "common/types.h"
 #include "common/lang/map.h"
+#include "common/lang/mutex.h"
 #include "common/lang/functional.h"
 #include "common/lang/filesystem.h"
 #include "common/lang/fstream.h"
 #include "common/lang/string.h"
+#include "common/lang/span.h"
 
 class LogEntry;
 
@@ -76,6 +78,15 @@ public:
   /// @brief 写入一条日志
   RC write(LogEntry &entry);
 
+  /**
+   * @brief 批量写入日志
+   * @details 所有日志拼接在一起只调用一次write，然后调用一次fsync。
+   * 如果只有前面一部分日志能放到当前文件中，就只写这一部分，并返回 RC::LOG_FILE_FULL。
+   * @param entries 要写入的日志，LSN必须是递增的
+   * @param[out] count 成功写入了多少条日志
+   */
+  RC write(span<LogEntry> entries, int &count);
+
   /**
    * @brief 当前文件是否已经打开
    */
@@ -137,6 +148,15 @@ public:
    */
   RC next_file(LogFileWriter &file_writer);
 
+  /**
+   * @brief 删除不再需要的日志文件
+   * @details 文件中所有日志的LSN都小于 lsn 时，这个文件就可以删除了。最后一个日志文件总会保留，
+   * 因为新的日志文件名是根据最后一个文件计算出来的。
+   * @param lsn 检查点LSN，回放时从这个LSN开始
+   * @param removed_count 删除了多少个文件
+   */
+  RC recycle(LSN lsn, int &removed_count);
+
 private:
   /**
    * @brief 从文件名称中获取LSN
@@ -151,5 +171,6 @@ private:
   filesystem::path directory_;                  /// 日志文件存放的目录
   int              max_entry_number_per_file_;  /// 一个文件最大允许存放多少条日志
 
+  mutex                      lock_;       /// 保护log_files_。刷日志的线程和做检查点的线程都会访问
   map<LSN, filesystem::path> log_files_;  /// 日志文件名和第一个LSN的映射
 };
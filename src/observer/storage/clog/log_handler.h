@@ -96,6 +96,13 @@ public:
 
   virtual LSN current_lsn() const = 0;
 
+  /**
+   * @brief 回收检查点之前的日志
+   * @details 检查点之前的日志对应的修改都已经落盘了，回放时也不会再读取
+   * @param check_point_lsn 检查点LSN，回放时从这个LSN开始
+   */
+  virtual RC recycle(LSN check_point_lsn) { return RC::SUCCESS; }
+
   static RC create(const char *name, LogHandler *&handler);
 
 private:
@@ -27,17 +27,56 @@ RC Chunk::reference(Chunk &chunk)
     columns_[i]->reference(chunk.column(i));
     column_ids_.push_back(chunk.column_ids(i));
   }
+  has_selection_ = chunk.has_selection_;
+  selection_     = chunk.selection_;
+  return RC::SUCCESS;
+}
+
+int Chunk::column_index(int col_id) const
+{
+  for (size_t i = 0; i < column_ids_.size(); i++) {
+    if (column_ids_[i] == col_id) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+RC Chunk::get_column(size_t idx, Column &column) const
+{
+  ASSERT(idx < columns_.size(), "invalid column index");
+  const Column &source = *columns_[idx];
+  if (!has_selection_ || source.column_type() == Column::Type::CONSTANT_COLUMN) {
+    column.reference(source);
+    return RC::SUCCESS;
+  }
+
+  column.gather(source, selection_);
   return RC::SUCCESS;
 }
 
 int Chunk::rows() const
 {
+  if (has_selection_) {
+    return static_cast<int>(selection_.size());
+  }
   if (!columns_.empty()) {
     return columns_[0]->count();
   }
   return 0;
 }
 
+void Chunk::set_selection(const vector<uint8_t> &select)
+{
+  selection_.clear();
+  for (size_t i = 0; i < select.size(); i++) {
+    if (select[i] != 0) {
+      selection_.push_back(static_cast<int>(i));
+    }
+  }
+  has_selection_ = true;
+}
+
 int Chunk::capacity() const
 {
   if (!columns_.empty()) {
@@ -51,10 +90,14 @@ void Chunk::reset_data()
   for (auto &col : columns_) {
     col->reset_data();
   }
+  has_selection_ = false;
+  selection_.clear();
 }
 
 void Chunk::reset()
 {
   columns_.clear();
   column_ids_.clear();
+  has_selection_ = false;
+  selection_.clear();
 }
\ No newline at end of file
@@ -18,6 +18,8 @@ See the Mulan PSL v2 for more details. */
 
 /**
  * @brief A Chunk represents a set of columns.
+ * @details A chunk may carry a selection vector. Then only the selected rows are part of the chunk, but the
+ * column data is not compacted. Consumers that need dense data copy the selected rows out with get_column.
  */
 class Chunk
 {
@@ -46,15 +48,41 @@ public:
     return column_ids_[i];
   }
 
+  /**
+   * @brief Find the column with the given column id
+   * @return the index of the column, or -1 if not found
+   */
+  int column_index(int col_id) const;
+
+  /**
+   * @brief Get the dense data of a column
+   * @details Reference the column if there is no selection vector. Otherwise copy the selected rows into `column`.
+   */
+  RC get_column(size_t idx, Column &column) const;
+
   void add_column(unique_ptr<Column> col, int col_id);
 
   RC reference(Chunk &chunk);
 
   /**
    * @brief 获取 Chunk 中的行数
+   * @details 有选择向量时是被选中的行数
    */
   int rows() const;
 
+  /**
+   * @brief 设置选择向量
+   * @param select 长度和列中的数据个数相同，非0表示这一行被选中
+   */
+  void set_selection(const vector<uint8_t> &select);
+
+  bool has_selection() const { return has_selection_; }
+
+  /**
+   * @brief 被选中的行在列数据中的下标，递增
+   */
+  const vector<int> &selection() const { return selection_; }
+
   /**
    * @brief 获取 Chunk 的容量
    */
@@ -68,10 +96,13 @@ public:
    * @note 没有检查 col_idx 和 row_idx 是否越界
    *
    */
-  Value get_value(int col_idx, int row_idx) const { return columns_[col_idx]->get_value(row_idx); }
+  Value get_value(int col_idx, int row_idx) const
+  {
+    return columns_[col_idx]->get_value(has_selection_ ? selection_[row_idx] : row_idx);
+  }
 
   /**
-   * @brief 重置 Chunk 中的数据，不会修改 Chunk 的列属性。
+   * @brief 重置 Chunk 中的数据，不会修改 Chunk 的列属性。选择向量也会被清除
    */
   void reset_data();
 
@@ -82,4 +113,7 @@ private:
   // TODO: remove it and support multi-tables,
   // `columnd_ids` store the ids of child operator that need to be output
   vector<int> column_ids_;
+
+  bool        has_selection_ = false;
+  vector<int> selection_;
 };
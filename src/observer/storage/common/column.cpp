@@ -8,6 +8,8 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include "common/lang/algorithm.h"
+#include "common/lang/bitmap.h"
 #include "common/log/log.h"
 #include "storage/common/column.h"
 
@@ -69,21 +71,95 @@ void Column::init(const Value &value)
   count_     = 1;
   capacity_  = 1;
   own_       = true;
-  memcpy(data_, value.data(), attr_len_);
   column_type_ = Type::CONSTANT_COLUMN;
+  if (value.is_null()) {
+    memset(data_, 0, attr_len_);
+    set_null(0);
+  } else {
+    memcpy(data_, value.data(), attr_len_);
+  }
+}
+
+void Column::init_varlen(AttrType attr_type, int attr_len, size_t capacity)
+{
+  reset();
+  data_        = new char[(capacity + 1) * sizeof(int)];
+  count_       = 0;
+  capacity_    = capacity;
+  own_         = true;
+  attr_type_   = attr_type;
+  attr_len_    = attr_len;
+  column_type_ = Type::VARLEN_COLUMN;
+  heap_        = make_shared<vector<char>>();
+
+  reinterpret_cast<int *>(data_)[0] = 0;
+}
+
+void Column::init_dictionary(shared_ptr<Column> dictionary, size_t capacity)
+{
+  ASSERT(dictionary != nullptr, "dictionary should not be null");
+  reset();
+  data_        = new char[capacity * sizeof(int)];
+  count_       = 0;
+  capacity_    = capacity;
+  own_         = true;
+  attr_type_   = dictionary->attr_type();
+  attr_len_    = dictionary->attr_len();
+  column_type_ = Type::DICTIONARY_COLUMN;
+  dictionary_  = std::move(dictionary);
 }
 
 void Column::reset()
 {
-  if (data_ != nullptr && own_) {
+  if (own_) {
     delete[] data_;
+    delete[] null_bitmap_;
   }
-  data_      = nullptr;
-  count_     = 0;
-  capacity_  = 0;
-  own_       = false;
-  attr_type_ = AttrType::UNDEFINED;
-  attr_len_  = -1;
+  data_        = nullptr;
+  null_bitmap_ = nullptr;
+  has_null_    = false;
+  count_       = 0;
+  capacity_    = 0;
+  own_         = false;
+  attr_type_   = AttrType::UNDEFINED;
+  attr_len_    = -1;
+  heap_.reset();
+  dictionary_.reset();
+}
+
+void Column::reset_data()
+{
+  count_ = 0;
+  if (!own_) {
+    has_null_ = false;
+    return;
+  }
+
+  if (has_null_) {
+    memset(null_bitmap_, 0, common::Bitmap::bytes(capacity_));
+    has_null_ = false;
+  }
+  if (column_type_ == Type::VARLEN_COLUMN) {
+    heap_->clear();
+  }
+}
+
+void Column::ensure_null_bitmap()
+{
+  if (null_bitmap_ == nullptr) {
+    const int bytes = common::Bitmap::bytes(capacity_);
+    null_bitmap_    = new char[bytes];
+    memset(null_bitmap_, 0, bytes);
+  }
+}
+
+void Column::set_null(int index)
+{
+  ASSERT(own_, "cannot set null to non-owned column");
+  ASSERT(index >= 0 && index < capacity_, "invalid index %d, capacity %d", index, capacity_);
+  ensure_null_bitmap();
+  common::Bitmap(null_bitmap_, capacity_).set_bit(index);
+  has_null_ = true;
 }
 
 RC Column::append_one(char *data) { return append(data, 1); }
@@ -94,6 +170,10 @@ RC Column::append(char *data, int count)
     LOG_WARN("append data to non-owned column");
     return RC::INTERNAL;
   }
+  if (column_type_ == Type::VARLEN_COLUMN || column_type_ == Type::DICTIONARY_COLUMN) {
+    LOG_WARN("append fixed-length data to column with type %d", static_cast<int>(column_type_));
+    return RC::INTERNAL;
+  }
   if (count_ + count > capacity_) {
     LOG_WARN("append data to full column");
     return RC::INTERNAL;
@@ -106,12 +186,169 @@ RC Column::append(char *data, int count)
   return RC::SUCCESS;
 }
 
+RC Column::append_null()
+{
+  if (!own_ || column_type_ == Type::CONSTANT_COLUMN) {
+    LOG_WARN("append null to non-owned or constant column");
+    return RC::INTERNAL;
+  }
+  if (count_ >= capacity_) {
+    LOG_WARN("append null to full column");
+    return RC::INTERNAL;
+  }
+
+  RC rc = RC::SUCCESS;
+  switch (column_type_) {
+    case Type::VARLEN_COLUMN: rc = append_string("", 0); break;
+    case Type::DICTIONARY_COLUMN: {
+      reinterpret_cast<int *>(data_)[count_] = 0;
+      count_++;
+    } break;
+    default: {
+      memset(data_ + static_cast<size_t>(count_) * attr_len_, 0, attr_len_);
+      count_++;
+    } break;
+  }
+  if (OB_SUCC(rc)) {
+    set_null(count_ - 1);
+  }
+  return rc;
+}
+
+RC Column::append_string(const char *data, int len)
+{
+  if (!own_ || column_type_ != Type::VARLEN_COLUMN) {
+    LOG_WARN("append string to non-owned or fixed-length column");
+    return RC::INTERNAL;
+  }
+  if (count_ >= capacity_) {
+    LOG_WARN("append string to full column");
+    return RC::INTERNAL;
+  }
+
+  heap_->insert(heap_->end(), data, data + len);
+  int *offsets        = reinterpret_cast<int *>(data_);
+  offsets[count_ + 1] = static_cast<int>(heap_->size());
+  count_++;
+  return RC::SUCCESS;
+}
+
+RC Column::append_code(int code)
+{
+  if (!own_ || column_type_ != Type::DICTIONARY_COLUMN) {
+    LOG_WARN("append code to non-owned or non-dictionary column");
+    return RC::INTERNAL;
+  }
+  if (count_ >= capacity_) {
+    LOG_WARN("append code to full column");
+    return RC::INTERNAL;
+  }
+  if (code < 0 || code >= dictionary_->count()) {
+    LOG_WARN("invalid dictionary code %d, dictionary size %d", code, dictionary_->count());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  reinterpret_cast<int *>(data_)[count_] = code;
+  count_++;
+  return RC::SUCCESS;
+}
+
+void Column::gather(const Column &source, const vector<int> &rows)
+{
+  ASSERT(this != &source, "cannot gather from self");
+  if (source.column_type() == Type::CONSTANT_COLUMN) {
+    reference(source);
+    return;
+  }
+
+  const size_t capacity = max<size_t>(rows.size(), 1);
+  switch (source.column_type()) {
+    case Type::VARLEN_COLUMN: {
+      init_varlen(source.attr_type(), source.attr_len(), capacity);
+      for (int row : rows) {
+        string_view str = source.get_string(row);
+        append_string(str.data(), static_cast<int>(str.size()));
+      }
+    } break;
+
+    case Type::DICTIONARY_COLUMN: {
+      init_dictionary(source.dictionary(), capacity);
+      const int *codes = reinterpret_cast<const int *>(source.data());
+      int       *dest  = reinterpret_cast<int *>(data_);
+      for (size_t i = 0; i < rows.size(); i++) {
+        dest[i] = codes[rows[i]];
+      }
+      count_ = static_cast<int>(rows.size());
+    } break;
+
+    default: {
+      init(source.attr_type(), source.attr_len(), capacity);
+      const size_t attr_len = static_cast<size_t>(attr_len_);
+      char        *dest     = data_;
+      for (int row : rows) {
+        memcpy(dest, source.data() + row * attr_len, attr_len);
+        dest += attr_len;
+      }
+      count_ = static_cast<int>(rows.size());
+    } break;
+  }
+
+  if (source.has_null()) {
+    for (size_t i = 0; i < rows.size(); i++) {
+      if (source.is_null(rows[i])) {
+        set_null(static_cast<int>(i));
+      }
+    }
+  }
+}
+
 Value Column::get_value(int index) const
 {
-  if (index >= count_ || index < 0) {
+  const int row = column_type_ == Type::CONSTANT_COLUMN ? 0 : index;
+  if (row >= count_ || row < 0) {
     return Value();
   }
-  return Value(attr_type_, &data_[index * attr_len_], attr_len_);
+
+  if (is_null(row)) {
+    Value value;
+    value.set_type(attr_type_);
+    value.set_null(true);
+    return value;
+  }
+
+  switch (column_type_) {
+    case Type::VARLEN_COLUMN: {
+      string_view str = get_string(row);
+      Value       value;
+      value.set_type(attr_type_);
+      value.set_data(str.empty() ? "" : str.data(), static_cast<int>(str.size()));
+      return value;
+    }
+    case Type::DICTIONARY_COLUMN: {
+      return dictionary_->get_value(reinterpret_cast<const int *>(data_)[row]);
+    }
+    default: {
+      return Value(attr_type_, &data_[row * attr_len_], attr_len_);
+    }
+  }
+}
+
+string_view Column::get_string(int index) const
+{
+  const int row = column_type_ == Type::CONSTANT_COLUMN ? 0 : index;
+  switch (column_type_) {
+    case Type::VARLEN_COLUMN: {
+      const int *offsets = reinterpret_cast<const int *>(data_);
+      return string_view(heap_->data() + offsets[row], offsets[row + 1] - offsets[row]);
+    }
+    case Type::DICTIONARY_COLUMN: {
+      return dictionary_->get_string(reinterpret_cast<const int *>(data_)[row]);
+    }
+    default: {
+      const char *str = data_ + static_cast<size_t>(row) * attr_len_;
+      return string_view(str, strnlen(str, attr_len_));
+    }
+  }
 }
 
 void Column::reference(const Column &column)
@@ -129,4 +366,9 @@ void Column::reference(const Column &column)
   this->column_type_ = column.column_type();
   this->attr_type_   = column.attr_type();
   this->attr_len_    = column.attr_len();
+
+  this->null_bitmap_ = column.null_bitmap_;
+  this->has_null_    = column.has_null_;
+  this->heap_        = column.heap_;
+  this->dictionary_  = column.dictionary_;
 }
\ No newline at end of file
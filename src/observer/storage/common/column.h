@@ -12,19 +12,28 @@ See the Mulan PSL v2 for more details. */
 
 #include <string.h>
 
+#include "common/lang/memory.h"
+#include "common/lang/string_view.h"
+#include "common/lang/vector.h"
 #include "storage/field/field_meta.h"
 
 /**
  * @brief A column contains multiple values in contiguous memory with a specified type.
+ * @details Besides the values, a column may carry a null bitmap. The bitmap is allocated when the first
+ * null is set, so columns without nulls pay nothing for it. Strings can be stored in three ways:
+ * - NORMAL_COLUMN: fixed-length values padded to attr_len, as they are laid out in the pages;
+ * - VARLEN_COLUMN: `count + 1` int offsets in data() and the bytes in a separate heap;
+ * - DICTIONARY_COLUMN: int codes in data() that index into a shared dictionary column.
  */
-// TODO: `Column` currently only support fixed-length type.
 class Column
 {
 public:
   enum class Type
   {
-    NORMAL_COLUMN,   /// Normal column represents a list of fixed-length values
-    CONSTANT_COLUMN  /// Constant column represents a single value
+    NORMAL_COLUMN,      /// Normal column represents a list of fixed-length values
+    CONSTANT_COLUMN,    /// Constant column represents a single value
+    VARLEN_COLUMN,      /// Variable-length values stored as offsets + heap
+    DICTIONARY_COLUMN,  /// Codes referring to the values of a dictionary column
   };
 
   Column()               = default;
@@ -51,11 +60,60 @@ public:
    */
   RC append(char *data, int count);
 
+  /**
+   * @brief 追加一个 NULL
+   * @details 定长列会写入一个全零的值占位
+   */
+  RC append_null();
+
+  /**
+   * @brief 按照变长格式初始化，之后使用 append_string 追加数据
+   * @param attr_len 字符串的最大长度，只作为元信息使用
+   */
+  void init_varlen(AttrType attr_type, int attr_len, size_t capacity = DEFAULT_CAPACITY);
+  RC   append_string(const char *data, int len);
+
+  /**
+   * @brief 按照字典编码初始化，之后使用 append_code 追加编码
+   * @param dictionary 字典中的每个值都是不同的，多个列可以共享同一个字典
+   */
+  void init_dictionary(shared_ptr<Column> dictionary, size_t capacity = DEFAULT_CAPACITY);
+  RC   append_code(int code);
+
+  /**
+   * @brief 按照行号从另一个列中取出一部分行，保留原来的表示方式和 NULL
+   */
+  void gather(const Column &source, const vector<int> &rows);
+
   /**
    * @brief 获取 index 位置的列值
+   * @details 常量列对任意位置都返回同一个值；NULL 返回类型是 attr_type 的 NULL 值
    */
   Value get_value(int index) const;
 
+  /**
+   * @brief 获取 index 位置的字符串，不拷贝数据
+   * @details 定长的字符串会去掉末尾的 '\0'，调用者需要保证不是 NULL
+   */
+  string_view get_string(int index) const;
+
+  bool has_null() const { return has_null_; }
+  bool is_null(int index) const
+  {
+    if (!has_null_) {
+      return false;
+    }
+    const int row = column_type_ == Type::CONSTANT_COLUMN ? 0 : index;
+    return (null_bitmap_[row >> 3] & (1 << (row & 7))) != 0;
+  }
+  /**
+   * @brief 标记 index 位置的值是 NULL，只能修改自己拥有内存的列
+   */
+  void set_null(int index);
+
+  /// 字典编码列的字典
+  const shared_ptr<Column> &dictionary() const { return dictionary_; }
+
   /**
    * @brief 获取列数据的实际大小（字节）
    */
@@ -66,7 +124,7 @@ public:
   /**
    * @brief 重置列数据，但不修改元信息
    */
-  void reset_data() { count_ = 0; }
+  void reset_data();
 
   /**
    * @brief 引用另一个 Column
@@ -85,6 +143,8 @@ public:
 private:
   static constexpr size_t DEFAULT_CAPACITY = 8192;
 
+  void ensure_null_bitmap();
+
   char *data_ = nullptr;
   /// 当前列值数量
   int count_ = 0;
@@ -94,8 +154,16 @@ private:
   bool own_ = true;
   /// 列属性类型
   AttrType attr_type_ = AttrType::UNDEFINED;
-  /// 列属性类型长度（目前只支持定长）
+  /// 列属性类型长度，变长列中是字符串的最大长度
   int attr_len_ = -1;
   /// 列类型
   Type column_type_ = Type::NORMAL_COLUMN;
+
+  /// NULL 位图，第一次设置 NULL 时才申请，和 data_ 一样由 own_ 决定是否拥有
+  char *null_bitmap_ = nullptr;
+  bool  has_null_    = false;
+  /// 变长列的数据，引用这个列的其它列共享同一份数据
+  shared_ptr<vector<char>> heap_;
+  /// 字典编码列的字典
+  shared_ptr<Column> dictionary_;
 };
\ No newline at end of file
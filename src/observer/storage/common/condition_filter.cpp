@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "condition_filter.h"
 #include "common/log/log.h"
 #include "common/value.h"
+#include "sql/expr/expression.h"
 #include "storage/record/record_manager.h"
 #include "storage/table/table.h"
 #include <math.h>
@@ -24,6 +25,72 @@ using namespace common;
 
 ConditionFilter::~ConditionFilter() {}
 
+void ConditionFilter::filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const
+{
+  const PageNum page_num = page_handler.get_page_num();
+  Record        record;
+  size_t        selected = 0;
+  for (SlotNum slot_num : slots) {
+    if (page_handler.get_record(RID(page_num, slot_num), record) == RC::SUCCESS && filter(record)) {
+      slots[selected++] = slot_num;
+    }
+  }
+  slots.resize(selected);
+}
+
+namespace {
+
+/// 与 common::compare_int 和 common::compare_float 的结果一致
+inline int compare_scalar(int left, int right) { return (left > right) - (left < right); }
+inline int compare_scalar(float left, float right)
+{
+  float cmp = left - right;
+  return (cmp > EPSILON) - (cmp < -EPSILON);
+}
+
+/**
+ * @brief 在一列数据上计算 field <op> value，只保留满足条件的槽位
+ * @details 比较运算符在循环外面确定，循环中没有分支，编译器可以展开或者向量化
+ */
+template <typename T, typename Pred>
+void select_slots(const PageFieldView &view, T value, vector<SlotNum> &slots, Pred pred)
+{
+  size_t selected = 0;
+  for (SlotNum slot_num : slots) {
+    slots[selected] = slot_num;
+    selected += pred(compare_scalar(view.get<T>(slot_num), value)) ? 1 : 0;
+  }
+  slots.resize(selected);
+}
+
+template <typename T>
+void select_slots(const PageFieldView &view, T value, CompOp comp_op, vector<SlotNum> &slots)
+{
+  switch (comp_op) {
+    case EQUAL_TO: select_slots(view, value, slots, [](int cmp) { return cmp == 0; }); break;
+    case LESS_EQUAL: select_slots(view, value, slots, [](int cmp) { return cmp <= 0; }); break;
+    case NOT_EQUAL: select_slots(view, value, slots, [](int cmp) { return cmp != 0; }); break;
+    case LESS_THAN: select_slots(view, value, slots, [](int cmp) { return cmp < 0; }); break;
+    case GREAT_EQUAL: select_slots(view, value, slots, [](int cmp) { return cmp >= 0; }); break;
+    case GREAT_THAN: select_slots(view, value, slots, [](int cmp) { return cmp > 0; }); break;
+    default: break;
+  }
+}
+
+/// 交换比较的两边时对应的运算符，比如 1 < a 等价于 a > 1
+CompOp swap_comp_op(CompOp comp_op)
+{
+  switch (comp_op) {
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case LESS_THAN: return GREAT_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    default: return comp_op;
+  }
+}
+
+}  // namespace
+
 DefaultConditionFilter::DefaultConditionFilter()
 {
   left_.is_attr     = false;
@@ -73,6 +140,7 @@ RC DefaultConditionFilter::init(Table &table, const ConditionSqlNode &condition)
     }
     left.attr_length = field_left->len();
     left.attr_offset = field_left->offset();
+    left.attr_index  = static_cast<int>(field_left - table_meta.field(0));
 
     type_left = field_left->type();
   } else {
@@ -93,6 +161,7 @@ RC DefaultConditionFilter::init(Table &table, const ConditionSqlNode &condition)
     }
     right.attr_length = field_right->len();
     right.attr_offset = field_right->offset();
+    right.attr_index  = static_cast<int>(field_right - table_meta.field(0));
     type_right        = field_right->type();
   } else {
     right.is_attr = false;
@@ -153,6 +222,38 @@ bool DefaultConditionFilter::filter(const Record &rec) const
   return cmp_result;  // should not go here
 }
 
+void DefaultConditionFilter::filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const
+{
+  const ConDesc *attr    = nullptr;
+  const ConDesc *value   = nullptr;
+  CompOp         comp_op = comp_op_;
+  if (left_.is_attr && !right_.is_attr) {
+    attr  = &left_;
+    value = &right_;
+  } else if (!left_.is_attr && right_.is_attr) {
+    attr    = &right_;
+    value   = &left_;
+    comp_op = swap_comp_op(comp_op_);
+  }
+
+  PageFieldView view;
+  if (attr != nullptr && attr->attr_index >= 0 && comp_op <= GREAT_THAN && !value->value.is_null()) {
+    view = page_handler.field_view(attr->attr_index, attr->attr_offset);
+  }
+  if (view.data == nullptr) {
+    ConditionFilter::filter_page(page_handler, slots);
+    return;
+  }
+
+  if (attr_type_ == AttrType::INTS && attr->attr_length == sizeof(int)) {
+    select_slots(view, value->value.get_int(), comp_op, slots);
+  } else if (attr_type_ == AttrType::FLOATS && attr->attr_length == sizeof(float)) {
+    select_slots(view, value->value.get_float(), comp_op, slots);
+  } else {
+    ConditionFilter::filter_page(page_handler, slots);
+  }
+}
+
 CompositeConditionFilter::~CompositeConditionFilter()
 {
   if (memory_owner_) {
@@ -211,3 +312,115 @@ bool CompositeConditionFilter::filter(const Record &rec) const
   }
   return true;
 }
+
+void CompositeConditionFilter::filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const
+{
+  for (int i = 0; i < filter_num_ && !slots.empty(); i++) {
+    filters_[i]->filter_page(page_handler, slots);
+  }
+}
+
+RC ScanConditionFilter::init(
+    const Table &table, const char *table_alias, Expression *predicate, vector<Expression *> &residual)
+{
+  filters_.clear();
+  residual.clear();
+  if (predicate == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  // AND 连接的条件拆开，能下推的下推，其它的留给算子计算
+  vector<Expression *> exprs{predicate};
+  while (!exprs.empty()) {
+    Expression *expr = exprs.back();
+    exprs.pop_back();
+    if (expr->type() == ExprType::CONJUNCTION &&
+        static_cast<ConjunctionExpr *>(expr)->conjunction_type() == ConjunctionExpr::Type::AND) {
+      auto *conjunction = static_cast<ConjunctionExpr *>(expr);
+      exprs.push_back(conjunction->right().get());
+      exprs.push_back(conjunction->left().get());
+      continue;
+    }
+
+    if (!try_push_down(table, table_alias, expr)) {
+      residual.push_back(expr);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+bool ScanConditionFilter::try_push_down(const Table &table, const char *table_alias, Expression *expr)
+{
+  if (expr->type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto  *comparison = static_cast<ComparisonExpr *>(expr);
+  CompOp comp_op    = comparison->comp();
+  if (comp_op > GREAT_THAN) {
+    return false;
+  }
+
+  Expression *left  = comparison->left().get();
+  Expression *right = comparison->right().get();
+  if (left->type() == ExprType::VALUE && right->type() == ExprType::TABLE_FIELD) {
+    std::swap(left, right);
+    comp_op = swap_comp_op(comp_op);
+  }
+  if (left->type() != ExprType::TABLE_FIELD || right->type() != ExprType::VALUE) {
+    return false;
+  }
+
+  auto *field_expr = static_cast<TableFieldExpr *>(left);
+  auto *value_expr = static_cast<ValueExpr *>(right);
+
+  const FieldMeta *field_meta = field_expr->field().meta();
+  const Value     &value      = value_expr->get_value();
+  if (field_expr->field().table() != &table || 0 != strcmp(field_expr->table_alias_name(), table_alias) ||
+      field_meta->nullable() || value.is_null() || field_meta->type() != value.attr_type() ||
+      (field_meta->type() != AttrType::INTS && field_meta->type() != AttrType::FLOATS)) {
+    return false;
+  }
+
+  const TableMeta &table_meta = table.table_meta();
+  const FieldMeta *table_field = table_meta.field(field_meta->name());
+  if (table_field == nullptr) {
+    return false;
+  }
+
+  ConDesc attr;
+  attr.is_attr     = true;
+  attr.attr_length = table_field->len();
+  attr.attr_offset = table_field->offset();
+  attr.attr_index  = static_cast<int>(table_field - table_meta.field(0));
+
+  ConDesc constant;
+  constant.is_attr     = false;
+  constant.attr_length = 0;
+  constant.attr_offset = 0;
+  constant.value       = value;
+
+  auto filter = make_unique<DefaultConditionFilter>();
+  if (OB_FAIL(filter->init(attr, constant, field_meta->type(), comp_op))) {
+    return false;
+  }
+  filters_.push_back(std::move(filter));
+  return true;
+}
+
+bool ScanConditionFilter::filter(const Record &rec) const
+{
+  for (const auto &filter : filters_) {
+    if (!filter->filter(rec)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ScanConditionFilter::filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const
+{
+  for (size_t i = 0; i < filters_.size() && !slots.empty(); i++) {
+    filters_[i]->filter_page(page_handler, slots);
+  }
+}
@@ -14,17 +14,23 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/memory.h"
+#include "common/lang/vector.h"
+#include "common/types.h"
 #include "sql/parser/parse.h"
 
+class Expression;
 class Record;
+class RecordPageHandler;
 class Table;
 
 struct ConDesc
 {
-  bool  is_attr;      // 是否属性，false 表示是值
-  int   attr_length;  // 如果是属性，表示属性值长度
-  int   attr_offset;  // 如果是属性，表示在记录中的偏移量
-  Value value;        // 如果是值类型，这里记录值的数据
+  bool  is_attr;          // 是否属性，false 表示是值
+  int   attr_length;      // 如果是属性，表示属性值长度
+  int   attr_offset;      // 如果是属性，表示在记录中的偏移量
+  int   attr_index = -1;  // 如果是属性，表示是表中的第几个字段，-1 表示不知道，不能在页面上按列比较
+  Value value;            // 如果是值类型，这里记录值的数据
 };
 
 class ConditionFilter
@@ -38,6 +44,13 @@ public:
    * @return true means match condition, false means failed to match.
    */
   virtual bool filter(const Record &rec) const = 0;
+
+  /**
+   * @brief 过滤一个页面上的记录
+   * @details 扫描时每个页面调用一次。默认逐条取出记录调用 filter，子类可以直接在页面数据上按列批量比较
+   * @param slots 输入是要过滤的槽位，返回时只保留满足条件的槽位
+   */
+  virtual void filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const;
 };
 
 class DefaultConditionFilter : public ConditionFilter
@@ -51,6 +64,11 @@ public:
 
   virtual bool filter(const Record &rec) const;
 
+  /**
+   * @brief 字段和整数或浮点数常量比较时，在页面上按列批量比较，其它情况逐条过滤
+   */
+  virtual void filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const;
+
 public:
   const ConDesc &left() const { return left_; }
   const ConDesc &right() const { return right_; }
@@ -75,6 +93,7 @@ public:
   RC init(Table &table, const ConditionSqlNode *conditions, int condition_num);
 
   virtual bool filter(const Record &rec) const;
+  virtual void filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const;
 
 public:
   int                    filter_num() const { return filter_num_; }
@@ -88,3 +107,35 @@ private:
   int                     filter_num_   = 0;
   bool                    memory_owner_ = false;  // filters_的内存是否由自己来控制
 };
+
+/**
+ * @brief 表扫描时下推到存储层的过滤条件
+ * @details 从扫描算子的过滤条件中挑出 AND 连接的简单比较：不能为NULL的整数或浮点数字段，与相同类型的常量比较。
+ * 存储层扫描页面时按列批量计算这些条件，其它条件还是由算子逐行计算。
+ */
+class ScanConditionFilter : public ConditionFilter
+{
+public:
+  ScanConditionFilter()          = default;
+  virtual ~ScanConditionFilter() = default;
+
+  /**
+   * @param table       扫描的表
+   * @param table_alias 扫描算子中表的别名，只下推引用这个别名的字段
+   * @param predicate   扫描算子的过滤条件，可以是空指针
+   * @param residual    返回不能下推的条件，指向 predicate 中的表达式
+   */
+  RC init(const Table &table, const char *table_alias, Expression *predicate, vector<Expression *> &residual);
+
+  /// 没有任何条件下推
+  bool empty() const { return filters_.empty(); }
+
+  virtual bool filter(const Record &rec) const;
+  virtual void filter_page(RecordPageHandler &page_handler, vector<SlotNum> &slots) const;
+
+private:
+  bool try_push_down(const Table &table, const char *table_alias, Expression *expr);
+
+private:
+  vector<unique_ptr<DefaultConditionFilter>> filters_;
+};
@@ -21,6 +21,7 @@ static constexpr const char *TABLE_META_FILE_PATTERN = ".*\\.table$";
 static constexpr const char *TABLE_DATA_SUFFIX       = ".data";
 static constexpr const char *TABLE_INDEX_SUFFIX      = ".index";
 static constexpr const char *TABLE_LOB_SUFFIX        = ".lob";
+static constexpr const char *TABLE_STATS_SUFFIX      = ".stats";
 static constexpr const char *VIEW_SUFFIX             = ".view";
 static constexpr const char *VIEW_FILE_PATTERN       = ".*\\.view$";
 
@@ -29,4 +30,5 @@ string table_meta_file(const char *base_dir, const char *table_name);
 string table_data_file(const char *base_dir, const char *table_name);
 string table_index_file(const char *base_dir, const char *table_name, const char *index_name);
 string table_lob_file(const char *base_dir, const char *table_name);
+string table_stats_file(const char *base_dir, const char *table_name);
 string view_file(const char *base_dir, const char *view_name);
@@ -17,10 +17,12 @@ See the Mulan PSL v2 for more details. */
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#include "common/lang/algorithm.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/os/path.h"
 #include "common/global_context.h"
+#include "catalog/catalog.h"
 #include "storage/common/meta_util.h"
 #include "storage/table/table.h"
 #include "storage/table/table_meta.h"
@@ -32,6 +34,15 @@ using namespace common;
 
 Db::~Db()
 {
+  // page cleaner 会访问表的buffer pool，最先停止
+  if (page_cleaner_) {
+    page_cleaner_->stop();
+    page_cleaner_.reset();
+  }
+
+  // 缓存的执行计划引用了表对象，需要先释放
+  plan_cache_.reset();
+
   for (auto &iter : opened_tables_) {
     delete iter.second;
   }
@@ -68,6 +79,9 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return RC::INVALID_ARGUMENT;
   }
 
+  plan_cache_  = make_unique<PlanCache>();
+  query_cache_ = make_unique<QueryCache>();
+
   oceanbase::ObLsmOptions options;
   filesystem::path        lsm_path = filesystem::path(dbpath) / "lsm";
   filesystem::create_directory(lsm_path);
@@ -159,6 +173,17 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return rc;
   }
 
+  page_cleaner_ = make_unique<PageCleaner>();
+  rc            = page_cleaner_->init(*buffer_pool_manager_, *log_handler_, check_point_lsn_,
+      [this](LSN &check_point_lsn) { return this->checkpoint(check_point_lsn); });
+  if (OB_SUCC(rc)) {
+    rc = page_cleaner_->start();
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to start page cleaner. dbpath=%s, rc=%s", dbpath, strrc(rc));
+    return rc;
+  }
+
   return rc;
 }
 
@@ -254,16 +279,19 @@ RC Db::drop_table(const char *table_name)
 {
   if (opened_tables_.contains(table_name)) {
     Table *table = opened_tables_.at(table_name);
+    Catalog::get_instance().remove_table_stats(table->table_id());
     delete table;
     opened_tables_.erase(table_name);
 
-    string meta_file = table_meta_file(path_.c_str(), table_name);
-    string data_file = table_data_file(path_.c_str(), table_name);
-    string lob_file  = table_lob_file(path_.c_str(), table_name);
+    string meta_file  = table_meta_file(path_.c_str(), table_name);
+    string data_file  = table_data_file(path_.c_str(), table_name);
+    string lob_file   = table_lob_file(path_.c_str(), table_name);
+    string stats_file = table_stats_file(path_.c_str(), table_name);
 
     filesystem::remove(meta_file);
     filesystem::remove(data_file);
     filesystem::remove(lob_file);
+    filesystem::remove(stats_file);
 
     return RC::SUCCESS;
   }
@@ -322,6 +350,13 @@ RC Db::open_all_tables()
     if (table->table_id() >= next_table_id_) {
       next_table_id_ = table->table_id() + 1;
     }
+
+    // 统计信息只影响执行计划的选择，读不出来的时候不影响表的使用
+    string stats_file = table_stats_file(path_.c_str(), table->name());
+    if (OB_FAIL(rc = Catalog::get_instance().load_table_stats(table->table_id(), stats_file))) {
+      LOG_WARN("Failed to load table stats, ignore it. file=%s, rc=%s", stats_file.c_str(), strrc(rc));
+      rc = RC::SUCCESS;
+    }
     opened_tables_[table->name()] = table;
     LOG_INFO("Open table: %s, file: %s", table->name(), filename.c_str());
   }
@@ -395,14 +430,57 @@ RC Db::sync()
     return rc;
   }
 
+  lock_guard<mutex> guard(check_point_lock_);
   check_point_lsn_ = current_lsn;
   rc               = flush_meta();
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to flush meta. db=%s, rc=%d:%s", name_.c_str(), rc, strrc(rc));
     return rc;
   }
+
+  rc = log_handler_->recycle(check_point_lsn_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to recycle clog files. db=%s, rc=%s", name_.c_str(), strrc(rc));
+  }
   LOG_INFO("Successfully sync db. db=%s", name_.c_str());
-  return rc;
+  return RC::SUCCESS;
+}
+
+RC Db::checkpoint(LSN &check_point_lsn)
+{
+  lock_guard<mutex> guard(check_point_lock_);
+
+  LSN lsn = min(check_point_lsn, trx_kit_->min_active_lsn());
+  if (lsn <= check_point_lsn_) {
+    check_point_lsn = check_point_lsn_;
+    return RC::SUCCESS;
+  }
+
+  // 刷新到double write buffer中的页面，要先真正写到数据文件中
+  auto dblwr_buffer = static_cast<DiskDoubleWriteBuffer *>(buffer_pool_manager_->get_dblwr_buffer());
+  RC   rc           = dblwr_buffer->flush_page();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to flush double write buffer. db=%s, rc=%s", name_.c_str(), strrc(rc));
+    return rc;
+  }
+
+  LSN old_lsn      = check_point_lsn_;
+  check_point_lsn_ = lsn;
+  rc               = flush_meta();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to flush meta. db=%s, rc=%s", name_.c_str(), strrc(rc));
+    check_point_lsn_ = old_lsn;
+    return rc;
+  }
+
+  rc = log_handler_->recycle(check_point_lsn_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to recycle clog files. db=%s, rc=%s", name_.c_str(), strrc(rc));
+  }
+
+  LOG_DEBUG("check point advanced. db=%s, lsn=%ld", name_.c_str(), check_point_lsn_);
+  check_point_lsn = check_point_lsn_;
+  return RC::SUCCESS;
 }
 
 RC Db::recover()
@@ -468,10 +546,18 @@ RC Db::init_meta()
       return RC::IOERR_TOO_LONG;
     }
 
-    buffer[n]        = '\0';
-    check_point_lsn_ = atoll(buffer);  // 当前元数据就这一个数字
-    LOG_INFO("Successfully read db meta file. db=%s, file=%s, check_point_lsn=%ld", 
-             name_.c_str(), db_meta_file_path.c_str(), check_point_lsn_);
+    buffer[n] = '\0';
+
+    // 元数据格式: "检查点LSN 已分配的最大事务ID"，旧版本的元数据中只有检查点
+    char   *end        = nullptr;
+    int32_t max_trx_id = 0;
+    check_point_lsn_   = strtoll(buffer, &end, 10);
+    if (end != nullptr && *end != '\0') {
+      max_trx_id = static_cast<int32_t>(strtol(end, nullptr, 10));
+    }
+    trx_kit_->init_trx_id(max_trx_id);
+    LOG_INFO("Successfully read db meta file. db=%s, file=%s, check_point_lsn=%ld, max trx id=%d", 
+             name_.c_str(), db_meta_file_path.c_str(), check_point_lsn_, max_trx_id);
   }
   close(fd);
 
@@ -496,7 +582,9 @@ RC Db::flush_meta()
     return RC::IOERR_WRITE;
   }
 
-  string buffer = to_string(check_point_lsn_);
+  // 检查点之前的页面都已经落盘，里面用到的事务ID都不会超过当前分配出去的最大事务ID
+  const int32_t max_trx_id = trx_kit_->current_trx_id();
+  string        buffer     = to_string(check_point_lsn_) + " " + to_string(max_trx_id);
   int    n      = write(fd, buffer.c_str(), buffer.size());
   if (n < 0) {
     LOG_ERROR("Failed to write db meta file. db=%s, file=%s, errno=%s", 
@@ -515,8 +603,8 @@ RC Db::flush_meta()
       rc = RC::IOERR_WRITE;
     } else {
 
-      LOG_INFO("Successfully write db meta file. db=%s, file=%s, check_point_lsn=%ld", 
-               name_.c_str(), temp_meta_file_path.c_str(), check_point_lsn_);
+      LOG_INFO("Successfully write db meta file. db=%s, file=%s, check_point_lsn=%ld, max trx id=%d", 
+               name_.c_str(), temp_meta_file_path.c_str(), check_point_lsn_, max_trx_id);
     }
   }
 
@@ -538,3 +626,5 @@ RC Db::init_dblwr_buffer()
 LogHandler        &Db::log_handler() { return *log_handler_; }
 BufferPoolManager &Db::buffer_pool_manager() { return *buffer_pool_manager_; }
 TrxKit            &Db::trx_kit() { return *trx_kit_; }
+PlanCache         &Db::plan_cache() { return *plan_cache_; }
+QueryCache        &Db::query_cache() { return *query_cache_; }
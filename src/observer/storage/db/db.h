@@ -19,9 +19,13 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/lang/unordered_map.h"
 #include "common/lang/memory.h"
+#include "common/lang/mutex.h"
 #include "common/lang/span.h"
 #include "sql/parser/parse_defs.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/query_cache/query_cache.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/page_cleaner.h"
 #include "storage/clog/disk_log_handler.h"
 #include "storage/buffer/double_write_buffer.h"
 #include "oblsm/include/ob_lsm.h"
@@ -118,6 +122,17 @@ public:
    */
   RC sync();
 
+  /**
+   * @brief 推进检查点，page cleaner 在后台调用
+   * @details 检查点不会超过活跃事务的第一条日志，也不会后退。会先把double write buffer中的页面写入
+   * 数据文件，再持久化检查点，然后回收检查点之前的日志文件。
+   * @param[in,out] check_point_lsn 传入buffer pool允许的检查点，返回真正生效的检查点
+   */
+  RC checkpoint(LSN &check_point_lsn);
+
+  /// @brief 当前的检查点LSN，回放日志时从这里开始
+  LSN check_point_lsn() const { return check_point_lsn_; }
+
   /// @brief 获取当前数据库的日志处理器
   LogHandler &log_handler();
 
@@ -127,6 +142,12 @@ public:
   /// @brief 获取当前数据库的事务管理器
   TrxKit &trx_kit();
 
+  /// @brief 获取当前数据库的执行计划缓存
+  PlanCache &plan_cache();
+
+  /// @brief 获取当前数据库的查询结果缓存
+  QueryCache &query_cache();
+
   string path() const { return path_; }
 
   oceanbase::ObLsm *lsm() { return lsm_; }
@@ -171,12 +192,16 @@ private:
   unordered_map<string, View*>   opened_views_;         ///< 当前所有打开的视图
   unique_ptr<BufferPoolManager>  buffer_pool_manager_;  ///< 当前数据库的buffer pool管理器
   unique_ptr<LogHandler>         log_handler_;          ///< 当前数据库的日志处理器
+  unique_ptr<PageCleaner>        page_cleaner_;         ///< 后台刷脏页并推进检查点
   unique_ptr<TrxKit>             trx_kit_;              ///< 当前数据库的事务管理器
+  unique_ptr<PlanCache>          plan_cache_;           ///< 当前数据库的执行计划缓存
+  unique_ptr<QueryCache>         query_cache_;          ///< 当前数据库的查询结果缓存
   oceanbase::ObLsm              *lsm_;                  ///< 当前数据库的 LSM-Tree 存储引擎
 
   /// 给每个table都分配一个ID，用来记录日志。这里假设所有的DDL都不会并发操作，所以相关的数据都不上锁
   int32_t next_table_id_ = 0;
 
   LSN    check_point_lsn_ = 0;  ///< 当前数据库的检查点LSN。会记录到磁盘中。
+  mutex  check_point_lock_;     ///< sync和page cleaner都会修改检查点
   string storage_engine_;
 };
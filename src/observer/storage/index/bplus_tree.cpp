@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/index/bplus_tree.h"
 #include "common/lang/lower_bound.h"
+#include "common/lang/thread.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
 #include "sql/parser/parse_defs.h"
@@ -1247,6 +1248,19 @@ RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTree
 {
   LatchMemo &latch_memo = mtr.latch_memo();
 
+  if (op == BplusTreeOperationType::READ) {
+    // 只读操作先尝试乐观锁，冲突太多时再退回到加锁的方式
+    const int max_optimistic_retry = 8;
+    for (int i = 0; i < max_optimistic_retry; i++) {
+      RC rc = find_leaf_optimistic(mtr, child_page_getter, frame);
+      if (rc != RC::LOCKED_CONCURRENCY_CONFLICT) {
+        return rc;
+      }
+      this_thread::yield();
+    }
+    LOG_DEBUG("too many conflicts while finding leaf optimistically, fallback to crabing protocol");
+  }
+
   // root locked
   if (op != BplusTreeOperationType::READ) {
     latch_memo.xlatch(&root_lock_);
@@ -1280,6 +1294,85 @@ RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTree
   return RC::SUCCESS;
 }
 
+RC BplusTreeHandler::find_leaf_optimistic(BplusTreeMiniTransaction &mtr,
+    const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame)
+{
+  LatchMemo &latch_memo = mtr.latch_memo();
+
+  auto restart = [&latch_memo, &frame]() {
+    latch_memo.release_to(latch_memo.memo_point());
+    frame = nullptr;
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  };
+
+  // 根节点的编号可能会变，拿到根节点的版本号之后就可以释放root锁了
+  latch_memo.slatch(&root_lock_);
+  if (is_empty()) {
+    return RC::EMPTY;
+  }
+
+  int memo_point = latch_memo.memo_point();
+  RC  rc         = latch_memo.get_page(file_header_.root_page, frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to fetch root page. page id=%d, rc=%d:%s", file_header_.root_page, rc, strrc(rc));
+    return rc;
+  }
+
+  uint64_t version = 0;
+  if (!frame->optimistic_latch(version)) {
+    return restart();
+  }
+  latch_memo.release_to(memo_point);
+
+  while (true) {
+    const bool is_leaf = reinterpret_cast<const IndexNode *>(frame->data())->is_leaf;
+    if (!frame->validate_latch(version)) {
+      return restart();
+    }
+
+    if (is_leaf) {
+      // 加上读锁之后版本号还没有变，说明叶子节点和从父节点找到它的时候一样
+      latch_memo.slatch(frame);
+      if (!frame->validate_latch(version)) {
+        return restart();
+      }
+      return RC::SUCCESS;
+    }
+
+    // 页面内容可能正在被修改，先检查大小，防止读到页面外面去
+    InternalIndexNodeHandler internal_node(mtr, file_header_, frame);
+    const int                size = internal_node.size();
+    if (size < 0 || size > file_header_.internal_max_size) {
+      return restart();
+    }
+
+    const PageNum child_page_num = child_page_getter(internal_node);
+    if (!frame->validate_latch(version)) {
+      return restart();
+    }
+
+    Frame *child_frame = nullptr;
+    memo_point         = latch_memo.memo_point();
+    rc                 = latch_memo.get_page(child_page_num, child_frame);
+    if (OB_FAIL(rc)) {
+      if (!frame->validate_latch(version)) {
+        return restart();
+      }
+      LOG_WARN("Failed to load page page_num:%d. rc=%s", child_page_num, strrc(rc));
+      return rc;
+    }
+
+    uint64_t child_version = 0;
+    if (!child_frame->optimistic_latch(child_version) || !frame->validate_latch(version)) {
+      return restart();
+    }
+
+    latch_memo.release_to(memo_point);
+    frame   = child_frame;
+    version = child_version;
+  }
+}
+
 RC BplusTreeHandler::crabing_protocal_fetch_page(
     BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, PageNum page_num, bool is_root_node, Frame *&frame)
 {
@@ -20,6 +20,7 @@ See the Mulan PSL v2 for more details. */
 #include <string.h>
 
 #include "common/config.h"
+#include "common/defs.h"
 #include "common/lang/comparator.h"
 #include "common/lang/memory.h"
 #include "common/lang/sstream.h"
@@ -62,6 +63,9 @@ struct IndexKeyFieldMeta
 /**
  * @brief 属性比较(BplusTree)
  * @ingroup BPlusTree
+ * @details 直接比较索引键中的原始数据，不再为每个字段构造Value对象。
+ * 每个字段的比较函数在init时按照字段类型选好，只比较一个字段时使用按类型特化的版本。
+ * NULL 的处理与之前保持一致：左边为NULL时认为左边小，否则右边为NULL时认为右边小。
  */
 class AttrComparator
 {
@@ -70,11 +74,17 @@ public:
   {
     for (int32_t i = 0; i < attr_cnt; ++i) {
       attr_infos_.push_back(attr_infos[i]);
+      column_compare_funcs_.push_back(column_compare_func(attr_infos[i].attr_type_));
     }
     comp_column_cnt_ = (comp_cnt == -1 ? attr_cnt : comp_cnt);
+    update_compare_func();
   }
 
-  void set_comp_column_cnt(int cnt) { comp_column_cnt_ = cnt; }
+  void set_comp_column_cnt(int cnt)
+  {
+    comp_column_cnt_ = cnt;
+    update_compare_func();
+  }
 
   int get_comp_column_cnt() { return comp_column_cnt_; }
 
@@ -87,57 +97,116 @@ public:
     return ret;
   }
 
-  int operator()(const char *v1, const char *v2) const
+  int operator()(const char *v1, const char *v2) const { return compare_func_(*this, v1, v2); }
+
+private:
+  using CompareFunc       = int (*)(const AttrComparator &comparator, const char *v1, const char *v2);
+  using ColumnCompareFunc = int (*)(const char *v1, const char *v2, const IndexKeyFieldMeta &attr_info);
+
+  static bool is_null(const char *key, int index) { return (key[index / 8] & (1 << (index % 8))) != 0; }
+
+  /**
+   * @brief 比较一个字段的原始数据，不处理NULL
+   * @details 比较结果与对应类型的 DataType::compare 一致
+   */
+  template <AttrType TYPE>
+  static int compare_column(const char *v1, const char *v2, const IndexKeyFieldMeta &attr_info)
+  {
+    if constexpr (TYPE == AttrType::INTS || TYPE == AttrType::DATES) {
+      // 日期按照 year << 16 | month << 8 | day 编码，可以直接按照整数比较
+      int32_t left  = 0;
+      int32_t right = 0;
+      memcpy(&left, v1, sizeof(left));
+      memcpy(&right, v2, sizeof(right));
+      return left < right ? -1 : (left > right ? 1 : 0);
+    } else if constexpr (TYPE == AttrType::FLOATS) {
+      float left  = 0;
+      float right = 0;
+      memcpy(&left, v1, sizeof(left));
+      memcpy(&right, v2, sizeof(right));
+      const float cmp = left - right;
+      return cmp > EPSILON ? 1 : (cmp < -EPSILON ? -1 : 0);
+    } else if constexpr (TYPE == AttrType::CHARS) {
+      // 字符串要么以'\0'结尾，要么占满整个字段，strncmp 的结果与 common::compare_string 一致
+      const int result = strncmp(v1, v2, attr_info.attr_len_);
+      return result < 0 ? -1 : (result > 0 ? 1 : 0);
+    } else {
+      Value left;
+      Value right;
+      left.set_type(attr_info.attr_type_);
+      left.set_data(v1, attr_info.attr_len_);
+      right.set_type(attr_info.attr_type_);
+      right.set_data(v2, attr_info.attr_len_);
+      return left.compare(right);
+    }
+  }
+
+  static ColumnCompareFunc column_compare_func(AttrType attr_type)
+  {
+    switch (attr_type) {
+      case AttrType::INTS: return compare_column<AttrType::INTS>;
+      case AttrType::DATES: return compare_column<AttrType::DATES>;
+      case AttrType::FLOATS: return compare_column<AttrType::FLOATS>;
+      case AttrType::CHARS: return compare_column<AttrType::CHARS>;
+      default: return compare_column<AttrType::UNDEFINED>;  // 其他类型仍然通过Value比较
+    }
+  }
+
+  template <AttrType TYPE>
+  static int compare_single_column(const AttrComparator &comparator, const char *v1, const char *v2)
   {
-    common::Bitmap v1_null_bitmap{const_cast<char *>(v1), INDEX_NULL_BITMAP_LENGTH};
-    common::Bitmap v2_null_bitmap{const_cast<char *>(v2), INDEX_NULL_BITMAP_LENGTH};
-
-    auto get_value =
-        [](common::Bitmap &null_bitmap, const char *data, const IndexKeyFieldMeta &attr_info, int index) -> Value {
-      Value val;
-      val.set_type(attr_info.attr_type_);
-      val.set_data(data + attr_info.attr_offset_, attr_info.attr_len_);
-      val.set_null(null_bitmap.get_bit(index));
-      return val;
-    };
-
-    for (int i = 0; i < comp_column_cnt_; ++i) {
-      const IndexKeyFieldMeta &attr_info = attr_infos_.at(i);
-      Value                  left      = get_value(v1_null_bitmap, v1, attr_info, i);
-      Value                  right     = get_value(v2_null_bitmap, v2, attr_info, i);
-
-      if (left.is_null()) {
+    if (is_null(v1, 0)) {
+      return -1;
+    }
+    if (is_null(v2, 0)) {
+      return 1;
+    }
+
+    const IndexKeyFieldMeta &attr_info = comparator.attr_infos_[0];
+    return compare_column<TYPE>(v1 + attr_info.attr_offset_, v2 + attr_info.attr_offset_, attr_info);
+  }
+
+  static int compare_columns(const AttrComparator &comparator, const char *v1, const char *v2)
+  {
+    for (int i = 0; i < comparator.comp_column_cnt_; ++i) {
+      if (is_null(v1, i)) {
         return -1;
       }
-      if (right.is_null()) {
+      if (is_null(v2, i)) {
         return 1;
       }
 
-      int result = left.compare(right);
-      if (result == 0) {
-        continue;
+      const IndexKeyFieldMeta &attr_info = comparator.attr_infos_[i];
+      const int                result    = comparator.column_compare_funcs_[i](
+          v1 + attr_info.attr_offset_, v2 + attr_info.attr_offset_, attr_info);
+      if (result != 0) {
+        return result;
       }
-      return result;
     }
-    /*     for (const auto& attr_info: attr_infos_) {
-     *       Value left;
-     *       left.set_type(attr_info.attr_type_);
-     *       left.set_data(v1 + attr_info.attr_offset_, attr_info.attr_len_);
-     *       Value right;
-     *       right.set_type(attr_info.attr_type_);
-     *       right.set_data(v1 + attr_info.attr_offset_, attr_info.attr_len_);
-     *
-     *       auto result = DataType::type_instance(attr_info.attr_type_)->compare(left, right);
-     *       if (result != 0) {
-     *         return result;
-     *       }
-     *     } */
     return 0;
   }
 
+  void update_compare_func()
+  {
+    compare_func_ = compare_columns;
+    if (comp_column_cnt_ != 1 || attr_infos_.empty()) {
+      return;
+    }
+
+    switch (attr_infos_[0].attr_type_) {
+      case AttrType::INTS: compare_func_ = compare_single_column<AttrType::INTS>; break;
+      case AttrType::DATES: compare_func_ = compare_single_column<AttrType::DATES>; break;
+      case AttrType::FLOATS: compare_func_ = compare_single_column<AttrType::FLOATS>; break;
+      case AttrType::CHARS: compare_func_ = compare_single_column<AttrType::CHARS>; break;
+      default: break;
+    }
+  }
+
 private:
   vector<IndexKeyFieldMeta> attr_infos_;
-  int                     comp_column_cnt_;
+  vector<ColumnCompareFunc> column_compare_funcs_;  ///< 每个字段的比较函数，与attr_infos_一一对应
+  int                       comp_column_cnt_ = 0;
+  CompareFunc               compare_func_    = compare_columns;
 };
 
 /**
@@ -684,6 +753,15 @@ protected:
   RC find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
       const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
 
+  /**
+   * @brief 使用乐观锁(optimistic lock coupling)查找叶子节点，只用于只读操作
+   * @details 中间节点只pin住，不加锁，读完之后校验版本号；到达叶子节点后才加读锁。
+   * 读取子节点之后要再校验一次父节点，保证子节点确实是从当前的父节点找到的。
+   * @return 版本号校验失败时返回 LOCKED_CONCURRENCY_CONFLICT，这时已经释放了所有资源，可以重新开始
+   */
+  RC find_leaf_optimistic(BplusTreeMiniTransaction &mtr,
+      const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
+
   /**
    * @brief 使用crabing protocol 获取页面
    */
@@ -18,7 +18,7 @@ RC HeapRecordScanner::open_scan()
   ASSERT(disk_buffer_pool_ != nullptr, "disk buffer pool is null");
   ASSERT(log_handler_ != nullptr, "log handler is null");
 
-  RC rc = bp_iterator_.init(*disk_buffer_pool_, 1);
+  RC rc = bp_iterator_.init(*disk_buffer_pool_, 1, true /*prefetch*/);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -35,39 +35,35 @@ RC HeapRecordScanner::open_scan()
 /**
  * @brief 从当前位置开始找到下一条有效的记录
  *
- * 如果当前页面还有记录没有访问，就遍历当前的页面。
- * 当前页面遍历完了，就遍历下一个页面，然后找到有效的记录
+ * 如果当前页面还有选出来的记录没有返回，就返回下一条。
+ * 当前页面返回完了，就打开下一个页面，批量选出满足条件的记录
  */
 RC HeapRecordScanner::fetch_next_record()
 {
   RC rc = RC::SUCCESS;
-  if (record_page_iterator_.is_valid()) {
-    // 当前页面还是有效的，尝试看一下是否有有效记录
-    rc = fetch_next_record_in_page();
-    if (rc == RC::SUCCESS || rc != RC::RECORD_EOF) {
-      // 有有效记录：RC::SUCCESS
-      // 或者出现了错误，rc != (RC::SUCCESS or RC::RECORD_EOF)
-      // RECORD_EOF 表示当前页面已经遍历完了
+  while (true) {
+    if (slot_index_ < slots_.size()) {
+      const RID rid(record_page_handler_->get_page_num(), slots_[slot_index_++]);
+      rc = record_page_handler_->get_record(rid, next_record_);
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("failed to get record from page. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+      }
       return rc;
     }
-  }
 
-  // 上个页面遍历完了，或者还没有开始遍历某个页面，那么就从一个新的页面开始遍历查找
-  while (bp_iterator_.has_next()) {
-    PageNum page_num = bp_iterator_.next();
-    record_page_handler_->cleanup();
-    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
-    if (OB_FAIL(rc)) {
-      LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
+    // 冲突之前的可见记录都返回了，再把冲突返回给调用者
+    if (OB_FAIL(pending_rc_)) {
+      rc          = pending_rc_;
+      pending_rc_ = RC::SUCCESS;
       return rc;
     }
 
-    record_page_iterator_.init(record_page_handler_);
-    rc = fetch_next_record_in_page();
-    if (rc == RC::SUCCESS || rc != RC::RECORD_EOF) {
-      // 有有效记录：RC::SUCCESS
-      // 或者出现了错误，rc != (RC::SUCCESS or RC::RECORD_EOF)
-      // RECORD_EOF 表示当前页面已经遍历完了
+    if (!bp_iterator_.has_next()) {
+      break;
+    }
+
+    rc = select_records_in_page(bp_iterator_.next());
+    if (OB_FAIL(rc)) {
       return rc;
     }
   }
@@ -78,43 +74,37 @@ RC HeapRecordScanner::fetch_next_record()
   return RC::RECORD_EOF;
 }
 
-/**
- * @brief 遍历当前页面，尝试找到一条有效的记录
- */
-RC HeapRecordScanner::fetch_next_record_in_page()
+RC HeapRecordScanner::select_records_in_page(PageNum page_num)
 {
-  RC rc = RC::SUCCESS;
-  while (record_page_iterator_.has_next()) {
-    rc = record_page_iterator_.next(next_record_);
-    if (rc != RC::SUCCESS) {
-      const auto page_num = record_page_handler_->get_page_num();
-      LOG_TRACE("failed to get next record from page. page_num=%d, rc=%s", page_num, strrc(rc));
-      return rc;
-    }
+  slots_.clear();
+  slot_index_ = 0;
 
-    // 如果有过滤条件，就用过滤条件过滤一下
-    if (condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
-      continue;
-    }
+  record_page_handler_->cleanup();
+  RC rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_, BufferAccessMode::SCAN);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
 
-    // 如果是某个事务上遍历数据，还要看看事务访问是否有冲突
-    if (trx_ == nullptr) {
-      return rc;
-    }
+  record_page_handler_->valid_slots(slots_);
 
-    // 让当前事务探测一下是否访问冲突，或者需要加锁、等锁等操作，由事务自己决定
-    // TODO 把判断事务有效性的逻辑从Scanner中移除
-    rc = trx_->visit_record(table_, next_record_, rw_mode_);
-    if (rc == RC::RECORD_INVISIBLE) {
-      // 可以参考MvccTrx，表示当前记录不可见
-      // 这种模式仅在 readonly 事务下是有效的
-      continue;
-    }
-    return rc;
+  // 如果有过滤条件，就用过滤条件过滤一下
+  if (condition_filter_ != nullptr && !slots_.empty()) {
+    condition_filter_->filter_page(*record_page_handler_, slots_);
   }
 
-  next_record_.rid().slot_num = -1;
-  return RC::RECORD_EOF;
+  // 如果是某个事务上遍历数据，还要看看事务访问是否有冲突，不可见的记录会被去掉
+  // 可以参考MvccTrx，不可见的情况仅在 readonly 事务下是有效的
+  if (trx_ != nullptr && !slots_.empty()) {
+    pending_rc_ = trx_->visit_records(table_, *record_page_handler_, rw_mode_, slots_);
+  }
+  return RC::SUCCESS;
+}
+
+RC HeapRecordScanner::set_condition_filter(ConditionFilter *condition_filter)
+{
+  condition_filter_ = condition_filter;
+  return RC::SUCCESS;
 }
 
 RC HeapRecordScanner::close_scan()
@@ -131,6 +121,9 @@ RC HeapRecordScanner::close_scan()
     delete record_page_handler_;
     record_page_handler_ = nullptr;
   }
+  slots_.clear();
+  slot_index_ = 0;
+  pending_rc_ = RC::SUCCESS;
 
   return RC::SUCCESS;
 }
@@ -17,7 +17,8 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief 遍历某个文件中所有记录
  * @ingroup RecordManager
- * @details 遍历所有的页面，同时访问这些页面中所有的记录
+ * @details 遍历所有的页面，同时访问这些页面中所有的记录。
+ * 每个页面先按照过滤条件和事务可见性批量选出需要的记录，再逐条返回。
  */
 class HeapRecordScanner : public RecordScanner
 {
@@ -50,6 +51,11 @@ public:
    */
   RC next(Record &record) override;
 
+  /**
+   * @brief 设置过滤条件，替换构造时传入的过滤条件
+   */
+  RC set_condition_filter(ConditionFilter *condition_filter) override;
+
 private:
   /**
    * @brief 获取该文件中的下一条记录
@@ -57,9 +63,9 @@ private:
   RC fetch_next_record();
 
   /**
-   * @brief 获取一个页面内的下一条记录
+   * @brief 打开下一个页面，选出页面上满足过滤条件并且对当前事务可见的记录
    */
-  RC fetch_next_record_in_page();
+  RC select_records_in_page(PageNum page_num);
 
 private:
   // TODO 对于一个纯粹的record遍历器来说，不应该关心表和事务
@@ -73,6 +79,8 @@ private:
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
   ConditionFilter   *condition_filter_    = nullptr;  ///< 过滤record
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
-  RecordPageIterator record_page_iterator_;           ///< 遍历某个页面上的所有record
+  vector<SlotNum>    slots_;                          ///< 当前页面上选出来的记录
+  size_t             slot_index_ = 0;                 ///< 下一条要返回的记录在 slots_ 中的位置
+  RC                 pending_rc_ = RC::SUCCESS;       ///< 判断可见性时遇到的冲突，返回完冲突之前的记录后再返回
   Record             next_record_;                    ///< 获取的记录放在这里缓存起来
 };
\ No newline at end of file
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Meiyi & Longda on 2021/4/13.
 //
 #include "storage/record/record_manager.h"
+#include "common/config.h"
 #include "common/log/log.h"
 #include "storage/common/condition_filter.h"
 #include "storage/trx/trx.h"
@@ -95,7 +96,8 @@ RC RecordPageIterator::next(Record &record)
 
 RecordPageHandler::~RecordPageHandler() { cleanup(); }
 
-RC RecordPageHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode)
+RC RecordPageHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode,
+    BufferAccessMode access /* = NORMAL */)
 {
   if (disk_buffer_pool_ != nullptr) {
     if (frame_->page_num() == page_num) {
@@ -107,7 +109,7 @@ RC RecordPageHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler,
   }
 
   RC ret = RC::SUCCESS;
-  if ((ret = buffer_pool.get_this_page(page_num, &frame_)) != RC::SUCCESS) {
+  if ((ret = buffer_pool.get_this_page(page_num, &frame_, access)) != RC::SUCCESS) {
     LOG_ERROR("Failed to get page handle from disk buffer pool. ret=%d:%s", ret, strrc(ret));
     return ret;
   }
@@ -192,8 +194,8 @@ RC RecordPageHandler::init_empty_page(
   memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
   // column_index[i] store the end offset of column `i` or the start offset of column `i+1`
   int *column_index = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
+  // 列索引按照字段在表元数据中的位置排列，包括事务字段和null位图这些不可见的字段
   for (int i = 0; i < column_num; ++i) {
-    ASSERT(i == table_meta->field(i)->field_id(), "i should be the col_id of fields[i]");
     if (i == 0) {
       column_index[i] = table_meta->field(i)->len() * page_header_->record_capacity;
     } else {
@@ -404,6 +406,25 @@ RC RowRecordPageHandler::get_record(const RID &rid, Record &record)
   return RC::SUCCESS;
 }
 
+PageFieldView RowRecordPageHandler::field_view(int /*field_index*/, int field_offset)
+{
+  PageFieldView view;
+  view.data   = get_record_data(0) + field_offset;
+  view.stride = page_header_->record_size;
+  return view;
+}
+
+void RecordPageHandler::valid_slots(vector<SlotNum> &slots) const
+{
+  slots.clear();
+  slots.reserve(page_header_->record_num);
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  for (int slot = bitmap.next_setted_bit(0); slot != -1; slot = bitmap.next_setted_bit(slot + 1)) {
+    slots.push_back(slot);
+  }
+}
+
 PageNum RecordPageHandler::get_page_num() const
 {
   if (nullptr == page_header_) {
@@ -416,8 +437,42 @@ bool RecordPageHandler::is_full() const { return page_header_->record_num >= pag
 
 RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
 {
-  // your code here
-  exit(-1);
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 找到空闲位置
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = bitmap.next_unsetted_bit(0);
+  bitmap.set_bit(index);
+  page_header_->record_num++;
+
+  RC rc = log_handler_.insert_record(frame_, RID(get_page_num(), index), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  // 记录中的字段是按列顺序紧密排列的，按列拆开写到各自的列存储区
+  int field_offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int field_len = get_field_len(col_id);
+    memcpy(get_field_data(index, col_id), data + field_offset, field_len);
+    field_offset += field_len;
+  }
+
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = index;
+  }
+
+  return RC::SUCCESS;
 }
 
 RC PaxRecordPageHandler::delete_record(const RID *rid)
@@ -446,15 +501,78 @@ RC PaxRecordPageHandler::delete_record(const RID *rid)
 
 RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
 {
-  // your code here
-  exit(-1);
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  // 列数据不是连续存放的，需要拼装成一条完整的记录
+  RC rc = record.new_record(page_header_->record_real_size);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  char *record_data  = record.data();
+  int   field_offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int field_len = get_field_len(col_id);
+    memcpy(record_data + field_offset, get_field_data(rid.slot_num, col_id), field_len);
+    field_offset += field_len;
+  }
+
+  record.set_rid(rid);
+  return RC::SUCCESS;
 }
 
 // TODO: specify the column_ids that chunk needed. currenly we get all columns
-RC PaxRecordPageHandler::get_chunk(Chunk &chunk)
+RC PaxRecordPageHandler::get_chunk(Chunk &chunk, const vector<SlotNum> *slots /* = nullptr */)
+{
+  vector<SlotNum> all_slots;
+  if (slots == nullptr) {
+    valid_slots(all_slots);
+    slots = &all_slots;
+  }
+
+  for (int i = 0; i < chunk.column_num(); i++) {
+    Column   &column    = chunk.column(i);
+    const int col_id    = chunk.column_ids(i);
+    const int field_len = get_field_len(col_id);
+    if (col_id < 0 || col_id >= page_header_->column_num || field_len != column.attr_len()) {
+      LOG_WARN("invalid column in chunk. col_id=%d, column_num=%d, field_len=%d, attr_len=%d",
+               col_id, page_header_->column_num, field_len, column.attr_len());
+      return RC::INVALID_ARGUMENT;
+    }
+
+    // 同一列的数据在页面中是连续存放的，槽位连续的记录可以一次拷贝
+    for (size_t begin = 0; begin < slots->size();) {
+      size_t end = begin + 1;
+      while (end < slots->size() && (*slots)[end] == (*slots)[end - 1] + 1) {
+        end++;
+      }
+      RC rc = column.append(get_field_data((*slots)[begin], col_id), static_cast<int>(end - begin));
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append data to column. col_id=%d, rc=%s", col_id, strrc(rc));
+        return rc;
+      }
+      begin = end;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+PageFieldView PaxRecordPageHandler::field_view(int field_index, int /*field_offset*/)
 {
-  // your code here
-  exit(-1);
+  PageFieldView view;
+  view.data   = get_field_data(0, field_index);
+  view.stride = get_field_len(field_index);
+  return view;
 }
 
 char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
@@ -517,14 +635,15 @@ RC RecordFileHandler::init_free_pages()
   RC rc = RC::SUCCESS;
 
   BufferPoolIterator bp_iterator;
-  bp_iterator.init(*disk_buffer_pool_, 1);
+  bp_iterator.init(*disk_buffer_pool_, 1, true /*prefetch*/);
   unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
   PageNum                       current_page_num = 0;
 
   while (bp_iterator.has_next()) {
     current_page_num = bp_iterator.next();
 
-    rc = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_ONLY);
+    rc = record_page_handler->init(
+        *disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_ONLY, BufferAccessMode::SCAN);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, rc, strrc(rc));
       return rc;
@@ -707,6 +826,8 @@ RC ChunkFileScanner::close_scan()
   if (disk_buffer_pool_ != nullptr) {
     disk_buffer_pool_ = nullptr;
   }
+  condition_filter_ = nullptr;
+  trx_              = nullptr;
 
   if (record_page_handler_ != nullptr) {
     record_page_handler_->cleanup();
@@ -718,7 +839,7 @@ RC ChunkFileScanner::close_scan()
 }
 
 RC ChunkFileScanner::open_scan_chunk(
-    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode)
+    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode, Trx *trx /* = nullptr */)
 {
   close_scan();
 
@@ -726,8 +847,9 @@ RC ChunkFileScanner::open_scan_chunk(
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
   rw_mode_          = mode;
+  trx_              = trx;
 
-  RC rc = bp_iterator_.init(buffer_pool, 1);
+  RC rc = bp_iterator_.init(buffer_pool, 1, true /*prefetch*/);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -741,6 +863,38 @@ RC ChunkFileScanner::open_scan_chunk(
   return rc;
 }
 
+void ChunkFileScanner::fill_nulls(Chunk &chunk)
+{
+  if (table_ == nullptr) {
+    return;
+  }
+  const TableMeta &table_meta = table_->table_meta();
+  const FieldMeta *null_field = table_meta.field(NULL_BITMAP_FIELD_NAME);
+  if (null_field == nullptr) {
+    return;
+  }
+
+  const int     null_field_index = static_cast<int>(null_field - table_meta.field(0));
+  PageFieldView null_view        = record_page_handler_->field_view(null_field_index, null_field->offset());
+  const int     bitmap_bits      = null_field->len() * 8;
+  for (int i = 0; i < chunk.column_num(); i++) {
+    const FieldMeta *field = table_meta.field(chunk.column_ids(i));
+    if (field == nullptr || !field->nullable() || field->field_id() >= bitmap_bits) {
+      continue;
+    }
+
+    // 当前页面的记录追加在列的最后面，第 k 行对应 slots_[k]
+    Column   &column = chunk.column(i);
+    const int base   = column.count() - static_cast<int>(slots_.size());
+    for (size_t k = 0; k < slots_.size(); k++) {
+      common::Bitmap null_bitmap(const_cast<char *>(null_view.at(slots_[k])), bitmap_bits);
+      if (null_bitmap.get_bit(field->field_id())) {
+        column.set_null(base + static_cast<int>(k));
+      }
+    }
+  }
+}
+
 RC ChunkFileScanner::next_chunk(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
@@ -748,13 +902,31 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
     record_page_handler_->cleanup();
-    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
+    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_, BufferAccessMode::SCAN);
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
-    rc = record_page_handler_->get_chunk(chunk);
+
+    // 先按照过滤条件，再按照事务可见性，整个页面批量选出需要的记录
+    record_page_handler_->valid_slots(slots_);
+    if (condition_filter_ != nullptr && !slots_.empty()) {
+      condition_filter_->filter_page(*record_page_handler_, slots_);
+    }
+    if (trx_ != nullptr && !slots_.empty()) {
+      rc = trx_->visit_records(table_, *record_page_handler_, rw_mode_, slots_);
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("failed to visit records. page_num=%d, rc=%s", page_num, strrc(rc));
+        return rc;
+      }
+    }
+    if (slots_.empty()) {
+      continue;
+    }
+
+    rc = record_page_handler_->get_chunk(chunk, &slots_);
     if (rc == RC::SUCCESS) {
+      fill_nulls(chunk);
       return rc;
     } else if (rc == RC::RECORD_EOF) {
       break;
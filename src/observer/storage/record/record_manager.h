@@ -76,6 +76,28 @@ struct PageHeader
   string to_string() const;
 };
 
+/**
+ * @brief 页面上某个字段在所有记录中的值
+ * @ingroup RecordManager
+ * @details 第 slot 条记录的值存放在 data + slot * stride。行存格式的 stride 是记录的长度，
+ * PAX 格式同一列的数据连续存放，stride 就是字段的长度。可以在一个循环中批量处理整个页面的数据。
+ */
+struct PageFieldView
+{
+  const char *data   = nullptr;
+  int         stride = 0;
+
+  const char *at(SlotNum slot_num) const { return data + static_cast<int64_t>(slot_num) * stride; }
+
+  template <typename T>
+  T get(SlotNum slot_num) const
+  {
+    T value;
+    memcpy(&value, at(slot_num), sizeof(value));
+    return value;
+  }
+};
+
 /**
  * @brief 遍历一个页面中每条记录的iterator
  * @ingroup RecordManager
@@ -135,8 +157,10 @@ public:
    * @param buffer_pool 关联某个文件时，都通过buffer pool来做读写文件
    * @param page_num    当前处理哪个页面
    * @param mode        是否只读。在访问页面时，需要对页面加锁
+   * @param access      访问页面的方式，全表扫描时使用 SCAN
    */
-  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode);
+  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode,
+      BufferAccessMode access = BufferAccessMode::NORMAL);
 
   /**
    * @brief 数据库恢复时，与普通的运行场景有所不同，不做任何并发操作，也不需要加锁
@@ -214,9 +238,25 @@ public:
    * @brief 获取整个页面中指定列的所有记录。
    *
    * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @param slots 只获取这些槽位上的记录，必须是递增的。空指针表示页面上所有的记录
    * 只需由 PaxRecordPageHandler 实现。
    */
-  virtual RC get_chunk(Chunk &chunk) { return RC::UNIMPLEMENTED; }
+  virtual RC get_chunk(Chunk &chunk, const vector<SlotNum> *slots = nullptr) { return RC::UNIMPLEMENTED; }
+
+  /**
+   * @brief 获取页面上某个字段在所有记录中的值
+   *
+   * @param field_index  字段在表中的序号，包括事务字段这些不可见的字段。PAX 格式按照它找到列
+   * @param field_offset 字段在记录中的偏移量，行存格式按照它找到字段
+   */
+  virtual PageFieldView field_view(int field_index, int field_offset) { return PageFieldView(); }
+
+  /**
+   * @brief 页面上所有有记录的槽位，按照槽位递增
+   * @details 扫描时一次取出整个页面的记录，之后用 ConditionFilter::filter_page 和 Trx::visit_records
+   * 批量过滤，剩下的槽位就是选择向量
+   */
+  void valid_slots(vector<SlotNum> &slots) const;
 
   /**
    * @brief 返回该记录页的页号
@@ -297,6 +337,8 @@ public:
    * @param record 返回指定的数据。这里不会将数据复制出来，而是使用指针，所以调用者必须保证数据使用期间受到保护
    */
   virtual RC get_record(const RID &rid, Record &record) override;
+
+  virtual PageFieldView field_view(int field_index, int field_offset) override;
 };
 
 /**
@@ -339,8 +381,11 @@ public:
    * @brief 以 Chunk 格式获取整个页面中指定列的所有记录。
    *
    * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @param slots 只获取这些槽位上的记录，空指针表示页面上所有的记录
    */
-  virtual RC get_chunk(Chunk &chunk) override;
+  virtual RC get_chunk(Chunk &chunk, const vector<SlotNum> *slots = nullptr) override;
+
+  virtual PageFieldView field_view(int field_index, int field_offset) override;
 
 private:
   // get the field data by `slot_num` and `column id`
@@ -427,8 +472,17 @@ public:
   ChunkFileScanner() = default;
   ~ChunkFileScanner();
 
-  // TODO: not support filter and transaction
-  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode);
+  /**
+   * @brief 打开一个文件扫描
+   * @param trx 在哪个事务中扫描，只返回事务可见的记录。空指针表示不判断可见性
+   */
+  RC open_scan_chunk(
+      Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode, Trx *trx = nullptr);
+
+  /**
+   * @brief 设置下推到存储层的过滤条件，扫描时按页面批量过滤
+   */
+  void set_condition_filter(ConditionFilter *condition_filter) { condition_filter_ = condition_filter; }
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
@@ -436,17 +490,26 @@ public:
   RC close_scan();
 
   /**
-   * @brief 每次调用获取一个页面中的所有记录。
+   * @brief 每次调用获取一个页面中所有可见并且满足过滤条件的记录。没有这样的记录的页面会跳过
    */
   RC next_chunk(Chunk &chunk);
 
+private:
+  /**
+   * @brief 根据记录中的 NULL 位图，标记刚刚从当前页面读出来的那些行中的 NULL
+   */
+  void fill_nulls(Chunk &chunk);
+
 private:
   Table *table_ = nullptr;  ///< 当前遍历的是哪张表。
 
   DiskBufferPool *disk_buffer_pool_ = nullptr;  ///< 当前访问的文件
   LogHandler     *log_handler_      = nullptr;
   ReadWriteMode   rw_mode_ = ReadWriteMode::READ_WRITE;  ///< 遍历出来的数据，是否可能对它做修改
+  Trx            *trx_     = nullptr;
 
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
+  ConditionFilter   *condition_filter_    = nullptr;
+  vector<SlotNum>    slots_;                          ///< 当前页面上选中的记录
 };
@@ -39,4 +39,11 @@ public:
    * @param record 返回的下一条记录
    */
   virtual RC next(Record &record) = 0;
+
+  /**
+   * @brief 设置过滤条件，由存储层在扫描页面时批量过滤
+   * @details 需要在 open_scan 之后、第一次调用 next 之前设置，扫描结束之前调用者不能释放它
+   * @return 不支持过滤条件下推时返回 UNIMPLEMENTED，调用者需要自己过滤
+   */
+  virtual RC set_condition_filter(ConditionFilter *condition_filter) { return RC::UNIMPLEMENTED; }
 };
\ No newline at end of file
@@ -17,6 +17,9 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/meta_util.h"
 #include "storage/db/db.h"
 #include "sql/expr/expression.h"
+#include "storage/trx/trx.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
 
 HeapTableEngine::~HeapTableEngine()
 {
@@ -351,9 +354,85 @@ RC HeapTableEngine::get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWr
   return rc;
 }
 
+RC HeapTableEngine::sample_records(
+    Trx *trx, int max_pages, function<RC(const Record &)> visitor, int64_t &estimated_rows)
+{
+  estimated_rows = 0;
+
+  BufferPoolIterator bp_iterator;
+  RC                 rc = bp_iterator.init(*data_buffer_pool_, 1);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init bp iterator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 固定随机数种子，同样的数据每次分析得到的统计信息相同
+  mt19937         random(static_cast<uint32_t>(table_meta_->table_id()));
+  vector<PageNum> pages;
+  int64_t         total_pages = 0;
+  while (bp_iterator.has_next()) {
+    const PageNum page_num = bp_iterator.next();
+    total_pages++;
+    if (static_cast<int>(pages.size()) < max_pages) {
+      pages.push_back(page_num);
+    } else {
+      const int64_t index = uniform_int_distribution<int64_t>(0, total_pages - 1)(random);
+      if (index < max_pages) {
+        pages[index] = page_num;
+      }
+    }
+  }
+  if (pages.empty()) {
+    return RC::SUCCESS;
+  }
+  // 按照页号的顺序读，尽量顺序IO
+  sort(pages.begin(), pages.end());
+
+  unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(table_meta_->storage_format()));
+  RecordPageIterator            page_iterator;
+  Record                        record;
+  int64_t                       rows = 0;
+  for (PageNum page_num : pages) {
+    if (OB_FAIL(rc = page_handler->init(*data_buffer_pool_, db_->log_handler(), page_num, ReadWriteMode::READ_ONLY))) {
+      LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    page_iterator.init(page_handler.get());
+    while (page_iterator.has_next()) {
+      if (OB_FAIL(rc = page_iterator.next(record))) {
+        break;
+      }
+      if (trx != nullptr) {
+        rc = trx->visit_record(table_, record, ReadWriteMode::READ_ONLY);
+        if (rc == RC::RECORD_INVISIBLE) {
+          rc = RC::SUCCESS;
+          continue;
+        }
+        if (OB_FAIL(rc)) {
+          break;
+        }
+      }
+      if (OB_FAIL(rc = visitor(record))) {
+        break;
+      }
+      rows++;
+    }
+    page_handler->cleanup();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  estimated_rows = rows * total_pages / static_cast<int64_t>(pages.size());
+  LOG_INFO("sample table records. table=%s, total pages=%ld, sampled pages=%d, sampled rows=%ld, estimated rows=%ld",
+      table_meta_->name(), total_pages, static_cast<int>(pages.size()), rows, estimated_rows);
+  return RC::SUCCESS;
+}
+
 RC HeapTableEngine::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode)
 {
-  RC rc = scanner.open_scan_chunk(table_, *data_buffer_pool_, db_->log_handler(), mode);
+  RC rc = scanner.open_scan_chunk(table_, *data_buffer_pool_, db_->log_handler(), mode, trx);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
   }
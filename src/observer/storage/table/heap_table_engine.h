@@ -41,6 +41,8 @@ public:
   RC create_index(Trx *trx, const vector<FieldMeta> field_metas, const char *index_name, bool is_unique) override;
   RC create_vector_index(Trx *trx, const FieldMeta &field_meta, const char *index_name,
       const unordered_map<string, string> &params) override;
+  /// @brief 使用蓄水池抽样选出 max_pages 个数据页，只读取这些页面上的记录
+  RC sample_records(Trx *trx, int max_pages, function<RC(const Record &)> visitor, int64_t &estimated_rows) override;
   RC get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode) override;
   RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode) override;
   RC visit_record(const RID &rid, function<bool(Record &)> visitor) override;
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/table/lsm_table_engine.h"
 #include "storage/record/heap_record_scanner.h"
+#include "common/lang/bitmap.h"
 #include "common/log/log.h"
 #include "storage/index/bplus_tree_index.h"
 #include "storage/common/meta_util.h"
@@ -18,6 +19,62 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/codec.h"
 #include "storage/trx/lsm_mvcc_trx.h"
 
+RC LsmTableEngine::make_record(int value_num, const Value *values, Record &record)
+{
+  RC  rc                 = RC::SUCCESS;
+  int has_nullable_field = static_cast<int>(table_meta_->has_nullable_field());
+
+  // 检查字段类型是否一致
+  if (value_num + table_meta_->sys_field_num() != table_meta_->field_num() - has_nullable_field) {
+    LOG_WARN("Input values don't match the table's schema, table name:%s", table_meta_->name());
+    return RC::SCHEMA_FIELD_MISSING;
+  }
+
+  const int normal_field_start_index = table_meta_->sys_field_num() + has_nullable_field;
+  int       record_size              = table_meta_->record_size();
+  char     *record_data              = (char *)malloc(record_size);
+  memset(record_data, 0, record_size);
+
+  if (has_nullable_field == 1) {
+    const FieldMeta *field = table_meta_->field(NULL_BITMAP_FIELD_NAME);
+    vector<char>     data(field->len());
+    common::Bitmap   bitmap(data.data(), field->len());
+    bitmap.clear_all();
+    for (int i = 0; i < value_num; ++i) {
+      if (values[i].is_null()) {
+        bitmap.set_bit(i);
+      }
+    }
+    Value null_bitmap_val;
+    null_bitmap_val.set_bitmap(bitmap.data(), field->len());
+    rc = set_value_to_record(record_data, null_bitmap_val, field);
+  }
+
+  for (int i = 0; i < value_num && OB_SUCC(rc); i++) {
+    const FieldMeta *field = table_meta_->field(i + normal_field_start_index);
+    const Value     &value = values[i];
+    if (field->type() == AttrType::LOBID) {
+      // TODO: 大对象保存在堆表的 lob 文件中，LSM 表还不支持
+      rc = RC::UNSUPPORTED;
+    } else if (field->type() != value.attr_type()) {
+      Value real_value;
+      if (OB_SUCC(rc = Value::cast_to(value, field->type(), real_value))) {
+        rc = set_value_to_record(record_data, real_value, field);
+      }
+    } else {
+      rc = set_value_to_record(record_data, value, field);
+    }
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to make record. table name:%s, rc=%s", table_meta_->name(), strrc(rc));
+    free(record_data);
+    return rc;
+  }
+
+  record.set_data_owner(record_data, record_size);
+  return RC::SUCCESS;
+}
+
 RC LsmTableEngine::insert_record(Record &record)
 {
   RC rc = RC::SUCCESS;
@@ -29,6 +86,24 @@ RC LsmTableEngine::insert_record(Record &record)
   return rc;
 }
 
+RC LsmTableEngine::insert_records(vector<Record> &records)
+{
+  ObLsmWriteBatch batch;
+  bytes           lsm_key;
+  uint64_t        id = inc_id_.fetch_add(records.size());
+  for (const Record &record : records) {
+    lsm_key.clear();
+    Codec::encode(table_->table_id(), id++, lsm_key);
+    batch.put(string_view((char *)lsm_key.data(), lsm_key.size()), string_view(record.data(), record.len()));
+  }
+  RC rc = lsm_->write(&batch);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write records. table name:%s, record num=%lu, rc=%s",
+        table_meta_->name(), records.size(), strrc(rc));
+  }
+  return rc;
+}
+
 RC LsmTableEngine::get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode)
 {
   scanner = new LsmRecordScanner(table_, db_->lsm(), trx);
@@ -38,8 +113,3 @@ RC LsmTableEngine::get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWri
   }
   return rc;
 }
-
-RC LsmTableEngine::open()
-{
-  return RC::UNIMPLEMENTED;
-}
\ No newline at end of file
@@ -28,8 +28,10 @@ public:
   {}
   ~LsmTableEngine() override = default;
 
-  RC make_record(int value_num, const Value *values, Record &record) override { return RC::UNIMPLEMENTED; }
+  RC make_record(int value_num, const Value *values, Record &record) override;
   RC insert_record(Record &record) override;
+  /// 一批记录放在一个 ObLsmWriteBatch 中，只写一次 WAL，原子地可见
+  RC insert_records(vector<Record> &records) override;
   RC delete_record(const Record &record) override { return RC::UNIMPLEMENTED; }
   RC insert_record_with_trx(Record &record, Trx *trx) override { return RC::UNIMPLEMENTED; }
   RC delete_record_with_trx(const Record &record, Trx *trx) override { return RC::UNIMPLEMENTED; }
@@ -48,7 +50,7 @@ public:
   RC     sync() override { return RC::SUCCESS; }
   Index *find_index(const char *index_name) const override { return nullptr; }
   Index *find_index_by_field(const char *field_name) const override { return nullptr; }
-  RC     open() override;
+  RC     open() override { return RC::SUCCESS; }
   RC     init() override { return RC::UNIMPLEMENTED; }
 
 private:
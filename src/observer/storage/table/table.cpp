@@ -191,18 +191,38 @@ RC Table::open(Db *db, const char *meta_file, const char *base_dir)
   return rc;
 }
 
-RC Table::insert_record(Record &record) { return engine_->insert_record(record); }
+RC Table::insert_record(Record &record)
+{
+  increase_data_version();
+  return engine_->insert_record(record);
+}
 
-RC Table::visit_record(const RID &rid, function<bool(Record &)> visitor) { return engine_->visit_record(rid, visitor); }
+RC Table::insert_records(vector<Record> &records)
+{
+  increase_data_version();
+  return engine_->insert_records(records);
+}
+
+RC Table::visit_record(const RID &rid, function<bool(Record &)> visitor)
+{
+  increase_data_version();
+  return engine_->visit_record(rid, visitor);
+}
 
-RC Table::insert_record_with_trx(Record &record, Trx *trx) { return engine_->insert_record_with_trx(record, trx); }
+RC Table::insert_record_with_trx(Record &record, Trx *trx)
+{
+  increase_data_version();
+  return engine_->insert_record_with_trx(record, trx);
+}
 RC Table::delete_record_with_trx(const Record &record, Trx *trx)
 {
+  increase_data_version();
   return engine_->delete_record_with_trx(record, trx);
 }
 
 RC Table::update_record_with_trx(const Record &old_record, const Record &new_record, Trx *trx)
 {
+  increase_data_version();
   return engine_->update_record_with_trx(old_record, new_record, trx);
 }
 
@@ -243,6 +263,11 @@ RC Table::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode m
   return engine_->get_chunk_scanner(scanner, trx, mode);
 }
 
+RC Table::sample_records(Trx *trx, int max_pages, function<RC(const Record &)> visitor, int64_t &estimated_rows)
+{
+  return engine_->sample_records(trx, max_pages, std::move(visitor), estimated_rows);
+}
+
 RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name)
 {
   return engine_->create_index(trx, field_meta, index_name);
@@ -260,7 +285,11 @@ RC Table::create_vector_index(Trx *trx, const FieldMeta& field_meta, const char
   return engine_->create_vector_index(trx, field_meta, index_name, params);
 }
 
-RC Table::delete_record(const Record &record) { return engine_->delete_record(record); }
+RC Table::delete_record(const Record &record)
+{
+  increase_data_version();
+  return engine_->delete_record(record);
+}
 
 Index *Table::find_index(const char *index_name) const { return engine_->find_index(index_name); }
 Index *Table::find_index_by_field(const char *field_name) const { return engine_->find_index_by_field(field_name); }
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/table/table_engine.h"
 #include "common/types.h"
 #include "common/lang/span.h"
+#include "common/lang/atomic.h"
 #include "common/lang/functional.h"
 
 struct RID;
@@ -82,6 +83,12 @@ public:
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
    */
   RC insert_record(Record &record);
+
+  /**
+   * @brief 在当前的表中插入一批记录
+   * @details 和 insert_record 一样不关心事务。LSM 引擎把它们作为一个 write batch 原子地写入
+   */
+  RC insert_records(vector<Record> &records);
   RC delete_record(const Record &record);
 
   RC insert_record_with_trx(Record &record, Trx *trx);
@@ -101,6 +108,12 @@ public:
 
   RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode);
 
+  /**
+   * @brief 抽样读取表中的记录，ANALYZE TABLE 使用
+   * @details 参考 TableEngine::sample_records
+   */
+  RC sample_records(Trx *trx, int max_pages, function<RC(const Record &)> visitor, int64_t &estimated_rows);
+
   /**
    * @brief 可以在页面锁保护的情况下访问记录
    * @details 当前是在事务中访问记录，为了提供一个“原子性”的访问模式
@@ -118,6 +131,14 @@ public:
 
   const TableMeta &table_meta() const;
 
+  /**
+   * @brief 表数据的版本号
+   * @details 每次修改表中的数据(包括事务提交和回滚时修改记录的可见性)都会增加版本号，
+   * 查询缓存用它来判断缓存的结果是否还有效
+   */
+  uint64_t data_version() const { return data_version_.load(); }
+  void     increase_data_version() { data_version_++; }
+
   RC sync();
 
 private:
@@ -138,4 +159,5 @@ private:
   // RecordFileHandler *record_handler_   = nullptr;  /// 记录操作
   // vector<Index *>    indexes_;
   unique_ptr<TableEngine> engine_ = nullptr;
+  atomic<uint64_t>        data_version_{0};  ///< 表数据的版本号，数据变化时增加
 };
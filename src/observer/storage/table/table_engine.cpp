@@ -1,4 +1,5 @@
 #include "table_engine.h"
+#include "storage/record/record_scanner.h"
 
 RC TableEngine::set_value_to_record(char *record_data, const Value &value, const FieldMeta *field)
 {
@@ -17,3 +18,36 @@ RC TableEngine::set_value_to_record(char *record_data, const Value &value, const
   memcpy(record_data + field->offset(), value.data(), copy_len);
   return RC::SUCCESS;
 }
+
+RC TableEngine::insert_records(vector<Record> &records)
+{
+  RC rc = RC::SUCCESS;
+  for (Record &record : records) {
+    if (OB_FAIL(rc = insert_record(record))) {
+      break;
+    }
+  }
+  return rc;
+}
+
+RC TableEngine::sample_records(Trx *trx, int max_pages, function<RC(const Record &)> visitor, int64_t &estimated_rows)
+{
+  estimated_rows         = 0;
+  RecordScanner *scanner = nullptr;
+  RC             rc      = get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
+  if (OB_FAIL(rc)) {
+    delete scanner;
+    return rc;
+  }
+
+  Record record;
+  while (OB_SUCC(rc = scanner->next(record))) {
+    if (OB_FAIL(rc = visitor(record))) {
+      break;
+    }
+    estimated_rows++;
+  }
+  scanner->close_scan();
+  delete scanner;
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
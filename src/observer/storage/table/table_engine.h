@@ -40,6 +40,8 @@ public:
 
   virtual RC make_record(int value_num, const Value *values, Record &record)                      = 0;
   virtual RC insert_record(Record &record)                                                        = 0;
+  /// 插入一批记录，默认逐条插入
+  virtual RC insert_records(vector<Record> &records);
   virtual RC delete_record(const Record &record)                                                  = 0;
   virtual RC insert_record_with_trx(Record &record, Trx *trx)                                     = 0;
   virtual RC delete_record_with_trx(const Record &record, Trx *trx)                               = 0;
@@ -63,6 +65,15 @@ public:
     return RC::UNSUPPORTED;
   }
 
+  /**
+   * @brief 抽样读取表中的记录，用来收集统计信息
+   * @details 默认的实现会读取所有的记录，存储引擎可以只读取一部分数据页
+   * @param max_pages      最多读取多少个数据页
+   * @param visitor        每一条读到的对当前事务可见的记录
+   * @param estimated_rows 根据抽样估算出来的表中的总行数
+   */
+  virtual RC sample_records(Trx *trx, int max_pages, function<RC(const Record &)> visitor, int64_t &estimated_rows);
+
   virtual RC     get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode)  = 0;
   virtual RC     get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode) = 0;
   virtual RC     visit_record(const RID &rid, function<bool(Record &)> visitor)             = 0;
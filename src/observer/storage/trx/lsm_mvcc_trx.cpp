@@ -29,16 +29,19 @@ LogReplayer *LsmMvccTrxKit::create_log_replayer(Db &, LogHandler &) { return new
 
 RC LsmMvccTrx::insert_record(Table *table, Record &record)
 {
-   return table->insert_record_with_trx(record, this);
+  modified_tables_.insert(table);
+  return table->insert_record_with_trx(record, this);
 }
 
 RC LsmMvccTrx::delete_record(Table *table, Record &record)
 {
+  modified_tables_.insert(table);
   return table->delete_record_with_trx(record, this);
 }
 
 RC LsmMvccTrx::update_record(Table *table, Record &old_record, Record &new_record)
 {
+  modified_tables_.insert(table);
   return table->update_record_with_trx(old_record, new_record, this);
 }
 /**
@@ -60,12 +63,24 @@ RC LsmMvccTrx::commit()
   if (trx_ == nullptr) {
     return RC::SUCCESS;
   }
-  return trx_->commit();
+  RC rc = trx_->commit();
+  increase_data_versions();
+  return rc;
 }
 
 RC LsmMvccTrx::rollback()
 {
-  return trx_->rollback();
+  RC rc = trx_->rollback();
+  increase_data_versions();
+  return rc;
+}
+
+void LsmMvccTrx::increase_data_versions()
+{
+  for (Table *table : modified_tables_) {
+    table->increase_data_version();
+  }
+  modified_tables_.clear();
 }
 
 /**
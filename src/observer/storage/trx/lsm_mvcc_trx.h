@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/unordered_set.h"
 #include "storage/trx/trx.h"
 #include "storage/db/db.h"
 #include "oblsm/include/ob_lsm.h"
@@ -66,8 +67,16 @@ public:
   int32_t id() const override { return 0; }
 
 private:
-  ObLsm            *lsm_;
-  ObLsmTransaction *trx_ = nullptr;
+  /**
+   * @brief 事务结束时增加修改过的表的数据版本号
+   * @details oblsm 事务中的修改在提交之后才可见，所以提交时也要让查询缓存中相关的结果失效
+   */
+  void increase_data_versions();
+
+private:
+  ObLsm                 *lsm_;
+  ObLsmTransaction      *trx_ = nullptr;
+  unordered_set<Table *> modified_tables_;  ///< 当前事务修改过的表
 };
 
 class LsmMvccTrxLogReplayer : public LogReplayer
@@ -63,14 +63,19 @@ Trx *MvccTrxKit::create_trx(LogHandler &log_handler, int32_t trx_id)
   if (trx != nullptr) {
     lock_.lock();
     trxes_.push_back(trx);
-    if (current_trx_id_ < trx_id) {
-      current_trx_id_ = trx_id;
-    }
     lock_.unlock();
+    init_trx_id(trx_id);
   }
   return trx;
 }
 
+void MvccTrxKit::init_trx_id(int32_t trx_id)
+{
+  int32_t current = current_trx_id_.load();
+  while (current < trx_id && !current_trx_id_.compare_exchange_weak(current, trx_id)) {
+  }
+}
+
 void MvccTrxKit::destroy_trx(Trx *trx)
 {
   lock_.lock();
@@ -92,6 +97,21 @@ void MvccTrxKit::all_trxes(vector<Trx *> &trxes)
   lock_.unlock();
 }
 
+LSN MvccTrxKit::min_active_lsn()
+{
+  LSN min_lsn = numeric_limits<LSN>::max();
+
+  lock_.lock();
+  for (Trx *trx : trxes_) {
+    LSN first_lsn = static_cast<MvccTrx *>(trx)->first_lsn();
+    if (first_lsn > 0 && first_lsn < min_lsn) {
+      min_lsn = first_lsn;
+    }
+  }
+  lock_.unlock();
+  return min_lsn;
+}
+
 LogReplayer *MvccTrxKit::create_log_replayer(Db &db, LogHandler &log_handler)
 {
   return new MvccTrxLogReplayer(db, *this, log_handler);
@@ -180,7 +200,37 @@ RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
 
   int32_t begin_xid = begin_field.get_int(record);
   int32_t end_xid   = end_field.get_int(record);
+  return check_visibility(begin_xid, end_xid, mode);
+}
+
+RC MvccTrx::visit_records(Table *table, RecordPageHandler &page_handler, ReadWriteMode mode, vector<SlotNum> &slots)
+{
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
 
+  // 事务字段在表的字段列表中的序号，PAX 格式的页面按照序号找到列
+  const FieldMeta    *first_field = table->table_meta().field(0);
+  const PageFieldView begin_xids  = page_handler.field_view(begin_field.meta() - first_field, begin_field.meta()->offset());
+  const PageFieldView end_xids    = page_handler.field_view(end_field.meta() - first_field, end_field.meta()->offset());
+
+  RC     rc       = RC::SUCCESS;
+  size_t selected = 0;
+  for (size_t i = 0; i < slots.size(); i++) {
+    const SlotNum slot = slots[i];
+    rc = check_visibility(begin_xids.get<int32_t>(slot), end_xids.get<int32_t>(slot), mode);
+    if (OB_SUCC(rc)) {
+      slots[selected++] = slot;
+    } else if (rc != RC::RECORD_INVISIBLE) {
+      break;
+    }
+  }
+  slots.resize(selected);
+  return rc == RC::RECORD_INVISIBLE ? RC::SUCCESS : rc;
+}
+
+RC MvccTrx::check_visibility(int32_t begin_xid, int32_t end_xid, ReadWriteMode mode) const
+{
   RC rc = RC::SUCCESS;
   if (begin_xid > 0 && end_xid > 0) {
     if (trx_id_ >= begin_xid && trx_id_ <= end_xid) {
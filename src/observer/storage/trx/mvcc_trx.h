@@ -37,6 +37,11 @@ public:
 
   void all_trxes(vector<Trx *> &trxes) override;
 
+  LSN min_active_lsn() override;
+
+  int32_t current_trx_id() const override { return current_trx_id_.load(); }
+  void    init_trx_id(int32_t trx_id) override;
+
   LogReplayer *create_log_replayer(Db &db, LogHandler &log_handler) override;
 
 public:
@@ -87,6 +92,12 @@ public:
    */
   RC visit_record(Table *table, Record &record, ReadWriteMode mode) override;
 
+  /**
+   * @brief 批量判断一个页面上记录的可见性
+   * @details 直接在页面上读取 begin_xid 和 end_xid 两列，在一个循环里完成判断
+   */
+  RC visit_records(Table *table, RecordPageHandler &page_handler, ReadWriteMode mode, vector<SlotNum> &slots) override;
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
@@ -95,10 +106,18 @@ public:
 
   int32_t id() const override { return trx_id_; }
 
+  /// @brief 当前事务的第一条日志的LSN，还没有写日志时是0
+  LSN first_lsn() const { return log_handler_.first_lsn(); }
+
 private:
   RC   commit_with_trx_id(int32_t commit_id);
   void trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const;
 
+  /**
+   * @brief 根据记录的 begin_xid 和 end_xid 判断可见性，返回值见 visit_record
+   */
+  RC check_visibility(int32_t begin_xid, int32_t end_xid, ReadWriteMode mode) const;
+
 private:
   static const int32_t MAX_TRX_ID = numeric_limits<int32_t>::max();
 
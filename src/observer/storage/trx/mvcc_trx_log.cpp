@@ -68,6 +68,15 @@ MvccTrxLogHandler::MvccTrxLogHandler(LogHandler &log_handler) : log_handler_(log
 
 MvccTrxLogHandler::~MvccTrxLogHandler() {}
 
+RC MvccTrxLogHandler::append(span<const char> data, LSN &lsn)
+{
+  if (first_lsn_.load() == 0) {
+    // LSN是递增分配的，这条日志的LSN一定比当前的LSN大
+    first_lsn_.store(log_handler_.current_lsn() + 1);
+  }
+  return log_handler_.append(lsn, LogModule::Id::TRANSACTION, data);
+}
+
 RC MvccTrxLogHandler::insert_record(int32_t trx_id, Table *table, const RID &rid)
 {
   ASSERT(trx_id > 0, "invalid trx_id:%d", trx_id);
@@ -79,8 +88,7 @@ RC MvccTrxLogHandler::insert_record(int32_t trx_id, Table *table, const RID &rid
   log_entry.rid                   = rid;
 
   LSN lsn = 0;
-  return log_handler_.append(
-      lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+  return append(span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)), lsn);
 }
 
 RC MvccTrxLogHandler::delete_record(int32_t trx_id, Table *table, const RID &rid)
@@ -94,8 +102,7 @@ RC MvccTrxLogHandler::delete_record(int32_t trx_id, Table *table, const RID &rid
   log_entry.rid                   = rid;
 
   LSN lsn = 0;
-  return log_handler_.append(
-      lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+  return append(span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)), lsn);
 }
 
 RC MvccTrxLogHandler::commit(int32_t trx_id, int32_t commit_trx_id)
@@ -108,12 +115,14 @@ RC MvccTrxLogHandler::commit(int32_t trx_id, int32_t commit_trx_id)
   log_entry.commit_trx_id         = commit_trx_id;
 
   LSN lsn = 0;
-  RC rc = log_handler_.append(
-      lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+  RC rc = append(span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)), lsn);
   if (OB_FAIL(rc)) {
     return rc;
   }
 
+  // 事务已经结束，回放时不再需要它之前的日志来重建事务
+  first_lsn_.store(0);
+
   // 我们在这里粗暴的等待日志写入到磁盘
   // 有必要的话，可以让上层来决定如何等待
   return log_handler_.wait_lsn(lsn);
@@ -128,8 +137,9 @@ RC MvccTrxLogHandler::rollback(int32_t trx_id)
   log_entry.header.trx_id         = trx_id;
 
   LSN lsn = 0;
-  return log_handler_.append(
-      lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+  RC  rc  = append(span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)), lsn);
+  first_lsn_.store(0);
+  return rc;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,7 +151,7 @@ RC MvccTrxLogReplayer::replay(const LogEntry &entry)
 {
   RC rc = RC::SUCCESS;
 
-  // 由于当前没有check point，所以所有的事务都重做。
+  // 从检查点开始回放。检查点不会超过活跃事务的第一条日志，见 MvccTrxKit::min_active_lsn
 
   ASSERT(entry.module().id() == LogModule::Id::TRANSACTION, "invalid log module id: %d", entry.module().id());
 
@@ -164,6 +174,12 @@ RC MvccTrxLogReplayer::replay(const LogEntry &entry)
   rc = trx->redo(&db_, entry);
 
   /// 如果事务结束了，需要从内存中把它删除
+  if (MvccTrxLogOperation(header->operation_type).type() == MvccTrxLogOperation::Type::COMMIT) {
+    // 提交ID也会写到记录中，重启后分配的事务ID不能和它重复
+    auto *commit_entry = reinterpret_cast<const MvccTrxCommitLogEntry *>(entry.data());
+    trx_kit_.init_trx_id(commit_entry->commit_trx_id);
+  }
+
   if (MvccTrxLogOperation(header->operation_type).type() == MvccTrxLogOperation::Type::ROLLBACK ||
       MvccTrxLogOperation(header->operation_type).type() == MvccTrxLogOperation::Type::COMMIT) {
     Trx *trx = trx_map_[header->trx_id];
@@ -16,6 +16,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/sys/rc.h"
 #include "common/types.h"
+#include "common/lang/atomic.h"
+#include "common/lang/span.h"
 #include "common/lang/string.h"
 #include "common/lang/unordered_map.h"
 #include "storage/record/record.h"
@@ -134,8 +136,18 @@ public:
    */
   RC rollback(int32_t trx_id);
 
+  /**
+   * @brief 事务的第一条日志的LSN，还没有写日志时返回0
+   * @details 在写第一条日志之前就记录下来，保证做检查点的线程看到的值不会比真实的LSN大
+   */
+  LSN first_lsn() const { return first_lsn_.load(); }
+
+private:
+  RC append(span<const char> data, LSN &lsn);
+
 private:
   LogHandler &log_handler_;
+  atomic<LSN> first_lsn_{0};
 };
 
 /**
@@ -46,3 +46,36 @@ TrxKit *TrxKit::create(const char *name, Db* db)
   
   return trx_kit;
 }
+
+RC Trx::insert_records(Table *table, vector<Record> &records)
+{
+  RC rc = RC::SUCCESS;
+  for (Record &record : records) {
+    if (OB_FAIL(rc = insert_record(table, record))) {
+      break;
+    }
+  }
+  return rc;
+}
+
+RC Trx::visit_records(Table *table, RecordPageHandler &page_handler, ReadWriteMode mode, vector<SlotNum> &slots)
+{
+  const PageNum page_num = page_handler.get_page_num();
+
+  RC     rc       = RC::SUCCESS;
+  size_t selected = 0;
+  Record record;
+  for (SlotNum slot_num : slots) {
+    rc = page_handler.get_record(RID(page_num, slot_num), record);
+    if (OB_SUCC(rc)) {
+      rc = visit_record(table, record, mode);
+    }
+    if (OB_SUCC(rc)) {
+      slots[selected++] = slot_num;
+    } else if (rc != RC::RECORD_INVISIBLE) {
+      break;
+    }
+  }
+  slots.resize(selected);
+  return rc == RC::RECORD_INVISIBLE ? RC::SUCCESS : rc;
+}
@@ -127,6 +127,21 @@ public:
 
   virtual void destroy_trx(Trx *trx) = 0;
 
+  /**
+   * @brief 活跃事务写下的第一条日志中最小的LSN
+   * @details 回放时需要通过这些日志重建未结束的事务，所以检查点不能超过这个LSN。
+   * 没有活跃事务或者事务不依赖日志回放时返回LSN的最大值。
+   */
+  virtual LSN min_active_lsn() { return numeric_limits<LSN>::max(); }
+
+  /**
+   * @brief 已经分配出去的最大事务ID
+   * @details 检查点之前的日志不会再回放，重启时无法从这些日志中知道用过哪些事务ID，
+   * 所以做检查点时要把它记录下来，重启时通过 init_trx_id 恢复
+   */
+  virtual int32_t current_trx_id() const { return 0; }
+  virtual void    init_trx_id(int32_t trx_id) {}
+
   virtual LogReplayer *create_log_replayer(Db &db, LogHandler &log_handler) = 0;
 
 public:
@@ -148,6 +163,21 @@ public:
   virtual RC update_record(Table *table, Record &old_record, Record &new_record) = 0;
   virtual RC visit_record(Table *table, Record &record, ReadWriteMode mode)      = 0;
 
+  /**
+   * @brief 插入一批记录
+   * @details 默认逐条调用 insert_record。多行 INSERT 和 LOAD DATA 使用
+   */
+  virtual RC insert_records(Table *table, vector<Record> &records);
+
+  /**
+   * @brief 批量判断一个页面上的记录是否可见
+   * @details 和 visit_record 的规则相同，扫描时每个页面只需要调用一次。默认逐条取出记录调用 visit_record
+   * @param page_handler 记录所在的页面
+   * @param slots 输入是要判断的槽位，返回时只保留可见的槽位。遇到冲突时只保留冲突之前的可见槽位
+   * @return 遇到冲突时返回 visit_record 的错误码，比如 LOCKED_CONCURRENCY_CONFLICT
+   */
+  virtual RC visit_records(Table *table, RecordPageHandler &page_handler, ReadWriteMode mode, vector<SlotNum> &slots);
+
   virtual RC start_if_need() = 0;
   virtual RC commit()        = 0;
   virtual RC rollback()      = 0;
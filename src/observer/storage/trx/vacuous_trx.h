@@ -44,12 +44,17 @@ public:
   virtual ~VacuousTrx() = default;
 
   RC insert_record(Table *table, Record &record) override;
+  RC insert_records(Table *table, vector<Record> &records) override;
   RC delete_record(Table *table, Record &record) override;
   RC update_record(Table *table, Record &old_record, Record &new_record) override { 
     // return RC::UNIMPLEMENTED; 
     return table->update_record_with_trx(old_record, new_record, this);
   }
   RC visit_record(Table *table, Record &record, ReadWriteMode mode) override;
+  RC visit_records(Table *table, RecordPageHandler &page_handler, ReadWriteMode mode, vector<SlotNum> &slots) override
+  {
+    return RC::SUCCESS;
+  }
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
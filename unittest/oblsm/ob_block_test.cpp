@@ -16,7 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 using namespace oceanbase;
 
-TEST(block_test, DISABLED_block_builder_test_basic)
+TEST(block_test, block_builder_test_basic)
 {
   ObBlockBuilder builder;
   ObDefaultComparator comparator;
@@ -29,11 +29,15 @@ TEST(block_test, DISABLED_block_builder_test_basic)
   string_view block_contents = builder.finish();
 
   ObBlock block(&comparator);
-  block.decode(string(block_contents.data(), block_contents.size()));
+  ASSERT_EQ(block.decode(string(block_contents.data(), block_contents.size())), RC::SUCCESS);
   ASSERT_EQ(block.size(), 4);
+  ASSERT_GE(block.memory_size(), block_contents.size());
+
+  ObBlock bad_block(&comparator);
+  ASSERT_NE(bad_block.decode(string(block_contents.data(), block_contents.size() - 1)), RC::SUCCESS);
 }
 
-TEST(block_test, DISABLED_block_iterator_test_basic)
+TEST(block_test, block_iterator_test_basic)
 {
   ObBlockBuilder builder;
   ObDefaultComparator comparator;
@@ -85,6 +85,31 @@ TEST(BloomFilterTest, MultiThreadInsertTest) {
     EXPECT_FALSE(bloom_filter.contains("non_existent_item"));
 }
 
+TEST(BloomfilterTest, EncodeAndDecodeTest) {
+    ObBloomfilter bf(7, 10 * 1000);
+    for (int i = 0; i < 1000; ++i) {
+        bf.insert("key" + std::to_string(i));
+    }
+
+    std::string data;
+    bf.encode(&data);
+    ObBloomfilter decoded;
+    ASSERT_EQ(decoded.decode(data), RC::SUCCESS);
+    EXPECT_EQ(decoded.object_count(), 1000);
+    int false_positives = 0;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(decoded.contains("key" + std::to_string(i)));
+        if (decoded.contains("other" + std::to_string(i))) {
+            false_positives++;
+        }
+    }
+    // about 1% with 10 bits per key
+    EXPECT_LT(false_positives, 50);
+
+    EXPECT_EQ(decoded.decode(std::string_view(data.data(), data.size() - 1)), RC::INVALID_ARGUMENT);
+    EXPECT_EQ(decoded.decode(""), RC::INVALID_ARGUMENT);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
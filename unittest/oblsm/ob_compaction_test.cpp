@@ -11,6 +11,7 @@ See the Mulan PSL v2 for more details. */
 #include "gtest/gtest.h"
 
 #include "common/lang/filesystem.h"
+#include "common/lang/map.h"
 #include "oblsm/include/ob_lsm.h"
 #include "oblsm/ob_lsm_impl.h"
 #include "unittest/oblsm/ob_lsm_test_base.h"
@@ -70,7 +71,7 @@ bool check_compaction(ObLsm* lsm)
   return true;
 }
 
-TEST_P(ObLsmCompactionTest, DISABLED_oblsm_compaction_test_basic1)
+TEST_P(ObLsmCompactionTest, oblsm_compaction_test_basic1)
 {
   size_t num_entries = GetParam();
   auto data = KeyValueGenerator::generate_data(num_entries);
@@ -100,7 +101,7 @@ void thread_put(ObLsm *db, int start, int end) {
   }
 }
 
-TEST_P(ObLsmCompactionTest, DISABLED_ConcurrentPutAndGetTest) {
+TEST_P(ObLsmCompactionTest, ConcurrentPutAndGetTest) {
   const int num_entries = GetParam();
   const int num_threads = 4;
   const int batch_size = num_entries / num_threads;
@@ -142,6 +143,37 @@ TEST_P(ObLsmCompactionTest, DISABLED_ConcurrentPutAndGetTest) {
   ASSERT_TRUE(check_compaction(db));
 }
 
+TEST_P(ObLsmCompactionTest, SnapshotSurvivesCompaction)
+{
+  size_t num_entries = GetParam();
+  auto   data        = KeyValueGenerator::generate_data(num_entries);
+
+  for (const auto &[key, value] : data) {
+    ASSERT_EQ(db->put(key, value), RC::SUCCESS);
+  }
+  // every put takes one sequence number, the transaction pins the versions written so far
+  ObLsmTransaction *txn = db->begin_transaction();
+  for (const auto &[key, value] : data) {
+    ASSERT_EQ(db->put(key, "new" + value), RC::SUCCESS);
+  }
+  // wait for compaction
+  sleep(1);
+
+  ObLsmReadOptions options;
+  options.seq = num_entries;
+  std::map<string, string> expected(data.begin(), data.end());
+  ObLsmIterator *it = db->new_iterator(options);
+  size_t count = 0;
+  for (it->seek_to_first(); it->valid(); it->next()) {
+    ASSERT_EQ(expected[string(it->key())], it->value());
+    ++count;
+  }
+  EXPECT_EQ(count, num_entries);
+  delete it;
+  delete txn;
+  ASSERT_TRUE(check_compaction(db));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ObLsmCompactionTests,
     ObLsmCompactionTest,
@@ -11,6 +11,8 @@ See the Mulan PSL v2 for more details. */
 #include "gtest/gtest.h"
 
 #include "common/lang/filesystem.h"
+#include "common/lang/map.h"
+#include "common/lang/memory.h"
 #include "common/lang/thread.h"
 #include "common/lang/utility.h"
 #include "oblsm/include/ob_lsm.h"
@@ -148,6 +150,106 @@ TEST_P(ObLsmTest, DISABLED_ConcurrentPutAndRecoverTest) {
   delete iterator;
 }
 
+TEST(ObLsmWriteBatchTest, write_and_recover)
+{
+  const string path = "./testdb_batch";
+  filesystem::remove_all(path);
+  filesystem::create_directory(path);
+  ObLsmOptions options;
+  ObLsm       *db = nullptr;
+  ASSERT_EQ(ObLsm::open(options, path, &db), RC::SUCCESS);
+
+  ObLsmWriteBatch batch;
+  for (int i = 0; i < 100; ++i) {
+    batch.put("key" + to_string(i), "value" + to_string(i));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    batch.remove("key" + to_string(i));
+  }
+  ASSERT_EQ(batch.count(), 150U);
+  ASSERT_EQ(db->write(&batch), RC::SUCCESS);
+  const uint64_t first_seq = batch.sequence();
+
+  // the second batch gets the sequence numbers after the first one
+  ObLsmWriteBatch batch2;
+  batch2.put("key0", "new_value0");
+  ASSERT_EQ(db->write(&batch2), RC::SUCCESS);
+  EXPECT_EQ(batch2.sequence(), first_seq + 150);
+  ASSERT_EQ(db->batch_put({{"key100", "value100"}, {"key101", "value101"}}), RC::SUCCESS);
+
+  for (int round = 0; round < 2; ++round) {
+    string value;
+    ASSERT_EQ(db->get("key0", &value), RC::SUCCESS);
+    EXPECT_EQ(value, "new_value0");
+    EXPECT_EQ(db->get("key2", &value), RC::NOT_EXIST);
+    ASSERT_EQ(db->get("key3", &value), RC::SUCCESS);
+    EXPECT_EQ(value, "value3");
+    ASSERT_EQ(db->get("key101", &value), RC::SUCCESS);
+    EXPECT_EQ(value, "value101");
+
+    // recover from the wal
+    delete db;
+    db = nullptr;
+    ASSERT_EQ(ObLsm::open(options, path, &db), RC::SUCCESS);
+  }
+  delete db;
+}
+
+TEST(ObLsmGetTest, get_from_memtables_and_sstables)
+{
+  const string path = "./testdb_get";
+  filesystem::remove_all(path);
+  filesystem::create_directory(path);
+  ObLsmOptions options;
+  options.memtable_size = 8 * 1024;
+  ObLsm *db             = nullptr;
+  ASSERT_EQ(ObLsm::open(options, path, &db), RC::SUCCESS);
+
+  // many small memtables are flushed into sstables, the later rounds overwrite or delete the keys of the earlier
+  const int        num_keys = 2000;
+  map<int, string> expected;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = round; i < num_keys; i += round + 1) {
+      const string key = "key" + to_string(i);
+      if (round == 2 && i % 5 == 0) {
+        ASSERT_EQ(db->remove(key), RC::SUCCESS);
+        expected.erase(i);
+      } else {
+        const string value = "value" + to_string(i) + "_" + to_string(round);
+        ASSERT_EQ(db->put(key, value), RC::SUCCESS);
+        expected[i] = value;
+      }
+    }
+  }
+
+  for (int pass = 0; pass < 2; ++pass) {
+    string value;
+    for (int i = 0; i < num_keys + 100; ++i) {
+      RC rc = db->get("key" + to_string(i), &value);
+      if (expected.count(i) > 0) {
+        ASSERT_EQ(rc, RC::SUCCESS) << i;
+        ASSERT_EQ(value, expected[i]);
+      } else {
+        ASSERT_EQ(rc, RC::NOT_EXIST) << i;
+      }
+    }
+
+    // the iterator sees the same data
+    unique_ptr<ObLsmIterator> iter(db->new_iterator(ObLsmReadOptions()));
+    size_t                    count = 0;
+    for (iter->seek_to_first(); iter->valid(); iter->next()) {
+      count++;
+    }
+    ASSERT_EQ(count, expected.size());
+
+    // recover from the sstables and the wal
+    delete db;
+    db = nullptr;
+    ASSERT_EQ(ObLsm::open(options, path, &db), RC::SUCCESS);
+  }
+  delete db;
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ObLsmTests,
     ObLsmTest,
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include "gtest/gtest.h"
 
 #include "common/lang/filesystem.h"
+#include "common/lang/fstream.h"
 #include "oblsm/wal/ob_lsm_wal.h"
 #include "oblsm/include/ob_lsm.h"
 #include "oblsm/include/ob_lsm_options.h"
@@ -20,7 +21,7 @@ See the Mulan PSL v2 for more details. */
 
 using namespace oceanbase;
 
-TEST(wal, DISABLED_basic_test)
+TEST(wal, basic_test)
 {
   filesystem::remove_all("oblsm_tmp");
   filesystem::create_directory("oblsm_tmp");
@@ -53,7 +54,44 @@ TEST(wal, DISABLED_basic_test)
   EXPECT_EQ(p, count);
 }
 
-TEST(oblsm_wal_test, DISABLED_oblsm_recover_with_small_amount_of_data)
+TEST(wal, torn_tail)
+{
+  filesystem::remove_all("oblsm_tmp");
+  filesystem::create_directory("oblsm_tmp");
+  auto rw_file = filesystem::path("oblsm_tmp") / "tmp.wal";
+  {
+    WAL wal;
+    EXPECT_EQ(wal.open(rw_file), RC::SUCCESS);
+    for (auto i = 0; i < 10; ++i) {
+      EXPECT_EQ(wal.put(i, "key" + std::to_string(i), "val" + std::to_string(i)), RC::SUCCESS);
+    }
+    EXPECT_EQ(wal.sync(), RC::SUCCESS);
+  }
+
+  // a crash in the middle of writing the last record
+  auto size = filesystem::file_size(rw_file);
+  filesystem::resize_file(rw_file, size - 3);
+
+  WAL                    wal;
+  std::vector<WalRecord> records;
+  EXPECT_EQ(wal.recover(rw_file, records), RC::SUCCESS);
+  ASSERT_EQ(records.size(), 9);
+  EXPECT_EQ(records.back().seq, 8);
+  EXPECT_EQ(records.back().key, "key8");
+
+  // a corrupted record and the records after it are dropped
+  filesystem::resize_file(rw_file, size);
+  {
+    std::fstream file(rw_file, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(size / 2);
+    file.put('x');
+  }
+  records.clear();
+  EXPECT_EQ(wal.recover(rw_file, records), RC::SUCCESS);
+  EXPECT_LT(records.size(), 9);
+}
+
+TEST(oblsm_wal_test, oblsm_recover_with_small_amount_of_data)
 {
   filesystem::remove_all("oblsm_tmp");
   filesystem::create_directory("oblsm_tmp");
@@ -169,7 +207,7 @@ TEST(oblsm_wal_test, DISABLED_oblsm_recover_with_concurrent_put_no_sync)
   delete lsm;
 }
 
-TEST(oblsm_wal_test, DISABLED_oblsm_recover_with_concurrent_put_sync)
+TEST(oblsm_wal_test, oblsm_recover_with_concurrent_put_sync)
 {
   filesystem::remove_all("oblsm_tmp");
   filesystem::create_directory("oblsm_tmp");
@@ -14,10 +14,11 @@ See the Mulan PSL v2 for more details. */
 #include "oblsm/util/ob_comparator.h"
 #include "oblsm/table/ob_sstable_builder.h"
 #include "oblsm/table/ob_sstable.h"
+#include "oblsm/util/ob_coding.h"
 
 using namespace oceanbase;
 
-TEST(table_test, DISABLED_table_test_basic)
+TEST(table_test, table_test_basic)
 {
   ObDefaultComparator comparator;
   shared_ptr<ObMemTable> table = make_shared<ObMemTable>();
@@ -32,14 +33,128 @@ TEST(table_test, DISABLED_table_test_basic)
   shared_ptr<ObSSTable> sst = tb.get_built_table();
   ObLsmIterator* sst_iter = sst->new_iterator();
   sst_iter->seek_to_first();
+  size_t scanned = 0;
   while(sst_iter->valid()) {
-    cout << sst_iter->key() << " " << sst_iter->value() << endl;
+    ASSERT_EQ(extract_user_key(sst_iter->key()), to_string(scanned));
+    ASSERT_EQ(sst_iter->value(), to_string(scanned));
+    scanned++;
     sst_iter->next();
   }
+  ASSERT_EQ(scanned, count);
   delete sst_iter;
+  sst->remove();
+}
+
+TEST(table_test, table_test_block_cache)
+{
+  ObDefaultComparator comparator;
+  shared_ptr<ObMemTable> table = make_shared<ObMemTable>();
+  uint64_t seq = 0;
+  size_t count = 1000;
+  for (size_t i = 0; i < count; i++) {
+    char key[16];
+    snprintf(key, sizeof(key), "%08zu", i);
+    table->put(seq++, key, string(64, 'v'));
+  }
+
+  ObLRUCache<uint64_t, shared_ptr<ObBlock>> block_cache(1024 * 1024, 2);
+  ObSSTableBuilder tb(&comparator, &block_cache);
+  ASSERT_EQ(tb.build(table, "test_cache.sst", 1), RC::SUCCESS);
+  shared_ptr<ObSSTable> sst = tb.get_built_table();
+  ASSERT_GT(sst->block_count(), 1);
+
+  auto scan = [&sst, count]() {
+    unique_ptr<ObLsmIterator> sst_iter(sst->new_iterator());
+    size_t scanned = 0;
+    for (sst_iter->seek_to_first(); sst_iter->valid(); sst_iter->next()) {
+      scanned++;
+    }
+    ASSERT_EQ(scanned, count);
+  };
+
+  // cold, every block is read from file
+  scan();
+  ASSERT_EQ(block_cache.hits(), 0);
+  ASSERT_EQ(block_cache.misses(), sst->block_count());
+  size_t usage = 0;
+  for (uint32_t i = 0; i < sst->block_count(); i++) {
+    usage += sst->read_block(i)->memory_size();
+  }
+  ASSERT_EQ(block_cache.usage(), usage);
 
+  // warm
+  scan();
+  ASSERT_EQ(block_cache.hits(), sst->block_count());
+  ASSERT_EQ(block_cache.misses(), sst->block_count());
+
+  // the blocks of a removed sstable are dropped from cache
+  sst->remove();
+  ASSERT_EQ(block_cache.usage(), 0);
 }
 
+TEST(table_test, table_test_get)
+{
+  ObDefaultComparator comparator;
+  shared_ptr<ObMemTable> table = make_shared<ObMemTable>();
+  size_t count = 1000;
+  // even keys, every key has two versions, the newer one of key 10 is a deletion
+  for (size_t i = 0; i < count; i += 2) {
+    char key[16];
+    snprintf(key, sizeof(key), "%08zu", i);
+    table->put(i, key, "old" + to_string(i));
+    table->put(i + count, key, i == 10 ? "" : "new" + to_string(i));
+  }
+
+  auto lookup_key = [](const string &user_key, uint64_t seq) {
+    string key;
+    put_numeric<uint64_t>(&key, user_key.size() + SEQ_SIZE);
+    key.append(user_key);
+    put_numeric<uint64_t>(&key, seq);
+    return key;
+  };
+
+  ObSSTableBuilder tb(&comparator, nullptr, 10);
+  ASSERT_EQ(tb.build(table, "test_get.sst", 2), RC::SUCCESS);
+  ASSERT_GT(tb.get_built_table()->block_count(), 1);
+  // the bloom filter is read from file
+  shared_ptr<ObSSTable> sst = make_shared<ObSSTable>(2, "test_get.sst", &comparator, nullptr);
+  sst->init();
+  ASSERT_GT(sst->block_count(), 1);
+
+  string value;
+  for (size_t i = 0; i < count; i++) {
+    char key[16];
+    snprintf(key, sizeof(key), "%08zu", i);
+    if (i % 2 == 1) {
+      ASSERT_EQ(sst->get(lookup_key(key, 2 * count), &value), RC::NOT_EXIST);
+      continue;
+    }
+    ASSERT_EQ(sst->get(lookup_key(key, 2 * count), &value), RC::SUCCESS);
+    ASSERT_EQ(value, i == 10 ? "" : "new" + to_string(i));
+    // the newer version is not visible
+    ASSERT_EQ(sst->get(lookup_key(key, count - 1), &value), RC::SUCCESS);
+    ASSERT_EQ(value, "old" + to_string(i));
+    // neither version is visible
+    if (i > 0) {
+      ASSERT_EQ(sst->get(lookup_key(key, i - 1), &value), RC::NOT_EXIST);
+    }
+  }
+
+  // out of the key range
+  ASSERT_FALSE(sst->may_contain("0"));
+  ASSERT_FALSE(sst->may_contain("99999999"));
+  // most of the absent keys are filtered out by the bloom filter
+  size_t false_positives = 0;
+  for (size_t i = 1; i < count; i += 2) {
+    char key[16];
+    snprintf(key, sizeof(key), "%08zu", i);
+    if (sst->may_contain(key)) {
+      false_positives++;
+    }
+  }
+  ASSERT_LT(false_positives, count / 20);
+  sst->remove();
+}
 
 int main(int argc, char **argv)
 {
@@ -16,7 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
-TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
+TEST(AggregateHashTableTest, standard_hash_table)
 {
   // single group by column, single aggregate column
   {
@@ -87,8 +87,8 @@ TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
         make_unique<Column>(group_chunk.column(0).attr_type(), group_chunk.column(0).attr_len()), 0);
     output_chunk.add_column(
         make_unique<Column>(group_chunk.column(1).attr_type(), group_chunk.column(1).attr_len()), 1);
-    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(0).attr_type(), aggr_chunk.column(0).attr_len()), 1);
-    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(1).attr_type(), aggr_chunk.column(1).attr_len()), 2);
+    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(0).attr_type(), aggr_chunk.column(0).attr_len()), 2);
+    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(1).attr_type(), aggr_chunk.column(1).attr_len()), 3);
     StandardAggregateHashTable::Scanner scanner(standard_hash_table.get());
     scanner.open_scan();
     rc = scanner.next(output_chunk);
@@ -103,8 +103,62 @@ TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
   }
 }
 
+TEST(AggregateHashTableTest, standard_hash_table_aggregate_types)
+{
+  Chunk                   group_chunk;
+  Chunk                   aggr_chunk;
+  std::unique_ptr<Column> group = std::make_unique<Column>(AttrType::INTS, 4);
+  std::unique_ptr<Column> aggr1 = std::make_unique<Column>(AttrType::INTS, 4);
+  std::unique_ptr<Column> aggr2 = std::make_unique<Column>(AttrType::INTS, 4);
+  std::unique_ptr<Column> aggr3 = std::make_unique<Column>(AttrType::INTS, 4);
+  std::unique_ptr<Column> aggr4 = std::make_unique<Column>(AttrType::INTS, 4);
+  for (int i = 0; i < 1000; i++) {
+    int key = i % 4;
+    group->append_one((char *)&key);
+    aggr1->append_one((char *)&i);
+    aggr2->append_one((char *)&i);
+    aggr3->append_one((char *)&i);
+    aggr4->append_one((char *)&i);
+  }
+  group_chunk.add_column(std::move(group), 0);
+  aggr_chunk.add_column(std::move(aggr1), 0);
+  aggr_chunk.add_column(std::move(aggr2), 1);
+  aggr_chunk.add_column(std::move(aggr3), 2);
+  aggr_chunk.add_column(std::move(aggr4), 3);
+
+  AggregateExpr              count_expr(AggregateExpr::Type::COUNT, nullptr);
+  AggregateExpr              avg_expr(AggregateExpr::Type::AVG, nullptr);
+  AggregateExpr              max_expr(AggregateExpr::Type::MAX, nullptr);
+  AggregateExpr              min_expr(AggregateExpr::Type::MIN, nullptr);
+  std::vector<Expression *>  aggregate_exprs{&count_expr, &avg_expr, &max_expr, &min_expr};
+  StandardAggregateHashTable hash_table(aggregate_exprs);
+  // 分两次写入，聚合结果需要累加
+  ASSERT_EQ(hash_table.add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+  ASSERT_EQ(hash_table.add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+
+  Chunk output_chunk;
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+  output_chunk.add_column(make_unique<Column>(AttrType::FLOATS, 4), 2);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 3);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 4);
+  StandardAggregateHashTable::Scanner scanner(&hash_table);
+  scanner.open_scan();
+  ASSERT_EQ(scanner.next(output_chunk), RC::SUCCESS);
+  ASSERT_EQ(output_chunk.rows(), 4);
+  for (int i = 0; i < output_chunk.rows(); i++) {
+    int key = output_chunk.get_value(0, i).get_int();
+    ASSERT_EQ(output_chunk.get_value(1, i).get_int(), 500);
+    ASSERT_FLOAT_EQ(output_chunk.get_value(2, i).get_float(), 498.0f + key);
+    ASSERT_EQ(output_chunk.get_value(3, i).get_int(), 996 + key);
+    ASSERT_EQ(output_chunk.get_value(4, i).get_int(), key);
+  }
+  output_chunk.reset_data();
+  ASSERT_EQ(scanner.next(output_chunk), RC::RECORD_EOF);
+}
+
 #ifdef USE_SIMD
-TEST(AggregateHashTableTest, DISABLED_linear_probing_hash_table)
+TEST(AggregateHashTableTest, linear_probing_hash_table)
 {
   // simple case
   {
@@ -174,6 +228,31 @@ TEST(AggregateHashTableTest, DISABLED_linear_probing_hash_table)
     ASSERT_STREQ(output_chunk.get_value(1, 0).get_string().c_str(), "501");
     ASSERT_STREQ(output_chunk.get_value(1, 1).get_string().c_str(), "501");
   }
+
+  // many distinct keys, the hash table needs to resize while adding a batch
+  {
+    Chunk                   group_chunk;
+    Chunk                   aggr_chunk;
+    std::unique_ptr<Column> column1 = std::make_unique<Column>(AttrType::INTS, 4);
+    std::unique_ptr<Column> column2 = std::make_unique<Column>(AttrType::INTS, 4);
+    for (int i = 0; i < 8000; i++) {
+      int key = i % 3000, value = 1;
+      column1->append_one((char *)&key);
+      column2->append_one((char *)&value);
+    }
+    group_chunk.add_column(std::move(column1), 0);
+    aggr_chunk.add_column(std::move(column2), 1);
+
+    auto linear_probing_hash_table =
+        std::make_unique<LinearProbingAggregateHashTable<int>>(AggregateExpr::Type::SUM, 256);
+    ASSERT_EQ(linear_probing_hash_table->add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+    ASSERT_EQ(linear_probing_hash_table->size(), 3000);
+    for (int key = 0; key < 3000; key++) {
+      int value = 0;
+      ASSERT_EQ(linear_probing_hash_table->get(key, value), RC::SUCCESS);
+      ASSERT_EQ(value, key < 2000 ? 3 : 2);
+    }
+  }
 }
 #endif
 
@@ -125,6 +125,188 @@ TEST(test_frame_manager, test_frame_manager_simple_lru)
   frame_manager.cleanup();
 }
 
+TEST(test_frame_manager, test_frame_manager_shards_and_replacers)
+{
+  for (FrameReplacerType type : {FrameReplacerType::LRU, FrameReplacerType::CLOCK, FrameReplacerType::LRU_K}) {
+    for (int shard_num : {1, 3, 16}) {
+      BPFrameManager frame_manager("Test");
+      ASSERT_EQ(RC::SUCCESS, frame_manager.init(2, shard_num, type));
+      ASSERT_EQ(type, frame_manager.replacer_type());
+      ASSERT_EQ(0, frame_manager.shard_num() & (frame_manager.shard_num() - 1));
+
+      test_get(frame_manager);
+      test_alloc(frame_manager);
+    }
+  }
+}
+
+TEST(test_frame_manager, test_frame_manager_purge)
+{
+  BPFrameManager frame_manager("Test");
+  ASSERT_EQ(RC::SUCCESS, frame_manager.init(1, 4, FrameReplacerType::LRU_K));
+
+  const int buffer_pool_id = 0;
+  PageNum   page_num       = 0;
+  for (; true; page_num++) {
+    Frame *frame = frame_manager.alloc(buffer_pool_id, page_num);
+    if (frame == nullptr) {
+      break;
+    }
+    frame->unpin();
+  }
+  ASSERT_EQ(static_cast<size_t>(page_num), frame_manager.frame_num());
+
+  // 第0页一直被pin住，不能被淘汰
+  Frame *pinned = frame_manager.get(buffer_pool_id, 0);
+  ASSERT_NE(pinned, nullptr);
+
+  int purged = 0;
+  auto purger = [&purged](Frame *frame) {
+    purged++;
+    return RC::SUCCESS;
+  };
+  ASSERT_EQ(page_num - 1, frame_manager.purge_frames(page_num, purger));
+  ASSERT_EQ(page_num - 1, purged);
+  ASSERT_EQ(1UL, frame_manager.frame_num());
+  ASSERT_EQ(pinned, frame_manager.get(buffer_pool_id, 0));
+
+  // purger 失败的页帧不会被淘汰
+  pinned->unpin();
+  pinned->unpin();
+  ASSERT_EQ(0, frame_manager.purge_frames(1, [](Frame *) { return RC::IOERR_WRITE; }));
+  ASSERT_EQ(1UL, frame_manager.frame_num());
+  ASSERT_EQ(1, frame_manager.purge_frames(1, purger));
+  ASSERT_EQ(RC::SUCCESS, frame_manager.cleanup());
+}
+
+TEST(test_frame_manager, test_frame_manager_scan_resistant)
+{
+  for (FrameReplacerType type : {FrameReplacerType::LRU, FrameReplacerType::CLOCK, FrameReplacerType::LRU_K}) {
+    BPFrameManager frame_manager("Test");
+    ASSERT_EQ(RC::SUCCESS, frame_manager.init(1, 1, type));
+
+    // 一半页帧是反复访问的热点页面
+    const int buffer_pool_id = 0;
+    const int hot_num        = static_cast<int>(frame_manager.total_frame_num() / 2);
+    for (PageNum page_num = 0; page_num < hot_num; page_num++) {
+      Frame *frame = frame_manager.alloc(buffer_pool_id, page_num);
+      ASSERT_NE(frame, nullptr);
+      frame->unpin();
+      frame_manager.get(buffer_pool_id, page_num)->unpin();
+    }
+
+    // 扫描一个很大的文件，内存不够时只淘汰扫描读入的页面
+    auto purger = [](Frame *) { return RC::SUCCESS; };
+    for (PageNum page_num = 0; page_num < hot_num * 4; page_num++) {
+      Frame *frame = frame_manager.alloc(buffer_pool_id + 1, page_num, BufferAccessMode::SCAN);
+      if (frame == nullptr) {
+        ASSERT_EQ(1, frame_manager.purge_frames(1, purger));
+        frame = frame_manager.alloc(buffer_pool_id + 1, page_num, BufferAccessMode::SCAN);
+        ASSERT_NE(frame, nullptr);
+      }
+      frame->unpin();
+
+      // 扫描也可能碰到热点页面，但是不会影响它们的淘汰顺序
+      Frame *hot_frame = frame_manager.get(buffer_pool_id, page_num % hot_num, BufferAccessMode::SCAN);
+      ASSERT_NE(hot_frame, nullptr) << frame_replacer_type_name(type);
+      hot_frame->unpin();
+    }
+    ASSERT_EQ(frame_manager.total_frame_num() - hot_num, frame_manager.scan_frame_num());
+
+    // 扫描读入的页面被普通访问后，交给淘汰策略管理
+    Frame *frame = frame_manager.get(buffer_pool_id + 1, hot_num * 4 - 1);
+    ASSERT_NE(frame, nullptr);
+    frame->unpin();
+    ASSERT_EQ(frame_manager.total_frame_num() - hot_num - 1, frame_manager.scan_frame_num());
+
+    const int frame_num = static_cast<int>(frame_manager.frame_num());
+    ASSERT_EQ(frame_num, frame_manager.purge_frames(frame_num, purger));
+    ASSERT_EQ(0UL, frame_manager.scan_frame_num());
+    ASSERT_EQ(RC::SUCCESS, frame_manager.cleanup());
+  }
+}
+
+static vector<Frame *> victims_of(FrameReplacer &replacer)
+{
+  vector<Frame *> victims;
+  replacer.foreach_victim([&victims](Frame *frame) {
+    victims.push_back(frame);
+    return true;
+  });
+  return victims;
+}
+
+TEST(test_frame_replacer, lru)
+{
+  Frame            frames[3];
+  LruFrameReplacer replacer;
+  for (Frame &frame : frames) {
+    replacer.insert(&frame);
+  }
+  replacer.access(&frames[0]);
+
+  vector<Frame *> expected{&frames[1], &frames[2], &frames[0]};
+  ASSERT_EQ(expected, victims_of(replacer));
+
+  replacer.remove(&frames[2]);
+  expected = {&frames[1], &frames[0]};
+  ASSERT_EQ(expected, victims_of(replacer));
+}
+
+TEST(test_frame_replacer, clock)
+{
+  Frame              frames[3];
+  ClockFrameReplacer replacer;
+  for (Frame &frame : frames) {
+    replacer.insert(&frame);
+  }
+
+  // 第一圈清理所有的访问位，第二圈开始才有淘汰候选
+  vector<Frame *> expected{&frames[0], &frames[1], &frames[2]};
+  ASSERT_EQ(expected, victims_of(replacer));
+
+  // 被访问过的页帧会再得到一次机会
+  replacer.access(&frames[0]);
+  Frame *victim = nullptr;
+  replacer.foreach_victim([&victim](Frame *frame) {
+    victim = frame;
+    return false;
+  });
+  ASSERT_EQ(&frames[1], victim);
+
+  replacer.remove(&frames[2]);
+  expected = {&frames[0], &frames[1]};
+  ASSERT_EQ(expected, victims_of(replacer));
+}
+
+TEST(test_frame_replacer, lru_k_scan_resistant)
+{
+  Frame             hot[2];
+  Frame             scan[4];
+  LruKFrameReplacer replacer(2);
+
+  for (Frame &frame : hot) {
+    replacer.insert(&frame);
+    replacer.access(&frame);
+  }
+
+  // 全表扫描的页面只访问一次，它们会先于热点页面被淘汰
+  for (Frame &frame : scan) {
+    replacer.insert(&frame);
+  }
+  // 按照倒数第2次访问的时间，hot[0] 比 hot[1] 更晚
+  replacer.access(&hot[0]);
+  replacer.access(&hot[0]);
+
+  vector<Frame *> expected{&scan[0], &scan[1], &scan[2], &scan[3], &hot[1], &hot[0]};
+  ASSERT_EQ(expected, victims_of(replacer));
+
+  replacer.remove(&scan[1]);
+  replacer.remove(&hot[1]);
+  expected = {&scan[0], &scan[2], &scan[3], &hot[0]};
+  ASSERT_EQ(expected, victims_of(replacer));
+}
+
 int main(int argc, char **argv)
 {
 
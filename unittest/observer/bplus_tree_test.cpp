@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include <list>
 #include <filesystem>
 
+#include "common/lang/bitmap.h"
 #include "common/log/log.h"
 #include "common/lang/memory.h"
 #include "common/lang/filesystem.h"
@@ -826,6 +827,109 @@ TEST(test_bplus_tree, test_bplus_tree_insert)
   handler = nullptr;
 }
 
+// 与逐个字段构造Value比较的结果保持一致
+int compare_key_by_value(const IndexKeyFieldMeta *attr_infos, int attr_cnt, const char *v1, const char *v2)
+{
+  Bitmap v1_null_bitmap{const_cast<char *>(v1), INDEX_NULL_BITMAP_LENGTH};
+  Bitmap v2_null_bitmap{const_cast<char *>(v2), INDEX_NULL_BITMAP_LENGTH};
+  for (int i = 0; i < attr_cnt; i++) {
+    if (v1_null_bitmap.get_bit(i)) {
+      return -1;
+    }
+    if (v2_null_bitmap.get_bit(i)) {
+      return 1;
+    }
+    Value left(attr_infos[i].attr_type_, const_cast<char *>(v1 + attr_infos[i].attr_offset_), attr_infos[i].attr_len_);
+    Value right(attr_infos[i].attr_type_, const_cast<char *>(v2 + attr_infos[i].attr_offset_), attr_infos[i].attr_len_);
+    int   result = left.compare(right);
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+void fill_key(const IndexKeyFieldMeta *attr_infos, int attr_cnt, int seed, char *key)
+{
+  key[0] = 0;
+  for (int i = 0; i < attr_cnt; i++) {
+    const IndexKeyFieldMeta &attr_info = attr_infos[i];
+    char                    *data      = key + attr_info.attr_offset_;
+    const int                v         = (seed >> (i * 3)) % 5;
+    if (v == 4) {
+      key[0] |= (1 << i);
+      memset(data, 0, attr_info.attr_len_);
+      continue;
+    }
+    switch (attr_info.attr_type_) {
+      case AttrType::INTS: {
+        int value = v - 2;
+        memcpy(data, &value, sizeof(value));
+      } break;
+      case AttrType::FLOATS: {
+        float value = (v - 2) * 0.5f;
+        memcpy(data, &value, sizeof(value));
+      } break;
+      case AttrType::DATES: {
+        int value = ((2000 + v) << 16) | ((v + 1) << 8) | (5 - v);
+        memcpy(data, &value, sizeof(value));
+      } break;
+      case AttrType::CHARS: {
+        const char *values[] = {"", "a", "ab", "abcd"};
+        memset(data, 0, attr_info.attr_len_);
+        memcpy(data, values[v], std::min<int>(strlen(values[v]), attr_info.attr_len_));
+      } break;
+      default: break;
+    }
+  }
+}
+
+TEST(test_bplus_tree, test_key_comparator)
+{
+  const int         attr_cnt = 4;
+  IndexKeyFieldMeta attr_infos[attr_cnt] = {
+      {AttrType::CHARS, 1, 4},
+      {AttrType::INTS, 5, 4},
+      {AttrType::FLOATS, 9, 4},
+      {AttrType::DATES, 13, 4},
+  };
+  const int key_len = 17;
+
+  for (int comp_cnt = 1; comp_cnt <= attr_cnt; comp_cnt++) {
+    AttrComparator comparator;
+    comparator.init(attr_infos, attr_cnt, comp_cnt);
+    ASSERT_EQ(key_len, comparator.length());
+
+    for (int seed1 = 0; seed1 < 512; seed1 += 7) {
+      for (int seed2 = 0; seed2 < 512; seed2 += 5) {
+        char key1[key_len];
+        char key2[key_len];
+        fill_key(attr_infos, attr_cnt, seed1, key1);
+        fill_key(attr_infos, attr_cnt, seed2, key2);
+        ASSERT_EQ(compare_key_by_value(attr_infos, comp_cnt, key1, key2), comparator(key1, key2));
+      }
+    }
+  }
+
+  // 单列索引走按照类型特化的比较函数
+  for (int i = 0; i < attr_cnt; i++) {
+    IndexKeyFieldMeta attr_info = attr_infos[i];
+    attr_info.attr_offset_      = INDEX_NULL_BITMAP_LENGTH;
+
+    AttrComparator comparator;
+    comparator.init(&attr_info, 1);
+    for (int seed1 = 0; seed1 < 5; seed1++) {
+      for (int seed2 = 0; seed2 < 5; seed2++) {
+        char key1[key_len];
+        char key2[key_len];
+        fill_key(&attr_info, 1, seed1, key1);
+        fill_key(&attr_info, 1, seed2, key2);
+        ASSERT_EQ(compare_key_by_value(&attr_info, 1, key1, key2), comparator(key1, key2));
+      }
+    }
+  }
+}
+
 int main(int argc, char **argv)
 {
 
@@ -60,6 +60,160 @@ TEST(ChunkTest, chunk_test)
   }
 }
 
+TEST(ChunkTest, selection)
+{
+  int   row_num = 8;
+  Chunk chunk;
+  chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), row_num), 3);
+  chunk.add_column(std::make_unique<Column>(AttrType::FLOATS, sizeof(float), row_num), 5);
+  for (int i = 0; i < row_num; i++) {
+    int   value1 = i;
+    float value2 = i + 0.5f;
+    chunk.column(0).append_one((char *)&value1);
+    chunk.column(1).append_one((char *)&value2);
+  }
+  ASSERT_EQ(chunk.column_index(5), 1);
+  ASSERT_EQ(chunk.column_index(4), -1);
+
+  // 只选中奇数行，数据不会移动
+  vector<uint8_t> select(row_num, 0);
+  for (int i = 1; i < row_num; i += 2) {
+    select[i] = 1;
+  }
+  chunk.set_selection(select);
+  ASSERT_TRUE(chunk.has_selection());
+  ASSERT_EQ(chunk.rows(), row_num / 2);
+  ASSERT_EQ(chunk.column(0).count(), row_num);
+
+  Chunk chunk2;
+  chunk2.reference(chunk);
+  ASSERT_EQ(chunk2.rows(), row_num / 2);
+  for (int i = 0; i < chunk2.rows(); i++) {
+    ASSERT_EQ(chunk2.get_value(0, i).get_int(), 2 * i + 1);
+  }
+
+  // 需要紧凑的数据时拷贝出被选中的行
+  Column column;
+  ASSERT_EQ(chunk2.get_column(1, column), RC::SUCCESS);
+  ASSERT_EQ(column.count(), row_num / 2);
+  for (int i = 0; i < column.count(); i++) {
+    ASSERT_EQ(column.get_value(i).get_float(), 2 * i + 1.5f);
+  }
+
+  chunk.reset_data();
+  ASSERT_FALSE(chunk.has_selection());
+  ASSERT_EQ(chunk.rows(), 0);
+}
+
+TEST(ColumnTest, null_bitmap)
+{
+  int    row_num = 8;
+  Column column(AttrType::INTS, sizeof(int), row_num);
+  for (int i = 0; i < row_num; i++) {
+    if (i % 3 == 0) {
+      ASSERT_EQ(column.append_null(), RC::SUCCESS);
+    } else {
+      ASSERT_EQ(column.append_one((char *)&i), RC::SUCCESS);
+    }
+  }
+  ASSERT_TRUE(column.has_null());
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(column.is_null(i), i % 3 == 0);
+    Value value = column.get_value(i);
+    ASSERT_EQ(value.is_null(), i % 3 == 0);
+    ASSERT_EQ(value.attr_type(), AttrType::INTS);
+    if (!value.is_null()) {
+      ASSERT_EQ(value.get_int(), i);
+    }
+  }
+
+  // 引用和按行取出都会保留 NULL
+  Column ref;
+  ref.reference(column);
+  ASSERT_TRUE(ref.is_null(3));
+  Column gathered;
+  gathered.gather(column, {1, 3, 6, 7});
+  ASSERT_EQ(gathered.count(), 4);
+  ASSERT_FALSE(gathered.is_null(0));
+  ASSERT_TRUE(gathered.is_null(1));
+  ASSERT_TRUE(gathered.is_null(2));
+  ASSERT_EQ(gathered.get_value(3).get_int(), 7);
+
+  column.reset_data();
+  ASSERT_FALSE(column.has_null());
+  int value = 1;
+  ASSERT_EQ(column.append_one((char *)&value), RC::SUCCESS);
+  ASSERT_FALSE(column.is_null(0));
+
+  // 常量列的 NULL
+  Value null_value;
+  null_value.set_type(AttrType::INTS);
+  null_value.set_null(true);
+  Column constant;
+  constant.init(null_value);
+  ASSERT_TRUE(constant.is_null(5));
+  ASSERT_TRUE(constant.get_value(5).is_null());
+}
+
+TEST(ColumnTest, varlen)
+{
+  const char *strs[] = {"hello", "", "miniob", "a longer string than the others"};
+  Column      column;
+  column.init_varlen(AttrType::CHARS, 64, 8);
+  for (const char *str : strs) {
+    ASSERT_EQ(column.append_string(str, strlen(str)), RC::SUCCESS);
+  }
+  ASSERT_EQ(column.append_null(), RC::SUCCESS);
+  ASSERT_EQ(column.count(), 5);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(column.get_string(i), string_view(strs[i]));
+    ASSERT_EQ(column.get_value(i).get_string(), strs[i]);
+  }
+  ASSERT_TRUE(column.get_value(4).is_null());
+
+  Column gathered;
+  gathered.gather(column, {4, 2, 0});
+  ASSERT_EQ(gathered.column_type(), Column::Type::VARLEN_COLUMN);
+  ASSERT_TRUE(gathered.is_null(0));
+  ASSERT_EQ(gathered.get_string(1), "miniob");
+  ASSERT_EQ(gathered.get_string(2), "hello");
+
+  // 定长的字符串去掉末尾的 '\0'
+  Column fixed(AttrType::CHARS, 8, 2);
+  char   data[8] = "abc";
+  ASSERT_EQ(fixed.append_one(data), RC::SUCCESS);
+  ASSERT_EQ(fixed.get_string(0), "abc");
+}
+
+TEST(ColumnTest, dictionary)
+{
+  auto dictionary = make_shared<Column>();
+  dictionary->init_varlen(AttrType::CHARS, 16, 4);
+  dictionary->append_string("red", 3);
+  dictionary->append_string("green", 5);
+
+  Column column;
+  column.init_dictionary(dictionary, 8);
+  int codes[] = {1, 0, 0, 1, 1};
+  for (int code : codes) {
+    ASSERT_EQ(column.append_code(code), RC::SUCCESS);
+  }
+  ASSERT_EQ(column.append_code(2), RC::INVALID_ARGUMENT);
+  ASSERT_EQ(column.append_null(), RC::SUCCESS);
+  ASSERT_EQ(column.attr_type(), AttrType::CHARS);
+  ASSERT_EQ(column.get_string(0), "green");
+  ASSERT_EQ(column.get_value(1).get_string(), "red");
+  ASSERT_TRUE(column.get_value(5).is_null());
+
+  // 取出的列共享同一个字典
+  Column gathered;
+  gathered.gather(column, {3, 2, 5});
+  ASSERT_EQ(gathered.dictionary(), dictionary);
+  ASSERT_EQ(gathered.get_string(0), "green");
+  ASSERT_EQ(gathered.get_string(1), "red");
+  ASSERT_TRUE(gathered.is_null(2));
+}
+
 int main(int argc, char **argv)
 {
 
@@ -82,6 +82,56 @@ TEST(DiskLogHandler, test_append_and_wait)
   filesystem::remove_all(path);
 }
 
+TEST(DiskLogHandler, test_group_commit)
+{
+  // several threads append and wait their own log entries concurrently, like committing transactions
+  const char *path = "test_log_handler";
+  filesystem::remove_all(path);
+
+  DiskLogHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.init(path));
+  TestLogReplayer replayer;
+  ASSERT_EQ(RC::SUCCESS, handler.replay(replayer, 0));
+  handler.set_group_commit(4096, chrono::microseconds(200));
+  ASSERT_EQ(RC::SUCCESS, handler.start());
+
+  const int      thread_num = 8;
+  const int      times      = 500;
+  atomic<int>    failed{0};
+  vector<thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&handler, &failed]() {
+      for (int i = 0; i < times; i++) {
+        LSN          lsn = 0;
+        vector<char> data(100);
+        if (handler.append(lsn, LogModule::Id::BUFFER_POOL, std::move(data)) != RC::SUCCESS ||
+            handler.wait_lsn(lsn) != RC::SUCCESS || handler.current_flushed_lsn() < lsn) {
+          failed++;
+        }
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(0, failed.load());
+  ASSERT_EQ(handler.current_flushed_lsn(), thread_num * times);
+  ASSERT_TRUE(handler.lsn_waiters_.empty());
+
+  ASSERT_EQ(RC::SUCCESS, handler.stop());
+  ASSERT_EQ(RC::SUCCESS, handler.await_termination());
+
+  int  count             = 0;
+  auto log_entry_counter = [&count](LogEntry &) -> RC {
+    count++;
+    return RC::SUCCESS;
+  };
+  ASSERT_EQ(RC::SUCCESS, handler.iterate(log_entry_counter, 0));
+  ASSERT_EQ(count, thread_num * times);
+
+  filesystem::remove_all(path);
+}
+
 TEST(DiskLogHandler, test_replay)
 {
   // create an empty directory and init a DiskLogHandler and then test replay
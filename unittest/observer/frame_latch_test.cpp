@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+
+#include "common/lang/vector.h"
+#include "storage/buffer/frame_latch.h"
+
+TEST(FrameLatch, shared)
+{
+  FrameLatch latch;
+  ASSERT_TRUE(latch.try_lock_shared());
+  latch.lock_shared();
+
+  // 读锁不影响乐观读
+  uint64_t version = 0;
+  ASSERT_TRUE(latch.optimistic_lock(version));
+  ASSERT_TRUE(latch.validate(version));
+
+  latch.unlock_shared();
+  latch.unlock_shared();
+  ASSERT_TRUE(latch.validate(version));
+}
+
+TEST(FrameLatch, exclusive)
+{
+  FrameLatch latch;
+  uint64_t   version = 0;
+  ASSERT_TRUE(latch.optimistic_lock(version));
+
+  latch.lock();
+  latch.lock();  // 写锁可以递归
+#ifdef CONCURRENCY
+  uint64_t tmp_version = 0;
+  ASSERT_FALSE(latch.try_lock_shared());
+  ASSERT_FALSE(latch.optimistic_lock(tmp_version));
+  ASSERT_FALSE(latch.validate(version));
+#endif
+  latch.unlock();
+#ifdef CONCURRENCY
+  ASSERT_FALSE(latch.try_lock_shared());
+#endif
+  latch.unlock();
+
+#ifdef CONCURRENCY
+  // 释放写锁之后版本号变了
+  ASSERT_FALSE(latch.validate(version));
+#endif
+  ASSERT_TRUE(latch.optimistic_lock(version));
+  ASSERT_TRUE(latch.validate(version));
+  ASSERT_TRUE(latch.try_lock_shared());
+  latch.unlock_shared();
+}
+
+#ifdef CONCURRENCY
+TEST(FrameLatch, optimistic_read)
+{
+  // 写线程保持两个值相等，乐观读校验成功时读到的两个值也一定相等
+  FrameLatch       latch;
+  volatile int64_t values[2] = {0, 0};
+  const int        write_num = 100000;
+  atomic<bool>     stop{false};
+  atomic<int64_t>  validated_num{0};
+  atomic<int64_t>  inconsistent_num{0};
+
+  auto reader = [&]() {
+    while (!stop.load()) {
+      uint64_t version = 0;
+      if (!latch.optimistic_lock(version)) {
+        continue;
+      }
+      int64_t first  = values[0];
+      int64_t second = values[1];
+      if (latch.validate(version)) {
+        validated_num++;
+        if (first != second) {
+          inconsistent_num++;
+        }
+      }
+    }
+  };
+
+  auto writer = [&]() {
+    for (int i = 0; i < write_num; i++) {
+      latch.lock();
+      values[0] = values[0] + 1;
+      values[1] = values[1] + 1;
+      latch.unlock();
+    }
+  };
+
+  vector<thread> readers;
+  for (int i = 0; i < 2; i++) {
+    readers.emplace_back(reader);
+  }
+  vector<thread> writers;
+  for (int i = 0; i < 2; i++) {
+    writers.emplace_back(writer);
+  }
+  for (thread &t : writers) {
+    t.join();
+  }
+  stop = true;
+  for (thread &t : readers) {
+    t.join();
+  }
+
+  ASSERT_EQ(values[0], 2 * write_num);
+  ASSERT_EQ(values[1], 2 * write_num);
+  ASSERT_GT(validated_num.load(), 0);
+  ASSERT_EQ(inconsistent_num.load(), 0);
+}
+
+TEST(FrameLatch, shared_and_exclusive)
+{
+  FrameLatch   latch;
+  int          value      = 0;
+  const int    thread_num = 4;
+  const int    loop_num   = 20000;
+  atomic<bool> broken{false};
+
+  auto func = [&](int id) {
+    for (int i = 0; i < loop_num; i++) {
+      if ((i + id) % 4 == 0) {
+        latch.lock();
+        int old = value;
+        value   = old + 1;
+        latch.unlock();
+      } else {
+        latch.lock_shared();
+        int first  = value;
+        int second = value;
+        if (first != second) {
+          broken = true;
+        }
+        latch.unlock_shared();
+      }
+    }
+  };
+
+  vector<thread> threads;
+  for (int i = 0; i < thread_num; i++) {
+    threads.emplace_back(func, i);
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  ASSERT_EQ(value, thread_num * loop_num / 4);
+  ASSERT_FALSE(broken.load());
+}
+#endif  // CONCURRENCY
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
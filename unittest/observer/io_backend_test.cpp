@@ -0,0 +1,205 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <fcntl.h>
+#include <filesystem>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "common/lang/atomic.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/buffer/io_backend.h"
+#include "storage/clog/vacuous_log_handler.h"
+
+using namespace std;
+using namespace common;
+
+class IoBackendTest : public testing::TestWithParam<const char *>
+{};
+
+TEST_P(IoBackendTest, read_write)
+{
+  filesystem::path directory("io_backend");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+  filesystem::path filename = directory / (string(GetParam()) + ".data");
+
+  int fd = open(filename.c_str(), O_CREAT | O_RDWR, 0644);
+  ASSERT_GE(fd, 0);
+
+  PageIoOptions options;
+  options.backend     = GetParam();
+  options.queue_depth = 8;  // 比请求个数少，测试提交队列满了的情况
+  unique_ptr<IoBackend> backend = IoBackend::create(options);
+  ASSERT_NE(backend, nullptr);
+
+  // 一次写入一批页面，每个页面的内容都是它的编号
+  const int    page_num = 64;
+  vector<Page> pages(page_num);
+  vector<IoRequest> requests;
+  for (int i = 0; i < page_num; i++) {
+    memset(&pages[i], i, sizeof(Page));
+    requests.emplace_back(IoRequest::write(fd, &pages[i], sizeof(Page), static_cast<int64_t>(i) * sizeof(Page)));
+  }
+  ASSERT_EQ(RC::SUCCESS, backend->submit_and_wait(requests));
+  ASSERT_EQ(static_cast<off_t>(page_num * sizeof(Page)), lseek(fd, 0, SEEK_END));
+
+  // 异步读回来，逆序提交
+  vector<Page>  read_pages(page_num);
+  atomic<int>   finished_num{0};
+  atomic<int>   failed_num{0};
+  requests.clear();
+  for (int i = page_num - 1; i >= 0; i--) {
+    requests.emplace_back(IoRequest::read(fd, &read_pages[i], sizeof(Page), static_cast<int64_t>(i) * sizeof(Page),
+        [&finished_num, &failed_num](RC rc) {
+          if (OB_FAIL(rc)) {
+            failed_num++;
+          }
+          finished_num++;
+        }));
+  }
+  ASSERT_EQ(RC::SUCCESS, backend->submit(requests));
+  while (finished_num.load() < page_num) {
+    this_thread::yield();
+  }
+  ASSERT_EQ(0, failed_num.load());
+  for (int i = 0; i < page_num; i++) {
+    ASSERT_EQ(0, memcmp(&pages[i], &read_pages[i], sizeof(Page))) << "page " << i;
+  }
+
+  // 读取文件末尾之后的数据会失败
+  Page tail_page;
+  requests.clear();
+  requests.emplace_back(IoRequest::read(fd, &tail_page, sizeof(Page), static_cast<int64_t>(page_num) * sizeof(Page)));
+  ASSERT_EQ(RC::IOERR_READ, backend->submit_and_wait(requests));
+
+  backend->cleanup();
+  close(fd);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, IoBackendTest, testing::Values("sync", "thread_pool", "io_uring"));
+
+TEST(IoBackend, fallback)
+{
+  PageIoOptions options;
+  options.backend = "no_such_backend";
+  unique_ptr<IoBackend> backend = IoBackend::create(options);
+  ASSERT_NE(backend, nullptr);
+  ASSERT_STREQ("thread_pool", backend->name());
+}
+
+TEST(DiskBufferPool, prefetch)
+{
+  filesystem::path directory("io_backend");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+  filesystem::path buffer_pool_filename = directory / "prefetch.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  // 页面中写入自己的编号，然后全部淘汰出内存
+  const int page_num = 100;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    memcpy(frame->data(), &i, sizeof(i));
+    frame->mark_dirty();
+    buffer_pool->unpin_page(frame);
+  }
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->purge_all_pages());
+
+  // 第一个数据页是1
+  vector<PageNum> page_nums{1, 2, 3, 5, 8, 13};
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->prefetch_pages(page_nums));
+  // 重复预读已经在内存中的页面不会有问题
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->prefetch_pages(page_nums));
+
+  BufferPoolIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(*buffer_pool, 1, true /*prefetch*/));
+  int count = 0;
+  while (iterator.has_next()) {
+    PageNum page = iterator.next();
+    Frame  *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(page, &frame));
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    ASSERT_EQ(count, value);
+    buffer_pool->unpin_page(frame);
+    count++;
+  }
+  ASSERT_EQ(page_num, count);
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->close_file());
+}
+
+TEST(DiskBufferPool, read_ahead)
+{
+  filesystem::path directory("io_backend");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+  filesystem::path buffer_pool_filename = directory / "read_ahead.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = 100;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    memcpy(frame->data(), &i, sizeof(i));
+    frame->mark_dirty();
+    buffer_pool->unpin_page(frame);
+  }
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->purge_all_pages());
+
+  BPFrameManager      &frame_manager = buffer_pool_manager.get_frame_manager();
+  const PageIoOptions &options       = buffer_pool_manager.io_options();
+
+  // 随机访问不会预读
+  for (PageNum page : {90, 50, 70, 60}) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(page, &frame));
+    buffer_pool->unpin_page(frame);
+  }
+  ASSERT_EQ(0UL, frame_manager.scan_frame_num());
+
+  // 连续访问相邻的页面之后，预读后面的页面，预读的页面放在扫描队列中
+  PageNum page = 1;
+  for (; page <= options.read_ahead_threshold + 1; page++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(page, &frame));
+    buffer_pool->unpin_page(frame);
+  }
+  ASSERT_EQ(static_cast<size_t>(options.read_ahead_pages), frame_manager.scan_frame_num());
+
+  // 一直顺序访问到文件末尾，读到的数据都是正确的
+  for (; page <= page_num; page++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(page, &frame));
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    ASSERT_EQ(page - 1, value);
+    buffer_pool->unpin_page(frame);
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->close_file());
+}
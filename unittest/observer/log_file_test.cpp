@@ -390,6 +390,54 @@ TEST(LogFileManager, next_file)
   filesystem::remove_all(directory);
 }
 
+TEST(LogFileManager, recycle)
+{
+  const char *directory                 = "recycle";
+  int         max_entry_number_per_file = 1000;
+
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directory(directory));
+
+  LSN lsns[] = {0, 1000, 2000, 3000};
+  for (LSN lsn : lsns) {
+    string   filename = string(LogFileManager::file_prefix_) + to_string(lsn) + LogFileManager::file_suffix_;
+    ofstream ofs(filesystem::path(directory) / filename);
+    ofs.close();
+  }
+
+  LogFileManager manager;
+  ASSERT_EQ(RC::SUCCESS, manager.init(directory, max_entry_number_per_file));
+
+  // the checkpoint is inside the first file, nothing can be removed
+  int removed_count = 0;
+  ASSERT_EQ(RC::SUCCESS, manager.recycle(999, removed_count));
+  ASSERT_EQ(0, removed_count);
+
+  ASSERT_EQ(RC::SUCCESS, manager.recycle(1500, removed_count));
+  ASSERT_EQ(1, removed_count);
+  ASSERT_FALSE(filesystem::exists(filesystem::path(directory) / "clog_0.log"));
+
+  vector<string> files;
+  ASSERT_EQ(RC::SUCCESS, manager.list_files(files, 0));
+  ASSERT_EQ(3, files.size());
+
+  // the last file is always kept, and the next file continues from it
+  ASSERT_EQ(RC::SUCCESS, manager.recycle(10000, removed_count));
+  ASSERT_EQ(2, removed_count);
+  ASSERT_EQ(RC::SUCCESS, manager.list_files(files, 0));
+  ASSERT_EQ(1, files.size());
+  ASSERT_EQ("clog_3000.log", filesystem::path(files[0]).filename());
+
+  LogFileWriter writer;
+  ASSERT_EQ(RC::SUCCESS, manager.next_file(writer));
+  LSN lsn = 0;
+  ASSERT_EQ(RC::SUCCESS, LogFileManager::get_lsn_from_filename(filesystem::path(writer.filename()).filename(), lsn));
+  ASSERT_EQ(4000, lsn);
+
+  writer.close();
+  filesystem::remove_all(directory);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
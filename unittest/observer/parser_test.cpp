@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 
 #include "sql/expr/expression.h"
+#include "session/prepared_statement.h"
 #include "sql/parser/parse.h"
 #include "gtest/gtest.h"
 
@@ -64,6 +65,100 @@ TEST(ParserTest, DISABLED_group_by_test)
   }
 }
 
+TEST(ParserTest, placeholder)
+{
+  // 普通的SQL中不能出现占位符
+  ParsedSqlResult result;
+  parse("select * from t where id = ?;", &result);
+  ASSERT_EQ(1UL, result.sql_nodes().size());
+  ASSERT_EQ(SCF_ERROR, result.sql_nodes().front()->flag);
+
+  PreparedStatement stmt(1, "select id, ? from t where id = ? and name = 'a' and score > ?;");
+  ASSERT_EQ(RC::SUCCESS, stmt.prepare());
+  ASSERT_EQ(3, stmt.param_count());
+
+  // 绑定参数之后的指纹与直接写出这些常量的SQL相同
+  vector<Value> values{Value("x"), Value(1), Value(2.5f)};
+  string        fingerprint;
+  vector<Value> params;
+  ASSERT_EQ(RC::SUCCESS, stmt.fingerprint(values, fingerprint, params));
+
+  string        expected_fingerprint;
+  vector<Value> expected_params;
+  const char *expected_sql = "select id, 'x' from t where id = 1 and name = 'a' and score > 2.5;";
+  ASSERT_EQ(RC::SUCCESS, parse_fingerprint(expected_sql, expected_fingerprint, expected_params));
+  ASSERT_EQ(expected_fingerprint, fingerprint);
+  ASSERT_EQ(expected_params.size(), params.size());
+  for (size_t i = 0; i < params.size(); i++) {
+    ASSERT_EQ(expected_params[i].attr_type(), params[i].attr_type());
+    ASSERT_EQ(expected_params[i].to_string(), params[i].to_string());
+  }
+
+  // NULL不是参数
+  values[1].set_null(true);
+  ASSERT_EQ(RC::SUCCESS, stmt.fingerprint(values, fingerprint, params));
+  expected_sql = "select id, 'x' from t where id = null and name = 'a' and score > 2.5;";
+  ASSERT_EQ(RC::SUCCESS, parse_fingerprint(expected_sql, expected_fingerprint, expected_params));
+  ASSERT_EQ(expected_fingerprint, fingerprint);
+  ASSERT_EQ(3UL, params.size());
+
+  ParsedSqlResult bound_result;
+  ASSERT_EQ(RC::SUCCESS, stmt.parse(values, &bound_result));
+  ASSERT_EQ(SCF_SELECT, bound_result.sql_nodes().front()->flag);
+  ASSERT_EQ(3, bound_result.param_count());
+}
+
+TEST(ParserTest, prepared_insert)
+{
+  PreparedStatement stmt(1, "insert into t values(?, 'a', ?);");
+  ASSERT_EQ(RC::SUCCESS, stmt.prepare());
+  ASSERT_EQ(2, stmt.param_count());
+
+  vector<Value>   values{Value(1), Value(2.5f)};
+  ParsedSqlResult result;
+  ASSERT_EQ(RC::SUCCESS, stmt.parse(values, &result));
+  ASSERT_EQ(SCF_INSERT, result.sql_nodes().front()->flag);
+
+  const InsertSqlNode &insertion = result.sql_nodes().front()->insertion;
+  ASSERT_EQ(3UL, insertion.values.size());
+  ASSERT_EQ(1, insertion.values[0].get_int());
+  ASSERT_EQ("a", insertion.values[1].get_string());
+  ASSERT_EQ(2.5f, insertion.values[2].get_float());
+
+  // 参数个数不对
+  values.pop_back();
+  ParsedSqlResult wrong_result;
+  ASSERT_EQ(RC::INVALID_ARGUMENT, stmt.parse(values, &wrong_result));
+}
+
+TEST(ParserTest, multi_row_insert)
+{
+  ParsedSqlResult result;
+  ASSERT_EQ(RC::SUCCESS, parse("insert into t values(1, 'a'), (2, 'b'), (3, 'c');", &result));
+  ASSERT_EQ(SCF_INSERT, result.sql_nodes().front()->flag);
+  const InsertSqlNode &insertion = result.sql_nodes().front()->insertion;
+  ASSERT_EQ(3UL, insertion.row_num);
+  ASSERT_EQ(6UL, insertion.values.size());
+  ASSERT_EQ(3, insertion.values[4].get_int());
+  ASSERT_EQ("c", insertion.values[5].get_string());
+
+  // 每一行值的个数必须相同
+  ParsedSqlResult wrong_result;
+  parse("insert into t values(1, 'a'), (2);", &wrong_result);
+  ASSERT_EQ(SCF_ERROR, wrong_result.sql_nodes().front()->flag);
+
+  // 预处理语句的参数可以在任意一行
+  PreparedStatement stmt(1, "insert into t values(?, 'a'), (?, 'b');");
+  ASSERT_EQ(RC::SUCCESS, stmt.prepare());
+  ASSERT_EQ(2, stmt.param_count());
+  vector<Value>   values{Value(1), Value(2)};
+  ParsedSqlResult bound_result;
+  ASSERT_EQ(RC::SUCCESS, stmt.parse(values, &bound_result));
+  const InsertSqlNode &bound_insertion = bound_result.sql_nodes().front()->insertion;
+  ASSERT_EQ(2UL, bound_insertion.row_num);
+  ASSERT_EQ(2, bound_insertion.values[2].get_int());
+}
+
 int main(int argc, char **argv)
 {
 
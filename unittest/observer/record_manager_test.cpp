@@ -212,6 +212,86 @@ TEST(RecordScanner, test_record_file_iterator)
   delete bpm;
 }
 
+TEST(RecordScanner, test_condition_filter)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "record_manager_filter.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, record_manager_file, bp));
+
+  RecordFileHandler file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, nullptr));
+
+  // 记录的前4个字节是整数 i，后面4个字节是浮点数 i / 2.0
+  const int        record_insert_num = 1000;
+  char             record_data[20];
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    float f = i / 2.0f;
+    memcpy(record_data, &i, sizeof(i));
+    memcpy(record_data + sizeof(i), &f, sizeof(f));
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+  for (int i = 0; i < record_insert_num; i += 2) {
+    ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[i]));
+  }
+
+  ConDesc int_attr;
+  int_attr.is_attr     = true;
+  int_attr.attr_length = sizeof(int);
+  int_attr.attr_offset = 0;
+  int_attr.attr_index  = 0;
+  ConDesc float_attr;
+  float_attr.is_attr     = true;
+  float_attr.attr_length = sizeof(float);
+  float_attr.attr_offset = sizeof(int);
+  float_attr.attr_index  = 1;
+  ConDesc int_value;
+  int_value.is_attr = false;
+  int_value.value   = Value(600);
+  ConDesc float_value;
+  float_value.is_attr = false;
+  float_value.value   = Value(400.0f);
+
+  // 600 <= i and f < 400.0，常量在左边的条件交换两边之后比较
+  DefaultConditionFilter int_filter;
+  ASSERT_EQ(RC::SUCCESS, int_filter.init(int_value, int_attr, AttrType::INTS, LESS_EQUAL));
+  DefaultConditionFilter float_filter;
+  ASSERT_EQ(RC::SUCCESS, float_filter.init(float_attr, float_value, AttrType::FLOATS, LESS_THAN));
+  const ConditionFilter   *filters[] = {&int_filter, &float_filter};
+  CompositeConditionFilter condition_filter;
+  ASSERT_EQ(RC::SUCCESS, condition_filter.init(filters, 2));
+
+  VacuousTrx        trx;
+  HeapRecordScanner file_scanner(
+      nullptr /*table*/, *bp, &trx, log_handler, ReadWriteMode::READ_ONLY, &condition_filter);
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan());
+
+  Record record;
+  RC     rc       = RC::SUCCESS;
+  int    expected = 601;
+  while (OB_SUCC(rc = file_scanner.next(record))) {
+    int value = -1;
+    memcpy(&value, record.data(), sizeof(value));
+    ASSERT_EQ(expected, value);
+    expected += 2;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(801, expected);
+  file_scanner.close_scan();
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
 TEST(RecordManager, durability)
 {
   /*
@@ -0,0 +1,142 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <sstream>
+
+#include "catalog/table_stats.h"
+#include "common/value.h"
+#include "sql/operator/join_runtime_filter.h"
+#include "sql/optimizer/statistics/histogram.h"
+#include "sql/optimizer/statistics/hyper_log_log.h"
+#include "sql/optimizer/statistics/table_statistics.h"
+
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(HyperLogLogTest, estimate)
+{
+  for (int64_t ndv : {0, 10, 1000, 100000}) {
+    HyperLogLog hll;
+    // 每个值添加两次，重复的值不影响估算结果
+    for (int round = 0; round < 2; round++) {
+      for (int64_t i = 0; i < ndv; i++) {
+        Value    value(static_cast<int>(i));
+        uint64_t hash = 0;
+        ASSERT_EQ(RC::SUCCESS, JoinKeyHasher::hash_keys(&value, 1, hash));
+        hll.add(hash);
+      }
+    }
+    EXPECT_NEAR(static_cast<double>(ndv), static_cast<double>(hll.estimate()), ndv * 0.05 + 1);
+  }
+}
+
+TEST(HistogramTest, selectivity)
+{
+  // 0..99 各一行，再加上 50 个 1000
+  vector<double> values;
+  for (int i = 0; i < 100; i++) {
+    values.push_back(i);
+  }
+  values.insert(values.end(), 50, 1000);
+
+  Histogram histogram;
+  histogram.build(values, 10, 101);
+  ASSERT_FALSE(histogram.empty());
+
+  // 同一个值不能跨桶
+  for (const Histogram::Bucket &bucket : histogram.buckets()) {
+    EXPECT_TRUE(bucket.upper < 1000 || bucket.lower == 1000);
+  }
+
+  EXPECT_NEAR(50.0 / 150, histogram.equal_selectivity(1000), 1e-6);
+  EXPECT_NEAR(1.0 / 150, histogram.equal_selectivity(10), 0.01);
+  EXPECT_DOUBLE_EQ(0, histogram.equal_selectivity(2000));
+  EXPECT_NEAR(50.0 / 150, histogram.less_selectivity(50, false), 0.02);
+  EXPECT_NEAR(100.0 / 150, histogram.less_selectivity(1000, false), 1e-6);
+  EXPECT_NEAR(1.0, histogram.less_selectivity(1000, true), 1e-6);
+  EXPECT_DOUBLE_EQ(0, histogram.less_selectivity(-1, true));
+}
+
+TEST(HistogramTest, position)
+{
+  double a = 0, b = 0, c = 0;
+  ASSERT_TRUE(Histogram::position(Value("abc", 3), a));
+  ASSERT_TRUE(Histogram::position(Value("abd", 3), b));
+  ASSERT_TRUE(Histogram::position(Value("b", 1), c));
+  EXPECT_LT(a, b);
+  EXPECT_LT(b, c);
+
+  ASSERT_TRUE(Histogram::position(Value(1.5f), a));
+  EXPECT_DOUBLE_EQ(1.5, a);
+}
+
+TEST(TableStatisticsTest, estimate_ndv)
+{
+  // 读了整张表
+  EXPECT_EQ(100, TableStatistics::estimate_ndv(100, 1000, 1000));
+  // 样本中几乎都是不同的值，按照比例放大
+  EXPECT_EQ(10000, TableStatistics::estimate_ndv(1000, 1000, 10000));
+  // 样本中重复的值很多，认为已经看到了所有的值
+  EXPECT_EQ(50, TableStatistics::estimate_ndv(50, 1000, 10000));
+  EXPECT_EQ(0, TableStatistics::estimate_ndv(0, 0, 10000));
+}
+
+TEST(TableStatsTest, serialize)
+{
+  TableStats stats(1000);
+  stats.sampled_rows = 500;
+
+  ColumnStats id;
+  id.name      = "id";
+  id.ndv       = 1000;
+  id.has_range = true;
+  id.min       = 1;
+  id.max       = 1000;
+  id.histogram.add_bucket({1, 500, 0.5, 500});
+  id.histogram.add_bucket({501, 1000, 0.5, 500});
+  stats.column_stats.push_back(id);
+
+  ColumnStats name;
+  name.name      = "name";
+  name.null_frac = 0.25;
+  name.ndv       = 10;
+  stats.column_stats.push_back(name);
+
+  stringstream ss;
+  ASSERT_GT(stats.serialize(ss), 0);
+
+  TableStats other;
+  ASSERT_GE(other.deserialize(ss), 0);
+  EXPECT_EQ(1000, other.row_nums);
+  EXPECT_EQ(500, other.sampled_rows);
+  ASSERT_EQ(2, static_cast<int>(other.column_stats.size()));
+
+  const ColumnStats *other_id = other.find_column("ID");
+  ASSERT_NE(nullptr, other_id);
+  EXPECT_TRUE(other_id->has_range);
+  EXPECT_DOUBLE_EQ(1000, other_id->max);
+  ASSERT_EQ(2, static_cast<int>(other_id->histogram.buckets().size()));
+  EXPECT_DOUBLE_EQ(501, other_id->histogram.buckets()[1].lower);
+
+  const ColumnStats *other_name = other.find_column("name");
+  ASSERT_NE(nullptr, other_name);
+  EXPECT_FALSE(other_name->has_range);
+  EXPECT_DOUBLE_EQ(0.25, other_name->null_frac);
+  EXPECT_EQ(10, other_name->ndv);
+
+  EXPECT_EQ(nullptr, other.find_column("none"));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}